@@ -60,6 +60,10 @@ function(ez_set_build_flags_msvc TARGET_NAME)
 		# enable SSE2 (incompatible with /fp:except)
 		target_compile_options(${TARGET_NAME} PRIVATE "/arch:SSE2")
 	endif ()
+
+	if (EZ_ENABLE_AVX2 AND EZ_CMAKE_ARCHITECTURE_X86)
+		target_compile_options(${TARGET_NAME} PRIVATE "/arch:AVX2")
+	endif ()
 	
 	# /Zo: Improved debugging of optimized code
 	target_compile_options(${TARGET_NAME} PRIVATE "$<$<CONFIG:RELEASE>:/Zo>")
@@ -147,6 +151,10 @@ function(ez_set_build_flags_clang TARGET_NAME)
 	
 	if(EZ_CMAKE_ARCHITECTURE_X86)
 		target_compile_options(${TARGET_NAME} PRIVATE "-msse4.1")
+		
+		if(EZ_ENABLE_AVX2)
+			target_compile_options(${TARGET_NAME} PRIVATE -mavx2 -mfma)
+		endif()
 	endif()
 	
 	# Disable warning: multi-character character constant
@@ -193,6 +201,10 @@ function(ez_set_build_flags_gcc TARGET_NAME)
 	target_compile_options(${TARGET_NAME} PRIVATE -fPIC -gdwarf-3)
 
 	target_compile_options(${TARGET_NAME} PRIVATE -msse4.1)
+
+	if(EZ_ENABLE_AVX2)
+		target_compile_options(${TARGET_NAME} PRIVATE -mavx2 -mfma)
+	endif()
 	
 	# Disable warning: multi-character character constant
 	target_compile_options(${TARGET_NAME} PRIVATE -Wno-multichar)
@@ -50,6 +50,13 @@ set (EZ_ENABLE_COMPILER_STATIC_ANALYSIS OFF CACHE BOOL "Enables static analysis
 
 mark_as_advanced(FORCE EZ_ENABLE_COMPILER_STATIC_ANALYSIS)
 
+######################################
+### AVX2 support
+######################################
+set (EZ_ENABLE_AVX2 OFF CACHE BOOL "Compiles all code for CPUs that support AVX2 and FMA. The binaries will not run on older CPUs.")
+
+mark_as_advanced(FORCE EZ_ENABLE_AVX2)
+
 
 ######################################
 ### vcpkg
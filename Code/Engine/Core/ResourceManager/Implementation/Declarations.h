@@ -150,3 +150,5 @@ enum class ezResourcePriority
 };
 
 // clang-format on
+
+EZ_DEFINE_AS_POD_TYPE(ezResourcePriority);
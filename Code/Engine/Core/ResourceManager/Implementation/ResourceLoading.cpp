@@ -328,7 +328,7 @@ bool ezResourceManager::ReloadResource(ezResource* pResource, bool bForce)
   }
   else
   {
-    s_State->s_ResourcesToUnloadOnMainThread.Insert(ezTempHashedString(pResource->GetResourceID().GetData()), pResource->GetDynamicRTTI());
+    s_State->s_ResourcesToUnloadOnMainThread.Insert(ezTempHashedString(pResource->GetResourceIDHash()), pResource->GetDynamicRTTI());
   }
 
   if (bAllowPreloading)
@@ -60,7 +60,7 @@ ezResourceTypeLoader* ezResourceManager::GetResourceTypeLoader(const ezRTTI* pRT
   return s_State->s_ResourceTypeLoader[pRTTI];
 }
 
-ezMap<const ezRTTI*, ezResourceTypeLoader*>& ezResourceManager::GetResourceTypeLoaders()
+ezBTreeMap<const ezRTTI*, ezResourceTypeLoader*>& ezResourceManager::GetResourceTypeLoaders()
 {
   return s_State->s_ResourceTypeLoader;
 }
@@ -109,7 +109,7 @@ void ezResourceManager::ExecuteAllResourceCleanupCallbacks()
   EZ_ASSERT_DEV(s_State->s_ResourceCleanupCallbacks.IsEmpty(), "During resource cleanup, new resource cleanup callbacks were registered.");
 }
 
-ezMap<const ezRTTI*, ezResourcePriority>& ezResourceManager::GetResourceTypePriorities()
+ezBTreeMap<const ezRTTI*, ezResourcePriority>& ezResourceManager::GetResourceTypePriorities()
 {
   return s_State->s_ResourceTypePriorities;
 }
@@ -30,7 +30,7 @@ private:
   /// \name Resource Priorities
   ///@{
 
-  ezMap<const ezRTTI*, ezResourcePriority> s_ResourceTypePriorities;
+  ezBTreeMap<const ezRTTI*, ezResourcePriority> s_ResourceTypePriorities;
 
   ///@}
 
@@ -72,7 +72,7 @@ private:
 
   // Type Loaders
 
-  ezMap<const ezRTTI*, ezResourceTypeLoader*> s_ResourceTypeLoader;
+  ezBTreeMap<const ezRTTI*, ezResourceTypeLoader*> s_ResourceTypeLoader;
   ezResourceLoaderFromFile s_FileResourceLoader;
   ezResourceTypeLoader* s_pDefaultResourceLoader = &s_FileResourceLoader;
   ezMap<ezResource*, ezUniquePtr<ezResourceTypeLoader>> s_CustomLoaders;
@@ -89,7 +89,7 @@ private:
 
   // Asset system interaction
 
-  ezMap<ezString, const ezRTTI*> s_AssetToResourceType;
+  ezBTreeMap<ezString, const ezRTTI*> s_AssetToResourceType;
 
 
   // Export mode
@@ -8,56 +8,172 @@
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Profiling/Profiling.h>
 
+namespace
+{
+  /// Returns the header in front of the file content from one stream and the memory mapped file content from another one,
+  /// such that the file content does not need to be copied into one contiguous buffer.
+  class MappedFileStreamReader : public ezStreamReader
+  {
+  public:
+    void Reset(const void* pHeader, ezUInt64 uiHeaderSize, ezArrayPtr<const ezUInt8> content)
+    {
+      m_Header.Reset(pHeader, uiHeaderSize);
+      m_Content.Reset(content.GetPtr(), content.GetCount());
+    }
+
+    virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override
+    {
+      const ezUInt64 uiHeaderBytes = m_Header.ReadBytes(pReadBuffer, uiBytesToRead);
+      if (uiHeaderBytes == uiBytesToRead)
+        return uiHeaderBytes;
+
+      void* pContentBuffer = pReadBuffer != nullptr ? ezMemoryUtils::AddByteOffset(pReadBuffer, static_cast<ptrdiff_t>(uiHeaderBytes)) : nullptr;
+      return uiHeaderBytes + m_Content.ReadBytes(pContentBuffer, uiBytesToRead - uiHeaderBytes);
+    }
+
+    virtual ezUInt64 SkipBytes(ezUInt64 uiBytesToSkip) override { return ReadBytes(nullptr, uiBytesToSkip); }
+
+  private:
+    ezRawMemoryStreamReader m_Header;
+    ezRawMemoryStreamReader m_Content;
+  };
+} // namespace
+
 struct FileResourceLoadData
 {
   ezBlob m_Storage;
   ezRawMemoryStreamReader m_Reader;
+  MappedFileStreamReader m_MappedReader;
+  ezFileReader m_File;
+  ezUInt64 m_uiFileDataOffset = 0;
 };
 
+namespace
+{
+  /// Opens the file of the resource and fills out the description of \a res.
+  /// With bRequireOSFile, files that are not stored as ordinary files (e.g. inside an archive) are not opened.
+  FileResourceLoadData* OpenResourceFile(const ezResource* pResource, bool bRequireOSFile, ezResourceLoadData& res)
+  {
+    FileResourceLoadData* pData = EZ_DEFAULT_NEW(FileResourceLoadData);
+
+    if (pData->m_File.Open(pResource->GetResourceID().GetData()).Failed() || (bRequireOSFile && pData->m_File.GetOSFile() == nullptr))
+    {
+      EZ_DEFAULT_DELETE(pData);
+      return nullptr;
+    }
+
+    res.m_sResourceDescription = pData->m_File.GetFilePathRelative().GetData();
+
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_STATS)
+    ezFileStats stat;
+    if (ezFileSystem::GetFileStats(pResource->GetResourceID(), stat).Succeeded())
+    {
+      res.m_LoadedFileModificationDate = stat.m_LastModificationTime;
+    }
+
+#endif
+
+    res.m_pCustomLoaderData = pData;
+    return pData;
+  }
+
+  /// Writes the absolute path of the file into the storage, which is what loaders read first from the stream.
+  /// Reserves \a uiContentCapacity bytes behind it, for the caller to read the file content into GetFileDataPtr().
+  void WriteFileHeader(FileResourceLoadData* pData, ezUInt64 uiContentCapacity)
+  {
+    const ezUInt64 uiBlobCapacity = uiContentCapacity + pData->m_File.GetFilePathAbsolute().GetElementCount() + 8; // +8 for the string overhead
+    pData->m_Storage.SetCountUninitialized(uiBlobCapacity);
+
+    ezUInt8* pBlobPtr = pData->m_Storage.GetBlobPtr<ezUInt8>().GetPtr();
+
+    ezRawMemoryStreamWriter w(pBlobPtr, uiBlobCapacity);
+
+    // write the absolute path to the read file into the memory stream
+    w << pData->m_File.GetFilePathAbsolute();
+
+    pData->m_uiFileDataOffset = w.GetNumWrittenBytes();
+  }
+
+  ezUInt8* GetFileDataPtr(FileResourceLoadData* pData)
+  {
+    return pData->m_Storage.GetBlobPtr<ezUInt8>().GetPtr() + pData->m_uiFileDataOffset;
+  }
+
+  void FinishResourceFile(FileResourceLoadData* pData, ezUInt64 uiBytesRead, ezResourceLoadData& res)
+  {
+    pData->m_File.Close();
+
+    pData->m_Reader.Reset(pData->m_Storage.GetBlobPtr<ezUInt8>().GetPtr(), pData->m_uiFileDataOffset + uiBytesRead);
+    res.m_pDataStream = &pData->m_Reader;
+  }
+} // namespace
+
 ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pResource)
 {
   EZ_PROFILE_SCOPE("ReadResourceFile");
 
   ezResourceLoadData res;
 
-  ezFileReader File;
-  if (File.Open(pResource->GetResourceID().GetData()).Failed())
+  FileResourceLoadData* pData = OpenResourceFile(pResource, false, res);
+  if (pData == nullptr)
     return res;
 
-  res.m_sResourceDescription = File.GetFilePathRelative().GetData();
-
-#if EZ_ENABLED(EZ_SUPPORTS_FILE_STATS)
-  ezFileStats stat;
-  if (ezFileSystem::GetFileStats(pResource->GetResourceID(), stat).Succeeded())
+  // if the data directory can provide the content directly (e.g. uncompressed archive entries), the loader reads it from there
+  // and the file stays open until CloseDataStream()
+  ezArrayPtr<const ezUInt8> content;
+  if (pData->m_File.MapFileContent(content).Succeeded())
   {
-    res.m_LoadedFileModificationDate = stat.m_LastModificationTime;
+    WriteFileHeader(pData, 0);
+
+    pData->m_MappedReader.Reset(pData->m_Storage.GetBlobPtr<ezUInt8>().GetPtr(), pData->m_uiFileDataOffset, content);
+    res.m_pDataStream = &pData->m_MappedReader;
+    return res;
   }
 
-#endif
+  WriteFileHeader(pData, pData->m_File.GetFileSize());
 
-  FileResourceLoadData* pData = EZ_DEFAULT_NEW(FileResourceLoadData);
+  const ezUInt64 uiBytesRead = pData->m_File.ReadBytes(GetFileDataPtr(pData), pData->m_File.GetFileSize());
 
-  const ezUInt64 uiFileSize = File.GetFileSize();
+  FinishResourceFile(pData, uiBytesRead, res);
+  return res;
+}
 
-  const ezUInt64 uiBlobCapacity = uiFileSize + File.GetFilePathAbsolute().GetElementCount() + 8; // +8 for the string overhead
-  pData->m_Storage.SetCountUninitialized(uiBlobCapacity);
+bool ezResourceLoaderFromFile::BeginOpenDataStream(const ezResource* pResource, ezAsyncFileReader& reader, ezUInt64 uiReadUserData, ezResourceLoadData& out_LoadData)
+{
+  EZ_PROFILE_SCOPE("BeginReadResourceFile");
 
-  ezUInt8* pBlobPtr = pData->m_Storage.GetBlobPtr<ezUInt8>().GetPtr();
+  ezResourceLoadData res;
 
-  ezRawMemoryStreamWriter w(pBlobPtr, uiBlobCapacity);
+  // files that are not ordinary files (e.g. inside an archive) are read right away by OpenDataStream()
+  // ordinary files are not memory mapped here, because page faults would block the loading thread, while many reads can be in flight at once
+  FileResourceLoadData* pData = OpenResourceFile(pResource, true, res);
+  if (pData == nullptr)
+    return false;
 
-  // write the absolute path to the read file into the memory stream
-  w << File.GetFilePathAbsolute();
+  WriteFileHeader(pData, pData->m_File.GetFileSize());
 
-  const ezUInt64 uiOffset = w.GetNumWrittenBytes();
+  EZ_VERIFY(pData->m_File.ReadBytesAsync(reader, GetFileDataPtr(pData), pData->m_File.GetFileSize(), uiReadUserData).Succeeded(),
+    "Reading an OS file asynchronously should not fail.");
 
-  File.ReadBytes(pBlobPtr + uiOffset, uiFileSize);
+  out_LoadData = res;
+  return true;
+}
 
-  pData->m_Reader.Reset(pBlobPtr, w.GetNumWrittenBytes() + uiFileSize);
-  res.m_pDataStream = &pData->m_Reader;
-  res.m_pCustomLoaderData = pData;
+void ezResourceLoaderFromFile::FinishOpenDataStream(const ezResource* pResource, const ezAsyncFileReader::Completion& completion, ezResourceLoadData& inout_LoadData)
+{
+  FileResourceLoadData* pData = static_cast<FileResourceLoadData*>(inout_LoadData.m_pCustomLoaderData);
 
-  return res;
+  if (completion.m_Result.Failed())
+  {
+    // a truncated file must not be handed to the resource, treat it like a file that could not be opened
+    ezLog::Error("Failed to read resource file '{0}'", pData->m_File.GetFilePathAbsolute().GetData());
+
+    EZ_DEFAULT_DELETE(pData);
+    inout_LoadData = ezResourceLoadData();
+    return;
+  }
+
+  FinishResourceFile(pData, completion.m_uiBytesRead, inout_LoadData);
 }
 
 void ezResourceLoaderFromFile::CloseDataStream(const ezResource* pResource, const ezResourceLoadData& LoaderData)
@@ -12,46 +12,112 @@ void ezResourceManagerWorkerDataLoad::Execute()
 {
   EZ_PROFILE_SCOPE("LoadResourceFromDisk");
 
-  ezResource* pResourceToLoad = nullptr;
-  ezResourceTypeLoader* pLoader = nullptr;
-  ezUniquePtr<ezResourceTypeLoader> pCustomLoader;
+  if (m_pAsyncReader == nullptr)
+  {
+    m_pAsyncReader = EZ_DEFAULT_NEW(ezAsyncFileReader, MaxLoadsInFlight);
+
+    m_LoadsInFlight.SetCount(MaxLoadsInFlight);
+    m_FreeLoadSlots.SetCountUninitialized(MaxLoadsInFlight);
+
+    for (ezUInt32 i = 0; i < MaxLoadsInFlight; ++i)
+    {
+      m_FreeLoadSlots[i] = MaxLoadsInFlight - 1 - i;
+    }
+  }
 
+  ezUInt32 uiNumLoadsStarted = 0;
+
+  while (true)
   {
-    EZ_LOCK(ezResourceManager::s_ResourceMutex);
+    // start loading as many resources as possible, so that the OS can work on all of their reads at once
+    // a single file that is larger than the budget is still loaded, but nothing else is read at the same time
+    while (!m_FreeLoadSlots.IsEmpty() && m_pAsyncReader->GetNumPendingBytes() < MaxBytesInFlight &&
+           uiNumLoadsStarted < MaxLoadsPerExecution && !HasBeenCanceled())
+    {
+      const ezUInt32 uiSlot = m_FreeLoadSlots.PeekBack();
+      LoadInFlight& load = m_LoadsInFlight[uiSlot];
+
+      if (!PopNextResource(load))
+        break;
+
+      ++uiNumLoadsStarted;
+
+      if (load.m_pLoader->BeginOpenDataStream(load.m_pResource, *m_pAsyncReader, uiSlot, load.m_LoaderData))
+      {
+        m_FreeLoadSlots.PopBack();
+      }
+      else
+      {
+        load.m_LoaderData = load.m_pLoader->OpenDataStream(load.m_pResource);
+        LaunchUpdateContent(load);
+      }
+    }
 
-    if (ezResourceManager::s_State->s_LoadingQueue.IsEmpty())
+    if (m_pAsyncReader->GetNumPendingReads() == 0)
+      break;
+
+    m_Completions.Clear();
+    m_pAsyncReader->WaitForCompletions(m_Completions);
+
+    for (const ezAsyncFileReader::Completion& completion : m_Completions)
     {
-      ezResourceManager::s_State->s_bAllowLaunchDataLoadTask = true;
-      return;
+      const ezUInt32 uiSlot = static_cast<ezUInt32>(completion.m_uiUserData);
+      LoadInFlight& load = m_LoadsInFlight[uiSlot];
+
+      load.m_pLoader->FinishOpenDataStream(load.m_pResource, completion, load.m_LoaderData);
+      LaunchUpdateContent(load);
+
+      m_FreeLoadSlots.PushBack(uiSlot);
     }
+  }
+
+  EZ_LOCK(ezResourceManager::s_ResourceMutex);
+
+  // restart the next loading task (this one is about to finish), it picks up the remaining queue
+  ezResourceManager::s_State->s_bAllowLaunchDataLoadTask = true;
+  ezResourceManager::RunWorkerTask(nullptr);
+}
+
+bool ezResourceManagerWorkerDataLoad::PopNextResource(LoadInFlight& out_Load)
+{
+  {
+    EZ_LOCK(ezResourceManager::s_ResourceMutex);
+
+    if (ezResourceManager::s_State->s_LoadingQueue.IsEmpty())
+      return false;
 
     ezResourceManager::UpdateLoadingDeadlines();
 
     auto it = ezResourceManager::s_State->s_LoadingQueue.PeekFront();
-    pResourceToLoad = it.m_pResource;
+    out_Load.m_pResource = it.m_pResource;
+    out_Load.m_pLoader = nullptr;
     ezResourceManager::s_State->s_LoadingQueue.PopFront();
 
-    if (pResourceToLoad->m_Flags.IsSet(ezResourceFlags::HasCustomDataLoader))
+    if (out_Load.m_pResource->m_Flags.IsSet(ezResourceFlags::HasCustomDataLoader))
     {
-      pCustomLoader = std::move(ezResourceManager::s_State->s_CustomLoaders[pResourceToLoad]);
-      pLoader = pCustomLoader.Borrow();
-      pResourceToLoad->m_Flags.Remove(ezResourceFlags::HasCustomDataLoader);
-      pResourceToLoad->m_Flags.Add(ezResourceFlags::PreventFileReload);
+      out_Load.m_pCustomLoader = std::move(ezResourceManager::s_State->s_CustomLoaders[out_Load.m_pResource]);
+      out_Load.m_pLoader = out_Load.m_pCustomLoader.Borrow();
+      out_Load.m_pResource->m_Flags.Remove(ezResourceFlags::HasCustomDataLoader);
+      out_Load.m_pResource->m_Flags.Add(ezResourceFlags::PreventFileReload);
     }
   }
 
-  if (pLoader == nullptr)
-    pLoader = ezResourceManager::GetResourceTypeLoader(pResourceToLoad->GetDynamicRTTI());
+  if (out_Load.m_pLoader == nullptr)
+    out_Load.m_pLoader = ezResourceManager::GetResourceTypeLoader(out_Load.m_pResource->GetDynamicRTTI());
 
-  if (pLoader == nullptr)
-    pLoader = pResourceToLoad->GetDefaultResourceTypeLoader();
+  if (out_Load.m_pLoader == nullptr)
+    out_Load.m_pLoader = out_Load.m_pResource->GetDefaultResourceTypeLoader();
 
-  EZ_ASSERT_DEV(pLoader != nullptr, "No Loader function available for Resource Type '{0}'", pResourceToLoad->GetDynamicRTTI()->GetTypeName());
+  EZ_ASSERT_DEV(out_Load.m_pLoader != nullptr, "No Loader function available for Resource Type '{0}'", out_Load.m_pResource->GetDynamicRTTI()->GetTypeName());
 
-  ezResourceLoadData LoaderData = pLoader->OpenDataStream(pResourceToLoad);
+  out_Load.m_LoaderData = ezResourceLoadData();
+  return true;
+}
 
+void ezResourceManagerWorkerDataLoad::LaunchUpdateContent(LoadInFlight& load)
+{
   // we need this info later to do some work in a lock, all the directly following code is outside the lock
-  const bool bResourceIsLoadedOnMainThread = pResourceToLoad->GetBaseResourceFlags().IsAnySet(ezResourceFlags::UpdateOnMainThread);
+  const bool bResourceIsLoadedOnMainThread = load.m_pResource->GetBaseResourceFlags().IsAnySet(ezResourceFlags::UpdateOnMainThread);
 
   ezSharedPtr<ezResourceManagerWorkerUpdateContent> pUpdateContentTask;
   ezTaskGroupID* pUpdateContentGroup = nullptr;
@@ -90,21 +156,19 @@ void ezResourceManagerWorkerDataLoad::Execute()
 
   // set up the data load task and launch it
   {
-    pUpdateContentTask->m_LoaderData = LoaderData;
-    pUpdateContentTask->m_pLoader = pLoader;
-    pUpdateContentTask->m_pCustomLoader = std::move(pCustomLoader);
-    pUpdateContentTask->m_pResourceToLoad = pResourceToLoad;
+    pUpdateContentTask->m_LoaderData = load.m_LoaderData;
+    pUpdateContentTask->m_pLoader = load.m_pLoader;
+    pUpdateContentTask->m_pCustomLoader = std::move(load.m_pCustomLoader);
+    pUpdateContentTask->m_pResourceToLoad = load.m_pResource;
 
     // schedule the task to run, either on the main thread or on some other thread
     *pUpdateContentGroup = ezTaskSystem::StartSingleTask(
       pUpdateContentTask, bResourceIsLoadedOnMainThread ? ezTaskPriority::SomeFrameMainThread : ezTaskPriority::LateNextFrame);
-
-    // restart the next loading task (this one is about to finish)
-    ezResourceManager::s_State->s_bAllowLaunchDataLoadTask = true;
-    ezResourceManager::RunWorkerTask(nullptr);
-
-    pCustomLoader.Clear();
   }
+
+  load.m_pResource = nullptr;
+  load.m_pLoader = nullptr;
+  load.m_pCustomLoader.Clear();
 }
 
 
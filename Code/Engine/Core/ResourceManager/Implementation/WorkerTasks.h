@@ -6,6 +6,11 @@
 #include <Foundation/Types/UniquePtr.h>
 
 /// \brief [internal] Worker task for loading resources (typically from disk).
+///
+/// Loads up to MaxLoadsPerExecution resources from the loading queue and then launches the next loading task, such that a single
+/// task never occupies a worker thread for long. Loaders that support BeginOpenDataStream() read their data through an
+/// ezAsyncFileReader, such that up to MaxLoadsInFlight files are read at the same time, as long as their buffers take up
+/// less than MaxBytesInFlight in total.
 class EZ_CORE_DLL ezResourceManagerWorkerDataLoad final : public ezTask
 {
 public:
@@ -18,6 +23,29 @@ private:
   ezResourceManagerWorkerDataLoad();
 
   virtual void Execute() override;
+
+  static constexpr ezUInt32 MaxLoadsInFlight = 32;
+  static constexpr ezUInt64 MaxBytesInFlight = 64 * 1024 * 1024;
+  static constexpr ezUInt32 MaxLoadsPerExecution = 128;
+
+  struct LoadInFlight
+  {
+    ezResource* m_pResource = nullptr;
+    ezResourceTypeLoader* m_pLoader = nullptr;
+    ezUniquePtr<ezResourceTypeLoader> m_pCustomLoader;
+    ezResourceLoadData m_LoaderData;
+  };
+
+  /// \brief Takes the next resource out of the loading queue and determines its loader. Returns false, if the queue is empty.
+  static bool PopNextResource(LoadInFlight& out_Load);
+
+  /// \brief Schedules the ezResourceManagerWorkerUpdateContent task for a resource whose data has been loaded.
+  static void LaunchUpdateContent(LoadInFlight& load);
+
+  ezUniquePtr<ezAsyncFileReader> m_pAsyncReader;
+  ezHybridArray<LoadInFlight, MaxLoadsInFlight> m_LoadsInFlight;
+  ezHybridArray<ezUInt32, MaxLoadsInFlight> m_FreeLoadSlots;
+  ezDynamicArray<ezAsyncFileReader::Completion> m_Completions;
 };
 
 /// \brief [internal] Worker task for uploading resource data.
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Core/ResourceManager/Implementation/Declarations.h>
+#include <Foundation/IO/AsyncFileReader.h>
 #include <Foundation/IO/MemoryStream.h>
 #include <Foundation/IO/Stream.h>
 #include <Foundation/Time/Timestamp.h>
@@ -40,6 +41,17 @@ public:
   /// \sa ezResourceLoadData
   virtual ezResourceLoadData OpenDataStream(const ezResource* pResource) = 0;
 
+  /// \brief Override this function to allow the resource manager to load the data of many resources at the same time.
+  ///
+  /// Instead of reading the data right away, exactly one read with \a uiReadUserData may be submitted to \a reader.
+  /// In that case true must be returned and FinishOpenDataStream() is called with the result of the read, once it has completed.
+  /// \a out_LoadData is passed to FinishOpenDataStream() again.
+  /// If false is returned (default), nothing must have been submitted and OpenDataStream() is used instead.
+  virtual bool BeginOpenDataStream(const ezResource* pResource, ezAsyncFileReader& reader, ezUInt64 uiReadUserData, ezResourceLoadData& out_LoadData) { return false; }
+
+  /// \brief Called for every successful BeginOpenDataStream(), once the submitted read has completed.
+  virtual void FinishOpenDataStream(const ezResource* pResource, const ezAsyncFileReader::Completion& completion, ezResourceLoadData& inout_LoadData) {}
+
   /// \brief This function is called when the resource has been updated with the data from the resource loader and the loader can deallocate
   /// any temporary memory.
   virtual void CloseDataStream(const ezResource* pResource, const ezResourceLoadData& LoaderData) = 0;
@@ -55,11 +67,14 @@ public:
 ///
 /// The loader will interpret the ezResource 'resource ID' as a path, read that full file into a memory stream.
 /// The file modification data is stored as well.
+/// Files that are stored as ordinary files in their data directory are read asynchronously (see BeginOpenDataStream()).
 /// Resources that use this loader can update their data as if they were reading the file directly.
 class EZ_CORE_DLL ezResourceLoaderFromFile : public ezResourceTypeLoader
 {
 public:
   virtual ezResourceLoadData OpenDataStream(const ezResource* pResource) override;
+  virtual bool BeginOpenDataStream(const ezResource* pResource, ezAsyncFileReader& reader, ezUInt64 uiReadUserData, ezResourceLoadData& out_LoadData) override;
+  virtual void FinishOpenDataStream(const ezResource* pResource, const ezAsyncFileReader::Completion& completion, ezResourceLoadData& inout_LoadData) override;
   virtual void CloseDataStream(const ezResource* pResource, const ezResourceLoadData& LoaderData) override;
   virtual bool IsResourceOutdated(const ezResource* pResource) const override;
 };
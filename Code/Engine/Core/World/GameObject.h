@@ -3,6 +3,7 @@
 /// \file
 
 #include <Foundation/Containers/HybridArray.h>
+#include <Foundation/SimdMath/SimdBBoxSphereBatch.h>
 #include <Foundation/SimdMath/SimdConversion.h>
 #include <Foundation/Time/Time.h>
 #include <Foundation/Types/TagSet.h>
@@ -520,6 +521,30 @@ private:
     void UpdateVelocity(const ezSimdFloat& fInvDeltaSeconds);
 
     void UpdateSpatialData(ezSpatialSystem& spatialSystem, bool bWasAlwaysVisible, bool bIsAlwaysVisible);
+
+    // Batched versions of the functions above, which process pData[0] to pData[uiCount - 1] in structure-of-arrays batches.
+    // uiCount may be arbitrarily large. The global transforms and bounds are the same as with the functions above,
+    // apart from floating point rounding and the w components of the global position and scale, which are set to zero.
+    static void UpdateGlobalTransformsAndBounds(TransformationData* pData, ezUInt32 uiCount);
+    static void UpdateGlobalTransformsAndBoundsWithParent(TransformationData* pData, ezUInt32 uiCount);
+
+    // Conversion helpers between uiCount consecutive transformation data entries and batches, uiCount must not exceed the batch size.
+    template <typename VEC>
+    static void LoadLocalTransforms(const TransformationData* pData, ezUInt32 uiCount, ezSimdTransformBatch<VEC>& out_Transforms);
+    template <typename VEC>
+    static void LoadParentGlobalTransforms(const TransformationData* pData, ezUInt32 uiCount, ezSimdTransformBatch<VEC>& out_Transforms);
+    template <typename VEC>
+    static void LoadGlobalTransforms(const TransformationData* pData, ezUInt32 uiCount, ezSimdTransformBatch<VEC>& out_Transforms);
+    template <typename VEC>
+    static void StoreGlobalTransforms(TransformationData* pData, ezUInt32 uiCount, const ezSimdTransformBatch<VEC>& transforms);
+
+    template <typename VEC>
+    static void LoadLocalBounds(const TransformationData* pData, ezUInt32 uiCount, ezSimdBBoxSphereBatch<VEC>& out_Bounds);
+    template <typename VEC>
+    static void LoadGlobalBounds(const TransformationData* pData, ezUInt32 uiCount, ezSimdBBoxSphereBatch<VEC>& out_Bounds);
+    /// Also copies the always visible flag from the local bounds.
+    template <typename VEC>
+    static void StoreGlobalBounds(TransformationData* pData, ezUInt32 uiCount, const ezSimdBBoxSphereBatch<VEC>& bounds);
   };
 
   ezGameObjectId m_InternalId;
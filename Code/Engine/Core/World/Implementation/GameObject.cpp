@@ -1022,4 +1022,51 @@ void ezGameObject::TransformationData::UpdateSpatialData(ezSpatialSystem& spatia
   }
 }
 
+// static
+void ezGameObject::TransformationData::UpdateGlobalTransformsAndBounds(TransformationData* pData, ezUInt32 uiCount)
+{
+  constexpr ezUInt32 uiBatchSize = ezSimdBatchTraits<ezSimdBatchVec>::NumLanes;
+
+  for (ezUInt32 uiFirst = 0; uiFirst < uiCount; uiFirst += uiBatchSize)
+  {
+    TransformationData* pBatchData = pData + uiFirst;
+    const ezUInt32 uiBatchCount = ezMath::Min(uiCount - uiFirst, uiBatchSize);
+
+    ezSimdTransformBatchDefault globalTransforms;
+    LoadLocalTransforms(pBatchData, uiBatchCount, globalTransforms);
+    StoreGlobalTransforms(pBatchData, uiBatchCount, globalTransforms);
+
+    ezSimdBBoxSphereBatchDefault bounds;
+    LoadLocalBounds(pBatchData, uiBatchCount, bounds);
+    bounds.Transform(globalTransforms);
+    StoreGlobalBounds(pBatchData, uiBatchCount, bounds);
+  }
+}
+
+// static
+void ezGameObject::TransformationData::UpdateGlobalTransformsAndBoundsWithParent(TransformationData* pData, ezUInt32 uiCount)
+{
+  constexpr ezUInt32 uiBatchSize = ezSimdBatchTraits<ezSimdBatchVec>::NumLanes;
+
+  for (ezUInt32 uiFirst = 0; uiFirst < uiCount; uiFirst += uiBatchSize)
+  {
+    TransformationData* pBatchData = pData + uiFirst;
+    const ezUInt32 uiBatchCount = ezMath::Min(uiCount - uiFirst, uiBatchSize);
+
+    ezSimdTransformBatchDefault parentTransforms;
+    LoadParentGlobalTransforms(pBatchData, uiBatchCount, parentTransforms);
+
+    ezSimdTransformBatchDefault localTransforms;
+    LoadLocalTransforms(pBatchData, uiBatchCount, localTransforms);
+
+    const ezSimdTransformBatchDefault globalTransforms = parentTransforms * localTransforms;
+    StoreGlobalTransforms(pBatchData, uiBatchCount, globalTransforms);
+
+    ezSimdBBoxSphereBatchDefault bounds;
+    LoadLocalBounds(pBatchData, uiBatchCount, bounds);
+    bounds.Transform(globalTransforms);
+    StoreGlobalBounds(pBatchData, uiBatchCount, bounds);
+  }
+}
+
 EZ_STATICLINK_FILE(Core, Core_World_Implementation_GameObject);
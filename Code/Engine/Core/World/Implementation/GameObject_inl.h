@@ -574,6 +574,74 @@ EZ_FORCE_INLINE void ezGameObject::TransformationData::UpdateGlobalBoundsAndSpat
   }
 }
 
+// static
+template <typename VEC>
+EZ_FORCE_INLINE void ezGameObject::TransformationData::LoadLocalTransforms(
+  const TransformationData* pData, ezUInt32 uiCount, ezSimdTransformBatch<VEC>& out_Transforms)
+{
+  out_Transforms.m_Position.Load(uiCount, [pData](ezUInt32 i) -> const ezSimdVec4f& { return pData[i].m_localPosition; });
+  out_Transforms.m_Rotation.Load(uiCount, [pData](ezUInt32 i) -> const ezSimdQuat& { return pData[i].m_localRotation; });
+
+  // the w component of the local scaling is the uniform scale
+  VEC uniformScale;
+  ezInternal::SimdBatchLoad<VEC>(uiCount, [pData](ezUInt32 i) -> const ezSimdVec4f& { return pData[i].m_localScaling; },
+    out_Transforms.m_Scale.x, out_Transforms.m_Scale.y, out_Transforms.m_Scale.z, uniformScale);
+  out_Transforms.m_Scale = out_Transforms.m_Scale * uniformScale;
+}
+
+// static
+template <typename VEC>
+EZ_FORCE_INLINE void ezGameObject::TransformationData::LoadParentGlobalTransforms(
+  const TransformationData* pData, ezUInt32 uiCount, ezSimdTransformBatch<VEC>& out_Transforms)
+{
+  out_Transforms.Load(uiCount, [pData](ezUInt32 i) -> const ezSimdTransform& { return pData[i].m_pParentData->m_globalTransform; });
+}
+
+// static
+template <typename VEC>
+EZ_FORCE_INLINE void ezGameObject::TransformationData::LoadGlobalTransforms(
+  const TransformationData* pData, ezUInt32 uiCount, ezSimdTransformBatch<VEC>& out_Transforms)
+{
+  out_Transforms.Load(uiCount, [pData](ezUInt32 i) -> const ezSimdTransform& { return pData[i].m_globalTransform; });
+}
+
+// static
+template <typename VEC>
+EZ_FORCE_INLINE void ezGameObject::TransformationData::StoreGlobalTransforms(
+  TransformationData* pData, ezUInt32 uiCount, const ezSimdTransformBatch<VEC>& transforms)
+{
+  transforms.Store(uiCount, [pData](ezUInt32 i) -> ezSimdTransform& { return pData[i].m_globalTransform; });
+}
+
+// static
+template <typename VEC>
+EZ_FORCE_INLINE void ezGameObject::TransformationData::LoadLocalBounds(
+  const TransformationData* pData, ezUInt32 uiCount, ezSimdBBoxSphereBatch<VEC>& out_Bounds)
+{
+  out_Bounds.Load(uiCount, [pData](ezUInt32 i) -> const ezSimdBBoxSphere& { return pData[i].m_localBounds; });
+}
+
+// static
+template <typename VEC>
+EZ_FORCE_INLINE void ezGameObject::TransformationData::LoadGlobalBounds(
+  const TransformationData* pData, ezUInt32 uiCount, ezSimdBBoxSphereBatch<VEC>& out_Bounds)
+{
+  out_Bounds.Load(uiCount, [pData](ezUInt32 i) -> const ezSimdBBoxSphere& { return pData[i].m_globalBounds; });
+}
+
+// static
+template <typename VEC>
+EZ_FORCE_INLINE void ezGameObject::TransformationData::StoreGlobalBounds(
+  TransformationData* pData, ezUInt32 uiCount, const ezSimdBBoxSphereBatch<VEC>& bounds)
+{
+  bounds.Store(uiCount, [pData](ezUInt32 i) -> ezSimdBBoxSphere& { return pData[i].m_globalBounds; });
+
+  for (ezUInt32 i = 0; i < uiCount; ++i)
+  {
+    pData[i].m_globalBounds.m_BoxHalfExtents.SetW(pData[i].m_localBounds.m_BoxHalfExtents.w());
+  }
+}
+
 EZ_ALWAYS_INLINE void ezGameObject::TransformationData::UpdateVelocity(const ezSimdFloat& fInvDeltaSeconds)
 {
 #if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
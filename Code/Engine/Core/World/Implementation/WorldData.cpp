@@ -289,21 +289,21 @@ namespace ezInternal
     userData.m_fInvDt = fInvDeltaSeconds;
     userData.m_pSpatialSystem = m_pSpatialSystem.Borrow();
 
-    struct RootLevel
+    struct RootLevelBlock
     {
-      EZ_ALWAYS_INLINE static ezVisitorExecution::Enum Visit(ezGameObject::TransformationData* pData, void* pUserData)
+      EZ_ALWAYS_INLINE static void VisitBlock(ezGameObject::TransformationData* pData, ezUInt32 uiCount, void* pUserData)
       {
-        WorldData::UpdateGlobalTransform(pData, static_cast<UserData*>(pUserData)->m_fInvDt);
-        return ezVisitorExecution::Continue;
+        ezGameObject::TransformationData::UpdateGlobalTransformsAndBounds(pData, uiCount);
+        WorldData::UpdateVelocities(pData, uiCount, static_cast<UserData*>(pUserData)->m_fInvDt);
       }
     };
 
-    struct WithParent
+    struct WithParentBlock
     {
-      EZ_ALWAYS_INLINE static ezVisitorExecution::Enum Visit(ezGameObject::TransformationData* pData, void* pUserData)
+      EZ_ALWAYS_INLINE static void VisitBlock(ezGameObject::TransformationData* pData, ezUInt32 uiCount, void* pUserData)
       {
-        WorldData::UpdateGlobalTransformWithParent(pData, static_cast<UserData*>(pUserData)->m_fInvDt);
-        return ezVisitorExecution::Continue;
+        ezGameObject::TransformationData::UpdateGlobalTransformsAndBoundsWithParent(pData, uiCount);
+        WorldData::UpdateVelocities(pData, uiCount, static_cast<UserData*>(pUserData)->m_fInvDt);
       }
     };
 
@@ -336,11 +336,12 @@ namespace ezInternal
       // have to acquire a write lock in the process.
       if (m_pSpatialSystem == nullptr)
       {
-        TraverseHierarchyLevelMultiThreaded<RootLevel>(*dataPtr[0], &userData);
+        // The transforms and bounds are computed in SIMD batches here.
+        TraverseHierarchyLevelBlocksMultiThreaded<RootLevelBlock>(*dataPtr[0], &userData);
 
         for (ezUInt32 i = 1; i < hierarchy.m_Data.GetCount(); ++i)
         {
-          TraverseHierarchyLevelMultiThreaded<WithParent>(*dataPtr[i], &userData);
+          TraverseHierarchyLevelBlocksMultiThreaded<WithParentBlock>(*dataPtr[i], &userData);
         }
       }
       else
@@ -59,20 +59,32 @@ namespace ezInternal
     return ezVisitorExecution::Continue;
   }
 
-  // static
-  EZ_FORCE_INLINE void WorldData::UpdateGlobalTransform(ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDeltaSeconds)
+  template <typename VISITOR>
+  EZ_FORCE_INLINE void WorldData::TraverseHierarchyLevelBlocksMultiThreaded(Hierarchy::DataBlockArray& blocks, void* pUserData /* = nullptr*/)
   {
-    pData->UpdateGlobalTransform();
-    pData->UpdateVelocity(fInvDeltaSeconds);
-    pData->UpdateGlobalBounds();
+    ezParallelForParams parallelForParams;
+    parallelForParams.uiBinSize = 100;
+    parallelForParams.uiMaxTasksPerThread = 2;
+    parallelForParams.pTaskAllocator = m_StackAllocator.GetCurrentAllocator();
+
+    ezTaskSystem::ParallelFor(
+      blocks.GetArrayPtr(),
+      [pUserData](ezArrayPtr<WorldData::Hierarchy::DataBlock> blocksSlice) {
+        for (WorldData::Hierarchy::DataBlock& block : blocksSlice)
+        {
+          VISITOR::VisitBlock(block.m_pData, block.m_uiCount, pUserData);
+        }
+      },
+      "World DataBlock Traversal Task", parallelForParams);
   }
 
   // static
-  EZ_FORCE_INLINE void WorldData::UpdateGlobalTransformWithParent(ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDeltaSeconds)
+  EZ_FORCE_INLINE void WorldData::UpdateVelocities(ezGameObject::TransformationData* pData, ezUInt32 uiCount, const ezSimdFloat& fInvDeltaSeconds)
   {
-    pData->UpdateGlobalTransformWithParent();
-    pData->UpdateVelocity(fInvDeltaSeconds);
-    pData->UpdateGlobalBounds();
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      pData[i].UpdateVelocity(fInvDeltaSeconds);
+    }
   }
 
   // static
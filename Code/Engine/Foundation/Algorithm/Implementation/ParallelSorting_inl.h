@@ -0,0 +1,151 @@
+#pragma once
+
+template <typename T, typename Comparer>
+void ezParallelSorting::MergeSort(ezArrayPtr<T> arrayPtr, ezArrayPtr<T> scratchPtr, const Comparer& comparer, const char* szTaskName)
+{
+  const ezUInt32 uiCount = arrayPtr.GetCount();
+  const ezUInt32 uiNumThreads = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+
+  if (uiCount < PARALLEL_THRESHOLD || uiNumThreads < 2)
+  {
+    ezSorting::MergeSort(arrayPtr, scratchPtr, comparer);
+    return;
+  }
+
+  EZ_ASSERT_DEV(scratchPtr.GetCount() >= uiCount, "The scratch array needs at least {} elements, but only has {}.", uiCount, scratchPtr.GetCount());
+
+  // a power of two, so that the chunks can be merged pairwise
+  ezUInt32 uiNumChunks = 1;
+  while (uiNumChunks < uiNumThreads * 2 && uiCount / (uiNumChunks * 2) >= MIN_CHUNK_SIZE)
+  {
+    uiNumChunks *= 2;
+  }
+
+  struct SortState
+  {
+    EZ_ALWAYS_INLINE ezUInt32 GetChunkStart(ezUInt32 uiChunk) const
+    {
+      return static_cast<ezUInt32>(static_cast<ezUInt64>(m_uiCount) * uiChunk / m_uiNumChunks);
+    }
+
+    T* m_pSrc;
+    T* m_pDst;
+    T* m_pScratch;
+    ezUInt32 m_uiCount;
+    ezUInt32 m_uiNumChunks;
+    ezUInt32 m_uiChunksPerRun;
+    const Comparer* m_pComparer;
+  };
+
+  SortState state;
+  state.m_pSrc = arrayPtr.GetPtr();
+  state.m_pDst = scratchPtr.GetPtr();
+  state.m_pScratch = scratchPtr.GetPtr();
+  state.m_uiCount = uiCount;
+  state.m_uiNumChunks = uiNumChunks;
+  state.m_uiChunksPerRun = 1;
+  state.m_pComparer = &comparer;
+
+  ezTaskSystem::ParallelForIndexed(
+    0, uiNumChunks,
+    [&state](ezUInt32 uiStartChunk, ezUInt32 uiEndChunk) {
+      for (ezUInt32 uiChunk = uiStartChunk; uiChunk < uiEndChunk; ++uiChunk)
+      {
+        const ezUInt32 uiStart = state.GetChunkStart(uiChunk);
+        const ezUInt32 uiChunkCount = state.GetChunkStart(uiChunk + 1) - uiStart;
+
+        ezSorting::MergeSort(ezArrayPtr<T>(state.m_pSrc + uiStart, uiChunkCount), ezArrayPtr<T>(state.m_pScratch + uiStart, uiChunkCount), *state.m_pComparer);
+      }
+    },
+    szTaskName);
+
+  // Every round merges pairs of runs. Each merge is split into as many pieces as the runs have chunks,
+  // so every round consists of uiNumChunks pieces of roughly the same size.
+  for (; state.m_uiChunksPerRun < uiNumChunks; state.m_uiChunksPerRun *= 2)
+  {
+    ezTaskSystem::ParallelForIndexed(
+      0, uiNumChunks,
+      [&state](ezUInt32 uiStartPiece, ezUInt32 uiEndPiece) {
+        const ezUInt32 uiPiecesPerMerge = state.m_uiChunksPerRun * 2;
+
+        for (ezUInt32 uiPiece = uiStartPiece; uiPiece < uiEndPiece; ++uiPiece)
+        {
+          const ezUInt32 uiFirstChunk = uiPiece - (uiPiece % uiPiecesPerMerge);
+          const ezUInt32 uiLeft = state.GetChunkStart(uiFirstChunk);
+          const ezUInt32 uiMid = state.GetChunkStart(uiFirstChunk + state.m_uiChunksPerRun);
+          const ezUInt32 uiRight = state.GetChunkStart(uiFirstChunk + uiPiecesPerMerge);
+
+          const T* pFirst = state.m_pSrc + uiLeft;
+          const T* pSecond = state.m_pSrc + uiMid;
+          const ezUInt32 uiFirstCount = uiMid - uiLeft;
+          const ezUInt32 uiSecondCount = uiRight - uiMid;
+
+          const ezUInt64 uiTotalCount = uiRight - uiLeft;
+          const ezUInt32 uiPieceIndex = uiPiece % uiPiecesPerMerge;
+          const ezUInt32 uiOutStart = static_cast<ezUInt32>(uiTotalCount * uiPieceIndex / uiPiecesPerMerge);
+          const ezUInt32 uiOutEnd = static_cast<ezUInt32>(uiTotalCount * (uiPieceIndex + 1) / uiPiecesPerMerge);
+
+          const ezUInt32 uiFirstStart = FindMergeSplit(uiOutStart, pFirst, uiFirstCount, pSecond, uiSecondCount, *state.m_pComparer);
+          const ezUInt32 uiFirstEnd = FindMergeSplit(uiOutEnd, pFirst, uiFirstCount, pSecond, uiSecondCount, *state.m_pComparer);
+          const ezUInt32 uiSecondStart = uiOutStart - uiFirstStart;
+          const ezUInt32 uiSecondEnd = uiOutEnd - uiFirstEnd;
+
+          ezSorting::Merge(state.m_pSrc + uiLeft + uiFirstStart, uiFirstEnd - uiFirstStart, state.m_pSrc + uiMid + uiSecondStart,
+            uiSecondEnd - uiSecondStart, state.m_pDst + uiLeft + uiOutStart, *state.m_pComparer);
+        }
+      },
+      szTaskName);
+
+    ezMath::Swap(state.m_pSrc, state.m_pDst);
+  }
+
+  if (state.m_pSrc != arrayPtr.GetPtr())
+  {
+    ezTaskSystem::ParallelForIndexed(
+      0, uiNumChunks,
+      [&state](ezUInt32 uiStartChunk, ezUInt32 uiEndChunk) {
+        const ezUInt32 uiStart = state.GetChunkStart(uiStartChunk);
+        const ezUInt32 uiEnd = state.GetChunkStart(uiEndChunk);
+
+        for (ezUInt32 i = uiStart; i < uiEnd; ++i)
+        {
+          state.m_pDst[i] = std::move(state.m_pSrc[i]);
+        }
+      },
+      szTaskName);
+  }
+}
+
+template <typename T, typename Comparer>
+void ezParallelSorting::MergeSort(ezArrayPtr<T> arrayPtr, const Comparer& comparer, const char* szTaskName, ezAllocatorBase* pAllocator)
+{
+  if (arrayPtr.GetCount() < 2)
+    return;
+
+  ezDynamicArray<T> scratch(pAllocator);
+  scratch.SetCount(arrayPtr.GetCount());
+
+  MergeSort(arrayPtr, scratch.GetArrayPtr(), comparer, szTaskName);
+}
+
+template <typename T, typename Comparer>
+ezUInt32 ezParallelSorting::FindMergeSplit(
+  ezUInt32 uiOutputIndex, const T* pFirst, ezUInt32 uiFirstCount, const T* pSecond, ezUInt32 uiSecondCount, const Comparer& comparer)
+{
+  ezUInt32 uiLow = uiOutputIndex > uiSecondCount ? uiOutputIndex - uiSecondCount : 0;
+  ezUInt32 uiHigh = ezMath::Min(uiOutputIndex, uiFirstCount);
+
+  while (uiLow < uiHigh)
+  {
+    const ezUInt32 i = (uiLow + uiHigh) / 2;
+    const ezUInt32 j = uiOutputIndex - i - 1;
+
+    // pFirst[i] comes before pSecond[j] on ties, so it is part of the output range, if it is not larger
+    if (!ezSorting::DoCompare(comparer, pSecond[j], pFirst[i]))
+      uiLow = i + 1;
+    else
+      uiHigh = i;
+  }
+
+  return uiLow;
+}
@@ -153,3 +153,147 @@ void ezSorting::InsertionSort(ezArrayPtr<T>& arrayPtr, ezUInt32 uiStartIndex, ez
     }
   }
 }
+
+template <typename T, typename Comparer>
+void ezSorting::MergeSort(ezArrayPtr<T> arrayPtr, ezArrayPtr<T> scratchPtr, const Comparer& comparer)
+{
+  const ezUInt32 uiCount = arrayPtr.GetCount();
+
+  if (uiCount < 2)
+    return;
+
+  EZ_ASSERT_DEV(scratchPtr.GetCount() >= uiCount, "The scratch array needs at least {} elements, but only has {}.", uiCount, scratchPtr.GetCount());
+
+  // short runs are sorted in place, because insertion sort is faster than merging for them
+  for (ezUInt32 uiStart = 0; uiStart < uiCount; uiStart += MERGE_RUN_LENGTH)
+  {
+    InsertionSort(arrayPtr, uiStart, ezMath::Min(uiStart + MERGE_RUN_LENGTH, uiCount) - 1, comparer);
+  }
+
+  T* pSrc = arrayPtr.GetPtr();
+  T* pDst = scratchPtr.GetPtr();
+
+  for (ezUInt32 uiWidth = MERGE_RUN_LENGTH; uiWidth < uiCount; uiWidth *= 2)
+  {
+    for (ezUInt32 uiLeft = 0; uiLeft < uiCount; uiLeft += 2 * uiWidth)
+    {
+      const ezUInt32 uiMid = ezMath::Min(uiLeft + uiWidth, uiCount);
+      const ezUInt32 uiRight = ezMath::Min(uiMid + uiWidth, uiCount);
+
+      Merge(pSrc + uiLeft, uiMid - uiLeft, pSrc + uiMid, uiRight - uiMid, pDst + uiLeft, comparer);
+    }
+
+    ezMath::Swap(pSrc, pDst);
+  }
+
+  if (pSrc != arrayPtr.GetPtr())
+  {
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      pDst[i] = std::move(pSrc[i]);
+    }
+  }
+}
+
+template <typename T, typename KeyExtractor>
+void ezSorting::RadixSort(ezArrayPtr<T> arrayPtr, ezArrayPtr<T> scratchPtr, const KeyExtractor& keyExtractor)
+{
+  using KeyType = typename std::decay<decltype(keyExtractor(arrayPtr[0]))>::type;
+  static_assert(std::is_integral<KeyType>::value && std::is_unsigned<KeyType>::value, "The key extractor has to return an unsigned integer.");
+
+  const ezUInt32 uiCount = arrayPtr.GetCount();
+
+  if (uiCount < 2)
+    return;
+
+  if (uiCount <= RADIX_INSERTION_THRESHOLD)
+  {
+    InsertionSort(arrayPtr, 0, uiCount - 1, [&](const T& a, const T& b) { return keyExtractor(a) < keyExtractor(b); });
+    return;
+  }
+
+  EZ_ASSERT_DEV(scratchPtr.GetCount() >= uiCount, "The scratch array needs at least {} elements, but only has {}.", uiCount, scratchPtr.GetCount());
+
+  // wider digits need fewer passes, but their histograms only fit into the L1 cache alongside the data for large arrays
+  constexpr ezUInt32 uiKeyBits = sizeof(KeyType) * 8;
+  const ezUInt32 uiDigitBits = (uiCount >= RADIX_WIDE_DIGIT_THRESHOLD && uiKeyBits > 8) ? 11 : 8;
+  const ezUInt32 uiNumBuckets = 1u << uiDigitBits;
+  const ezUInt32 uiNumPasses = (uiKeyBits + uiDigitBits - 1) / uiDigitBits;
+  const KeyType digitMask = static_cast<KeyType>(uiNumBuckets - 1);
+
+  // count the digits of all passes at once, to only read the keys once for this
+  ezUInt32* pHistograms = EZ_DEFAULT_NEW_RAW_BUFFER(ezUInt32, uiNumBuckets * uiNumPasses);
+  ezMemoryUtils::ZeroFill(pHistograms, uiNumBuckets * uiNumPasses);
+
+  for (ezUInt32 i = 0; i < uiCount; ++i)
+  {
+    const KeyType key = keyExtractor(arrayPtr[i]);
+
+    for (ezUInt32 uiPass = 0; uiPass < uiNumPasses; ++uiPass)
+    {
+      ++pHistograms[uiPass * uiNumBuckets + ((key >> (uiPass * uiDigitBits)) & digitMask)];
+    }
+  }
+
+  const KeyType firstKey = keyExtractor(arrayPtr[0]);
+
+  T* pSrc = arrayPtr.GetPtr();
+  T* pDst = scratchPtr.GetPtr();
+
+  for (ezUInt32 uiPass = 0; uiPass < uiNumPasses; ++uiPass)
+  {
+    const ezUInt32 uiShift = uiPass * uiDigitBits;
+    ezUInt32* pOffsets = pHistograms + uiPass * uiNumBuckets;
+
+    // nothing to do, if all elements have the same digit
+    if (pOffsets[(firstKey >> uiShift) & digitMask] == uiCount)
+      continue;
+
+    ezUInt32 uiOffset = 0;
+    for (ezUInt32 uiBucket = 0; uiBucket < uiNumBuckets; ++uiBucket)
+    {
+      const ezUInt32 uiBucketCount = pOffsets[uiBucket];
+      pOffsets[uiBucket] = uiOffset;
+      uiOffset += uiBucketCount;
+    }
+
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      const ezUInt32 uiBucket = static_cast<ezUInt32>((keyExtractor(pSrc[i]) >> uiShift) & digitMask);
+      pDst[pOffsets[uiBucket]++] = std::move(pSrc[i]);
+    }
+
+    ezMath::Swap(pSrc, pDst);
+  }
+
+  EZ_DEFAULT_DELETE_RAW_BUFFER(pHistograms);
+
+  if (pSrc != arrayPtr.GetPtr())
+  {
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      pDst[i] = std::move(pSrc[i]);
+    }
+  }
+}
+
+template <typename T, typename Comparer>
+void ezSorting::Merge(T* pFirst, ezUInt32 uiFirstCount, T* pSecond, ezUInt32 uiSecondCount, T* pOut, const Comparer& comparer)
+{
+  ezUInt32 a = 0;
+  ezUInt32 b = 0;
+
+  while (a < uiFirstCount && b < uiSecondCount)
+  {
+    if (DoCompare(comparer, pSecond[b], pFirst[a]))
+      *pOut++ = std::move(pSecond[b++]);
+    else
+      *pOut++ = std::move(pFirst[a++]);
+  }
+
+  while (a < uiFirstCount)
+    *pOut++ = std::move(pFirst[a++]);
+
+  while (b < uiSecondCount)
+    *pOut++ = std::move(pSecond[b++]);
+}
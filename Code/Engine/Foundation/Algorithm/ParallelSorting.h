@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Foundation/Algorithm/Sorting.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Threading/TaskSystem.h>
+
+/// \brief Multi-threaded sorting algorithms that distribute their work with ezTaskSystem::ParallelForIndexed().
+class ezParallelSorting
+{
+public:
+  /// \brief Sorts the elements in the array using a multi-threaded merge sort (stable, not in-place).
+  ///
+  /// The array is split into chunks that are sorted with ezSorting::MergeSort() in parallel. The sorted chunks are then merged pairwise,
+  /// where every merge is split into several independent pieces as well, so that the last merges do not run on a single thread.
+  /// Small arrays, or a task system without worker threads, fall back to ezSorting::MergeSort().
+  ///
+  /// \a scratchPtr has the same requirements as for ezSorting::MergeSort(). Its content is undefined afterwards.
+  template <typename T, typename Comparer>
+  static void MergeSort(ezArrayPtr<T> arrayPtr, ezArrayPtr<T> scratchPtr, const Comparer& comparer = Comparer(), const char* szTaskName = nullptr); // [tested]
+
+  /// \brief Same as above, but allocates the scratch array from the given allocator.
+  template <typename T, typename Comparer>
+  static void MergeSort(ezArrayPtr<T> arrayPtr, const Comparer& comparer = Comparer(), const char* szTaskName = nullptr,
+    ezAllocatorBase* pAllocator = ezFoundation::GetDefaultAllocator()); // [tested]
+
+private:
+  enum
+  {
+    /// Below this number of elements the overhead of scheduling tasks outweighs the gains.
+    PARALLEL_THRESHOLD = 16 * 1024,
+
+    /// Every chunk that is sorted on its own has at least this many elements.
+    MIN_CHUNK_SIZE = 4 * 1024,
+  };
+
+  /// \brief Returns how many elements of the first range end up in the first uiOutputIndex elements of the merged range.
+  template <typename T, typename Comparer>
+  static ezUInt32 FindMergeSplit(
+    ezUInt32 uiOutputIndex, const T* pFirst, ezUInt32 uiFirstCount, const T* pSecond, ezUInt32 uiSecondCount, const Comparer& comparer);
+};
+
+#include <Foundation/Algorithm/Implementation/ParallelSorting_inl.h>
@@ -27,10 +27,33 @@ public:
   template <typename T, typename Comparer>
   static void InsertionSort(ezArrayPtr<T>& arrayPtr, const Comparer& comparer = Comparer()); // [tested]
 
+  /// \brief Sorts the elements in the array using a bottom-up merge sort (stable, not in-place).
+  ///
+  /// \a scratchPtr must hold at least as many (constructed) elements as \a arrayPtr. The elements are moved back and forth between both
+  /// arrays, so the content of \a scratchPtr is undefined afterwards. See ezParallelSorting::MergeSort() for a multi-threaded version.
+  template <typename T, typename Comparer>
+  static void MergeSort(ezArrayPtr<T> arrayPtr, ezArrayPtr<T> scratchPtr, const Comparer& comparer = Comparer()); // [tested]
+
+  /// \brief Sorts the elements in the array by an unsigned integer key using a LSD radix sort (stable, not in-place).
+  ///
+  /// \a keyExtractor is called as keyExtractor(const T&) and has to return an unsigned integer type. Signed or floating point keys have
+  /// to be mapped to an unsigned integer with the same ordering by the caller. The keys are processed with 8 bit digits, or with 11 bit
+  /// digits for large arrays, and digits that are the same for all elements are skipped. Thus sorting 64 bit keys that only use their
+  /// lower bits does not cost more passes than sorting 32 bit keys.
+  ///
+  /// \a scratchPtr has the same requirements as for MergeSort(). Its content is undefined afterwards.
+  template <typename T, typename KeyExtractor>
+  static void RadixSort(ezArrayPtr<T> arrayPtr, ezArrayPtr<T> scratchPtr, const KeyExtractor& keyExtractor); // [tested]
+
 private:
+  friend class ezParallelSorting;
+
   enum
   {
-    INSERTION_THRESHOLD = 16
+    INSERTION_THRESHOLD = 16,
+    MERGE_RUN_LENGTH = 32,
+    RADIX_INSERTION_THRESHOLD = 64,
+    RADIX_WIDE_DIGIT_THRESHOLD = 64 * 1024,
   };
 
   // Perform comparison either with "Less(a,b)" (prefered) or with operator ()(a,b)
@@ -72,6 +95,11 @@ private:
 
   template <typename T, typename Comparer>
   static void InsertionSort(ezArrayPtr<T>& arrayPtr, ezUInt32 uiStartIndex, ezUInt32 uiEndIndex, const Comparer& comparer);
+
+
+  /// \brief Moves the two sorted ranges into pOut in sorted order. On ties the elements from the first range come first.
+  template <typename T, typename Comparer>
+  static void Merge(T* pFirst, ezUInt32 uiFirstCount, T* pSecond, ezUInt32 uiSecondCount, T* pOut, const Comparer& comparer);
 };
 
 #include <Foundation/Algorithm/Implementation/Sorting_inl.h>
@@ -67,6 +67,16 @@
 #include <Foundation/Configuration/StaticSubSystem.h>
 #include <Foundation/Strings/FormatString.h>
 
+/// \brief Selects the allocator that ezFoundation creates as its default allocator, see ezFoundation::SetDefaultHeapType().
+struct ezDefaultHeapType
+{
+  enum Enum
+  {
+    Platform, ///< ezHeapAllocator, which forwards to the CRT heap.
+    Scalable, ///< ezScalableHeapAllocator, which serves small allocations from per-thread heaps.
+  };
+};
+
 class EZ_FOUNDATION_DLL ezFoundation
 {
 public:
@@ -92,6 +102,16 @@ public:
     return s_pAlignedAllocator;
   }
 
+  /// \brief Selects which allocator is created as the default allocator.
+  ///
+  /// Has to be called before ezFoundation is initialized, i.e. before the first startup stage runs.
+  /// If EZ_USE_SCALABLE_HEAP is enabled, the default is ezDefaultHeapType::Scalable, otherwise ezDefaultHeapType::Platform.
+  /// Guarded allocations (EZ_USE_GUARDED_ALLOCATIONS) take precedence over this setting.
+  static void SetDefaultHeapType(ezDefaultHeapType::Enum type);
+
+  /// \brief Returns which allocator is (or will be) used as the default allocator.
+  static ezDefaultHeapType::Enum GetDefaultHeapType() { return s_DefaultHeapType; }
+
 private:
   friend class ezStartup;
   friend struct ezStaticAllocatorWrapper;
@@ -102,4 +122,5 @@ private:
   static ezAllocatorBase* GetStaticAllocator();
 
   static bool s_bIsInitialized;
+  static ezDefaultHeapType::Enum s_DefaultHeapType;
 };
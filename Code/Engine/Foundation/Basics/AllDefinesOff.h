@@ -68,10 +68,16 @@
 #define EZ_USE_ALLOCATION_TRACKING EZ_OFF
 #define EZ_USE_ALLOCATION_STACK_TRACING EZ_OFF
 #define EZ_USE_GUARDED_ALLOCATIONS EZ_OFF
+/// \brief Makes ezScalableHeapAllocator the default heap instead of ezHeapAllocator, see ezFoundation::SetDefaultHeapType().
+#define EZ_USE_SCALABLE_HEAP EZ_OFF
 
 // Other Features
 #define EZ_USE_PROFILING EZ_OFF
 
+// Compiler Features
+/// \brief Enabled when the compiler supports C++20 coroutines (e.g. when compiling with C++20 or later), see ezTaskCoroutine.
+#define EZ_SUPPORTS_COROUTINES EZ_OFF
+
 // Hashed String
 /// \brief Ref counting on hashed strings adds the possibility to cleanup unused strings. Since ref counting has a performance overhead it is disabled
 /// by default.
@@ -85,3 +91,6 @@
 #define EZ_SIMD_IMPLEMENTATION_SSE 2
 
 #define EZ_SIMD_IMPLEMENTATION 0
+
+// Whether the 8-wide SIMD types (ezSimdVec8f etc.) map to native 256 bit registers, otherwise they are emulated with two 4-wide vectors
+#define EZ_SIMD_NATIVE_VEC8 EZ_OFF
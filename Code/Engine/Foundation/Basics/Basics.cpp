@@ -4,10 +4,12 @@
 
 #if EZ_ENABLED(EZ_USE_GUARDED_ALLOCATIONS)
 typedef ezGuardedAllocator DefaultHeapType;
+typedef ezGuardedAllocator DefaultScalableHeapType;
 typedef ezGuardedAllocator DefaultAlignedHeapType;
 typedef ezGuardedAllocator DefaultStaticHeapType;
 #else
 typedef ezHeapAllocator DefaultHeapType;
+typedef ezScalableHeapAllocator DefaultScalableHeapType;
 typedef ezAlignedHeapAllocator DefaultAlignedHeapType;
 typedef ezHeapAllocator DefaultStaticHeapType;
 #endif
@@ -15,10 +17,12 @@ typedef ezHeapAllocator DefaultStaticHeapType;
 enum
 {
   HEAP_ALLOCATOR_BUFFER_SIZE = sizeof(DefaultHeapType),
+  DEFAULT_ALLOCATOR_BUFFER_SIZE = EZ_COMPILE_TIME_MAX(sizeof(DefaultHeapType), sizeof(DefaultScalableHeapType)),
+  DEFAULT_ALLOCATOR_ALIGNMENT = EZ_COMPILE_TIME_MAX(EZ_ALIGNMENT_OF(DefaultHeapType), EZ_ALIGNMENT_OF(DefaultScalableHeapType)),
   ALIGNED_ALLOCATOR_BUFFER_SIZE = sizeof(DefaultAlignedHeapType)
 };
 
-EZ_ALIGN_VARIABLE(static ezUInt8 s_DefaultAllocatorBuffer[HEAP_ALLOCATOR_BUFFER_SIZE], EZ_ALIGNMENT_MINIMUM);
+EZ_ALIGN_VARIABLE(static ezUInt8 s_DefaultAllocatorBuffer[DEFAULT_ALLOCATOR_BUFFER_SIZE], DEFAULT_ALLOCATOR_ALIGNMENT);
 EZ_ALIGN_VARIABLE(static ezUInt8 s_StaticAllocatorBuffer[HEAP_ALLOCATOR_BUFFER_SIZE], EZ_ALIGNMENT_MINIMUM);
 
 EZ_ALIGN_VARIABLE(static ezUInt8 s_AlignedAllocatorBuffer[ALIGNED_ALLOCATOR_BUFFER_SIZE], EZ_ALIGNMENT_MINIMUM);
@@ -27,6 +31,18 @@ bool ezFoundation::s_bIsInitialized = false;
 ezAllocatorBase* ezFoundation::s_pDefaultAllocator = nullptr;
 ezAllocatorBase* ezFoundation::s_pAlignedAllocator = nullptr;
 
+#if EZ_ENABLED(EZ_USE_SCALABLE_HEAP)
+ezDefaultHeapType::Enum ezFoundation::s_DefaultHeapType = ezDefaultHeapType::Scalable;
+#else
+ezDefaultHeapType::Enum ezFoundation::s_DefaultHeapType = ezDefaultHeapType::Platform;
+#endif
+
+void ezFoundation::SetDefaultHeapType(ezDefaultHeapType::Enum type)
+{
+  EZ_ASSERT_DEV(!s_bIsInitialized, "The default heap type has to be selected before ezFoundation is initialized.");
+  s_DefaultHeapType = type;
+}
+
 void ezFoundation::Initialize()
 {
   if (s_bIsInitialized)
@@ -38,7 +54,10 @@ void ezFoundation::Initialize()
 
   if (s_pDefaultAllocator == nullptr)
   {
-    s_pDefaultAllocator = new (s_DefaultAllocatorBuffer) DefaultHeapType("DefaultHeap");
+    if (s_DefaultHeapType == ezDefaultHeapType::Scalable)
+      s_pDefaultAllocator = new (s_DefaultAllocatorBuffer) DefaultScalableHeapType("DefaultHeap");
+    else
+      s_pDefaultAllocator = new (s_DefaultAllocatorBuffer) DefaultHeapType("DefaultHeap");
   }
 
   if (s_pAlignedAllocator == nullptr)
@@ -33,6 +33,16 @@
 #  define EZ_NODISCARD
 #endif
 
+#ifndef __has_include
+#  define __has_include(header) 0
+#endif
+
+// C++20 coroutines
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#  undef EZ_SUPPORTS_COROUTINES
+#  define EZ_SUPPORTS_COROUTINES EZ_ON
+#endif
+
 #ifndef __INTELLISENSE__
 
 // Macros to do compile-time checks, such as to ensure sizes of types
@@ -0,0 +1,434 @@
+#pragma once
+
+#include <Foundation/Algorithm/Comparer.h>
+#include <Foundation/Memory/AllocatorWrapper.h>
+
+namespace ezInternal
+{
+  /// \brief Returns how many entries of the given size are stored in one node of an ezBTreeMap. Nodes are roughly 512 bytes large.
+  constexpr ezUInt32 GetBTreeNodeCapacity(ezUInt32 uiBytesPerEntry)
+  {
+    return (512 / uiBytesPerEntry) < 8 ? 8 : ((512 / uiBytesPerEntry) > 64 ? 64 : (512 / uiBytesPerEntry));
+  }
+
+  /// \brief Uninitialized, correctly aligned storage for Count objects of type T.
+  template <typename T, ezUInt32 Count>
+  struct BTreeNodeStorage : ezAligned<EZ_ALIGNMENT_OF(T)>
+  {
+    EZ_ALWAYS_INLINE T* GetPtr() { return reinterpret_cast<T*>(m_Data); }
+
+    ezUInt8 m_Data[Count * sizeof(T)];
+  };
+} // namespace ezInternal
+
+/// \brief An associative container with the same interface as ezMap, implemented as a B+-tree.
+///
+/// Instead of one allocation per element, the key/value pairs are stored in sorted order in wide leaf nodes (roughly 512 bytes each),
+/// which are linked to each other for in-order iteration. A lookup only visits about log64(n) nodes and the keys of each node are
+/// stored consecutively, so it touches far fewer cache lines than the pointer chasing through an ezMap.
+/// All insertion/erasure/lookup functions take O(log n) time.
+///
+/// Contrary to ezMap, inserting or removing elements moves other elements around inside the tree. Therefore all iterators and pointers
+/// to keys or values are invalidated by Insert, FindOrAdd, operator[] and Remove. Use ezMap when stable element addresses are required.
+///
+/// KeyType is the key type. For example a string.\n
+/// ValueType is the value type. For example int.\n
+/// Comparer is a helper class that implements a strictly weak-ordering comparison for Key types.
+template <typename KeyType, typename ValueType, typename Comparer>
+class ezBTreeMapBase
+{
+private:
+  enum : ezUInt32
+  {
+    LeafCapacity = ezInternal::GetBTreeNodeCapacity(sizeof(KeyType) + sizeof(ValueType)),
+    InnerCapacity = ezInternal::GetBTreeNodeCapacity(sizeof(KeyType) + sizeof(void*)), // maximum number of children
+    MinLeafCount = LeafCapacity / 2,
+    MinInnerCount = InnerCapacity / 2,
+  };
+
+  struct InnerNode;
+
+  struct Node
+  {
+    InnerNode* m_pParent = nullptr;
+    ezUInt32 m_uiCount = 0; // number of elements in a leaf or number of children of an inner node
+    bool m_bIsLeaf = false;
+  };
+
+  /// \brief Stores the elements. Only the first m_uiCount keys and values are constructed.
+  struct LeafNode : public Node
+  {
+    LeafNode* m_pPrev = nullptr;
+    LeafNode* m_pNext = nullptr;
+
+    ezInternal::BTreeNodeStorage<KeyType, LeafCapacity> m_Keys;
+    ezInternal::BTreeNodeStorage<ValueType, LeafCapacity> m_Values;
+
+    EZ_ALWAYS_INLINE KeyType* Keys() { return m_Keys.GetPtr(); }
+    EZ_ALWAYS_INLINE ValueType* Values() { return m_Values.GetPtr(); }
+  };
+
+  /// \brief Stores m_uiCount children and m_uiCount - 1 separator keys. All keys in child i are smaller than separator i,
+  /// all keys in child i + 1 are equal to or larger than it.
+  struct InnerNode : public Node
+  {
+    Node* m_pChildren[InnerCapacity];
+
+    ezInternal::BTreeNodeStorage<KeyType, InnerCapacity - 1> m_Keys;
+
+    EZ_ALWAYS_INLINE KeyType* Keys() { return m_Keys.GetPtr(); }
+  };
+
+public:
+  /// \brief Base class for all iterators.
+  struct ConstIterator
+  {
+    typedef std::forward_iterator_tag iterator_category;
+    using value_type = ConstIterator;
+    using difference_type = ptrdiff_t;
+    using pointer = ConstIterator*;
+    using reference = ConstIterator&;
+
+    EZ_DECLARE_POD_TYPE();
+
+    /// \brief Constructs an invalid iterator.
+    EZ_ALWAYS_INLINE ConstIterator()
+      : m_pLeaf(nullptr)
+      , m_uiIndex(0)
+    {
+    } // [tested]
+
+    /// \brief Checks whether this iterator points to a valid element.
+    EZ_ALWAYS_INLINE bool IsValid() const { return (m_pLeaf != nullptr); } // [tested]
+
+    /// \brief Checks whether the two iterators point to the same element.
+    EZ_ALWAYS_INLINE bool operator==(const typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator& it2) const
+    {
+      return (m_pLeaf == it2.m_pLeaf && m_uiIndex == it2.m_uiIndex);
+    }
+
+    /// \brief Checks whether the two iterators point to the same element.
+    EZ_ALWAYS_INLINE bool operator!=(const typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator& it2) const
+    {
+      return !(*this == it2);
+    }
+
+    /// \brief Returns the 'key' of the element that this iterator points to.
+    EZ_FORCE_INLINE const KeyType& Key() const
+    {
+      EZ_ASSERT_DEBUG(IsValid(), "Cannot access the 'key' of an invalid iterator.");
+      return m_pLeaf->Keys()[m_uiIndex];
+    } // [tested]
+
+    /// \brief Returns the 'value' of the element that this iterator points to.
+    EZ_FORCE_INLINE const ValueType& Value() const
+    {
+      EZ_ASSERT_DEBUG(IsValid(), "Cannot access the 'value' of an invalid iterator.");
+      return m_pLeaf->Values()[m_uiIndex];
+    } // [tested]
+
+    /// \brief Returns '*this' to enable foreach
+    EZ_ALWAYS_INLINE ConstIterator& operator*() { return *this; } // [tested]
+
+    /// \brief Advances the iterator to the next element in the map. The iterator will not be valid anymore, if the end is reached.
+    void Next(); // [tested]
+
+    /// \brief Advances the iterator to the previous element in the map. The iterator will not be valid anymore, if the end is reached.
+    void Prev(); // [tested]
+
+    /// \brief Shorthand for 'Next'
+    EZ_ALWAYS_INLINE void operator++() { Next(); } // [tested]
+
+    /// \brief Shorthand for 'Prev'
+    EZ_ALWAYS_INLINE void operator--() { Prev(); } // [tested]
+
+  protected:
+    friend class ezBTreeMapBase<KeyType, ValueType, Comparer>;
+    template <typename, typename>
+    friend class ezBTreeSetBase;
+
+    EZ_ALWAYS_INLINE ConstIterator(LeafNode* pLeaf, ezUInt32 uiIndex)
+      : m_pLeaf(pLeaf)
+      , m_uiIndex(uiIndex)
+    {
+    }
+
+    LeafNode* m_pLeaf;
+    ezUInt32 m_uiIndex;
+  };
+
+  /// \brief Forward Iterator to iterate over all elements in sorted order.
+  struct Iterator : public ConstIterator
+  {
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Iterator;
+    using difference_type = ptrdiff_t;
+    using pointer = Iterator*;
+    using reference = Iterator&;
+
+    // this is required to pull in the const version of this function
+    using ConstIterator::Value;
+
+    EZ_DECLARE_POD_TYPE();
+
+    /// \brief Constructs an invalid iterator.
+    EZ_ALWAYS_INLINE Iterator()
+      : ConstIterator()
+    {
+    }
+
+    /// \brief Returns the 'value' of the element that this iterator points to.
+    EZ_FORCE_INLINE ValueType& Value()
+    {
+      EZ_ASSERT_DEBUG(this->IsValid(), "Cannot access the 'value' of an invalid iterator.");
+      return this->m_pLeaf->Values()[this->m_uiIndex];
+    }
+
+    /// \brief Returns '*this' to enable foreach
+    EZ_ALWAYS_INLINE Iterator& operator*() { return *this; } // [tested]
+
+  private:
+    friend class ezBTreeMapBase<KeyType, ValueType, Comparer>;
+
+    EZ_ALWAYS_INLINE Iterator(LeafNode* pLeaf, ezUInt32 uiIndex)
+      : ConstIterator(pLeaf, uiIndex)
+    {
+    }
+  };
+
+protected:
+  /// \brief Initializes the map to be empty.
+  ezBTreeMapBase(const Comparer& comparer, ezAllocatorBase* pAllocator); // [tested]
+
+  /// \brief Copies all key/value pairs from the given map into this one.
+  ezBTreeMapBase(const ezBTreeMapBase<KeyType, ValueType, Comparer>& cc, ezAllocatorBase* pAllocator); // [tested]
+
+  /// \brief Destroys all elements from the map.
+  ~ezBTreeMapBase(); // [tested]
+
+  /// \brief Copies all key/value pairs from the given map into this one.
+  void operator=(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs);
+
+public:
+  /// \brief Returns whether there are no elements in the map. O(1) operation.
+  bool IsEmpty() const; // [tested]
+
+  /// \brief Returns the number of elements currently stored in the map. O(1) operation.
+  ezUInt32 GetCount() const; // [tested]
+
+  /// \brief Destroys all elements in the map and resets its size to zero.
+  void Clear(); // [tested]
+
+  /// \brief Returns an Iterator to the very first element.
+  Iterator GetIterator(); // [tested]
+
+  /// \brief Returns a constant Iterator to the very first element.
+  ConstIterator GetIterator() const; // [tested]
+
+  /// \brief Returns an Iterator to the very last element. For reverse traversal.
+  Iterator GetLastIterator(); // [tested]
+
+  /// \brief Returns a constant Iterator to the very last element. For reverse traversal.
+  ConstIterator GetLastIterator() const; // [tested]
+
+  /// \brief Inserts the key/value pair into the tree and returns an Iterator to it. O(log n) operation.
+  template <typename CompatibleKeyType, typename CompatibleValueType>
+  Iterator Insert(CompatibleKeyType&& key, CompatibleValueType&& value); // [tested]
+
+  /// \brief Erases the key/value pair with the given key, if it exists. O(log n) operation.
+  template <typename CompatibleKeyType>
+  bool Remove(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Erases the key/value pair at the given Iterator. O(log n) operation. Returns an iterator to the element after the given
+  /// iterator.
+  Iterator Remove(const Iterator& pos); // [tested]
+
+  /// \brief Searches for the given key and returns an iterator to it. If it did not exist yet, it is default-created. \a bExisted is set to
+  /// true, if the key was found, false if it needed to be created.
+  template <typename CompatibleKeyType>
+  Iterator FindOrAdd(CompatibleKeyType&& key, bool* bExisted = nullptr); // [tested]
+
+  /// \brief Allows read/write access to the value stored under the given key. If there is no such key, a new element is
+  /// default-constructed.
+  template <typename CompatibleKeyType>
+  ValueType& operator[](const CompatibleKeyType& key); // [tested]
+
+  /// \brief Returns a pointer to the value of the entry with the given key if found, otherwise returns nullptr.
+  template <typename CompatibleKeyType>
+  const ValueType* GetValue(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns a pointer to the value of the entry with the given key if found, otherwise returns nullptr.
+  template <typename CompatibleKeyType>
+  ValueType* GetValue(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Either returns the value of the entry with the given key, if found, or the provided default value.
+  template <typename CompatibleKeyType>
+  const ValueType& GetValueOrDefault(const CompatibleKeyType& key, const ValueType& defaultValue) const; // [tested]
+
+  /// \brief Searches for key, returns an Iterator to it or an invalid iterator, if no such key is found. O(log n) operation.
+  template <typename CompatibleKeyType>
+  Iterator Find(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Returns an Iterator to the element with a key equal or larger than the given key. Returns an invalid iterator, if there is no
+  /// such element.
+  template <typename CompatibleKeyType>
+  Iterator LowerBound(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Returns an Iterator to the element with a key that is LARGER than the given key. Returns an invalid iterator, if there is no
+  /// such element.
+  template <typename CompatibleKeyType>
+  Iterator UpperBound(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Searches for key, returns an Iterator to it or an invalid iterator, if no such key is found. O(log n) operation.
+  template <typename CompatibleKeyType>
+  ConstIterator Find(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Checks whether the given key is in the container.
+  template <typename CompatibleKeyType>
+  bool Contains(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns an Iterator to the element with a key equal or larger than the given key. Returns an invalid iterator, if there is no
+  /// such element.
+  template <typename CompatibleKeyType>
+  ConstIterator LowerBound(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns an Iterator to the element with a key that is LARGER than the given key. Returns an invalid iterator, if there is no
+  /// such element.
+  template <typename CompatibleKeyType>
+  ConstIterator UpperBound(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns the allocator that is used by this instance.
+  ezAllocatorBase* GetAllocator() const { return m_pAllocator; }
+
+  /// \brief Comparison operator
+  bool operator==(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs) const; // [tested]
+
+  /// \brief Comparison operator
+  bool operator!=(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs) const; // [tested]
+
+  /// \brief Returns the amount of bytes that are currently allocated on the heap.
+  ezUInt64 GetHeapMemoryUsage() const; // [tested]
+
+  /// \brief Swaps this map with the other one.
+  void Swap(ezBTreeMapBase<KeyType, ValueType, Comparer>& other); // [tested]
+
+private:
+  template <typename, typename>
+  friend class ezBTreeSetBase;
+
+  /// \brief Returns the leaf that contains the key, if it is in the map at all.
+  template <typename CompatibleKeyType>
+  LeafNode* FindLeaf(const CompatibleKeyType& key) const;
+
+  /// \brief Returns the index of the first key in the leaf that is not smaller than the given key.
+  template <typename CompatibleKeyType>
+  ezUInt32 LeafLowerBound(LeafNode* pLeaf, const CompatibleKeyType& key) const;
+
+  /// \brief Returns the index of the first of the uiCount keys that is larger than the given key.
+  template <typename CompatibleKeyType>
+  ezUInt32 UpperBoundIndex(const KeyType* pKeys, ezUInt32 uiCount, const CompatibleKeyType& key) const;
+
+  template <typename CompatibleKeyType>
+  ConstIterator Internal_Find(const CompatibleKeyType& key) const;
+  template <typename CompatibleKeyType>
+  ConstIterator Internal_LowerBound(const CompatibleKeyType& key) const;
+  template <typename CompatibleKeyType>
+  ConstIterator Internal_UpperBound(const CompatibleKeyType& key) const;
+
+  /// \brief Inserts a new element at the given position of the leaf, splitting it first if it is full. Returns where the element ended up.
+  template <typename CompatibleKeyType, typename CompatibleValueType>
+  ConstIterator InsertIntoLeaf(LeafNode* pLeaf, ezUInt32 uiIndex, CompatibleKeyType&& key, CompatibleValueType&& value);
+
+  /// \brief Adds pRight as the next sibling of pLeft to the parent of pLeft, splitting inner nodes up to the root as necessary.
+  void InsertIntoParent(Node* pLeft, KeyType&& separator, Node* pRight);
+
+  /// \brief Inserts pChild at the given child index of a non-full inner node, with the separator in front of it.
+  void InsertIntoInner(InnerNode* pNode, ezUInt32 uiChildIndex, KeyType&& separator, Node* pChild);
+
+  /// \brief Removes the element and rebalances the tree. Returns the position of the element that followed the removed one.
+  ConstIterator RemoveFromLeaf(LeafNode* pLeaf, ezUInt32 uiIndex);
+
+  /// \brief Removes the given separator and child from an inner node and rebalances the tree.
+  void RemoveFromInner(InnerNode* pNode, ezUInt32 uiKeyIndex, ezUInt32 uiChildIndex);
+
+  static ezUInt32 GetChildIndex(InnerNode* pParent, Node* pChild);
+  static void SetParent(InnerNode* pNode, ezUInt32 uiFirstChild, ezUInt32 uiNumChildren);
+
+  LeafNode* AcquireLeaf();
+  InnerNode* AcquireInner();
+  void ReleaseNode(Node* pNode);
+  void ReleaseTree(Node* pNode);
+
+  /// \brief Root node of the tree, nullptr if the map is empty.
+  Node* m_pRoot;
+
+  /// \brief The leaves with the smallest and largest keys, for iteration.
+  LeafNode* m_pFirstLeaf;
+  LeafNode* m_pLastLeaf;
+
+  /// \brief Number of elements in the tree.
+  ezUInt32 m_uiCount;
+
+  ezUInt32 m_uiNumLeafNodes;
+  ezUInt32 m_uiNumInnerNodes;
+
+  ezAllocatorBase* m_pAllocator;
+
+  /// \brief Comparer object
+  Comparer m_Comparer;
+};
+
+
+/// \brief \see ezBTreeMapBase
+template <typename KeyType, typename ValueType, typename Comparer = ezCompareHelper<KeyType>, typename AllocatorWrapper = ezDefaultAllocatorWrapper>
+class ezBTreeMap : public ezBTreeMapBase<KeyType, ValueType, Comparer>
+{
+public:
+  ezBTreeMap();
+  ezBTreeMap(ezAllocatorBase* pAllocator);
+  ezBTreeMap(const Comparer& comparer, ezAllocatorBase* pAllocator);
+
+  ezBTreeMap(const ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>& other);
+  ezBTreeMap(const ezBTreeMapBase<KeyType, ValueType, Comparer>& other);
+
+  void operator=(const ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>& rhs);
+  void operator=(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs);
+};
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator begin(ezBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator begin(const ezBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator cbegin(const ezBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator end(ezBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator end(const ezBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator cend(const ezBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator();
+}
+
+#include <Foundation/Containers/Implementation/BTreeMap_inl.h>
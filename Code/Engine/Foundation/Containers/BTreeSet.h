@@ -0,0 +1,203 @@
+#pragma once
+
+#include <Foundation/Containers/BTreeMap.h>
+
+namespace ezInternal
+{
+  /// \brief The value that ezBTreeSet stores in its underlying ezBTreeMap.
+  struct BTreeSetEmptyValue
+  {
+    EZ_DECLARE_POD_TYPE();
+  };
+} // namespace ezInternal
+
+/// \brief A set container with the same interface as ezSet, implemented as a B+-tree.
+///
+/// See ezBTreeMapBase for the memory layout. Contrary to ezSet, inserting or removing elements invalidates all iterators.
+template <typename KeyType, typename Comparer>
+class ezBTreeSetBase
+{
+private:
+  typedef ezBTreeMap<KeyType, ezInternal::BTreeSetEmptyValue, Comparer, ezNullAllocatorWrapper> TreeType;
+
+public:
+  /// \brief Base class for all iterators.
+  struct Iterator
+  {
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Iterator;
+    using difference_type = ptrdiff_t;
+    using pointer = Iterator*;
+    using reference = Iterator&;
+
+    EZ_DECLARE_POD_TYPE();
+
+    /// \brief Constructs an invalid iterator.
+    EZ_ALWAYS_INLINE Iterator() {} // [tested]
+
+    /// \brief Checks whether this iterator points to a valid element.
+    EZ_ALWAYS_INLINE bool IsValid() const { return m_It.IsValid(); } // [tested]
+
+    /// \brief Checks whether the two iterators point to the same element.
+    EZ_ALWAYS_INLINE bool operator==(const typename ezBTreeSetBase<KeyType, Comparer>::Iterator& it2) const { return (m_It == it2.m_It); }
+
+    /// \brief Checks whether the two iterators point to the same element.
+    EZ_ALWAYS_INLINE bool operator!=(const typename ezBTreeSetBase<KeyType, Comparer>::Iterator& it2) const { return (m_It != it2.m_It); }
+
+    /// \brief Returns the 'key' of the element that this iterator points to.
+    EZ_FORCE_INLINE const KeyType& Key() const { return m_It.Key(); } // [tested]
+
+    /// \brief Returns the 'key' of the element that this iterator points to.
+    EZ_ALWAYS_INLINE const KeyType& operator*() { return Key(); }
+
+    /// \brief Advances the iterator to the next element in the set. The iterator will not be valid anymore, if the end is reached.
+    EZ_ALWAYS_INLINE void Next() { m_It.Next(); } // [tested]
+
+    /// \brief Advances the iterator to the previous element in the set. The iterator will not be valid anymore, if the end is reached.
+    EZ_ALWAYS_INLINE void Prev() { m_It.Prev(); } // [tested]
+
+    /// \brief Shorthand for 'Next'
+    EZ_ALWAYS_INLINE void operator++() { Next(); } // [tested]
+
+    /// \brief Shorthand for 'Prev'
+    EZ_ALWAYS_INLINE void operator--() { Prev(); } // [tested]
+
+  protected:
+    friend class ezBTreeSetBase<KeyType, Comparer>;
+
+    EZ_ALWAYS_INLINE explicit Iterator(const typename TreeType::ConstIterator& it)
+      : m_It(it)
+    {
+    }
+
+    typename TreeType::ConstIterator m_It;
+  };
+
+protected:
+  /// \brief Initializes the set to be empty.
+  ezBTreeSetBase(const Comparer& comparer, ezAllocatorBase* pAllocator); // [tested]
+
+  /// \brief Creates a copy of the given set.
+  ezBTreeSetBase(const ezBTreeSetBase<KeyType, Comparer>& cc, ezAllocatorBase* pAllocator); // [tested]
+
+  /// \brief Copies all keys from the given set into this one.
+  void operator=(const ezBTreeSetBase<KeyType, Comparer>& rhs); // [tested]
+
+public:
+  /// \brief Returns whether there are no elements in the set.
+  bool IsEmpty() const { return m_Tree.IsEmpty(); } // [tested]
+
+  /// \brief Returns the number of elements currently stored in the set. O(1) operation.
+  ezUInt32 GetCount() const { return m_Tree.GetCount(); } // [tested]
+
+  /// \brief Destroys all elements in the set and resets its size to zero.
+  void Clear() { m_Tree.Clear(); } // [tested]
+
+  /// \brief Returns a constant Iterator to the very first element.
+  Iterator GetIterator() const { return Iterator(m_Tree.GetIterator()); } // [tested]
+
+  /// \brief Returns a constant Iterator to the very last element. For reverse traversal.
+  Iterator GetLastIterator() const { return Iterator(m_Tree.GetLastIterator()); } // [tested]
+
+  /// \brief Inserts the key into the tree and returns an Iterator to it. O(log n) operation.
+  template <typename CompatibleKeyType>
+  Iterator Insert(CompatibleKeyType&& key); // [tested]
+
+  /// \brief Erases the element with the given key, if it exists. O(log n) operation.
+  template <typename CompatibleKeyType>
+  bool Remove(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Erases the element at the given Iterator. O(log n) operation. Returns an iterator to the element after the given iterator.
+  Iterator Remove(const Iterator& pos); // [tested]
+
+  /// \brief Searches for key, returns an Iterator to it or an invalid iterator, if no such key is found. O(log n) operation.
+  template <typename CompatibleKeyType>
+  Iterator Find(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Checks whether the given key is in the container.
+  template <typename CompatibleKeyType>
+  bool Contains(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Checks whether all keys of the given set are in the container.
+  bool ContainsSet(const ezBTreeSetBase<KeyType, Comparer>& operand) const; // [tested]
+
+  /// \brief Returns an Iterator to the element with a key equal or larger than the given key. Returns an invalid iterator, if there is no
+  /// such element.
+  template <typename CompatibleKeyType>
+  Iterator LowerBound(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns an Iterator to the element with a key that is LARGER than the given key. Returns an invalid iterator, if there is no
+  /// such element.
+  template <typename CompatibleKeyType>
+  Iterator UpperBound(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Makes this set the union of itself and the operand.
+  void Union(const ezBTreeSetBase<KeyType, Comparer>& operand); // [tested]
+
+  /// \brief Makes this set the difference of itself and the operand, i.e. subtracts operand.
+  void Difference(const ezBTreeSetBase<KeyType, Comparer>& operand); // [tested]
+
+  /// \brief Makes this set the intersection of itself and the operand.
+  void Intersection(const ezBTreeSetBase<KeyType, Comparer>& operand); // [tested]
+
+  /// \brief Returns the allocator that is used by this instance.
+  ezAllocatorBase* GetAllocator() const { return m_Tree.GetAllocator(); }
+
+  /// \brief Comparison operator
+  bool operator==(const ezBTreeSetBase<KeyType, Comparer>& rhs) const; // [tested]
+
+  /// \brief Comparison operator
+  bool operator!=(const ezBTreeSetBase<KeyType, Comparer>& rhs) const; // [tested]
+
+  /// \brief Returns the amount of bytes that are currently allocated on the heap.
+  ezUInt64 GetHeapMemoryUsage() const { return m_Tree.GetHeapMemoryUsage(); } // [tested]
+
+  /// \brief Swaps this set with the other one.
+  void Swap(ezBTreeSetBase<KeyType, Comparer>& other) { m_Tree.Swap(other.m_Tree); } // [tested]
+
+private:
+  TreeType m_Tree;
+};
+
+/// \brief \see ezBTreeSetBase
+template <typename KeyType, typename Comparer = ezCompareHelper<KeyType>, typename AllocatorWrapper = ezDefaultAllocatorWrapper>
+class ezBTreeSet : public ezBTreeSetBase<KeyType, Comparer>
+{
+public:
+  ezBTreeSet();
+  ezBTreeSet(ezAllocatorBase* pAllocator);
+  ezBTreeSet(const Comparer& comparer, ezAllocatorBase* pAllocator);
+
+  ezBTreeSet(const ezBTreeSet<KeyType, Comparer, AllocatorWrapper>& other);
+  ezBTreeSet(const ezBTreeSetBase<KeyType, Comparer>& other);
+
+  void operator=(const ezBTreeSet<KeyType, Comparer, AllocatorWrapper>& rhs);
+  void operator=(const ezBTreeSetBase<KeyType, Comparer>& rhs);
+};
+
+
+template <typename KeyType, typename Comparer>
+typename ezBTreeSetBase<KeyType, Comparer>::Iterator begin(const ezBTreeSetBase<KeyType, Comparer>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename Comparer>
+typename ezBTreeSetBase<KeyType, Comparer>::Iterator cbegin(const ezBTreeSetBase<KeyType, Comparer>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename Comparer>
+typename ezBTreeSetBase<KeyType, Comparer>::Iterator end(const ezBTreeSetBase<KeyType, Comparer>& container)
+{
+  return typename ezBTreeSetBase<KeyType, Comparer>::Iterator();
+}
+
+template <typename KeyType, typename Comparer>
+typename ezBTreeSetBase<KeyType, Comparer>::Iterator cend(const ezBTreeSetBase<KeyType, Comparer>& container)
+{
+  return typename ezBTreeSetBase<KeyType, Comparer>::Iterator();
+}
+
+#include <Foundation/Containers/Implementation/BTreeSet_inl.h>
@@ -0,0 +1,931 @@
+#pragma once
+
+namespace ezInternal
+{
+  /// \brief Moves uiCount constructed objects one slot up. Afterwards pData[0] is not constructed anymore.
+  template <typename T>
+  EZ_ALWAYS_INLINE void BTreeShiftUp(T* pData, ezUInt32 uiCount)
+  {
+    for (ezUInt32 i = uiCount; i > 0; --i)
+    {
+      ezMemoryUtils::RelocateConstruct(pData + i, pData + i - 1, 1);
+    }
+  }
+
+  /// \brief Moves uiCount constructed objects from pData + 1 one slot down into the unconstructed pData[0].
+  template <typename T>
+  EZ_ALWAYS_INLINE void BTreeShiftDown(T* pData, ezUInt32 uiCount)
+  {
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      ezMemoryUtils::RelocateConstruct(pData + i, pData + i + 1, 1);
+    }
+  }
+} // namespace ezInternal
+
+// ***** Const Iterator *****
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator::Next()
+{
+  if (m_pLeaf == nullptr)
+  {
+    EZ_ASSERT_DEV(m_pLeaf != nullptr, "The Iterator is invalid (end).");
+    return;
+  }
+
+  ++m_uiIndex;
+
+  if (m_uiIndex >= m_pLeaf->m_uiCount)
+  {
+    m_pLeaf = m_pLeaf->m_pNext;
+    m_uiIndex = 0;
+  }
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator::Prev()
+{
+  if (m_pLeaf == nullptr)
+  {
+    EZ_ASSERT_DEV(m_pLeaf != nullptr, "The Iterator is invalid (end).");
+    return;
+  }
+
+  if (m_uiIndex > 0)
+  {
+    --m_uiIndex;
+    return;
+  }
+
+  m_pLeaf = m_pLeaf->m_pPrev;
+  m_uiIndex = (m_pLeaf != nullptr) ? m_pLeaf->m_uiCount - 1 : 0;
+}
+
+// ***** ezBTreeMapBase *****
+
+template <typename KeyType, typename ValueType, typename Comparer>
+ezBTreeMapBase<KeyType, ValueType, Comparer>::ezBTreeMapBase(const Comparer& comparer, ezAllocatorBase* pAllocator)
+  : m_pRoot(nullptr)
+  , m_pFirstLeaf(nullptr)
+  , m_pLastLeaf(nullptr)
+  , m_uiCount(0)
+  , m_uiNumLeafNodes(0)
+  , m_uiNumInnerNodes(0)
+  , m_pAllocator(pAllocator)
+  , m_Comparer(comparer)
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+ezBTreeMapBase<KeyType, ValueType, Comparer>::ezBTreeMapBase(const ezBTreeMapBase<KeyType, ValueType, Comparer>& cc, ezAllocatorBase* pAllocator)
+  : m_pRoot(nullptr)
+  , m_pFirstLeaf(nullptr)
+  , m_pLastLeaf(nullptr)
+  , m_uiCount(0)
+  , m_uiNumLeafNodes(0)
+  , m_uiNumInnerNodes(0)
+  , m_pAllocator(pAllocator)
+  , m_Comparer(cc.m_Comparer)
+{
+  operator=(cc);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+ezBTreeMapBase<KeyType, ValueType, Comparer>::~ezBTreeMapBase()
+{
+  Clear();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::operator=(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs)
+{
+  Clear();
+
+  // the keys arrive in sorted order, so every insertion appends to the last leaf, which keeps the leaves full
+  for (ConstIterator it = rhs.GetIterator(); it.IsValid(); ++it)
+    Insert(it.Key(), it.Value());
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::Clear()
+{
+  if (m_pRoot != nullptr)
+  {
+    ReleaseTree(m_pRoot);
+  }
+
+  m_pRoot = nullptr;
+  m_pFirstLeaf = nullptr;
+  m_pLastLeaf = nullptr;
+  m_uiCount = 0;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_ALWAYS_INLINE bool ezBTreeMapBase<KeyType, ValueType, Comparer>::IsEmpty() const
+{
+  return (m_uiCount == 0);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_ALWAYS_INLINE ezUInt32 ezBTreeMapBase<KeyType, ValueType, Comparer>::GetCount() const
+{
+  return m_uiCount;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_ALWAYS_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::GetIterator()
+{
+  return Iterator(m_pFirstLeaf, 0);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_ALWAYS_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator
+ezBTreeMapBase<KeyType, ValueType, Comparer>::GetIterator() const
+{
+  return ConstIterator(m_pFirstLeaf, 0);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_ALWAYS_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::GetLastIterator()
+{
+  return (m_pLastLeaf != nullptr) ? Iterator(m_pLastLeaf, m_pLastLeaf->m_uiCount - 1) : Iterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_ALWAYS_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator
+ezBTreeMapBase<KeyType, ValueType, Comparer>::GetLastIterator() const
+{
+  return (m_pLastLeaf != nullptr) ? ConstIterator(m_pLastLeaf, m_pLastLeaf->m_uiCount - 1) : ConstIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::LeafNode* ezBTreeMapBase<KeyType, ValueType, Comparer>::FindLeaf(
+  const CompatibleKeyType& key) const
+{
+  Node* pNode = m_pRoot;
+
+  if (pNode == nullptr)
+    return nullptr;
+
+  while (!pNode->m_bIsLeaf)
+  {
+    InnerNode* pInner = static_cast<InnerNode*>(pNode);
+    const KeyType* pKeys = pInner->Keys();
+
+    // search for the first separator that is larger than the key, its child contains the key
+    pNode = pInner->m_pChildren[UpperBoundIndex(pKeys, pInner->m_uiCount - 1, key)];
+  }
+
+  return static_cast<LeafNode*>(pNode);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+ezUInt32 ezBTreeMapBase<KeyType, ValueType, Comparer>::LeafLowerBound(LeafNode* pLeaf, const CompatibleKeyType& key) const
+{
+  const KeyType* pKeys = pLeaf->Keys();
+  ezUInt32 uiCount = pLeaf->m_uiCount;
+
+  if (uiCount == 0)
+    return 0;
+
+  // Halving the range unconditionally lets the compiler turn the comparison into a conditional move.
+  // The nodes are small enough that the branch mispredictions of a classic binary search dominate the lookup.
+  ezUInt32 uiBase = 0;
+  while (uiCount > 1)
+  {
+    const ezUInt32 uiHalf = uiCount / 2;
+    uiBase = m_Comparer.Less(pKeys[uiBase + uiHalf - 1], key) ? uiBase + uiHalf : uiBase;
+    uiCount -= uiHalf;
+  }
+
+  return uiBase + (m_Comparer.Less(pKeys[uiBase], key) ? 1 : 0);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+ezUInt32 ezBTreeMapBase<KeyType, ValueType, Comparer>::UpperBoundIndex(const KeyType* pKeys, ezUInt32 uiCount, const CompatibleKeyType& key) const
+{
+  if (uiCount == 0)
+    return 0;
+
+  // same as LeafLowerBound, but finds the first key that is larger than the given key
+  ezUInt32 uiBase = 0;
+  while (uiCount > 1)
+  {
+    const ezUInt32 uiHalf = uiCount / 2;
+    uiBase = m_Comparer.Less(key, pKeys[uiBase + uiHalf - 1]) ? uiBase : uiBase + uiHalf;
+    uiCount -= uiHalf;
+  }
+
+  return uiBase + (m_Comparer.Less(key, pKeys[uiBase]) ? 0 : 1);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::Internal_Find(
+  const CompatibleKeyType& key) const
+{
+  LeafNode* pLeaf = FindLeaf(key);
+
+  if (pLeaf == nullptr)
+    return ConstIterator();
+
+  const ezUInt32 uiIndex = LeafLowerBound(pLeaf, key);
+
+  if (uiIndex < pLeaf->m_uiCount && m_Comparer.Equal(pLeaf->Keys()[uiIndex], key))
+    return ConstIterator(pLeaf, uiIndex);
+
+  return ConstIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::Internal_LowerBound(
+  const CompatibleKeyType& key) const
+{
+  LeafNode* pLeaf = FindLeaf(key);
+
+  if (pLeaf == nullptr)
+    return ConstIterator();
+
+  const ezUInt32 uiIndex = LeafLowerBound(pLeaf, key);
+
+  // all keys in the next leaf are larger than the key
+  if (uiIndex == pLeaf->m_uiCount)
+    return ConstIterator(pLeaf->m_pNext, 0);
+
+  return ConstIterator(pLeaf, uiIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::Internal_UpperBound(
+  const CompatibleKeyType& key) const
+{
+  LeafNode* pLeaf = FindLeaf(key);
+
+  if (pLeaf == nullptr)
+    return ConstIterator();
+
+  const ezUInt32 uiIndex = UpperBoundIndex(pLeaf->Keys(), pLeaf->m_uiCount, key);
+
+  if (uiIndex == pLeaf->m_uiCount)
+    return ConstIterator(pLeaf->m_pNext, 0);
+
+  return ConstIterator(pLeaf, uiIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE const ValueType* ezBTreeMapBase<KeyType, ValueType, Comparer>::GetValue(const CompatibleKeyType& key) const
+{
+  ConstIterator it = Internal_Find<CompatibleKeyType>(key);
+  return it.IsValid() ? &it.Value() : nullptr;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE ValueType* ezBTreeMapBase<KeyType, ValueType, Comparer>::GetValue(const CompatibleKeyType& key)
+{
+  Iterator it = Find<CompatibleKeyType>(key);
+  return it.IsValid() ? &it.Value() : nullptr;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE const ValueType& ezBTreeMapBase<KeyType, ValueType, Comparer>::GetValueOrDefault(
+  const CompatibleKeyType& key, const ValueType& defaultValue) const
+{
+  ConstIterator it = Internal_Find<CompatibleKeyType>(key);
+  return it.IsValid() ? it.Value() : defaultValue;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::Find(
+  const CompatibleKeyType& key)
+{
+  ConstIterator it = Internal_Find<CompatibleKeyType>(key);
+  return Iterator(it.m_pLeaf, it.m_uiIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::Find(
+  const CompatibleKeyType& key) const
+{
+  return Internal_Find<CompatibleKeyType>(key);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE bool ezBTreeMapBase<KeyType, ValueType, Comparer>::Contains(const CompatibleKeyType& key) const
+{
+  return Internal_Find<CompatibleKeyType>(key).IsValid();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::LowerBound(
+  const CompatibleKeyType& key)
+{
+  ConstIterator it = Internal_LowerBound<CompatibleKeyType>(key);
+  return Iterator(it.m_pLeaf, it.m_uiIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator
+ezBTreeMapBase<KeyType, ValueType, Comparer>::LowerBound(const CompatibleKeyType& key) const
+{
+  return Internal_LowerBound<CompatibleKeyType>(key);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::UpperBound(
+  const CompatibleKeyType& key)
+{
+  ConstIterator it = Internal_UpperBound<CompatibleKeyType>(key);
+  return Iterator(it.m_pLeaf, it.m_uiIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator
+ezBTreeMapBase<KeyType, ValueType, Comparer>::UpperBound(const CompatibleKeyType& key) const
+{
+  return Internal_UpperBound<CompatibleKeyType>(key);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE ValueType& ezBTreeMapBase<KeyType, ValueType, Comparer>::operator[](const CompatibleKeyType& key)
+{
+  return FindOrAdd(key).Value();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::FindOrAdd(
+  CompatibleKeyType&& key, bool* bExisted)
+{
+  if (m_pRoot == nullptr)
+  {
+    m_pRoot = m_pFirstLeaf = m_pLastLeaf = AcquireLeaf();
+  }
+
+  LeafNode* pLeaf = FindLeaf(key);
+  const ezUInt32 uiIndex = LeafLowerBound(pLeaf, key);
+
+  if (uiIndex < pLeaf->m_uiCount && m_Comparer.Equal(pLeaf->Keys()[uiIndex], key))
+  {
+    if (bExisted)
+      *bExisted = true;
+
+    return Iterator(pLeaf, uiIndex);
+  }
+
+  if (bExisted)
+    *bExisted = false;
+
+  ConstIterator it = InsertIntoLeaf(pLeaf, uiIndex, std::forward<CompatibleKeyType>(key), ValueType());
+  return Iterator(it.m_pLeaf, it.m_uiIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType, typename CompatibleValueType>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::Insert(
+  CompatibleKeyType&& key, CompatibleValueType&& value)
+{
+  if (m_pRoot == nullptr)
+  {
+    m_pRoot = m_pFirstLeaf = m_pLastLeaf = AcquireLeaf();
+  }
+
+  LeafNode* pLeaf = FindLeaf(key);
+  const ezUInt32 uiIndex = LeafLowerBound(pLeaf, key);
+
+  if (uiIndex < pLeaf->m_uiCount && m_Comparer.Equal(pLeaf->Keys()[uiIndex], key))
+  {
+    pLeaf->Values()[uiIndex] = std::forward<CompatibleValueType>(value);
+    return Iterator(pLeaf, uiIndex);
+  }
+
+  ConstIterator it = InsertIntoLeaf(pLeaf, uiIndex, std::forward<CompatibleKeyType>(key), std::forward<CompatibleValueType>(value));
+  return Iterator(it.m_pLeaf, it.m_uiIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType, typename CompatibleValueType>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::InsertIntoLeaf(
+  LeafNode* pLeaf, ezUInt32 uiIndex, CompatibleKeyType&& key, CompatibleValueType&& value)
+{
+  LeafNode* pTarget = pLeaf;
+  LeafNode* pSplit = nullptr;
+
+  if (pLeaf->m_uiCount == LeafCapacity)
+  {
+    pSplit = AcquireLeaf();
+
+    // when appending to the very end, the full leaf stays full, so that inserting sorted data results in compact leaves
+    const ezUInt32 uiKeep = (uiIndex == LeafCapacity && pLeaf->m_pNext == nullptr) ? LeafCapacity : LeafCapacity / 2;
+    const ezUInt32 uiMove = LeafCapacity - uiKeep;
+
+    ezMemoryUtils::RelocateConstruct(pSplit->Keys(), pLeaf->Keys() + uiKeep, uiMove);
+    ezMemoryUtils::RelocateConstruct(pSplit->Values(), pLeaf->Values() + uiKeep, uiMove);
+    pSplit->m_uiCount = uiMove;
+    pLeaf->m_uiCount = uiKeep;
+
+    pSplit->m_pPrev = pLeaf;
+    pSplit->m_pNext = pLeaf->m_pNext;
+
+    if (pLeaf->m_pNext != nullptr)
+      pLeaf->m_pNext->m_pPrev = pSplit;
+    else
+      m_pLastLeaf = pSplit;
+
+    pLeaf->m_pNext = pSplit;
+
+    if (uiIndex >= uiKeep)
+    {
+      pTarget = pSplit;
+      uiIndex -= uiKeep;
+    }
+  }
+
+  ezInternal::BTreeShiftUp(pTarget->Keys() + uiIndex, pTarget->m_uiCount - uiIndex);
+  ezInternal::BTreeShiftUp(pTarget->Values() + uiIndex, pTarget->m_uiCount - uiIndex);
+  ezMemoryUtils::CopyOrMoveConstruct<KeyType>(pTarget->Keys() + uiIndex, std::forward<CompatibleKeyType>(key));
+  ezMemoryUtils::CopyOrMoveConstruct<ValueType>(pTarget->Values() + uiIndex, std::forward<CompatibleValueType>(value));
+  ++pTarget->m_uiCount;
+  ++m_uiCount;
+
+  if (pSplit != nullptr)
+  {
+    KeyType separator(pSplit->Keys()[0]);
+    InsertIntoParent(pLeaf, std::move(separator), pSplit);
+  }
+
+  return ConstIterator(pTarget, uiIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::InsertIntoParent(Node* pLeft, KeyType&& separator, Node* pRight)
+{
+  InnerNode* pParent = pLeft->m_pParent;
+
+  if (pParent == nullptr)
+  {
+    InnerNode* pRoot = AcquireInner();
+    pRoot->m_pChildren[0] = pLeft;
+    pRoot->m_pChildren[1] = pRight;
+    pRoot->m_uiCount = 2;
+    ezMemoryUtils::MoveConstruct(pRoot->Keys(), std::move(separator));
+
+    pLeft->m_pParent = pRoot;
+    pRight->m_pParent = pRoot;
+    m_pRoot = pRoot;
+    return;
+  }
+
+  const ezUInt32 uiChildIndex = GetChildIndex(pParent, pLeft) + 1;
+
+  if (pParent->m_uiCount < InnerCapacity)
+  {
+    InsertIntoInner(pParent, uiChildIndex, std::move(separator), pRight);
+    return;
+  }
+
+  // split the parent, the separator between the two halves moves up one level
+  InnerNode* pSplit = AcquireInner();
+
+  const ezUInt32 uiKeep = InnerCapacity / 2;
+  const ezUInt32 uiMove = InnerCapacity - uiKeep;
+
+  for (ezUInt32 i = 0; i < uiMove; ++i)
+  {
+    pSplit->m_pChildren[i] = pParent->m_pChildren[uiKeep + i];
+  }
+
+  ezMemoryUtils::RelocateConstruct(pSplit->Keys(), pParent->Keys() + uiKeep, uiMove - 1);
+  KeyType promoted(std::move(pParent->Keys()[uiKeep - 1]));
+  ezMemoryUtils::Destruct(pParent->Keys() + uiKeep - 1, 1);
+
+  pSplit->m_uiCount = uiMove;
+  pParent->m_uiCount = uiKeep;
+  SetParent(pSplit, 0, uiMove);
+
+  if (uiChildIndex <= uiKeep)
+    InsertIntoInner(pParent, uiChildIndex, std::move(separator), pRight);
+  else
+    InsertIntoInner(pSplit, uiChildIndex - uiKeep, std::move(separator), pRight);
+
+  InsertIntoParent(pParent, std::move(promoted), pSplit);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::InsertIntoInner(InnerNode* pNode, ezUInt32 uiChildIndex, KeyType&& separator, Node* pChild)
+{
+  EZ_ASSERT_DEBUG(uiChildIndex > 0 && uiChildIndex <= pNode->m_uiCount && pNode->m_uiCount < InnerCapacity, "Invalid child index");
+
+  ezInternal::BTreeShiftUp(pNode->Keys() + uiChildIndex - 1, pNode->m_uiCount - uiChildIndex);
+  ezMemoryUtils::MoveConstruct(pNode->Keys() + uiChildIndex - 1, std::move(separator));
+
+  for (ezUInt32 i = pNode->m_uiCount; i > uiChildIndex; --i)
+  {
+    pNode->m_pChildren[i] = pNode->m_pChildren[i - 1];
+  }
+
+  pNode->m_pChildren[uiChildIndex] = pChild;
+  pChild->m_pParent = pNode;
+  ++pNode->m_uiCount;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+bool ezBTreeMapBase<KeyType, ValueType, Comparer>::Remove(const CompatibleKeyType& key)
+{
+  ConstIterator it = Internal_Find<CompatibleKeyType>(key);
+
+  if (!it.IsValid())
+    return false;
+
+  RemoveFromLeaf(it.m_pLeaf, it.m_uiIndex);
+  return true;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::Remove(const Iterator& pos)
+{
+  EZ_ASSERT_DEV(pos.IsValid(), "The Iterator(pos) is invalid.");
+
+  ConstIterator it = RemoveFromLeaf(pos.m_pLeaf, pos.m_uiIndex);
+  return Iterator(it.m_pLeaf, it.m_uiIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::RemoveFromLeaf(
+  LeafNode* pLeaf, ezUInt32 uiIndex)
+{
+  ezMemoryUtils::Destruct(pLeaf->Keys() + uiIndex, 1);
+  ezMemoryUtils::Destruct(pLeaf->Values() + uiIndex, 1);
+  ezInternal::BTreeShiftDown(pLeaf->Keys() + uiIndex, pLeaf->m_uiCount - uiIndex - 1);
+  ezInternal::BTreeShiftDown(pLeaf->Values() + uiIndex, pLeaf->m_uiCount - uiIndex - 1);
+  --pLeaf->m_uiCount;
+  --m_uiCount;
+
+  if (pLeaf == m_pRoot)
+  {
+    if (pLeaf->m_uiCount == 0)
+    {
+      ReleaseNode(pLeaf);
+      m_pRoot = m_pFirstLeaf = m_pLastLeaf = nullptr;
+      return ConstIterator();
+    }
+  }
+  else if (pLeaf->m_uiCount < MinLeafCount)
+  {
+    // the leaf is underfull: either take an element from a sibling or merge with one
+    InnerNode* pParent = pLeaf->m_pParent;
+    const ezUInt32 uiChild = GetChildIndex(pParent, pLeaf);
+
+    LeafNode* pLeft = (uiChild > 0) ? static_cast<LeafNode*>(pParent->m_pChildren[uiChild - 1]) : nullptr;
+    LeafNode* pRight = (uiChild + 1 < pParent->m_uiCount) ? static_cast<LeafNode*>(pParent->m_pChildren[uiChild + 1]) : nullptr;
+
+    if (pLeft != nullptr && pLeft->m_uiCount > MinLeafCount)
+    {
+      ezInternal::BTreeShiftUp(pLeaf->Keys(), pLeaf->m_uiCount);
+      ezInternal::BTreeShiftUp(pLeaf->Values(), pLeaf->m_uiCount);
+      ezMemoryUtils::RelocateConstruct(pLeaf->Keys(), pLeft->Keys() + pLeft->m_uiCount - 1, 1);
+      ezMemoryUtils::RelocateConstruct(pLeaf->Values(), pLeft->Values() + pLeft->m_uiCount - 1, 1);
+      ++pLeaf->m_uiCount;
+      --pLeft->m_uiCount;
+
+      pParent->Keys()[uiChild - 1] = pLeaf->Keys()[0];
+      ++uiIndex;
+    }
+    else if (pRight != nullptr && pRight->m_uiCount > MinLeafCount)
+    {
+      ezMemoryUtils::RelocateConstruct(pLeaf->Keys() + pLeaf->m_uiCount, pRight->Keys(), 1);
+      ezMemoryUtils::RelocateConstruct(pLeaf->Values() + pLeaf->m_uiCount, pRight->Values(), 1);
+      ezInternal::BTreeShiftDown(pRight->Keys(), pRight->m_uiCount - 1);
+      ezInternal::BTreeShiftDown(pRight->Values(), pRight->m_uiCount - 1);
+      ++pLeaf->m_uiCount;
+      --pRight->m_uiCount;
+
+      pParent->Keys()[uiChild] = pRight->Keys()[0];
+    }
+    else
+    {
+      // merge the right one of the two leaves into the left one
+      if (pLeft != nullptr)
+      {
+        uiIndex += pLeft->m_uiCount;
+        pRight = pLeaf;
+        pLeaf = pLeft;
+      }
+      else
+      {
+        EZ_ASSERT_DEBUG(pRight != nullptr, "Inner node with a single child");
+      }
+
+      ezMemoryUtils::RelocateConstruct(pLeaf->Keys() + pLeaf->m_uiCount, pRight->Keys(), pRight->m_uiCount);
+      ezMemoryUtils::RelocateConstruct(pLeaf->Values() + pLeaf->m_uiCount, pRight->Values(), pRight->m_uiCount);
+      pLeaf->m_uiCount += pRight->m_uiCount;
+      pRight->m_uiCount = 0;
+
+      pLeaf->m_pNext = pRight->m_pNext;
+
+      if (pRight->m_pNext != nullptr)
+        pRight->m_pNext->m_pPrev = pLeaf;
+      else
+        m_pLastLeaf = pLeaf;
+
+      const ezUInt32 uiRightChild = GetChildIndex(pParent, pRight);
+      ReleaseNode(pRight);
+      RemoveFromInner(pParent, uiRightChild - 1, uiRightChild);
+    }
+  }
+
+  if (uiIndex == pLeaf->m_uiCount)
+    return ConstIterator(pLeaf->m_pNext, 0);
+
+  return ConstIterator(pLeaf, uiIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::RemoveFromInner(InnerNode* pNode, ezUInt32 uiKeyIndex, ezUInt32 uiChildIndex)
+{
+  ezMemoryUtils::Destruct(pNode->Keys() + uiKeyIndex, 1);
+  ezInternal::BTreeShiftDown(pNode->Keys() + uiKeyIndex, pNode->m_uiCount - uiKeyIndex - 2);
+
+  for (ezUInt32 i = uiChildIndex; i + 1 < pNode->m_uiCount; ++i)
+  {
+    pNode->m_pChildren[i] = pNode->m_pChildren[i + 1];
+  }
+
+  --pNode->m_uiCount;
+
+  if (pNode == m_pRoot)
+  {
+    // the tree shrinks by one level
+    if (pNode->m_uiCount == 1)
+    {
+      m_pRoot = pNode->m_pChildren[0];
+      m_pRoot->m_pParent = nullptr;
+      ReleaseNode(pNode);
+    }
+
+    return;
+  }
+
+  if (pNode->m_uiCount >= MinInnerCount)
+    return;
+
+  InnerNode* pParent = pNode->m_pParent;
+  const ezUInt32 uiChild = GetChildIndex(pParent, pNode);
+
+  InnerNode* pLeft = (uiChild > 0) ? static_cast<InnerNode*>(pParent->m_pChildren[uiChild - 1]) : nullptr;
+  InnerNode* pRight = (uiChild + 1 < pParent->m_uiCount) ? static_cast<InnerNode*>(pParent->m_pChildren[uiChild + 1]) : nullptr;
+
+  if (pLeft != nullptr && pLeft->m_uiCount > MinInnerCount)
+  {
+    // rotate: the separator in the parent moves down, the last separator of the left sibling moves up
+    ezInternal::BTreeShiftUp(pNode->Keys(), pNode->m_uiCount - 1);
+    ezMemoryUtils::MoveConstruct(pNode->Keys(), std::move(pParent->Keys()[uiChild - 1]));
+    pParent->Keys()[uiChild - 1] = std::move(pLeft->Keys()[pLeft->m_uiCount - 2]);
+    ezMemoryUtils::Destruct(pLeft->Keys() + pLeft->m_uiCount - 2, 1);
+
+    for (ezUInt32 i = pNode->m_uiCount; i > 0; --i)
+    {
+      pNode->m_pChildren[i] = pNode->m_pChildren[i - 1];
+    }
+
+    pNode->m_pChildren[0] = pLeft->m_pChildren[pLeft->m_uiCount - 1];
+    pNode->m_pChildren[0]->m_pParent = pNode;
+    ++pNode->m_uiCount;
+    --pLeft->m_uiCount;
+  }
+  else if (pRight != nullptr && pRight->m_uiCount > MinInnerCount)
+  {
+    // rotate: the separator in the parent moves down, the first separator of the right sibling moves up
+    ezMemoryUtils::MoveConstruct(pNode->Keys() + pNode->m_uiCount - 1, std::move(pParent->Keys()[uiChild]));
+    pParent->Keys()[uiChild] = std::move(pRight->Keys()[0]);
+    ezMemoryUtils::Destruct(pRight->Keys(), 1);
+    ezInternal::BTreeShiftDown(pRight->Keys(), pRight->m_uiCount - 2);
+
+    pNode->m_pChildren[pNode->m_uiCount] = pRight->m_pChildren[0];
+    pNode->m_pChildren[pNode->m_uiCount]->m_pParent = pNode;
+
+    for (ezUInt32 i = 0; i + 1 < pRight->m_uiCount; ++i)
+    {
+      pRight->m_pChildren[i] = pRight->m_pChildren[i + 1];
+    }
+
+    ++pNode->m_uiCount;
+    --pRight->m_uiCount;
+  }
+  else
+  {
+    // merge the right one of the two nodes into the left one, the separator between them moves down
+    ezUInt32 uiLeftChild = uiChild;
+
+    if (pLeft != nullptr)
+    {
+      pRight = pNode;
+      pNode = pLeft;
+      uiLeftChild = uiChild - 1;
+    }
+
+    ezMemoryUtils::MoveConstruct(pNode->Keys() + pNode->m_uiCount - 1, std::move(pParent->Keys()[uiLeftChild]));
+    ezMemoryUtils::RelocateConstruct(pNode->Keys() + pNode->m_uiCount, pRight->Keys(), pRight->m_uiCount - 1);
+
+    for (ezUInt32 i = 0; i < pRight->m_uiCount; ++i)
+    {
+      pNode->m_pChildren[pNode->m_uiCount + i] = pRight->m_pChildren[i];
+    }
+
+    SetParent(pNode, pNode->m_uiCount, pRight->m_uiCount);
+    pNode->m_uiCount += pRight->m_uiCount;
+    pRight->m_uiCount = 0;
+
+    ReleaseNode(pRight);
+    RemoveFromInner(pParent, uiLeftChild, uiLeftChild + 1);
+  }
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_FORCE_INLINE ezUInt32 ezBTreeMapBase<KeyType, ValueType, Comparer>::GetChildIndex(InnerNode* pParent, Node* pChild)
+{
+  ezUInt32 uiIndex = 0;
+  while (pParent->m_pChildren[uiIndex] != pChild)
+    ++uiIndex;
+
+  return uiIndex;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_FORCE_INLINE void ezBTreeMapBase<KeyType, ValueType, Comparer>::SetParent(InnerNode* pNode, ezUInt32 uiFirstChild, ezUInt32 uiNumChildren)
+{
+  for (ezUInt32 i = uiFirstChild; i < uiFirstChild + uiNumChildren; ++i)
+  {
+    pNode->m_pChildren[i]->m_pParent = pNode;
+  }
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::LeafNode* ezBTreeMapBase<KeyType, ValueType, Comparer>::AcquireLeaf()
+{
+  LeafNode* pLeaf = EZ_NEW(m_pAllocator, LeafNode);
+  pLeaf->m_bIsLeaf = true;
+
+  ++m_uiNumLeafNodes;
+  return pLeaf;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::InnerNode* ezBTreeMapBase<KeyType, ValueType, Comparer>::AcquireInner()
+{
+  InnerNode* pInner = EZ_NEW(m_pAllocator, InnerNode);
+
+  ++m_uiNumInnerNodes;
+  return pInner;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::ReleaseNode(Node* pNode)
+{
+  if (pNode->m_bIsLeaf)
+  {
+    LeafNode* pLeaf = static_cast<LeafNode*>(pNode);
+    EZ_DELETE(m_pAllocator, pLeaf);
+    --m_uiNumLeafNodes;
+  }
+  else
+  {
+    InnerNode* pInner = static_cast<InnerNode*>(pNode);
+    EZ_DELETE(m_pAllocator, pInner);
+    --m_uiNumInnerNodes;
+  }
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::ReleaseTree(Node* pNode)
+{
+  if (pNode->m_bIsLeaf)
+  {
+    LeafNode* pLeaf = static_cast<LeafNode*>(pNode);
+    ezMemoryUtils::Destruct(pLeaf->Keys(), pLeaf->m_uiCount);
+    ezMemoryUtils::Destruct(pLeaf->Values(), pLeaf->m_uiCount);
+  }
+  else
+  {
+    InnerNode* pInner = static_cast<InnerNode*>(pNode);
+
+    for (ezUInt32 i = 0; i < pInner->m_uiCount; ++i)
+    {
+      ReleaseTree(pInner->m_pChildren[i]);
+    }
+
+    ezMemoryUtils::Destruct(pInner->Keys(), pInner->m_uiCount - 1);
+  }
+
+  ReleaseNode(pNode);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+ezUInt64 ezBTreeMapBase<KeyType, ValueType, Comparer>::GetHeapMemoryUsage() const
+{
+  return static_cast<ezUInt64>(m_uiNumLeafNodes) * sizeof(LeafNode) + static_cast<ezUInt64>(m_uiNumInnerNodes) * sizeof(InnerNode);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+bool ezBTreeMapBase<KeyType, ValueType, Comparer>::operator==(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs) const
+{
+  if (GetCount() != rhs.GetCount())
+    return false;
+
+  auto itLhs = GetIterator();
+  auto itRhs = rhs.GetIterator();
+
+  while (itLhs.IsValid())
+  {
+    if (!m_Comparer.Equal(itLhs.Key(), itRhs.Key()))
+      return false;
+
+    if (itLhs.Value() != itRhs.Value())
+      return false;
+
+    ++itLhs;
+    ++itRhs;
+  }
+
+  return true;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_ALWAYS_INLINE bool ezBTreeMapBase<KeyType, ValueType, Comparer>::operator!=(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs) const
+{
+  return !operator==(rhs);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::Swap(ezBTreeMapBase<KeyType, ValueType, Comparer>& other)
+{
+  // the nodes do not reference the container, so swapping the members is enough
+  ezMath::Swap(this->m_pRoot, other.m_pRoot);
+  ezMath::Swap(this->m_pFirstLeaf, other.m_pFirstLeaf);
+  ezMath::Swap(this->m_pLastLeaf, other.m_pLastLeaf);
+  ezMath::Swap(this->m_uiCount, other.m_uiCount);
+  ezMath::Swap(this->m_uiNumLeafNodes, other.m_uiNumLeafNodes);
+  ezMath::Swap(this->m_uiNumInnerNodes, other.m_uiNumInnerNodes);
+  ezMath::Swap(this->m_pAllocator, other.m_pAllocator);
+  ezMath::Swap(this->m_Comparer, other.m_Comparer);
+}
+
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::ezBTreeMap()
+  : ezBTreeMapBase<KeyType, ValueType, Comparer>(Comparer(), AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::ezBTreeMap(ezAllocatorBase* pAllocator)
+  : ezBTreeMapBase<KeyType, ValueType, Comparer>(Comparer(), pAllocator)
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::ezBTreeMap(const Comparer& comparer, ezAllocatorBase* pAllocator)
+  : ezBTreeMapBase<KeyType, ValueType, Comparer>(comparer, pAllocator)
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::ezBTreeMap(const ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>& other)
+  : ezBTreeMapBase<KeyType, ValueType, Comparer>(other, AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::ezBTreeMap(const ezBTreeMapBase<KeyType, ValueType, Comparer>& other)
+  : ezBTreeMapBase<KeyType, ValueType, Comparer>(other, AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+void ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::operator=(const ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>& rhs)
+{
+  ezBTreeMapBase<KeyType, ValueType, Comparer>::operator=(rhs);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+void ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::operator=(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs)
+{
+  ezBTreeMapBase<KeyType, ValueType, Comparer>::operator=(rhs);
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+template <typename KeyType, typename Comparer>
+ezBTreeSetBase<KeyType, Comparer>::ezBTreeSetBase(const Comparer& comparer, ezAllocatorBase* pAllocator)
+  : m_Tree(comparer, pAllocator)
+{
+}
+
+template <typename KeyType, typename Comparer>
+ezBTreeSetBase<KeyType, Comparer>::ezBTreeSetBase(const ezBTreeSetBase<KeyType, Comparer>& cc, ezAllocatorBase* pAllocator)
+  : m_Tree(cc.m_Tree.m_Comparer, pAllocator)
+{
+  m_Tree = cc.m_Tree;
+}
+
+template <typename KeyType, typename Comparer>
+void ezBTreeSetBase<KeyType, Comparer>::operator=(const ezBTreeSetBase<KeyType, Comparer>& rhs)
+{
+  m_Tree = rhs.m_Tree;
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE typename ezBTreeSetBase<KeyType, Comparer>::Iterator ezBTreeSetBase<KeyType, Comparer>::Insert(CompatibleKeyType&& key)
+{
+  return Iterator(m_Tree.FindOrAdd(std::forward<CompatibleKeyType>(key)));
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE bool ezBTreeSetBase<KeyType, Comparer>::Remove(const CompatibleKeyType& key)
+{
+  return m_Tree.Remove(key);
+}
+
+template <typename KeyType, typename Comparer>
+typename ezBTreeSetBase<KeyType, Comparer>::Iterator ezBTreeSetBase<KeyType, Comparer>::Remove(const Iterator& pos)
+{
+  EZ_ASSERT_DEV(pos.IsValid(), "The Iterator(pos) is invalid.");
+
+  return Iterator(m_Tree.RemoveFromLeaf(pos.m_It.m_pLeaf, pos.m_It.m_uiIndex));
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE typename ezBTreeSetBase<KeyType, Comparer>::Iterator ezBTreeSetBase<KeyType, Comparer>::Find(const CompatibleKeyType& key) const
+{
+  return Iterator(m_Tree.Find(key));
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE bool ezBTreeSetBase<KeyType, Comparer>::Contains(const CompatibleKeyType& key) const
+{
+  return m_Tree.Contains(key);
+}
+
+template <typename KeyType, typename Comparer>
+bool ezBTreeSetBase<KeyType, Comparer>::ContainsSet(const ezBTreeSetBase<KeyType, Comparer>& operand) const
+{
+  for (const KeyType& key : operand)
+  {
+    if (!Contains(key))
+      return false;
+  }
+
+  return true;
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE typename ezBTreeSetBase<KeyType, Comparer>::Iterator ezBTreeSetBase<KeyType, Comparer>::LowerBound(
+  const CompatibleKeyType& key) const
+{
+  return Iterator(m_Tree.LowerBound(key));
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE typename ezBTreeSetBase<KeyType, Comparer>::Iterator ezBTreeSetBase<KeyType, Comparer>::UpperBound(
+  const CompatibleKeyType& key) const
+{
+  return Iterator(m_Tree.UpperBound(key));
+}
+
+template <typename KeyType, typename Comparer>
+void ezBTreeSetBase<KeyType, Comparer>::Union(const ezBTreeSetBase<KeyType, Comparer>& operand)
+{
+  for (const auto& key : operand)
+  {
+    Insert(key);
+  }
+}
+
+template <typename KeyType, typename Comparer>
+void ezBTreeSetBase<KeyType, Comparer>::Difference(const ezBTreeSetBase<KeyType, Comparer>& operand)
+{
+  for (const auto& key : operand)
+  {
+    Remove(key);
+  }
+}
+
+template <typename KeyType, typename Comparer>
+void ezBTreeSetBase<KeyType, Comparer>::Intersection(const ezBTreeSetBase<KeyType, Comparer>& operand)
+{
+  for (auto it = GetIterator(); it.IsValid();)
+  {
+    if (!operand.Contains(it.Key()))
+      it = Remove(it);
+    else
+      ++it;
+  }
+}
+
+template <typename KeyType, typename Comparer>
+bool ezBTreeSetBase<KeyType, Comparer>::operator==(const ezBTreeSetBase<KeyType, Comparer>& rhs) const
+{
+  if (GetCount() != rhs.GetCount())
+    return false;
+
+  auto itLhs = GetIterator();
+  auto itRhs = rhs.GetIterator();
+
+  while (itLhs.IsValid())
+  {
+    if (!m_Tree.m_Comparer.Equal(itLhs.Key(), itRhs.Key()))
+      return false;
+
+    ++itLhs;
+    ++itRhs;
+  }
+
+  return true;
+}
+
+template <typename KeyType, typename Comparer>
+EZ_ALWAYS_INLINE bool ezBTreeSetBase<KeyType, Comparer>::operator!=(const ezBTreeSetBase<KeyType, Comparer>& rhs) const
+{
+  return !operator==(rhs);
+}
+
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+ezBTreeSet<KeyType, Comparer, AllocatorWrapper>::ezBTreeSet()
+  : ezBTreeSetBase<KeyType, Comparer>(Comparer(), AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+ezBTreeSet<KeyType, Comparer, AllocatorWrapper>::ezBTreeSet(ezAllocatorBase* pAllocator)
+  : ezBTreeSetBase<KeyType, Comparer>(Comparer(), pAllocator)
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+ezBTreeSet<KeyType, Comparer, AllocatorWrapper>::ezBTreeSet(const Comparer& comparer, ezAllocatorBase* pAllocator)
+  : ezBTreeSetBase<KeyType, Comparer>(comparer, pAllocator)
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+ezBTreeSet<KeyType, Comparer, AllocatorWrapper>::ezBTreeSet(const ezBTreeSet<KeyType, Comparer, AllocatorWrapper>& other)
+  : ezBTreeSetBase<KeyType, Comparer>(other, AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+ezBTreeSet<KeyType, Comparer, AllocatorWrapper>::ezBTreeSet(const ezBTreeSetBase<KeyType, Comparer>& other)
+  : ezBTreeSetBase<KeyType, Comparer>(other, AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+void ezBTreeSet<KeyType, Comparer, AllocatorWrapper>::operator=(const ezBTreeSet<KeyType, Comparer, AllocatorWrapper>& rhs)
+{
+  ezBTreeSetBase<KeyType, Comparer>::operator=(rhs);
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+void ezBTreeSet<KeyType, Comparer, AllocatorWrapper>::operator=(const ezBTreeSetBase<KeyType, Comparer>& rhs)
+{
+  ezBTreeSetBase<KeyType, Comparer>::operator=(rhs);
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <Foundation/Math/Math.h>
+
+#if EZ_ENABLED(EZ_PLATFORM_ARCH_X86)
+#  include <emmintrin.h>
+#endif
+
+/// \brief Value used by containers for indices to indicate an invalid index.
+#ifndef ezInvalidIndex
+#  define ezInvalidIndex 0xFFFFFFFF
+#endif
+
+namespace ezInternal
+{
+  /// \brief Shared helpers of ezSwissHashTable and ezSwissHashSet.
+  ///
+  /// Every slot of the table has one control byte. For valid entries it stores the lowest 7 bits of the (mixed) hash of the key, otherwise it
+  /// is one of the special values EMPTY or DELETED, which have the high bit set. The slots are grouped into aligned groups of 16, and all
+  /// control bytes of a group are compared at once (with SSE2 where available), so most lookups only touch a single cache line of control
+  /// bytes and call the Hasher's Equal function only for the few entries whose 7 bit tag matches.
+  struct SwissHashGroup
+  {
+    enum : ezUInt8
+    {
+      EMPTY = 0x80,
+      DELETED = 0xFE,
+    };
+
+    enum : ezUInt32
+    {
+      SIZE = 16
+    };
+
+    EZ_ALWAYS_INLINE explicit SwissHashGroup(const ezUInt8* pControl)
+    {
+#if EZ_ENABLED(EZ_PLATFORM_ARCH_X86)
+      m_Control = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pControl));
+#else
+      m_pControl = pControl;
+#endif
+    }
+
+    /// \brief Returns a bitmask with one bit per slot whose control byte is equal to uiTag.
+    EZ_ALWAYS_INLINE ezUInt32 Match(ezUInt8 uiTag) const
+    {
+#if EZ_ENABLED(EZ_PLATFORM_ARCH_X86)
+      return static_cast<ezUInt32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(uiTag)), m_Control)));
+#else
+      ezUInt32 uiMask = 0;
+      for (ezUInt32 i = 0; i < SIZE; ++i)
+      {
+        uiMask |= (m_pControl[i] == uiTag) ? (1u << i) : 0u;
+      }
+      return uiMask;
+#endif
+    }
+
+    /// \brief Returns a bitmask with one bit per empty slot.
+    EZ_ALWAYS_INLINE ezUInt32 MatchEmpty() const { return Match(EMPTY); }
+
+    /// \brief Returns a bitmask with one bit per slot that is either empty or deleted, i.e. that can be used for a new entry.
+    EZ_ALWAYS_INLINE ezUInt32 MatchEmptyOrDeleted() const
+    {
+#if EZ_ENABLED(EZ_PLATFORM_ARCH_X86)
+      return static_cast<ezUInt32>(_mm_movemask_epi8(m_Control));
+#else
+      ezUInt32 uiMask = 0;
+      for (ezUInt32 i = 0; i < SIZE; ++i)
+      {
+        uiMask |= (m_pControl[i] & 0x80) ? (1u << i) : 0u;
+      }
+      return uiMask;
+#endif
+    }
+
+    EZ_ALWAYS_INLINE static bool IsFull(ezUInt8 uiControl) { return (uiControl & 0x80) == 0; }
+
+    /// \brief Mixes the hash, since the table uses its upper bits for the group index and its lowest 7 bits for the tag.
+    ///
+    /// Many ezHashHelper implementations are cheap and only well distributed in some of their bits.
+    EZ_ALWAYS_INLINE static ezUInt32 MixHash(ezUInt32 uiHash)
+    {
+      // murmur3 finalizer
+      uiHash ^= uiHash >> 16;
+      uiHash *= 0x85ebca6bu;
+      uiHash ^= uiHash >> 13;
+      uiHash *= 0xc2b2ae35u;
+      uiHash ^= uiHash >> 16;
+      return uiHash;
+    }
+
+    EZ_ALWAYS_INLINE static ezUInt8 GetTag(ezUInt32 uiMixedHash) { return static_cast<ezUInt8>(uiMixedHash & 0x7F); }
+
+    /// \brief The maximum number of entries (including deleted ones) before the table has to be rehashed, i.e. a load factor of 87.5%.
+    EZ_ALWAYS_INLINE static ezUInt32 GetMaxLoad(ezUInt32 uiCapacity) { return uiCapacity - uiCapacity / 8; }
+
+    /// \brief Returns the smallest capacity that can hold uiCount entries.
+    static ezUInt32 GetCapacityForCount(ezUInt32 uiCount)
+    {
+      const ezUInt64 uiCapacity64 = ezMath::Min<ezUInt64>(static_cast<ezUInt64>(uiCount) * 8 / 7 + 1, 0x80000000llu);
+      EZ_ASSERT_DEBUG(uiCount <= GetMaxLoad(0x80000000u), "ezSwissHashSet/Table do not support more than 1.8 billion entries.");
+
+      return ezMath::Max<ezUInt32>(ezMath::PowerOfTwo_Ceil(static_cast<ezUInt32>(uiCapacity64)), SIZE);
+    }
+
+#if EZ_ENABLED(EZ_PLATFORM_ARCH_X86)
+    __m128i m_Control;
+#else
+    const ezUInt8* m_pControl;
+#endif
+  };
+
+  /// \brief The probe sequence visits the groups of a table in triangular order, which reaches every group if the group count is a power of two.
+  struct SwissHashProbe
+  {
+    EZ_ALWAYS_INLINE SwissHashProbe(ezUInt32 uiMixedHash, ezUInt32 uiCapacity)
+      : m_uiGroupMask((uiCapacity / SwissHashGroup::SIZE) - 1)
+      , m_uiGroup((uiMixedHash >> 7) & m_uiGroupMask)
+    {
+    }
+
+    /// \brief Returns the index of the first slot of the current group.
+    EZ_ALWAYS_INLINE ezUInt32 GetOffset() const { return m_uiGroup * SwissHashGroup::SIZE; }
+
+    EZ_ALWAYS_INLINE void Next()
+    {
+      ++m_uiStep;
+      m_uiGroup = (m_uiGroup + m_uiStep) & m_uiGroupMask;
+    }
+
+    ezUInt32 m_uiGroupMask;
+    ezUInt32 m_uiGroup;
+    ezUInt32 m_uiStep = 0;
+  };
+} // namespace ezInternal
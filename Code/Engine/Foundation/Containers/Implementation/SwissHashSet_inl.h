@@ -0,0 +1,594 @@
+
+// ***** Const Iterator *****
+
+template <typename K, typename H>
+ezSwissHashSetBase<K, H>::ConstIterator::ConstIterator(const ezSwissHashSetBase<K, H>& hashSet)
+  : m_hashSet(&hashSet)
+{
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::ConstIterator::SetToBegin()
+{
+  if (m_hashSet->IsEmpty())
+  {
+    m_uiCurrentIndex = m_hashSet->m_uiCapacity;
+    return;
+  }
+  while (!m_hashSet->IsValidEntry(m_uiCurrentIndex))
+  {
+    ++m_uiCurrentIndex;
+  }
+}
+
+template <typename K, typename H>
+inline void ezSwissHashSetBase<K, H>::ConstIterator::SetToEnd()
+{
+  m_uiCurrentCount = m_hashSet->m_uiCount;
+  m_uiCurrentIndex = m_hashSet->m_uiCapacity;
+}
+
+template <typename K, typename H>
+EZ_ALWAYS_INLINE bool ezSwissHashSetBase<K, H>::ConstIterator::IsValid() const
+{
+  return m_uiCurrentCount < m_hashSet->m_uiCount;
+}
+
+template <typename K, typename H>
+EZ_ALWAYS_INLINE bool ezSwissHashSetBase<K, H>::ConstIterator::operator==(const typename ezSwissHashSetBase<K, H>::ConstIterator& rhs) const
+{
+  return m_uiCurrentIndex == rhs.m_uiCurrentIndex && m_hashSet->m_pEntries == rhs.m_hashSet->m_pEntries;
+}
+
+template <typename K, typename H>
+EZ_ALWAYS_INLINE bool ezSwissHashSetBase<K, H>::ConstIterator::operator!=(const typename ezSwissHashSetBase<K, H>::ConstIterator& rhs) const
+{
+  return !(*this == rhs);
+}
+
+template <typename K, typename H>
+EZ_FORCE_INLINE const K& ezSwissHashSetBase<K, H>::ConstIterator::Key() const
+{
+  return m_hashSet->m_pEntries[m_uiCurrentIndex];
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::ConstIterator::Next()
+{
+  // if we already iterated over the amount of valid elements that the hash-set stores, early out
+  if (m_uiCurrentCount >= m_hashSet->m_uiCount)
+    return;
+
+  // increase the counter of how many elements we have seen
+  ++m_uiCurrentCount;
+  // increase the index of the element to look at
+  ++m_uiCurrentIndex;
+
+  // check that we don't leave the valid range of element indices
+  while (m_uiCurrentIndex < m_hashSet->m_uiCapacity)
+  {
+    if (m_hashSet->IsValidEntry(m_uiCurrentIndex))
+      return;
+
+    ++m_uiCurrentIndex;
+  }
+
+  // if we fell through this loop, we reached the end of all elements in the container
+  // set the m_uiCurrentCount to maximum, to enable early-out in the future and to make 'IsValid' return 'false'
+  m_uiCurrentCount = m_hashSet->m_uiCount;
+}
+
+template <typename K, typename H>
+EZ_ALWAYS_INLINE void ezSwissHashSetBase<K, H>::ConstIterator::operator++()
+{
+  Next();
+}
+
+
+// ***** ezSwissHashSetBase *****
+
+template <typename K, typename H>
+ezSwissHashSetBase<K, H>::ezSwissHashSetBase(ezAllocatorBase* pAllocator)
+{
+  m_pEntries = nullptr;
+  m_pControl = nullptr;
+  m_uiCount = 0;
+  m_uiCapacity = 0;
+  m_uiGrowthLeft = 0;
+  m_pAllocator = pAllocator;
+}
+
+template <typename K, typename H>
+ezSwissHashSetBase<K, H>::ezSwissHashSetBase(const ezSwissHashSetBase<K, H>& other, ezAllocatorBase* pAllocator)
+  : ezSwissHashSetBase(pAllocator)
+{
+  *this = other;
+}
+
+template <typename K, typename H>
+ezSwissHashSetBase<K, H>::ezSwissHashSetBase(ezSwissHashSetBase<K, H>&& other, ezAllocatorBase* pAllocator)
+  : ezSwissHashSetBase(pAllocator)
+{
+  *this = std::move(other);
+}
+
+template <typename K, typename H>
+ezSwissHashSetBase<K, H>::~ezSwissHashSetBase()
+{
+  Clear();
+  FreeData();
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::operator=(const ezSwissHashSetBase<K, H>& rhs)
+{
+  Clear();
+  Reserve(rhs.GetCount());
+
+  ezUInt32 uiCopied = 0;
+  for (ezUInt32 i = 0; uiCopied < rhs.GetCount(); ++i)
+  {
+    if (rhs.IsValidEntry(i))
+    {
+      Insert(rhs.m_pEntries[i]);
+      ++uiCopied;
+    }
+  }
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::operator=(ezSwissHashSetBase<K, H>&& rhs)
+{
+  // Clear any existing data (calls destructors if necessary)
+  Clear();
+
+  if (m_pAllocator != rhs.m_pAllocator)
+  {
+    Reserve(rhs.m_uiCount);
+
+    ezUInt32 uiCopied = 0;
+    for (ezUInt32 i = 0; uiCopied < rhs.GetCount(); ++i)
+    {
+      if (rhs.IsValidEntry(i))
+      {
+        Insert(std::move(rhs.m_pEntries[i]));
+        ++uiCopied;
+      }
+    }
+
+    rhs.Clear();
+  }
+  else
+  {
+    FreeData();
+
+    // Move all data over.
+    m_pEntries = rhs.m_pEntries;
+    m_pControl = rhs.m_pControl;
+    m_uiCount = rhs.m_uiCount;
+    m_uiCapacity = rhs.m_uiCapacity;
+    m_uiGrowthLeft = rhs.m_uiGrowthLeft;
+
+    // Temp copy forgets all its state.
+    rhs.m_pEntries = nullptr;
+    rhs.m_pControl = nullptr;
+    rhs.m_uiCount = 0;
+    rhs.m_uiCapacity = 0;
+    rhs.m_uiGrowthLeft = 0;
+  }
+}
+
+template <typename K, typename H>
+bool ezSwissHashSetBase<K, H>::operator==(const ezSwissHashSetBase<K, H>& rhs) const
+{
+  if (m_uiCount != rhs.m_uiCount)
+    return false;
+
+  ezUInt32 uiCompared = 0;
+  for (ezUInt32 i = 0; uiCompared < m_uiCount; ++i)
+  {
+    if (IsValidEntry(i))
+    {
+      if (!rhs.Contains(m_pEntries[i]))
+        return false;
+
+      ++uiCompared;
+    }
+  }
+
+  return true;
+}
+
+template <typename K, typename H>
+EZ_ALWAYS_INLINE bool ezSwissHashSetBase<K, H>::operator!=(const ezSwissHashSetBase<K, H>& rhs) const
+{
+  return !(*this == rhs);
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::Reserve(ezUInt32 uiCapacity)
+{
+  if (uiCapacity <= m_uiCount + m_uiGrowthLeft)
+    return;
+
+  SetCapacity(ezMath::Max(Group::GetCapacityForCount(uiCapacity), m_uiCapacity));
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::Compact()
+{
+  if (IsEmpty())
+  {
+    // completely deallocate all data, if the set is empty.
+    FreeData();
+  }
+  else
+  {
+    const ezUInt32 uiNewCapacity = Group::GetCapacityForCount(m_uiCount);
+    if (m_uiCapacity != uiNewCapacity)
+      SetCapacity(uiNewCapacity);
+  }
+}
+
+template <typename K, typename H>
+EZ_ALWAYS_INLINE ezUInt32 ezSwissHashSetBase<K, H>::GetCount() const
+{
+  return m_uiCount;
+}
+
+template <typename K, typename H>
+EZ_ALWAYS_INLINE bool ezSwissHashSetBase<K, H>::IsEmpty() const
+{
+  return m_uiCount == 0;
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::Clear()
+{
+  for (ezUInt32 i = 0; i < m_uiCapacity; ++i)
+  {
+    if (IsValidEntry(i))
+    {
+      ezMemoryUtils::Destruct(&m_pEntries[i], 1);
+    }
+  }
+
+  ezMemoryUtils::PatternFill(m_pControl, Group::EMPTY, m_uiCapacity);
+  m_uiCount = 0;
+  m_uiGrowthLeft = Group::GetMaxLoad(m_uiCapacity);
+}
+
+template <typename K, typename H>
+template <typename CompatibleKeyType>
+bool ezSwissHashSetBase<K, H>::Insert(CompatibleKeyType&& key)
+{
+  const ezUInt32 uiHash = H::Hash(key);
+  if (FindEntry(uiHash, key) != ezInvalidIndex)
+    return true;
+
+  const ezUInt32 uiIndex = PrepareInsert(uiHash);
+
+  // Constructions might either be a move or a copy.
+  ezMemoryUtils::CopyOrMoveConstruct(&m_pEntries[uiIndex], std::forward<CompatibleKeyType>(key));
+
+  return false;
+}
+
+template <typename K, typename H>
+bool ezSwissHashSetBase<K, H>::Remove(const K& key)
+{
+  ezUInt32 uiIndex = FindEntry(H::Hash(key), key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    RemoveInternal(uiIndex);
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename H>
+typename ezSwissHashSetBase<K, H>::ConstIterator ezSwissHashSetBase<K, H>::Remove(const typename ezSwissHashSetBase<K, H>::ConstIterator& pos)
+{
+  ConstIterator it = pos;
+  ezUInt32 uiIndex = pos.m_uiCurrentIndex;
+  ++it;
+  --it.m_uiCurrentCount;
+  RemoveInternal(uiIndex);
+  return it;
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::RemoveInternal(ezUInt32 uiIndex)
+{
+  ezMemoryUtils::Destruct(&m_pEntries[uiIndex], 1);
+
+  // see ezSwissHashTableBase::RemoveInternal
+  const Group group(m_pControl + (uiIndex & ~(Group::SIZE - 1)));
+  if (group.MatchEmpty() != 0)
+  {
+    m_pControl[uiIndex] = Group::EMPTY;
+    ++m_uiGrowthLeft;
+  }
+  else
+  {
+    m_pControl[uiIndex] = Group::DELETED;
+  }
+
+  --m_uiCount;
+}
+
+template <typename K, typename H>
+EZ_FORCE_INLINE bool ezSwissHashSetBase<K, H>::Contains(const K& key) const
+{
+  return FindEntry(H::Hash(key), key) != ezInvalidIndex;
+}
+
+template <typename K, typename H>
+bool ezSwissHashSetBase<K, H>::ContainsSet(const ezSwissHashSetBase<K, H>& operand) const
+{
+  for (const K& key : operand)
+  {
+    if (!Contains(key))
+      return false;
+  }
+
+  return true;
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::Union(const ezSwissHashSetBase<K, H>& operand)
+{
+  Reserve(GetCount() + operand.GetCount());
+  for (const auto& key : operand)
+  {
+    Insert(key);
+  }
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::Difference(const ezSwissHashSetBase<K, H>& operand)
+{
+  for (const auto& key : operand)
+  {
+    Remove(key);
+  }
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::Intersection(const ezSwissHashSetBase<K, H>& operand)
+{
+  for (auto it = GetIterator(); it.IsValid();)
+  {
+    if (!operand.Contains(it.Key()))
+      it = Remove(it);
+    else
+      ++it;
+  }
+}
+
+template <typename K, typename H>
+EZ_FORCE_INLINE typename ezSwissHashSetBase<K, H>::ConstIterator ezSwissHashSetBase<K, H>::GetIterator() const
+{
+  ConstIterator iterator(*this);
+  iterator.SetToBegin();
+  return iterator;
+}
+
+template <typename K, typename H>
+EZ_FORCE_INLINE typename ezSwissHashSetBase<K, H>::ConstIterator ezSwissHashSetBase<K, H>::GetEndIterator() const
+{
+  ConstIterator iterator(*this);
+  iterator.SetToEnd();
+  return iterator;
+}
+
+template <typename K, typename H>
+EZ_ALWAYS_INLINE ezAllocatorBase* ezSwissHashSetBase<K, H>::GetAllocator() const
+{
+  return m_pAllocator;
+}
+
+template <typename K, typename H>
+ezUInt64 ezSwissHashSetBase<K, H>::GetHeapMemoryUsage() const
+{
+  return (ezUInt64)m_uiCapacity * (sizeof(K) + sizeof(ezUInt8));
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::Swap(ezSwissHashSetBase<K, H>& other)
+{
+  ezMath::Swap(this->m_pEntries, other.m_pEntries);
+  ezMath::Swap(this->m_pControl, other.m_pControl);
+  ezMath::Swap(this->m_uiCount, other.m_uiCount);
+  ezMath::Swap(this->m_uiCapacity, other.m_uiCapacity);
+  ezMath::Swap(this->m_uiGrowthLeft, other.m_uiGrowthLeft);
+  ezMath::Swap(this->m_pAllocator, other.m_pAllocator);
+}
+
+// private methods
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::SetCapacity(ezUInt32 uiCapacity)
+{
+  EZ_ASSERT_DEV(ezMath::IsPowerOf2(uiCapacity) && uiCapacity >= Group::SIZE, "uiCapacity must be a power of two and at least one group.");
+  EZ_ASSERT_DEV(Group::GetMaxLoad(uiCapacity) >= m_uiCount, "uiCapacity is too small for the current number of entries.");
+
+  const ezUInt32 uiOldCapacity = m_uiCapacity;
+  K* pOldEntries = m_pEntries;
+  ezUInt8* pOldControl = m_pControl;
+
+  m_uiCapacity = uiCapacity;
+  m_pEntries = EZ_NEW_RAW_BUFFER(m_pAllocator, K, m_uiCapacity);
+  m_pControl = EZ_NEW_RAW_BUFFER(m_pAllocator, ezUInt8, m_uiCapacity);
+  ezMemoryUtils::PatternFill(m_pControl, Group::EMPTY, m_uiCapacity);
+  m_uiGrowthLeft = Group::GetMaxLoad(m_uiCapacity) - m_uiCount;
+
+  // all keys are unique, so the entries can be moved into the first free slot without comparing any keys
+  for (ezUInt32 i = 0; i < uiOldCapacity; ++i)
+  {
+    if (Group::IsFull(pOldControl[i]))
+    {
+      const ezUInt32 uiMixedHash = Group::MixHash(H::Hash(pOldEntries[i]));
+      const ezUInt32 uiIndex = FindFreeEntry(uiMixedHash);
+      m_pControl[uiIndex] = Group::GetTag(uiMixedHash);
+
+      ezMemoryUtils::RelocateConstruct(&m_pEntries[uiIndex], &pOldEntries[i], 1);
+    }
+  }
+
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, pOldEntries);
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, pOldControl);
+}
+
+template <typename K, typename H>
+void ezSwissHashSetBase<K, H>::FreeData()
+{
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pEntries);
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pControl);
+  m_uiCapacity = 0;
+  m_uiGrowthLeft = 0;
+}
+
+template <typename K, typename H>
+template <typename CompatibleKeyType>
+inline ezUInt32 ezSwissHashSetBase<K, H>::FindEntry(ezUInt32 uiHash, const CompatibleKeyType& key) const
+{
+  if (m_uiCapacity > 0)
+  {
+    const ezUInt32 uiMixedHash = Group::MixHash(uiHash);
+    const ezUInt8 uiTag = Group::GetTag(uiMixedHash);
+
+    // there is always at least one empty slot, so this terminates
+    ezInternal::SwissHashProbe probe(uiMixedHash, m_uiCapacity);
+    while (true)
+    {
+      const Group group(m_pControl + probe.GetOffset());
+
+      for (ezUInt32 uiMatches = group.Match(uiTag); uiMatches != 0; uiMatches &= uiMatches - 1)
+      {
+        const ezUInt32 uiIndex = probe.GetOffset() + ezMath::FirstBitLow(uiMatches);
+        if (H::Equal(m_pEntries[uiIndex], key))
+          return uiIndex;
+      }
+
+      if (group.MatchEmpty() != 0)
+        break;
+
+      probe.Next();
+    }
+  }
+  // not found
+  return ezInvalidIndex;
+}
+
+template <typename K, typename H>
+inline ezUInt32 ezSwissHashSetBase<K, H>::FindFreeEntry(ezUInt32 uiMixedHash) const
+{
+  ezInternal::SwissHashProbe probe(uiMixedHash, m_uiCapacity);
+  while (true)
+  {
+    const ezUInt32 uiFree = Group(m_pControl + probe.GetOffset()).MatchEmptyOrDeleted();
+    if (uiFree != 0)
+      return probe.GetOffset() + ezMath::FirstBitLow(uiFree);
+
+    probe.Next();
+  }
+}
+
+template <typename K, typename H>
+ezUInt32 ezSwissHashSetBase<K, H>::PrepareInsert(ezUInt32 uiHash)
+{
+  if (m_uiCapacity == 0)
+  {
+    SetCapacity(Group::SIZE);
+  }
+
+  const ezUInt32 uiMixedHash = Group::MixHash(uiHash);
+  ezUInt32 uiIndex = FindFreeEntry(uiMixedHash);
+
+  // see ezSwissHashTableBase::PrepareInsert
+  if (m_uiGrowthLeft == 0 && m_pControl[uiIndex] == Group::EMPTY)
+  {
+    const bool bGrow = m_uiCount > Group::GetMaxLoad(m_uiCapacity) / 2;
+    SetCapacity(bGrow ? m_uiCapacity * 2 : m_uiCapacity);
+
+    uiIndex = FindFreeEntry(uiMixedHash);
+  }
+
+  if (m_pControl[uiIndex] == Group::EMPTY)
+  {
+    --m_uiGrowthLeft;
+  }
+
+  m_pControl[uiIndex] = Group::GetTag(uiMixedHash);
+  ++m_uiCount;
+
+  return uiIndex;
+}
+
+template <typename K, typename H>
+EZ_FORCE_INLINE bool ezSwissHashSetBase<K, H>::IsValidEntry(ezUInt32 uiEntryIndex) const
+{
+  return Group::IsFull(m_pControl[uiEntryIndex]);
+}
+
+
+template <typename K, typename H, typename A>
+ezSwissHashSet<K, H, A>::ezSwissHashSet()
+  : ezSwissHashSetBase<K, H>(A::GetAllocator())
+{
+}
+
+template <typename K, typename H, typename A>
+ezSwissHashSet<K, H, A>::ezSwissHashSet(ezAllocatorBase* pAllocator)
+  : ezSwissHashSetBase<K, H>(pAllocator)
+{
+}
+
+template <typename K, typename H, typename A>
+ezSwissHashSet<K, H, A>::ezSwissHashSet(const ezSwissHashSet<K, H, A>& other)
+  : ezSwissHashSetBase<K, H>(other, A::GetAllocator())
+{
+}
+
+template <typename K, typename H, typename A>
+ezSwissHashSet<K, H, A>::ezSwissHashSet(const ezSwissHashSetBase<K, H>& other)
+  : ezSwissHashSetBase<K, H>(other, A::GetAllocator())
+{
+}
+
+template <typename K, typename H, typename A>
+ezSwissHashSet<K, H, A>::ezSwissHashSet(ezSwissHashSet<K, H, A>&& other)
+  : ezSwissHashSetBase<K, H>(std::move(other), other.GetAllocator())
+{
+}
+
+template <typename K, typename H, typename A>
+ezSwissHashSet<K, H, A>::ezSwissHashSet(ezSwissHashSetBase<K, H>&& other)
+  : ezSwissHashSetBase<K, H>(std::move(other), other.GetAllocator())
+{
+}
+
+template <typename K, typename H, typename A>
+void ezSwissHashSet<K, H, A>::operator=(const ezSwissHashSet<K, H, A>& rhs)
+{
+  ezSwissHashSetBase<K, H>::operator=(rhs);
+}
+
+template <typename K, typename H, typename A>
+void ezSwissHashSet<K, H, A>::operator=(const ezSwissHashSetBase<K, H>& rhs)
+{
+  ezSwissHashSetBase<K, H>::operator=(rhs);
+}
+
+template <typename K, typename H, typename A>
+void ezSwissHashSet<K, H, A>::operator=(ezSwissHashSet<K, H, A>&& rhs)
+{
+  ezSwissHashSetBase<K, H>::operator=(std::move(rhs));
+}
+
+template <typename K, typename H, typename A>
+void ezSwissHashSet<K, H, A>::operator=(ezSwissHashSetBase<K, H>&& rhs)
+{
+  ezSwissHashSetBase<K, H>::operator=(std::move(rhs));
+}
@@ -0,0 +1,746 @@
+
+// ***** Const Iterator *****
+
+template <typename K, typename V, typename H>
+ezSwissHashTableBase<K, V, H>::ConstIterator::ConstIterator(const ezSwissHashTableBase<K, V, H>& hashTable)
+  : m_hashTable(&hashTable)
+{
+}
+
+template <typename K, typename V, typename H>
+void ezSwissHashTableBase<K, V, H>::ConstIterator::SetToBegin()
+{
+  if (m_hashTable->IsEmpty())
+  {
+    m_uiCurrentIndex = m_hashTable->m_uiCapacity;
+    return;
+  }
+  while (!m_hashTable->IsValidEntry(m_uiCurrentIndex))
+  {
+    ++m_uiCurrentIndex;
+  }
+}
+
+template <typename K, typename V, typename H>
+inline void ezSwissHashTableBase<K, V, H>::ConstIterator::SetToEnd()
+{
+  m_uiCurrentCount = m_hashTable->m_uiCount;
+  m_uiCurrentIndex = m_hashTable->m_uiCapacity;
+}
+
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE bool ezSwissHashTableBase<K, V, H>::ConstIterator::IsValid() const
+{
+  return m_uiCurrentCount < m_hashTable->m_uiCount;
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE bool ezSwissHashTableBase<K, V, H>::ConstIterator::operator==(
+  const typename ezSwissHashTableBase<K, V, H>::ConstIterator& rhs) const
+{
+  return m_uiCurrentIndex == rhs.m_uiCurrentIndex && m_hashTable->m_pEntries == rhs.m_hashTable->m_pEntries;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE bool ezSwissHashTableBase<K, V, H>::ConstIterator::operator!=(
+  const typename ezSwissHashTableBase<K, V, H>::ConstIterator& rhs) const
+{
+  return !(*this == rhs);
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE const K& ezSwissHashTableBase<K, V, H>::ConstIterator::Key() const
+{
+  return m_hashTable->m_pEntries[m_uiCurrentIndex].key;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE const V& ezSwissHashTableBase<K, V, H>::ConstIterator::Value() const
+{
+  return m_hashTable->m_pEntries[m_uiCurrentIndex].value;
+}
+
+template <typename K, typename V, typename H>
+void ezSwissHashTableBase<K, V, H>::ConstIterator::Next()
+{
+  // if we already iterated over the amount of valid elements that the hash-table stores, early out
+  if (m_uiCurrentCount >= m_hashTable->m_uiCount)
+    return;
+
+  // increase the counter of how many elements we have seen
+  ++m_uiCurrentCount;
+  // increase the index of the element to look at
+  ++m_uiCurrentIndex;
+
+  // check that we don't leave the valid range of element indices
+  while (m_uiCurrentIndex < m_hashTable->m_uiCapacity)
+  {
+    if (m_hashTable->IsValidEntry(m_uiCurrentIndex))
+      return;
+
+    ++m_uiCurrentIndex;
+  }
+
+  // if we fell through this loop, we reached the end of all elements in the container
+  // set the m_uiCurrentCount to maximum, to enable early-out in the future and to make 'IsValid' return 'false'
+  m_uiCurrentCount = m_hashTable->m_uiCount;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE void ezSwissHashTableBase<K, V, H>::ConstIterator::operator++()
+{
+  Next();
+}
+
+
+// ***** Iterator *****
+
+template <typename K, typename V, typename H>
+ezSwissHashTableBase<K, V, H>::Iterator::Iterator(const ezSwissHashTableBase<K, V, H>& hashTable)
+  : ConstIterator(hashTable)
+{
+}
+
+template <typename K, typename V, typename H>
+ezSwissHashTableBase<K, V, H>::Iterator::Iterator(const typename ezSwissHashTableBase<K, V, H>::Iterator& rhs)
+  : ConstIterator(*rhs.m_hashTable)
+{
+  this->m_uiCurrentIndex = rhs.m_uiCurrentIndex;
+  this->m_uiCurrentCount = rhs.m_uiCurrentCount;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE void ezSwissHashTableBase<K, V, H>::Iterator::operator=(const Iterator& rhs) // [tested]
+{
+  this->m_hashTable = rhs.m_hashTable;
+  this->m_uiCurrentIndex = rhs.m_uiCurrentIndex;
+  this->m_uiCurrentCount = rhs.m_uiCurrentCount;
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE V& ezSwissHashTableBase<K, V, H>::Iterator::Value()
+{
+  return this->m_hashTable->m_pEntries[this->m_uiCurrentIndex].value;
+}
+
+
+// ***** ezSwissHashTableBase *****
+
+template <typename K, typename V, typename H>
+ezSwissHashTableBase<K, V, H>::ezSwissHashTableBase(ezAllocatorBase* pAllocator)
+{
+  m_pEntries = nullptr;
+  m_pControl = nullptr;
+  m_uiCount = 0;
+  m_uiCapacity = 0;
+  m_uiGrowthLeft = 0;
+  m_pAllocator = pAllocator;
+}
+
+template <typename K, typename V, typename H>
+ezSwissHashTableBase<K, V, H>::ezSwissHashTableBase(const ezSwissHashTableBase<K, V, H>& other, ezAllocatorBase* pAllocator)
+  : ezSwissHashTableBase(pAllocator)
+{
+  *this = other;
+}
+
+template <typename K, typename V, typename H>
+ezSwissHashTableBase<K, V, H>::ezSwissHashTableBase(ezSwissHashTableBase<K, V, H>&& other, ezAllocatorBase* pAllocator)
+  : ezSwissHashTableBase(pAllocator)
+{
+  *this = std::move(other);
+}
+
+template <typename K, typename V, typename H>
+ezSwissHashTableBase<K, V, H>::~ezSwissHashTableBase()
+{
+  Clear();
+  FreeData();
+}
+
+template <typename K, typename V, typename H>
+void ezSwissHashTableBase<K, V, H>::operator=(const ezSwissHashTableBase<K, V, H>& rhs)
+{
+  Clear();
+  Reserve(rhs.GetCount());
+
+  ezUInt32 uiCopied = 0;
+  for (ezUInt32 i = 0; uiCopied < rhs.GetCount(); ++i)
+  {
+    if (rhs.IsValidEntry(i))
+    {
+      Insert(rhs.m_pEntries[i].key, rhs.m_pEntries[i].value);
+      ++uiCopied;
+    }
+  }
+}
+
+template <typename K, typename V, typename H>
+void ezSwissHashTableBase<K, V, H>::operator=(ezSwissHashTableBase<K, V, H>&& rhs)
+{
+  // Clear any existing data (calls destructors if necessary)
+  Clear();
+
+  if (m_pAllocator != rhs.m_pAllocator)
+  {
+    Reserve(rhs.m_uiCount);
+
+    ezUInt32 uiCopied = 0;
+    for (ezUInt32 i = 0; uiCopied < rhs.GetCount(); ++i)
+    {
+      if (rhs.IsValidEntry(i))
+      {
+        Insert(std::move(rhs.m_pEntries[i].key), std::move(rhs.m_pEntries[i].value));
+        ++uiCopied;
+      }
+    }
+
+    rhs.Clear();
+  }
+  else
+  {
+    FreeData();
+
+    // Move all data over.
+    m_pEntries = rhs.m_pEntries;
+    m_pControl = rhs.m_pControl;
+    m_uiCount = rhs.m_uiCount;
+    m_uiCapacity = rhs.m_uiCapacity;
+    m_uiGrowthLeft = rhs.m_uiGrowthLeft;
+
+    // Temp copy forgets all its state.
+    rhs.m_pEntries = nullptr;
+    rhs.m_pControl = nullptr;
+    rhs.m_uiCount = 0;
+    rhs.m_uiCapacity = 0;
+    rhs.m_uiGrowthLeft = 0;
+  }
+}
+
+template <typename K, typename V, typename H>
+bool ezSwissHashTableBase<K, V, H>::operator==(const ezSwissHashTableBase<K, V, H>& rhs) const
+{
+  if (m_uiCount != rhs.m_uiCount)
+    return false;
+
+  ezUInt32 uiCompared = 0;
+  for (ezUInt32 i = 0; uiCompared < m_uiCount; ++i)
+  {
+    if (IsValidEntry(i))
+    {
+      const V* pRhsValue = nullptr;
+      if (!rhs.TryGetValue(m_pEntries[i].key, pRhsValue))
+        return false;
+
+      if (m_pEntries[i].value != *pRhsValue)
+        return false;
+
+      ++uiCompared;
+    }
+  }
+
+  return true;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE bool ezSwissHashTableBase<K, V, H>::operator!=(const ezSwissHashTableBase<K, V, H>& rhs) const
+{
+  return !(*this == rhs);
+}
+
+template <typename K, typename V, typename H>
+void ezSwissHashTableBase<K, V, H>::Reserve(ezUInt32 uiCapacity)
+{
+  if (uiCapacity <= m_uiCount + m_uiGrowthLeft)
+    return;
+
+  SetCapacity(ezMath::Max(Group::GetCapacityForCount(uiCapacity), m_uiCapacity));
+}
+
+template <typename K, typename V, typename H>
+void ezSwissHashTableBase<K, V, H>::Compact()
+{
+  if (IsEmpty())
+  {
+    // completely deallocate all data, if the table is empty.
+    FreeData();
+  }
+  else
+  {
+    const ezUInt32 uiNewCapacity = Group::GetCapacityForCount(m_uiCount);
+    if (m_uiCapacity != uiNewCapacity)
+      SetCapacity(uiNewCapacity);
+  }
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezUInt32 ezSwissHashTableBase<K, V, H>::GetCount() const
+{
+  return m_uiCount;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE bool ezSwissHashTableBase<K, V, H>::IsEmpty() const
+{
+  return m_uiCount == 0;
+}
+
+template <typename K, typename V, typename H>
+void ezSwissHashTableBase<K, V, H>::Clear()
+{
+  for (ezUInt32 i = 0; i < m_uiCapacity; ++i)
+  {
+    if (IsValidEntry(i))
+    {
+      ezMemoryUtils::Destruct(&m_pEntries[i].key, 1);
+      ezMemoryUtils::Destruct(&m_pEntries[i].value, 1);
+    }
+  }
+
+  ezMemoryUtils::PatternFill(m_pControl, Group::EMPTY, m_uiCapacity);
+  m_uiCount = 0;
+  m_uiGrowthLeft = Group::GetMaxLoad(m_uiCapacity);
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType, typename CompatibleValueType>
+bool ezSwissHashTableBase<K, V, H>::Insert(CompatibleKeyType&& key, CompatibleValueType&& value, V* out_oldValue /*= nullptr*/)
+{
+  const ezUInt32 uiHash = H::Hash(key);
+  ezUInt32 uiIndex = FindEntry(uiHash, key);
+
+  if (uiIndex != ezInvalidIndex)
+  {
+    if (out_oldValue != nullptr)
+      *out_oldValue = std::move(m_pEntries[uiIndex].value);
+
+    m_pEntries[uiIndex].value = std::forward<CompatibleValueType>(value); // Either move or copy assignment.
+    return true;
+  }
+
+  uiIndex = PrepareInsert(uiHash);
+
+  // Both constructions might either be a move or a copy.
+  ezMemoryUtils::CopyOrMoveConstruct(&m_pEntries[uiIndex].key, std::forward<CompatibleKeyType>(key));
+  ezMemoryUtils::CopyOrMoveConstruct(&m_pEntries[uiIndex].value, std::forward<CompatibleValueType>(value));
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+bool ezSwissHashTableBase<K, V, H>::Remove(const CompatibleKeyType& key, V* out_oldValue /*= nullptr*/)
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    if (out_oldValue != nullptr)
+      *out_oldValue = std::move(m_pEntries[uiIndex].value);
+
+    RemoveInternal(uiIndex);
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+typename ezSwissHashTableBase<K, V, H>::Iterator ezSwissHashTableBase<K, V, H>::Remove(const typename ezSwissHashTableBase<K, V, H>::Iterator& pos)
+{
+  Iterator it = pos;
+  ezUInt32 uiIndex = pos.m_uiCurrentIndex;
+  ++it;
+  --it.m_uiCurrentCount;
+  RemoveInternal(uiIndex);
+  return it;
+}
+
+template <typename K, typename V, typename H>
+void ezSwissHashTableBase<K, V, H>::RemoveInternal(ezUInt32 uiIndex)
+{
+  ezMemoryUtils::Destruct(&m_pEntries[uiIndex].key, 1);
+  ezMemoryUtils::Destruct(&m_pEntries[uiIndex].value, 1);
+
+  // Lookups only continue past a group if it has no empty slot, so if this group still has one, no lookup ever went past it
+  // and the slot can be marked as empty. Otherwise it has to stay occupied until the next rehash.
+  const Group group(m_pControl + (uiIndex & ~(Group::SIZE - 1)));
+  if (group.MatchEmpty() != 0)
+  {
+    m_pControl[uiIndex] = Group::EMPTY;
+    ++m_uiGrowthLeft;
+  }
+  else
+  {
+    m_pControl[uiIndex] = Group::DELETED;
+  }
+
+  --m_uiCount;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline bool ezSwissHashTableBase<K, V, H>::TryGetValue(const CompatibleKeyType& key, V& out_value) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    out_value = m_pEntries[uiIndex].value;
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline bool ezSwissHashTableBase<K, V, H>::TryGetValue(const CompatibleKeyType& key, const V*& out_pValue) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    out_pValue = &m_pEntries[uiIndex].value;
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline bool ezSwissHashTableBase<K, V, H>::TryGetValue(const CompatibleKeyType& key, V*& out_pValue)
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    out_pValue = &m_pEntries[uiIndex].value;
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline typename ezSwissHashTableBase<K, V, H>::ConstIterator ezSwissHashTableBase<K, V, H>::Find(const CompatibleKeyType& key) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex == ezInvalidIndex)
+  {
+    return GetEndIterator();
+  }
+
+  ConstIterator it(*this);
+  it.m_uiCurrentIndex = uiIndex;
+  it.m_uiCurrentCount = 0; // we do not know the 'count' (which is used as an optimization), so we just use 0
+
+  return it;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline typename ezSwissHashTableBase<K, V, H>::Iterator ezSwissHashTableBase<K, V, H>::Find(const CompatibleKeyType& key)
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex == ezInvalidIndex)
+  {
+    return GetEndIterator();
+  }
+
+  Iterator it(*this);
+  it.m_uiCurrentIndex = uiIndex;
+  it.m_uiCurrentCount = 0; // we do not know the 'count' (which is used as an optimization), so we just use 0
+  return it;
+}
+
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline const V* ezSwissHashTableBase<K, V, H>::GetValue(const CompatibleKeyType& key) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  return (uiIndex != ezInvalidIndex) ? &m_pEntries[uiIndex].value : nullptr;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline V* ezSwissHashTableBase<K, V, H>::GetValue(const CompatibleKeyType& key)
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  return (uiIndex != ezInvalidIndex) ? &m_pEntries[uiIndex].value : nullptr;
+}
+
+template <typename K, typename V, typename H>
+inline V& ezSwissHashTableBase<K, V, H>::operator[](const K& key)
+{
+  const ezUInt32 uiHash = H::Hash(key);
+  ezUInt32 uiIndex = FindEntry(uiHash, key);
+
+  if (uiIndex == ezInvalidIndex)
+  {
+    uiIndex = PrepareInsert(uiHash);
+
+    // new entry
+    ezMemoryUtils::CopyConstruct(&m_pEntries[uiIndex].key, key, 1);
+    ezMemoryUtils::DefaultConstruct(&m_pEntries[uiIndex].value, 1);
+  }
+  return m_pEntries[uiIndex].value;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE bool ezSwissHashTableBase<K, V, H>::Contains(const CompatibleKeyType& key) const
+{
+  return FindEntry(key) != ezInvalidIndex;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezSwissHashTableBase<K, V, H>::Iterator ezSwissHashTableBase<K, V, H>::GetIterator()
+{
+  Iterator iterator(*this);
+  iterator.SetToBegin();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezSwissHashTableBase<K, V, H>::Iterator ezSwissHashTableBase<K, V, H>::GetEndIterator()
+{
+  Iterator iterator(*this);
+  iterator.SetToEnd();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezSwissHashTableBase<K, V, H>::ConstIterator ezSwissHashTableBase<K, V, H>::GetIterator() const
+{
+  ConstIterator iterator(*this);
+  iterator.SetToBegin();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezSwissHashTableBase<K, V, H>::ConstIterator ezSwissHashTableBase<K, V, H>::GetEndIterator() const
+{
+  ConstIterator iterator(*this);
+  iterator.SetToEnd();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezAllocatorBase* ezSwissHashTableBase<K, V, H>::GetAllocator() const
+{
+  return m_pAllocator;
+}
+
+template <typename K, typename V, typename H>
+ezUInt64 ezSwissHashTableBase<K, V, H>::GetHeapMemoryUsage() const
+{
+  return (ezUInt64)m_uiCapacity * (sizeof(Entry) + sizeof(ezUInt8));
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void ezSwissHashTableBase<KeyType, ValueType, Hasher>::Swap(ezSwissHashTableBase<KeyType, ValueType, Hasher>& other)
+{
+  ezMath::Swap(this->m_pEntries, other.m_pEntries);
+  ezMath::Swap(this->m_pControl, other.m_pControl);
+  ezMath::Swap(this->m_uiCount, other.m_uiCount);
+  ezMath::Swap(this->m_uiCapacity, other.m_uiCapacity);
+  ezMath::Swap(this->m_uiGrowthLeft, other.m_uiGrowthLeft);
+  ezMath::Swap(this->m_pAllocator, other.m_pAllocator);
+}
+
+// private methods
+template <typename K, typename V, typename H>
+void ezSwissHashTableBase<K, V, H>::SetCapacity(ezUInt32 uiCapacity)
+{
+  EZ_ASSERT_DEV(ezMath::IsPowerOf2(uiCapacity) && uiCapacity >= Group::SIZE, "uiCapacity must be a power of two and at least one group.");
+  EZ_ASSERT_DEV(Group::GetMaxLoad(uiCapacity) >= m_uiCount, "uiCapacity is too small for the current number of entries.");
+
+  const ezUInt32 uiOldCapacity = m_uiCapacity;
+  Entry* pOldEntries = m_pEntries;
+  ezUInt8* pOldControl = m_pControl;
+
+  m_uiCapacity = uiCapacity;
+  m_pEntries = EZ_NEW_RAW_BUFFER(m_pAllocator, Entry, m_uiCapacity);
+  m_pControl = EZ_NEW_RAW_BUFFER(m_pAllocator, ezUInt8, m_uiCapacity);
+  ezMemoryUtils::PatternFill(m_pControl, Group::EMPTY, m_uiCapacity);
+  m_uiGrowthLeft = Group::GetMaxLoad(m_uiCapacity) - m_uiCount;
+
+  // all keys are unique, so the entries can be moved into the first free slot without comparing any keys
+  for (ezUInt32 i = 0; i < uiOldCapacity; ++i)
+  {
+    if (Group::IsFull(pOldControl[i]))
+    {
+      const ezUInt32 uiMixedHash = Group::MixHash(H::Hash(pOldEntries[i].key));
+      const ezUInt32 uiIndex = FindFreeEntry(uiMixedHash);
+      m_pControl[uiIndex] = Group::GetTag(uiMixedHash);
+
+      ezMemoryUtils::RelocateConstruct(&m_pEntries[uiIndex].key, &pOldEntries[i].key, 1);
+      ezMemoryUtils::RelocateConstruct(&m_pEntries[uiIndex].value, &pOldEntries[i].value, 1);
+    }
+  }
+
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, pOldEntries);
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, pOldControl);
+}
+
+template <typename K, typename V, typename H>
+void ezSwissHashTableBase<K, V, H>::FreeData()
+{
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pEntries);
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pControl);
+  m_uiCapacity = 0;
+  m_uiGrowthLeft = 0;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE ezUInt32 ezSwissHashTableBase<K, V, H>::FindEntry(const CompatibleKeyType& key) const
+{
+  return FindEntry(H::Hash(key), key);
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline ezUInt32 ezSwissHashTableBase<K, V, H>::FindEntry(ezUInt32 uiHash, const CompatibleKeyType& key) const
+{
+  if (m_uiCapacity > 0)
+  {
+    const ezUInt32 uiMixedHash = Group::MixHash(uiHash);
+    const ezUInt8 uiTag = Group::GetTag(uiMixedHash);
+
+    // there is always at least one empty slot, so this terminates
+    ezInternal::SwissHashProbe probe(uiMixedHash, m_uiCapacity);
+    while (true)
+    {
+      const Group group(m_pControl + probe.GetOffset());
+
+      for (ezUInt32 uiMatches = group.Match(uiTag); uiMatches != 0; uiMatches &= uiMatches - 1)
+      {
+        const ezUInt32 uiIndex = probe.GetOffset() + ezMath::FirstBitLow(uiMatches);
+        if (H::Equal(m_pEntries[uiIndex].key, key))
+          return uiIndex;
+      }
+
+      if (group.MatchEmpty() != 0)
+        break;
+
+      probe.Next();
+    }
+  }
+  // not found
+  return ezInvalidIndex;
+}
+
+template <typename K, typename V, typename H>
+inline ezUInt32 ezSwissHashTableBase<K, V, H>::FindFreeEntry(ezUInt32 uiMixedHash) const
+{
+  ezInternal::SwissHashProbe probe(uiMixedHash, m_uiCapacity);
+  while (true)
+  {
+    const ezUInt32 uiFree = Group(m_pControl + probe.GetOffset()).MatchEmptyOrDeleted();
+    if (uiFree != 0)
+      return probe.GetOffset() + ezMath::FirstBitLow(uiFree);
+
+    probe.Next();
+  }
+}
+
+template <typename K, typename V, typename H>
+ezUInt32 ezSwissHashTableBase<K, V, H>::PrepareInsert(ezUInt32 uiHash)
+{
+  if (m_uiCapacity == 0)
+  {
+    SetCapacity(Group::SIZE);
+  }
+
+  const ezUInt32 uiMixedHash = Group::MixHash(uiHash);
+  ezUInt32 uiIndex = FindFreeEntry(uiMixedHash);
+
+  // reusing a deleted slot is always possible, but using up an empty one requires some growth budget
+  if (m_uiGrowthLeft == 0 && m_pControl[uiIndex] == Group::EMPTY)
+  {
+    // if more than half of the used slots are deleted, rehashing without growing is enough
+    const bool bGrow = m_uiCount > Group::GetMaxLoad(m_uiCapacity) / 2;
+    SetCapacity(bGrow ? m_uiCapacity * 2 : m_uiCapacity);
+
+    uiIndex = FindFreeEntry(uiMixedHash);
+  }
+
+  if (m_pControl[uiIndex] == Group::EMPTY)
+  {
+    --m_uiGrowthLeft;
+  }
+
+  m_pControl[uiIndex] = Group::GetTag(uiMixedHash);
+  ++m_uiCount;
+
+  return uiIndex;
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE bool ezSwissHashTableBase<K, V, H>::IsValidEntry(ezUInt32 uiEntryIndex) const
+{
+  return Group::IsFull(m_pControl[uiEntryIndex]);
+}
+
+
+template <typename K, typename V, typename H, typename A>
+ezSwissHashTable<K, V, H, A>::ezSwissHashTable()
+  : ezSwissHashTableBase<K, V, H>(A::GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezSwissHashTable<K, V, H, A>::ezSwissHashTable(ezAllocatorBase* pAllocator)
+  : ezSwissHashTableBase<K, V, H>(pAllocator)
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezSwissHashTable<K, V, H, A>::ezSwissHashTable(const ezSwissHashTable<K, V, H, A>& other)
+  : ezSwissHashTableBase<K, V, H>(other, A::GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezSwissHashTable<K, V, H, A>::ezSwissHashTable(const ezSwissHashTableBase<K, V, H>& other)
+  : ezSwissHashTableBase<K, V, H>(other, A::GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezSwissHashTable<K, V, H, A>::ezSwissHashTable(ezSwissHashTable<K, V, H, A>&& other)
+  : ezSwissHashTableBase<K, V, H>(std::move(other), other.GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezSwissHashTable<K, V, H, A>::ezSwissHashTable(ezSwissHashTableBase<K, V, H>&& other)
+  : ezSwissHashTableBase<K, V, H>(std::move(other), other.GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezSwissHashTable<K, V, H, A>::operator=(const ezSwissHashTable<K, V, H, A>& rhs)
+{
+  ezSwissHashTableBase<K, V, H>::operator=(rhs);
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezSwissHashTable<K, V, H, A>::operator=(const ezSwissHashTableBase<K, V, H>& rhs)
+{
+  ezSwissHashTableBase<K, V, H>::operator=(rhs);
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezSwissHashTable<K, V, H, A>::operator=(ezSwissHashTable<K, V, H, A>&& rhs)
+{
+  ezSwissHashTableBase<K, V, H>::operator=(std::move(rhs));
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezSwissHashTable<K, V, H, A>::operator=(ezSwissHashTableBase<K, V, H>&& rhs)
+{
+  ezSwissHashTableBase<K, V, H>::operator=(std::move(rhs));
+}
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/Containers/Implementation/SwissHashGroup_inl.h>
+#include <Foundation/Memory/AllocatorWrapper.h>
+#include <Foundation/Types/ArrayPtr.h>
+
+/// \brief Implementation of a hashset, with the same interface as ezHashSet.
+///
+/// Uses the same layout as ezSwissHashTable: every entry has one control byte which holds 7 bits of the hash, and the control bytes of
+/// 16 entries are compared at once. Lookups are considerably faster than with ezHashSet for large sets, and the maximum load is 87.5%.
+/// As with ezSwissHashTable, this only holds up to roughly one million entries, sets that grow much larger should keep using ezHashSet.
+///
+/// Iterators stay valid when entries are removed, but not when entries are inserted.
+/// The hash function can be customized by providing a Hasher helper class like ezHashHelper.
+
+/// \see ezHashHelper
+template <typename KeyType, typename Hasher>
+class ezSwissHashSetBase
+{
+public:
+  /// \brief Const iterator.
+  class ConstIterator
+  {
+  public:
+    /// \brief Checks whether this iterator points to a valid element.
+    bool IsValid() const; // [tested]
+
+    /// \brief Checks whether the two iterators point to the same element.
+    bool operator==(const typename ezSwissHashSetBase<KeyType, Hasher>::ConstIterator& rhs) const;
+
+    /// \brief Checks whether the two iterators point to the same element.
+    bool operator!=(const typename ezSwissHashSetBase<KeyType, Hasher>::ConstIterator& rhs) const;
+
+    /// \brief Returns the 'key' of the element that this iterator points to.
+    const KeyType& Key() const; // [tested]
+
+    /// \brief Returns the 'key' of the element that this iterator points to.
+    EZ_ALWAYS_INLINE const KeyType& operator*() { return Key(); } // [tested]
+
+    /// \brief Advances the iterator to the next element in the map. The iterator will not be valid anymore, if the end is reached.
+    void Next(); // [tested]
+
+    /// \brief Shorthand for 'Next'
+    void operator++(); // [tested]
+
+  protected:
+    friend class ezSwissHashSetBase<KeyType, Hasher>;
+
+    explicit ConstIterator(const ezSwissHashSetBase<KeyType, Hasher>& hashSet);
+    void SetToBegin();
+    void SetToEnd();
+
+    const ezSwissHashSetBase<KeyType, Hasher>* m_hashSet = nullptr;
+    ezUInt32 m_uiCurrentIndex = 0; // current element index that this iterator points to.
+    ezUInt32 m_uiCurrentCount = 0; // current number of valid elements that this iterator has found so far.
+  };
+
+protected:
+  /// \brief Creates an empty hashset. Does not allocate any data yet.
+  ezSwissHashSetBase(ezAllocatorBase* pAllocator); // [tested]
+
+  /// \brief Creates a copy of the given hashset.
+  ezSwissHashSetBase(const ezSwissHashSetBase<KeyType, Hasher>& rhs, ezAllocatorBase* pAllocator); // [tested]
+
+  /// \brief Moves data from an existing hashset into this one.
+  ezSwissHashSetBase(ezSwissHashSetBase<KeyType, Hasher>&& rhs, ezAllocatorBase* pAllocator); // [tested]
+
+  /// \brief Destructor.
+  ~ezSwissHashSetBase(); // [tested]
+
+  /// \brief Copies the data from another hashset into this one.
+  void operator=(const ezSwissHashSetBase<KeyType, Hasher>& rhs); // [tested]
+
+  /// \brief Moves data from an existing hashset into this one.
+  void operator=(ezSwissHashSetBase<KeyType, Hasher>&& rhs); // [tested]
+
+public:
+  /// \brief Compares this table to another table.
+  bool operator==(const ezSwissHashSetBase<KeyType, Hasher>& rhs) const; // [tested]
+
+  /// \brief Compares this table to another table.
+  bool operator!=(const ezSwissHashSetBase<KeyType, Hasher>& rhs) const; // [tested]
+
+  /// \brief Expands the hashset so that the given number of entries can be inserted without growing the set.
+  void Reserve(ezUInt32 uiCapacity); // [tested]
+
+  /// \brief Tries to compact the hashset to avoid wasting memory.
+  ///
+  /// The resulting capacity is at least 'GetCount' (no elements get removed).
+  /// Will deallocate all data, if the hashset is empty.
+  void Compact(); // [tested]
+
+  /// \brief Returns the number of active entries in the table.
+  ezUInt32 GetCount() const; // [tested]
+
+  /// \brief Returns true, if the hashset does not contain any elements.
+  bool IsEmpty() const; // [tested]
+
+  /// \brief Clears the table.
+  void Clear(); // [tested]
+
+  /// \brief Inserts the key. Returns whether the key was already existing.
+  template <typename CompatibleKeyType>
+  bool Insert(CompatibleKeyType&& key); // [tested]
+
+  /// \brief Removes the entry with the given key. Returns if an entry was removed.
+  bool Remove(const KeyType& key); // [tested]
+
+  /// \brief Erases the key at the given Iterator. Returns an iterator to the element after the given iterator.
+  ConstIterator Remove(const ConstIterator& pos); // [tested]
+
+  /// \brief Returns if an entry with given key exists in the table.
+  bool Contains(const KeyType& key) const; // [tested]
+
+  /// \brief Checks whether all keys of the given set are in the container.
+  bool ContainsSet(const ezSwissHashSetBase<KeyType, Hasher>& operand) const; // [tested]
+
+  /// \brief Makes this set the union of itself and the operand.
+  void Union(const ezSwissHashSetBase<KeyType, Hasher>& operand); // [tested]
+
+  /// \brief Makes this set the difference of itself and the operand, i.e. subtracts operand.
+  void Difference(const ezSwissHashSetBase<KeyType, Hasher>& operand); // [tested]
+
+  /// \brief Makes this set the intersection of itself and the operand.
+  void Intersection(const ezSwissHashSetBase<KeyType, Hasher>& operand); // [tested]
+
+  /// \brief Returns a constant Iterator to the very first element.
+  ConstIterator GetIterator() const; // [tested]
+
+  /// \brief Returns a constant Iterator to the first element that is not part of the hashset. Needed to implement range based for loop
+  /// support.
+  ConstIterator GetEndIterator() const;
+
+  /// \brief Returns the allocator that is used by this instance.
+  ezAllocatorBase* GetAllocator() const;
+
+  /// \brief Returns the amount of bytes that are currently allocated on the heap.
+  ezUInt64 GetHeapMemoryUsage() const; // [tested]
+
+  /// \brief Swaps this map with the other one.
+  void Swap(ezSwissHashSetBase<KeyType, Hasher>& other); // [tested]
+
+private:
+  typedef ezInternal::SwissHashGroup Group;
+
+  KeyType* m_pEntries;
+  ezUInt8* m_pControl;
+
+  ezUInt32 m_uiCount;
+  ezUInt32 m_uiCapacity;
+  ezUInt32 m_uiGrowthLeft; // how many empty slots can still be used before the set needs to be rehashed
+
+  ezAllocatorBase* m_pAllocator;
+
+  void SetCapacity(ezUInt32 uiCapacity);
+  void FreeData();
+
+  void RemoveInternal(ezUInt32 uiIndex);
+
+  template <typename CompatibleKeyType>
+  ezUInt32 FindEntry(ezUInt32 uiHash, const CompatibleKeyType& key) const;
+
+  /// \brief Returns the index of the first slot that is free for a new entry on the probe sequence of the given hash.
+  ezUInt32 FindFreeEntry(ezUInt32 uiMixedHash) const;
+
+  /// \brief Marks a free slot as used by a new entry with the given hash and returns its index. The entry itself is not constructed.
+  ezUInt32 PrepareInsert(ezUInt32 uiHash);
+
+  bool IsValidEntry(ezUInt32 uiEntryIndex) const;
+};
+
+/// \brief \see ezSwissHashSetBase
+template <typename KeyType, typename Hasher = ezHashHelper<KeyType>, typename AllocatorWrapper = ezDefaultAllocatorWrapper>
+class ezSwissHashSet : public ezSwissHashSetBase<KeyType, Hasher>
+{
+public:
+  ezSwissHashSet();
+  ezSwissHashSet(ezAllocatorBase* pAllocator);
+
+  ezSwissHashSet(const ezSwissHashSet<KeyType, Hasher, AllocatorWrapper>& other);
+  ezSwissHashSet(const ezSwissHashSetBase<KeyType, Hasher>& other);
+
+  ezSwissHashSet(ezSwissHashSet<KeyType, Hasher, AllocatorWrapper>&& other);
+  ezSwissHashSet(ezSwissHashSetBase<KeyType, Hasher>&& other);
+
+  void operator=(const ezSwissHashSet<KeyType, Hasher, AllocatorWrapper>& rhs);
+  void operator=(const ezSwissHashSetBase<KeyType, Hasher>& rhs);
+
+  void operator=(ezSwissHashSet<KeyType, Hasher, AllocatorWrapper>&& rhs);
+  void operator=(ezSwissHashSetBase<KeyType, Hasher>&& rhs);
+};
+
+template <typename KeyType, typename Hasher>
+typename ezSwissHashSetBase<KeyType, Hasher>::ConstIterator begin(const ezSwissHashSetBase<KeyType, Hasher>& set)
+{
+  return set.GetIterator();
+}
+
+template <typename KeyType, typename Hasher>
+typename ezSwissHashSetBase<KeyType, Hasher>::ConstIterator cbegin(const ezSwissHashSetBase<KeyType, Hasher>& set)
+{
+  return set.GetIterator();
+}
+
+template <typename KeyType, typename Hasher>
+typename ezSwissHashSetBase<KeyType, Hasher>::ConstIterator end(const ezSwissHashSetBase<KeyType, Hasher>& set)
+{
+  return set.GetEndIterator();
+}
+
+template <typename KeyType, typename Hasher>
+typename ezSwissHashSetBase<KeyType, Hasher>::ConstIterator cend(const ezSwissHashSetBase<KeyType, Hasher>& set)
+{
+  return set.GetEndIterator();
+}
+
+#include <Foundation/Containers/Implementation/SwissHashSet_inl.h>
@@ -31,15 +31,18 @@ void ezProcessingStream::SetSize(ezUInt64 uiNumElements)
     return;
   }
 
+  // padded, so that the last chunk can be processed with whole SIMD vectors
+  const ezUInt64 uiNumAllocatedElements = (uiNumElements + ElementGranularity - 1) / ElementGranularity * ElementGranularity;
+
   /// \todo Allow to reuse memory from a pool ?
   if (m_uiAlignment > 0)
   {
-    m_pData =
-      ezFoundation::GetAlignedAllocator()->Allocate(static_cast<size_t>(uiNumElements * GetDataTypeSize(m_Type)), static_cast<size_t>(m_uiAlignment));
+    m_pData = ezFoundation::GetAlignedAllocator()->Allocate(
+      static_cast<size_t>(uiNumAllocatedElements * GetDataTypeSize(m_Type)), static_cast<size_t>(m_uiAlignment));
   }
   else
   {
-    m_pData = ezFoundation::GetDefaultAllocator()->Allocate(static_cast<size_t>(uiNumElements * GetDataTypeSize(m_Type)), 0);
+    m_pData = ezFoundation::GetDefaultAllocator()->Allocate(static_cast<size_t>(uiNumAllocatedElements * GetDataTypeSize(m_Type)), 0);
   }
 
   EZ_ASSERT_DEV(m_pData != nullptr, "Allocating {0} elements of {1} bytes each, with {2} bytes alignment, failed", uiNumElements,
@@ -59,6 +62,8 @@ void ezProcessingStream::FreeData()
     {
       ezFoundation::GetDefaultAllocator()->Deallocate(m_pData);
     }
+
+    m_pData = nullptr;
   }
 
   m_uiNumElements = 0;
@@ -6,6 +6,50 @@
 #include <Foundation/DataProcessing/Stream/ProcessingStreamProcessor.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Memory/MemoryUtils.h>
+#include <Foundation/Threading/DelegateTask.h>
+
+namespace
+{
+  // the data of all streams of one chunk should fit into the L1 cache
+  static constexpr ezUInt64 s_uiChunkSizeInBytes = 16 * 1024;
+
+  /// \brief The streams that one or several processors read and write.
+  struct StreamAccess
+  {
+    void Add(const ezHybridArray<const ezProcessingStream*, 4>& readStreams, const ezHybridArray<const ezProcessingStream*, 4>& writeStreams)
+    {
+      // processors that do not declare anything may access any stream
+      m_bAnyStream |= readStreams.IsEmpty() && writeStreams.IsEmpty();
+
+      m_ReadStreams.PushBackRange(readStreams);
+      m_WriteStreams.PushBackRange(writeStreams);
+    }
+
+    bool ConflictsWith(const StreamAccess& other) const
+    {
+      if (m_bAnyStream || other.m_bAnyStream)
+        return true;
+
+      for (const ezProcessingStream* pStream : m_WriteStreams)
+      {
+        if (other.m_ReadStreams.Contains(pStream) || other.m_WriteStreams.Contains(pStream))
+          return true;
+      }
+
+      for (const ezProcessingStream* pStream : other.m_WriteStreams)
+      {
+        if (m_ReadStreams.Contains(pStream))
+          return true;
+      }
+
+      return false;
+    }
+
+    ezHybridArray<const ezProcessingStream*, 8> m_ReadStreams;
+    ezHybridArray<const ezProcessingStream*, 8> m_WriteStreams;
+    bool m_bAnyStream = false;
+  };
+} // namespace
 
 ezProcessingStreamGroup::ezProcessingStreamGroup()
 {
@@ -20,6 +64,7 @@ ezProcessingStreamGroup::~ezProcessingStreamGroup()
 void ezProcessingStreamGroup::Clear()
 {
   ClearProcessors();
+  m_Batches.Clear();
 
   m_uiPendingNumberOfElementsToSpawn = 0;
   m_uiNumElements = 0;
@@ -56,6 +101,8 @@ void ezProcessingStreamGroup::RemoveProcessor(ezProcessingStreamProcessor* pProc
 {
   m_Processors.RemoveAndCopy(pProcessor);
   pProcessor->GetDynamicRTTI()->GetAllocator()->Deallocate(pProcessor);
+
+  m_bStreamAssignmentDirty = true;
 }
 
 void ezProcessingStreamGroup::ClearProcessors()
@@ -140,7 +187,10 @@ void ezProcessingStreamGroup::SetSize(ezUInt64 uiNumElements)
 /// processors).
 void ezProcessingStreamGroup::RemoveElement(ezUInt64 uiElementIndex)
 {
-  if (m_PendingRemoveIndices.Contains(uiElementIndex))
+  EZ_LOCK(m_PendingOperationsMutex);
+
+  // in batched mode, duplicates are removed after sorting
+  if (!m_bBatchedElementRemoval && m_PendingRemoveIndices.Contains(uiElementIndex))
     return;
 
   EZ_ASSERT_DEBUG(uiElementIndex < m_uiNumActiveElements, "Element which should be removed is outside of active element range!");
@@ -152,6 +202,8 @@ void ezProcessingStreamGroup::RemoveElement(ezUInt64 uiElementIndex)
 /// spawning will be queued.
 void ezProcessingStreamGroup::InitializeElements(ezUInt64 uiNumElements)
 {
+  EZ_LOCK(m_PendingOperationsMutex);
+
   m_uiPendingNumberOfElementsToSpawn += uiNumElements;
 }
 
@@ -159,10 +211,15 @@ void ezProcessingStreamGroup::Process()
 {
   EnsureStreamAssignmentValid();
 
-  // TODO: Identify which processors work on which streams and find independent groups and use separate tasks for them?
-  for (ezProcessingStreamProcessor* pStreamProcessor : m_Processors)
+  // with a single chunk there is nothing to distribute
+  const bool bParallel = m_bParallelProcessing && m_uiNumActiveElements > m_uiChunkSize;
+
+  for (ezUInt32 uiBatch = 0; uiBatch < m_Batches.GetCount(); ++uiBatch)
   {
-    pStreamProcessor->Process(m_uiNumActiveElements);
+    if (bParallel)
+      ProcessBatchParallel(uiBatch);
+    else
+      ProcessBatchSerial(uiBatch);
   }
 
   // Run any pending deletions which happened due to stream processor execution
@@ -173,9 +230,97 @@ void ezProcessingStreamGroup::Process()
   RunPendingSpawns();
 }
 
+void ezProcessingStreamGroup::ProcessBatchSerial(ezUInt32 uiBatch)
+{
+  const ProcessingBatch& batch = m_Batches[uiBatch];
+
+  if (!batch.m_RangeProcessors.IsEmpty())
+  {
+    ProcessChunks(uiBatch, 0, (m_uiNumActiveElements + m_uiChunkSize - 1) / m_uiChunkSize);
+  }
+
+  for (ezProcessingStreamProcessor* pStreamProcessor : batch.m_Processors)
+  {
+    pStreamProcessor->Process(m_uiNumActiveElements);
+  }
+}
+
+void ezProcessingStreamGroup::ProcessBatchParallel(ezUInt32 uiBatch)
+{
+  ProcessingBatch& batch = m_Batches[uiBatch];
+
+  // without range processors, the first processor is executed on this thread
+  const ezUInt32 uiFirstTask = batch.m_RangeProcessors.IsEmpty() ? 1 : 0;
+
+  ezTaskGroupID taskGroup;
+  if (batch.m_Processors.GetCount() > uiFirstTask)
+  {
+    for (ezUInt32 i = batch.m_Tasks.GetCount(); i < batch.m_Processors.GetCount(); ++i)
+    {
+      ezProcessingStreamProcessor* pStreamProcessor = batch.m_Processors[i];
+      batch.m_Tasks.PushBack(EZ_DEFAULT_NEW(
+        ezDelegateTask<void>, "ezProcessingStreamProcessor", [this, pStreamProcessor]() { pStreamProcessor->Process(m_uiNumActiveElements); }));
+    }
+
+    taskGroup = ezTaskSystem::CreateTaskGroup(ezTaskPriority::ThisFrame);
+
+    for (ezUInt32 i = uiFirstTask; i < batch.m_Tasks.GetCount(); ++i)
+    {
+      ezTaskSystem::AddTaskToGroup(taskGroup, batch.m_Tasks[i]);
+    }
+
+    ezTaskSystem::StartTaskGroup(taskGroup);
+  }
+
+  if (batch.m_RangeProcessors.IsEmpty())
+  {
+    batch.m_Processors[0]->Process(m_uiNumActiveElements);
+  }
+  else
+  {
+    const ezUInt32 uiNumChunks = static_cast<ezUInt32>((m_uiNumActiveElements + m_uiChunkSize - 1) / m_uiChunkSize);
+
+    // the cost of a chunk only depends on the processors in the batch, so small groups are processed on this thread
+    ezParallelForParams params;
+    params.bAdaptive = true;
+    params.pCostCache = &batch.m_ChunkCost;
+
+    ezTaskSystem::ParallelForIndexed(
+      0, uiNumChunks, [this, uiBatch](ezUInt32 uiStartChunk, ezUInt32 uiEndChunk) { ProcessChunks(uiBatch, uiStartChunk, uiEndChunk); },
+      "ezProcessingStreamGroup", params);
+  }
+
+  if (taskGroup.IsValid())
+  {
+    ezTaskSystem::WaitForGroup(taskGroup);
+  }
+}
+
+void ezProcessingStreamGroup::ProcessChunks(ezUInt32 uiBatch, ezUInt64 uiFirstChunk, ezUInt64 uiEndChunk)
+{
+  const ProcessingBatch& batch = m_Batches[uiBatch];
+
+  // all range processors work on the same chunk one after another, while its data is still in the cache
+  for (ezUInt64 uiChunk = uiFirstChunk; uiChunk < uiEndChunk; ++uiChunk)
+  {
+    const ezUInt64 uiStartIndex = uiChunk * m_uiChunkSize;
+    const ezUInt64 uiNumElements = ezMath::Min(m_uiChunkSize, m_uiNumActiveElements - uiStartIndex);
+
+    for (ezProcessingStreamProcessor* pStreamProcessor : batch.m_RangeProcessors)
+    {
+      pStreamProcessor->ProcessRange(uiStartIndex, uiNumElements);
+    }
+  }
+}
 
 void ezProcessingStreamGroup::RunPendingDeletions()
 {
+  if (m_bBatchedElementRemoval)
+  {
+    RunPendingDeletionsBatched();
+    return;
+  }
+
   ezStreamGroupElementRemovedEvent e;
   e.m_pStreamGroup = this;
 
@@ -239,6 +384,114 @@ void ezProcessingStreamGroup::RunPendingDeletions()
   m_PendingRemoveIndices.Clear();
 }
 
+void ezProcessingStreamGroup::RunPendingDeletionsBatched()
+{
+  if (m_PendingRemoveIndices.IsEmpty())
+    return;
+
+  m_PendingRemoveIndices.Sort();
+
+  ezUInt32 uiNumRemoved = 0;
+  for (ezUInt32 i = 0; i < m_PendingRemoveIndices.GetCount(); ++i)
+  {
+    if (uiNumRemoved == 0 || m_PendingRemoveIndices[i] != m_PendingRemoveIndices[uiNumRemoved - 1])
+    {
+      m_PendingRemoveIndices[uiNumRemoved++] = m_PendingRemoveIndices[i];
+    }
+  }
+
+  m_PendingRemoveIndices.SetCountUninitialized(uiNumRemoved);
+
+  EZ_ASSERT_DEBUG(m_PendingRemoveIndices.PeekBack() < m_uiNumActiveElements, "Invalid index to remove");
+
+  const ezUInt64 uiNewNumActiveElements = m_uiNumActiveElements - uiNumRemoved;
+
+  // The holes below the new number of active elements are filled with the remaining elements above it, both in ascending order.
+  // Since the indices are sorted, the removed elements above the new end are at the back of the array.
+  m_ElementMoves.Clear();
+
+  ezUInt32 uiNextHole = 0;
+  ezUInt32 uiNextRemovedAboveEnd = 0;
+  while (uiNextRemovedAboveEnd < uiNumRemoved && m_PendingRemoveIndices[uiNextRemovedAboveEnd] < uiNewNumActiveElements)
+  {
+    ++uiNextRemovedAboveEnd;
+  }
+
+  for (ezUInt64 uiElement = uiNewNumActiveElements; uiElement < m_uiNumActiveElements; ++uiElement)
+  {
+    if (uiNextRemovedAboveEnd < uiNumRemoved && m_PendingRemoveIndices[uiNextRemovedAboveEnd] == uiElement)
+    {
+      ++uiNextRemovedAboveEnd;
+      continue;
+    }
+
+    ezStreamGroupElementsRemovedEvent::Move& move = m_ElementMoves.ExpandAndGetRef();
+    move.m_uiOldIndex = uiElement;
+    move.m_uiNewIndex = m_PendingRemoveIndices[uiNextHole++];
+  }
+
+  // inform any interested party about the tragic deaths, while the data is still there
+  {
+    ezStreamGroupElementRemovedEvent e;
+    e.m_pStreamGroup = this;
+
+    for (ezUInt64 uiElementIndex : m_PendingRemoveIndices)
+    {
+      e.m_uiElementIndex = uiElementIndex;
+      m_ElementRemovedEvent.Broadcast(e);
+    }
+
+    ezStreamGroupElementsRemovedEvent e2;
+    e2.m_pStreamGroup = this;
+    e2.m_RemovedIndices = m_PendingRemoveIndices;
+    e2.m_MovedElements = m_ElementMoves;
+    m_ElementsRemovedEvent.Broadcast(e2);
+  }
+
+  // Move the data, consecutive elements that move to consecutive holes are copied at once
+  for (ezProcessingStream* pStream : m_DataStreams)
+  {
+    const ezUInt64 uiStreamElementStride = pStream->GetElementStride();
+    const ezUInt64 uiStreamElementSize = pStream->GetElementSize();
+    ezUInt8* pData = static_cast<ezUInt8*>(pStream->GetWritableData());
+
+    for (ezUInt32 uiFirstMove = 0; uiFirstMove < m_ElementMoves.GetCount();)
+    {
+      const ezStreamGroupElementsRemovedEvent::Move& firstMove = m_ElementMoves[uiFirstMove];
+
+      ezUInt32 uiNumMoves = 1;
+      while (uiFirstMove + uiNumMoves < m_ElementMoves.GetCount() &&
+             m_ElementMoves[uiFirstMove + uiNumMoves].m_uiOldIndex == firstMove.m_uiOldIndex + uiNumMoves &&
+             m_ElementMoves[uiFirstMove + uiNumMoves].m_uiNewIndex == firstMove.m_uiNewIndex + uiNumMoves)
+      {
+        ++uiNumMoves;
+      }
+
+      // the source is always above the new end and the target below it, so they never overlap
+      const ezUInt8* pSourceData = pData + firstMove.m_uiOldIndex * uiStreamElementStride;
+      ezUInt8* pTargetData = pData + firstMove.m_uiNewIndex * uiStreamElementStride;
+
+      if (uiStreamElementStride == uiStreamElementSize)
+      {
+        ezMemoryUtils::RawByteCopy(pTargetData, pSourceData, static_cast<size_t>(uiNumMoves * uiStreamElementSize));
+      }
+      else
+      {
+        for (ezUInt32 i = 0; i < uiNumMoves; ++i)
+        {
+          ezMemoryUtils::RawByteCopy(pTargetData + i * uiStreamElementStride, pSourceData + i * uiStreamElementStride, static_cast<size_t>(uiStreamElementSize));
+        }
+      }
+
+      uiFirstMove += uiNumMoves;
+    }
+  }
+
+  m_uiNumActiveElements = uiNewNumActiveElements;
+
+  m_PendingRemoveIndices.Clear();
+}
+
 void ezProcessingStreamGroup::EnsureStreamAssignmentValid()
 {
   // If any stream processors or streams were added we may need to inform them.
@@ -247,16 +500,25 @@ void ezProcessingStreamGroup::EnsureStreamAssignmentValid()
     SortProcessorsByPriority();
 
     // Set the new size on all stream.
+    ezUInt64 uiBytesPerElement = 0;
     for (ezProcessingStream* Stream : m_DataStreams)
     {
       Stream->SetSize(m_uiNumElements);
+      uiBytesPerElement += Stream->GetElementSize();
     }
 
+    const ezUInt64 uiGranularity = ezProcessingStream::ElementGranularity;
+    m_uiChunkSize = ezMath::Max(uiGranularity, s_uiChunkSizeInBytes / ezMath::Max<ezUInt64>(uiBytesPerElement, 1) / uiGranularity * uiGranularity);
+
     for (ezProcessingStreamProcessor* pStreamProcessor : m_Processors)
     {
+      pStreamProcessor->m_ReadStreams.Clear();
+      pStreamProcessor->m_WriteStreams.Clear();
       pStreamProcessor->UpdateStreamBindings();
     }
 
+    UpdateProcessingBatches();
+
     m_bStreamAssignmentDirty = false;
   }
 }
@@ -298,4 +560,52 @@ void ezProcessingStreamGroup::SortProcessorsByPriority()
   m_Processors.Sort(cmp);
 }
 
+void ezProcessingStreamGroup::UpdateProcessingBatches()
+{
+  m_Batches.Clear();
+
+  // a processor is added to the current batch, if it does not access the streams that any other processor in the batch writes, and vice versa
+  StreamAccess rangeAccess;
+  ezHybridArray<StreamAccess, 4> processorAccess;
+
+  for (ezProcessingStreamProcessor* pStreamProcessor : m_Processors)
+  {
+    StreamAccess access;
+    access.Add(pStreamProcessor->m_ReadStreams, pStreamProcessor->m_WriteStreams);
+
+    bool bFitsIntoBatch = !m_Batches.IsEmpty();
+
+    for (ezUInt32 i = 0; bFitsIntoBatch && i < processorAccess.GetCount(); ++i)
+    {
+      bFitsIntoBatch = !access.ConflictsWith(processorAccess[i]);
+    }
+
+    // range processors may depend on each other, since they are executed one after another on each chunk
+    if (bFitsIntoBatch && !pStreamProcessor->m_bSupportsRangeProcessing && !m_Batches.PeekBack().m_RangeProcessors.IsEmpty())
+    {
+      bFitsIntoBatch = !access.ConflictsWith(rangeAccess);
+    }
+
+    if (!bFitsIntoBatch)
+    {
+      m_Batches.ExpandAndGetRef();
+      rangeAccess = StreamAccess();
+      processorAccess.Clear();
+    }
+
+    ProcessingBatch& batch = m_Batches.PeekBack();
+
+    if (pStreamProcessor->m_bSupportsRangeProcessing)
+    {
+      batch.m_RangeProcessors.PushBack(pStreamProcessor);
+      rangeAccess.Add(pStreamProcessor->m_ReadStreams, pStreamProcessor->m_WriteStreams);
+    }
+    else
+    {
+      batch.m_Processors.PushBack(pStreamProcessor);
+      processorAccess.PushBack(access);
+    }
+  }
+}
+
 EZ_STATICLINK_FILE(Foundation, Foundation_DataProcessing_Stream_Implementation_ProcessingStreamGroup);
@@ -19,6 +19,21 @@ ezProcessingStreamProcessor::~ezProcessingStreamProcessor()
   m_pStreamGroup = nullptr;
 }
 
+void ezProcessingStreamProcessor::DeclareStreamRead(const ezProcessingStream* pStream)
+{
+  if (pStream != nullptr && !m_ReadStreams.Contains(pStream))
+  {
+    m_ReadStreams.PushBack(pStream);
+  }
+}
+
+void ezProcessingStreamProcessor::DeclareStreamWrite(const ezProcessingStream* pStream)
+{
+  if (pStream != nullptr && !m_WriteStreams.Contains(pStream))
+  {
+    m_WriteStreams.PushBack(pStream);
+  }
+}
 
 
 EZ_STATICLINK_FILE(Foundation, Foundation_DataProcessing_Stream_Implementation_ProcessingStreamProcessor);
@@ -83,6 +83,14 @@ public:
 
   static size_t GetDataTypeSize(DataType Type);
 
+  /// \brief The storage of a stream is always allocated for a multiple of this many elements and ezProcessingStreamGroup only splits
+  /// the elements into chunks at multiples of it.
+  ///
+  /// Since the smallest element is 2 bytes and the stream data is 64 byte aligned, every chunk starts on its own cache line, which allows
+  /// aligned SIMD loads. The last chunk may be processed with full SIMD vectors, even if that reads and writes a few elements behind the
+  /// last active one.
+  static constexpr ezUInt32 ElementGranularity = 32;
+
 protected:
   friend class ezProcessingStreamGroup;
 
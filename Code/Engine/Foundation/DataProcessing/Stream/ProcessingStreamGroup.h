@@ -5,6 +5,8 @@
 #include <Foundation/Communication/Event.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStream.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/TaskSystem.h>
 
 class ezProcessingStreamProcessor;
 class ezProcessingStreamGroup;
@@ -15,12 +17,40 @@ struct ezStreamGroupElementRemovedEvent
   ezUInt64 m_uiElementIndex;
 };
 
+/// \brief Sent once per ezProcessingStreamGroup::Process() in batched removal mode, see ezProcessingStreamGroup::SetBatchedElementRemoval().
+///
+/// The event is sent before the streams are compacted, so the data of the removed elements is still accessible.
+struct ezStreamGroupElementsRemovedEvent
+{
+  /// \brief An element that is moved into the place of a removed element.
+  struct Move
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt64 m_uiOldIndex;
+    ezUInt64 m_uiNewIndex;
+  };
+
+  ezProcessingStreamGroup* m_pStreamGroup;
+
+  /// \brief The indices of all removed elements, sorted ascending and without duplicates.
+  ezArrayPtr<const ezUInt64> m_RemovedIndices;
+
+  /// \brief The elements that change their index, sorted by their new index. All other remaining elements keep their index.
+  ezArrayPtr<const Move> m_MovedElements;
+};
+
 struct ezStreamGroupElementsClearedEvent
 {
   ezProcessingStreamGroup* m_pStreamGroup;
 };
 
 /// \brief A stream group encapsulates the streams and the corresponding data processors.
+///
+/// Processors that implement ezProcessingStreamProcessor::ProcessRange() are executed on cache sized chunks of the elements,
+/// which are distributed across the worker threads of the ezTaskSystem. Processors that declare which streams they read and write
+/// are additionally executed concurrently with all other processors that do not write the streams they access.
+/// All other processors are executed one after another on the calling thread, just like before.
 class EZ_FOUNDATION_DLL ezProcessingStreamGroup
 {
 public:
@@ -67,6 +97,30 @@ public:
   /// \brief Runs the stream processors which have been added to the stream group.
   void Process();
 
+  /// \brief Allows to disable the parallel execution of processors, e.g. when the stream group is already updated from within a task.
+  /// Enabled by default.
+  void SetParallelProcessingEnabled(bool bEnable) { m_bParallelProcessing = bEnable; }
+
+  /// \brief Returns whether processors may be executed on several threads.
+  bool IsParallelProcessingEnabled() const { return m_bParallelProcessing; }
+
+  /// \brief Enables removing all pending elements at once, which is much faster when many elements are removed per Process() call.
+  ///
+  /// The pending indices are sorted once, the holes below the new number of active elements are filled with the remaining elements
+  /// above it, and each stream is compacted with one pass of bulk memory copies. m_ElementRemovedEvent is still sent for every removed
+  /// element, with the index referring to the uncompacted streams. Additionally, m_ElementsRemovedEvent is sent once with all moved
+  /// elements. Disabled by default, in which case elements are removed one by one in the order RemoveElement() was called.
+  void SetBatchedElementRemoval(bool bEnable) { m_bBatchedElementRemoval = bEnable; }
+
+  /// \brief Returns whether pending elements are removed all at once, see SetBatchedElementRemoval().
+  bool IsBatchedElementRemovalEnabled() const { return m_bBatchedElementRemoval; }
+
+  /// \brief Returns the number of elements that are passed to ezProcessingStreamProcessor::ProcessRange() at once.
+  ///
+  /// The chunk size is chosen, such that the data of one chunk of all streams fits into the L1 cache and is always a multiple of
+  /// ezProcessingStream::ElementGranularity.
+  ezUInt64 GetChunkSize() const { return m_uiChunkSize; }
+
   /// \brief Returns the number of elements the streams store.
   inline ezUInt64 GetNumElements() const { return m_uiNumElements; }
 
@@ -79,22 +133,48 @@ public:
   /// \brief Subscribe to this event to be informed when (shortly before) items are deleted.
   ezEvent<const ezStreamGroupElementRemovedEvent&> m_ElementRemovedEvent;
 
+  /// \brief Sent once with all removed and moved elements, shortly before they are deleted. Only sent in batched removal mode.
+  ezEvent<const ezStreamGroupElementsRemovedEvent&> m_ElementsRemovedEvent;
+
 private:
   /// \brief Internal helper function which removes any pending elements and spawns new elements as needed
   void RunPendingDeletions();
 
+  void RunPendingDeletionsBatched();
+
   void EnsureStreamAssignmentValid();
 
   void RunPendingSpawns();
 
   void SortProcessorsByPriority();
 
+  void UpdateProcessingBatches();
+
+  void ProcessBatchSerial(ezUInt32 uiBatch);
+
+  void ProcessBatchParallel(ezUInt32 uiBatch);
+
+  void ProcessChunks(ezUInt32 uiBatch, ezUInt64 uiFirstChunk, ezUInt64 uiEndChunk);
+
+  /// \brief Processors that can be executed concurrently. Range processors are executed chunk by chunk, all others run in separate tasks.
+  struct ProcessingBatch
+  {
+    ezHybridArray<ezProcessingStreamProcessor*, 4> m_RangeProcessors;
+    ezHybridArray<ezProcessingStreamProcessor*, 4> m_Processors;
+    ezHybridArray<ezSharedPtr<ezTask>, 4> m_Tasks;
+    ezParallelForCostCache m_ChunkCost;
+  };
+
   ezHybridArray<ezProcessingStreamProcessor*, 8> m_Processors;
 
+  ezHybridArray<ProcessingBatch, 8> m_Batches;
+
   ezHybridArray<ezProcessingStream*, 8> m_DataStreams;
 
   ezHybridArray<ezUInt64, 64> m_PendingRemoveIndices;
 
+  ezDynamicArray<ezStreamGroupElementsRemovedEvent::Move> m_ElementMoves;
+
   ezUInt64 m_uiPendingNumberOfElementsToSpawn;
 
   ezUInt64 m_uiNumElements;
@@ -103,5 +183,14 @@ private:
 
   ezUInt64 m_uiHighestNumActiveElements;
 
+  ezUInt64 m_uiChunkSize = ezProcessingStream::ElementGranularity;
+
+  /// \brief Protects the pending removals and spawns, which may be requested by processors that run in parallel.
+  ezMutex m_PendingOperationsMutex;
+
   bool m_bStreamAssignmentDirty;
+
+  bool m_bParallelProcessing = true;
+
+  bool m_bBatchedElementRemoval = false;
 };
@@ -2,8 +2,10 @@
 #pragma once
 
 #include <Foundation/Basics.h>
+#include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Reflection/Reflection.h>
 
+class ezProcessingStream;
 class ezProcessingStreamGroup;
 
 /// \brief Base class for all stream processor implementations.
@@ -21,6 +23,9 @@ public:
   /// Used for sorting processors, to ensure a certain order. Lower priority == executed first.
   float m_fPriority = 0.0f;
 
+  /// \brief Returns whether the processor implements ProcessRange(), see m_bSupportsRangeProcessing.
+  bool SupportsRangeProcessing() const { return m_bSupportsRangeProcessing; }
+
 protected:
   friend class ezProcessingStreamGroup;
 
@@ -35,7 +40,32 @@ protected:
   /// \brief The actual method which processes the data, will be called with the number of elements to process.
   virtual void Process(ezUInt64 uiNumElements) = 0;
 
+  /// \brief Processes only the elements in the given range. Called instead of Process(), if m_bSupportsRangeProcessing is set.
+  ///
+  /// The stream group splits the active elements into chunks that fit into the cache and calls this function for several chunks in
+  /// parallel. Within one chunk, all range processors that follow each other are executed in order, before the next chunk is processed.
+  /// Therefore the function must only access the elements in the given range and must not modify any other state of the processor.
+  /// uiStartIndex is always a multiple of ezProcessingStream::ElementGranularity, so the data of every chunk is at least 16 byte aligned
+  /// and may be processed with ezSimdVec4f loads and stores. Rounding uiNumElements up to whole SIMD vectors is allowed as well.
+  virtual void ProcessRange(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) {}
+
+  /// \brief Declares that Process() or ProcessRange() reads the given stream. Should be called in UpdateStreamBindings().
+  ///
+  /// Processors that declare which streams they read and write may be executed concurrently with other processors that do not
+  /// write to the same streams. Processors that declare nothing are never executed concurrently with any other processor.
+  void DeclareStreamRead(const ezProcessingStream* pStream);
+
+  /// \brief Declares that Process() or ProcessRange() writes the given stream. Should be called in UpdateStreamBindings().
+  void DeclareStreamWrite(const ezProcessingStream* pStream);
+
   /// \brief Back pointer to the stream group - will be set to the owner stream group when adding the stream processor to the group.
   /// Can be used to get stream pointers in UpdateStreamBindings();
   ezProcessingStreamGroup* m_pStreamGroup;
+
+  /// \brief Set this in the constructor of processors that implement ProcessRange().
+  bool m_bSupportsRangeProcessing = false;
+
+private:
+  ezHybridArray<const ezProcessingStream*, 4> m_ReadStreams;
+  ezHybridArray<const ezProcessingStream*, 4> m_WriteStreams;
 };
@@ -107,10 +107,13 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Memory_Implementation_AllocatorWrapper);
   EZ_STATICLINK_REFERENCE(Foundation_Memory_Implementation_EndianHelper);
   EZ_STATICLINK_REFERENCE(Foundation_Memory_Implementation_FrameAllocator);
+  EZ_STATICLINK_REFERENCE(Foundation_Memory_Implementation_LargeBlockAllocator);
   EZ_STATICLINK_REFERENCE(Foundation_Memory_Implementation_MemoryTracker);
   EZ_STATICLINK_REFERENCE(Foundation_Memory_Implementation_MemoryUtils);
   EZ_STATICLINK_REFERENCE(Foundation_Memory_Implementation_PageAllocator);
   EZ_STATICLINK_REFERENCE(Foundation_Memory_Policies_GuardedAllocation);
+  EZ_STATICLINK_REFERENCE(Foundation_Memory_Policies_PoolAllocation);
+  EZ_STATICLINK_REFERENCE(Foundation_Memory_Policies_ScalableHeapAllocation);
   EZ_STATICLINK_REFERENCE(Foundation_Profiling_Implementation_Profiling);
   EZ_STATICLINK_REFERENCE(Foundation_Reflection_Implementation_PropertyAttributes);
   EZ_STATICLINK_REFERENCE(Foundation_Reflection_Implementation_PropertyPath);
@@ -125,6 +128,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Serialization_Implementation_ReflectionSerializer);
   EZ_STATICLINK_REFERENCE(Foundation_Serialization_Implementation_RttiConverterReader);
   EZ_STATICLINK_REFERENCE(Foundation_Serialization_Implementation_RttiConverterWriter);
+  EZ_STATICLINK_REFERENCE(Foundation_SimdMath_Implementation_SimdKernels);
   EZ_STATICLINK_REFERENCE(Foundation_SimdMath_Implementation_SimdMat4f);
   EZ_STATICLINK_REFERENCE(Foundation_SimdMath_Implementation_SimdNoise);
   EZ_STATICLINK_REFERENCE(Foundation_SimdMath_Implementation_SimdQuat);
@@ -136,6 +140,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Strings_Implementation_StringUtils);
   EZ_STATICLINK_REFERENCE(Foundation_Strings_Implementation_StringView);
   EZ_STATICLINK_REFERENCE(Foundation_Strings_Implementation_TranslationLookup);
+  EZ_STATICLINK_REFERENCE(Foundation_Strings_Implementation_UnicodeUtils);
   EZ_STATICLINK_REFERENCE(Foundation_Strings_Implementation_snprintf);
   EZ_STATICLINK_REFERENCE(Foundation_System_Implementation_CrashHandler);
   EZ_STATICLINK_REFERENCE(Foundation_System_Implementation_MiniDumpUtils);
@@ -150,6 +155,8 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_Task);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_TaskGroup);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_TaskSystem);
+  EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_TaskSystemCoroutines);
+  EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_TaskSystemForkJoin);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_TaskSystemGroups);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_TaskSystemTasks);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_TaskSystemThreads);
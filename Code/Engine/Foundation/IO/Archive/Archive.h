@@ -12,6 +12,7 @@ enum class ezArchiveCompressionMode : ezUInt8
   Uncompressed,
   Compressed_zstd,
   Compressed_zip,
+  Compressed_zstd_seekable, ///< Independently compressed zstd blocks, see ezSeekableStreamWriterZstd. The block index is stored in the ezArchiveTOC.
 };
 
 /// \brief Data for a single file entry in an ezArchive file
@@ -23,6 +24,11 @@ public:
   ezUInt64 m_uiStoredDataSize = 0;       ///< The amount of (compressed) bytes actually stored in the ezArchive.
   ezUInt32 m_uiPathStringOffset = 0;     ///< Byte offset into ezArchiveTOC::m_AllPathStrings where the path string for this entry resides.
   ezArchiveCompressionMode m_CompressionMode = ezArchiveCompressionMode::Uncompressed;
+  ezUInt32 m_uiBlockSize = 0;            ///< For Compressed_zstd_seekable: The uncompressed size of each block.
+  ezUInt32 m_uiFirstBlockIndex = 0;      ///< For Compressed_zstd_seekable: Index of the first block in ezArchiveTOC::m_BlockEndOffsets.
+
+  /// \brief Returns the number of blocks of a Compressed_zstd_seekable entry, zero for all other entries.
+  ezUInt32 GetNumBlocks() const;
 
   ezResult Serialize(ezStreamWriter& stream) const;
   ezResult Deserialize(ezStreamReader& stream);
@@ -106,12 +112,17 @@ public:
   ezHashTable<ezArchiveStoredString, ezUInt32> m_PathToEntryIndex;
   /// one large array holding all path strings for the file entries, to reduce allocations
   ezDynamicArray<ezUInt8> m_AllPathStrings;
+  /// the end of every block of all Compressed_zstd_seekable entries, relative to the start of the entry's data
+  ezDynamicArray<ezUInt64> m_BlockEndOffsets;
 
   /// \brief Returns the entry index for the given file or ezInvalidIndex, if not found.
   ezUInt32 FindEntry(const char* szFile) const;
 
   const char* GetEntryPathString(ezUInt32 uiEntryIdx) const;
 
+  /// \brief Returns the end offsets of all blocks of a Compressed_zstd_seekable entry, an empty array for all other entries.
+  ezArrayPtr<const ezUInt64> GetEntryBlockEndOffsets(ezUInt32 uiEntryIdx) const;
+
   ezResult Serialize(ezStreamWriter& stream) const;
   ezResult Deserialize(ezStreamReader& stream);
 };
@@ -8,6 +8,9 @@
 /// \brief Utility class to build an ezArchive file from files/folders on disk
 ///
 /// All functionality for writing an ezArchive file is available through ezArchiveUtils.
+///
+/// The entries are compressed in parallel using the ezTaskSystem, but written in the order of m_Entries, so the output is deterministic.
+/// Files with identical content (same xxHash64 and size) are only stored once, all their entries in the TOC reference the same data.
 class EZ_FOUNDATION_DLL ezArchiveBuilder
 {
 public:
@@ -21,6 +24,22 @@ public:
   // all the source files from disk that should be put into the ezArchive
   ezDeque<SourceEntry> m_Entries;
 
+  /// \brief If not zero, zstd compressed files that are larger than this are split into independently compressed blocks of this size.
+  ///
+  /// Such entries are stored as ezArchiveCompressionMode::Compressed_zstd_seekable, which allows to read any part of the file without
+  /// decompressing everything before it, and to decompress large files on multiple threads. Smaller blocks allow finer grained access,
+  /// but compress worse. Typical values are between 64 KB and 1 MB.
+  /// Entries that explicitly request Compressed_zstd_seekable use 256 KB blocks, if this is zero.
+  ezUInt32 m_uiZstdBlockSize = 0;
+
+  /// \brief If not zero, a zstd dictionary of at most this many bytes is trained from the files and stored in the archive header.
+  ///
+  /// Small files compress poorly on their own, because zstd has to learn their redundancy anew for every file. For archives with many
+  /// small files of the same kind (materials, prefabs, collections, ...) a dictionary with their typical content improves the compression
+  /// considerably. The dictionary is trained from the zstd compressed files of up to 128 KB and used for all Compressed_zstd entries.
+  /// It is loaded whenever the archive is opened, so around 100 KB is a good size, more rarely helps.
+  ezUInt32 m_uiZstdDictionarySize = 0;
+
   enum class InclusionMode
   {
     Exclude,       ///< Do not add this file to the archive
@@ -29,6 +48,18 @@ public:
                    ///< archive.
   };
 
+  /// \brief Information about the archive that was written by WriteArchive().
+  struct Statistics
+  {
+    ezUInt32 m_uiNumEntries = 0;
+    ezUInt32 m_uiNumDeduplicatedEntries = 0; ///< Entries whose content is identical to an earlier entry and that share its stored data.
+    ezUInt64 m_uiUncompressedBytes = 0;      ///< The size of all source files.
+    ezUInt64 m_uiStoredBytes = 0;            ///< The amount of (compressed) file data that was written to the archive.
+    ezUInt64 m_uiDeduplicatedBytes = 0;      ///< The amount of (compressed) file data that was not written, because it was shared.
+    ezUInt32 m_uiZstdDictionarySize = 0;     ///< The size of the zstd dictionary in the archive header, zero if there is none.
+    ezUInt32 m_uiNumZstdDictionarySamples = 0; ///< From how many files the zstd dictionary was trained.
+  };
+
   /// \brief Custom decider whether to include a file into the archive
   typedef ezDelegate<InclusionMode(const char*)> InclusionCallback;
 
@@ -40,14 +71,15 @@ public:
     InclusionCallback callback = InclusionCallback());
 
   /// \brief Overwrites the given file with the archive
-  ezResult WriteArchive(const char* szFile) const;
+  ezResult WriteArchive(const char* szFile, Statistics* out_pStatistics = nullptr) const;
 
   /// \brief Writes the previously gathered files to the file stream
-  ezResult WriteArchive(ezStreamWriter& stream) const;
+  ezResult WriteArchive(ezStreamWriter& stream, Statistics* out_pStatistics = nullptr) const;
 
 protected:
   /// Override this to get a callback when the next file is being written to the output
   virtual bool WriteNextFileCallback(ezUInt32 uiCurEntry, ezUInt32 uiMaxEntries, const char* szSourceFile) const;
   /// Override this to get a progress report for writing a single file to the output
+  /// \note This is called from the worker threads that compress the files, so it may be called for several files at the same time.
   virtual bool WriteFileProgressCallback(ezUInt64 bytesWritten, ezUInt64 bytesTotal) const;
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/IO/Archive/Archive.h>
+#include <Foundation/IO/CompressedStreamZstd.h>
 #include <Foundation/IO/MemoryMappedFile.h>
 #include <Foundation/Types/UniquePtr.h>
 
@@ -30,9 +31,21 @@ public:
   /// \brief Sets up \a memReader for reading the raw (potentially compressed) data that is stored for the given entry in the archive.
   void ConfigureRawMemoryStreamReader(ezUInt32 uiEntryIdx, ezRawMemoryStreamReader& memReader) const;
 
+  /// \brief Returns a pointer to the raw (potentially compressed) data of the given entry, inside the memory mapped archive.
+  ///
+  /// The entry's m_uiStoredDataSize bytes can be accessed directly, as long as the archive is open.
+  const void* GetEntryReadPointer(ezUInt32 uiEntryIdx) const;
+
   /// \brief Creates a reader that will decompress the given file entry.
   ezUniquePtr<ezStreamReader> CreateEntryReader(ezUInt32 uiEntryIdx) const;
 
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  /// \brief Returns the digested zstd dictionary that is stored in the archive header, or nullptr, if the archive has none.
+  ///
+  /// All entries that are stored as ezArchiveCompressionMode::Compressed_zstd need this dictionary for decompression.
+  const ezZstdDictionary* GetZstdDictionary() const { return m_pZstdDictionary.Borrow(); }
+#endif
+
 protected:
   /// \brief Called by ExtractAllFiles() for progress reporting. Return false to abort.
   virtual bool ExtractNextFileCallback(ezUInt32 uiCurEntry, ezUInt32 uiMaxEntries, const char* szSourceFile) const;
@@ -45,4 +58,8 @@ protected:
   ezUInt8 m_uiArchiveVersion = 0;
   const void* m_pDataStart = nullptr;
   ezUInt64 m_uiMemFileSize = 0;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  ezUniquePtr<ezZstdDictionary> m_pZstdDictionary;
+#endif
 };
@@ -10,6 +10,7 @@ class ezMemoryMappedFile;
 class ezArchiveTOC;
 class ezArchiveEntry;
 class ezRawMemoryStreamReader;
+class ezZstdDictionary;
 
 /// \brief Utilities for working with ezArchive files
 namespace ezArchiveUtils
@@ -26,10 +27,16 @@ namespace ezArchiveUtils
   EZ_FOUNDATION_DLL bool IsAcceptedArchiveFileExtensions(ezStringView extension);
 
   /// \brief Writes the header that identifies the ezArchive file and version to the stream
-  EZ_FOUNDATION_DLL ezResult WriteHeader(ezStreamWriter& stream);
+  ///
+  /// If \a zstdDictionary is not empty, it is stored as part of the header. All entries that are stored as
+  /// ezArchiveCompressionMode::Compressed_zstd must then be compressed with this dictionary.
+  EZ_FOUNDATION_DLL ezResult WriteHeader(ezStreamWriter& stream, ezArrayPtr<const ezUInt8> zstdDictionary = ezArrayPtr<const ezUInt8>());
 
   /// \brief Reads the ezArchive header. Returns success and the version, if the stream is a valid ezArchive file.
-  EZ_FOUNDATION_DLL ezResult ReadHeader(ezStreamReader& stream, ezUInt8& out_uiVersion);
+  ///
+  /// Since version 3 the header ends with the zstd dictionary. Its size is returned in \a out_uiZstdDictionarySize (zero if there is none)
+  /// and the stream is positioned at the start of the dictionary. The entry data follows directly after the dictionary.
+  EZ_FOUNDATION_DLL ezResult ReadHeader(ezStreamReader& stream, ezUInt8& out_uiVersion, ezUInt32& out_uiZstdDictionarySize);
 
   /// \brief Writes the archive TOC to the stream. This must be the last thing in the stream, if ExtractTOC() is supposed to work.
   EZ_FOUNDATION_DLL ezResult AppendTOC(ezStreamWriter& stream, const ezArchiveTOC& toc);
@@ -41,15 +48,27 @@ namespace ezArchiveUtils
   ///
   /// Appends information to the TOC for finding the data in the stream. Reads and updates inout_uiCurrentStreamPosition with the data byte
   /// offset. The progress callback is executed for every couple of KB of data that were written.
+  /// If the archive has a zstd dictionary (see WriteHeader()), it has to be passed in as \a pZstdDictionary, initialized for compression.
   EZ_FOUNDATION_DLL ezResult WriteEntry(ezStreamWriter& stream, const char* szAbsSourcePath, ezUInt32 uiPathStringOffset,
     ezArchiveCompressionMode compression, ezArchiveEntry& tocEntry, ezUInt64& inout_uiCurrentStreamPosition,
-    FileWriteProgressCallback progress = FileWriteProgressCallback());
+    FileWriteProgressCallback progress = FileWriteProgressCallback(), const ezZstdDictionary* pZstdDictionary = nullptr);
 
   /// \brief Similar to WriteEntry, but if compression is enabled, checks that compression makes enough of a difference.
   /// If compression does not reduce file size enough, the file is stored uncompressed instead.
   EZ_FOUNDATION_DLL ezResult WriteEntryOptimal(ezStreamWriter& stream, const char* szAbsSourcePath, ezUInt32 uiPathStringOffset,
     ezArchiveCompressionMode compression, ezArchiveEntry& tocEntry, ezUInt64& inout_uiCurrentStreamPosition,
-    FileWriteProgressCallback progress = FileWriteProgressCallback());
+    FileWriteProgressCallback progress = FileWriteProgressCallback(), const ezZstdDictionary* pZstdDictionary = nullptr);
+
+  /// \brief Writes a single file entry as independently compressed zstd blocks of \a uiBlockSize uncompressed bytes.
+  ///
+  /// This allows to decompress any part of the file without decompressing everything before it, and to decompress large files in parallel.
+  /// The block index is appended to \a inout_BlockEndOffsets (ezArchiveTOC::m_BlockEndOffsets), the entry references it.
+  /// Like WriteEntryOptimal(), the file is stored uncompressed, if compression does not reduce its size enough.
+  /// Files that are not larger than a single block are stored as ezArchiveCompressionMode::Compressed_zstd, using \a pZstdDictionary.
+  /// The blocks themselves do not use the dictionary, it makes no difference for that much data.
+  EZ_FOUNDATION_DLL ezResult WriteEntrySeekableOptimal(ezStreamWriter& stream, const char* szAbsSourcePath, ezUInt32 uiPathStringOffset,
+    ezUInt32 uiBlockSize, ezArchiveEntry& tocEntry, ezDynamicArray<ezUInt64>& inout_BlockEndOffsets, ezUInt64& inout_uiCurrentStreamPosition,
+    FileWriteProgressCallback progress = FileWriteProgressCallback(), const ezZstdDictionary* pZstdDictionary = nullptr);
 
   /// \brief Configures \a memReader as a view into the data stored for \a entry in the archive file.
   ///
@@ -60,7 +79,11 @@ namespace ezArchiveUtils
   /// \brief Creates a new stream reader which allows to read the uncompressed data for the given archive entry.
   ///
   /// Under the hood it may create different types of stream readers to uncompress or decode the data.
-  EZ_FOUNDATION_DLL ezUniquePtr<ezStreamReader> CreateEntryReader(const ezArchiveEntry& entry, const void* pStartOfArchiveData);
+  /// Entries that are stored as ezArchiveCompressionMode::Compressed_zstd_seekable additionally need their block index,
+  /// see ezArchiveTOC::GetEntryBlockEndOffsets(). Entries that are stored as ezArchiveCompressionMode::Compressed_zstd need the zstd
+  /// dictionary of the archive, if it has one. The dictionary must stay valid while the reader is in use.
+  EZ_FOUNDATION_DLL ezUniquePtr<ezStreamReader> CreateEntryReader(const ezArchiveEntry& entry, const void* pStartOfArchiveData,
+    ezArrayPtr<const ezUInt64> blockEndOffsets = ezArrayPtr<const ezUInt64>(), const ezZstdDictionary* pZstdDictionary = nullptr);
 
   EZ_FOUNDATION_DLL ezResult ReadZipHeader(ezStreamReader& stream, ezUInt8& out_uiVersion);
   EZ_FOUNDATION_DLL ezResult ExtractZipTOC(ezMemoryMappedFile& memFile, ezArchiveTOC& toc);
@@ -67,8 +67,12 @@ namespace ezDataDirectory
     ~ArchiveReaderUncompressed();
 
     virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) override;
+    virtual ezUInt64 Skip(ezUInt64 uiBytes) override;
     virtual ezUInt64 GetFileSize() const override;
 
+    /// \brief Returns the entry's data inside the memory mapped archive, if it is stored uncompressed.
+    virtual ezResult MapFileContent(ezArrayPtr<const ezUInt8>& out_Content) override;
+
   protected:
     virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
     virtual void InternalClose() override;
@@ -77,6 +81,7 @@ namespace ezDataDirectory
 
     ezUInt64 m_uiUncompressedSize = 0;
     ezUInt64 m_uiCompressedSize = 0;
+    const ezUInt8* m_pUncompressedData = nullptr; ///< Only set for entries that are stored uncompressed.
     ezRawMemoryStreamReader m_MemStreamReader;
   };
 
@@ -91,12 +96,20 @@ namespace ezDataDirectory
 
     virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) override;
 
+    /// \brief For seekable entries only the blocks that are read afterwards are decompressed.
+    virtual ezUInt64 Skip(ezUInt64 uiBytes) override;
+
   protected:
     virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
 
     friend class ArchiveType;
 
     ezCompressedStreamReaderZstd m_CompressedStreamReader;
+    const ezZstdDictionary* m_pZstdDictionary = nullptr; ///< The dictionary of the archive, if it has one.
+
+    /// Used instead of m_CompressedStreamReader for entries that are stored as ezArchiveCompressionMode::Compressed_zstd_seekable.
+    ezSeekableStreamReaderZstd m_SeekableStreamReader;
+    bool m_bSeekable = false;
   };
 #endif
 
@@ -110,6 +123,7 @@ namespace ezDataDirectory
     ~ArchiveReaderZip();
 
     virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) override;
+    virtual ezUInt64 Skip(ezUInt64 uiBytes) override;
 
   protected:
     virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
@@ -36,9 +36,37 @@ const char* ezArchiveTOC::GetEntryPathString(ezUInt32 uiEntryIdx) const
   return reinterpret_cast<const char*>(&m_AllPathStrings[m_Entries[uiEntryIdx].m_uiPathStringOffset]);
 }
 
+ezArrayPtr<const ezUInt64> ezArchiveTOC::GetEntryBlockEndOffsets(ezUInt32 uiEntryIdx) const
+{
+  const ezArchiveEntry& entry = m_Entries[uiEntryIdx];
+  return m_BlockEndOffsets.GetArrayPtr().GetSubArray(entry.m_uiFirstBlockIndex, entry.GetNumBlocks());
+}
+
+namespace
+{
+  /// \brief Entries of TOC versions 1 and 2, which did not store any block information yet.
+  struct ezArchiveEntryV2
+  {
+    ezArchiveEntry m_Entry;
+
+    ezResult Deserialize(ezStreamReader& stream)
+    {
+      stream >> m_Entry.m_uiDataStartOffset;
+      stream >> m_Entry.m_uiUncompressedDataSize;
+      stream >> m_Entry.m_uiStoredDataSize;
+      ezUInt8 uiCompressionMode = 0;
+      stream >> uiCompressionMode;
+      m_Entry.m_CompressionMode = (ezArchiveCompressionMode)uiCompressionMode;
+      stream >> m_Entry.m_uiPathStringOffset;
+
+      return EZ_SUCCESS;
+    }
+  };
+} // namespace
+
 ezResult ezArchiveTOC::Serialize(ezStreamWriter& stream) const
 {
-  stream.WriteVersion(2);
+  stream.WriteVersion(3);
 
   EZ_SUCCEED_OR_RETURN(stream.WriteArray(m_Entries));
 
@@ -47,14 +75,31 @@ ezResult ezArchiveTOC::Serialize(ezStreamWriter& stream) const
 
   EZ_SUCCEED_OR_RETURN(stream.WriteArray(m_AllPathStrings));
 
+  // version 3 added the block index for seekable entries
+  EZ_SUCCEED_OR_RETURN(stream.WriteArray(m_BlockEndOffsets));
+
   return EZ_SUCCESS;
 }
 
 ezResult ezArchiveTOC::Deserialize(ezStreamReader& stream)
 {
-  ezTypeVersion version = stream.ReadVersion(2);
+  ezTypeVersion version = stream.ReadVersion(3);
 
-  EZ_SUCCEED_OR_RETURN(stream.ReadArray(m_Entries));
+  if (version >= 3)
+  {
+    EZ_SUCCEED_OR_RETURN(stream.ReadArray(m_Entries));
+  }
+  else
+  {
+    ezDynamicArray<ezArchiveEntryV2> oldEntries;
+    EZ_SUCCEED_OR_RETURN(stream.ReadArray(oldEntries));
+
+    m_Entries.SetCount(oldEntries.GetCount());
+    for (ezUInt32 i = 0; i < oldEntries.GetCount(); ++i)
+    {
+      m_Entries[i] = oldEntries[i].m_Entry;
+    }
+  }
 
   if (version == 1)
   {
@@ -71,6 +116,11 @@ ezResult ezArchiveTOC::Deserialize(ezStreamReader& stream)
 
   EZ_SUCCEED_OR_RETURN(stream.ReadArray(m_AllPathStrings));
 
+  if (version >= 3)
+  {
+    EZ_SUCCEED_OR_RETURN(stream.ReadArray(m_BlockEndOffsets));
+  }
+
   if (version == 1)
   {
     // version 1 stores an older way for the path/hash -> entry lookup table, which is prone to hash collisions
@@ -116,6 +166,8 @@ ezResult ezArchiveEntry::Serialize(ezStreamWriter& stream) const
   stream << m_uiStoredDataSize;
   stream << (ezUInt8)m_CompressionMode;
   stream << m_uiPathStringOffset;
+  stream << m_uiBlockSize;
+  stream << m_uiFirstBlockIndex;
 
   return EZ_SUCCESS;
 }
@@ -129,9 +181,19 @@ ezResult ezArchiveEntry::Deserialize(ezStreamReader& stream)
   stream >> uiCompressionMode;
   m_CompressionMode = (ezArchiveCompressionMode)uiCompressionMode;
   stream >> m_uiPathStringOffset;
+  stream >> m_uiBlockSize;
+  stream >> m_uiFirstBlockIndex;
 
   return EZ_SUCCESS;
 }
 
+ezUInt32 ezArchiveEntry::GetNumBlocks() const
+{
+  if (m_CompressionMode != ezArchiveCompressionMode::Compressed_zstd_seekable || m_uiBlockSize == 0 || m_uiUncompressedDataSize == 0)
+    return 0;
+
+  return static_cast<ezUInt32>((m_uiUncompressedDataSize - 1) / m_uiBlockSize + 1);
+}
+
 
 EZ_STATICLINK_FILE(Foundation, Foundation_IO_Archive_Implementation_Archive);
@@ -1,10 +1,15 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/Algorithm/HashStream.h>
 #include <Foundation/IO/Archive/ArchiveBuilder.h>
 #include <Foundation/IO/Archive/ArchiveUtils.h>
+#include <Foundation/IO/CompressedStreamZstd.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/TaskSystem.h>
 
 void ezArchiveBuilder::AddFolder(const char* szAbsFolderPath, ezArchiveCompressionMode defaultMode /*= ezArchiveCompressionMode::Uncompressed*/,
   InclusionCallback callback /*= InclusionCallback()*/)
@@ -61,7 +66,7 @@ void ezArchiveBuilder::AddFolder(const char* szAbsFolderPath, ezArchiveCompressi
 #endif
 }
 
-ezResult ezArchiveBuilder::WriteArchive(const char* szFile) const
+ezResult ezArchiveBuilder::WriteArchive(const char* szFile, Statistics* out_pStatistics /*= nullptr*/) const
 {
   EZ_LOG_BLOCK("WriteArchive", szFile);
 
@@ -72,43 +77,417 @@ ezResult ezArchiveBuilder::WriteArchive(const char* szFile) const
     return EZ_FAILURE;
   }
 
-  return WriteArchive(file);
+  return WriteArchive(file, out_pStatistics);
 }
 
-ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& stream) const
+namespace
 {
-  EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteHeader(stream));
+  /// \brief Per entry data of ezArchiveBuilder::WriteArchive(), which is filled by the worker tasks.
+  struct ezArchiveBuilderEntryData
+  {
+    ezUInt64 m_uiContentHash = 0;
+    ezUInt64 m_uiContentSize = 0;
+    ezUInt32 m_uiSharedDataEntry = ezInvalidIndex; ///< The earlier entry with identical content, whose data is reused.
+    bool m_bFailed = false;
+
+    ezArchiveEntry m_Entry;                      ///< Data offsets are relative to m_Data, until it is written to the archive.
+    ezDynamicArray<ezUInt64> m_BlockEndOffsets; ///< For seekable entries.
+    ezDynamicArray<ezUInt8> m_Data;
+  };
+
+  /// Source files are compressed into memory in batches of this size, before they are written to the output in order.
+  static constexpr ezUInt64 s_uiMaxArchiveBuilderBatchBytes = 256 * 1024 * 1024;
+  static constexpr ezUInt32 s_uiMaxArchiveBuilderBatchEntries = 1024;
+
+  ezResult HashFileContent(const char* szAbsSourcePath, ezArchiveBuilderEntryData& inout_Data)
+  {
+    ezFileReader file;
+    EZ_SUCCEED_OR_RETURN(file.Open(szAbsSourcePath, 1024 * 256));
+
+    ezHashStreamWriter64 hash;
+    ezUInt8 uiTemp[1024 * 8];
+
+    while (true)
+    {
+      const ezUInt64 uiRead = file.ReadBytes(uiTemp, EZ_ARRAY_SIZE(uiTemp));
+
+      if (uiRead == 0)
+        break;
+
+      EZ_SUCCEED_OR_RETURN(hash.WriteBytes(uiTemp, uiRead));
+      inout_Data.m_uiContentSize += uiRead;
+    }
+
+    inout_Data.m_uiContentHash = hash.GetHashValue();
+    return EZ_SUCCESS;
+  }
+
+  /// \brief Compares the content of two files byte by byte. Used to confirm duplicates, since equal hashes do not guarantee equal content.
+  ezResult CompareFileContent(const char* szAbsSourcePathA, const char* szAbsSourcePathB, bool& out_bEqual)
+  {
+    ezFileReader fileA;
+    EZ_SUCCEED_OR_RETURN(fileA.Open(szAbsSourcePathA, 1024 * 256));
 
+    ezFileReader fileB;
+    EZ_SUCCEED_OR_RETURN(fileB.Open(szAbsSourcePathB, 1024 * 256));
+
+    ezUInt8 uiTempA[1024 * 8];
+    ezUInt8 uiTempB[1024 * 8];
+
+    while (true)
+    {
+      const ezUInt64 uiReadA = fileA.ReadBytes(uiTempA, EZ_ARRAY_SIZE(uiTempA));
+      const ezUInt64 uiReadB = fileB.ReadBytes(uiTempB, EZ_ARRAY_SIZE(uiTempB));
+
+      if (uiReadA != uiReadB || !ezMemoryUtils::IsEqual(uiTempA, uiTempB, static_cast<size_t>(uiReadA)))
+      {
+        out_bEqual = false;
+        return EZ_SUCCESS;
+      }
+
+      if (uiReadA == 0)
+      {
+        out_bEqual = true;
+        return EZ_SUCCESS;
+      }
+    }
+  }
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  /// Only files up to this size are used for training the zstd dictionary, larger files hardly benefit from it.
+  static constexpr ezUInt64 s_uiMaxZstdDictionarySampleFileSize = 128 * 1024;
+
+  /// The dictionary is trained from up to this many times its size of sample data.
+  static constexpr ezUInt64 s_uiZstdDictionarySampleFactor = 100;
+
+  ezResult TrainZstdDictionary(const ezDeque<ezArchiveBuilder::SourceEntry>& entries, const ezDynamicArray<ezArchiveBuilderEntryData>& entryData,
+    ezUInt32 uiMaxDictionarySize, ezDynamicArray<ezUInt8>& out_Dictionary, ezUInt32& out_uiNumSamples)
+  {
+    ezDynamicArray<ezUInt32> candidates;
+    ezUInt64 uiCandidateBytes = 0;
+
+    for (ezUInt32 i = 0; i < entries.GetCount(); ++i)
+    {
+      const ezArchiveBuilderEntryData& data = entryData[i];
+
+      if (data.m_uiSharedDataEntry == ezInvalidIndex && entries[i].m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd &&
+          data.m_uiContentSize > 0 && data.m_uiContentSize <= s_uiMaxZstdDictionarySampleFileSize)
+      {
+        candidates.PushBack(i);
+        uiCandidateBytes += data.m_uiContentSize;
+      }
+    }
+
+    // if there is too much sample data, every n-th file is used, which keeps the selection representative
+    const ezUInt64 uiMaxSampleBytes = static_cast<ezUInt64>(uiMaxDictionarySize) * s_uiZstdDictionarySampleFactor;
+    const ezUInt32 uiStride = static_cast<ezUInt32>(uiCandidateBytes / uiMaxSampleBytes + 1);
+
+    ezDynamicArray<ezUInt32> sampleEntries;
+    for (ezUInt32 i = 0; i < candidates.GetCount(); i += uiStride)
+    {
+      sampleEntries.PushBack(candidates[i]);
+    }
+
+    ezDynamicArray<ezDynamicArray<ezUInt8>> samples;
+    samples.SetCount(sampleEntries.GetCount());
+
+    ezAtomicInteger32 iFailed;
+
+    ezTaskSystem::ParallelForIndexed(0, sampleEntries.GetCount(), [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        const ezUInt32 uiEntry = sampleEntries[i];
+
+        ezFileReader file;
+        if (file.Open(entries[uiEntry].m_sAbsSourcePath, 1024 * 256).Failed())
+        {
+          iFailed.Set(1);
+          continue;
+        }
+
+        samples[i].SetCountUninitialized(static_cast<ezUInt32>(entryData[uiEntry].m_uiContentSize));
+        samples[i].SetCountUninitialized(static_cast<ezUInt32>(file.ReadBytes(samples[i].GetData(), samples[i].GetCount())));
+      }
+    });
+
+    if (iFailed != 0)
+      return EZ_FAILURE;
+
+    ezDynamicArray<ezArrayPtr<const ezUInt8>> samplePtrs;
+    samplePtrs.Reserve(samples.GetCount());
+
+    for (const auto& sample : samples)
+    {
+      samplePtrs.PushBack(sample.GetArrayPtr());
+    }
+
+    ezZstdDictionary::Train(samplePtrs, uiMaxDictionarySize, out_Dictionary);
+    out_uiNumSamples = samples.GetCount();
+
+    return EZ_SUCCESS;
+  }
+#endif
+} // namespace
+
+ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& stream, Statistics* out_pStatistics /*= nullptr*/) const
+{
   ezArchiveTOC toc;
+  Statistics stats;
 
   ezStringBuilder sHashablePath;
 
   ezUInt64 uiStreamSize = 0;
   const ezUInt32 uiNumEntries = m_Entries.GetCount();
 
+  toc.m_Entries.SetCount(uiNumEntries);
+
   for (ezUInt32 i = 0; i < uiNumEntries; ++i)
   {
     const SourceEntry& e = m_Entries[i];
 
-    const ezUInt32 uiPathStringOffset = toc.m_AllPathStrings.GetCount();
+    toc.m_Entries[i].m_uiPathStringOffset = toc.m_AllPathStrings.GetCount();
     toc.m_AllPathStrings.PushBackRange(
       ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(e.m_sRelTargetPath.GetData()), e.m_sRelTargetPath.GetElementCount() + 1));
 
     sHashablePath = e.m_sRelTargetPath;
     sHashablePath.ToLower();
 
-    toc.m_PathToEntryIndex[ezArchiveStoredString(ezTempHashedString::ComputeHash(sHashablePath.GetData()), uiPathStringOffset)] =
-      toc.m_Entries.GetCount();
+    toc.m_PathToEntryIndex[ezArchiveStoredString(ezTempHashedString::ComputeHash(sHashablePath.GetData()), toc.m_Entries[i].m_uiPathStringOffset)] = i;
+  }
+
+  ezDynamicArray<ezArchiveBuilderEntryData> entryData;
+  entryData.SetCount(uiNumEntries);
 
-    if (!WriteNextFileCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath))
+  // hash the content of all files, to find duplicates before compressing anything
+  ezTaskSystem::ParallelForIndexed(0, uiNumEntries, [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+    for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+    {
+      entryData[i].m_bFailed = HashFileContent(m_Entries[i].m_sAbsSourcePath, entryData[i]).Failed();
+    }
+  });
+
+  // the first entry with some content owns the data, all later ones reference it
+  {
+    // several entries with different content may end up with the same hash, so every hash maps to all of its entries
+    ezHashTable<ezUInt64, ezHybridArray<ezUInt32, 1>> contentToEntries;
+
+    for (ezUInt32 i = 0; i < uiNumEntries; ++i)
+    {
+      if (entryData[i].m_bFailed)
+      {
+        ezLog::Error("Could not read file '{}'", m_Entries[i].m_sAbsSourcePath);
+        return EZ_FAILURE;
+      }
+
+      contentToEntries[entryData[i].m_uiContentHash].PushBack(i);
+    }
+
+    ezDynamicArray<const ezHybridArray<ezUInt32, 1>*> candidates;
+
+    for (auto it = contentToEntries.GetIterator(); it.IsValid(); ++it)
+    {
+      if (it.Value().GetCount() > 1)
+      {
+        candidates.PushBack(&it.Value());
+      }
+    }
+
+    ezAtomicInteger32 iFailed;
+
+    // only share the data with an entry whose content is really identical, reading the files again is much cheaper than compressing them
+    ezTaskSystem::ParallelForIndexed(0, candidates.GetCount(), [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      for (ezUInt32 c = uiStartIndex; c < uiEndIndex; ++c)
+      {
+        const ezHybridArray<ezUInt32, 1>& sameHash = *candidates[c];
+
+        // the entries are in ascending order, so each owner is the first entry with its content
+        ezHybridArray<ezUInt32, 4> owners;
+
+        for (ezUInt32 uiEntry : sameHash)
+        {
+          ezArchiveBuilderEntryData& data = entryData[uiEntry];
+
+          for (ezUInt32 uiOwner : owners)
+          {
+            if (entryData[uiOwner].m_uiContentSize != data.m_uiContentSize)
+              continue;
+
+            bool bEqual = false;
+            if (CompareFileContent(m_Entries[uiOwner].m_sAbsSourcePath, m_Entries[uiEntry].m_sAbsSourcePath, bEqual).Failed())
+            {
+              iFailed.Set(1);
+              return;
+            }
+
+            if (bEqual)
+            {
+              data.m_uiSharedDataEntry = uiOwner;
+              break;
+            }
+          }
+
+          if (data.m_uiSharedDataEntry == ezInvalidIndex)
+          {
+            owners.PushBack(uiEntry);
+          }
+        }
+      }
+    });
+
+    if (iFailed != 0)
+    {
+      ezLog::Error("Could not read the files for comparing duplicates");
+      return EZ_FAILURE;
+    }
+  }
+
+  // the dictionary is needed for compressing the entries, but is stored in front of them
+  ezDynamicArray<ezUInt8> zstdDictionaryData;
+  const ezZstdDictionary* pZstdDictionary = nullptr;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  ezZstdDictionary zstdDictionary;
+
+  if (m_uiZstdDictionarySize > 0)
+  {
+    if (TrainZstdDictionary(m_Entries, entryData, m_uiZstdDictionarySize, zstdDictionaryData, stats.m_uiNumZstdDictionarySamples).Failed())
+    {
+      ezLog::Error("Could not read the files for training the zstd dictionary");
       return EZ_FAILURE;
+    }
+
+    if (!zstdDictionaryData.IsEmpty())
+    {
+      EZ_SUCCEED_OR_RETURN(zstdDictionary.Initialize(zstdDictionaryData, true));
+      pZstdDictionary = &zstdDictionary;
+    }
+  }
+#endif
+
+  stats.m_uiZstdDictionarySize = zstdDictionaryData.GetCount();
+
+  EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteHeader(stream, zstdDictionaryData));
+
+  // compress batches of files in parallel, then write them in order, which keeps the output deterministic
+  for (ezUInt32 uiBatchStart = 0; uiBatchStart < uiNumEntries;)
+  {
+    ezUInt32 uiBatchEnd = uiBatchStart;
+    ezUInt64 uiBatchBytes = 0;
+
+    while (uiBatchEnd < uiNumEntries && uiBatchEnd - uiBatchStart < s_uiMaxArchiveBuilderBatchEntries)
+    {
+      // shared entries do not need to be compressed again
+      const ezUInt64 uiEntryBytes = entryData[uiBatchEnd].m_uiSharedDataEntry == ezInvalidIndex ? entryData[uiBatchEnd].m_uiContentSize : 0;
+
+      if (uiBatchEnd > uiBatchStart && uiBatchBytes + uiEntryBytes > s_uiMaxArchiveBuilderBatchBytes)
+        break;
 
-    EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteEntryOptimal(stream, e.m_sAbsSourcePath, uiPathStringOffset, e.m_CompressionMode,
-      toc.m_Entries.ExpandAndGetRef(), uiStreamSize, ezMakeDelegate(&ezArchiveBuilder::WriteFileProgressCallback, this)));
+      uiBatchBytes += uiEntryBytes;
+      ++uiBatchEnd;
+    }
+
+    ezParallelForParams params;
+    params.uiMaxTasksPerThread = 4; // file sizes vary a lot
+
+    ezTaskSystem::ParallelForIndexed(
+      uiBatchStart, uiBatchEnd - uiBatchStart,
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+        for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          ezArchiveBuilderEntryData& data = entryData[i];
+
+          if (data.m_uiSharedDataEntry != ezInvalidIndex)
+            continue;
+
+          const SourceEntry& e = m_Entries[i];
+          const auto progress = ezMakeDelegate(&ezArchiveBuilder::WriteFileProgressCallback, this);
+
+          ezMemoryStreamContainerWrapperStorage<ezDynamicArray<ezUInt8>> storage(&data.m_Data);
+          ezMemoryStreamWriter writer(&storage);
+          ezUInt64 uiDataSize = 0;
+
+          const bool bSeekable = e.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_seekable ||
+                                 (e.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd && m_uiZstdBlockSize > 0);
+
+          if (bSeekable)
+          {
+            const ezUInt32 uiBlockSize = m_uiZstdBlockSize > 0 ? m_uiZstdBlockSize : 256 * 1024;
+
+            data.m_bFailed = ezArchiveUtils::WriteEntrySeekableOptimal(
+              writer, e.m_sAbsSourcePath, 0, uiBlockSize, data.m_Entry, data.m_BlockEndOffsets, uiDataSize, progress, pZstdDictionary)
+                               .Failed();
+          }
+          else
+          {
+            data.m_bFailed =
+              ezArchiveUtils::WriteEntryOptimal(writer, e.m_sAbsSourcePath, 0, e.m_CompressionMode, data.m_Entry, uiDataSize, progress, pZstdDictionary)
+                .Failed();
+          }
+        }
+      },
+      "ArchiveBuilder", params);
+
+    for (ezUInt32 i = uiBatchStart; i < uiBatchEnd; ++i)
+    {
+      ezArchiveBuilderEntryData& data = entryData[i];
+      ezArchiveEntry& tocEntry = toc.m_Entries[i];
+
+      if (!WriteNextFileCallback(i + 1, uiNumEntries, m_Entries[i].m_sAbsSourcePath))
+        return EZ_FAILURE;
+
+      if (data.m_bFailed)
+      {
+        ezLog::Error("Could not write file '{}' to the archive", m_Entries[i].m_sAbsSourcePath);
+        return EZ_FAILURE;
+      }
+
+      const ezUInt32 uiPathStringOffset = tocEntry.m_uiPathStringOffset;
+
+      if (data.m_uiSharedDataEntry != ezInvalidIndex)
+      {
+        // the owner has been written already, since it comes earlier
+        tocEntry = toc.m_Entries[data.m_uiSharedDataEntry];
+        tocEntry.m_uiPathStringOffset = uiPathStringOffset;
+
+        ++stats.m_uiNumDeduplicatedEntries;
+        stats.m_uiDeduplicatedBytes += tocEntry.m_uiStoredDataSize;
+      }
+      else
+      {
+        tocEntry = data.m_Entry;
+        tocEntry.m_uiPathStringOffset = uiPathStringOffset;
+        tocEntry.m_uiDataStartOffset = uiStreamSize;
+
+        if (!data.m_BlockEndOffsets.IsEmpty())
+        {
+          tocEntry.m_uiFirstBlockIndex = toc.m_BlockEndOffsets.GetCount();
+          toc.m_BlockEndOffsets.PushBackRange(data.m_BlockEndOffsets.GetArrayPtr());
+        }
+
+        EZ_SUCCEED_OR_RETURN(stream.WriteBytes(data.m_Data.GetData(), data.m_Data.GetCount()));
+        uiStreamSize += data.m_Data.GetCount();
+
+        stats.m_uiStoredBytes += tocEntry.m_uiStoredDataSize;
+
+        data.m_Data.Clear();
+        data.m_Data.Compact();
+      }
+
+      stats.m_uiUncompressedBytes += tocEntry.m_uiUncompressedDataSize;
+    }
+
+    uiBatchStart = uiBatchEnd;
   }
 
   EZ_SUCCEED_OR_RETURN(ezArchiveUtils::AppendTOC(stream, toc));
 
+  stats.m_uiNumEntries = uiNumEntries;
+
+  if (out_pStatistics)
+  {
+    *out_pStatistics = stats;
+  }
+
   return EZ_SUCCESS;
 }
 
@@ -27,9 +27,36 @@ ezResult ezArchiveReader::OpenArchive(const char* szPath)
 
     if (ezArchiveUtils::IsAcceptedArchiveFileExtensions(extension))
     {
-      EZ_SUCCEED_OR_RETURN(ezArchiveUtils::ReadHeader(reader, m_uiArchiveVersion));
+      ezUInt32 uiZstdDictionarySize = 0;
+      EZ_SUCCEED_OR_RETURN(ezArchiveUtils::ReadHeader(reader, m_uiArchiveVersion, uiZstdDictionarySize));
 
-      m_pDataStart = m_MemFile.GetReadPointer(16, ezMemoryMappedFile::OffsetBase::Start);
+      const ezUInt64 uiDictionaryStart = reader.GetReadPosition();
+
+      if (uiDictionaryStart + uiZstdDictionarySize > m_uiMemFileSize)
+      {
+        ezLog::Error("Archive is corrupt. Invalid zstd dictionary size.");
+        return EZ_FAILURE;
+      }
+
+      m_pDataStart = m_MemFile.GetReadPointer(uiDictionaryStart + uiZstdDictionarySize, ezMemoryMappedFile::OffsetBase::Start);
+
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+      m_pZstdDictionary.Clear();
+
+      if (uiZstdDictionarySize > 0)
+      {
+        // digest the dictionary only once, all entry readers share it
+        m_pZstdDictionary = EZ_DEFAULT_NEW(ezZstdDictionary);
+
+        const ezArrayPtr<const ezUInt8> dictionary(static_cast<const ezUInt8*>(m_MemFile.GetReadPointer(uiDictionaryStart, ezMemoryMappedFile::OffsetBase::Start)), uiZstdDictionarySize);
+
+        if (m_pZstdDictionary->Initialize(dictionary).Failed())
+        {
+          ezLog::Error("Archive is corrupt. Invalid zstd dictionary.");
+          return EZ_FAILURE;
+        }
+      }
+#  endif
 
       EZ_SUCCEED_OR_RETURN(ezArchiveUtils::ExtractTOC(m_MemFile, m_ArchiveTOC, m_uiArchiveVersion));
     }
@@ -81,6 +108,32 @@ ezResult ezArchiveReader::OpenArchive(const char* szPath)
         ezLog::Error("Archive is corrupt. Invalid entry path-string offset.");
         return EZ_FAILURE;
       }
+
+      if (e.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_seekable)
+      {
+        const ezUInt32 uiNumBlocks = e.GetNumBlocks();
+
+        if ((uiNumBlocks == 0 && e.m_uiUncompressedDataSize > 0) || static_cast<ezUInt64>(e.m_uiFirstBlockIndex) + uiNumBlocks > m_ArchiveTOC.m_BlockEndOffsets.GetCount())
+        {
+          ezLog::Error("Archive is corrupt. Invalid entry block index.");
+          return EZ_FAILURE;
+        }
+
+        // the blocks must be in order and must not exceed the stored data
+        ezUInt64 uiPrevBlockEnd = 0;
+        for (ezUInt32 b = 0; b < uiNumBlocks; ++b)
+        {
+          const ezUInt64 uiBlockEnd = m_ArchiveTOC.m_BlockEndOffsets[e.m_uiFirstBlockIndex + b];
+
+          if (uiBlockEnd <= uiPrevBlockEnd || uiBlockEnd > e.m_uiStoredDataSize)
+          {
+            ezLog::Error("Archive is corrupt. Invalid entry block offsets.");
+            return EZ_FAILURE;
+          }
+
+          uiPrevBlockEnd = uiBlockEnd;
+        }
+      }
     }
   }
 
@@ -120,9 +173,18 @@ void ezArchiveReader::ConfigureRawMemoryStreamReader(ezUInt32 uiEntryIdx, ezRawM
   ezArchiveUtils::ConfigureRawMemoryStreamReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart, memReader);
 }
 
+const void* ezArchiveReader::GetEntryReadPointer(ezUInt32 uiEntryIdx) const
+{
+  return ezMemoryUtils::AddByteOffset(m_pDataStart, m_ArchiveTOC.m_Entries[uiEntryIdx].m_uiDataStartOffset);
+}
+
 ezUniquePtr<ezStreamReader> ezArchiveReader::CreateEntryReader(ezUInt32 uiEntryIdx) const
 {
-  return ezArchiveUtils::CreateEntryReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart);
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  return ezArchiveUtils::CreateEntryReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart, m_ArchiveTOC.GetEntryBlockEndOffsets(uiEntryIdx), GetZstdDictionary());
+#else
+  return ezArchiveUtils::CreateEntryReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart, m_ArchiveTOC.GetEntryBlockEndOffsets(uiEntryIdx));
+#endif
 }
 
 ezResult ezArchiveReader::ExtractFile(ezUInt32 uiEntryIdx, const char* szTargetFolder) const
@@ -32,22 +32,30 @@ bool ezArchiveUtils::IsAcceptedArchiveFileExtensions(ezStringView extension)
   return false;
 }
 
-ezResult ezArchiveUtils::WriteHeader(ezStreamWriter& stream)
+ezResult ezArchiveUtils::WriteHeader(ezStreamWriter& stream, ezArrayPtr<const ezUInt8> zstdDictionary /*= ezArrayPtr<const ezUInt8>()*/)
 {
   const char* szTag = "EZARCHIVE";
   EZ_SUCCEED_OR_RETURN(stream.WriteBytes(szTag, 10));
 
-  const ezUInt8 uiArchiveVersion = 2;
+  const ezUInt8 uiArchiveVersion = 3;
   // Version 2: Added end-of-file marker for file corruption (cutoff) detection
+  // Version 3: Added the zstd dictionary
   stream << uiArchiveVersion;
 
   const ezUInt8 uiPadding[5] = {0, 0, 0, 0, 0};
   EZ_SUCCEED_OR_RETURN(stream.WriteBytes(uiPadding, 5));
 
+  stream << zstdDictionary.GetCount();
+
+  if (!zstdDictionary.IsEmpty())
+  {
+    EZ_SUCCEED_OR_RETURN(stream.WriteBytes(zstdDictionary.GetPtr(), zstdDictionary.GetCount()));
+  }
+
   return EZ_SUCCESS;
 }
 
-ezResult ezArchiveUtils::ReadHeader(ezStreamReader& stream, ezUInt8& out_uiVersion)
+ezResult ezArchiveUtils::ReadHeader(ezStreamReader& stream, ezUInt8& out_uiVersion, ezUInt32& out_uiZstdDictionarySize)
 {
   char szTag[10];
   if (stream.ReadBytes(szTag, 10) != 10 || !ezStringUtils::IsEqual(szTag, "EZARCHIVE"))
@@ -59,7 +67,7 @@ ezResult ezArchiveUtils::ReadHeader(ezStreamReader& stream, ezUInt8& out_uiVersi
   out_uiVersion = 0;
   stream >> out_uiVersion;
 
-  if (out_uiVersion != 1 && out_uiVersion != 2)
+  if (out_uiVersion < 1 || out_uiVersion > 3)
   {
     ezLog::Error("Unsupported archive version '{}'.", out_uiVersion);
     return EZ_FAILURE;
@@ -80,12 +88,23 @@ ezResult ezArchiveUtils::ReadHeader(ezStreamReader& stream, ezUInt8& out_uiVersi
     return EZ_FAILURE;
   }
 
+  out_uiZstdDictionarySize = 0;
+
+  if (out_uiVersion >= 3)
+  {
+    if (stream.ReadBytes(&out_uiZstdDictionarySize, sizeof(ezUInt32)) != sizeof(ezUInt32))
+    {
+      ezLog::Error("Invalid or corrupted archive. Missing header data.");
+      return EZ_FAILURE;
+    }
+  }
+
   return EZ_SUCCESS;
 }
 
 ezResult ezArchiveUtils::WriteEntry(ezStreamWriter& stream, const char* szAbsSourcePath, ezUInt32 uiPathStringOffset,
   ezArchiveCompressionMode compression, ezArchiveEntry& tocEntry, ezUInt64& inout_uiCurrentStreamPosition,
-  FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/)
+  FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/, const ezZstdDictionary* pZstdDictionary /*= nullptr*/)
 {
   ezFileReader file;
   EZ_SUCCEED_OR_RETURN(file.Open(szAbsSourcePath, 1024 * 1024));
@@ -111,7 +130,7 @@ ezResult ezArchiveUtils::WriteEntry(ezStreamWriter& stream, const char* szAbsSou
 
     case ezArchiveCompressionMode::Compressed_zstd:
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
-      zstdWriter.SetOutputStream(&stream);
+      zstdWriter.SetOutputStream(&stream, ezCompressedStreamWriterZstd::Compression::Default, 4, pZstdDictionary);
       pWriter = &zstdWriter;
 #else
       compression = ezArchiveCompressionMode::Uncompressed;
@@ -166,7 +185,7 @@ ezResult ezArchiveUtils::WriteEntry(ezStreamWriter& stream, const char* szAbsSou
 
 ezResult ezArchiveUtils::WriteEntryOptimal(ezStreamWriter& stream, const char* szAbsSourcePath, ezUInt32 uiPathStringOffset,
   ezArchiveCompressionMode compression, ezArchiveEntry& tocEntry, ezUInt64& inout_uiCurrentStreamPosition,
-  FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/)
+  FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/, const ezZstdDictionary* pZstdDictionary /*= nullptr*/)
 {
   if (compression == ezArchiveCompressionMode::Uncompressed)
   {
@@ -179,7 +198,7 @@ ezResult ezArchiveUtils::WriteEntryOptimal(ezStreamWriter& stream, const char* s
     ezMemoryStreamWriter writer(&storage);
 
     ezUInt64 streamPos = inout_uiCurrentStreamPosition;
-    EZ_SUCCEED_OR_RETURN(WriteEntry(writer, szAbsSourcePath, uiPathStringOffset, compression, tocEntry, streamPos, progress));
+    EZ_SUCCEED_OR_RETURN(WriteEntry(writer, szAbsSourcePath, uiPathStringOffset, compression, tocEntry, streamPos, progress, pZstdDictionary));
 
     if (tocEntry.m_uiStoredDataSize * 12 >= tocEntry.m_uiUncompressedDataSize * 10)
     {
@@ -197,6 +216,80 @@ ezResult ezArchiveUtils::WriteEntryOptimal(ezStreamWriter& stream, const char* s
   }
 }
 
+ezResult ezArchiveUtils::WriteEntrySeekableOptimal(ezStreamWriter& stream, const char* szAbsSourcePath, ezUInt32 uiPathStringOffset,
+  ezUInt32 uiBlockSize, ezArchiveEntry& tocEntry, ezDynamicArray<ezUInt64>& inout_BlockEndOffsets, ezUInt64& inout_uiCurrentStreamPosition,
+  FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/, const ezZstdDictionary* pZstdDictionary /*= nullptr*/)
+{
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  EZ_ASSERT_DEV(uiBlockSize > 0, "The block size must not be zero.");
+
+  ezFileReader file;
+  EZ_SUCCEED_OR_RETURN(file.Open(szAbsSourcePath, 1024 * 1024));
+
+  const ezUInt64 uiMaxBytes = file.GetFileSize();
+
+  if (uiMaxBytes <= uiBlockSize)
+  {
+    // a single block does not allow any random access or parallel decompression, so the additional index would be a waste
+    file.Close();
+    return WriteEntryOptimal(stream, szAbsSourcePath, uiPathStringOffset, ezArchiveCompressionMode::Compressed_zstd, tocEntry,
+      inout_uiCurrentStreamPosition, progress, pZstdDictionary);
+  }
+
+  ezMemoryStreamStorage storage;
+  ezMemoryStreamWriter writer(&storage);
+
+  ezSeekableStreamWriterZstd zstdWriter;
+  zstdWriter.SetOutputStream(&writer, uiBlockSize);
+
+  ezUInt8 uiTemp[1024 * 8];
+
+  while (true)
+  {
+    const ezUInt64 uiRead = file.ReadBytes(uiTemp, EZ_ARRAY_SIZE(uiTemp));
+
+    if (uiRead == 0)
+      break;
+
+    EZ_SUCCEED_OR_RETURN(zstdWriter.WriteBytes(uiTemp, uiRead));
+
+    if (progress.IsValid())
+    {
+      if (!progress(zstdWriter.GetUncompressedSize(), uiMaxBytes))
+        return EZ_FAILURE;
+    }
+  }
+
+  EZ_SUCCEED_OR_RETURN(zstdWriter.FinishCompressedStream());
+
+  if (zstdWriter.GetWrittenBytes() * 12 >= zstdWriter.GetUncompressedSize() * 10)
+  {
+    // less than 20% size saving -> go uncompressed
+    file.Close();
+    return WriteEntry(
+      stream, szAbsSourcePath, uiPathStringOffset, ezArchiveCompressionMode::Uncompressed, tocEntry, inout_uiCurrentStreamPosition, progress);
+  }
+
+  tocEntry.m_uiPathStringOffset = uiPathStringOffset;
+  tocEntry.m_uiDataStartOffset = inout_uiCurrentStreamPosition;
+  tocEntry.m_uiUncompressedDataSize = zstdWriter.GetUncompressedSize();
+  tocEntry.m_uiStoredDataSize = zstdWriter.GetWrittenBytes();
+  tocEntry.m_CompressionMode = ezArchiveCompressionMode::Compressed_zstd_seekable;
+  tocEntry.m_uiBlockSize = uiBlockSize;
+  tocEntry.m_uiFirstBlockIndex = inout_BlockEndOffsets.GetCount();
+
+  inout_BlockEndOffsets.PushBackRange(zstdWriter.GetBlockEndOffsets().GetArrayPtr());
+
+  EZ_SUCCEED_OR_RETURN(stream.WriteBytes(storage.GetData(), storage.GetStorageSize()));
+  inout_uiCurrentStreamPosition += tocEntry.m_uiStoredDataSize;
+
+  return EZ_SUCCESS;
+#else
+  return WriteEntryOptimal(
+    stream, szAbsSourcePath, uiPathStringOffset, ezArchiveCompressionMode::Uncompressed, tocEntry, inout_uiCurrentStreamPosition, progress);
+#endif
+}
+
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
 
 class ezCompressedStreamReaderZstdWithSource : public ezCompressedStreamReaderZstd
@@ -217,7 +310,8 @@ public:
 
 #endif
 
-ezUniquePtr<ezStreamReader> ezArchiveUtils::CreateEntryReader(const ezArchiveEntry& entry, const void* pStartOfArchiveData)
+ezUniquePtr<ezStreamReader> ezArchiveUtils::CreateEntryReader(const ezArchiveEntry& entry, const void* pStartOfArchiveData,
+  ezArrayPtr<const ezUInt64> blockEndOffsets /*= ezArrayPtr<const ezUInt64>()*/, const ezZstdDictionary* pZstdDictionary /*= nullptr*/)
 {
   ezUniquePtr<ezStreamReader> reader;
 
@@ -237,7 +331,18 @@ ezUniquePtr<ezStreamReader> ezArchiveUtils::CreateEntryReader(const ezArchiveEnt
       reader = EZ_DEFAULT_NEW(ezCompressedStreamReaderZstdWithSource);
       ezCompressedStreamReaderZstdWithSource* pRawReader = static_cast<ezCompressedStreamReaderZstdWithSource*>(reader.Borrow());
       ConfigureRawMemoryStreamReader(entry, pStartOfArchiveData, pRawReader->m_Source);
-      pRawReader->SetInputStream(&pRawReader->m_Source);
+      pRawReader->SetInputStream(&pRawReader->m_Source, pZstdDictionary);
+      break;
+    }
+
+    case ezArchiveCompressionMode::Compressed_zstd_seekable:
+    {
+      EZ_ASSERT_DEV(blockEndOffsets.GetCount() == entry.GetNumBlocks(), "The block index of the seekable archive entry is missing.");
+
+      reader = EZ_DEFAULT_NEW(ezSeekableStreamReaderZstd);
+      ezSeekableStreamReaderZstd* pSeekableReader = static_cast<ezSeekableStreamReaderZstd*>(reader.Borrow());
+      pSeekableReader->SetInputData(
+        ezMemoryUtils::AddByteOffset(pStartOfArchiveData, entry.m_uiDataStartOffset), blockEndOffsets, entry.m_uiBlockSize, entry.m_uiUncompressedDataSize);
       break;
     }
 #endif
@@ -75,6 +75,7 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
       case ezArchiveCompressionMode::Compressed_zstd:
+      case ezArchiveCompressionMode::Compressed_zstd_seekable:
       {
         if (!m_FreeReadersZstd.IsEmpty())
         {
@@ -114,9 +115,30 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(
 
   pReader->m_uiUncompressedSize = pEntry->m_uiUncompressedDataSize;
   pReader->m_uiCompressedSize = pEntry->m_uiStoredDataSize;
+  pReader->m_pUncompressedData = nullptr;
+
+  if (pEntry->m_CompressionMode == ezArchiveCompressionMode::Uncompressed)
+  {
+    pReader->m_pUncompressedData = static_cast<const ezUInt8*>(m_ArchiveReader.GetEntryReadPointer(uiEntryIndex));
+  }
 
   m_ArchiveReader.ConfigureRawMemoryStreamReader(uiEntryIndex, pReader->m_MemStreamReader);
 
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  if (pReader->GetDataDirUserData() == 1)
+  {
+    ArchiveReaderZstd* pZstdReader = static_cast<ArchiveReaderZstd*>(pReader);
+    pZstdReader->m_bSeekable = pEntry->m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_seekable;
+    pZstdReader->m_pZstdDictionary = m_ArchiveReader.GetZstdDictionary();
+
+    if (pZstdReader->m_bSeekable)
+    {
+      pZstdReader->m_SeekableStreamReader.SetInputData(m_ArchiveReader.GetEntryReadPointer(uiEntryIndex), toc.GetEntryBlockEndOffsets(uiEntryIndex),
+        pEntry->m_uiBlockSize, pEntry->m_uiUncompressedDataSize);
+    }
+  }
+#endif
+
   if (pReader->Open(sArchivePath, this, FileShareMode).Failed())
   {
     EZ_DEFAULT_DELETE(pReader);
@@ -268,11 +290,26 @@ ezUInt64 ezDataDirectory::ArchiveReaderUncompressed::Read(void* pBuffer, ezUInt6
   return m_MemStreamReader.ReadBytes(pBuffer, uiBytes);
 }
 
+ezUInt64 ezDataDirectory::ArchiveReaderUncompressed::Skip(ezUInt64 uiBytes)
+{
+  return m_MemStreamReader.SkipBytes(uiBytes);
+}
+
 ezUInt64 ezDataDirectory::ArchiveReaderUncompressed::GetFileSize() const
 {
   return m_uiUncompressedSize;
 }
 
+ezResult ezDataDirectory::ArchiveReaderUncompressed::MapFileContent(ezArrayPtr<const ezUInt8>& out_Content)
+{
+  // the archive is memory mapped anyway, so uncompressed entries can be accessed directly
+  if (m_pUncompressedData == nullptr || m_uiUncompressedSize >= 0xFFFFFFFFu)
+    return EZ_FAILURE;
+
+  out_Content = ezArrayPtr<const ezUInt8>(m_pUncompressedData, static_cast<ezUInt32>(m_uiUncompressedSize));
+  return EZ_SUCCESS;
+}
+
 ezResult ezDataDirectory::ArchiveReaderUncompressed::InternalOpen(ezFileShareMode::Enum FileShareMode)
 {
   EZ_ASSERT_DEBUG(
@@ -300,15 +337,31 @@ ezDataDirectory::ArchiveReaderZstd::~ArchiveReaderZstd() = default;
 
 ezUInt64 ezDataDirectory::ArchiveReaderZstd::Read(void* pBuffer, ezUInt64 uiBytes)
 {
+  if (m_bSeekable)
+    return m_SeekableStreamReader.ReadBytes(pBuffer, uiBytes);
+
   return m_CompressedStreamReader.ReadBytes(pBuffer, uiBytes);
 }
 
+ezUInt64 ezDataDirectory::ArchiveReaderZstd::Skip(ezUInt64 uiBytes)
+{
+  if (m_bSeekable)
+    return m_SeekableStreamReader.SkipBytes(uiBytes);
+
+  return m_CompressedStreamReader.SkipBytes(uiBytes);
+}
+
 ezResult ezDataDirectory::ArchiveReaderZstd::InternalOpen(ezFileShareMode::Enum FileShareMode)
 {
   EZ_ASSERT_DEBUG(
     FileShareMode != ezFileShareMode::Exclusive, "Archives only support shared reading of files. Exclusive access cannot be guaranteed.");
 
-  m_CompressedStreamReader.SetInputStream(&m_MemStreamReader);
+  // seekable entries are configured by ArchiveType::OpenFileToRead(), because they need the block index from the TOC
+  if (!m_bSeekable)
+  {
+    m_CompressedStreamReader.SetInputStream(&m_MemStreamReader, m_pZstdDictionary);
+  }
+
   return EZ_SUCCESS;
 }
 
@@ -330,6 +383,11 @@ ezUInt64 ezDataDirectory::ArchiveReaderZip::Read(void* pBuffer, ezUInt64 uiBytes
   return m_CompressedStreamReader.ReadBytes(pBuffer, uiBytes);
 }
 
+ezUInt64 ezDataDirectory::ArchiveReaderZip::Skip(ezUInt64 uiBytes)
+{
+  return m_CompressedStreamReader.SkipBytes(uiBytes);
+}
+
 ezResult ezDataDirectory::ArchiveReaderZip::InternalOpen(ezFileShareMode::Enum FileShareMode)
 {
   EZ_ASSERT_DEBUG(
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Types/UniquePtr.h>
+
+class ezOSFile;
+struct ezAsyncFileReaderImpl;
+
+/// \brief Reads from many files at the same time, without blocking the calling thread for every single read.
+///
+/// Reads are submitted with SubmitRead() and their results are collected with PollCompletions() or WaitForCompletions().
+/// Having many reads in flight at once allows the OS and the storage device to reorder and parallelize them, which is
+/// much faster than reading one file after the other, especially for many small files that are not in the page cache yet.
+///
+/// On Linux the reads are handed to the kernel through io_uring. Where io_uring is not available (other platforms,
+/// old kernels or when it is blocked), the reads are executed with ezOSFile::ReadAt() by long running tasks of the ezTaskSystem.
+///
+/// The files and the target buffers must stay valid until the completion of the read has been returned.
+/// An ezAsyncFileReader itself is not thread-safe, it should only be used by one thread at a time.
+class EZ_FOUNDATION_DLL ezAsyncFileReader
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezAsyncFileReader);
+
+public:
+  /// \brief The result of one read that was submitted with SubmitRead().
+  struct Completion
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt64 m_uiUserData = 0;       ///< The value that was passed to SubmitRead().
+    ezUInt64 m_uiBytesRequested = 0; ///< The number of bytes that was passed to SubmitRead().
+    ezUInt64 m_uiBytesRead = 0;      ///< Less than requested, if the end of the file was reached or an error occurred.
+    ezResult m_Result = EZ_SUCCESS;  ///< EZ_FAILURE if the OS reported an error.
+  };
+
+  /// \brief Creates the reader.
+  ///
+  /// \param uiMaxReadsInFlight How many reads may be executed by the OS at the same time. Additional reads are queued.
+  /// \param bAllowIoUring If false, the ezTaskSystem fallback is used even where io_uring is available.
+  ezAsyncFileReader(ezUInt32 uiMaxReadsInFlight = 64, bool bAllowIoUring = true);
+
+  /// \brief Waits for all reads that are still in flight, their completions are discarded.
+  ~ezAsyncFileReader();
+
+  /// \brief Submits a read of \a uiBytes from \a file at \a uiFileOffset into \a pBuffer.
+  ///
+  /// \a uiUserData is passed through to the Completion, to identify the read.
+  /// Reads may be handed to the OS in batches, at the latest when PollCompletions() or WaitForCompletions() is called.
+  void SubmitRead(const ezOSFile& file, ezUInt64 uiFileOffset, void* pBuffer, ezUInt64 uiBytes, ezUInt64 uiUserData);
+
+  /// \brief Appends the completions of all reads that finished since the last call. Never blocks. Returns the number of appended completions.
+  ezUInt32 PollCompletions(ezDynamicArray<Completion>& out_Completions);
+
+  /// \brief Same as PollCompletions(), but blocks until at least one read has finished, unless no read is pending at all.
+  ezUInt32 WaitForCompletions(ezDynamicArray<Completion>& out_Completions);
+
+  /// \brief Returns the number of reads that have been submitted, but whose completion has not been returned yet.
+  ezUInt32 GetNumPendingReads() const;
+
+  /// \brief Returns how many bytes the pending reads requested in total. Allows callers to limit the memory of the buffers in flight.
+  ezUInt64 GetNumPendingBytes() const;
+
+  /// \brief Returns true if the reads are executed through io_uring, false if the ezTaskSystem fallback is used.
+  bool IsUsingIoUring() const;
+
+private:
+  ezUniquePtr<ezAsyncFileReaderImpl> m_pImpl;
+};
@@ -7,6 +7,8 @@
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
 
+class ezZstdDictionary;
+
 /// \brief A stream reader that will decompress data that was stored using the ezCompressedStreamWriterZstd.
 ///
 /// The reader takes another reader as its source for the compressed data (e.g. a file or a memory stream).
@@ -24,7 +26,9 @@ public:
   ///
   /// Calling this a second time on the same instance is valid and allows to reuse the decoder, which is more efficient than creating a new
   /// one.
-  void SetInputStream(ezStreamReader* pInputStream); // [tested]
+  /// If the data was compressed with an ezZstdDictionary, the same dictionary has to be passed in here. It must stay valid while the reader
+  /// is in use.
+  void SetInputStream(ezStreamReader* pInputStream, const ezZstdDictionary* pDictionary = nullptr); // [tested]
 
   /// \brief Reads either uiBytesToRead or the amount of remaining bytes in the stream into pReadBuffer.
   ///
@@ -92,7 +96,11 @@ public:
   /// another stream. This can prevent internal allocations, if one wants to use compression on multiple streams consecutively. It also
   /// allows to create a compressor stream early, but decide at a later pointer whether or with which stream to use it, and it will only
   /// allocate internal structures once that final decision is made.
-  void SetOutputStream(ezStreamWriter* pOutputStream, Compression Ratio = Compression::Default, ezUInt32 uiCompressionCacheSizeKB = 4); // [tested]
+  ///
+  /// If \a pDictionary is given, the data is compressed with it and can only be decompressed with the same dictionary. In this case the
+  /// compression level of the dictionary is used, instead of \a Ratio. The dictionary must stay valid until the stream is finished.
+  void SetOutputStream(ezStreamWriter* pOutputStream, Compression Ratio = Compression::Default, ezUInt32 uiCompressionCacheSizeKB = 4,
+    const ezZstdDictionary* pDictionary = nullptr); // [tested]
 
   /// \brief Compresses \a uiBytesToWrite from \a pWriteBuffer.
   ///
@@ -154,4 +162,173 @@ private:
   ezDynamicArray<ezUInt8> m_CompressedCache;
 };
 
+/// \brief A stream writer that compresses the incoming data in blocks of a fixed size, which can later be decompressed independently of
+/// each other.
+///
+/// Every block of \a uiBlockSize uncompressed bytes (only the last one may be smaller) is compressed as a separate zstd frame and
+/// the frames are written to the output stream back to back, without any additional bookkeeping data.
+/// GetBlockEndOffsets() returns where each block ends in the output. This index has to be stored separately (e.g. in the TOC of an
+/// ezArchive) and passed to ezSeekableStreamReaderZstd, which can then decompress any byte range without decompressing everything before
+/// it, and decompress many blocks in parallel.
+///
+/// Smaller blocks allow for finer grained random access, but reduce the compression ratio, since every block starts with an empty
+/// compression history.
+class EZ_FOUNDATION_DLL ezSeekableStreamWriterZstd : public ezStreamWriter
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezSeekableStreamWriterZstd);
+
+public:
+  ezSeekableStreamWriterZstd();
+
+  /// \brief Calls FinishCompressedStream() internally.
+  ~ezSeekableStreamWriterZstd();
+
+  /// \brief Configures to which stream the compressed blocks are written, the uncompressed size of each block and the compression level.
+  ///
+  /// Finishes any previous stream first, so one writer can be reused for many streams.
+  void SetOutputStream(ezStreamWriter* pOutputStream, ezUInt32 uiBlockSize, ezCompressedStreamWriterZstd::Compression Ratio = ezCompressedStreamWriterZstd::Compression::Default);
+
+  /// \brief Caches the data and writes out a compressed block whenever a full block is available.
+  virtual ezResult WriteBytes(const void* pWriteBuffer, ezUInt64 uiBytesToWrite) override;
+
+  /// \brief Compresses and writes the last (partial) block. Afterwards no more data can be written to the stream.
+  ezResult FinishCompressedStream();
+
+  /// \brief Returns the uncompressed size of each block.
+  ezUInt32 GetBlockSize() const { return m_uiBlockSize; }
+
+  /// \brief Returns the size of the data in its uncompressed state.
+  ezUInt64 GetUncompressedSize() const { return m_uiUncompressedSize; }
+
+  /// \brief Returns the number of bytes written to the output stream so far.
+  ezUInt64 GetWrittenBytes() const { return m_uiWrittenBytes; }
+
+  /// \brief Returns the end of every block in the output, relative to the start of the stream. Only complete after FinishCompressedStream().
+  const ezDynamicArray<ezUInt64>& GetBlockEndOffsets() const { return m_BlockEndOffsets; }
+
+private:
+  ezResult CompressBlock();
+
+  ezStreamWriter* m_pOutputStream = nullptr;
+  ezCompressedStreamWriterZstd::Compression m_Ratio = ezCompressedStreamWriterZstd::Compression::Default;
+  ezUInt32 m_uiBlockSize = 0;
+  ezUInt64 m_uiUncompressedSize = 0;
+  ezUInt64 m_uiWrittenBytes = 0;
+
+  ezDynamicArray<ezUInt8> m_UncompressedBlock;
+  ezDynamicArray<ezUInt8> m_CompressedBlock;
+  ezDynamicArray<ezUInt64> m_BlockEndOffsets;
+  /*ZSTD_CCtx*/ void* m_pZstdCCtx = nullptr;
+};
+
+/// \brief A stream reader that decompresses data that was written with ezSeekableStreamWriterZstd and supports random access.
+///
+/// The reader works directly on the compressed data in memory (typically a memory mapped ezArchive) and needs the block index
+/// that ezSeekableStreamWriterZstd::GetBlockEndOffsets() returned.
+/// Skipping or changing the read position does not decompress anything, reading only decompresses the blocks that overlap with the
+/// requested range. Reads that cover several complete blocks decompress them directly into the target buffer, in parallel using the
+/// ezTaskSystem.
+class EZ_FOUNDATION_DLL ezSeekableStreamReaderZstd : public ezStreamReader
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezSeekableStreamReaderZstd);
+
+public:
+  ezSeekableStreamReaderZstd();
+  ~ezSeekableStreamReaderZstd();
+
+  /// \brief Configures the reader to decompress the given data and resets the read position.
+  ///
+  /// \a pCompressedData points to the start of the first block, \a blockEndOffsets holds the end of every block relative to it.
+  /// Both must stay valid while the reader is in use.
+  void SetInputData(const void* pCompressedData, ezArrayPtr<const ezUInt64> blockEndOffsets, ezUInt32 uiBlockSize, ezUInt64 uiUncompressedSize);
+
+  /// \brief Reads either uiBytesToRead or the amount of remaining bytes in the stream into pReadBuffer.
+  ///
+  /// Passing nullptr for pReadBuffer skips the bytes, without decompressing anything.
+  virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override;
+
+  /// \brief Moves the read position forward, without decompressing anything.
+  virtual ezUInt64 SkipBytes(ezUInt64 uiBytesToSkip) override;
+
+  /// \brief Moves the read position to the given (uncompressed) offset. Positions behind the end are clamped to the end.
+  void SetReadPosition(ezUInt64 uiPosition);
+
+  /// \brief Returns the current (uncompressed) read position.
+  ezUInt64 GetReadPosition() const { return m_uiReadPosition; }
+
+  /// \brief Returns the size of the data in its uncompressed state.
+  ezUInt64 GetUncompressedSize() const { return m_uiUncompressedSize; }
+
+  /// \brief Reads that cover at least this many complete blocks are decompressed in parallel by the ezTaskSystem. 0 disables that.
+  ///
+  /// The default is 4.
+  void SetMinBlocksForParallelDecompression(ezUInt32 uiMinBlocks) { m_uiMinBlocksForParallelDecompression = uiMinBlocks; }
+
+private:
+  ezResult DecompressBlock(void* pZstdDCtx, ezUInt32 uiBlock, void* pTarget) const;
+  ezResult DecompressBlocks(ezUInt32 uiFirstBlock, ezUInt32 uiNumBlocks, ezUInt8* pTarget);
+
+  const ezUInt8* m_pCompressedData = nullptr;
+  ezArrayPtr<const ezUInt64> m_BlockEndOffsets;
+  ezUInt32 m_uiBlockSize = 0;
+  ezUInt64 m_uiUncompressedSize = 0;
+  ezUInt64 m_uiReadPosition = 0;
+  ezUInt32 m_uiMinBlocksForParallelDecompression = 4;
+
+  ezUInt32 m_uiCachedBlock = ezInvalidIndex;
+  ezDynamicArray<ezUInt8> m_BlockCache;
+  /*ZSTD_DCtx*/ void* m_pZstdDCtx = nullptr;
+};
+
+/// \brief A zstd dictionary, which improves the compression of many small pieces of similar data, e.g. the files in an ezArchive.
+///
+/// Small files compress poorly on their own, because zstd has to learn their redundancy anew for every single file. A dictionary holds
+/// typical content, which the compressor can reference from the very first byte. The exact same dictionary is needed for decompression,
+/// so it has to be stored together with the compressed data.
+///
+/// Train() builds a dictionary from samples of the data. Initialize() digests a dictionary once, afterwards it can be used by any number
+/// of ezCompressedStreamWriterZstd and ezCompressedStreamReaderZstd instances at the same time, also on different threads.
+class EZ_FOUNDATION_DLL ezZstdDictionary
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezZstdDictionary);
+
+public:
+  ezZstdDictionary();
+  ~ezZstdDictionary();
+
+  /// \brief Builds a dictionary of at most \a uiMaxDictionarySize bytes from typical samples of the data that is going to be compressed.
+  ///
+  /// The dictionary is assembled from those pieces of the samples that have the most content in common with other samples, the most
+  /// valuable pieces are placed at the end, where they are the cheapest to reference. Each sample should be one complete piece of data,
+  /// e.g. one small file. The result is a raw content dictionary, it is empty if the samples have too little in common.
+  static void Train(ezArrayPtr<const ezArrayPtr<const ezUInt8>> samples, ezUInt32 uiMaxDictionarySize, ezDynamicArray<ezUInt8>& out_Dictionary);
+
+  /// \brief Digests the dictionary for decompression and, if \a bForCompression is set, for compression with the given level.
+  ///
+  /// Accepts dictionaries created by Train() as well as dictionaries in the zstd format (e.g. created with 'zstd --train').
+  /// The data is copied, it does not need to stay valid afterwards.
+  ezResult Initialize(ezArrayPtr<const ezUInt8> dictionary, bool bForCompression = false,
+    ezCompressedStreamWriterZstd::Compression Ratio = ezCompressedStreamWriterZstd::Compression::Default);
+
+  /// \brief Frees the digested dictionary.
+  void Clear();
+
+  /// \brief Returns whether Initialize() was successful.
+  bool IsInitialized() const { return m_pZstdDDict != nullptr; }
+
+  /// \brief Returns whether the dictionary was digested for compression as well.
+  bool CanCompress() const { return m_pZstdCDict != nullptr; }
+
+  /// \brief Returns the size of the dictionary that was passed to Initialize().
+  ezUInt32 GetDictionarySize() const { return m_uiDictionarySize; }
+
+private:
+  friend class ezCompressedStreamReaderZstd;
+  friend class ezCompressedStreamWriterZstd;
+
+  ezUInt32 m_uiDictionarySize = 0;
+  /*ZSTD_CDict*/ void* m_pZstdCDict = nullptr;
+  /*ZSTD_DDict*/ void* m_pZstdDDict = nullptr;
+};
+
 #endif // BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
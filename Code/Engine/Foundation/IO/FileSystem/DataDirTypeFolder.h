@@ -4,6 +4,7 @@
 #include <Foundation/Containers/Map.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/Implementation/DataDirType.h>
+#include <Foundation/IO/MemoryMappedFile.h>
 #include <Foundation/IO/OSFile.h>
 
 namespace ezDataDirectory
@@ -84,7 +85,12 @@ namespace ezDataDirectory
     }
 
     virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) override;
+    virtual ezUInt64 Skip(ezUInt64 uiBytes) override;
     virtual ezUInt64 GetFileSize() const override;
+    virtual const ezOSFile* GetOSFile() const override { return &m_File; }
+
+    /// \brief Maps the file into memory with ezMemoryMappedFile, on the first call.
+    virtual ezResult MapFileContent(ezArrayPtr<const ezUInt8>& out_Content) override;
 
   protected:
     virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
@@ -94,6 +100,7 @@ namespace ezDataDirectory
 
     bool m_bIsInUse;
     ezOSFile m_File;
+    ezMemoryMappedFile m_MappedFile;
   };
 
   /// \brief Handles writing to ordinary files.
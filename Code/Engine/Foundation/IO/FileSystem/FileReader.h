@@ -4,9 +4,12 @@
 #include <Foundation/IO/FileSystem/Implementation/FileReaderWriterBase.h>
 #include <Foundation/IO/Stream.h>
 
+class ezAsyncFileReader;
+
 /// \brief The default class to use to read data from a file, implements the ezStreamReader interface.
 ///
 /// This file reader buffers reads up to a certain amount of bytes (configurable).
+/// The cache is only filled with the first call to ReadBytes(), opening a file does not read from it yet.
 /// It closes the file automatically once it goes out of scope.
 class EZ_FOUNDATION_DLL ezFileReader : public ezFileReaderBase
 {
@@ -17,6 +20,7 @@ public:
   ezFileReader()
     : m_uiBytesCached(0)
     , m_uiCacheReadPosition(0)
+    , m_uiCacheSize(0)
     , m_bEOF(true)
   {
   }
@@ -37,9 +41,21 @@ public:
   /// \brief Attempts to read the given number of bytes into the buffer. Returns the actual number of bytes read.
   virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override;
 
+  /// \brief Skips the given number of bytes. Data that is not cached yet is skipped by the data directory, without reading it.
+  virtual ezUInt64 SkipBytes(ezUInt64 uiBytesToSkip) override;
+
+  /// \brief Submits a read of the given number of bytes, starting at the current read position, to \a reader.
+  ///
+  /// Fails if the data directory does not store the file as an ordinary file (see ezDataDirectoryReader::GetOSFile()),
+  /// in which case ReadBytes() has to be used instead.
+  /// On success the read position is moved behind the requested bytes. The file must stay open and ReadBytes() must not be called,
+  /// until \a reader has returned the completion for \a uiUserData.
+  ezResult ReadBytesAsync(ezAsyncFileReader& reader, void* pReadBuffer, ezUInt64 uiBytesToRead, ezUInt64 uiUserData);
+
 private:
   ezUInt64 m_uiBytesCached;
   ezUInt64 m_uiCacheReadPosition;
+  ezUInt32 m_uiCacheSize;
   ezDynamicArray<ezUInt8> m_Cache;
   bool m_bEOF;
 };
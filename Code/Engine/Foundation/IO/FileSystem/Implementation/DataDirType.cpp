@@ -2,6 +2,7 @@
 
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/OSFile.h>
+#include <Foundation/Memory/ArenaAllocator.h>
 
 ezResult ezDataDirectoryType::InitializeDataDirectory(const char* szDataDirPath)
 {
@@ -17,14 +18,35 @@ ezResult ezDataDirectoryType::InitializeDataDirectory(const char* szDataDirPath)
 
 bool ezDataDirectoryType::ExistsFile(const char* szFile, bool bOneSpecificDataDir)
 {
-  ezStringBuilder sRedirectedAsset;
+  ezArenaAllocator<> arena;
+  ezStringBuilder sRedirectedAsset(&arena);
   ResolveAssetRedirection(szFile, sRedirectedAsset);
 
-  ezStringBuilder sPath = GetRedirectedDataDirectoryPath();
+  ezStringBuilder sPath(&arena);
+  sPath = GetRedirectedDataDirectoryPath();
   sPath.AppendPath(sRedirectedAsset);
   return ezOSFile::ExistsFile(sPath);
 }
 
+ezUInt64 ezDataDirectoryReader::Skip(ezUInt64 uiBytes)
+{
+  ezUInt8 uiTemp[1024 * 4];
+
+  ezUInt64 uiSkipped = 0;
+  while (uiSkipped < uiBytes)
+  {
+    const ezUInt64 uiToRead = ezMath::Min<ezUInt64>(uiBytes - uiSkipped, EZ_ARRAY_SIZE(uiTemp));
+    const ezUInt64 uiRead = Read(uiTemp, uiToRead);
+
+    uiSkipped += uiRead;
+
+    if (uiRead < uiToRead)
+      break;
+  }
+
+  return uiSkipped;
+}
+
 void ezDataDirectoryReaderWriterBase::Close()
 {
   InternalClose();
@@ -2,11 +2,13 @@
 
 #include <Foundation/Basics.h>
 #include <Foundation/IO/FileEnums.h>
+#include <Foundation/Types/ArrayPtr.h>
 #include <Foundation/Strings/String.h>
 
 class ezDataDirectoryReaderWriterBase;
 class ezDataDirectoryReader;
 class ezDataDirectoryWriter;
+class ezOSFile;
 struct ezFileStats;
 
 /// \brief The base class for all data directory types.
@@ -163,6 +165,24 @@ public:
   }
 
   virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) = 0;
+
+  /// \brief Moves the read position forward by the given number of bytes and returns how many bytes were actually skipped.
+  ///
+  /// The default implementation reads and discards the data. Derived readers should implement this more efficiently, if they can,
+  /// e.g. by seeking in the file or by only decompressing the parts of a compressed file that are actually read.
+  virtual ezUInt64 Skip(ezUInt64 uiBytes);
+
+  /// \brief Returns the ezOSFile that this reader reads from, if the data is stored in an ordinary file 1:1.
+  ///
+  /// Returns nullptr by default, e.g. for files that are stored compressed in an archive.
+  /// The OS file allows to read the data through an ezAsyncFileReader.
+  virtual const ezOSFile* GetOSFile() const { return nullptr; }
+
+  /// \brief Returns a read-only view of the entire (uncompressed) file content, without copying it, if the data directory supports that.
+  ///
+  /// The memory stays valid until the reader is closed. It is independent of the read position and does not modify it.
+  /// Returns EZ_FAILURE by default, e.g. for files that are stored compressed in an archive, in which case Read() has to be used instead.
+  virtual ezResult MapFileContent(ezArrayPtr<const ezUInt8>& out_Content) { return EZ_FAILURE; }
 };
 
 /// \brief A base class for writers that handle writing to a (virtual) file inside a data directory.
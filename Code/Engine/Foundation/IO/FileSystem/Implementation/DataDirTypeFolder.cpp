@@ -3,6 +3,7 @@
 #include <Foundation/Configuration/Startup.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Memory/ArenaAllocator.h>
 
 // clang-format off
 EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, FolderDataDirectory)
@@ -26,21 +27,69 @@ namespace ezDataDirectory
 
   ezResult FolderReader::InternalOpen(ezFileShareMode::Enum FileShareMode)
   {
-    ezStringBuilder sPath = ((ezDataDirectory::FolderType*)GetDataDirectory())->GetRedirectedDataDirectoryPath();
+    ezArenaAllocator<> arena;
+    ezStringBuilder sPath(&arena);
+    sPath = ((ezDataDirectory::FolderType*)GetDataDirectory())->GetRedirectedDataDirectoryPath();
     sPath.AppendPath(GetFilePath().GetData());
 
     return m_File.Open(sPath.GetData(), ezFileOpenMode::Read, FileShareMode);
   }
 
-  void FolderReader::InternalClose() { m_File.Close(); }
+  void FolderReader::InternalClose()
+  {
+    m_MappedFile.Close();
+    m_File.Close();
+  }
 
   ezUInt64 FolderReader::Read(void* pBuffer, ezUInt64 uiBytes) { return m_File.Read(pBuffer, uiBytes); }
 
+  ezUInt64 FolderReader::Skip(ezUInt64 uiBytes)
+  {
+    const ezUInt64 uiPosition = m_File.GetFilePosition();
+    const ezUInt64 uiSkipped = ezMath::Min(uiBytes, m_File.GetFileSize() - ezMath::Min(uiPosition, m_File.GetFileSize()));
+
+    m_File.SetFilePosition(uiPosition + uiSkipped, ezFileSeekMode::FromStart);
+    return uiSkipped;
+  }
+
   ezUInt64 FolderReader::GetFileSize() const { return m_File.GetFileSize(); }
 
+  ezResult FolderReader::MapFileContent(ezArrayPtr<const ezUInt8>& out_Content)
+  {
+#if EZ_ENABLED(EZ_SUPPORTS_MEMORY_MAPPED_FILE)
+    if (m_MappedFile.GetMode() == ezMemoryMappedFile::Mode::None)
+    {
+      const ezUInt64 uiFileSize = m_File.GetFileSize();
+
+      // empty files cannot be mapped and ezArrayPtr cannot address more than 4 GB
+      if (uiFileSize == 0)
+      {
+        out_Content = ezArrayPtr<const ezUInt8>();
+        return EZ_SUCCESS;
+      }
+
+      if (uiFileSize >= 0xFFFFFFFFu)
+        return EZ_FAILURE;
+
+      {
+        // callers fall back to regular reads when the file can't be mapped (e.g. special files or no address space left), that is no error
+        EZ_LOG_BLOCK_MUTE();
+        EZ_SUCCEED_OR_RETURN(m_MappedFile.Open(m_File.GetOpenFileName(), ezMemoryMappedFile::Mode::ReadOnly));
+      }
+    }
+
+    out_Content = ezArrayPtr<const ezUInt8>(static_cast<const ezUInt8*>(m_MappedFile.GetReadPointer()), static_cast<ezUInt32>(m_MappedFile.GetFileSize()));
+    return EZ_SUCCESS;
+#else
+    return EZ_FAILURE;
+#endif
+  }
+
   ezResult FolderWriter::InternalOpen(ezFileShareMode::Enum FileShareMode)
   {
-    ezStringBuilder sPath = ((ezDataDirectory::FolderType*)GetDataDirectory())->GetRedirectedDataDirectoryPath();
+    ezArenaAllocator<> arena;
+    ezStringBuilder sPath(&arena);
+    sPath = ((ezDataDirectory::FolderType*)GetDataDirectory())->GetRedirectedDataDirectoryPath();
     sPath.AppendPath(GetFilePath().GetData());
 
     return m_File.Open(sPath.GetData(), ezFileOpenMode::Write, FileShareMode);
@@ -161,20 +210,24 @@ namespace ezDataDirectory
 
   bool FolderType::ExistsFile(const char* szFile, bool bOneSpecificDataDir)
   {
-    ezStringBuilder sRedirectedAsset;
+    ezArenaAllocator<> arena;
+    ezStringBuilder sRedirectedAsset(&arena);
     ResolveAssetRedirection(szFile, sRedirectedAsset);
 
-    ezStringBuilder sPath = GetRedirectedDataDirectoryPath();
+    ezStringBuilder sPath(&arena);
+    sPath = GetRedirectedDataDirectoryPath();
     sPath.AppendPath(sRedirectedAsset);
     return ezOSFile::ExistsFile(sPath);
   }
 
   ezResult FolderType::GetFileStats(const char* szFileOrFolder, bool bOneSpecificDataDir, ezFileStats& out_Stats)
   {
-    ezStringBuilder sRedirectedAsset;
+    ezArenaAllocator<> arena;
+    ezStringBuilder sRedirectedAsset(&arena);
     ResolveAssetRedirection(szFileOrFolder, sRedirectedAsset);
 
-    ezStringBuilder sPath = GetRedirectedDataDirectoryPath();
+    ezStringBuilder sPath(&arena);
+    sPath = GetRedirectedDataDirectoryPath();
 
     if (ezPathUtils::IsAbsolutePath(sRedirectedAsset))
     {
@@ -237,7 +290,8 @@ namespace ezDataDirectory
 
   ezDataDirectoryReader* FolderType::OpenFileToRead(const char* szFile, ezFileShareMode::Enum FileShareMode, bool bSpecificallyThisDataDir)
   {
-    ezStringBuilder sFileToOpen;
+    ezArenaAllocator<> arena;
+    ezStringBuilder sFileToOpen(&arena);
     ResolveAssetRedirection(szFile, sFileToOpen);
 
     // we know that these files cannot be opened, so don't even try
@@ -1,6 +1,8 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/IO/AsyncFileReader.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/OSFile.h>
 
 ezResult ezFileReader::Open(const char* szFile, ezUInt32 uiCacheSize /*= 1024 * 64*/,
   ezFileShareMode::Enum FileShareMode /*= ezFileShareMode::SharedReads*/, bool bAllowFileEvents /*= true*/)
@@ -14,11 +16,11 @@ ezResult ezFileReader::Open(const char* szFile, ezUInt32 uiCacheSize /*= 1024 *
   if (!m_pDataDirReader)
     return EZ_FAILURE;
 
-  m_Cache.SetCountUninitialized(uiCacheSize);
-
+  // the cache is allocated and filled by the first ReadBytes() call, such that opening a file does not block on reading it
+  m_uiCacheSize = uiCacheSize;
   m_uiCacheReadPosition = 0;
-  m_uiBytesCached = m_pDataDirReader->Read(&m_Cache[0], m_Cache.GetCount());
-  m_bEOF = m_uiBytesCached > 0 ? false : true;
+  m_uiBytesCached = 0;
+  m_bEOF = false;
 
   return EZ_SUCCESS;
 }
@@ -52,7 +54,10 @@ ezUInt64 ezFileReader::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
 
     // copy data into the buffer
     // uiChunkSize can never be larger than the cache size, which is limited to 32 Bit
-    ezMemoryUtils::Copy(&pBuffer[uiBufferPosition], &m_Cache[(ezUInt32)m_uiCacheReadPosition], (ezUInt32)uiChunkSize);
+    if (uiChunkSize > 0)
+    {
+      ezMemoryUtils::Copy(&pBuffer[uiBufferPosition], &m_Cache[(ezUInt32)m_uiCacheReadPosition], (ezUInt32)uiChunkSize);
+    }
 
     // store how much was read and how much is still left to read
     uiBufferPosition += uiChunkSize;
@@ -65,6 +70,9 @@ ezUInt64 ezFileReader::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
     // this will even be triggered if EXACTLY the amount of available bytes was read
     if (m_uiCacheReadPosition >= m_uiBytesCached)
     {
+      if (m_Cache.GetCount() != m_uiCacheSize)
+        m_Cache.SetCountUninitialized(m_uiCacheSize);
+
       m_uiBytesCached = m_pDataDirReader->Read(&m_Cache[0], m_Cache.GetCount());
       m_uiCacheReadPosition = 0;
 
@@ -83,6 +91,48 @@ ezUInt64 ezFileReader::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
   return uiBufferPosition;
 }
 
+ezUInt64 ezFileReader::SkipBytes(ezUInt64 uiBytesToSkip)
+{
+  EZ_ASSERT_DEV(m_pDataDirReader != nullptr, "The file has not been opened (successfully).");
+  if (m_bEOF)
+    return 0;
+
+  // first skip what is still in the cache
+  const ezUInt64 uiFromCache = ezMath::Min(uiBytesToSkip, m_uiBytesCached - m_uiCacheReadPosition);
+  m_uiCacheReadPosition += uiFromCache;
+
+  if (uiFromCache == uiBytesToSkip)
+    return uiFromCache;
+
+  // the cache is depleted, let the data directory skip the rest, which may be able to do that without reading or decompressing the data
+  const ezUInt64 uiSkipped = m_pDataDirReader->Skip(uiBytesToSkip - uiFromCache);
+
+  m_uiBytesCached = 0;
+  m_uiCacheReadPosition = 0;
+
+  return uiFromCache + uiSkipped;
+}
+
+ezResult ezFileReader::ReadBytesAsync(ezAsyncFileReader& reader, void* pReadBuffer, ezUInt64 uiBytesToRead, ezUInt64 uiUserData)
+{
+  EZ_ASSERT_DEV(m_pDataDirReader != nullptr, "The file has not been opened (successfully).");
+
+  const ezOSFile* pFile = GetOSFile();
+  if (pFile == nullptr)
+    return EZ_FAILURE;
+
+  // everything that is in the cache, but was not returned yet, is read again from the file
+  const ezUInt64 uiReadPosition = pFile->GetFilePosition() - (m_uiBytesCached - m_uiCacheReadPosition);
+
+  reader.SubmitRead(*pFile, uiReadPosition, pReadBuffer, uiBytesToRead, uiUserData);
+
+  pFile->SetFilePosition(uiReadPosition + uiBytesToRead, ezFileSeekMode::FromStart);
+  m_uiBytesCached = 0;
+  m_uiCacheReadPosition = 0;
+
+  return EZ_SUCCESS;
+}
+
 
 
 EZ_STATICLINK_FILE(Foundation, Foundation_IO_FileSystem_Implementation_FileReader);
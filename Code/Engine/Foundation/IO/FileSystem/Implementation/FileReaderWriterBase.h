@@ -36,6 +36,15 @@ public:
   /// \brief Returns the current total size of the file.
   ezUInt64 GetFileSize() const { return m_pDataDirReader->GetFileSize(); }
 
+  /// \brief Returns the ezOSFile that the data is read from, or nullptr if the data directory does not store the file as an ordinary file.
+  const ezOSFile* GetOSFile() const { return m_pDataDirReader->GetOSFile(); }
+
+  /// \brief Gives direct access to the entire file content, e.g. through a memory mapping, such that it can be parsed without copying it.
+  ///
+  /// See ezDataDirectoryReader::MapFileContent(). The view stays valid until the file is closed.
+  /// On failure the file has to be read through the ezStreamReader interface as usual.
+  ezResult MapFileContent(ezArrayPtr<const ezUInt8>& out_Content) { return m_pDataDirReader->MapFileContent(out_Content); }
+
 protected:
   ezDataDirectoryReader* GetFileReader(const char* szFile, ezFileShareMode::Enum FileShareMode, bool bAllowFileEvents)
   {
@@ -4,6 +4,7 @@
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Memory/ArenaAllocator.h>
 
 // clang-format off
 EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, FileSystem)
@@ -460,7 +461,8 @@ ezDataDirectoryReader* ezFileSystem::GetFileReader(const char* szFile, ezFileSha
   szFile = ExtractRootName(szFile, sRootName);
 
   // clean up the path to get rid of ".." etc.
-  ezStringBuilder sPath = szFile;
+  ezArenaAllocator<> arena;
+  ezStringBuilder sPath(szFile, &arena);
   sPath.MakeCleanPath();
 
   const bool bOneSpecificDataDir = !sRootName.IsEmpty();
@@ -598,7 +600,8 @@ ezResult ezFileSystem::ResolvePath(const char* szPath, ezStringBuilder* out_sAbs
 
   EZ_LOCK(s_Data->m_FsMutex);
 
-  ezStringBuilder absPath, relPath;
+  ezArenaAllocator<> arena;
+  ezStringBuilder absPath(&arena), relPath(&arena);
 
   if (ezStringUtils::StartsWith(szPath, ":"))
   {
@@ -0,0 +1,403 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/IO/AsyncFileReader.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Threading/ConditionVariable.h>
+#include <Foundation/Threading/DelegateTask.h>
+
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+#  include <Foundation/IO/Implementation/Posix/IoUring_linux.h>
+#else
+#  define EZ_IO_URING_SUPPORTED EZ_OFF
+#endif
+
+struct ezAsyncFileReaderImpl
+{
+  struct Request
+  {
+    const ezOSFile* m_pFile = nullptr;
+    ezUInt64 m_uiFileOffset = 0;
+    void* m_pBuffer = nullptr;
+    ezUInt64 m_uiBytes = 0;
+    ezUInt64 m_uiBytesRead = 0;
+    ezUInt64 m_uiUserData = 0;
+    ezTime m_StartTime;
+  };
+
+  ezAsyncFileReaderImpl(ezUInt32 uiMaxReadsInFlight, bool bAllowIoUring)
+  {
+    m_uiMaxReadsInFlight = ezMath::Max(uiMaxReadsInFlight, 1u);
+
+#if EZ_ENABLED(EZ_IO_URING_SUPPORTED)
+    if (bAllowIoUring && m_Ring.Initialize(ezMath::PowerOfTwo_Ceil(m_uiMaxReadsInFlight)).Succeeded())
+    {
+      m_bUseIoUring = true;
+      m_InFlight.SetCount(m_uiMaxReadsInFlight);
+      m_FreeSlots.SetCountUninitialized(m_uiMaxReadsInFlight);
+
+      for (ezUInt32 i = 0; i < m_uiMaxReadsInFlight; ++i)
+      {
+        // hand out the low slots first
+        m_FreeSlots[i] = m_uiMaxReadsInFlight - 1 - i;
+      }
+
+      return;
+    }
+#endif
+
+    // the fallback blocks one long running task per read, so there is no point in having more tasks than worker threads
+    const ezUInt32 uiNumWorkers = ezMath::Clamp(ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::LongTasks), 1u, m_uiMaxReadsInFlight);
+    m_Workers.SetCount(uiNumWorkers);
+  }
+
+  ~ezAsyncFileReaderImpl()
+  {
+    for (const Worker& worker : m_Workers)
+    {
+      ezTaskSystem::WaitForGroup(worker.m_GroupId);
+    }
+
+    // a worker that finished before the last one was started may still be about to release the lock
+    EZ_LOCK(m_Signal);
+  }
+
+  bool IsUsingIoUring() const
+  {
+#if EZ_ENABLED(EZ_IO_URING_SUPPORTED)
+    return m_bUseIoUring;
+#else
+    return false;
+#endif
+  }
+
+  void SubmitRead(const Request& request)
+  {
+    ++m_uiNumPendingReads;
+    m_uiNumPendingBytes += request.m_uiBytes;
+
+#if EZ_ENABLED(EZ_IO_URING_SUPPORTED)
+    if (m_bUseIoUring)
+    {
+      m_Queued.PushBack(request);
+      SubmitQueuedReads(false);
+      return;
+    }
+#endif
+
+    EZ_LOCK(m_Signal);
+    m_Queued.PushBack(request);
+
+    for (Worker& worker : m_Workers)
+    {
+      if (!worker.m_bRunning)
+      {
+        worker.m_bRunning = true;
+
+        Worker* pWorker = &worker;
+        ezSharedPtr<ezTask> pTask = EZ_DEFAULT_NEW(ezDelegateTask<void>, "Async File Read", [this, pWorker]() { RunWorker(*pWorker); });
+        worker.m_GroupId = ezTaskSystem::StartSingleTask(pTask, ezTaskPriority::LongRunning);
+        break;
+      }
+    }
+  }
+
+  ezUInt32 PollCompletions(ezDynamicArray<ezAsyncFileReader::Completion>& out_Completions)
+  {
+    ezUInt32 uiNumCompleted = 0;
+
+#if EZ_ENABLED(EZ_IO_URING_SUPPORTED)
+    if (m_bUseIoUring)
+    {
+      SubmitQueuedReads(true);
+      uiNumCompleted = CollectRingCompletions(out_Completions);
+      SubmitQueuedReads(true);
+    }
+    else
+#endif
+    {
+      EZ_LOCK(m_Signal);
+      uiNumCompleted = CollectFinished(out_Completions);
+    }
+
+    RemovePending(out_Completions, uiNumCompleted);
+    return uiNumCompleted;
+  }
+
+  void RemovePending(const ezDynamicArray<ezAsyncFileReader::Completion>& completions, ezUInt32 uiNumCompleted)
+  {
+    for (ezUInt32 i = completions.GetCount() - uiNumCompleted; i < completions.GetCount(); ++i)
+    {
+      m_uiNumPendingBytes -= completions[i].m_uiBytesRequested;
+    }
+
+    m_uiNumPendingReads -= uiNumCompleted;
+  }
+
+  ezUInt32 WaitForCompletions(ezDynamicArray<ezAsyncFileReader::Completion>& out_Completions)
+  {
+    ezUInt32 uiNumCompleted = PollCompletions(out_Completions);
+
+    if (uiNumCompleted > 0 || m_uiNumPendingReads == 0)
+      return uiNumCompleted;
+
+#if EZ_ENABLED(EZ_IO_URING_SUPPORTED)
+    if (m_bUseIoUring)
+    {
+      while (uiNumCompleted == 0)
+      {
+        EZ_VERIFY(m_Ring.Enter(1).Succeeded(), "io_uring_enter failed.");
+        uiNumCompleted = CollectRingCompletions(out_Completions);
+        SubmitQueuedReads(true);
+      }
+
+      RemovePending(out_Completions, uiNumCompleted);
+      return uiNumCompleted;
+    }
+#endif
+
+    m_Signal.Lock();
+
+    while (m_Finished.IsEmpty())
+    {
+      if (!m_Queued.IsEmpty())
+      {
+        // rather than sleeping, do some of the work ourselves, this also guarantees progress if all long running threads are busy
+        Request request = m_Queued.PeekFront();
+        m_Queued.PopFront();
+
+        m_Signal.Unlock();
+        ExecuteRead(request);
+        m_Signal.Lock();
+        continue;
+      }
+
+      m_Signal.UnlockWaitForSignalAndLock();
+    }
+
+    uiNumCompleted = CollectFinished(out_Completions);
+    m_Signal.Unlock();
+
+    RemovePending(out_Completions, uiNumCompleted);
+    return uiNumCompleted;
+  }
+
+  ezUInt32 m_uiMaxReadsInFlight = 0;
+  ezUInt32 m_uiNumPendingReads = 0;
+  ezUInt64 m_uiNumPendingBytes = 0;
+
+  /// Reads that have not been handed to the OS yet. In fallback mode this is shared with the workers and guarded by m_Signal.
+  ezDeque<Request> m_Queued;
+
+private:
+  struct Worker
+  {
+    bool m_bRunning = false;
+    ezTaskGroupID m_GroupId;
+  };
+
+  void ExecuteRead(Request& request)
+  {
+    ezResult result = EZ_SUCCESS;
+
+    if (request.m_uiBytes > 0)
+    {
+      request.m_uiBytesRead = request.m_pFile->ReadAt(request.m_uiFileOffset, request.m_pBuffer, request.m_uiBytes, &result);
+    }
+
+    ezAsyncFileReader::Completion completion;
+    completion.m_uiUserData = request.m_uiUserData;
+    completion.m_uiBytesRequested = request.m_uiBytes;
+    completion.m_uiBytesRead = request.m_uiBytesRead;
+    completion.m_Result = result;
+
+    EZ_LOCK(m_Signal);
+    m_Finished.PushBack(completion);
+    m_Signal.SignalAll();
+  }
+
+  void RunWorker(Worker& worker)
+  {
+    while (true)
+    {
+      Request request;
+
+      {
+        EZ_LOCK(m_Signal);
+
+        if (m_Queued.IsEmpty())
+        {
+          worker.m_bRunning = false;
+          return;
+        }
+
+        request = m_Queued.PeekFront();
+        m_Queued.PopFront();
+      }
+
+      ExecuteRead(request);
+    }
+  }
+
+  ezUInt32 CollectFinished(ezDynamicArray<ezAsyncFileReader::Completion>& out_Completions)
+  {
+    const ezUInt32 uiNumCompleted = m_Finished.GetCount();
+    out_Completions.PushBackRange(m_Finished);
+    m_Finished.Clear();
+    return uiNumCompleted;
+  }
+
+  ezConditionVariable m_Signal;
+  ezDynamicArray<ezAsyncFileReader::Completion> m_Finished;
+  ezHybridArray<Worker, 8> m_Workers;
+
+#if EZ_ENABLED(EZ_IO_URING_SUPPORTED)
+
+  void PrepareRingRead(ezUInt32 uiSlot)
+  {
+    const Request& request = m_InFlight[uiSlot];
+
+    const ezUInt32 uiBatchBytes = 1024 * 1024 * 1024; // 1 GB
+    const ezUInt32 uiBytes = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(request.m_uiBytes - request.m_uiBytesRead, uiBatchBytes));
+
+    m_Ring.PrepareRead(fileno(request.m_pFile->GetFileData().m_pFileHandle), request.m_uiFileOffset + request.m_uiBytesRead,
+      ezMemoryUtils::AddByteOffset(request.m_pBuffer, static_cast<ptrdiff_t>(request.m_uiBytesRead)), uiBytes, uiSlot);
+  }
+
+  void SubmitQueuedReads(bool bForce)
+  {
+    while (!m_Queued.IsEmpty() && !m_FreeSlots.IsEmpty())
+    {
+      const ezUInt32 uiSlot = m_FreeSlots.PeekBack();
+      m_FreeSlots.PopBack();
+
+      m_InFlight[uiSlot] = m_Queued.PeekFront();
+      m_Queued.PopFront();
+
+      PrepareRingRead(uiSlot);
+    }
+
+    // one system call for a whole batch of reads
+    const ezUInt32 uiBatchSize = 16;
+
+    if (m_Ring.GetNumUnsubmitted() >= uiBatchSize || (bForce && m_Ring.GetNumUnsubmitted() > 0))
+    {
+      EZ_VERIFY(m_Ring.Enter(0).Succeeded(), "io_uring_enter failed.");
+    }
+  }
+
+  ezUInt32 CollectRingCompletions(ezDynamicArray<ezAsyncFileReader::Completion>& out_Completions)
+  {
+    ezUInt32 uiNumCompleted = 0;
+
+    m_Ring.ForEachCompletion([&](ezUInt64 uiSlot, ezInt32 iResult) {
+      Request& request = m_InFlight[static_cast<ezUInt32>(uiSlot)];
+
+      if (iResult == -EAGAIN || iResult == -EINTR)
+      {
+        // nothing was read, the request just has to be tried again
+        PrepareRingRead(static_cast<ezUInt32>(uiSlot));
+        return;
+      }
+
+      if (iResult == -EINVAL || iResult == -EOPNOTSUPP)
+      {
+        // some file systems do not support io_uring reads
+        ezResult result = EZ_SUCCESS;
+        request.m_uiBytesRead += request.m_pFile->InternalReadAt(request.m_uiFileOffset + request.m_uiBytesRead,
+          ezMemoryUtils::AddByteOffset(request.m_pBuffer, static_cast<ptrdiff_t>(request.m_uiBytesRead)), request.m_uiBytes - request.m_uiBytesRead, result);
+        iResult = result.Succeeded() ? 0 : -EIO;
+      }
+      else if (iResult > 0)
+      {
+        request.m_uiBytesRead += static_cast<ezUInt64>(iResult);
+
+        // reads may return less than requested without having reached the end of the file, continue where it stopped
+        if (request.m_uiBytesRead < request.m_uiBytes)
+        {
+          PrepareRingRead(static_cast<ezUInt32>(uiSlot));
+          return;
+        }
+      }
+
+      request.m_pFile->BroadcastReadEvent(request.m_uiBytes, request.m_uiBytesRead, ezTime::Now() - request.m_StartTime);
+
+      ezAsyncFileReader::Completion& completion = out_Completions.ExpandAndGetRef();
+      completion.m_uiUserData = request.m_uiUserData;
+      completion.m_uiBytesRequested = request.m_uiBytes;
+      completion.m_uiBytesRead = request.m_uiBytesRead;
+      completion.m_Result = iResult < 0 ? EZ_FAILURE : EZ_SUCCESS;
+
+      m_FreeSlots.PushBack(static_cast<ezUInt32>(uiSlot));
+      ++uiNumCompleted;
+    });
+
+    return uiNumCompleted;
+  }
+
+  bool m_bUseIoUring = false;
+  ezIoUring m_Ring;
+  ezDynamicArray<Request> m_InFlight;
+  ezDynamicArray<ezUInt32> m_FreeSlots;
+
+#endif
+};
+
+ezAsyncFileReader::ezAsyncFileReader(ezUInt32 uiMaxReadsInFlight /*= 64*/, bool bAllowIoUring /*= true*/)
+{
+  m_pImpl = EZ_DEFAULT_NEW(ezAsyncFileReaderImpl, uiMaxReadsInFlight, bAllowIoUring);
+}
+
+ezAsyncFileReader::~ezAsyncFileReader()
+{
+  ezDynamicArray<Completion> discarded;
+
+  while (m_pImpl->m_uiNumPendingReads > 0)
+  {
+    discarded.Clear();
+    m_pImpl->WaitForCompletions(discarded);
+  }
+}
+
+void ezAsyncFileReader::SubmitRead(const ezOSFile& file, ezUInt64 uiFileOffset, void* pBuffer, ezUInt64 uiBytes, ezUInt64 uiUserData)
+{
+  EZ_ASSERT_DEV(file.IsOpen(), "The file must be open.");
+  EZ_ASSERT_DEV(pBuffer != nullptr || uiBytes == 0, "pBuffer must not be nullptr.");
+
+  ezAsyncFileReaderImpl::Request request;
+  request.m_pFile = &file;
+  request.m_uiFileOffset = uiFileOffset;
+  request.m_pBuffer = pBuffer;
+  request.m_uiBytes = uiBytes;
+  request.m_uiUserData = uiUserData;
+  request.m_StartTime = ezTime::Now();
+
+  m_pImpl->SubmitRead(request);
+}
+
+ezUInt32 ezAsyncFileReader::PollCompletions(ezDynamicArray<Completion>& out_Completions)
+{
+  return m_pImpl->PollCompletions(out_Completions);
+}
+
+ezUInt32 ezAsyncFileReader::WaitForCompletions(ezDynamicArray<Completion>& out_Completions)
+{
+  return m_pImpl->WaitForCompletions(out_Completions);
+}
+
+ezUInt32 ezAsyncFileReader::GetNumPendingReads() const
+{
+  return m_pImpl->m_uiNumPendingReads;
+}
+
+ezUInt64 ezAsyncFileReader::GetNumPendingBytes() const
+{
+  return m_pImpl->m_uiNumPendingBytes;
+}
+
+bool ezAsyncFileReader::IsUsingIoUring() const
+{
+  return m_pImpl->IsUsingIoUring();
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_IO_Implementation_AsyncFileReader);
@@ -4,6 +4,7 @@
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
 
+#  include <Foundation/Threading/TaskSystem.h>
 #  include <zstd/zstd.h>
 
 ezCompressedStreamReaderZstd::ezCompressedStreamReaderZstd() = default;
@@ -22,7 +23,7 @@ ezCompressedStreamReaderZstd::~ezCompressedStreamReaderZstd()
   }
 }
 
-void ezCompressedStreamReaderZstd::SetInputStream(ezStreamReader* pInputStream)
+void ezCompressedStreamReaderZstd::SetInputStream(ezStreamReader* pInputStream, const ezZstdDictionary* pDictionary /*= nullptr*/)
 {
   m_InBuffer.pos = 0;
   m_InBuffer.size = 0;
@@ -35,6 +36,14 @@ void ezCompressedStreamReaderZstd::SetInputStream(ezStreamReader* pInputStream)
   }
 
   ZSTD_initDStream(reinterpret_cast<ZSTD_DStream*>(m_pZstdDStream));
+
+  if (pDictionary != nullptr)
+  {
+    EZ_ASSERT_DEV(pDictionary->IsInitialized(), "The zstd dictionary has not been initialized.");
+
+    // the digested dictionary is only referenced, so setting it up for every stream is cheap
+    ZSTD_DCtx_refDDict(reinterpret_cast<ZSTD_DStream*>(m_pZstdDStream), reinterpret_cast<const ZSTD_DDict*>(pDictionary->m_pZstdDDict));
+  }
 }
 
 ezUInt64 ezCompressedStreamReaderZstd::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
@@ -161,8 +170,8 @@ ezCompressedStreamWriterZstd::~ezCompressedStreamWriterZstd()
   }
 }
 
-void ezCompressedStreamWriterZstd::SetOutputStream(
-  ezStreamWriter* pOutputStream, Compression Ratio /*= Compression::Default*/, ezUInt32 uiCompressionCacheSizeKB /*= 4*/)
+void ezCompressedStreamWriterZstd::SetOutputStream(ezStreamWriter* pOutputStream, Compression Ratio /*= Compression::Default*/,
+  ezUInt32 uiCompressionCacheSizeKB /*= 4*/, const ezZstdDictionary* pDictionary /*= nullptr*/)
 {
   if (m_pOutputStream == pOutputStream)
     return;
@@ -185,6 +194,12 @@ void ezCompressedStreamWriterZstd::SetOutputStream(
 
     ZSTD_initCStream(reinterpret_cast<ZSTD_CStream*>(m_pZstdCStream), (int)Ratio);
 
+    if (pDictionary != nullptr)
+    {
+      EZ_ASSERT_DEV(pDictionary->CanCompress(), "The zstd dictionary has not been initialized for compression.");
+      ZSTD_CCtx_refCDict(reinterpret_cast<ZSTD_CStream*>(m_pZstdCStream), reinterpret_cast<const ZSTD_CDict*>(pDictionary->m_pZstdCDict));
+    }
+
     m_CompressedCache.SetCountUninitialized(ezMath::Max(1U, uiCompressionCacheSizeKB) * 1024);
 
     m_OutBuffer.dst = m_CompressedCache.GetData();
@@ -289,6 +304,535 @@ ezResult ezCompressedStreamWriterZstd::WriteBytes(const void* pWriteBuffer, ezUI
   return EZ_SUCCESS;
 }
 
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+
+ezSeekableStreamWriterZstd::ezSeekableStreamWriterZstd() = default;
+
+ezSeekableStreamWriterZstd::~ezSeekableStreamWriterZstd()
+{
+  FinishCompressedStream().IgnoreResult();
+
+  if (m_pZstdCCtx != nullptr)
+  {
+    ZSTD_freeCCtx(reinterpret_cast<ZSTD_CCtx*>(m_pZstdCCtx));
+    m_pZstdCCtx = nullptr;
+  }
+}
+
+void ezSeekableStreamWriterZstd::SetOutputStream(ezStreamWriter* pOutputStream, ezUInt32 uiBlockSize,
+  ezCompressedStreamWriterZstd::Compression Ratio /*= ezCompressedStreamWriterZstd::Compression::Default*/)
+{
+  EZ_ASSERT_DEV(uiBlockSize > 0, "The block size must not be zero.");
+
+  // finish anything done on a previous output stream
+  FinishCompressedStream().IgnoreResult();
+
+  m_pOutputStream = pOutputStream;
+  m_Ratio = Ratio;
+  m_uiBlockSize = uiBlockSize;
+  m_uiUncompressedSize = 0;
+  m_uiWrittenBytes = 0;
+  m_BlockEndOffsets.Clear();
+  m_UncompressedBlock.Clear();
+
+  if (m_pZstdCCtx == nullptr)
+  {
+    m_pZstdCCtx = ZSTD_createCCtx();
+  }
+
+  m_UncompressedBlock.Reserve(uiBlockSize);
+  m_CompressedBlock.SetCountUninitialized(static_cast<ezUInt32>(ZSTD_compressBound(uiBlockSize)));
+}
+
+ezResult ezSeekableStreamWriterZstd::WriteBytes(const void* pWriteBuffer, ezUInt64 uiBytesToWrite)
+{
+  EZ_ASSERT_DEV(m_pOutputStream != nullptr, "The stream is already closed, you cannot write more data to it.");
+
+  const ezUInt8* pBytes = static_cast<const ezUInt8*>(pWriteBuffer);
+  m_uiUncompressedSize += uiBytesToWrite;
+
+  while (uiBytesToWrite > 0)
+  {
+    const ezUInt32 uiToCopy = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(uiBytesToWrite, m_uiBlockSize - m_UncompressedBlock.GetCount()));
+
+    m_UncompressedBlock.PushBackRange(ezArrayPtr<const ezUInt8>(pBytes, uiToCopy));
+    pBytes += uiToCopy;
+    uiBytesToWrite -= uiToCopy;
+
+    if (m_UncompressedBlock.GetCount() == m_uiBlockSize)
+    {
+      EZ_SUCCEED_OR_RETURN(CompressBlock());
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezSeekableStreamWriterZstd::FinishCompressedStream()
+{
+  if (m_pOutputStream == nullptr)
+    return EZ_SUCCESS;
+
+  if (!m_UncompressedBlock.IsEmpty())
+  {
+    EZ_SUCCEED_OR_RETURN(CompressBlock());
+  }
+
+  m_pOutputStream = nullptr;
+  return EZ_SUCCESS;
+}
+
+ezResult ezSeekableStreamWriterZstd::CompressBlock()
+{
+  // every block is a complete zstd frame, so that it can be decompressed without any of the other blocks
+  const size_t uiCompressedSize = ZSTD_compressCCtx(reinterpret_cast<ZSTD_CCtx*>(m_pZstdCCtx), m_CompressedBlock.GetData(), m_CompressedBlock.GetCount(),
+    m_UncompressedBlock.GetData(), m_UncompressedBlock.GetCount(), (int)m_Ratio);
+  EZ_VERIFY(!ZSTD_isError(uiCompressedSize), "Compressing the zstd block failed: '{0}'", ZSTD_getErrorName(uiCompressedSize));
+
+  EZ_SUCCEED_OR_RETURN(m_pOutputStream->WriteBytes(m_CompressedBlock.GetData(), uiCompressedSize));
+
+  m_uiWrittenBytes += uiCompressedSize;
+  m_BlockEndOffsets.PushBack(m_uiWrittenBytes);
+  m_UncompressedBlock.Clear();
+
+  return EZ_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+
+ezSeekableStreamReaderZstd::ezSeekableStreamReaderZstd() = default;
+
+ezSeekableStreamReaderZstd::~ezSeekableStreamReaderZstd()
+{
+  if (m_pZstdDCtx != nullptr)
+  {
+    ZSTD_freeDCtx(reinterpret_cast<ZSTD_DCtx*>(m_pZstdDCtx));
+    m_pZstdDCtx = nullptr;
+  }
+}
+
+void ezSeekableStreamReaderZstd::SetInputData(
+  const void* pCompressedData, ezArrayPtr<const ezUInt64> blockEndOffsets, ezUInt32 uiBlockSize, ezUInt64 uiUncompressedSize)
+{
+  EZ_ASSERT_DEV(uiUncompressedSize == 0 || uiBlockSize > 0, "The block size must not be zero.");
+  EZ_ASSERT_DEV(uiUncompressedSize == 0 || (uiUncompressedSize - 1) / uiBlockSize + 1 == blockEndOffsets.GetCount(),
+    "The number of blocks ({}) does not match the uncompressed size.", blockEndOffsets.GetCount());
+
+  m_pCompressedData = static_cast<const ezUInt8*>(pCompressedData);
+  m_BlockEndOffsets = blockEndOffsets;
+  m_uiBlockSize = uiBlockSize;
+  m_uiUncompressedSize = uiUncompressedSize;
+  m_uiReadPosition = 0;
+  m_uiCachedBlock = ezInvalidIndex;
+
+  if (m_pZstdDCtx == nullptr)
+  {
+    m_pZstdDCtx = ZSTD_createDCtx();
+  }
+}
+
+ezUInt64 ezSeekableStreamReaderZstd::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
+{
+  uiBytesToRead = ezMath::Min(uiBytesToRead, m_uiUncompressedSize - m_uiReadPosition);
+
+  if (pReadBuffer == nullptr)
+    return SkipBytes(uiBytesToRead);
+
+  ezUInt8* pTarget = static_cast<ezUInt8*>(pReadBuffer);
+  ezUInt64 uiBytesRead = 0;
+
+  while (uiBytesRead < uiBytesToRead)
+  {
+    const ezUInt64 uiBytesLeft = uiBytesToRead - uiBytesRead;
+    const ezUInt32 uiBlock = static_cast<ezUInt32>(m_uiReadPosition / m_uiBlockSize);
+    const ezUInt64 uiBlockStart = static_cast<ezUInt64>(uiBlock) * m_uiBlockSize;
+    const ezUInt32 uiBlockBytes = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(m_uiBlockSize, m_uiUncompressedSize - uiBlockStart));
+    const ezUInt32 uiOffsetInBlock = static_cast<ezUInt32>(m_uiReadPosition - uiBlockStart);
+
+    ezUInt64 uiChunkSize = 0;
+
+    if (uiOffsetInBlock == 0 && uiBlockBytes <= uiBytesLeft)
+    {
+      // all complete blocks are decompressed directly into the target buffer, only the last block can be shorter than the block size
+      const ezUInt32 uiNumBlocks = (m_uiReadPosition + uiBytesLeft == m_uiUncompressedSize) ? m_BlockEndOffsets.GetCount() - uiBlock
+                                                                                            : static_cast<ezUInt32>(uiBytesLeft / m_uiBlockSize);
+
+      if (DecompressBlocks(uiBlock, uiNumBlocks, pTarget + uiBytesRead).Failed())
+        return uiBytesRead;
+
+      uiChunkSize = ezMath::Min<ezUInt64>(static_cast<ezUInt64>(uiNumBlocks) * m_uiBlockSize, uiBytesLeft);
+    }
+    else
+    {
+      // partially read blocks go through the cache, so that consecutive small reads do not decompress the same block again
+      if (m_uiCachedBlock != uiBlock)
+      {
+        m_BlockCache.SetCountUninitialized(m_uiBlockSize);
+
+        if (DecompressBlock(m_pZstdDCtx, uiBlock, m_BlockCache.GetData()).Failed())
+        {
+          m_uiCachedBlock = ezInvalidIndex;
+          return uiBytesRead;
+        }
+
+        m_uiCachedBlock = uiBlock;
+      }
+
+      uiChunkSize = ezMath::Min<ezUInt64>(uiBlockBytes - uiOffsetInBlock, uiBytesLeft);
+      ezMemoryUtils::Copy(pTarget + uiBytesRead, m_BlockCache.GetData() + uiOffsetInBlock, static_cast<size_t>(uiChunkSize));
+    }
+
+    uiBytesRead += uiChunkSize;
+    m_uiReadPosition += uiChunkSize;
+  }
+
+  return uiBytesRead;
+}
+
+ezUInt64 ezSeekableStreamReaderZstd::SkipBytes(ezUInt64 uiBytesToSkip)
+{
+  uiBytesToSkip = ezMath::Min(uiBytesToSkip, m_uiUncompressedSize - m_uiReadPosition);
+  m_uiReadPosition += uiBytesToSkip;
+  return uiBytesToSkip;
+}
+
+void ezSeekableStreamReaderZstd::SetReadPosition(ezUInt64 uiPosition)
+{
+  m_uiReadPosition = ezMath::Min(uiPosition, m_uiUncompressedSize);
+}
+
+ezResult ezSeekableStreamReaderZstd::DecompressBlock(void* pZstdDCtx, ezUInt32 uiBlock, void* pTarget) const
+{
+  const ezUInt64 uiStart = uiBlock > 0 ? m_BlockEndOffsets[uiBlock - 1] : 0;
+  const ezUInt64 uiEnd = m_BlockEndOffsets[uiBlock];
+  const ezUInt64 uiExpectedSize = ezMath::Min<ezUInt64>(m_uiBlockSize, m_uiUncompressedSize - static_cast<ezUInt64>(uiBlock) * m_uiBlockSize);
+
+  const size_t res =
+    ZSTD_decompressDCtx(reinterpret_cast<ZSTD_DCtx*>(pZstdDCtx), pTarget, static_cast<size_t>(uiExpectedSize), m_pCompressedData + uiStart, static_cast<size_t>(uiEnd - uiStart));
+
+  if (ZSTD_isError(res) || res != uiExpectedSize)
+  {
+    EZ_REPORT_FAILURE("Decompressing zstd block {} failed: '{}'", uiBlock, ZSTD_isError(res) ? ZSTD_getErrorName(res) : "unexpected size");
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezSeekableStreamReaderZstd::DecompressBlocks(ezUInt32 uiFirstBlock, ezUInt32 uiNumBlocks, ezUInt8* pTarget)
+{
+  if (m_uiMinBlocksForParallelDecompression == 0 || uiNumBlocks < m_uiMinBlocksForParallelDecompression)
+  {
+    for (ezUInt32 i = 0; i < uiNumBlocks; ++i)
+    {
+      EZ_SUCCEED_OR_RETURN(DecompressBlock(m_pZstdDCtx, uiFirstBlock + i, pTarget + static_cast<ezUInt64>(i) * m_uiBlockSize));
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  ezAtomicInteger32 iFailed;
+
+  ezTaskSystem::ParallelForIndexed(
+    0, uiNumBlocks,
+    [this, uiFirstBlock, pTarget, &iFailed](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      // decompression contexts must not be shared between threads
+      ZSTD_DCtx* pZstdDCtx = ZSTD_createDCtx();
+
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        if (DecompressBlock(pZstdDCtx, uiFirstBlock + i, pTarget + static_cast<ezUInt64>(i) * m_uiBlockSize).Failed())
+        {
+          iFailed.Set(1);
+          break;
+        }
+      }
+
+      ZSTD_freeDCtx(pZstdDCtx);
+    },
+    "DecompressZstdBlocks");
+
+  return iFailed == 0 ? EZ_SUCCESS : EZ_FAILURE;
+}
+
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+  // ezZstdDictionary::Train() is a simplified version of the COVER algorithm of zstd's dictionary builder:
+  // the samples are split into epochs and from every epoch the segment is picked, whose k-mers occur in the most other samples.
+  static constexpr ezUInt32 s_uiZstdDictionaryKmerSize = 8;
+  static constexpr ezUInt32 s_uiZstdDictionarySegmentSize = 256;
+  static constexpr ezUInt32 s_uiZstdDictionaryMinHashBits = 16;
+  static constexpr ezUInt32 s_uiZstdDictionaryMaxHashBits = 22;
+
+  EZ_ALWAYS_INLINE ezUInt32 HashZstdDictionaryKmer(const ezUInt8* pData, ezUInt32 uiHashBits)
+  {
+    static_assert(s_uiZstdDictionaryKmerSize == sizeof(ezUInt64), "The k-mers are hashed as 64 bit values");
+
+    ezUInt64 uiKmer;
+    ezMemoryUtils::RawByteCopy(&uiKmer, pData, sizeof(ezUInt64));
+    return static_cast<ezUInt32>((uiKmer * 0x9E3779B97F4A7C15ull) >> (64 - uiHashBits));
+  }
+
+  struct ezZstdDictionarySegment
+  {
+    ezUInt32 m_uiSample = 0;
+    ezUInt32 m_uiStart = 0;
+    ezUInt64 m_uiScore = 0;
+  };
+} // namespace
+
+ezZstdDictionary::ezZstdDictionary() = default;
+
+ezZstdDictionary::~ezZstdDictionary()
+{
+  Clear();
+}
+
+void ezZstdDictionary::Train(ezArrayPtr<const ezArrayPtr<const ezUInt8>> samples, ezUInt32 uiMaxDictionarySize, ezDynamicArray<ezUInt8>& out_Dictionary)
+{
+  out_Dictionary.Clear();
+
+  constexpr ezUInt32 uiKmersPerSegment = s_uiZstdDictionarySegmentSize - s_uiZstdDictionaryKmerSize + 1;
+  const ezUInt32 uiNumSegments = uiMaxDictionarySize / s_uiZstdDictionarySegmentSize;
+
+  // every position from which a complete segment can be taken is a candidate
+  ezUInt64 uiNumCandidates = 0;
+  ezUInt64 uiTotalSize = 0;
+  for (const auto& sample : samples)
+  {
+    uiTotalSize += sample.GetCount();
+
+    if (sample.GetCount() >= s_uiZstdDictionarySegmentSize)
+      uiNumCandidates += sample.GetCount() - s_uiZstdDictionarySegmentSize + 1;
+  }
+
+  if (samples.GetCount() < 2 || uiNumSegments == 0 || uiNumCandidates == 0)
+    return;
+
+  // k-mers are only tracked by their hash, the table has to be sparse enough, so that unrelated k-mers rarely share a slot
+  ezUInt32 uiHashBits = s_uiZstdDictionaryMinHashBits;
+  while (uiHashBits < s_uiZstdDictionaryMaxHashBits && (1ull << (uiHashBits - 2)) < uiTotalSize)
+  {
+    ++uiHashBits;
+  }
+
+  const ezUInt32 uiNumHashes = 1u << uiHashBits;
+
+  // count in how many samples each k-mer occurs
+  ezDynamicArray<ezUInt16> frequency;
+  frequency.SetCount(uiNumHashes);
+
+  {
+    ezDynamicArray<ezUInt32> lastSample;
+    lastSample.SetCount(uiNumHashes, ezInvalidIndex);
+
+    for (ezUInt32 s = 0; s < samples.GetCount(); ++s)
+    {
+      const ezUInt8* pData = samples[s].GetPtr();
+
+      for (ezUInt32 i = 0; i + s_uiZstdDictionaryKmerSize <= samples[s].GetCount(); ++i)
+      {
+        const ezUInt32 uiHash = HashZstdDictionaryKmer(pData + i, uiHashBits);
+
+        if (lastSample[uiHash] != s)
+        {
+          lastSample[uiHash] = s;
+          frequency[uiHash] = ezMath::Min<ezUInt16>(frequency[uiHash], 0xFFFE) + 1;
+        }
+      }
+    }
+  }
+
+  // k-mers that only occur in a single sample do not help to compress any other data
+  for (ezUInt16& uiFrequency : frequency)
+  {
+    if (uiFrequency == 1)
+      uiFrequency = 0;
+  }
+
+  // the score of a segment is the sum of the frequencies of its distinct k-mers, it is updated incrementally while the segment slides along
+  ezDynamicArray<ezUInt16> activeKmers;
+  activeKmers.SetCount(uiNumHashes);
+
+  auto FindBestSegment = [&](ezUInt32 uiSample, ezUInt32 uiFirstStart, ezUInt32 uiEndStart, ezZstdDictionarySegment& inout_Best) {
+    const ezUInt8* pData = samples[uiSample].GetPtr();
+    ezUInt64 uiScore = 0;
+
+    auto AddKmer = [&](ezUInt32 uiPos) {
+      const ezUInt32 uiHash = HashZstdDictionaryKmer(pData + uiPos, uiHashBits);
+      if (activeKmers[uiHash]++ == 0)
+        uiScore += frequency[uiHash];
+    };
+
+    auto RemoveKmer = [&](ezUInt32 uiPos) {
+      const ezUInt32 uiHash = HashZstdDictionaryKmer(pData + uiPos, uiHashBits);
+      if (--activeKmers[uiHash] == 0)
+        uiScore -= frequency[uiHash];
+    };
+
+    for (ezUInt32 k = 0; k < uiKmersPerSegment; ++k)
+    {
+      AddKmer(uiFirstStart + k);
+    }
+
+    ezUInt32 uiStart = uiFirstStart;
+    while (true)
+    {
+      if (uiScore > inout_Best.m_uiScore)
+      {
+        inout_Best.m_uiSample = uiSample;
+        inout_Best.m_uiStart = uiStart;
+        inout_Best.m_uiScore = uiScore;
+      }
+
+      if (uiStart + 1 == uiEndStart)
+        break;
+
+      RemoveKmer(uiStart);
+      AddKmer(uiStart + uiKmersPerSegment);
+      ++uiStart;
+    }
+
+    for (ezUInt32 k = 0; k < uiKmersPerSegment; ++k)
+    {
+      RemoveKmer(uiStart + k);
+    }
+  };
+
+  ezDynamicArray<ezZstdDictionarySegment> segments;
+
+  const ezUInt64 uiEpochSize = ezMath::Max<ezUInt64>(1, uiNumCandidates / uiNumSegments);
+  ezUInt32 uiSample = 0;
+  ezUInt32 uiCandidate = 0;
+
+  for (ezUInt32 uiEpoch = 0; uiEpoch < uiNumSegments && uiSample < samples.GetCount(); ++uiEpoch)
+  {
+    ezZstdDictionarySegment best;
+
+    for (ezUInt64 uiCandidatesLeft = uiEpochSize; uiCandidatesLeft > 0 && uiSample < samples.GetCount();)
+    {
+      const ezUInt32 uiSampleSize = samples[uiSample].GetCount();
+
+      if (uiSampleSize < s_uiZstdDictionarySegmentSize)
+      {
+        ++uiSample;
+        continue;
+      }
+
+      const ezUInt32 uiEndCandidate = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(uiSampleSize - s_uiZstdDictionarySegmentSize + 1, uiCandidate + uiCandidatesLeft));
+
+      FindBestSegment(uiSample, uiCandidate, uiEndCandidate, best);
+
+      uiCandidatesLeft -= uiEndCandidate - uiCandidate;
+      uiCandidate = uiEndCandidate;
+
+      if (uiCandidate + s_uiZstdDictionarySegmentSize > uiSampleSize)
+      {
+        ++uiSample;
+        uiCandidate = 0;
+      }
+    }
+
+    // a segment whose content hardly occurs in any other sample is not worth the space
+    if (best.m_uiScore < uiKmersPerSegment)
+      continue;
+
+    // the content of the chosen segment is in the dictionary now, later segments only get credit for other content
+    for (ezUInt32 k = 0; k < uiKmersPerSegment; ++k)
+    {
+      frequency[HashZstdDictionaryKmer(samples[best.m_uiSample].GetPtr() + best.m_uiStart + k, uiHashBits)] = 0;
+    }
+
+    segments.PushBack(best);
+  }
+
+  // matches with recent data are cheaper to encode, so the most valuable segments go to the end of the dictionary
+  segments.Sort([](const ezZstdDictionarySegment& lhs, const ezZstdDictionarySegment& rhs) -> bool {
+    if (lhs.m_uiScore != rhs.m_uiScore)
+      return lhs.m_uiScore < rhs.m_uiScore;
+    if (lhs.m_uiSample != rhs.m_uiSample)
+      return lhs.m_uiSample < rhs.m_uiSample;
+    return lhs.m_uiStart < rhs.m_uiStart;
+  });
+
+  out_Dictionary.Reserve(segments.GetCount() * s_uiZstdDictionarySegmentSize);
+
+  for (const auto& segment : segments)
+  {
+    out_Dictionary.PushBackRange(ezArrayPtr<const ezUInt8>(samples[segment.m_uiSample].GetPtr() + segment.m_uiStart, s_uiZstdDictionarySegmentSize));
+  }
+
+  // data that starts with the magic number would be interpreted as a dictionary in the zstd format instead of as raw content
+  if (out_Dictionary.GetCount() >= 4)
+  {
+    const ezUInt32 uiStart = out_Dictionary[0] | (out_Dictionary[1] << 8) | (out_Dictionary[2] << 16) | (static_cast<ezUInt32>(out_Dictionary[3]) << 24);
+
+    if (uiStart == ZSTD_MAGIC_DICTIONARY)
+    {
+      out_Dictionary.RemoveAtAndCopy(0);
+    }
+  }
+}
+
+ezResult ezZstdDictionary::Initialize(ezArrayPtr<const ezUInt8> dictionary, bool bForCompression /*= false*/,
+  ezCompressedStreamWriterZstd::Compression Ratio /*= ezCompressedStreamWriterZstd::Compression::Default*/)
+{
+  Clear();
+
+  if (dictionary.IsEmpty())
+    return EZ_FAILURE;
+
+  m_pZstdDDict = ZSTD_createDDict(dictionary.GetPtr(), dictionary.GetCount());
+
+  if (m_pZstdDDict == nullptr)
+    return EZ_FAILURE;
+
+  if (bForCompression)
+  {
+    m_pZstdCDict = ZSTD_createCDict(dictionary.GetPtr(), dictionary.GetCount(), (int)Ratio);
+
+    if (m_pZstdCDict == nullptr)
+    {
+      Clear();
+      return EZ_FAILURE;
+    }
+  }
+
+  m_uiDictionarySize = dictionary.GetCount();
+  return EZ_SUCCESS;
+}
+
+void ezZstdDictionary::Clear()
+{
+  if (m_pZstdCDict != nullptr)
+  {
+    ZSTD_freeCDict(reinterpret_cast<ZSTD_CDict*>(m_pZstdCDict));
+    m_pZstdCDict = nullptr;
+  }
+
+  if (m_pZstdDDict != nullptr)
+  {
+    ZSTD_freeDDict(reinterpret_cast<ZSTD_DDict*>(m_pZstdDDict));
+    m_pZstdDDict = nullptr;
+  }
+
+  m_uiDictionarySize = 0;
+}
+
 #endif
 
 
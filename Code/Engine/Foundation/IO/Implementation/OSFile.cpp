@@ -1,6 +1,7 @@
 #include <FoundationPCH.h>
 
 #include <Foundation/IO/OSFile.h>
+#include <Foundation/Memory/ArenaAllocator.h>
 
 ezString64 ezOSFile::s_ApplicationPath;
 ezString64 ezOSFile::s_UserDataPath;
@@ -144,20 +145,40 @@ ezUInt64 ezOSFile::Read(void* pBuffer, ezUInt64 uiBytes)
 
   const ezUInt64 Res = InternalRead(pBuffer, uiBytes);
 
-  const ezTime t1 = ezTime::Now();
-  const ezTime tdiff = t1 - t0;
+  BroadcastReadEvent(uiBytes, Res, ezTime::Now() - t0);
+
+  return Res;
+}
+
+ezUInt64 ezOSFile::ReadAt(ezUInt64 uiFileOffset, void* pBuffer, ezUInt64 uiBytes, ezResult* out_pResult /*= nullptr*/) const
+{
+  EZ_ASSERT_DEV(m_FileMode == ezFileOpenMode::Read, "The file is not opened for reading.");
+  EZ_ASSERT_DEV(pBuffer != nullptr, "pBuffer must not be nullptr.");
+
+  const ezTime t0 = ezTime::Now();
 
+  ezResult result = EZ_SUCCESS;
+  const ezUInt64 Res = InternalReadAt(uiFileOffset, pBuffer, uiBytes, result);
+
+  BroadcastReadEvent(uiBytes, Res, ezTime::Now() - t0);
+
+  if (out_pResult != nullptr)
+    *out_pResult = result;
+
+  return Res;
+}
+
+void ezOSFile::BroadcastReadEvent(ezUInt64 uiBytesRequested, ezUInt64 uiBytesRead, ezTime duration) const
+{
   EventData e;
-  e.m_bSuccess = (Res == uiBytes);
-  e.m_Duration = tdiff;
+  e.m_bSuccess = (uiBytesRead == uiBytesRequested);
+  e.m_Duration = duration;
   e.m_iFileID = m_iFileID;
   e.m_szFile = m_sFileName.GetData();
   e.m_EventType = EventType::FileRead;
-  e.m_uiBytesAccessed = Res;
+  e.m_uiBytesAccessed = uiBytesRead;
 
   s_FileEvents.Broadcast(e);
-
-  return Res;
 }
 
 ezUInt64 ezOSFile::ReadAll(ezDynamicArray<ezUInt8>& out_FileContent)
@@ -225,7 +246,8 @@ bool ezOSFile::ExistsFile(const char* szFile)
 {
   const ezTime t0 = ezTime::Now();
 
-  ezStringBuilder s(szFile);
+  ezArenaAllocator<> arena;
+  ezStringBuilder s(szFile, &arena);
   s.MakeCleanPath();
   s.MakePathSeparatorsNative();
 
@@ -251,7 +273,8 @@ bool ezOSFile::ExistsDirectory(const char* szDirectory)
 {
   const ezTime t0 = ezTime::Now();
 
-  ezStringBuilder s(szDirectory);
+  ezArenaAllocator<> arena;
+  ezStringBuilder s(szDirectory, &arena);
   s.MakeCleanPath();
   s.MakePathSeparatorsNative();
 
@@ -279,7 +302,8 @@ ezResult ezOSFile::DeleteFile(const char* szFile)
 {
   const ezTime t0 = ezTime::Now();
 
-  ezStringBuilder s(szFile);
+  ezArenaAllocator<> arena;
+  ezStringBuilder s(szFile, &arena);
   s.MakeCleanPath();
   s.MakePathSeparatorsNative();
 
@@ -409,7 +433,8 @@ ezResult ezOSFile::GetFileStats(const char* szFileOrFolder, ezFileStats& out_Sta
 {
   const ezTime t0 = ezTime::Now();
 
-  ezStringBuilder s = szFileOrFolder;
+  ezArenaAllocator<> arena;
+  ezStringBuilder s(szFileOrFolder, &arena);
   s.MakeCleanPath();
   s.MakePathSeparatorsNative();
 
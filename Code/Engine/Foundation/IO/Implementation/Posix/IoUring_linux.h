@@ -0,0 +1,217 @@
+#pragma once
+
+#include <Foundation/FoundationPCH.h>
+EZ_FOUNDATION_INTERNAL_HEADER
+
+#if __has_include(<linux/io_uring.h>)
+#  include <linux/io_uring.h>
+#endif
+
+// IORING_OP_READ was added together with IORING_FEAT_RW_CUR_POS (Linux 5.6), older headers are treated as unsupported
+#if defined(IORING_FEAT_RW_CUR_POS)
+
+#  include <errno.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+
+#  define EZ_IO_URING_SUPPORTED EZ_ON
+
+/// \brief Minimal wrapper around the raw io_uring system calls, to not depend on liburing.
+///
+/// Only supports what ezAsyncFileReader needs: one submission and one completion queue, used from a single thread.
+class ezIoUring
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezIoUring);
+
+public:
+  ezIoUring() = default;
+  ~ezIoUring() { Deinitialize(); }
+
+  /// \brief Creates the ring. Fails if the kernel does not support io_uring, or if it is blocked (e.g. by seccomp or sysctl).
+  ezResult Initialize(ezUInt32 uiEntries)
+  {
+    io_uring_params params;
+    ezMemoryUtils::ZeroFill(&params, 1);
+
+    m_iRingFd = static_cast<int>(syscall(__NR_io_uring_setup, uiEntries, &params));
+    if (m_iRingFd < 0)
+    {
+      m_iRingFd = -1;
+      return EZ_FAILURE;
+    }
+
+    m_uiSqRingSize = params.sq_off.array + params.sq_entries * sizeof(ezUInt32);
+    m_uiCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+    const bool bSingleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (bSingleMap)
+    {
+      m_uiSqRingSize = ezMath::Max(m_uiSqRingSize, m_uiCqRingSize);
+      m_uiCqRingSize = m_uiSqRingSize;
+    }
+
+    m_pSqRing = mmap(nullptr, m_uiSqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_iRingFd, IORING_OFF_SQ_RING);
+    if (m_pSqRing == MAP_FAILED)
+    {
+      m_pSqRing = nullptr;
+      Deinitialize();
+      return EZ_FAILURE;
+    }
+
+    if (bSingleMap)
+    {
+      m_pCqRing = m_pSqRing;
+    }
+    else
+    {
+      m_pCqRing = mmap(nullptr, m_uiCqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_iRingFd, IORING_OFF_CQ_RING);
+      if (m_pCqRing == MAP_FAILED)
+      {
+        m_pCqRing = nullptr;
+        Deinitialize();
+        return EZ_FAILURE;
+      }
+    }
+
+    m_uiSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* pSqes = mmap(nullptr, m_uiSqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_iRingFd, IORING_OFF_SQES);
+    if (pSqes == MAP_FAILED)
+    {
+      Deinitialize();
+      return EZ_FAILURE;
+    }
+
+    m_pSqes = static_cast<io_uring_sqe*>(pSqes);
+
+    m_pSqTail = ezMemoryUtils::AddByteOffset(static_cast<ezUInt32*>(m_pSqRing), params.sq_off.tail);
+    m_uiSqMask = *ezMemoryUtils::AddByteOffset(static_cast<ezUInt32*>(m_pSqRing), params.sq_off.ring_mask);
+    m_pSqArray = ezMemoryUtils::AddByteOffset(static_cast<ezUInt32*>(m_pSqRing), params.sq_off.array);
+
+    m_pCqHead = ezMemoryUtils::AddByteOffset(static_cast<ezUInt32*>(m_pCqRing), params.cq_off.head);
+    m_pCqTail = ezMemoryUtils::AddByteOffset(static_cast<ezUInt32*>(m_pCqRing), params.cq_off.tail);
+    m_uiCqMask = *ezMemoryUtils::AddByteOffset(static_cast<ezUInt32*>(m_pCqRing), params.cq_off.ring_mask);
+    m_pCqes = ezMemoryUtils::AddByteOffset(static_cast<io_uring_cqe*>(m_pCqRing), params.cq_off.cqes);
+
+    m_uiNumEntries = params.sq_entries;
+    m_uiNumUnsubmitted = 0;
+    return EZ_SUCCESS;
+  }
+
+  void Deinitialize()
+  {
+    if (m_pSqes != nullptr)
+      munmap(m_pSqes, m_uiSqesSize);
+    if (m_pCqRing != nullptr && m_pCqRing != m_pSqRing)
+      munmap(m_pCqRing, m_uiCqRingSize);
+    if (m_pSqRing != nullptr)
+      munmap(m_pSqRing, m_uiSqRingSize);
+    if (m_iRingFd >= 0)
+      close(m_iRingFd);
+
+    m_pSqes = nullptr;
+    m_pCqRing = nullptr;
+    m_pSqRing = nullptr;
+    m_iRingFd = -1;
+  }
+
+  bool IsInitialized() const { return m_iRingFd >= 0; }
+
+  /// \brief The number of submission queue entries. The completion queue is at least this large, too.
+  ezUInt32 GetNumEntries() const { return m_uiNumEntries; }
+
+  /// \brief Queues a read request. It is handed to the kernel with the next call to Enter().
+  ///
+  /// The caller must make sure to never have more than GetNumEntries() requests queued or in flight.
+  void PrepareRead(int iFileDescriptor, ezUInt64 uiFileOffset, void* pBuffer, ezUInt32 uiBytes, ezUInt64 uiUserData)
+  {
+    const ezUInt32 uiTail = *m_pSqTail;
+    const ezUInt32 uiIndex = uiTail & m_uiSqMask;
+
+    io_uring_sqe* pSqe = &m_pSqes[uiIndex];
+    ezMemoryUtils::ZeroFill(pSqe, 1);
+    pSqe->opcode = IORING_OP_READ;
+    pSqe->fd = iFileDescriptor;
+    pSqe->off = uiFileOffset;
+    pSqe->addr = reinterpret_cast<ezUInt64>(pBuffer);
+    pSqe->len = uiBytes;
+    pSqe->user_data = uiUserData;
+
+    m_pSqArray[uiIndex] = uiIndex;
+
+    // the kernel must see the filled entry before the new tail
+    __atomic_store_n(m_pSqTail, uiTail + 1, __ATOMIC_RELEASE);
+    ++m_uiNumUnsubmitted;
+  }
+
+  ezUInt32 GetNumUnsubmitted() const { return m_uiNumUnsubmitted; }
+
+  /// \brief Hands all prepared requests to the kernel and optionally blocks until at least \a uiMinComplete requests have completed.
+  ezResult Enter(ezUInt32 uiMinComplete)
+  {
+    while (true)
+    {
+      const ezUInt32 uiFlags = uiMinComplete > 0 ? IORING_ENTER_GETEVENTS : 0;
+      const long iRes = syscall(__NR_io_uring_enter, m_iRingFd, m_uiNumUnsubmitted, uiMinComplete, uiFlags, nullptr, 0);
+
+      if (iRes >= 0)
+      {
+        m_uiNumUnsubmitted -= static_cast<ezUInt32>(iRes);
+
+        if (m_uiNumUnsubmitted == 0 || uiMinComplete > 0)
+          return EZ_SUCCESS;
+
+        continue;
+      }
+
+      if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+        return EZ_FAILURE;
+    }
+  }
+
+  /// \brief Calls \a callback(ezUInt64 uiUserData, ezInt32 iResult) for every completed request and removes them from the queue.
+  template <typename Callback>
+  ezUInt32 ForEachCompletion(Callback callback)
+  {
+    ezUInt32 uiHead = *m_pCqHead;
+    const ezUInt32 uiTail = __atomic_load_n(m_pCqTail, __ATOMIC_ACQUIRE);
+    const ezUInt32 uiCount = uiTail - uiHead;
+
+    for (; uiHead != uiTail; ++uiHead)
+    {
+      const io_uring_cqe& cqe = m_pCqes[uiHead & m_uiCqMask];
+      callback(static_cast<ezUInt64>(cqe.user_data), static_cast<ezInt32>(cqe.res));
+    }
+
+    // the entries must have been read, before the kernel may overwrite them
+    __atomic_store_n(m_pCqHead, uiHead, __ATOMIC_RELEASE);
+    return uiCount;
+  }
+
+private:
+  int m_iRingFd = -1;
+  ezUInt32 m_uiNumEntries = 0;
+  ezUInt32 m_uiNumUnsubmitted = 0;
+
+  void* m_pSqRing = nullptr;
+  void* m_pCqRing = nullptr;
+  io_uring_sqe* m_pSqes = nullptr;
+  size_t m_uiSqRingSize = 0;
+  size_t m_uiCqRingSize = 0;
+  size_t m_uiSqesSize = 0;
+
+  ezUInt32* m_pSqTail = nullptr;
+  ezUInt32* m_pSqArray = nullptr;
+  ezUInt32 m_uiSqMask = 0;
+
+  ezUInt32* m_pCqHead = nullptr;
+  ezUInt32* m_pCqTail = nullptr;
+  ezUInt32 m_uiCqMask = 0;
+  io_uring_cqe* m_pCqes = nullptr;
+};
+
+#else
+
+#  define EZ_IO_URING_SUPPORTED EZ_OFF
+
+#endif
@@ -106,8 +106,9 @@ ezResult ezMemoryMappedFile::Open(const char* szAbsolutePath, Mode mode)
   m_Impl->m_uiFileSize = sb.st_size;
 
   m_Impl->m_pMappedFilePtr = mmap(nullptr, m_Impl->m_uiFileSize, prot, flags, m_Impl->m_hFile, 0);
-  if (m_Impl->m_pMappedFilePtr == nullptr)
+  if (m_Impl->m_pMappedFilePtr == MAP_FAILED)
   {
+    m_Impl->m_pMappedFilePtr = nullptr;
     ezLog::Error("Could not create memory mapping of file - {}", strerror(errno));
     Close();
     return EZ_FAILURE;
@@ -163,8 +164,9 @@ ezResult ezMemoryMappedFile::OpenShared(const char* szSharedName, ezUInt64 uiSiz
   m_Impl->m_uiFileSize = uiSize;
 
   m_Impl->m_pMappedFilePtr = mmap(nullptr, m_Impl->m_uiFileSize, prot, flags, m_Impl->m_hFile, 0);
-  if (m_Impl->m_pMappedFilePtr == nullptr)
+  if (m_Impl->m_pMappedFilePtr == MAP_FAILED)
   {
+    m_Impl->m_pMappedFilePtr = nullptr;
     ezLog::Error("Could not create memory mapping of file - {}", strerror(errno));
     Close();
     return EZ_FAILURE;
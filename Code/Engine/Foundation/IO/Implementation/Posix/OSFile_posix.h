@@ -150,6 +150,59 @@ ezUInt64 ezOSFile::InternalRead(void* pBuffer, ezUInt64 uiBytes)
   return uiBytesRead;
 }
 
+ezUInt64 ezOSFile::InternalReadAt(ezUInt64 uiFileOffset, void* pBuffer, ezUInt64 uiBytes, ezResult& out_Result) const
+{
+  out_Result = EZ_SUCCESS;
+
+#if EZ_ENABLED(EZ_USE_OLD_POSIX_FUNCTIONS)
+  // there is no pread, so the file position has to be moved and restored
+  static ezMutex s_ReadAtMutex;
+  EZ_LOCK(s_ReadAtMutex);
+
+  const ezUInt64 uiPrevPosition = InternalGetFilePosition();
+  InternalSetFilePosition(uiFileOffset, ezFileSeekMode::FromStart);
+  const ezUInt64 uiBytesRead = const_cast<ezOSFile*>(this)->InternalRead(pBuffer, uiBytes);
+
+  if (uiBytesRead < uiBytes && ferror(m_FileData.m_pFileHandle) != 0)
+  {
+    clearerr(m_FileData.m_pFileHandle);
+    out_Result = EZ_FAILURE;
+  }
+
+  InternalSetFilePosition(uiPrevPosition, ezFileSeekMode::FromStart);
+
+  return uiBytesRead;
+#else
+  const int fileNo = fileno(m_FileData.m_pFileHandle);
+
+  ezUInt64 uiBytesRead = 0;
+
+  const ezUInt32 uiBatchBytes = 1024 * 1024 * 1024; // 1 GB
+
+  while (uiBytes > 0)
+  {
+    const size_t uiBytesThisTime = static_cast<size_t>(ezMath::Min<ezUInt64>(uiBytes, uiBatchBytes));
+    const ssize_t iRes = pread(fileNo, pBuffer, uiBytesThisTime, static_cast<off_t>(uiFileOffset + uiBytesRead));
+
+    if (iRes < 0 && errno == EINTR)
+      continue;
+
+    if (iRes < 0)
+      out_Result = EZ_FAILURE;
+
+    if (iRes <= 0)
+      break;
+
+    // pread may return less than requested, without having reached the end of the file
+    uiBytesRead += static_cast<ezUInt64>(iRes);
+    uiBytes -= static_cast<ezUInt64>(iRes);
+    pBuffer = ezMemoryUtils::AddByteOffset(pBuffer, iRes);
+  }
+
+  return uiBytesRead;
+#endif
+}
+
 ezUInt64 ezOSFile::InternalGetFilePosition() const
 {
 #if EZ_ENABLED(EZ_USE_OLD_POSIX_FUNCTIONS)
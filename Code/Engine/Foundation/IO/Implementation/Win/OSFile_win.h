@@ -185,6 +185,46 @@ ezUInt64 ezOSFile::InternalRead(void* pBuffer, ezUInt64 uiBytes)
   return uiBytesRead;
 }
 
+ezUInt64 ezOSFile::InternalReadAt(ezUInt64 uiFileOffset, void* pBuffer, ezUInt64 uiBytes, ezResult& out_Result) const
+{
+  out_Result = EZ_SUCCESS;
+
+  ezUInt64 uiBytesRead = 0;
+
+  const ezUInt32 uiBatchBytes = 1024 * 1024 * 1024; // 1 GB
+
+  while (uiBytes > 0)
+  {
+    const ezUInt32 uiBytesThisTime = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(uiBytes, uiBatchBytes));
+    const ezUInt64 uiOffset = uiFileOffset + uiBytesRead;
+
+    // on a synchronous handle, an OVERLAPPED structure only specifies the position to read from
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = static_cast<DWORD>(uiOffset & 0xFFFFFFFFu);
+    overlapped.OffsetHigh = static_cast<DWORD>(uiOffset >> 32);
+
+    DWORD uiBytesReadThisTime = 0;
+    if (!ReadFile(m_FileData.m_pFileHandle, pBuffer, uiBytesThisTime, &uiBytesReadThisTime, &overlapped))
+    {
+      // reading at or beyond the end of the file fails with ERROR_HANDLE_EOF
+      if (GetLastError() != ERROR_HANDLE_EOF)
+        out_Result = EZ_FAILURE;
+
+      return uiBytesRead + uiBytesReadThisTime;
+    }
+
+    uiBytesRead += uiBytesReadThisTime;
+
+    if (uiBytesReadThisTime != uiBytesThisTime)
+      return uiBytesRead;
+
+    uiBytes -= uiBytesThisTime;
+    pBuffer = ezMemoryUtils::AddByteOffset(pBuffer, uiBytesThisTime);
+  }
+
+  return uiBytesRead;
+}
+
 ezUInt64 ezOSFile::InternalGetFilePosition() const
 {
   long int uiHigh32 = 0;
@@ -180,6 +180,13 @@ public:
   /// \brief Reads the entire file content into the given array
   ezUInt64 ReadAll(ezDynamicArray<ezUInt8>& out_FileContent); // [tested]
 
+  /// \brief Reads up to the given number of bytes at the absolute position \a uiFileOffset. Returns the actual number of bytes that was read.
+  ///
+  /// Multiple threads may read from the same file this way at the same time.
+  /// On Posix systems the file position is not affected, on Windows it is moved behind the read data.
+  /// If \a out_pResult is given, it is set to EZ_FAILURE when the OS reported an error. Reaching the end of the file is not an error.
+  ezUInt64 ReadAt(ezUInt64 uiFileOffset, void* pBuffer, ezUInt64 uiBytes, ezResult* out_pResult = nullptr) const; // [tested]
+
   /// \brief Returns the name of the file that is currently opened. Returns an empty string, if no file is open.
   const char* GetOpenFileName() const { return m_sFileName.GetData(); } // [tested]
 
@@ -343,15 +350,21 @@ public:
   static void RemoveEventHandler(Event::Handler handler) { s_FileEvents.RemoveEventHandler(handler); }
 
 private:
+  friend struct ezAsyncFileReaderImpl;
+
   /// \brief Manages all the Event Handlers for the OSFile events.
   static Event s_FileEvents;
 
+  /// \brief Sends the FileRead event. Also used by ezAsyncFileReader, for the reads that it hands to the OS directly.
+  void BroadcastReadEvent(ezUInt64 uiBytesRequested, ezUInt64 uiBytesRead, ezTime duration) const;
+
   // *** Internal Functions that do the platform specific work ***
 
   ezResult InternalOpen(const char* szFile, ezFileOpenMode::Enum OpenMode, ezFileShareMode::Enum FileShareMode);
   void InternalClose();
   ezResult InternalWrite(const void* pBuffer, ezUInt64 uiBytes);
   ezUInt64 InternalRead(void* pBuffer, ezUInt64 uiBytes);
+  ezUInt64 InternalReadAt(ezUInt64 uiFileOffset, void* pBuffer, ezUInt64 uiBytes, ezResult& out_Result) const;
   ezUInt64 InternalGetFilePosition() const;
   void InternalSetFilePosition(ezInt64 iDistance, ezFileSeekMode::Enum Pos) const;
 
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <Foundation/Memory/Allocator.h>
+#include <Foundation/Memory/Policies/ArenaAllocation.h>
+
+/// \brief An allocator for short-lived temporary data, typically the ezStringBuilder instances that are needed to assemble paths.
+///
+/// The first InlineSize bytes are taken from a buffer inside the allocator object, so when the allocator is a local variable,
+/// most temporaries never touch the heap. The default is enough for one path that does not fit into the inline storage of
+/// ezStringBuilder, and small enough to be used in nested calls on the small stacks of task worker threads.
+/// Everything is freed at once when the allocator goes out of scope or Reset() is called:
+///
+/// \code{.cpp}
+///   ezArenaAllocator<> arena;
+///   ezStringBuilder sPath(&arena);
+///   ezStringBuilder sRedirected(&arena);
+/// \endcode
+///
+/// Data that uses this allocator must not outlive it. Copying such a string into an ezString or an ezStringBuilder with another
+/// allocator is fine. The allocator is not thread-safe and, by default, not registered with the ezMemoryTracker, which makes it
+/// cheap to create.
+template <ezUInt32 InlineSize = 256, ezUInt32 TrackingFlags = ezMemoryTrackingFlags::None>
+class ezArenaAllocator : public ezAllocator<ezMemoryPolicies::ezArenaAllocation<InlineSize>, TrackingFlags>
+{
+public:
+  ezArenaAllocator(const char* szName = "Arena", ezAllocatorBase* pParent = ezFoundation::GetDefaultAllocator())
+    : ezAllocator<ezMemoryPolicies::ezArenaAllocation<InlineSize>, TrackingFlags>(szName, pParent)
+  {
+  }
+
+  /// \brief Frees all memory at once. Nothing that was allocated before must be used afterwards.
+  void Reset()
+  {
+    this->m_allocator.Reset();
+
+    if ((TrackingFlags & ezMemoryTrackingFlags::EnableAllocationTracking) != 0)
+    {
+      ezMemoryTracker::RemoveAllAllocations(this->m_Id);
+    }
+  }
+};
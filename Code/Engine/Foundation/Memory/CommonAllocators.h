@@ -9,6 +9,7 @@
 #include <Foundation/Memory/Policies/GuardedAllocation.h>
 #include <Foundation/Memory/Policies/HeapAllocation.h>
 #include <Foundation/Memory/Policies/ProxyAllocation.h>
+#include <Foundation/Memory/Policies/ScalableHeapAllocation.h>
 
 
 /// \brief Default heap allocator
@@ -22,3 +23,16 @@ typedef ezAllocator<ezMemoryPolicies::ezGuardedAllocation> ezGuardedAllocator;
 
 /// \brief Proxy allocator
 typedef ezAllocator<ezMemoryPolicies::ezProxyAllocation> ezProxyAllocator;
+
+/// \brief Scalable heap allocator with per-thread heaps, see ezMemoryPolicies::ezScalableHeapAllocation.
+///
+/// Statistics about its thread heaps are available through ezMemoryTracker::GetThreadCacheStats().
+class ezScalableHeapAllocator : public ezAllocator<ezMemoryPolicies::ezScalableHeapAllocation>
+{
+public:
+  ezScalableHeapAllocator(const char* szName, ezAllocatorBase* pParent = nullptr)
+    : ezAllocator<ezMemoryPolicies::ezScalableHeapAllocation>(szName, pParent)
+  {
+    this->m_allocator.SetAllocatorId(this->m_Id);
+  }
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/Memory/StackAllocator.h>
+#include <Foundation/Threading/AtomicInteger.h>
 
 /// \brief A double buffered stack allocator
 class EZ_FOUNDATION_DLL ezDoubleBufferedStackAllocator
@@ -21,12 +22,68 @@ private:
   StackAllocatorType* m_pOtherAllocator;
 };
 
+/// \brief Keeps the allocations of the last N frames alive, using one stack allocator per frame.
+///
+/// The allocator of a frame is reset when the ring buffer wraps around to it again. Use ezNoMutex as MutexType
+/// if the allocator is only used by a single thread.
+template <typename MutexType>
+class ezRingBufferedStackAllocator
+{
+public:
+  typedef ezStackAllocator<ezMemoryTrackingFlags::RegisterAllocator, MutexType> StackAllocatorType;
+
+  ezRingBufferedStackAllocator(const char* szName, ezAllocatorBase* pParent, ezUInt32 uiNumFrames);
+  ~ezRingBufferedStackAllocator();
+
+  EZ_ALWAYS_INLINE ezUInt32 GetNumFrames() const { return m_Allocators.GetCount(); }
+
+  /// \brief Returns the allocator of the given frame, the frame index wraps around.
+  EZ_ALWAYS_INLINE StackAllocatorType* GetAllocator(ezUInt32 uiFrame) const { return m_Allocators[uiFrame % m_Allocators.GetCount()]; }
+
+  /// \brief Frees all allocations that were made in the given frame.
+  void ResetFrame(ezUInt32 uiFrame, bool bPoisonMemory);
+
+  /// \brief Frees all allocations of all frames.
+  void Reset(bool bPoisonMemory);
+
+private:
+  ezHybridArray<StackAllocatorType*, 4> m_Allocators;
+};
+
+/// \brief Allocators for data that only has to stay alive for a few frames, e.g. extracted render data.
+///
+/// Allocations made in a frame stay alive until the allocators of that frame are reused, which happens GetFrameLifetime() frames later.
+/// Nothing has to be deallocated individually.
 class EZ_FOUNDATION_DLL ezFrameAllocator
 {
 public:
-  EZ_ALWAYS_INLINE static ezAllocatorBase* GetCurrentAllocator() { return s_pAllocator->GetCurrentAllocator(); }
+  /// \brief Returns the allocator of the current frame, which is shared by all threads.
+  EZ_ALWAYS_INLINE static ezAllocatorBase* GetCurrentAllocator() { return s_pAllocator->GetAllocator(s_iCurrentFrame); }
+
+  /// \brief Returns the allocator of the current frame that belongs to the calling thread.
+  ///
+  /// Allocating from it needs no locks, which makes it the right choice for temporary data that tasks produce.
+  /// The memory may be handed to other threads, but the returned allocator itself must only be used on the calling thread.
+  static ezAllocatorBase* GetCurrentThreadAllocator();
 
+  /// \brief Sets for how many frames allocations stay alive, e.g. 3 for triple buffered rendering. The default is 2.
+  ///
+  /// This frees all frame allocations, so it should only be called while no frame data is in use, e.g. during startup.
+  static void SetFrameLifetime(ezUInt32 uiNumFrames);
+  static ezUInt32 GetFrameLifetime() { return s_uiFrameLifetime; }
+
+  /// \brief Sets whether memory is overwritten with a pattern when it is freed, to catch accesses to frame data that is not alive anymore.
+  ///
+  /// Enabled by default in debug builds.
+  static void SetPoisonMemoryOnReset(bool bPoison) { s_bPoisonMemoryOnReset = bPoison; }
+  static bool GetPoisonMemoryOnReset() { return s_bPoisonMemoryOnReset; }
+
+  /// \brief Advances to the next frame and frees the allocations that were made GetFrameLifetime() frames ago.
+  ///
+  /// Should be called once per frame, while no tasks use the frame allocators.
   static void Swap();
+
+  /// \brief Frees the allocations of all frames.
   static void Reset();
 
 private:
@@ -35,5 +92,10 @@ private:
   static void Startup();
   static void Shutdown();
 
-  static ezDoubleBufferedStackAllocator* s_pAllocator;
+  static ezRingBufferedStackAllocator<ezMutex>* s_pAllocator;
+  static ezAtomicInteger32 s_iCurrentFrame;
+  static ezUInt32 s_uiFrameLifetime;
+  static bool s_bPoisonMemoryOnReset;
 };
+
+#include <Foundation/Memory/Implementation/FrameAllocator_inl.h>
@@ -54,14 +54,129 @@ EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, FrameAllocator)
 EZ_END_SUBSYSTEM_DECLARATION;
 // clang-format on
 
-ezDoubleBufferedStackAllocator* ezFrameAllocator::s_pAllocator;
+namespace
+{
+  typedef ezRingBufferedStackAllocator<ezNoMutex> ezThreadFrameAllocatorRing;
+
+  struct ezThreadFrameAllocatorEntry
+  {
+    ezThreadFrameAllocatorRing* m_pRing = nullptr;
+
+    // 0 while the owning thread is alive, afterwards the number of frames until the last allocations of the thread expire
+    ezUInt32 m_uiFramesUntilDelete = 0;
+    bool m_bThreadExited = false;
+  };
+
+  struct ezThreadFrameAllocatorData
+  {
+    ezMutex m_Mutex;
+    ezDynamicArray<ezThreadFrameAllocatorEntry> m_Entries;
+    ezUInt32 m_uiNextThreadIndex = 0;
+  };
+
+  static ezThreadFrameAllocatorData* s_pThreadFrameAllocatorData = nullptr;
+
+  // incremented on every startup, so that threads notice when their allocators were deleted by a shutdown
+  static ezUInt32 s_uiFrameAllocatorGeneration = 0;
+
+  struct ezThreadFrameAllocatorHandle
+  {
+    ~ezThreadFrameAllocatorHandle()
+    {
+      if (m_pRing == nullptr || m_uiGeneration != s_uiFrameAllocatorGeneration || s_pThreadFrameAllocatorData == nullptr)
+        return;
+
+      // other threads may still use the data that this thread allocated, so the allocators are only deleted once it expired
+      EZ_LOCK(s_pThreadFrameAllocatorData->m_Mutex);
+
+      for (ezThreadFrameAllocatorEntry& entry : s_pThreadFrameAllocatorData->m_Entries)
+      {
+        if (entry.m_pRing == m_pRing)
+        {
+          entry.m_bThreadExited = true;
+          entry.m_uiFramesUntilDelete = m_pRing->GetNumFrames();
+        }
+      }
+    }
+
+    ezThreadFrameAllocatorRing* m_pRing = nullptr;
+    ezUInt32 m_uiGeneration = 0;
+  };
+
+  static thread_local ezThreadFrameAllocatorHandle s_ThreadFrameAllocator;
+} // namespace
+
+ezRingBufferedStackAllocator<ezMutex>* ezFrameAllocator::s_pAllocator;
+ezAtomicInteger32 ezFrameAllocator::s_iCurrentFrame;
+ezUInt32 ezFrameAllocator::s_uiFrameLifetime = 2;
+bool ezFrameAllocator::s_bPoisonMemoryOnReset = EZ_ENABLED(EZ_COMPILE_FOR_DEBUG);
+
+// static
+ezAllocatorBase* ezFrameAllocator::GetCurrentThreadAllocator()
+{
+  ezThreadFrameAllocatorHandle& handle = s_ThreadFrameAllocator;
+
+  if (handle.m_pRing == nullptr || handle.m_uiGeneration != s_uiFrameAllocatorGeneration)
+  {
+    EZ_LOCK(s_pThreadFrameAllocatorData->m_Mutex);
+
+    ezStringBuilder sName;
+    sName.Format("ThreadFrameAllocator{}_", s_pThreadFrameAllocatorData->m_uiNextThreadIndex++);
+
+    ezThreadFrameAllocatorEntry& entry = s_pThreadFrameAllocatorData->m_Entries.ExpandAndGetRef();
+    entry.m_pRing = EZ_DEFAULT_NEW(ezThreadFrameAllocatorRing, sName, ezFoundation::GetAlignedAllocator(), s_uiFrameLifetime);
+
+    handle.m_pRing = entry.m_pRing;
+    handle.m_uiGeneration = s_uiFrameAllocatorGeneration;
+  }
+
+  return handle.m_pRing->GetAllocator(s_iCurrentFrame);
+}
+
+// static
+void ezFrameAllocator::SetFrameLifetime(ezUInt32 uiNumFrames)
+{
+  EZ_ASSERT_DEV(uiNumFrames >= 1, "Frame allocations have to stay alive for at least one frame");
+
+  s_uiFrameLifetime = uiNumFrames;
+
+  if (s_pAllocator != nullptr)
+  {
+    Shutdown();
+    Startup();
+  }
+}
 
 // static
 void ezFrameAllocator::Swap()
 {
   EZ_PROFILE_SCOPE("FrameAllocator.Swap");
 
-  s_pAllocator->Swap();
+  // the allocators of the next frame have to be reset before any thread can see the new frame index
+  const ezUInt32 uiNextFrame = (static_cast<ezUInt32>(s_iCurrentFrame) + 1) % s_uiFrameLifetime;
+
+  s_pAllocator->ResetFrame(uiNextFrame, s_bPoisonMemoryOnReset);
+
+  {
+    EZ_LOCK(s_pThreadFrameAllocatorData->m_Mutex);
+
+    auto& entries = s_pThreadFrameAllocatorData->m_Entries;
+    for (ezUInt32 i = entries.GetCount(); i-- > 0;)
+    {
+      ezThreadFrameAllocatorEntry& entry = entries[i];
+
+      if (entry.m_bThreadExited && --entry.m_uiFramesUntilDelete == 0)
+      {
+        EZ_DEFAULT_DELETE(entry.m_pRing);
+        entries.RemoveAtAndSwap(i);
+        continue;
+      }
+
+      entry.m_pRing->ResetFrame(uiNextFrame, s_bPoisonMemoryOnReset);
+    }
+  }
+
+  s_iCurrentFrame = static_cast<ezInt32>(uiNextFrame);
 }
 
 // static
@@ -69,19 +184,36 @@ void ezFrameAllocator::Reset()
 {
   if (s_pAllocator)
   {
-    s_pAllocator->Reset();
+    s_pAllocator->Reset(s_bPoisonMemoryOnReset);
+
+    EZ_LOCK(s_pThreadFrameAllocatorData->m_Mutex);
+
+    for (ezThreadFrameAllocatorEntry& entry : s_pThreadFrameAllocatorData->m_Entries)
+    {
+      entry.m_pRing->Reset(s_bPoisonMemoryOnReset);
+    }
   }
 }
 
 // static
 void ezFrameAllocator::Startup()
 {
-  s_pAllocator = EZ_DEFAULT_NEW(ezDoubleBufferedStackAllocator, "FrameAllocator", ezFoundation::GetAlignedAllocator());
+  ++s_uiFrameAllocatorGeneration;
+  s_iCurrentFrame = 0;
+
+  s_pAllocator = EZ_DEFAULT_NEW(ezRingBufferedStackAllocator<ezMutex>, "FrameAllocator", ezFoundation::GetAlignedAllocator(), s_uiFrameLifetime);
+  s_pThreadFrameAllocatorData = EZ_DEFAULT_NEW(ezThreadFrameAllocatorData);
 }
 
 // static
 void ezFrameAllocator::Shutdown()
 {
+  for (ezThreadFrameAllocatorEntry& entry : s_pThreadFrameAllocatorData->m_Entries)
+  {
+    EZ_DEFAULT_DELETE(entry.m_pRing);
+  }
+
+  EZ_DEFAULT_DELETE(s_pThreadFrameAllocatorData);
   EZ_DEFAULT_DELETE(s_pAllocator);
 }
 
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <Foundation/Strings/StringBuilder.h>
+
+template <typename MutexType>
+ezRingBufferedStackAllocator<MutexType>::ezRingBufferedStackAllocator(const char* szName, ezAllocatorBase* pParent, ezUInt32 uiNumFrames)
+{
+  EZ_ASSERT_DEV(uiNumFrames >= 1, "At least one frame is required");
+
+  ezStringBuilder sName;
+  for (ezUInt32 i = 0; i < uiNumFrames; ++i)
+  {
+    sName.Format("{}{}", szName, i);
+    m_Allocators.PushBack(EZ_DEFAULT_NEW(StackAllocatorType, sName, pParent));
+  }
+}
+
+template <typename MutexType>
+ezRingBufferedStackAllocator<MutexType>::~ezRingBufferedStackAllocator()
+{
+  for (StackAllocatorType* pAllocator : m_Allocators)
+  {
+    EZ_DEFAULT_DELETE(pAllocator);
+  }
+}
+
+template <typename MutexType>
+void ezRingBufferedStackAllocator<MutexType>::ResetFrame(ezUInt32 uiFrame, bool bPoisonMemory)
+{
+  GetAllocator(uiFrame)->Reset(bPoisonMemory);
+}
+
+template <typename MutexType>
+void ezRingBufferedStackAllocator<MutexType>::Reset(bool bPoisonMemory)
+{
+  for (StackAllocatorType* pAllocator : m_Allocators)
+  {
+    pAllocator->Reset(bPoisonMemory);
+  }
+}
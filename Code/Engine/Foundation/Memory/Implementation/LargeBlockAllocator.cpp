@@ -0,0 +1,63 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Memory/LargeBlockAllocator.h>
+#include <Foundation/Threading/AtomicInteger.h>
+
+EZ_CHECK_AT_COMPILETIME_MSG(ezLargeBlockAllocatorThreadCacheIndex::MAX_THREADS <= 64, "The used indices are stored in a 64 bit mask");
+
+namespace
+{
+  // one bit for every index that is held by a running thread
+  static ezAtomicInteger64 s_iUsedLargeBlockThreadCacheIndices;
+
+  struct ezLargeBlockThreadCacheIndex
+  {
+    ezLargeBlockThreadCacheIndex()
+    {
+      while (true)
+      {
+        const ezUInt64 uiUsed = static_cast<ezUInt64>(static_cast<ezInt64>(s_iUsedLargeBlockThreadCacheIndices));
+
+        ezUInt32 uiIndex = 0;
+        while (uiIndex < ezLargeBlockAllocatorThreadCacheIndex::MAX_THREADS && (uiUsed & (1ull << uiIndex)) != 0)
+        {
+          ++uiIndex;
+        }
+
+        // all caches are taken, this thread uses the shared free lists directly
+        if (uiIndex == ezLargeBlockAllocatorThreadCacheIndex::MAX_THREADS)
+          return;
+
+        if (s_iUsedLargeBlockThreadCacheIndices.TestAndSet(static_cast<ezInt64>(uiUsed), static_cast<ezInt64>(uiUsed | (1ull << uiIndex))))
+        {
+          m_uiIndex = uiIndex;
+          return;
+        }
+      }
+    }
+
+    ~ezLargeBlockThreadCacheIndex()
+    {
+      if (m_uiIndex == ezInvalidIndex)
+        return;
+
+      // blocks that are still freed during thread shutdown go to the shared free list,
+      // the blocks in the cache stay there and are used by the next thread that gets this index
+      const ezUInt64 uiMask = 1ull << m_uiIndex;
+      m_uiIndex = ezInvalidIndex;
+      s_iUsedLargeBlockThreadCacheIndices.And(static_cast<ezInt64>(~uiMask));
+    }
+
+    ezUInt32 m_uiIndex = ezInvalidIndex;
+  };
+
+  thread_local ezLargeBlockThreadCacheIndex tl_LargeBlockThreadCacheIndex;
+} // namespace
+
+// static
+ezUInt32 ezLargeBlockAllocatorThreadCacheIndex::GetCurrentThreadIndex()
+{
+  return tl_LargeBlockThreadCacheIndex.m_uiIndex;
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Memory_Implementation_LargeBlockAllocator);
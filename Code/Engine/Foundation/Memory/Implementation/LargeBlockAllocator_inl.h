@@ -65,9 +65,10 @@ ezLargeBlockAllocator<BlockSize>::~ezLargeBlockAllocator()
   EZ_ASSERT_RELEASE(m_ThreadID == ezThreadUtils::GetCurrentThreadID(), "Allocator is deleted from another thread");
   ezMemoryTracker::DeregisterAllocator(m_Id);
 
+  // the blocks in the thread caches belong to the super blocks, so they don't need to be returned individually
   for (ezUInt32 i = 0; i < m_superBlocks.GetCount(); ++i)
   {
-    ezPageAllocator::DeallocatePage(m_superBlocks[i].m_pBasePtr);
+    ezPageAllocator::DeallocatePage(m_superBlocks[i].m_pBasePtr, SuperBlock::SIZE_IN_BYTES);
   }
 }
 
@@ -112,11 +113,39 @@ EZ_ALWAYS_INLINE ezAllocatorId ezLargeBlockAllocator<BlockSize>::GetId() const
 }
 
 template <ezUInt32 BlockSize>
-EZ_ALWAYS_INLINE const ezAllocatorBase::Stats& ezLargeBlockAllocator<BlockSize>::GetStats() const
+EZ_ALWAYS_INLINE ezAllocatorBase::Stats ezLargeBlockAllocator<BlockSize>::GetStats() const
 {
   return ezMemoryTracker::GetAllocatorStats(m_Id);
 }
 
+template <ezUInt32 BlockSize>
+void ezLargeBlockAllocator<BlockSize>::SetThreadCacheSize(ezUInt32 uiMaxBlocksPerCache)
+{
+  EZ_ASSERT_DEV(uiMaxBlocksPerCache <= MAX_THREAD_CACHE_SIZE, "The thread cache size is limited to {0} blocks", (ezUInt32)MAX_THREAD_CACHE_SIZE);
+
+  {
+    EZ_LOCK(m_mutex);
+    m_uiThreadCacheSize = ezMath::Min<ezUInt32>(uiMaxBlocksPerCache, MAX_THREAD_CACHE_SIZE);
+  }
+
+  FlushThreadCaches();
+}
+
+template <ezUInt32 BlockSize>
+EZ_ALWAYS_INLINE ezUInt32 ezLargeBlockAllocator<BlockSize>::GetThreadCacheSize() const
+{
+  return m_uiThreadCacheSize;
+}
+
+template <ezUInt32 BlockSize>
+void ezLargeBlockAllocator<BlockSize>::FlushThreadCaches()
+{
+  for (ThreadCache& cache : m_ThreadCaches)
+  {
+    FlushThreadCache(cache, 0);
+  }
+}
+
 template <ezUInt32 BlockSize>
 void* ezLargeBlockAllocator<BlockSize>::Allocate(size_t uiAlign)
 {
@@ -124,8 +153,117 @@ void* ezLargeBlockAllocator<BlockSize>::Allocate(size_t uiAlign)
 
   ezTime fAllocationTime = ezTime::Now();
 
+  void* ptr = nullptr;
+
+  const ezUInt32 uiCacheIndex = m_uiThreadCacheSize > 0 ? ezLargeBlockAllocatorThreadCacheIndex::GetCurrentThreadIndex() : ezInvalidIndex;
+
+  if (uiCacheIndex != ezInvalidIndex)
+  {
+    // only this thread uses this cache, the shared free list is only locked to refill it
+    ThreadCache& cache = m_ThreadCaches[uiCacheIndex];
+
+    if (cache.m_uiNumBlocks == 0)
+    {
+      RefillThreadCache(cache, uiAlign);
+    }
+    else
+    {
+      ++cache.m_uiNumHits;
+    }
+
+    ptr = cache.m_Blocks[--cache.m_uiNumBlocks];
+    EZ_CHECK_ALIGNMENT(ptr, uiAlign);
+  }
+  else
+  {
+    EZ_LOCK(m_mutex);
+    ptr = AllocateFromFreeList(uiAlign);
+  }
+
+  ezMemoryTracker::AddAllocation(m_Id, m_TrackingFlags, ptr, BlockSize, uiAlign, ezTime::Now() - fAllocationTime);
+
+  return ptr;
+}
+
+template <ezUInt32 BlockSize>
+void ezLargeBlockAllocator<BlockSize>::Deallocate(void* ptr)
+{
+  ezMemoryTracker::RemoveAllocation(m_Id, ptr);
+
+  const ezUInt32 uiCacheIndex = m_uiThreadCacheSize > 0 ? ezLargeBlockAllocatorThreadCacheIndex::GetCurrentThreadIndex() : ezInvalidIndex;
+
+  if (uiCacheIndex != ezInvalidIndex)
+  {
+    ThreadCache& cache = m_ThreadCaches[uiCacheIndex];
+
+    if (cache.m_uiNumBlocks >= m_uiThreadCacheSize)
+    {
+      // keep half of the blocks, so that alternating allocations and deallocations don't hit the shared free list every time
+      FlushThreadCache(cache, m_uiThreadCacheSize / 2);
+    }
+
+    cache.m_Blocks[cache.m_uiNumBlocks++] = ptr;
+  }
+  else
+  {
+    EZ_LOCK(m_mutex);
+    DeallocateToFreeList(ptr);
+  }
+}
+
+template <ezUInt32 BlockSize>
+void ezLargeBlockAllocator<BlockSize>::RefillThreadCache(ThreadCache& cache, size_t uiAlign)
+{
   EZ_LOCK(m_mutex);
 
+  // take half a cache worth of blocks at once, so that the next allocations don't need the shared free list
+  const ezUInt32 uiNumBlocks = ezMath::Max<ezUInt32>(1, m_uiThreadCacheSize / 2);
+
+  while (cache.m_uiNumBlocks < uiNumBlocks)
+  {
+    cache.m_Blocks[cache.m_uiNumBlocks++] = AllocateFromFreeList(uiAlign);
+  }
+
+  ++m_ThreadCacheStats.m_uiNumMisses;
+  UpdateThreadCacheStats(cache);
+}
+
+template <ezUInt32 BlockSize>
+void ezLargeBlockAllocator<BlockSize>::FlushThreadCache(ThreadCache& cache, ezUInt32 uiBlocksToKeep)
+{
+  EZ_LOCK(m_mutex);
+
+  if (cache.m_uiNumBlocks > uiBlocksToKeep)
+  {
+    while (cache.m_uiNumBlocks > uiBlocksToKeep)
+    {
+      DeallocateToFreeList(cache.m_Blocks[--cache.m_uiNumBlocks]);
+    }
+
+    ++m_ThreadCacheStats.m_uiNumFlushes;
+  }
+
+  UpdateThreadCacheStats(cache);
+}
+
+template <ezUInt32 BlockSize>
+void ezLargeBlockAllocator<BlockSize>::UpdateThreadCacheStats(ThreadCache& cache)
+{
+  // Called with m_mutex locked. The hits and the cached size of each cache are only collected here,
+  // so that the fast path doesn't need to touch any shared data.
+  m_ThreadCacheStats.m_uiNumHits += cache.m_uiNumHits;
+  m_ThreadCacheStats.m_uiCachedSize -= static_cast<ezUInt64>(cache.m_uiReportedBlocks) * BlockSize;
+  m_ThreadCacheStats.m_uiCachedSize += static_cast<ezUInt64>(cache.m_uiNumBlocks) * BlockSize;
+
+  cache.m_uiNumHits = 0;
+  cache.m_uiReportedBlocks = cache.m_uiNumBlocks;
+
+  ezMemoryTracker::SetThreadCacheStats(m_Id, m_ThreadCacheStats);
+}
+
+template <ezUInt32 BlockSize>
+void* ezLargeBlockAllocator<BlockSize>::AllocateFromFreeList(size_t uiAlign)
+{
   void* ptr = nullptr;
 
   if (!m_freeBlocks.IsEmpty())
@@ -162,18 +300,12 @@ void* ezLargeBlockAllocator<BlockSize>::Allocate(size_t uiAlign)
     ptr = pMemory;
   }
 
-  ezMemoryTracker::AddAllocation(m_Id, m_TrackingFlags, ptr, BlockSize, uiAlign, ezTime::Now() - fAllocationTime);
-
   return ptr;
 }
 
 template <ezUInt32 BlockSize>
-void ezLargeBlockAllocator<BlockSize>::Deallocate(void* ptr)
+void ezLargeBlockAllocator<BlockSize>::DeallocateToFreeList(void* ptr)
 {
-  EZ_LOCK(m_mutex);
-
-  ezMemoryTracker::RemoveAllocation(m_Id, ptr);
-
   // find super block
   bool bFound = false;
   ezUInt32 uiSuperBlockIndex = m_superBlocks.GetCount();
@@ -197,7 +329,7 @@ void ezLargeBlockAllocator<BlockSize>::Deallocate(void* ptr)
   if (superBlock.m_uiUsedBlocks == 0 && m_freeBlocks.GetCount() > SuperBlock::NUM_BLOCKS * 4)
   {
     // give memory back
-    ezPageAllocator::DeallocatePage(superBlock.m_pBasePtr);
+    ezPageAllocator::DeallocatePage(superBlock.m_pBasePtr, SuperBlock::SIZE_IN_BYTES);
 
     m_superBlocks.RemoveAtAndSwap(uiSuperBlockIndex);
     const ezUInt32 uiLastSuperBlockIndex = m_superBlocks.GetCount();
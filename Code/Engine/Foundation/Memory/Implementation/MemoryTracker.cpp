@@ -7,6 +7,7 @@
 #include <Foundation/Memory/Policies/HeapAllocation.h>
 #include <Foundation/Strings/String.h>
 #include <Foundation/System/StackTracer.h>
+#include <Foundation/Threading/AtomicInteger.h>
 #include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/Mutex.h>
 
@@ -27,6 +28,26 @@ namespace
   };
 
 
+  // The live allocations of every allocator are spread over several tables by pointer hash, each with its own lock.
+  // That way threads that allocate concurrently rarely wait for each other, even when they use the same allocator.
+  static constexpr ezUInt32 s_uiNumAllocationShards = 16;
+
+  // allocators whose id index is below this are found without taking the global lock
+  static constexpr ezUInt32 s_uiMaxDirectAllocatorLookups = 4096;
+
+  static ezAtomicInteger32 s_iStackTraceSampleRate(1);
+  static thread_local ezUInt32 s_uiAllocationsUntilStackTrace = 0;
+
+  struct AllocationShard
+  {
+    EZ_ALWAYS_INLINE void Lock() { m_Mutex.Lock(); }
+    EZ_ALWAYS_INLINE void Unlock() { m_Mutex.Unlock(); }
+
+    ezMutex m_Mutex;
+    ezAllocatorBase::Stats m_Stats;
+    ezHashTable<const void*, ezMemoryTracker::AllocationInfo, ezHashHelper<const void*>, TrackerDataAllocatorWrapper> m_Allocations;
+  };
+
   struct AllocatorData
   {
     EZ_ALWAYS_INLINE AllocatorData() {}
@@ -34,11 +55,38 @@ namespace
     ezHybridString<32, TrackerDataAllocatorWrapper> m_sName;
     ezBitflags<ezMemoryTrackingFlags> m_Flags;
 
+    ezAllocatorId m_Id;
     ezAllocatorId m_ParentId;
 
-    ezAllocatorBase::Stats m_Stats;
+    ezAllocatorBase::Stats m_Stats; // set through SetAllocatorStats
+    ezMemoryTracker::ThreadCacheStats m_ThreadCacheStats;
 
-    ezHashTable<const void*, ezMemoryTracker::AllocationInfo, ezHashHelper<const void*>, TrackerDataAllocatorWrapper> m_Allocations;
+    AllocationShard m_Shards[s_uiNumAllocationShards];
+
+    EZ_ALWAYS_INLINE AllocationShard& GetShard(const void* ptr)
+    {
+      // the lowest bits are mostly zero due to alignment, multiplying with a large odd constant mixes them into the upper bits
+      const ezUInt64 uiHash = (static_cast<ezUInt64>(reinterpret_cast<size_t>(ptr)) >> 4) * 0x9E3779B97F4A7C15ull;
+      return m_Shards[(uiHash >> 32) % s_uiNumAllocationShards];
+    }
+
+    /// \brief Returns m_Stats plus the stats of all shards. The global lock must be held, so that m_Stats is not modified concurrently.
+    ezAllocatorBase::Stats ComputeCombinedStats()
+    {
+      ezAllocatorBase::Stats combined = m_Stats;
+
+      for (AllocationShard& shard : m_Shards)
+      {
+        EZ_LOCK(shard);
+        combined.m_uiNumAllocations += shard.m_Stats.m_uiNumAllocations;
+        combined.m_uiNumDeallocations += shard.m_Stats.m_uiNumDeallocations;
+        combined.m_uiAllocationSize += shard.m_Stats.m_uiAllocationSize;
+        combined.m_uiPerFrameAllocationSize += shard.m_Stats.m_uiPerFrameAllocationSize;
+        combined.m_PerFrameAllocationTime += shard.m_Stats.m_PerFrameAllocationTime;
+      }
+
+      return combined;
+    }
   };
 
   struct TrackerData
@@ -48,9 +96,13 @@ namespace
 
     ezMutex m_Mutex;
 
-    typedef ezIdTable<ezAllocatorId, AllocatorData, TrackerDataAllocatorWrapper> AllocatorTable;
+    typedef ezIdTable<ezAllocatorId, AllocatorData*, TrackerDataAllocatorWrapper> AllocatorTable;
     AllocatorTable m_AllocatorData;
 
+    // The allocator data never moves in memory once it is registered, and an allocator cannot be deregistered while it is still
+    // in use. So this table can be read without locking, it is only written while the global lock is held.
+    AllocatorData* m_DirectAllocatorLookup[s_uiMaxDirectAllocatorLookups] = {};
+
     ezAllocatorId m_StaticAllocatorId;
   };
 
@@ -84,6 +136,19 @@ namespace
     s_bIsInitializing = false;
   }
 
+  static AllocatorData& GetAllocatorData(ezAllocatorId allocatorId)
+  {
+    if (allocatorId.m_InstanceIndex < s_uiMaxDirectAllocatorLookups)
+    {
+      AllocatorData* pData = s_pTrackerData->m_DirectAllocatorLookup[allocatorId.m_InstanceIndex];
+      EZ_ASSERT_DEBUG(pData != nullptr && pData->m_Id == allocatorId, "Invalid allocator id");
+      return *pData;
+    }
+
+    EZ_LOCK(*s_pTrackerData);
+    return *s_pTrackerData->m_AllocatorData[allocatorId];
+  }
+
   static void DumpLeak(const ezMemoryTracker::AllocationInfo& info, const char* szAllocatorName)
   {
     char szBuffer[512];
@@ -111,17 +176,19 @@ ezAllocatorId ezMemoryTracker::Iterator::Id() const
 
 const char* ezMemoryTracker::Iterator::Name() const
 {
-  return CAST_ITER(m_pData)->Value().m_sName.GetData();
+  return CAST_ITER(m_pData)->Value()->m_sName.GetData();
 }
 
 ezAllocatorId ezMemoryTracker::Iterator::ParentId() const
 {
-  return CAST_ITER(m_pData)->Value().m_ParentId;
+  return CAST_ITER(m_pData)->Value()->m_ParentId;
 }
 
-const ezAllocatorBase::Stats& ezMemoryTracker::Iterator::Stats() const
+ezAllocatorBase::Stats ezMemoryTracker::Iterator::Stats() const
 {
-  return CAST_ITER(m_pData)->Value().m_Stats;
+  EZ_LOCK(*s_pTrackerData);
+
+  return CAST_ITER(m_pData)->Value()->ComputeCombinedStats();
 }
 
 void ezMemoryTracker::Iterator::Next()
@@ -149,14 +216,20 @@ ezAllocatorId ezMemoryTracker::RegisterAllocator(const char* szName, ezBitflags<
 
   EZ_LOCK(*s_pTrackerData);
 
-  AllocatorData data;
-  data.m_sName = szName;
-  data.m_Flags = flags;
-  data.m_ParentId = parentId;
+  AllocatorData* pData = EZ_NEW(s_pTrackerDataAllocator, AllocatorData);
+  pData->m_sName = szName;
+  pData->m_Flags = flags;
+  pData->m_ParentId = parentId;
 
-  ezAllocatorId id = s_pTrackerData->m_AllocatorData.Insert(data);
+  ezAllocatorId id = s_pTrackerData->m_AllocatorData.Insert(pData);
+  pData->m_Id = id;
+
+  if (id.m_InstanceIndex < s_uiMaxDirectAllocatorLookups)
+  {
+    s_pTrackerData->m_DirectAllocatorLookup[id.m_InstanceIndex] = pData;
+  }
 
-  if (data.m_sName == EZ_STATIC_ALLOCATOR_NAME)
+  if (pData->m_sName == EZ_STATIC_ALLOCATOR_NAME)
   {
     s_pTrackerData->m_StaticAllocatorId = id;
   }
@@ -169,20 +242,33 @@ void ezMemoryTracker::DeregisterAllocator(ezAllocatorId allocatorId)
 {
   EZ_LOCK(*s_pTrackerData);
 
-  const AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
+  AllocatorData* pData = s_pTrackerData->m_AllocatorData[allocatorId];
 
-  ezUInt32 uiLiveAllocations = data.m_Allocations.GetCount();
-  if (uiLiveAllocations != 0)
+  ezUInt32 uiLiveAllocations = 0;
+  for (AllocationShard& shard : pData->m_Shards)
   {
-    for (auto it = data.m_Allocations.GetIterator(); it.IsValid(); ++it)
+    EZ_LOCK(shard);
+
+    for (auto it = shard.m_Allocations.GetIterator(); it.IsValid(); ++it)
     {
-      DumpLeak(it.Value(), data.m_sName.GetData());
+      DumpLeak(it.Value(), pData->m_sName.GetData());
     }
 
-    EZ_REPORT_FAILURE("Allocator '{0}' leaked {1} allocation(s)", data.m_sName.GetData(), uiLiveAllocations);
+    uiLiveAllocations += shard.m_Allocations.GetCount();
+  }
+
+  if (uiLiveAllocations != 0)
+  {
+    EZ_REPORT_FAILURE("Allocator '{0}' leaked {1} allocation(s)", pData->m_sName.GetData(), uiLiveAllocations);
+  }
+
+  if (allocatorId.m_InstanceIndex < s_uiMaxDirectAllocatorLookups)
+  {
+    s_pTrackerData->m_DirectAllocatorLookup[allocatorId.m_InstanceIndex] = nullptr;
   }
 
   s_pTrackerData->m_AllocatorData.Remove(allocatorId);
+  EZ_DELETE(s_pTrackerDataAllocator, pData);
 }
 
 // static
@@ -194,29 +280,36 @@ void ezMemoryTracker::AddAllocation(
   ezArrayPtr<void*> stackTrace;
   if (flags.IsSet(ezMemoryTrackingFlags::EnableStackTrace))
   {
-    void* pBuffer[64];
-    ezArrayPtr<void*> tempTrace(pBuffer);
-    const ezUInt32 uiNumTraces = ezStackTracer::GetStackTrace(tempTrace);
+    if (s_uiAllocationsUntilStackTrace == 0)
+    {
+      s_uiAllocationsUntilStackTrace = static_cast<ezUInt32>(s_iStackTraceSampleRate);
 
-    stackTrace = EZ_NEW_ARRAY(s_pTrackerDataAllocator, void*, uiNumTraces);
-    ezMemoryUtils::Copy(stackTrace.GetPtr(), pBuffer, uiNumTraces);
-  }
+      void* pBuffer[64];
+      ezArrayPtr<void*> tempTrace(pBuffer);
+      const ezUInt32 uiNumTraces = ezStackTracer::GetStackTrace(tempTrace);
 
-  {
-    EZ_LOCK(*s_pTrackerData);
+      stackTrace = EZ_NEW_ARRAY(s_pTrackerDataAllocator, void*, uiNumTraces);
+      ezMemoryUtils::Copy(stackTrace.GetPtr(), pBuffer, uiNumTraces);
+    }
 
-    AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
-    data.m_Stats.m_uiNumAllocations++;
-    data.m_Stats.m_uiAllocationSize += uiSize;
-    data.m_Stats.m_uiPerFrameAllocationSize += uiSize;
-    data.m_Stats.m_PerFrameAllocationTime += allocationTime;
-
-    EZ_ASSERT_DEBUG(data.m_Flags == flags, "Given flags have to be identical to allocator flags");
-    auto pInfo = &data.m_Allocations[ptr];
-    pInfo->m_uiSize = uiSize;
-    pInfo->m_uiAlignment = (ezUInt16)uiAlign;
-    pInfo->SetStackTrace(stackTrace);
+    --s_uiAllocationsUntilStackTrace;
   }
+
+  AllocatorData& data = GetAllocatorData(allocatorId);
+  EZ_ASSERT_DEBUG(data.m_Flags == flags, "Given flags have to be identical to allocator flags");
+
+  AllocationShard& shard = data.GetShard(ptr);
+  EZ_LOCK(shard);
+
+  shard.m_Stats.m_uiNumAllocations++;
+  shard.m_Stats.m_uiAllocationSize += uiSize;
+  shard.m_Stats.m_uiPerFrameAllocationSize += uiSize;
+  shard.m_Stats.m_PerFrameAllocationTime += allocationTime;
+
+  auto pInfo = &shard.m_Allocations[ptr];
+  pInfo->m_uiSize = uiSize;
+  pInfo->m_uiAlignment = (ezUInt16)uiAlign;
+  pInfo->SetStackTrace(stackTrace);
 }
 
 // static
@@ -225,15 +318,14 @@ void ezMemoryTracker::RemoveAllocation(ezAllocatorId allocatorId, const void* pt
   ezArrayPtr<void*> stackTrace;
 
   {
-    EZ_LOCK(*s_pTrackerData);
-
-    AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
+    AllocationShard& shard = GetAllocatorData(allocatorId).GetShard(ptr);
+    EZ_LOCK(shard);
 
     AllocationInfo info;
-    if (data.m_Allocations.Remove(ptr, &info))
+    if (shard.m_Allocations.Remove(ptr, &info))
     {
-      data.m_Stats.m_uiNumDeallocations++;
-      data.m_Stats.m_uiAllocationSize -= info.m_uiSize;
+      shard.m_Stats.m_uiNumDeallocations++;
+      shard.m_Stats.m_uiAllocationSize -= info.m_uiSize;
 
       stackTrace = info.GetStackTrace();
     }
@@ -249,25 +341,64 @@ void ezMemoryTracker::RemoveAllocation(ezAllocatorId allocatorId, const void* pt
 // static
 void ezMemoryTracker::RemoveAllAllocations(ezAllocatorId allocatorId)
 {
-  EZ_LOCK(*s_pTrackerData);
-  AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
-  for (auto it = data.m_Allocations.GetIterator(); it.IsValid(); ++it)
+  AllocatorData& data = GetAllocatorData(allocatorId);
+
+  for (AllocationShard& shard : data.m_Shards)
   {
-    auto& info = it.Value();
-    data.m_Stats.m_uiNumDeallocations++;
-    data.m_Stats.m_uiAllocationSize -= info.m_uiSize;
+    EZ_LOCK(shard);
 
-    EZ_DELETE_ARRAY(s_pTrackerDataAllocator, info.GetStackTrace());
+    for (auto it = shard.m_Allocations.GetIterator(); it.IsValid(); ++it)
+    {
+      auto& info = it.Value();
+      shard.m_Stats.m_uiNumDeallocations++;
+      shard.m_Stats.m_uiAllocationSize -= info.m_uiSize;
+
+      EZ_DELETE_ARRAY(s_pTrackerDataAllocator, info.GetStackTrace());
+    }
+
+    shard.m_Allocations.Clear();
   }
-  data.m_Allocations.Clear();
 }
 
 // static
 void ezMemoryTracker::SetAllocatorStats(ezAllocatorId allocatorId, const ezAllocatorBase::Stats& stats)
 {
+  AllocatorData& data = GetAllocatorData(allocatorId);
+
+  EZ_LOCK(*s_pTrackerData);
+
+  data.m_Stats = stats;
+
+  // the given stats replace everything that was counted so far
+  for (AllocationShard& shard : data.m_Shards)
+  {
+    EZ_LOCK(shard);
+    shard.m_Stats = ezAllocatorBase::Stats();
+  }
+}
+
+// static
+void ezMemoryTracker::SetThreadCacheStats(ezAllocatorId allocatorId, const ThreadCacheStats& stats)
+{
+  AllocatorData& data = GetAllocatorData(allocatorId);
+
   EZ_LOCK(*s_pTrackerData);
 
-  s_pTrackerData->m_AllocatorData[allocatorId].m_Stats = stats;
+  data.m_ThreadCacheStats = stats;
+}
+
+// static
+void ezMemoryTracker::SetStackTraceSampleRate(ezUInt32 uiSampleRate)
+{
+  EZ_ASSERT_DEV(uiSampleRate > 0, "The stack trace sample rate must be at least 1.");
+
+  s_iStackTraceSampleRate = static_cast<ezInt32>(uiSampleRate);
+}
+
+// static
+ezUInt32 ezMemoryTracker::GetStackTraceSampleRate()
+{
+  return static_cast<ezUInt32>(s_iStackTraceSampleRate);
 }
 
 // static
@@ -277,9 +408,16 @@ void ezMemoryTracker::ResetPerFrameAllocatorStats()
 
   for (auto it = s_pTrackerData->m_AllocatorData.GetIterator(); it.IsValid(); ++it)
   {
-    AllocatorData& data = it.Value();
+    AllocatorData& data = *it.Value();
     data.m_Stats.m_uiPerFrameAllocationSize = 0;
     data.m_Stats.m_PerFrameAllocationTime.SetZero();
+
+    for (AllocationShard& shard : data.m_Shards)
+    {
+      EZ_LOCK(shard);
+      shard.m_Stats.m_uiPerFrameAllocationSize = 0;
+      shard.m_Stats.m_PerFrameAllocationTime.SetZero();
+    }
   }
 }
 
@@ -288,15 +426,23 @@ const char* ezMemoryTracker::GetAllocatorName(ezAllocatorId allocatorId)
 {
   EZ_LOCK(*s_pTrackerData);
 
-  return s_pTrackerData->m_AllocatorData[allocatorId].m_sName.GetData();
+  return s_pTrackerData->m_AllocatorData[allocatorId]->m_sName.GetData();
 }
 
 // static
-const ezAllocatorBase::Stats& ezMemoryTracker::GetAllocatorStats(ezAllocatorId allocatorId)
+ezAllocatorBase::Stats ezMemoryTracker::GetAllocatorStats(ezAllocatorId allocatorId)
 {
   EZ_LOCK(*s_pTrackerData);
 
-  return s_pTrackerData->m_AllocatorData[allocatorId].m_Stats;
+  return s_pTrackerData->m_AllocatorData[allocatorId]->ComputeCombinedStats();
+}
+
+// static
+ezMemoryTracker::ThreadCacheStats ezMemoryTracker::GetThreadCacheStats(ezAllocatorId allocatorId)
+{
+  EZ_LOCK(*s_pTrackerData);
+
+  return s_pTrackerData->m_AllocatorData[allocatorId]->m_ThreadCacheStats;
 }
 
 // static
@@ -304,17 +450,17 @@ ezAllocatorId ezMemoryTracker::GetAllocatorParentId(ezAllocatorId allocatorId)
 {
   EZ_LOCK(*s_pTrackerData);
 
-  return s_pTrackerData->m_AllocatorData[allocatorId].m_ParentId;
+  return s_pTrackerData->m_AllocatorData[allocatorId]->m_ParentId;
 }
 
 // static
 const ezMemoryTracker::AllocationInfo& ezMemoryTracker::GetAllocationInfo(ezAllocatorId allocatorId, const void* ptr)
 {
-  EZ_LOCK(*s_pTrackerData);
+  AllocationShard& shard = GetAllocatorData(allocatorId).GetShard(ptr);
+  EZ_LOCK(shard);
 
-  const AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
   const AllocationInfo* info = nullptr;
-  if (data.m_Allocations.TryGetValue(ptr, info))
+  if (shard.m_Allocations.TryGetValue(ptr, info))
   {
     return *info;
   }
@@ -350,15 +496,19 @@ void ezMemoryTracker::DumpMemoryLeaks()
   // first collect all leaks
   for (auto it = s_pTrackerData->m_AllocatorData.GetIterator(); it.IsValid(); ++it)
   {
-    const AllocatorData& data = it.Value();
-    for (auto it2 = data.m_Allocations.GetIterator(); it2.IsValid(); ++it2)
+    for (AllocationShard& shard : it.Value()->m_Shards)
     {
-      LeakInfo leak;
-      leak.m_AllocatorId = it.Id();
-      leak.m_uiSize = it2.Value().m_uiSize;
-      leak.m_pParentLeak = nullptr;
+      EZ_LOCK(shard);
+
+      for (auto it2 = shard.m_Allocations.GetIterator(); it2.IsValid(); ++it2)
+      {
+        LeakInfo leak;
+        leak.m_AllocatorId = it.Id();
+        leak.m_uiSize = it2.Value().m_uiSize;
+        leak.m_pParentLeak = nullptr;
 
-      leakTable.Insert(it2.Key(), leak);
+        leakTable.Insert(it2.Key(), leak);
+      }
     }
   }
 
@@ -402,9 +552,13 @@ void ezMemoryTracker::DumpMemoryLeaks()
                      "\n--------------------------------------------------------------------\n\n");
       }
 
-      const AllocatorData& data = s_pTrackerData->m_AllocatorData[leak.m_AllocatorId];
+      AllocatorData& data = *s_pTrackerData->m_AllocatorData[leak.m_AllocatorId];
+      AllocationShard& shard = data.GetShard(ptr);
       ezMemoryTracker::AllocationInfo info;
-      data.m_Allocations.TryGetValue(ptr, info);
+      {
+        EZ_LOCK(shard);
+        shard.m_Allocations.TryGetValue(ptr, info);
+      }
 
       DumpLeak(info, data.m_sName.GetData());
 
@@ -16,11 +16,6 @@ static ezAllocatorId GetPageAllocatorId()
   return id;
 }
 
-ezAllocatorId ezPageAllocator::GetId()
-{
-  return GetPageAllocatorId();
-}
-
 #if EZ_ENABLED(EZ_PLATFORM_WINDOWS)
 #  include <Foundation/Memory/Implementation/Win/PageAllocator_win.h>
 #elif EZ_ENABLED(EZ_PLATFORM_OSX) || EZ_ENABLED(EZ_PLATFORM_LINUX) || EZ_ENABLED(EZ_PLATFORM_ANDROID)
@@ -29,4 +24,209 @@ ezAllocatorId ezPageAllocator::GetId()
 #  error "ezPageAllocator is not implemented on current platform"
 #endif
 
+namespace
+{
+  // how many separate page allocations a thread cache can hold, independent of their size
+  static constexpr ezUInt32 s_uiMaxCachedPageAllocations = 16;
+
+  static ezAtomicInteger64 s_iPageThreadCacheSize(1024 * 1024);
+
+  // summed up over all thread caches, see ezMemoryTracker::ThreadCacheStats
+  // the caches only publish their values when pages move between them and the OS, so the fast path doesn't touch shared data
+  static ezAtomicInteger64 s_iPageCacheHits;
+  static ezAtomicInteger64 s_iPageCacheMisses;
+  static ezAtomicInteger64 s_iPageCacheFlushes;
+  static ezAtomicInteger64 s_iPageCacheSize;
+
+  static void ReportPageThreadCacheStats()
+  {
+    ezMemoryTracker::ThreadCacheStats stats;
+    stats.m_uiNumHits = s_iPageCacheHits;
+    stats.m_uiNumMisses = s_iPageCacheMisses;
+    stats.m_uiNumFlushes = s_iPageCacheFlushes;
+    stats.m_uiCachedSize = s_iPageCacheSize;
+
+    ezMemoryTracker::SetThreadCacheStats(GetPageAllocatorId(), stats);
+  }
+
+  /// Freed pages of one thread, the oldest ones are returned to the OS first, when the cache gets too large.
+  struct ezPageThreadCache
+  {
+    ~ezPageThreadCache()
+    {
+      Flush(0);
+
+      // pages may still be freed during shutdown, after the thread local cache was destroyed
+      m_bDestroyed = true;
+    }
+
+    void* Take(size_t uiSize)
+    {
+      for (ezUInt32 i = m_uiNumEntries; i > 0; --i)
+      {
+        if (m_Entries[i - 1].m_uiSize == uiSize)
+        {
+          void* ptr = m_Entries[i - 1].m_pPages;
+          RemoveEntry(i - 1);
+          return ptr;
+        }
+      }
+
+      return nullptr;
+    }
+
+    bool Put(void* ptr, size_t uiSize)
+    {
+      const size_t uiMaxSize = static_cast<size_t>(s_iPageThreadCacheSize);
+
+      if (m_bDestroyed || uiSize > uiMaxSize)
+        return false;
+
+      // the statistics are published after the new entry was added
+      const bool bFlushed = FreeOldest(uiMaxSize - uiSize, s_uiMaxCachedPageAllocations - 1);
+
+      m_Entries[m_uiNumEntries].m_pPages = ptr;
+      m_Entries[m_uiNumEntries].m_uiSize = uiSize;
+      ++m_uiNumEntries;
+
+      m_uiCachedSize += uiSize;
+
+      if (bFlushed)
+      {
+        Publish();
+      }
+
+      return true;
+    }
+
+    void Flush(size_t uiMaxSizeToKeep)
+    {
+      FreeOldest(uiMaxSizeToKeep, 0);
+      Publish();
+    }
+
+    /// Returns the oldest pages to the OS, until the cache holds at most the given size and number of entries.
+    bool FreeOldest(size_t uiMaxSizeToKeep, ezUInt32 uiMaxEntriesToKeep)
+    {
+      if (m_uiCachedSize <= uiMaxSizeToKeep && m_uiNumEntries <= uiMaxEntriesToKeep)
+        return false;
+
+      while (m_uiNumEntries > 0 && (m_uiCachedSize > uiMaxSizeToKeep || m_uiNumEntries > uiMaxEntriesToKeep))
+      {
+        FreeOSPages(m_Entries[0].m_pPages);
+        RemoveEntry(0);
+      }
+
+      s_iPageCacheFlushes.Increment();
+      return true;
+    }
+
+    /// Adds the hits, misses and size changes of this cache since the last call to the shared statistics.
+    void Publish()
+    {
+      s_iPageCacheHits.Add(static_cast<ezInt64>(m_uiNumHits));
+      s_iPageCacheMisses.Add(static_cast<ezInt64>(m_uiNumMisses));
+      s_iPageCacheSize.Add(static_cast<ezInt64>(m_uiCachedSize) - static_cast<ezInt64>(m_uiReportedSize));
+
+      m_uiNumHits = 0;
+      m_uiNumMisses = 0;
+      m_uiReportedSize = m_uiCachedSize;
+
+      ReportPageThreadCacheStats();
+    }
+
+    void RemoveEntry(ezUInt32 uiIndex)
+    {
+      const size_t uiSize = m_Entries[uiIndex].m_uiSize;
+      m_uiCachedSize -= uiSize;
+
+      --m_uiNumEntries;
+      for (ezUInt32 i = uiIndex; i < m_uiNumEntries; ++i)
+      {
+        m_Entries[i] = m_Entries[i + 1];
+      }
+    }
+
+    struct Entry
+    {
+      void* m_pPages;
+      size_t m_uiSize;
+    };
+
+    Entry m_Entries[s_uiMaxCachedPageAllocations];
+    ezUInt32 m_uiNumEntries = 0;
+    size_t m_uiCachedSize = 0;
+    size_t m_uiReportedSize = 0;
+    ezUInt64 m_uiNumHits = 0;
+    ezUInt64 m_uiNumMisses = 0;
+    bool m_bDestroyed = false;
+  };
+
+  thread_local ezPageThreadCache tl_PageThreadCache;
+} // namespace
+
+ezAllocatorId ezPageAllocator::GetId()
+{
+  return GetPageAllocatorId();
+}
+
+// static
+void* ezPageAllocator::AllocatePage(size_t uiSize)
+{
+  ezTime fAllocationTime = ezTime::Now();
+
+  ezPageThreadCache& cache = tl_PageThreadCache;
+  void* ptr = cache.Take(uiSize);
+
+  if (ptr != nullptr)
+  {
+    ++cache.m_uiNumHits;
+  }
+  else
+  {
+    ptr = AllocateOSPages(uiSize);
+
+    // the pages come from the OS anyway, so publishing the statistics doesn't add noticeable cost here
+    ++cache.m_uiNumMisses;
+    cache.Publish();
+  }
+
+  size_t uiAlign = ezSystemInformation::Get().GetMemoryPageSize();
+  ezMemoryTracker::AddAllocation(GetPageAllocatorId(), ezMemoryTrackingFlags::Default, ptr, uiSize, uiAlign, ezTime::Now() - fAllocationTime);
+
+  return ptr;
+}
+
+// static
+void ezPageAllocator::DeallocatePage(void* ptr, size_t uiSize /*= 0*/)
+{
+  ezMemoryTracker::RemoveAllocation(GetPageAllocatorId(), ptr);
+
+  if (uiSize == 0 || !tl_PageThreadCache.Put(ptr, uiSize))
+  {
+    FreeOSPages(ptr);
+  }
+}
+
+// static
+void ezPageAllocator::SetThreadCacheSize(size_t uiMaxBytesPerThread)
+{
+  s_iPageThreadCacheSize = static_cast<ezInt64>(uiMaxBytesPerThread);
+
+  // the caches of other threads shrink with their next deallocation
+  FlushThreadCache();
+}
+
+// static
+size_t ezPageAllocator::GetThreadCacheSize()
+{
+  return static_cast<size_t>(s_iPageThreadCacheSize);
+}
+
+// static
+void ezPageAllocator::FlushThreadCache()
+{
+  tl_PageThreadCache.Flush(0);
+}
+
 EZ_STATICLINK_FILE(Foundation, Foundation_Memory_Implementation_PageAllocator);
@@ -1,11 +1,7 @@
-
 #include <Foundation/Time/Time.h>
 
-// static
-void* ezPageAllocator::AllocatePage(size_t uiSize)
+static void* AllocateOSPages(size_t uiSize)
 {
-  ezTime fAllocationTime = ezTime::Now();
-
   void* ptr = nullptr;
   size_t uiAlign = ezSystemInformation::Get().GetMemoryPageSize();
   const int res = posix_memalign(&ptr, uiAlign, uiSize);
@@ -14,15 +10,10 @@ void* ezPageAllocator::AllocatePage(size_t uiSize)
 
   EZ_CHECK_ALIGNMENT(ptr, uiAlign);
 
-  ezMemoryTracker::AddAllocation(GetPageAllocatorId(), ezMemoryTrackingFlags::Default, ptr, uiSize, uiAlign, ezTime::Now() - fAllocationTime);
-
   return ptr;
 }
 
-// static
-void ezPageAllocator::DeallocatePage(void* ptr)
+static void FreeOSPages(void* ptr)
 {
-  ezMemoryTracker::RemoveAllocation(GetPageAllocatorId(), ptr);
-
   free(ptr);
 }
@@ -1,19 +1,19 @@
-template <ezUInt32 TrackingFlags>
-ezStackAllocator<TrackingFlags>::ezStackAllocator(const char* szName, ezAllocatorBase* pParent)
+template <ezUInt32 TrackingFlags, typename MutexType>
+ezStackAllocator<TrackingFlags, MutexType>::ezStackAllocator(const char* szName, ezAllocatorBase* pParent)
   : ezAllocator<ezMemoryPolicies::ezStackAllocation, TrackingFlags>(szName, pParent)
   , m_DestructData(pParent)
   , m_PtrToDestructDataIndexTable(pParent)
 {
 }
 
-template <ezUInt32 TrackingFlags>
-ezStackAllocator<TrackingFlags>::~ezStackAllocator()
+template <ezUInt32 TrackingFlags, typename MutexType>
+ezStackAllocator<TrackingFlags, MutexType>::~ezStackAllocator()
 {
   Reset();
 }
 
-template <ezUInt32 TrackingFlags>
-void* ezStackAllocator<TrackingFlags>::Allocate(size_t uiSize, size_t uiAlign, ezMemoryUtils::DestructorFunction destructorFunc)
+template <ezUInt32 TrackingFlags, typename MutexType>
+void* ezStackAllocator<TrackingFlags, MutexType>::Allocate(size_t uiSize, size_t uiAlign, ezMemoryUtils::DestructorFunction destructorFunc)
 {
   EZ_LOCK(m_Mutex);
 
@@ -32,8 +32,8 @@ void* ezStackAllocator<TrackingFlags>::Allocate(size_t uiSize, size_t uiAlign, e
   return ptr;
 }
 
-template <ezUInt32 TrackingFlags>
-void ezStackAllocator<TrackingFlags>::Deallocate(void* ptr)
+template <ezUInt32 TrackingFlags, typename MutexType>
+void ezStackAllocator<TrackingFlags, MutexType>::Deallocate(void* ptr)
 {
   EZ_LOCK(m_Mutex);
 
@@ -54,8 +54,8 @@ EZ_MSVC_ANALYSIS_WARNING_PUSH
 // even with the added guard of a check that it can't be 0.
 EZ_MSVC_ANALYSIS_WARNING_DISABLE(6313)
 
-template <ezUInt32 TrackingFlags>
-void ezStackAllocator<TrackingFlags>::Reset()
+template <ezUInt32 TrackingFlags, typename MutexType>
+void ezStackAllocator<TrackingFlags, MutexType>::Reset(bool bPoisonMemory)
 {
   EZ_LOCK(m_Mutex);
 
@@ -68,6 +68,11 @@ void ezStackAllocator<TrackingFlags>::Reset()
   m_DestructData.Clear();
   m_PtrToDestructDataIndexTable.Clear();
 
+  if (bPoisonMemory)
+  {
+    this->m_allocator.PoisonMemory();
+  }
+
   this->m_allocator.Reset();
   if ((TrackingFlags & ezMemoryTrackingFlags::EnableAllocationTracking) != 0)
   {
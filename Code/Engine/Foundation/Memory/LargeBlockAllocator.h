@@ -8,6 +8,22 @@
 #include <Foundation/Threading/Mutex.h>
 #include <Foundation/Threading/ThreadUtils.h>
 
+/// \brief Assigns an index to every thread that uses an ezLargeBlockAllocator, which selects the thread cache of that thread.
+///
+/// No two running threads have the same index, so a thread cache is only ever accessed by a single thread.
+/// The index of a thread is released when the thread exits and is then reused by the next thread.
+class EZ_FOUNDATION_DLL ezLargeBlockAllocatorThreadCacheIndex
+{
+public:
+  enum
+  {
+    MAX_THREADS = 32
+  };
+
+  /// \brief Returns the index of the calling thread, or ezInvalidIndex if MAX_THREADS other threads already hold an index.
+  static ezUInt32 GetCurrentThreadIndex();
+};
+
 /// \brief This struct represents a block of type T, typically 4kb.
 template <typename T, ezUInt32 SizeInBytes>
 struct ezDataBlock
@@ -35,10 +51,23 @@ struct ezDataBlock
 };
 
 /// \brief A block allocator which can only allocates blocks of memory at once.
+///
+/// Freed blocks are first put into the cache of the calling thread, from which the same thread can take them again without any lock.
+/// Every thread gets a cache of its own (see ezLargeBlockAllocatorThreadCacheIndex), threads beyond NUM_THREAD_CACHES use the shared
+/// free list directly. When a cache runs empty it takes several blocks from the shared free list at once, when it exceeds its size
+/// (see SetThreadCacheSize()) it returns half of its blocks. Only these transfers lock the shared free list and report statistics
+/// to ezMemoryTracker::GetThreadCacheStats().
 template <ezUInt32 BlockSizeInByte>
 class ezLargeBlockAllocator
 {
 public:
+  enum
+  {
+    NUM_THREAD_CACHES = ezLargeBlockAllocatorThreadCacheIndex::MAX_THREADS,
+    MAX_THREAD_CACHE_SIZE = 32,
+    DEFAULT_THREAD_CACHE_SIZE = 16
+  };
+
   ezLargeBlockAllocator(const char* szName, ezAllocatorBase* pParent, ezBitflags<ezMemoryTrackingFlags> flags = ezMemoryTrackingFlags::Default);
   ~ezLargeBlockAllocator();
 
@@ -53,12 +82,35 @@ public:
 
   ezAllocatorId GetId() const;
 
-  const ezAllocatorBase::Stats& GetStats() const;
+  ezAllocatorBase::Stats GetStats() const;
+
+  /// \brief Sets how many free blocks each thread cache may hold, at most MAX_THREAD_CACHE_SIZE. Zero disables the thread caches.
+  ///
+  /// Larger caches make allocations cheaper, when many blocks are allocated and freed in a row, but keep more memory
+  /// from being reused by other threads. Should be called before the allocator is used by several threads.
+  void SetThreadCacheSize(ezUInt32 uiMaxBlocksPerCache);
+
+  /// \brief Returns the value set with SetThreadCacheSize().
+  ezUInt32 GetThreadCacheSize() const;
+
+  /// \brief Returns all blocks from the thread caches to the shared free list, which allows unused super blocks to be freed.
+  ///
+  /// The thread caches are not locked, so this must not be called while other threads use the allocator.
+  void FlushThreadCaches();
 
 private:
+  struct ThreadCache;
+
   void* Allocate(size_t uiAlign);
   void Deallocate(void* ptr);
 
+  void* AllocateFromFreeList(size_t uiAlign);
+  void DeallocateToFreeList(void* ptr);
+
+  void RefillThreadCache(ThreadCache& cache, size_t uiAlign);
+  void FlushThreadCache(ThreadCache& cache, ezUInt32 uiBlocksToKeep);
+  void UpdateThreadCacheStats(ThreadCache& cache);
+
   ezAllocatorId m_Id;
   ezBitflags<ezMemoryTrackingFlags> m_TrackingFlags;
 
@@ -82,6 +134,19 @@ private:
 
   ezDynamicArray<SuperBlock> m_superBlocks;
   ezDynamicArray<ezUInt32> m_freeBlocks;
+
+  // aligned to the cache line size, so that threads working on neighboring caches don't slow each other down
+  struct EZ_ALIGN(ThreadCache, 64)
+  {
+    ezUInt32 m_uiNumBlocks = 0;
+    ezUInt32 m_uiReportedBlocks = 0;
+    ezUInt64 m_uiNumHits = 0;
+    void* m_Blocks[MAX_THREAD_CACHE_SIZE];
+  };
+
+  ezUInt32 m_uiThreadCacheSize = DEFAULT_THREAD_CACHE_SIZE;
+  ThreadCache m_ThreadCaches[NUM_THREAD_CACHES];
+  ezMemoryTracker::ThreadCacheStats m_ThreadCacheStats; // protected by m_mutex
 };
 
 #include <Foundation/Memory/Implementation/LargeBlockAllocator_inl.h>
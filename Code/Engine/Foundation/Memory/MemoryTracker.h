@@ -72,6 +72,19 @@ public:
     }
   };
 
+  /// \brief Statistics of allocators that keep freed memory in thread caches, e.g. ezLargeBlockAllocator, ezPageAllocator and ezScalableHeapAllocator.
+  ///
+  /// The allocators only update these when memory moves between a thread cache and the shared state, so the values may lag behind slightly.
+  struct ThreadCacheStats
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt64 m_uiNumHits = 0;    ///< number of allocations that were served from a thread cache
+    ezUInt64 m_uiNumMisses = 0;  ///< number of allocations that found the thread cache empty
+    ezUInt64 m_uiNumFlushes = 0; ///< number of times that thread caches returned memory to the shared state
+    ezUInt64 m_uiCachedSize = 0; ///< size in bytes of the memory that currently sits in thread caches
+  };
+
   class EZ_FOUNDATION_DLL Iterator
   {
   public:
@@ -80,7 +93,7 @@ public:
     ezAllocatorId Id() const;
     const char* Name() const;
     ezAllocatorId ParentId() const;
-    const ezAllocatorBase::Stats& Stats() const;
+    ezAllocatorBase::Stats Stats() const;
 
     void Next();
     bool IsValid() const;
@@ -106,11 +119,22 @@ public:
   static void RemoveAllocation(ezAllocatorId allocatorId, const void* ptr);
   static void RemoveAllAllocations(ezAllocatorId allocatorId);
   static void SetAllocatorStats(ezAllocatorId allocatorId, const ezAllocatorBase::Stats& stats);
+  static void SetThreadCacheStats(ezAllocatorId allocatorId, const ThreadCacheStats& stats);
+
+  /// \brief Only every N-th allocation of a thread records a stack trace, for allocators that use ezMemoryTrackingFlags::EnableStackTrace.
+  ///
+  /// Capturing stack traces is by far the most expensive part of allocation tracking. Sampling them keeps tracking fast enough
+  /// for profiling builds, while all allocations are still tracked for the statistics and leak detection.
+  /// Leaks of allocations without a stack trace are reported without one. The default of 1 records every stack trace.
+  static void SetStackTraceSampleRate(ezUInt32 uiSampleRate);
+  static ezUInt32 GetStackTraceSampleRate();
 
   static void ResetPerFrameAllocatorStats();
 
   static const char* GetAllocatorName(ezAllocatorId allocatorId);
-  static const ezAllocatorBase::Stats& GetAllocatorStats(ezAllocatorId allocatorId);
+  /// \brief Returns a snapshot of the allocator's stats, which is taken while other threads may keep allocating.
+  static ezAllocatorBase::Stats GetAllocatorStats(ezAllocatorId allocatorId);
+  static ThreadCacheStats GetThreadCacheStats(ezAllocatorId allocatorId);
   static ezAllocatorId GetAllocatorParentId(ezAllocatorId allocatorId);
   static const AllocationInfo& GetAllocationInfo(ezAllocatorId allocatorId, const void* ptr);
 
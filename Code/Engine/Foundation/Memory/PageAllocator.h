@@ -3,11 +3,26 @@
 #include <Foundation/Basics.h>
 
 /// \brief This helper class can reserve and allocate whole memory pages.
+///
+/// Pages that are freed with their size are kept in a cache of the calling thread, up to the size set with SetThreadCacheSize().
+/// A following allocation of the same size on that thread reuses them, instead of going to the OS again.
+/// Statistics about the caches are reported to ezMemoryTracker::GetThreadCacheStats().
 class EZ_FOUNDATION_DLL ezPageAllocator
 {
 public:
   static void* AllocatePage(size_t uiSize);
-  static void DeallocatePage(void* ptr);
+
+  /// \brief Frees pages that were allocated with AllocatePage(). If the size is not given, the pages cannot be cached and are returned to the OS right away.
+  static void DeallocatePage(void* ptr, size_t uiSize = 0);
 
   static ezAllocatorId GetId();
+
+  /// \brief Sets how many bytes of freed pages each thread may keep for reuse. Zero disables the thread caches.
+  static void SetThreadCacheSize(size_t uiMaxBytesPerThread);
+
+  /// \brief Returns the value set with SetThreadCacheSize().
+  static size_t GetThreadCacheSize();
+
+  /// \brief Returns the pages that the calling thread has cached to the OS. This also happens automatically when a thread exits.
+  static void FlushThreadCache();
 };
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+
+namespace ezMemoryPolicies
+{
+  /// \brief This allocation policy hands out memory from a buffer that is embedded into the allocator itself and only
+  ///   takes additional buckets from the parent allocator, once that buffer is used up.
+  ///
+  /// Only the last allocation can be freed individually, all other memory is freed at once on Reset() or destruction.
+  /// Reallocating the last allocation grows it in place, if possible, which makes this a good fit for temporary strings and
+  /// arrays that are built up piece by piece.
+  ///
+  /// \note This policy is not thread-safe.
+  ///
+  /// \see ezAllocator
+  template <ezUInt32 InlineSize>
+  class ezArenaAllocation
+  {
+  public:
+    enum
+    {
+      Alignment = 16
+    };
+
+    EZ_CHECK_AT_COMPILETIME_MSG(InlineSize % Alignment == 0, "The inline size must be a multiple of the alignment");
+
+    EZ_FORCE_INLINE ezArenaAllocation(ezAllocatorBase* pParent)
+      : m_pParent(pParent)
+    {
+      Reset();
+    }
+
+    EZ_FORCE_INLINE ~ezArenaAllocation() { FreeBuckets(); }
+
+    EZ_FORCE_INLINE void* Allocate(size_t uiSize, size_t uiAlign)
+    {
+      EZ_ASSERT_DEV(uiAlign <= Alignment && Alignment % uiAlign == 0, "Unsupported alignment {0}", ((ezUInt32)uiAlign));
+      uiSize = ezMemoryUtils::AlignSize(uiSize, (size_t)Alignment);
+
+      if (uiSize > static_cast<size_t>(m_pEnd - m_pNextAllocation))
+      {
+        AddBucket(uiSize);
+      }
+
+      m_pLastAllocation = m_pNextAllocation;
+      m_pNextAllocation += uiSize;
+      return m_pLastAllocation;
+    }
+
+    EZ_FORCE_INLINE void* Reallocate(void* ptr, size_t uiCurrentSize, size_t uiNewSize, size_t uiAlign)
+    {
+      if (ptr == m_pLastAllocation)
+      {
+        const size_t uiAlignedSize = ezMemoryUtils::AlignSize(uiNewSize, (size_t)Alignment);
+
+        if (uiAlignedSize <= static_cast<size_t>(m_pEnd - m_pLastAllocation))
+        {
+          m_pNextAllocation = m_pLastAllocation + uiAlignedSize;
+          return ptr;
+        }
+      }
+
+      void* pNewMem = Allocate(uiNewSize, uiAlign);
+      ezMemoryUtils::RawByteCopy(pNewMem, ptr, ezMath::Min(uiCurrentSize, uiNewSize));
+      return pNewMem;
+    }
+
+    EZ_FORCE_INLINE void Deallocate(void* ptr)
+    {
+      // only the last allocation can be given back, everything else is freed on Reset()
+      if (ptr == m_pLastAllocation)
+      {
+        m_pNextAllocation = m_pLastAllocation;
+        m_pLastAllocation = nullptr;
+      }
+    }
+
+    /// \brief Frees all buckets that were taken from the parent allocator and starts over with the embedded buffer.
+    void Reset()
+    {
+      FreeBuckets();
+
+      m_pNextAllocation = m_InlineMemory;
+      m_pEnd = m_InlineMemory + InlineSize;
+      m_pLastAllocation = nullptr;
+    }
+
+    EZ_ALWAYS_INLINE ezAllocatorBase* GetParent() const { return m_pParent; }
+
+  private:
+    struct BucketHeader
+    {
+      BucketHeader* m_pPrevBucket;
+    };
+
+    static constexpr size_t HeaderSize = Alignment;
+
+    void AddBucket(size_t uiMinSize)
+    {
+      while (uiMinSize + HeaderSize > m_uiNextBucketSize)
+      {
+        m_uiNextBucketSize *= 2;
+      }
+
+      BucketHeader* pBucket = static_cast<BucketHeader*>(m_pParent->Allocate(m_uiNextBucketSize, Alignment));
+      pBucket->m_pPrevBucket = m_pLastBucket;
+      m_pLastBucket = pBucket;
+
+      m_pNextAllocation = reinterpret_cast<ezUInt8*>(pBucket) + HeaderSize;
+      m_pEnd = reinterpret_cast<ezUInt8*>(pBucket) + m_uiNextBucketSize;
+
+      m_uiNextBucketSize *= 2;
+    }
+
+    void FreeBuckets()
+    {
+      while (m_pLastBucket != nullptr)
+      {
+        BucketHeader* pPrevBucket = m_pLastBucket->m_pPrevBucket;
+        m_pParent->Deallocate(m_pLastBucket);
+        m_pLastBucket = pPrevBucket;
+      }
+
+      m_uiNextBucketSize = 4096;
+    }
+
+    ezAllocatorBase* m_pParent = nullptr;
+    BucketHeader* m_pLastBucket = nullptr;
+    size_t m_uiNextBucketSize = 4096;
+
+    ezUInt8* m_pNextAllocation = nullptr;
+    ezUInt8* m_pEnd = nullptr;
+    ezUInt8* m_pLastAllocation = nullptr;
+
+    EZ_ALIGN_16(ezUInt8 m_InlineMemory[InlineSize]);
+  };
+} // namespace ezMemoryPolicies
@@ -0,0 +1,90 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Memory/Policies/PoolAllocation.h>
+
+namespace
+{
+  // every block starts with a header that stores its size class, the header size also defines the maximum supported alignment
+  static constexpr size_t s_uiPoolBlockHeaderSize = 16;
+} // namespace
+
+namespace ezMemoryPolicies
+{
+  ezPoolAllocation::ezPoolAllocation(ezAllocatorBase* pParent)
+    : m_pParent(pParent)
+  {
+    EZ_ASSERT_DEV(m_pParent != nullptr, "The pool allocation policy requires a parent allocator.");
+  }
+
+  ezPoolAllocation::~ezPoolAllocation()
+  {
+    for (SizeClass& sizeClass : m_SizeClasses)
+    {
+      while (sizeClass.m_pFreeBlocks != nullptr)
+      {
+        FreeBlock* pBlock = sizeClass.m_pFreeBlocks;
+        sizeClass.m_pFreeBlocks = pBlock->m_pNext;
+
+        m_pParent->Deallocate(ezMemoryUtils::AddByteOffset(pBlock, -static_cast<ptrdiff_t>(s_uiPoolBlockHeaderSize)));
+      }
+    }
+  }
+
+  void* ezPoolAllocation::Allocate(size_t uiSize, size_t uiAlign)
+  {
+    EZ_ASSERT_DEV(uiAlign <= s_uiPoolBlockHeaderSize, "The pool allocation policy does not support alignments larger than {}.",
+      (ezUInt32)s_uiPoolBlockHeaderSize);
+
+    const ezUInt32 uiSizeClass = uiSize > 0 ? static_cast<ezUInt32>((uiSize - 1) / SizeClassGranularity) : 0;
+
+    if (uiSizeClass >= NumSizeClasses)
+    {
+      void* ptr = m_pParent->Allocate(uiSize + s_uiPoolBlockHeaderSize, s_uiPoolBlockHeaderSize);
+      *static_cast<ezUInt32*>(ptr) = NumSizeClasses;
+      return ezMemoryUtils::AddByteOffset(ptr, s_uiPoolBlockHeaderSize);
+    }
+
+    SizeClass& sizeClass = m_SizeClasses[uiSizeClass];
+
+    {
+      EZ_LOCK(sizeClass.m_Mutex);
+
+      if (FreeBlock* pBlock = sizeClass.m_pFreeBlocks)
+      {
+        sizeClass.m_pFreeBlocks = pBlock->m_pNext;
+        --sizeClass.m_uiNumFreeBlocks;
+        return pBlock;
+      }
+    }
+
+    void* ptr = m_pParent->Allocate((uiSizeClass + 1) * SizeClassGranularity + s_uiPoolBlockHeaderSize, s_uiPoolBlockHeaderSize);
+    *static_cast<ezUInt32*>(ptr) = uiSizeClass;
+    return ezMemoryUtils::AddByteOffset(ptr, s_uiPoolBlockHeaderSize);
+  }
+
+  void ezPoolAllocation::Deallocate(void* ptr)
+  {
+    void* pHeader = ezMemoryUtils::AddByteOffset(ptr, -static_cast<ptrdiff_t>(s_uiPoolBlockHeaderSize));
+    const ezUInt32 uiSizeClass = *static_cast<ezUInt32*>(pHeader);
+
+    if (uiSizeClass < NumSizeClasses)
+    {
+      SizeClass& sizeClass = m_SizeClasses[uiSizeClass];
+
+      EZ_LOCK(sizeClass.m_Mutex);
+
+      if (sizeClass.m_uiNumFreeBlocks < MaxFreeBlocksPerSizeClass)
+      {
+        FreeBlock* pBlock = static_cast<FreeBlock*>(ptr);
+        pBlock->m_pNext = sizeClass.m_pFreeBlocks;
+        sizeClass.m_pFreeBlocks = pBlock;
+        ++sizeClass.m_uiNumFreeBlocks;
+        return;
+      }
+    }
+
+    m_pParent->Deallocate(pHeader);
+  }
+} // namespace ezMemoryPolicies
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Memory_Policies_PoolAllocation);
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Threading/Mutex.h>
+
+namespace ezMemoryPolicies
+{
+  /// \brief Pool allocation policy for many small, short-lived allocations of varying size.
+  ///
+  /// Allocations are rounded up to a multiple of SizeClassGranularity bytes. Freed blocks are not returned to the parent allocator,
+  /// but kept in one free list per size class and handed out again for the next allocation of the same size class.
+  /// This makes allocating and freeing blocks of the typical sizes very cheap, once the pool has warmed up.
+  /// Allocations larger than MaxPooledSize bytes are passed through to the parent allocator.
+  ///
+  /// \see ezAllocator
+  class EZ_FOUNDATION_DLL ezPoolAllocation
+  {
+  public:
+    enum : ezUInt32
+    {
+      SizeClassGranularity = 64,
+      NumSizeClasses = 16,
+      MaxPooledSize = SizeClassGranularity * NumSizeClasses,
+      MaxFreeBlocksPerSizeClass = 256,
+    };
+
+    ezPoolAllocation(ezAllocatorBase* pParent);
+    ~ezPoolAllocation();
+
+    void* Allocate(size_t uiSize, size_t uiAlign);
+    void Deallocate(void* ptr);
+
+    EZ_ALWAYS_INLINE ezAllocatorBase* GetParent() const { return m_pParent; }
+
+  private:
+    struct FreeBlock
+    {
+      FreeBlock* m_pNext;
+    };
+
+    struct SizeClass
+    {
+      ezMutex m_Mutex;
+      FreeBlock* m_pFreeBlocks = nullptr;
+      ezUInt32 m_uiNumFreeBlocks = 0;
+    };
+
+    ezAllocatorBase* m_pParent;
+    SizeClass m_SizeClasses[NumSizeClasses];
+  };
+} // namespace ezMemoryPolicies
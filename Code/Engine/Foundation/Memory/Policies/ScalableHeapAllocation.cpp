@@ -0,0 +1,634 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Memory/MemoryTracker.h>
+#include <Foundation/Memory/Policies/ScalableHeapAllocation.h>
+#include <Foundation/Threading/AtomicUtils.h>
+
+namespace
+{
+  using ezScalableHeapPolicy = ezMemoryPolicies::ezScalableHeapAllocation;
+
+  // The span map has one bit for every SpanSize aligned address range, which is set while that range holds a span of small blocks.
+  // Everything else that the policy hands out is a large allocation, so it can tell them apart without looking at the memory.
+  // It has two levels, the leaves are only allocated for the parts of the address space that are actually used and are never freed.
+  static constexpr ezUInt32 s_uiScalableHeapSpanBits = 16;
+  static constexpr ezUInt32 s_uiScalableHeapSpanMapLeafBits = 18;
+  static constexpr ezUInt32 s_uiScalableHeapSpanMapLeafWords = (1u << s_uiScalableHeapSpanMapLeafBits) / 32;
+
+  // 64 bit platforms use 48 bit virtual addresses, 32 bit platforms only need the first leaf
+  static constexpr ezUInt32 s_uiScalableHeapSpanMapRootSize =
+    sizeof(void*) == 8 ? (1u << (48 - s_uiScalableHeapSpanBits - s_uiScalableHeapSpanMapLeafBits)) : 1;
+
+  EZ_CHECK_AT_COMPILETIME(ezScalableHeapPolicy::SpanSize == (1u << s_uiScalableHeapSpanBits));
+
+  static void* s_ScalableHeapSpanMap[s_uiScalableHeapSpanMapRootSize] = {};
+
+  ezInt32* ezScalableHeapGetSpanMapLeaf(size_t uiSpanIndex)
+  {
+    const size_t uiRootIndex = uiSpanIndex >> s_uiScalableHeapSpanMapLeafBits;
+    EZ_ASSERT_DEV(uiRootIndex < s_uiScalableHeapSpanMapRootSize, "The scalable heap only supports 48 bit addresses.");
+
+    ezInt32* pLeaf = static_cast<ezInt32*>(s_ScalableHeapSpanMap[uiRootIndex]);
+
+    if (pLeaf == nullptr)
+    {
+      ezMemoryPolicies::ezAlignedHeapAllocation leafAllocation(nullptr);
+      ezInt32* pNewLeaf = static_cast<ezInt32*>(leafAllocation.Allocate(s_uiScalableHeapSpanMapLeafWords * sizeof(ezInt32), EZ_ALIGNMENT_OF(ezInt32)));
+      ezMemoryUtils::ZeroFill(pNewLeaf, s_uiScalableHeapSpanMapLeafWords);
+
+      if (ezAtomicUtils::TestAndSet(&s_ScalableHeapSpanMap[uiRootIndex], nullptr, pNewLeaf))
+      {
+        pLeaf = pNewLeaf;
+      }
+      else
+      {
+        // another thread was faster
+        leafAllocation.Deallocate(pNewLeaf);
+        pLeaf = static_cast<ezInt32*>(s_ScalableHeapSpanMap[uiRootIndex]);
+      }
+    }
+
+    return pLeaf;
+  }
+
+  void ezScalableHeapMarkSpan(const void* pSpan, bool bSmallBlocks)
+  {
+    const size_t uiSpanIndex = reinterpret_cast<size_t>(pSpan) >> s_uiScalableHeapSpanBits;
+    const size_t uiBit = uiSpanIndex & ((1u << s_uiScalableHeapSpanMapLeafBits) - 1);
+
+    volatile ezInt32& word = ezScalableHeapGetSpanMapLeaf(uiSpanIndex)[uiBit / 32];
+    const ezInt32 iMask = static_cast<ezInt32>(1u << (uiBit % 32));
+
+    if (bSmallBlocks)
+      ezAtomicUtils::Or(word, iMask);
+    else
+      ezAtomicUtils::And(word, ~iMask);
+  }
+
+  EZ_ALWAYS_INLINE bool ezScalableHeapIsInSmallSpan(const void* ptr)
+  {
+    // whoever frees the memory got the pointer after the span was marked, so no further synchronization is needed
+    const size_t uiSpanIndex = reinterpret_cast<size_t>(ptr) >> s_uiScalableHeapSpanBits;
+    const size_t uiRootIndex = uiSpanIndex >> s_uiScalableHeapSpanMapLeafBits;
+
+    if (uiRootIndex >= s_uiScalableHeapSpanMapRootSize)
+      return false;
+
+    const ezInt32* pLeaf = static_cast<const ezInt32*>(s_ScalableHeapSpanMap[uiRootIndex]);
+
+    if (pLeaf == nullptr)
+      return false;
+
+    const size_t uiBit = uiSpanIndex & ((1u << s_uiScalableHeapSpanMapLeafBits) - 1);
+    return (static_cast<ezUInt32>(pLeaf[uiBit / 32]) & (1u << (uiBit % 32))) != 0;
+  }
+
+  // all live allocator instances, used to check whether a thread heap may still be accessed when a thread shuts down
+  static ezMemoryPolicies::ezScalableHeapAllocation* s_pFirstScalableHeap = nullptr;
+  static ezUInt64 s_uiLastScalableHeapInstanceId = 0;
+
+  ezMutex& GetScalableHeapRegistryMutex()
+  {
+    static ezMutex s_Mutex;
+    return s_Mutex;
+  }
+
+  template <typename SpanType>
+  void ezScalableHeapLinkSpan(SpanType*& pHead, SpanType* pSpan)
+  {
+    // the head is the span that allocations are served from, so new spans are inserted behind it unless the list is empty
+    if (pHead == nullptr)
+    {
+      pSpan->m_pPrev = nullptr;
+      pSpan->m_pNext = nullptr;
+      pHead = pSpan;
+      return;
+    }
+
+    pSpan->m_pPrev = pHead;
+    pSpan->m_pNext = pHead->m_pNext;
+
+    if (pHead->m_pNext != nullptr)
+      pHead->m_pNext->m_pPrev = pSpan;
+
+    pHead->m_pNext = pSpan;
+  }
+
+  template <typename SpanType>
+  void ezScalableHeapPushSpan(SpanType*& pHead, SpanType* pSpan)
+  {
+    pSpan->m_pPrev = nullptr;
+    pSpan->m_pNext = pHead;
+
+    if (pHead != nullptr)
+      pHead->m_pPrev = pSpan;
+
+    pHead = pSpan;
+  }
+
+  template <typename SpanType>
+  void ezScalableHeapUnlinkSpan(SpanType*& pHead, SpanType* pSpan)
+  {
+    if (pSpan->m_pPrev != nullptr)
+      pSpan->m_pPrev->m_pNext = pSpan->m_pNext;
+    else
+      pHead = pSpan->m_pNext;
+
+    if (pSpan->m_pNext != nullptr)
+      pSpan->m_pNext->m_pPrev = pSpan->m_pPrev;
+
+    pSpan->m_pPrev = nullptr;
+    pSpan->m_pNext = nullptr;
+  }
+} // namespace
+
+namespace ezMemoryPolicies
+{
+  struct ezScalableHeapAllocation::FreeBlock
+  {
+    FreeBlock* m_pNext;
+  };
+
+  /// Header at the start of every span. Since spans are aligned to their size, the span of any block is found by masking its address.
+  struct ezScalableHeapAllocation::Span
+  {
+    ThreadHeap* m_pHeap;
+    Span* m_pPrev;
+    Span* m_pNext;
+    FreeBlock* m_pFreeList;
+    ezUInt8* m_pUnusedBlocks;
+    ezUInt32 m_uiSizeClass;
+    ezUInt32 m_uiBlockSize;
+    ezUInt32 m_uiNumUsedBlocks;
+    bool m_bFull;
+
+    EZ_ALWAYS_INLINE bool HasFreeBlocks() const
+    {
+      return m_pFreeList != nullptr || m_pUnusedBlocks + m_uiBlockSize <= reinterpret_cast<const ezUInt8*>(this) + SpanSize;
+    }
+  };
+
+  /// Header directly in front of every large allocation. Large allocations are only aligned to MaxAlignment and never lie in a range
+  /// that the span map marks as a span of small blocks.
+  struct ezScalableHeapAllocation::LargeHeader
+  {
+    size_t m_uiSize;
+  };
+
+  struct ezScalableHeapAllocation::ThreadHeap
+  {
+    // spans that may still have free blocks, the first one is used for allocations
+    Span* m_PartialSpans[NumSizeClasses] = {};
+
+    // spans without free blocks, they move back to the partial list as soon as their owner frees a block in them
+    Span* m_FullSpans[NumSizeClasses] = {};
+
+    ezUInt64 m_uiNumHits = 0;
+    ThreadHeap* m_pNextHeap = nullptr;
+    ezAtomicInteger32 m_iAbandoned;
+
+    // blocks freed by other threads, pushed lock-free and reclaimed by the owning thread all at once
+    void* m_pRemoteFreeList = nullptr;
+  };
+
+  struct ezScalableHeapAllocation::ThreadData
+  {
+    struct Entry
+    {
+      ezUInt64 m_uiInstanceId = 0;
+      ThreadHeap* m_pHeap = nullptr;
+    };
+
+    ~ThreadData()
+    {
+      for (Entry& entry : m_Entries)
+      {
+        if (entry.m_pHeap != nullptr)
+        {
+          AbandonHeap(entry.m_uiInstanceId, entry.m_pHeap);
+        }
+      }
+
+      m_bShutDown = true;
+    }
+
+    Entry m_Entries[MaxThreadHeaps];
+    ezUInt32 m_uiNextEviction = 0;
+    bool m_bShutDown = false;
+  };
+
+  // static
+  EZ_ALWAYS_INLINE ezScalableHeapAllocation::Span* ezScalableHeapAllocation::GetSpan(const void* ptr)
+  {
+    return reinterpret_cast<Span*>(reinterpret_cast<size_t>(ptr) & ~static_cast<size_t>(SpanSize - 1));
+  }
+
+  // static
+  EZ_ALWAYS_INLINE ezScalableHeapAllocation::LargeHeader* ezScalableHeapAllocation::GetLargeHeader(const void* ptr)
+  {
+    if (ezScalableHeapIsInSmallSpan(ptr))
+      return nullptr;
+
+    return reinterpret_cast<LargeHeader*>(const_cast<void*>(ptr)) - 1;
+  }
+
+  EZ_FORCE_INLINE void* ezScalableHeapAllocation::AllocateSmall(ThreadHeap* pHeap, ezUInt32 uiSizeClass)
+  {
+    Span* pSpan = pHeap->m_PartialSpans[uiSizeClass];
+
+    if (pSpan != nullptr)
+    {
+      if (FreeBlock* pBlock = pSpan->m_pFreeList)
+      {
+        pSpan->m_pFreeList = pBlock->m_pNext;
+        ++pSpan->m_uiNumUsedBlocks;
+        ++pHeap->m_uiNumHits;
+        return pBlock;
+      }
+
+      if (pSpan->HasFreeBlocks())
+      {
+        void* ptr = pSpan->m_pUnusedBlocks;
+        pSpan->m_pUnusedBlocks += pSpan->m_uiBlockSize;
+        ++pSpan->m_uiNumUsedBlocks;
+        ++pHeap->m_uiNumHits;
+        return ptr;
+      }
+    }
+
+    return AllocateSmallSlow(pHeap, uiSizeClass);
+  }
+
+  ezScalableHeapAllocation::ezScalableHeapAllocation(ezAllocatorBase* pParent)
+    : m_SystemAllocation(pParent)
+  {
+    EZ_CHECK_AT_COMPILETIME(sizeof(Span) <= SpanHeaderSize);
+    EZ_CHECK_AT_COMPILETIME(sizeof(LargeHeader) <= MaxAlignment);
+
+    EZ_LOCK(GetScalableHeapRegistryMutex());
+
+    m_uiInstanceId = ++s_uiLastScalableHeapInstanceId;
+    m_pNextInstance = s_pFirstScalableHeap;
+    s_pFirstScalableHeap = this;
+  }
+
+  ezScalableHeapAllocation::~ezScalableHeapAllocation()
+  {
+    {
+      EZ_LOCK(GetScalableHeapRegistryMutex());
+
+      ezScalableHeapAllocation** ppInstance = &s_pFirstScalableHeap;
+      while (*ppInstance != this)
+      {
+        ppInstance = &(*ppInstance)->m_pNextInstance;
+      }
+
+      *ppInstance = m_pNextInstance;
+    }
+
+    ThreadHeap* pHeap = m_pFirstHeap;
+    while (pHeap != nullptr)
+    {
+      for (ezUInt32 uiSizeClass = 0; uiSizeClass < NumSizeClasses; ++uiSizeClass)
+      {
+        for (Span* pList : {pHeap->m_PartialSpans[uiSizeClass], pHeap->m_FullSpans[uiSizeClass]})
+        {
+          while (pList != nullptr)
+          {
+            Span* pNext = pList->m_pNext;
+            ezScalableHeapMarkSpan(pList, false);
+            m_SystemAllocation.Deallocate(pList);
+            pList = pNext;
+          }
+        }
+      }
+
+      ThreadHeap* pNextHeap = pHeap->m_pNextHeap;
+      pHeap->~ThreadHeap();
+      m_SystemAllocation.Deallocate(pHeap);
+      pHeap = pNextHeap;
+    }
+  }
+
+  void* ezScalableHeapAllocation::Allocate(size_t uiSize, size_t uiAlign)
+  {
+    EZ_ASSERT_DEV(uiAlign <= MaxAlignment, "The scalable heap allocation policy does not support alignments larger than {}.", (ezUInt32)MaxAlignment);
+
+    if (uiSize > MaxSmallSize || uiAlign > MaxSmallAlignment)
+    {
+      return AllocateLarge(uiSize);
+    }
+
+    const ezUInt32 uiSizeClass = GetSizeClass(uiSize);
+
+    if (ThreadHeap* pHeap = GetThreadHeap(true))
+    {
+      return AllocateSmall(pHeap, uiSizeClass);
+    }
+
+    // the thread local data of this thread has already been destroyed, borrow a heap for this single allocation
+    ThreadHeap* pHeap = AcquireHeap();
+    void* ptr = AllocateSmall(pHeap, uiSizeClass);
+    pHeap->m_iAbandoned.Set(1);
+    return ptr;
+  }
+
+  void* ezScalableHeapAllocation::Reallocate(void* ptr, size_t uiCurrentSize, size_t uiNewSize, size_t uiAlign)
+  {
+    if (ptr != nullptr)
+    {
+      const LargeHeader* pLarge = GetLargeHeader(ptr);
+      const size_t uiCapacity = pLarge != nullptr ? pLarge->m_uiSize : GetSpan(ptr)->m_uiBlockSize;
+
+      // keep the memory if the new size still fits and does not waste more than half of it
+      if (uiNewSize <= uiCapacity && uiNewSize > uiCapacity / 2 && ezMemoryUtils::IsAligned(ptr, uiAlign))
+      {
+        return ptr;
+      }
+    }
+
+    void* pNewMem = Allocate(uiNewSize, uiAlign);
+
+    if (ptr != nullptr)
+    {
+      ezMemoryUtils::Copy(static_cast<ezUInt8*>(pNewMem), static_cast<const ezUInt8*>(ptr), ezMath::Min(uiCurrentSize, uiNewSize));
+      Deallocate(ptr);
+    }
+
+    return pNewMem;
+  }
+
+  void ezScalableHeapAllocation::Deallocate(void* ptr)
+  {
+    if (ptr == nullptr)
+      return;
+
+    if (GetLargeHeader(ptr) != nullptr)
+    {
+      m_SystemAllocation.Deallocate(ezMemoryUtils::AddByteOffset(ptr, -static_cast<ptrdiff_t>(MaxAlignment)));
+      return;
+    }
+
+    Span* pSpan = GetSpan(ptr);
+
+    ThreadHeap* pHeap = GetThreadHeap(false);
+
+    if (pHeap == pSpan->m_pHeap)
+    {
+      DeallocateLocal(pHeap, pSpan, ptr);
+    }
+    else
+    {
+      DeallocateRemote(pSpan, ptr);
+    }
+  }
+
+  // static
+  ezUInt32 ezScalableHeapAllocation::GetSizeClass(size_t uiSize)
+  {
+    EZ_ASSERT_DEBUG(uiSize <= MaxSmallSize, "Size {} is not a small allocation.", uiSize);
+
+    // 16 byte steps up to 128 bytes, above that four size classes per power of two
+    const ezUInt32 uiSizeMinusOne = static_cast<ezUInt32>(ezMath::Max<size_t>(uiSize, 1) - 1);
+
+    if (uiSizeMinusOne < 128)
+      return uiSizeMinusOne >> 4;
+
+    const ezUInt32 uiHighBit = ezMath::FirstBitHigh(uiSizeMinusOne);
+    return 8 + (uiHighBit - 7) * 4 + ((uiSizeMinusOne >> (uiHighBit - 2)) & 3);
+  }
+
+  // static
+  ezUInt32 ezScalableHeapAllocation::GetSizeClassBlockSize(ezUInt32 uiSizeClass)
+  {
+    EZ_ASSERT_DEBUG(uiSizeClass < NumSizeClasses, "Invalid size class {}.", uiSizeClass);
+
+    if (uiSizeClass < 8)
+      return (uiSizeClass + 1) * 16;
+
+    const ezUInt32 uiHighBit = 7 + (uiSizeClass - 8) / 4;
+    return (5 + (uiSizeClass - 8) % 4) << (uiHighBit - 2);
+  }
+
+  // static
+  ezScalableHeapAllocation::ThreadData& ezScalableHeapAllocation::GetThreadData()
+  {
+    // once the thread local data has been destroyed during thread shutdown, m_bShutDown stays set and no heaps are handed out anymore
+    static thread_local ThreadData s_ThreadData;
+    return s_ThreadData;
+  }
+
+  // static
+  void ezScalableHeapAllocation::AbandonHeap(ezUInt64 uiInstanceId, ThreadHeap* pHeap)
+  {
+    EZ_LOCK(GetScalableHeapRegistryMutex());
+
+    // the allocator may already be destroyed, in that case its heaps are gone as well
+    for (ezScalableHeapAllocation* pInstance = s_pFirstScalableHeap; pInstance != nullptr; pInstance = pInstance->m_pNextInstance)
+    {
+      if (pInstance->m_uiInstanceId == uiInstanceId)
+      {
+        pHeap->m_iAbandoned.Set(1);
+        return;
+      }
+    }
+  }
+
+  ezScalableHeapAllocation::ThreadHeap* ezScalableHeapAllocation::GetThreadHeap(bool bCreate)
+  {
+    ThreadData& data = GetThreadData();
+
+    if (data.m_bShutDown)
+      return nullptr;
+
+    for (ThreadData::Entry& entry : data.m_Entries)
+    {
+      if (entry.m_uiInstanceId == m_uiInstanceId)
+        return entry.m_pHeap;
+    }
+
+    if (!bCreate)
+      return nullptr;
+
+    ThreadData::Entry* pEntry = nullptr;
+    for (ThreadData::Entry& entry : data.m_Entries)
+    {
+      if (entry.m_pHeap == nullptr)
+      {
+        pEntry = &entry;
+        break;
+      }
+    }
+
+    if (pEntry == nullptr)
+    {
+      pEntry = &data.m_Entries[data.m_uiNextEviction++ % MaxThreadHeaps];
+      AbandonHeap(pEntry->m_uiInstanceId, pEntry->m_pHeap);
+    }
+
+    pEntry->m_uiInstanceId = m_uiInstanceId;
+    pEntry->m_pHeap = AcquireHeap();
+    return pEntry->m_pHeap;
+  }
+
+  ezScalableHeapAllocation::ThreadHeap* ezScalableHeapAllocation::AcquireHeap()
+  {
+    EZ_LOCK(m_HeapMutex);
+
+    for (ThreadHeap* pHeap = m_pFirstHeap; pHeap != nullptr; pHeap = pHeap->m_pNextHeap)
+    {
+      if (pHeap->m_iAbandoned.TestAndSet(1, 0))
+        return pHeap;
+    }
+
+    ThreadHeap* pHeap = new (m_SystemAllocation.Allocate(sizeof(ThreadHeap), EZ_ALIGNMENT_OF(ThreadHeap))) ThreadHeap();
+    pHeap->m_pNextHeap = m_pFirstHeap;
+    m_pFirstHeap = pHeap;
+    return pHeap;
+  }
+
+  void* ezScalableHeapAllocation::AllocateSmallSlow(ThreadHeap* pHeap, ezUInt32 uiSizeClass)
+  {
+    while (true)
+    {
+      while (Span* pSpan = pHeap->m_PartialSpans[uiSizeClass])
+      {
+        if (pSpan->HasFreeBlocks())
+          return AllocateSmall(pHeap, uiSizeClass);
+
+        ezScalableHeapUnlinkSpan(pHeap->m_PartialSpans[uiSizeClass], pSpan);
+        ezScalableHeapLinkSpan(pHeap->m_FullSpans[uiSizeClass], pSpan);
+        pSpan->m_bFull = true;
+      }
+
+      // blocks freed by other threads may move full spans back to the partial list
+      if (!ReclaimRemoteFrees(pHeap))
+        break;
+    }
+
+    AllocateSpan(pHeap, uiSizeClass);
+    return AllocateSmall(pHeap, uiSizeClass);
+  }
+
+  void* ezScalableHeapAllocation::AllocateLarge(size_t uiSize)
+  {
+    // the header is padded to MaxAlignment, so that the returned memory fulfills any supported alignment
+    void* ptr = ezMemoryUtils::AddByteOffset(m_SystemAllocation.Allocate(MaxAlignment + uiSize, MaxAlignment), MaxAlignment);
+
+    LargeHeader* pHeader = static_cast<LargeHeader*>(ptr) - 1;
+    pHeader->m_uiSize = uiSize;
+
+    return ptr;
+  }
+
+  void ezScalableHeapAllocation::DeallocateLocal(ThreadHeap* pHeap, Span* pSpan, void* ptr)
+  {
+    FreeBlock* pBlock = static_cast<FreeBlock*>(ptr);
+    pBlock->m_pNext = pSpan->m_pFreeList;
+    pSpan->m_pFreeList = pBlock;
+    --pSpan->m_uiNumUsedBlocks;
+
+    const ezUInt32 uiSizeClass = pSpan->m_uiSizeClass;
+
+    if (pSpan->m_bFull)
+    {
+      ezScalableHeapUnlinkSpan(pHeap->m_FullSpans[uiSizeClass], pSpan);
+      ezScalableHeapLinkSpan(pHeap->m_PartialSpans[uiSizeClass], pSpan);
+      pSpan->m_bFull = false;
+    }
+    else if (pSpan->m_uiNumUsedBlocks == 0 && pHeap->m_PartialSpans[uiSizeClass] != pSpan)
+    {
+      // the span that allocations are served from is kept even when empty, to not allocate and free spans in quick succession
+      ezScalableHeapUnlinkSpan(pHeap->m_PartialSpans[uiSizeClass], pSpan);
+      ReleaseSpan(pHeap, pSpan);
+    }
+  }
+
+  void ezScalableHeapAllocation::DeallocateRemote(Span* pSpan, void* ptr)
+  {
+    // the span cannot be released while this block is in use, so its heap pointer is stable
+    ThreadHeap* pOwner = pSpan->m_pHeap;
+    FreeBlock* pBlock = static_cast<FreeBlock*>(ptr);
+
+    void* pHead;
+    do
+    {
+      pHead = pOwner->m_pRemoteFreeList;
+      pBlock->m_pNext = static_cast<FreeBlock*>(pHead);
+    } while (!ezAtomicUtils::TestAndSet(&pOwner->m_pRemoteFreeList, pHead, pBlock));
+  }
+
+  bool ezScalableHeapAllocation::ReclaimRemoteFrees(ThreadHeap* pHeap)
+  {
+    // only the owning thread takes blocks from the list and it always takes all of them, so there is no ABA problem
+    void* pList;
+    do
+    {
+      pList = pHeap->m_pRemoteFreeList;
+
+      if (pList == nullptr)
+        return false;
+
+    } while (!ezAtomicUtils::TestAndSet(&pHeap->m_pRemoteFreeList, pList, nullptr));
+
+    FreeBlock* pBlock = static_cast<FreeBlock*>(pList);
+    while (pBlock != nullptr)
+    {
+      FreeBlock* pNext = pBlock->m_pNext;
+      DeallocateLocal(pHeap, GetSpan(pBlock), pBlock);
+      pBlock = pNext;
+    }
+
+    return true;
+  }
+
+  ezScalableHeapAllocation::Span* ezScalableHeapAllocation::AllocateSpan(ThreadHeap* pHeap, ezUInt32 uiSizeClass)
+  {
+    Span* pSpan = static_cast<Span*>(m_SystemAllocation.Allocate(SpanSize, SpanSize));
+    ezMemoryUtils::ZeroFill(pSpan, 1);
+    ezScalableHeapMarkSpan(pSpan, true);
+    pSpan->m_pHeap = pHeap;
+    pSpan->m_pUnusedBlocks = reinterpret_cast<ezUInt8*>(pSpan) + SpanHeaderSize;
+    pSpan->m_uiSizeClass = uiSizeClass;
+    pSpan->m_uiBlockSize = GetSizeClassBlockSize(uiSizeClass);
+
+    // the new span becomes the one that allocations are served from
+    ezScalableHeapPushSpan(pHeap->m_PartialSpans[uiSizeClass], pSpan);
+
+    m_iNumSpans.Increment();
+    m_iNumSpanAllocations.Increment();
+    UpdateStats(pHeap);
+
+    return pSpan;
+  }
+
+  void ezScalableHeapAllocation::ReleaseSpan(ThreadHeap* pHeap, Span* pSpan)
+  {
+    // the range may be reused for large allocations right away
+    ezScalableHeapMarkSpan(pSpan, false);
+    m_SystemAllocation.Deallocate(pSpan);
+
+    m_iNumSpans.Decrement();
+    m_iNumSpanReleases.Increment();
+    UpdateStats(pHeap);
+  }
+
+  void ezScalableHeapAllocation::UpdateStats(ThreadHeap* pHeap)
+  {
+    m_iNumHits.Add(pHeap->m_uiNumHits);
+    pHeap->m_uiNumHits = 0;
+
+    if (m_AllocatorId.IsInvalidated())
+      return;
+
+    ezMemoryTracker::ThreadCacheStats stats;
+    stats.m_uiNumHits = m_iNumHits;
+    stats.m_uiNumMisses = m_iNumSpanAllocations;
+    stats.m_uiNumFlushes = m_iNumSpanReleases;
+    stats.m_uiCachedSize = m_iNumSpans * SpanSize;
+
+    ezMemoryTracker::SetThreadCacheStats(m_AllocatorId, stats);
+  }
+} // namespace ezMemoryPolicies
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Memory_Policies_ScalableHeapAllocation);
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Memory/Policies/AlignedHeapAllocation.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/Mutex.h>
+
+namespace ezMemoryPolicies
+{
+  /// \brief Scalable general purpose heap allocation policy.
+  ///
+  /// Small allocations are rounded up to one of NumSizeClasses size classes and are carved out of SpanSize bytes large spans.
+  /// Every thread gets its own heap, which owns one list of spans per size class. Allocating and freeing on the owning thread
+  /// only touches that heap and needs neither locks nor atomic operations. Blocks that are freed by another thread are pushed onto
+  /// a lock-free remote free list of the owning heap and are reclaimed once the owner runs out of free blocks.
+  /// Allocations larger than MaxSmallSize bytes go directly to the system allocator, with a small header in front of them.
+  /// A global map with one bit per SpanSize aligned address range tells the two kinds of allocations apart.
+  ///
+  /// The heap of a thread that exits is abandoned and adopted by the next thread that starts using the allocator, so short-lived
+  /// threads do not leak memory.
+  ///
+  /// A thread keeps heaps for at most MaxThreadHeaps allocator instances. When it starts using another one, the heap of the instance
+  /// that it started using longest ago is abandoned as well. No memory is lost that way, but the next allocation of that thread from that
+  /// instance needs to acquire a heap again, and its earlier blocks are freed like blocks of another thread. Code that uses many scalable
+  /// heaps on the same threads at the same time should use another allocator for some of them.
+  ///
+  /// \see ezScalableHeapAllocator
+  class EZ_FOUNDATION_DLL ezScalableHeapAllocation
+  {
+  public:
+    enum : ezUInt32
+    {
+      SpanSize = 64 * 1024,
+      SpanHeaderSize = 128,
+      MaxSmallSize = 16 * 1024,
+      NumSizeClasses = 36,
+      MaxSmallAlignment = 16,
+      MaxAlignment = SpanHeaderSize,
+      MaxThreadHeaps = 8,
+    };
+
+    ezScalableHeapAllocation(ezAllocatorBase* pParent);
+    ~ezScalableHeapAllocation();
+
+    void* Allocate(size_t uiSize, size_t uiAlign);
+    void* Reallocate(void* ptr, size_t uiCurrentSize, size_t uiNewSize, size_t uiAlign);
+    void Deallocate(void* ptr);
+
+    EZ_ALWAYS_INLINE ezAllocatorBase* GetParent() const { return nullptr; }
+
+    /// \brief Sets the id under which the thread heap statistics are reported to ezMemoryTracker::SetThreadCacheStats().
+    ///
+    /// Hits are allocations that were served from an existing span, misses are spans that had to be allocated,
+    /// flushes are spans that were returned to the system and the cached size is the memory currently held in spans.
+    void SetAllocatorId(ezAllocatorId id) { m_AllocatorId = id; }
+
+    /// \brief Returns the size class that an allocation of the given size is rounded up to.
+    static ezUInt32 GetSizeClass(size_t uiSize);
+
+    /// \brief Returns the block size of the given size class.
+    static ezUInt32 GetSizeClassBlockSize(ezUInt32 uiSizeClass);
+
+  private:
+    struct FreeBlock;
+    struct Span;
+    struct LargeHeader;
+    struct ThreadHeap;
+    struct ThreadData;
+
+    static Span* GetSpan(const void* ptr);
+    static LargeHeader* GetLargeHeader(const void* ptr);
+    static ThreadData& GetThreadData();
+    static void AbandonHeap(ezUInt64 uiInstanceId, ThreadHeap* pHeap);
+
+    ThreadHeap* GetThreadHeap(bool bCreate);
+    ThreadHeap* AcquireHeap();
+
+    void* AllocateSmall(ThreadHeap* pHeap, ezUInt32 uiSizeClass);
+    void* AllocateSmallSlow(ThreadHeap* pHeap, ezUInt32 uiSizeClass);
+    void* AllocateLarge(size_t uiSize);
+    void DeallocateLocal(ThreadHeap* pHeap, Span* pSpan, void* ptr);
+    void DeallocateRemote(Span* pSpan, void* ptr);
+    bool ReclaimRemoteFrees(ThreadHeap* pHeap);
+
+    Span* AllocateSpan(ThreadHeap* pHeap, ezUInt32 uiSizeClass);
+    void ReleaseSpan(ThreadHeap* pHeap, Span* pSpan);
+    void UpdateStats(ThreadHeap* pHeap);
+
+    ezAlignedHeapAllocation m_SystemAllocation;
+    ezAllocatorId m_AllocatorId;
+    ezUInt64 m_uiInstanceId = 0;
+    ezScalableHeapAllocation* m_pNextInstance = nullptr;
+
+    ezMutex m_HeapMutex;
+    ThreadHeap* m_pFirstHeap = nullptr;
+
+    ezAtomicInteger64 m_iNumHits;
+    ezAtomicInteger64 m_iNumSpanAllocations;
+    ezAtomicInteger64 m_iNumSpanReleases;
+    ezAtomicInteger64 m_iNumSpans;
+  };
+} // namespace ezMemoryPolicies
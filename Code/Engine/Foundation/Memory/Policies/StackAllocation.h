@@ -92,6 +92,16 @@ namespace ezMemoryPolicies
       m_pNextAllocation = !m_Buckets.IsEmpty() ? m_Buckets[0].GetPtr() : nullptr;
     }
 
+    /// \brief Overwrites all memory that was handed out since the last reset with a fixed pattern.
+    void PoisonMemory()
+    {
+      for (ezUInt32 i = 0; i <= m_uiCurrentBucketIndex && i < m_Buckets.GetCount(); ++i)
+      {
+        ezUInt8* pEnd = i == m_uiCurrentBucketIndex ? m_pNextAllocation : m_Buckets[i].GetEndPtr();
+        ezMemoryUtils::PatternFill(m_Buckets[i].GetPtr(), 0xCD, pEnd - m_Buckets[i].GetPtr());
+      }
+    }
+
     EZ_FORCE_INLINE void FillStats(ezAllocatorBase::Stats& stats)
     {
       stats.m_uiNumAllocations = m_Buckets.GetCount();
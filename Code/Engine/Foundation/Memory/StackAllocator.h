@@ -7,7 +7,10 @@
 #include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/Mutex.h>
 
-template <ezUInt32 TrackingFlags = ezMemoryTrackingFlags::Default>
+/// \brief An allocator that hands out memory like a stack and frees everything at once on Reset().
+///
+/// MutexType can be ezNoMutex when the allocator is only used by one thread at a time, which removes all locking.
+template <ezUInt32 TrackingFlags = ezMemoryTrackingFlags::Default, typename MutexType = ezMutex>
 class ezStackAllocator : public ezAllocator<ezMemoryPolicies::ezStackAllocation, TrackingFlags>
 {
 public:
@@ -19,7 +22,9 @@ public:
 
   /// \brief
   ///   Resets the allocator freeing all memory.
-  void Reset();
+  ///
+  /// If bPoisonMemory is set, the freed memory is overwritten with a pattern, so that accesses to data that is not alive anymore show up.
+  void Reset(bool bPoisonMemory = false);
 
 private:
   struct DestructData
@@ -30,7 +35,7 @@ private:
     void* m_Ptr;
   };
 
-  ezMutex m_Mutex;
+  MutexType m_Mutex;
   ezDynamicArray<DestructData> m_DestructData;
   ezHashTable<void*, ezUInt32> m_PtrToDestructDataIndexTable;
 };
@@ -5,9 +5,9 @@
 
 #include <Foundation/Communication/Message.h>
 #include <Foundation/Configuration/Startup.h>
-#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Containers/SwissHashTable.h>
 
-typedef ezHashTable<const char*, ezRTTI*, ezHashHelper<const char*>, ezStaticAllocatorWrapper> ezTypeHashTable;
+typedef ezSwissHashTable<const char*, ezRTTI*, ezHashHelper<const char*>, ezStaticAllocatorWrapper> ezTypeHashTable;
 
 EZ_ENUMERABLE_CLASS_IMPLEMENTATION(ezRTTI);
 
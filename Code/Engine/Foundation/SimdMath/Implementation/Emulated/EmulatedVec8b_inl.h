@@ -0,0 +1,83 @@
+#pragma once
+
+EZ_ALWAYS_INLINE ezSimdVec8b::ezSimdVec8b() {}
+
+EZ_ALWAYS_INLINE ezSimdVec8b::ezSimdVec8b(bool b)
+{
+  m_v.m_lo = ezSimdVec4b(b).m_v;
+  m_v.m_hi = m_v.m_lo;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b::ezSimdVec8b(const ezSimdVec4b& lo, const ezSimdVec4b& hi)
+{
+  m_v.m_lo = lo.m_v;
+  m_v.m_hi = hi.m_v;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b::ezSimdVec8b(ezInternal::OctBool v)
+{
+  m_v = v;
+}
+
+template <int N>
+EZ_ALWAYS_INLINE bool ezSimdVec8b::GetComponent() const
+{
+  return N < 4 ? GetLow().GetComponent<N & 3>() : GetHigh().GetComponent<N & 3>();
+}
+
+EZ_ALWAYS_INLINE ezSimdVec4b ezSimdVec8b::GetLow() const
+{
+  return m_v.m_lo;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec4b ezSimdVec8b::GetHigh() const
+{
+  return m_v.m_hi;
+}
+
+EZ_ALWAYS_INLINE ezUInt32 ezSimdVec8b::GetMask() const
+{
+  const ezSimdVec4b lo = GetLow();
+  const ezSimdVec4b hi = GetHigh();
+
+  ezUInt32 uiMask = 0;
+  uiMask |= lo.x() ? EZ_BIT(0) : 0;
+  uiMask |= lo.y() ? EZ_BIT(1) : 0;
+  uiMask |= lo.z() ? EZ_BIT(2) : 0;
+  uiMask |= lo.w() ? EZ_BIT(3) : 0;
+  uiMask |= hi.x() ? EZ_BIT(4) : 0;
+  uiMask |= hi.y() ? EZ_BIT(5) : 0;
+  uiMask |= hi.z() ? EZ_BIT(6) : 0;
+  uiMask |= hi.w() ? EZ_BIT(7) : 0;
+  return uiMask;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8b::operator&&(const ezSimdVec8b& rhs) const
+{
+  return ezSimdVec8b(GetLow() && rhs.GetLow(), GetHigh() && rhs.GetHigh());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8b::operator||(const ezSimdVec8b& rhs) const
+{
+  return ezSimdVec8b(GetLow() || rhs.GetLow(), GetHigh() || rhs.GetHigh());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8b::operator!() const
+{
+  return ezSimdVec8b(!GetLow(), !GetHigh());
+}
+
+EZ_ALWAYS_INLINE bool ezSimdVec8b::AllSet() const
+{
+  return GetLow().AllSet<4>() && GetHigh().AllSet<4>();
+}
+
+EZ_ALWAYS_INLINE bool ezSimdVec8b::AnySet() const
+{
+  return GetLow().AnySet<4>() || GetHigh().AnySet<4>();
+}
+
+EZ_ALWAYS_INLINE bool ezSimdVec8b::NoneSet() const
+{
+  return GetLow().NoneSet<4>() && GetHigh().NoneSet<4>();
+}
@@ -0,0 +1,239 @@
+#pragma once
+
+EZ_ALWAYS_INLINE ezSimdVec8f::ezSimdVec8f() {}
+
+EZ_ALWAYS_INLINE ezSimdVec8f::ezSimdVec8f(float f)
+{
+  Set(f);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f::ezSimdVec8f(const ezSimdVec4f& lo, const ezSimdVec4f& hi)
+{
+  m_v.m_lo = lo.m_v;
+  m_v.m_hi = hi.m_v;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f::ezSimdVec8f(ezInternal::OctFloat v)
+{
+  m_v = v;
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8f::Set(float f)
+{
+  m_v.m_lo = ezSimdVec4f(f).m_v;
+  m_v.m_hi = m_v.m_lo;
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8f::SetZero()
+{
+  m_v.m_lo = ezSimdVec4f::ZeroVector().m_v;
+  m_v.m_hi = m_v.m_lo;
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8f::Load(const float* pFloats)
+{
+  ezSimdVec4f lo, hi;
+  lo.Load<4>(pFloats);
+  hi.Load<4>(pFloats + 4);
+
+  m_v.m_lo = lo.m_v;
+  m_v.m_hi = hi.m_v;
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8f::Store(float* pFloats) const
+{
+  GetLow().Store<4>(pFloats);
+  GetHigh().Store<4>(pFloats + 4);
+}
+
+template <ezMathAcc::Enum acc>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetReciprocal() const
+{
+  return ezSimdVec8f(GetLow().GetReciprocal<acc>(), GetHigh().GetReciprocal<acc>());
+}
+
+template <ezMathAcc::Enum acc>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetSqrt() const
+{
+  return ezSimdVec8f(GetLow().GetSqrt<acc>(), GetHigh().GetSqrt<acc>());
+}
+
+template <ezMathAcc::Enum acc>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetInvSqrt() const
+{
+  return ezSimdVec8f(GetLow().GetInvSqrt<acc>(), GetHigh().GetInvSqrt<acc>());
+}
+
+template <int N>
+EZ_ALWAYS_INLINE float ezSimdVec8f::GetComponent() const
+{
+  return N < 4 ? GetLow().GetComponent<N & 3>() : GetHigh().GetComponent<N & 3>();
+}
+
+EZ_ALWAYS_INLINE ezSimdVec4f ezSimdVec8f::GetLow() const
+{
+  return m_v.m_lo;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec4f ezSimdVec8f::GetHigh() const
+{
+  return m_v.m_hi;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::operator-() const
+{
+  return ezSimdVec8f(-GetLow(), -GetHigh());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::operator+(const ezSimdVec8f& v) const
+{
+  return ezSimdVec8f(GetLow() + v.GetLow(), GetHigh() + v.GetHigh());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::operator-(const ezSimdVec8f& v) const
+{
+  return ezSimdVec8f(GetLow() - v.GetLow(), GetHigh() - v.GetHigh());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::operator*(float f) const
+{
+  const ezSimdFloat s(f);
+  return ezSimdVec8f(GetLow() * s, GetHigh() * s);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::operator/(float f) const
+{
+  const ezSimdFloat s(f);
+  return ezSimdVec8f(GetLow() / s, GetHigh() / s);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::CompMul(const ezSimdVec8f& v) const
+{
+  return ezSimdVec8f(GetLow().CompMul(v.GetLow()), GetHigh().CompMul(v.GetHigh()));
+}
+
+template <ezMathAcc::Enum acc>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::CompDiv(const ezSimdVec8f& v) const
+{
+  return ezSimdVec8f(GetLow().CompDiv<acc>(v.GetLow()), GetHigh().CompDiv<acc>(v.GetHigh()));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::CompMin(const ezSimdVec8f& rhs) const
+{
+  return ezSimdVec8f(GetLow().CompMin(rhs.GetLow()), GetHigh().CompMin(rhs.GetHigh()));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::CompMax(const ezSimdVec8f& rhs) const
+{
+  return ezSimdVec8f(GetLow().CompMax(rhs.GetLow()), GetHigh().CompMax(rhs.GetHigh()));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::Abs() const
+{
+  return ezSimdVec8f(GetLow().Abs(), GetHigh().Abs());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::Floor() const
+{
+  return ezSimdVec8f(GetLow().Floor(), GetHigh().Floor());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::Ceil() const
+{
+  return ezSimdVec8f(GetLow().Ceil(), GetHigh().Ceil());
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::Select(const ezSimdVec8b& cmp, const ezSimdVec8f& ifTrue, const ezSimdVec8f& ifFalse)
+{
+  return ezSimdVec8f(ezSimdVec4f::Select(cmp.GetLow(), ifTrue.GetLow(), ifFalse.GetLow()), ezSimdVec4f::Select(cmp.GetHigh(), ifTrue.GetHigh(), ifFalse.GetHigh()));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f& ezSimdVec8f::operator+=(const ezSimdVec8f& v)
+{
+  *this = *this + v;
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f& ezSimdVec8f::operator-=(const ezSimdVec8f& v)
+{
+  *this = *this - v;
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f& ezSimdVec8f::operator*=(float f)
+{
+  *this = *this * f;
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f& ezSimdVec8f::operator/=(float f)
+{
+  *this = *this / f;
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator==(const ezSimdVec8f& v) const
+{
+  return ezSimdVec8b(GetLow() == v.GetLow(), GetHigh() == v.GetHigh());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator!=(const ezSimdVec8f& v) const
+{
+  return ezSimdVec8b(GetLow() != v.GetLow(), GetHigh() != v.GetHigh());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator<=(const ezSimdVec8f& v) const
+{
+  return ezSimdVec8b(GetLow() <= v.GetLow(), GetHigh() <= v.GetHigh());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator<(const ezSimdVec8f& v) const
+{
+  return ezSimdVec8b(GetLow() < v.GetLow(), GetHigh() < v.GetHigh());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator>=(const ezSimdVec8f& v) const
+{
+  return ezSimdVec8b(GetLow() >= v.GetLow(), GetHigh() >= v.GetHigh());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator>(const ezSimdVec8f& v) const
+{
+  return ezSimdVec8b(GetLow() > v.GetLow(), GetHigh() > v.GetHigh());
+}
+
+EZ_ALWAYS_INLINE ezSimdFloat ezSimdVec8f::HorizontalSum() const
+{
+  return (GetLow() + GetHigh()).HorizontalSum<4>();
+}
+
+EZ_ALWAYS_INLINE ezSimdFloat ezSimdVec8f::HorizontalMin() const
+{
+  return GetLow().CompMin(GetHigh()).HorizontalMin<4>();
+}
+
+EZ_ALWAYS_INLINE ezSimdFloat ezSimdVec8f::HorizontalMax() const
+{
+  return GetLow().CompMax(GetHigh()).HorizontalMax<4>();
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::ZeroVector()
+{
+  ezSimdVec8f result;
+  result.SetZero();
+  return result;
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::MulAdd(const ezSimdVec8f& a, const ezSimdVec8f& b, const ezSimdVec8f& c)
+{
+  return ezSimdVec8f(ezSimdVec4f::MulAdd(a.GetLow(), b.GetLow(), c.GetLow()), ezSimdVec4f::MulAdd(a.GetHigh(), b.GetHigh(), c.GetHigh()));
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::MulSub(const ezSimdVec8f& a, const ezSimdVec8f& b, const ezSimdVec8f& c)
+{
+  return ezSimdVec8f(ezSimdVec4f::MulSub(a.GetLow(), b.GetLow(), c.GetLow()), ezSimdVec4f::MulSub(a.GetHigh(), b.GetHigh(), c.GetHigh()));
+}
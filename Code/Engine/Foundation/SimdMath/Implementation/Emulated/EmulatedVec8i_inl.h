@@ -0,0 +1,200 @@
+#pragma once
+
+EZ_ALWAYS_INLINE ezSimdVec8i::ezSimdVec8i() {}
+
+EZ_ALWAYS_INLINE ezSimdVec8i::ezSimdVec8i(ezInt32 i)
+{
+  Set(i);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i::ezSimdVec8i(const ezSimdVec4i& lo, const ezSimdVec4i& hi)
+{
+  m_v.m_lo = lo.m_v;
+  m_v.m_hi = hi.m_v;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i::ezSimdVec8i(ezInternal::OctInt v)
+{
+  m_v = v;
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8i::Set(ezInt32 i)
+{
+  m_v.m_lo = ezSimdVec4i(i).m_v;
+  m_v.m_hi = m_v.m_lo;
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8i::SetZero()
+{
+  m_v.m_lo = ezSimdVec4i::ZeroVector().m_v;
+  m_v.m_hi = m_v.m_lo;
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8i::Load(const ezInt32* pInts)
+{
+  m_v.m_lo = ezSimdVec4i(pInts[0], pInts[1], pInts[2], pInts[3]).m_v;
+  m_v.m_hi = ezSimdVec4i(pInts[4], pInts[5], pInts[6], pInts[7]).m_v;
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8i::Store(ezInt32* pInts) const
+{
+  const ezSimdVec4i lo = GetLow();
+  const ezSimdVec4i hi = GetHigh();
+
+  pInts[0] = lo.x();
+  pInts[1] = lo.y();
+  pInts[2] = lo.z();
+  pInts[3] = lo.w();
+  pInts[4] = hi.x();
+  pInts[5] = hi.y();
+  pInts[6] = hi.z();
+  pInts[7] = hi.w();
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8i::ToFloat() const
+{
+  return ezSimdVec8f(GetLow().ToFloat(), GetHigh().ToFloat());
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::Truncate(const ezSimdVec8f& f)
+{
+  return ezSimdVec8i(ezSimdVec4i::Truncate(f.GetLow()), ezSimdVec4i::Truncate(f.GetHigh()));
+}
+
+template <int N>
+EZ_ALWAYS_INLINE ezInt32 ezSimdVec8i::GetComponent() const
+{
+  return N < 4 ? GetLow().GetComponent<N & 3>() : GetHigh().GetComponent<N & 3>();
+}
+
+EZ_ALWAYS_INLINE ezSimdVec4i ezSimdVec8i::GetLow() const
+{
+  return m_v.m_lo;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec4i ezSimdVec8i::GetHigh() const
+{
+  return m_v.m_hi;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator-() const
+{
+  return ezSimdVec8i(-GetLow(), -GetHigh());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator+(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8i(GetLow() + v.GetLow(), GetHigh() + v.GetHigh());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator-(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8i(GetLow() - v.GetLow(), GetHigh() - v.GetHigh());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::CompMul(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8i(GetLow().CompMul(v.GetLow()), GetHigh().CompMul(v.GetHigh()));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator|(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8i(GetLow() | v.GetLow(), GetHigh() | v.GetHigh());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator&(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8i(GetLow() & v.GetLow(), GetHigh() & v.GetHigh());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator^(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8i(GetLow() ^ v.GetLow(), GetHigh() ^ v.GetHigh());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator~() const
+{
+  return ezSimdVec8i(~GetLow(), ~GetHigh());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator<<(ezUInt32 uiShift) const
+{
+  return ezSimdVec8i(GetLow() << uiShift, GetHigh() << uiShift);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator>>(ezUInt32 uiShift) const
+{
+  return ezSimdVec8i(GetLow() >> uiShift, GetHigh() >> uiShift);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i& ezSimdVec8i::operator+=(const ezSimdVec8i& v)
+{
+  *this = *this + v;
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i& ezSimdVec8i::operator-=(const ezSimdVec8i& v)
+{
+  *this = *this - v;
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::CompMin(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8i(GetLow().CompMin(v.GetLow()), GetHigh().CompMin(v.GetHigh()));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::CompMax(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8i(GetLow().CompMax(v.GetLow()), GetHigh().CompMax(v.GetHigh()));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::Abs() const
+{
+  return ezSimdVec8i(GetLow().Abs(), GetHigh().Abs());
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::Select(const ezSimdVec8b& cmp, const ezSimdVec8i& ifTrue, const ezSimdVec8i& ifFalse)
+{
+  return ezSimdVec8i(ezSimdVec4i::Select(cmp.GetLow(), ifTrue.GetLow(), ifFalse.GetLow()), ezSimdVec4i::Select(cmp.GetHigh(), ifTrue.GetHigh(), ifFalse.GetHigh()));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8i::operator==(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8b(GetLow() == v.GetLow(), GetHigh() == v.GetHigh());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8i::operator!=(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8b(GetLow() != v.GetLow(), GetHigh() != v.GetHigh());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8i::operator<=(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8b(GetLow() <= v.GetLow(), GetHigh() <= v.GetHigh());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8i::operator<(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8b(GetLow() < v.GetLow(), GetHigh() < v.GetHigh());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8i::operator>=(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8b(GetLow() >= v.GetLow(), GetHigh() >= v.GetHigh());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8i::operator>(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8b(GetLow() > v.GetLow(), GetHigh() > v.GetHigh());
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::ZeroVector()
+{
+  ezSimdVec8i result;
+  result.SetZero();
+  return result;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+EZ_ALWAYS_INLINE ezSimdVec8b::ezSimdVec8b() {}
+
+EZ_ALWAYS_INLINE ezSimdVec8b::ezSimdVec8b(bool b)
+{
+  m_v = _mm256_castsi256_ps(_mm256_set1_epi32(b ? -1 : 0));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b::ezSimdVec8b(const ezSimdVec4b& lo, const ezSimdVec4b& hi)
+{
+  m_v = _mm256_insertf128_ps(_mm256_castps128_ps256(lo.m_v), hi.m_v, 1);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b::ezSimdVec8b(ezInternal::OctBool v)
+{
+  m_v = v;
+}
+
+template <int N>
+EZ_ALWAYS_INLINE bool ezSimdVec8b::GetComponent() const
+{
+  return (_mm256_movemask_ps(m_v) & EZ_BIT(N)) != 0;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec4b ezSimdVec8b::GetLow() const
+{
+  return _mm256_castps256_ps128(m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec4b ezSimdVec8b::GetHigh() const
+{
+  return _mm256_extractf128_ps(m_v, 1);
+}
+
+EZ_ALWAYS_INLINE ezUInt32 ezSimdVec8b::GetMask() const
+{
+  return static_cast<ezUInt32>(_mm256_movemask_ps(m_v));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8b::operator&&(const ezSimdVec8b& rhs) const
+{
+  return _mm256_and_ps(m_v, rhs.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8b::operator||(const ezSimdVec8b& rhs) const
+{
+  return _mm256_or_ps(m_v, rhs.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8b::operator!() const
+{
+  return _mm256_xor_ps(m_v, _mm256_castsi256_ps(_mm256_set1_epi32(-1)));
+}
+
+EZ_ALWAYS_INLINE bool ezSimdVec8b::AllSet() const
+{
+  return _mm256_movemask_ps(m_v) == 0xFF;
+}
+
+EZ_ALWAYS_INLINE bool ezSimdVec8b::AnySet() const
+{
+  return _mm256_movemask_ps(m_v) != 0;
+}
+
+EZ_ALWAYS_INLINE bool ezSimdVec8b::NoneSet() const
+{
+  return _mm256_movemask_ps(m_v) == 0;
+}
@@ -0,0 +1,284 @@
+#pragma once
+
+EZ_ALWAYS_INLINE ezSimdVec8f::ezSimdVec8f()
+{
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+  // Initialize all data to NaN in debug mode to find problems with uninitialized data easier.
+  m_v = _mm256_set1_ps(ezMath::NaN<float>());
+#endif
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f::ezSimdVec8f(float f)
+{
+  m_v = _mm256_set1_ps(f);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f::ezSimdVec8f(const ezSimdVec4f& lo, const ezSimdVec4f& hi)
+{
+  m_v = _mm256_insertf128_ps(_mm256_castps128_ps256(lo.m_v), hi.m_v, 1);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f::ezSimdVec8f(ezInternal::OctFloat v)
+{
+  m_v = v;
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8f::Set(float f)
+{
+  m_v = _mm256_set1_ps(f);
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8f::SetZero()
+{
+  m_v = _mm256_setzero_ps();
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8f::Load(const float* pFloats)
+{
+  m_v = _mm256_loadu_ps(pFloats);
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8f::Store(float* pFloats) const
+{
+  _mm256_storeu_ps(pFloats, m_v);
+}
+
+template <>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetReciprocal<ezMathAcc::BITS_12>() const
+{
+  return _mm256_rcp_ps(m_v);
+}
+
+template <>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetReciprocal<ezMathAcc::BITS_23>() const
+{
+  __m256 x0 = _mm256_rcp_ps(m_v);
+
+  // One Newton-Raphson iteration
+  __m256 x1 = _mm256_mul_ps(x0, _mm256_fnmadd_ps(m_v, x0, _mm256_set1_ps(2.0f)));
+
+  return x1;
+}
+
+template <>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetReciprocal<ezMathAcc::FULL>() const
+{
+  return _mm256_div_ps(_mm256_set1_ps(1.0f), m_v);
+}
+
+template <>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetInvSqrt<ezMathAcc::FULL>() const
+{
+  return _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(m_v));
+}
+
+template <>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetInvSqrt<ezMathAcc::BITS_23>() const
+{
+  const __m256 x0 = _mm256_rsqrt_ps(m_v);
+
+  // One Newton-Raphson iteration
+  const __m256 x1 = _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), x0), _mm256_fnmadd_ps(_mm256_mul_ps(m_v, x0), x0, _mm256_set1_ps(3.0f)));
+
+  return x1;
+}
+
+template <>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetInvSqrt<ezMathAcc::BITS_12>() const
+{
+  return _mm256_rsqrt_ps(m_v);
+}
+
+template <>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetSqrt<ezMathAcc::FULL>() const
+{
+  return _mm256_sqrt_ps(m_v);
+}
+
+template <>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetSqrt<ezMathAcc::BITS_23>() const
+{
+  return CompMul(GetInvSqrt<ezMathAcc::BITS_23>());
+}
+
+template <>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetSqrt<ezMathAcc::BITS_12>() const
+{
+  return CompMul(GetInvSqrt<ezMathAcc::BITS_12>());
+}
+
+template <int N>
+EZ_ALWAYS_INLINE float ezSimdVec8f::GetComponent() const
+{
+  return N < 4 ? GetLow().GetComponent<N & 3>() : GetHigh().GetComponent<N & 3>();
+}
+
+EZ_ALWAYS_INLINE ezSimdVec4f ezSimdVec8f::GetLow() const
+{
+  return _mm256_castps256_ps128(m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec4f ezSimdVec8f::GetHigh() const
+{
+  return _mm256_extractf128_ps(m_v, 1);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::operator-() const
+{
+  return _mm256_sub_ps(_mm256_setzero_ps(), m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::operator+(const ezSimdVec8f& v) const
+{
+  return _mm256_add_ps(m_v, v.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::operator-(const ezSimdVec8f& v) const
+{
+  return _mm256_sub_ps(m_v, v.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::operator*(float f) const
+{
+  return _mm256_mul_ps(m_v, _mm256_set1_ps(f));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::operator/(float f) const
+{
+  return _mm256_div_ps(m_v, _mm256_set1_ps(f));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::CompMul(const ezSimdVec8f& v) const
+{
+  return _mm256_mul_ps(m_v, v.m_v);
+}
+
+template <>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::CompDiv<ezMathAcc::FULL>(const ezSimdVec8f& v) const
+{
+  return _mm256_div_ps(m_v, v.m_v);
+}
+
+template <ezMathAcc::Enum acc>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::CompDiv(const ezSimdVec8f& v) const
+{
+  return CompMul(v.GetReciprocal<acc>());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::CompMin(const ezSimdVec8f& rhs) const
+{
+  return _mm256_min_ps(m_v, rhs.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::CompMax(const ezSimdVec8f& rhs) const
+{
+  return _mm256_max_ps(m_v, rhs.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::Abs() const
+{
+  return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::Floor() const
+{
+  return _mm256_round_ps(m_v, _MM_FROUND_FLOOR);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::Ceil() const
+{
+  return _mm256_round_ps(m_v, _MM_FROUND_CEIL);
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::Select(const ezSimdVec8b& cmp, const ezSimdVec8f& ifTrue, const ezSimdVec8f& ifFalse)
+{
+  return _mm256_blendv_ps(ifFalse.m_v, ifTrue.m_v, cmp.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f& ezSimdVec8f::operator+=(const ezSimdVec8f& v)
+{
+  m_v = _mm256_add_ps(m_v, v.m_v);
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f& ezSimdVec8f::operator-=(const ezSimdVec8f& v)
+{
+  m_v = _mm256_sub_ps(m_v, v.m_v);
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f& ezSimdVec8f::operator*=(float f)
+{
+  m_v = _mm256_mul_ps(m_v, _mm256_set1_ps(f));
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f& ezSimdVec8f::operator/=(float f)
+{
+  m_v = _mm256_div_ps(m_v, _mm256_set1_ps(f));
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator==(const ezSimdVec8f& v) const
+{
+  return _mm256_cmp_ps(m_v, v.m_v, _CMP_EQ_OQ);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator!=(const ezSimdVec8f& v) const
+{
+  return _mm256_cmp_ps(m_v, v.m_v, _CMP_NEQ_UQ);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator<=(const ezSimdVec8f& v) const
+{
+  return _mm256_cmp_ps(m_v, v.m_v, _CMP_LE_OQ);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator<(const ezSimdVec8f& v) const
+{
+  return _mm256_cmp_ps(m_v, v.m_v, _CMP_LT_OQ);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator>=(const ezSimdVec8f& v) const
+{
+  return _mm256_cmp_ps(m_v, v.m_v, _CMP_GE_OQ);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator>(const ezSimdVec8f& v) const
+{
+  return _mm256_cmp_ps(m_v, v.m_v, _CMP_GT_OQ);
+}
+
+EZ_ALWAYS_INLINE ezSimdFloat ezSimdVec8f::HorizontalSum() const
+{
+  return (GetLow() + GetHigh()).HorizontalSum<4>();
+}
+
+EZ_ALWAYS_INLINE ezSimdFloat ezSimdVec8f::HorizontalMin() const
+{
+  return GetLow().CompMin(GetHigh()).HorizontalMin<4>();
+}
+
+EZ_ALWAYS_INLINE ezSimdFloat ezSimdVec8f::HorizontalMax() const
+{
+  return GetLow().CompMax(GetHigh()).HorizontalMax<4>();
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::ZeroVector()
+{
+  return _mm256_setzero_ps();
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::MulAdd(const ezSimdVec8f& a, const ezSimdVec8f& b, const ezSimdVec8f& c)
+{
+  return _mm256_fmadd_ps(a.m_v, b.m_v, c.m_v);
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::MulSub(const ezSimdVec8f& a, const ezSimdVec8f& b, const ezSimdVec8f& c)
+{
+  return _mm256_fmsub_ps(a.m_v, b.m_v, c.m_v);
+}
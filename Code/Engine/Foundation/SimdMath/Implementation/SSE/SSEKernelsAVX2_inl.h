@@ -0,0 +1,152 @@
+#pragma once
+
+#include <immintrin.h>
+
+// These kernels are compiled for AVX2 and FMA, even when the rest of the engine is not.
+// They must only be called after ezSimdKernels::IsBackendSupported() confirmed that the CPU supports these instructions.
+#if EZ_ENABLED(EZ_COMPILER_MSVC_PURE)
+#  define EZ_AVX2_TARGET
+#else
+#  define EZ_AVX2_TARGET __attribute__((target("avx2,fma")))
+#endif
+
+namespace
+{
+  EZ_AVX2_TARGET void ezTransformPositionsAVX2(const ezSimdMat4f& mTransform, const ezSimdVec4f* pIn, ezSimdVec4f* pOut, ezUInt32 uiCount)
+  {
+    // every 256 bit register holds two vectors, so every column is duplicated into both halves
+    const __m256 col0 = _mm256_broadcast_ps(&mTransform.m_col0.m_v);
+    const __m256 col1 = _mm256_broadcast_ps(&mTransform.m_col1.m_v);
+    const __m256 col2 = _mm256_broadcast_ps(&mTransform.m_col2.m_v);
+    const __m256 col3 = _mm256_broadcast_ps(&mTransform.m_col3.m_v);
+
+    ezUInt32 i = 0;
+    for (; i + 2 <= uiCount; i += 2)
+    {
+      const __m256 v = _mm256_loadu_ps(reinterpret_cast<const float*>(pIn + i));
+
+      __m256 result = _mm256_fmadd_ps(_mm256_permute_ps(v, EZ_SHUFFLE(2, 2, 2, 2)), col2, col3);
+      result = _mm256_fmadd_ps(_mm256_permute_ps(v, EZ_SHUFFLE(1, 1, 1, 1)), col1, result);
+      result = _mm256_fmadd_ps(_mm256_permute_ps(v, EZ_SHUFFLE(0, 0, 0, 0)), col0, result);
+
+      _mm256_storeu_ps(reinterpret_cast<float*>(pOut + i), result);
+    }
+
+    if (i < uiCount)
+    {
+      pOut[i] = mTransform.TransformPosition(pIn[i]);
+    }
+  }
+
+  EZ_AVX2_TARGET void ezTransformDirectionsAVX2(const ezSimdMat4f& mTransform, const ezSimdVec4f* pIn, ezSimdVec4f* pOut, ezUInt32 uiCount)
+  {
+    const __m256 col0 = _mm256_broadcast_ps(&mTransform.m_col0.m_v);
+    const __m256 col1 = _mm256_broadcast_ps(&mTransform.m_col1.m_v);
+    const __m256 col2 = _mm256_broadcast_ps(&mTransform.m_col2.m_v);
+
+    ezUInt32 i = 0;
+    for (; i + 2 <= uiCount; i += 2)
+    {
+      const __m256 v = _mm256_loadu_ps(reinterpret_cast<const float*>(pIn + i));
+
+      __m256 result = _mm256_mul_ps(_mm256_permute_ps(v, EZ_SHUFFLE(2, 2, 2, 2)), col2);
+      result = _mm256_fmadd_ps(_mm256_permute_ps(v, EZ_SHUFFLE(1, 1, 1, 1)), col1, result);
+      result = _mm256_fmadd_ps(_mm256_permute_ps(v, EZ_SHUFFLE(0, 0, 0, 0)), col0, result);
+
+      _mm256_storeu_ps(reinterpret_cast<float*>(pOut + i), result);
+    }
+
+    if (i < uiCount)
+    {
+      pOut[i] = mTransform.TransformDirection(pIn[i]);
+    }
+  }
+
+  EZ_AVX2_TARGET ezUInt32 ezCullSpheresAVX2(const ezSimdVec4f* pPlanes, ezUInt32 uiNumPlanes, const ezSimdBSphere* pSpheres, ezUInt32 uiNumSpheres, ezUInt32* pOutVisibleIndices)
+  {
+    const float* pPlaneData = reinterpret_cast<const float*>(pPlanes);
+
+    ezUInt32 uiNumVisible = 0;
+    ezUInt32 i = 0;
+
+    for (; i + 8 <= uiNumSpheres; i += 8)
+    {
+      // transpose 8 spheres into one register per component, sphere k and k + 4 share a register before the transpose
+      const ezSimdVec4f* s = &pSpheres[i].m_CenterAndRadius;
+      const __m256 a = _mm256_insertf128_ps(_mm256_castps128_ps256(s[0].m_v), s[4].m_v, 1);
+      const __m256 b = _mm256_insertf128_ps(_mm256_castps128_ps256(s[1].m_v), s[5].m_v, 1);
+      const __m256 c = _mm256_insertf128_ps(_mm256_castps128_ps256(s[2].m_v), s[6].m_v, 1);
+      const __m256 d = _mm256_insertf128_ps(_mm256_castps128_ps256(s[3].m_v), s[7].m_v, 1);
+
+      const __m256 ab0 = _mm256_unpacklo_ps(a, b);
+      const __m256 ab1 = _mm256_unpackhi_ps(a, b);
+      const __m256 cd0 = _mm256_unpacklo_ps(c, d);
+      const __m256 cd1 = _mm256_unpackhi_ps(c, d);
+
+      const __m256 x = _mm256_shuffle_ps(ab0, cd0, EZ_SHUFFLE(0, 1, 0, 1));
+      const __m256 y = _mm256_shuffle_ps(ab0, cd0, EZ_SHUFFLE(2, 3, 2, 3));
+      const __m256 z = _mm256_shuffle_ps(ab1, cd1, EZ_SHUFFLE(0, 1, 0, 1));
+      const __m256 r = _mm256_shuffle_ps(ab1, cd1, EZ_SHUFFLE(2, 3, 2, 3));
+
+      __m256 outside = _mm256_setzero_ps();
+      for (ezUInt32 p = 0; p < uiNumPlanes; ++p)
+      {
+        const float* pPlane = pPlaneData + p * 4;
+
+        __m256 distance = _mm256_fmadd_ps(z, _mm256_broadcast_ss(pPlane + 2), _mm256_broadcast_ss(pPlane + 3));
+        distance = _mm256_fmadd_ps(y, _mm256_broadcast_ss(pPlane + 1), distance);
+        distance = _mm256_fmadd_ps(x, _mm256_broadcast_ss(pPlane + 0), distance);
+
+        outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, r, _CMP_GT_OQ));
+      }
+
+      ezUInt32 uiVisibleMask = ~static_cast<ezUInt32>(_mm256_movemask_ps(outside)) & 0xFF;
+      while (uiVisibleMask != 0)
+      {
+        pOutVisibleIndices[uiNumVisible++] = i + ezMath::FirstBitLow(uiVisibleMask);
+        uiVisibleMask &= uiVisibleMask - 1;
+      }
+    }
+
+    if (i < uiNumSpheres)
+    {
+      const ezUInt32 uiNumTailVisible = ezCullSpheresDefault(pPlanes, uiNumPlanes, pSpheres + i, uiNumSpheres - i, pOutVisibleIndices + uiNumVisible);
+
+      for (ezUInt32 t = 0; t < uiNumTailVisible; ++t)
+      {
+        pOutVisibleIndices[uiNumVisible + t] += i;
+      }
+
+      uiNumVisible += uiNumTailVisible;
+    }
+
+    return uiNumVisible;
+  }
+
+  EZ_AVX2_TARGET void ezMulAddAVX2(float* pInOut, const float* pValues, float fFactor, ezUInt32 uiCount)
+  {
+    const __m256 factor = _mm256_set1_ps(fFactor);
+
+    ezUInt32 i = 0;
+    for (; i + 16 <= uiCount; i += 16)
+    {
+      const __m256 a0 = _mm256_loadu_ps(pInOut + i);
+      const __m256 a1 = _mm256_loadu_ps(pInOut + i + 8);
+
+      _mm256_storeu_ps(pInOut + i, _mm256_fmadd_ps(_mm256_loadu_ps(pValues + i), factor, a0));
+      _mm256_storeu_ps(pInOut + i + 8, _mm256_fmadd_ps(_mm256_loadu_ps(pValues + i + 8), factor, a1));
+    }
+
+    for (; i + 8 <= uiCount; i += 8)
+    {
+      _mm256_storeu_ps(pInOut + i, _mm256_fmadd_ps(_mm256_loadu_ps(pValues + i), factor, _mm256_loadu_ps(pInOut + i)));
+    }
+
+    for (; i < uiCount; ++i)
+    {
+      pInOut[i] += pValues[i] * fFactor;
+    }
+  }
+} // namespace
+
+#undef EZ_AVX2_TARGET
@@ -8,7 +8,19 @@
 #define EZ_SSE_AVX 0x50
 #define EZ_SSE_AVX2 0x51
 
-#define EZ_SSE_LEVEL EZ_SSE_41
+// The SSE level is derived from the instruction sets that the compiler targets, see EZ_ENABLE_AVX2 in CMake.
+// MSVC does not define __FMA__, but /arch:AVX2 implies FMA support.
+#if !defined(EZ_SSE_LEVEL)
+#  if defined(__AVX2__) && (defined(__FMA__) || EZ_ENABLED(EZ_COMPILER_MSVC))
+#    define EZ_SSE_LEVEL EZ_SSE_AVX2
+#  elif defined(__AVX__)
+#    define EZ_SSE_LEVEL EZ_SSE_AVX
+#  elif defined(__SSE4_2__)
+#    define EZ_SSE_LEVEL EZ_SSE_42
+#  else
+#    define EZ_SSE_LEVEL EZ_SSE_41
+#  endif
+#endif
 
 #if EZ_SSE_LEVEL >= EZ_SSE_20
 #  include <emmintrin.h>
@@ -46,6 +58,12 @@ namespace ezInternal
   typedef __m128 QuadBool;
   typedef __m128i QuadInt;
   typedef __m128i QuadUInt;
+
+#if EZ_SSE_LEVEL >= EZ_SSE_AVX2
+  typedef __m256 OctFloat;
+  typedef __m256 OctBool;
+  typedef __m256i OctInt;
+#endif
 } // namespace ezInternal
 
 #include <Foundation/SimdMath/SimdSwizzle.h>
@@ -221,6 +221,17 @@ EZ_ALWAYS_INLINE ezSimdVec4i ezSimdVec4i::Abs() const
 #endif
 }
 
+// static
+EZ_ALWAYS_INLINE ezSimdVec4i ezSimdVec4i::Select(const ezSimdVec4b& cmp, const ezSimdVec4i& ifTrue, const ezSimdVec4i& ifFalse)
+{
+#if EZ_SSE_LEVEL >= EZ_SSE_41
+  return _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(ifFalse.m_v), _mm_castsi128_ps(ifTrue.m_v), cmp.m_v));
+#else
+  __m128i mask = _mm_castps_si128(cmp.m_v);
+  return _mm_or_si128(_mm_andnot_si128(mask, ifFalse.m_v), _mm_and_si128(mask, ifTrue.m_v));
+#endif
+}
+
 EZ_ALWAYS_INLINE ezSimdVec4b ezSimdVec4i::operator==(const ezSimdVec4i& v) const
 {
   return _mm_castsi128_ps(_mm_cmpeq_epi32(m_v, v.m_v));
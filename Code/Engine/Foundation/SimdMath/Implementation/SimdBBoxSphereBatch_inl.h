@@ -0,0 +1,87 @@
+#pragma once
+
+template <typename VEC>
+template <typename ACCESSOR>
+EZ_FORCE_INLINE void ezSimdBBoxSphereBatch<VEC>::Load(ezUInt32 uiCount, ACCESSOR getBounds)
+{
+  ezInternal::SimdBatchLoad<VEC>(
+    uiCount, [&](ezUInt32 i) -> const ezSimdVec4f& { return getBounds(i).m_CenterAndRadius; }, m_Center.x, m_Center.y, m_Center.z, m_Radius);
+  m_BoxHalfExtents.Load(uiCount, [&](ezUInt32 i) -> const ezSimdVec4f& { return getBounds(i).m_BoxHalfExtents; });
+}
+
+template <typename VEC>
+EZ_ALWAYS_INLINE void ezSimdBBoxSphereBatch<VEC>::Load(const ezSimdBBoxSphere* pBounds, ezUInt32 uiCount)
+{
+  Load(uiCount, [pBounds](ezUInt32 i) -> const ezSimdBBoxSphere& { return pBounds[i]; });
+}
+
+template <typename VEC>
+template <typename ACCESSOR>
+EZ_FORCE_INLINE void ezSimdBBoxSphereBatch<VEC>::Store(ezUInt32 uiCount, ACCESSOR getBounds) const
+{
+  ezInternal::SimdBatchStore<VEC>(
+    uiCount, [&](ezUInt32 i) -> ezSimdVec4f& { return getBounds(i).m_CenterAndRadius; }, m_Center.x, m_Center.y, m_Center.z, m_Radius);
+  m_BoxHalfExtents.Store(uiCount, [&](ezUInt32 i) -> ezSimdVec4f& { return getBounds(i).m_BoxHalfExtents; });
+}
+
+template <typename VEC>
+EZ_ALWAYS_INLINE void ezSimdBBoxSphereBatch<VEC>::Store(ezSimdBBoxSphere* pBounds, ezUInt32 uiCount) const
+{
+  Store(uiCount, [pBounds](ezUInt32 i) -> ezSimdBBoxSphere& { return pBounds[i]; });
+}
+
+template <typename VEC>
+ezSimdBBoxSphere ezSimdBBoxSphereBatch<VEC>::GetLane(ezUInt32 uiLane) const
+{
+  ezSimdBBoxSphere result;
+  result.m_CenterAndRadius = ezInternal::SimdBatchGetLane(uiLane, m_Center.x, m_Center.y, m_Center.z, m_Radius);
+  result.m_BoxHalfExtents = m_BoxHalfExtents.GetLane(uiLane);
+  return result;
+}
+
+template <typename VEC>
+EZ_FORCE_INLINE void ezSimdBBoxSphereBatch<VEC>::Transform(const ezSimdTransformBatch<VEC>& t)
+{
+  ezSimdBatchVec3<VEC> col0, col1, col2;
+  t.GetAsMat3(col0, col1, col2);
+
+  m_Center = t.m_Position + ezSimdBatchVec3<VEC>::MulAdd(col0, m_Center.x, ezSimdBatchVec3<VEC>::MulAdd(col1, m_Center.y, col2 * m_Center.z));
+
+  const VEC maxScaleSquared = col0.Dot(col0).CompMax(col1.Dot(col1)).CompMax(col2.Dot(col2));
+  m_Radius = m_Radius.CompMul(maxScaleSquared.GetSqrt());
+
+  const ezSimdBatchVec3<VEC> newHalfExtents =
+    ezSimdBatchVec3<VEC>::MulAdd(col0.Abs(), m_BoxHalfExtents.x, ezSimdBatchVec3<VEC>::MulAdd(col1.Abs(), m_BoxHalfExtents.y, col2.Abs() * m_BoxHalfExtents.z));
+
+  m_BoxHalfExtents.x = newHalfExtents.x.CompMin(m_Radius);
+  m_BoxHalfExtents.y = newHalfExtents.y.CompMin(m_Radius);
+  m_BoxHalfExtents.z = newHalfExtents.z.CompMin(m_Radius);
+}
+
+template <typename VEC>
+typename ezSimdBBoxSphereBatch<VEC>::BoolType ezSimdBBoxSphereBatch<VEC>::Overlaps(ezArrayPtr<const ezSimdVec4f> planes) const
+{
+  BoolType outside(false);
+
+  for (const ezSimdVec4f& plane : planes)
+  {
+    const ezSimdBatchVec3<VEC> normal(VEC(plane.x()), VEC(plane.y()), VEC(plane.z()));
+    const VEC distance = normal.Dot(m_Center) + VEC(plane.w());
+
+    // the extent of the box along the plane normal, the sphere is used instead if it is tighter
+    const VEC boxExtent = normal.Abs().Dot(m_BoxHalfExtents);
+
+    outside = outside || (distance > boxExtent.CompMin(m_Radius));
+  }
+
+  return !outside;
+}
+
+template <typename VEC>
+EZ_FORCE_INLINE typename ezSimdBBoxSphereBatch<VEC>::BoolType ezSimdBBoxSphereBatch<VEC>::Overlaps(const ezFrustum& frustum) const
+{
+  ezSimdVec4f planes[ezFrustum::PLANE_COUNT];
+  ezInternal::SimdBatchGetFrustumPlanes(frustum, planes);
+
+  return Overlaps(ezMakeArrayPtr(planes));
+}
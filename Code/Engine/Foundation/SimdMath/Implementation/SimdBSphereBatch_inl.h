@@ -0,0 +1,69 @@
+#pragma once
+
+template <typename VEC>
+template <typename ACCESSOR>
+EZ_FORCE_INLINE void ezSimdBSphereBatch<VEC>::Load(ezUInt32 uiCount, ACCESSOR getSphere)
+{
+  ezInternal::SimdBatchLoad<VEC>(
+    uiCount, [&](ezUInt32 i) -> const ezSimdVec4f& { return getSphere(i).m_CenterAndRadius; }, m_Center.x, m_Center.y, m_Center.z, m_Radius);
+}
+
+template <typename VEC>
+EZ_ALWAYS_INLINE void ezSimdBSphereBatch<VEC>::Load(const ezSimdBSphere* pSpheres, ezUInt32 uiCount)
+{
+  Load(uiCount, [pSpheres](ezUInt32 i) -> const ezSimdBSphere& { return pSpheres[i]; });
+}
+
+template <typename VEC>
+template <typename ACCESSOR>
+EZ_FORCE_INLINE void ezSimdBSphereBatch<VEC>::Store(ezUInt32 uiCount, ACCESSOR getSphere) const
+{
+  ezInternal::SimdBatchStore<VEC>(
+    uiCount, [&](ezUInt32 i) -> ezSimdVec4f& { return getSphere(i).m_CenterAndRadius; }, m_Center.x, m_Center.y, m_Center.z, m_Radius);
+}
+
+template <typename VEC>
+EZ_ALWAYS_INLINE void ezSimdBSphereBatch<VEC>::Store(ezSimdBSphere* pSpheres, ezUInt32 uiCount) const
+{
+  Store(uiCount, [pSpheres](ezUInt32 i) -> ezSimdBSphere& { return pSpheres[i]; });
+}
+
+template <typename VEC>
+ezSimdBSphere ezSimdBSphereBatch<VEC>::GetLane(ezUInt32 uiLane) const
+{
+  ezSimdBSphere result;
+  result.m_CenterAndRadius = ezInternal::SimdBatchGetLane(uiLane, m_Center.x, m_Center.y, m_Center.z, m_Radius);
+  return result;
+}
+
+template <typename VEC>
+EZ_FORCE_INLINE void ezSimdBSphereBatch<VEC>::Transform(const ezSimdTransformBatch<VEC>& t)
+{
+  m_Center = t.TransformPosition(m_Center);
+  m_Radius = m_Radius.CompMul(t.GetMaxScale());
+}
+
+template <typename VEC>
+typename ezSimdBSphereBatch<VEC>::BoolType ezSimdBSphereBatch<VEC>::Overlaps(ezArrayPtr<const ezSimdVec4f> planes) const
+{
+  BoolType outside(false);
+
+  for (const ezSimdVec4f& plane : planes)
+  {
+    const ezSimdBatchVec3<VEC> normal(VEC(plane.x()), VEC(plane.y()), VEC(plane.z()));
+    const VEC distance = normal.Dot(m_Center) + VEC(plane.w());
+
+    outside = outside || (distance > m_Radius);
+  }
+
+  return !outside;
+}
+
+template <typename VEC>
+EZ_FORCE_INLINE typename ezSimdBSphereBatch<VEC>::BoolType ezSimdBSphereBatch<VEC>::Overlaps(const ezFrustum& frustum) const
+{
+  ezSimdVec4f planes[ezFrustum::PLANE_COUNT];
+  ezInternal::SimdBatchGetFrustumPlanes(frustum, planes);
+
+  return Overlaps(ezMakeArrayPtr(planes));
+}
@@ -0,0 +1,242 @@
+#pragma once
+
+namespace ezInternal
+{
+  template <typename VEC, typename ACCESSOR>
+  EZ_FORCE_INLINE void SimdBatchLoad(ezUInt32 uiCount, ACCESSOR getVector, VEC& out_x, VEC& out_y, VEC& out_z, VEC& out_w)
+  {
+    typedef ezSimdBatchTraits<VEC> Traits;
+    constexpr ezUInt32 uiNumQuads = Traits::NumLanes / 4;
+
+    EZ_ASSERT_DEBUG(uiCount > 0 && uiCount <= Traits::NumLanes, "Invalid batch element count {}", uiCount);
+
+    ezSimdVec4f x[uiNumQuads], y[uiNumQuads], z[uiNumQuads], w[uiNumQuads];
+
+    for (ezUInt32 q = 0; q < uiNumQuads; ++q)
+    {
+      const ezUInt32 uiFirst = q * 4;
+
+      // fill the unused lanes with the last valid element, so that they don't produce NaNs or denormals
+      ezSimdMat4f m;
+      m.SetRows(getVector(ezMath::Min(uiFirst + 0, uiCount - 1)), getVector(ezMath::Min(uiFirst + 1, uiCount - 1)),
+        getVector(ezMath::Min(uiFirst + 2, uiCount - 1)), getVector(ezMath::Min(uiFirst + 3, uiCount - 1)));
+
+      x[q] = m.m_col0;
+      y[q] = m.m_col1;
+      z[q] = m.m_col2;
+      w[q] = m.m_col3;
+    }
+
+    out_x = Traits::FromQuads(x);
+    out_y = Traits::FromQuads(y);
+    out_z = Traits::FromQuads(z);
+    out_w = Traits::FromQuads(w);
+  }
+
+  template <typename VEC, typename ACCESSOR>
+  EZ_FORCE_INLINE void SimdBatchStore(ezUInt32 uiCount, ACCESSOR getVector, const VEC& x, const VEC& y, const VEC& z, const VEC& w)
+  {
+    typedef ezSimdBatchTraits<VEC> Traits;
+    constexpr ezUInt32 uiNumQuads = Traits::NumLanes / 4;
+
+    EZ_ASSERT_DEBUG(uiCount > 0 && uiCount <= Traits::NumLanes, "Invalid batch element count {}", uiCount);
+
+    ezSimdVec4f xq[uiNumQuads], yq[uiNumQuads], zq[uiNumQuads], wq[uiNumQuads];
+    Traits::ToQuads(x, xq);
+    Traits::ToQuads(y, yq);
+    Traits::ToQuads(z, zq);
+    Traits::ToQuads(w, wq);
+
+    for (ezUInt32 q = 0; q < uiNumQuads; ++q)
+    {
+      const ezUInt32 uiFirst = q * 4;
+      if (uiFirst >= uiCount)
+        break;
+
+      ezSimdMat4f m;
+      m.SetRows(xq[q], yq[q], zq[q], wq[q]);
+
+      const ezUInt32 uiNumInQuad = ezMath::Min(uiCount - uiFirst, 4u);
+      const ezSimdVec4f* pColumns = &m.m_col0;
+      for (ezUInt32 i = 0; i < uiNumInQuad; ++i)
+      {
+        getVector(uiFirst + i) = pColumns[i];
+      }
+    }
+  }
+
+  template <typename VEC>
+  ezSimdVec4f SimdBatchGetLane(ezUInt32 uiLane, const VEC& x, const VEC& y, const VEC& z, const VEC& w)
+  {
+    typedef ezSimdBatchTraits<VEC> Traits;
+    constexpr ezUInt32 uiNumQuads = Traits::NumLanes / 4;
+
+    EZ_ASSERT_DEBUG(uiLane < Traits::NumLanes, "Invalid lane index {}", uiLane);
+
+    ezSimdVec4f xq[uiNumQuads], yq[uiNumQuads], zq[uiNumQuads], wq[uiNumQuads];
+    Traits::ToQuads(x, xq);
+    Traits::ToQuads(y, yq);
+    Traits::ToQuads(z, zq);
+    Traits::ToQuads(w, wq);
+
+    const ezUInt32 q = uiLane / 4;
+
+    ezSimdMat4f m;
+    m.SetRows(xq[q], yq[q], zq[q], wq[q]);
+    return (&m.m_col0)[uiLane % 4];
+  }
+} // namespace ezInternal
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename VEC>
+EZ_ALWAYS_INLINE ezSimdBatchVec3<VEC>::ezSimdBatchVec3(const VEC& x, const VEC& y, const VEC& z)
+  : x(x)
+  , y(y)
+  , z(z)
+{
+}
+
+template <typename VEC>
+EZ_ALWAYS_INLINE void ezSimdBatchVec3<VEC>::Set(const ezSimdVec4f& v)
+{
+  x = VEC(v.x());
+  y = VEC(v.y());
+  z = VEC(v.z());
+}
+
+template <typename VEC>
+template <typename ACCESSOR>
+EZ_FORCE_INLINE void ezSimdBatchVec3<VEC>::Load(ezUInt32 uiCount, ACCESSOR getVector)
+{
+  VEC w;
+  ezInternal::SimdBatchLoad<VEC>(uiCount, getVector, x, y, z, w);
+}
+
+template <typename VEC>
+template <typename ACCESSOR>
+EZ_FORCE_INLINE void ezSimdBatchVec3<VEC>::Store(ezUInt32 uiCount, ACCESSOR getVector) const
+{
+  ezInternal::SimdBatchStore<VEC>(uiCount, getVector, x, y, z, VEC(0.0f));
+}
+
+template <typename VEC>
+EZ_ALWAYS_INLINE ezSimdVec4f ezSimdBatchVec3<VEC>::GetLane(ezUInt32 uiLane) const
+{
+  return ezInternal::SimdBatchGetLane(uiLane, x, y, z, VEC(0.0f));
+}
+
+template <typename VEC>
+EZ_ALWAYS_INLINE VEC ezSimdBatchVec3<VEC>::Dot(const ezSimdBatchVec3& rhs) const
+{
+  return VEC::MulAdd(x, rhs.x, VEC::MulAdd(y, rhs.y, z.CompMul(rhs.z)));
+}
+
+template <typename VEC>
+EZ_ALWAYS_INLINE ezSimdBatchVec3<VEC> ezSimdBatchVec3<VEC>::CrossRH(const ezSimdBatchVec3& rhs) const
+{
+  return ezSimdBatchVec3(VEC::MulSub(y, rhs.z, z.CompMul(rhs.y)), VEC::MulSub(z, rhs.x, x.CompMul(rhs.z)), VEC::MulSub(x, rhs.y, y.CompMul(rhs.x)));
+}
+
+template <typename VEC>
+EZ_ALWAYS_INLINE ezSimdBatchVec3<VEC> ezSimdBatchVec3<VEC>::CompMul(const ezSimdBatchVec3& rhs) const
+{
+  return ezSimdBatchVec3(x.CompMul(rhs.x), y.CompMul(rhs.y), z.CompMul(rhs.z));
+}
+
+template <typename VEC>
+EZ_ALWAYS_INLINE ezSimdBatchVec3<VEC> ezSimdBatchVec3<VEC>::Abs() const
+{
+  return ezSimdBatchVec3(x.Abs(), y.Abs(), z.Abs());
+}
+
+template <typename VEC>
+EZ_ALWAYS_INLINE ezSimdBatchVec3<VEC> ezSimdBatchVec3<VEC>::operator+(const ezSimdBatchVec3& rhs) const
+{
+  return ezSimdBatchVec3(x + rhs.x, y + rhs.y, z + rhs.z);
+}
+
+template <typename VEC>
+EZ_ALWAYS_INLINE ezSimdBatchVec3<VEC> ezSimdBatchVec3<VEC>::operator-(const ezSimdBatchVec3& rhs) const
+{
+  return ezSimdBatchVec3(x - rhs.x, y - rhs.y, z - rhs.z);
+}
+
+template <typename VEC>
+EZ_ALWAYS_INLINE ezSimdBatchVec3<VEC> ezSimdBatchVec3<VEC>::operator*(const VEC& f) const
+{
+  return ezSimdBatchVec3(x.CompMul(f), y.CompMul(f), z.CompMul(f));
+}
+
+// static
+template <typename VEC>
+EZ_ALWAYS_INLINE ezSimdBatchVec3<VEC> ezSimdBatchVec3<VEC>::MulAdd(const ezSimdBatchVec3& a, const VEC& b, const ezSimdBatchVec3& c)
+{
+  return ezSimdBatchVec3(VEC::MulAdd(a.x, b, c.x), VEC::MulAdd(a.y, b, c.y), VEC::MulAdd(a.z, b, c.z));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename VEC>
+EZ_ALWAYS_INLINE void ezSimdBatchQuat<VEC>::SetIdentity()
+{
+  m_xyz.x = VEC(0.0f);
+  m_xyz.y = VEC(0.0f);
+  m_xyz.z = VEC(0.0f);
+  m_w = VEC(1.0f);
+}
+
+template <typename VEC>
+template <typename ACCESSOR>
+EZ_FORCE_INLINE void ezSimdBatchQuat<VEC>::Load(ezUInt32 uiCount, ACCESSOR getQuat)
+{
+  ezInternal::SimdBatchLoad<VEC>(
+    uiCount, [&](ezUInt32 i) -> const ezSimdVec4f& { return getQuat(i).m_v; }, m_xyz.x, m_xyz.y, m_xyz.z, m_w);
+}
+
+template <typename VEC>
+template <typename ACCESSOR>
+EZ_FORCE_INLINE void ezSimdBatchQuat<VEC>::Store(ezUInt32 uiCount, ACCESSOR getQuat) const
+{
+  ezInternal::SimdBatchStore<VEC>(
+    uiCount, [&](ezUInt32 i) -> ezSimdVec4f& { return getQuat(i).m_v; }, m_xyz.x, m_xyz.y, m_xyz.z, m_w);
+}
+
+template <typename VEC>
+EZ_ALWAYS_INLINE ezSimdBatchVec3<VEC> ezSimdBatchQuat<VEC>::operator*(const ezSimdBatchVec3<VEC>& v) const
+{
+  ezSimdBatchVec3<VEC> t = m_xyz.CrossRH(v);
+  t = t + t;
+  return ezSimdBatchVec3<VEC>::MulAdd(t, m_w, v) + m_xyz.CrossRH(t);
+}
+
+template <typename VEC>
+EZ_ALWAYS_INLINE ezSimdBatchQuat<VEC> ezSimdBatchQuat<VEC>::operator*(const ezSimdBatchQuat& q2) const
+{
+  ezSimdBatchQuat q;
+  q.m_xyz = ezSimdBatchVec3<VEC>::MulAdd(q2.m_xyz, m_w, m_xyz * q2.m_w) + m_xyz.CrossRH(q2.m_xyz);
+  q.m_w = VEC::MulSub(m_w, q2.m_w, m_xyz.Dot(q2.m_xyz));
+  return q;
+}
+
+template <typename VEC>
+EZ_FORCE_INLINE void ezSimdBatchQuat<VEC>::GetAsMat3(ezSimdBatchVec3<VEC>& out_col0, ezSimdBatchVec3<VEC>& out_col1, ezSimdBatchVec3<VEC>& out_col2) const
+{
+  const ezSimdBatchVec3<VEC> xyz2 = m_xyz + m_xyz;
+
+  const VEC xx2 = m_xyz.x.CompMul(xyz2.x);
+  const VEC yy2 = m_xyz.y.CompMul(xyz2.y);
+  const VEC zz2 = m_xyz.z.CompMul(xyz2.z);
+  const VEC xy2 = m_xyz.x.CompMul(xyz2.y);
+  const VEC xz2 = m_xyz.x.CompMul(xyz2.z);
+  const VEC yz2 = m_xyz.y.CompMul(xyz2.z);
+  const VEC wx2 = m_w.CompMul(xyz2.x);
+  const VEC wy2 = m_w.CompMul(xyz2.y);
+  const VEC wz2 = m_w.CompMul(xyz2.z);
+
+  const VEC one(1.0f);
+
+  out_col0 = ezSimdBatchVec3<VEC>(one - (yy2 + zz2), xy2 + wz2, xz2 - wy2);
+  out_col1 = ezSimdBatchVec3<VEC>(xy2 - wz2, one - (xx2 + zz2), yz2 + wx2);
+  out_col2 = ezSimdBatchVec3<VEC>(xz2 + wy2, yz2 - wx2, one - (xx2 + yy2));
+}
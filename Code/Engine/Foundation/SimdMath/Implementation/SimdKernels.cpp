@@ -0,0 +1,194 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/SimdMath/SimdKernels.h>
+#include <Foundation/System/SystemInformation.h>
+
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+#  define EZ_SIMD_KERNELS_AVX2 EZ_ON
+#else
+#  define EZ_SIMD_KERNELS_AVX2 EZ_OFF
+#endif
+
+namespace
+{
+  typedef void (*ezTransformKernelFunc)(const ezSimdMat4f& mTransform, const ezSimdVec4f* pIn, ezSimdVec4f* pOut, ezUInt32 uiCount);
+  typedef ezUInt32 (*ezCullSpheresKernelFunc)(const ezSimdVec4f* pPlanes, ezUInt32 uiNumPlanes, const ezSimdBSphere* pSpheres, ezUInt32 uiNumSpheres, ezUInt32* pOutVisibleIndices);
+  typedef void (*ezMulAddKernelFunc)(float* pInOut, const float* pValues, float fFactor, ezUInt32 uiCount);
+
+  void ezTransformPositionsDefault(const ezSimdMat4f& mTransform, const ezSimdVec4f* pIn, ezSimdVec4f* pOut, ezUInt32 uiCount)
+  {
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      pOut[i] = mTransform.TransformPosition(pIn[i]);
+    }
+  }
+
+  void ezTransformDirectionsDefault(const ezSimdMat4f& mTransform, const ezSimdVec4f* pIn, ezSimdVec4f* pOut, ezUInt32 uiCount)
+  {
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      pOut[i] = mTransform.TransformDirection(pIn[i]);
+    }
+  }
+
+  ezUInt32 ezCullSpheresDefault(const ezSimdVec4f* pPlanes, ezUInt32 uiNumPlanes, const ezSimdBSphere* pSpheres, ezUInt32 uiNumSpheres, ezUInt32* pOutVisibleIndices)
+  {
+    ezUInt32 uiNumVisible = 0;
+
+    for (ezUInt32 i = 0; i < uiNumSpheres; ++i)
+    {
+      const ezSimdVec4f centerAndRadius = pSpheres[i].m_CenterAndRadius;
+      const ezSimdFloat radius = centerAndRadius.w();
+
+      bool bVisible = true;
+      for (ezUInt32 p = 0; p < uiNumPlanes; ++p)
+      {
+        const ezSimdFloat distance = pPlanes[p].Dot<3>(centerAndRadius) + pPlanes[p].w();
+        if (distance > radius)
+        {
+          bVisible = false;
+          break;
+        }
+      }
+
+      pOutVisibleIndices[uiNumVisible] = i;
+      uiNumVisible += bVisible ? 1 : 0;
+    }
+
+    return uiNumVisible;
+  }
+
+  void ezMulAddDefault(float* pInOut, const float* pValues, float fFactor, ezUInt32 uiCount)
+  {
+    const ezSimdFloat factor(fFactor);
+
+    ezUInt32 i = 0;
+    for (; i + 4 <= uiCount; i += 4)
+    {
+      ezSimdVec4f a, b;
+      a.Load<4>(pInOut + i);
+      b.Load<4>(pValues + i);
+
+      ezSimdVec4f::MulAdd(b, factor, a).Store<4>(pInOut + i);
+    }
+
+    for (; i < uiCount; ++i)
+    {
+      pInOut[i] += pValues[i] * fFactor;
+    }
+  }
+} // namespace
+
+#if EZ_ENABLED(EZ_SIMD_KERNELS_AVX2)
+#  include <Foundation/SimdMath/Implementation/SSE/SSEKernelsAVX2_inl.h>
+#endif
+
+namespace
+{
+  static ezTransformKernelFunc s_TransformPositionsKernel = &ezTransformPositionsDefault;
+  static ezTransformKernelFunc s_TransformDirectionsKernel = &ezTransformDirectionsDefault;
+  static ezCullSpheresKernelFunc s_CullSpheresKernel = &ezCullSpheresDefault;
+  static ezMulAddKernelFunc s_MulAddKernel = &ezMulAddDefault;
+} // namespace
+
+ezSimdKernelBackend::Enum ezSimdKernels::s_Backend = ezSimdKernelBackend::Default;
+
+// static
+void ezSimdKernels::TransformPositions(const ezSimdMat4f& mTransform, ezArrayPtr<const ezSimdVec4f> positions, ezArrayPtr<ezSimdVec4f> out_Positions)
+{
+  EZ_ASSERT_DEV(positions.GetCount() == out_Positions.GetCount(), "Input and output must have the same size");
+
+  s_TransformPositionsKernel(mTransform, positions.GetPtr(), out_Positions.GetPtr(), positions.GetCount());
+}
+
+// static
+void ezSimdKernels::TransformDirections(const ezSimdMat4f& mTransform, ezArrayPtr<const ezSimdVec4f> directions, ezArrayPtr<ezSimdVec4f> out_Directions)
+{
+  EZ_ASSERT_DEV(directions.GetCount() == out_Directions.GetCount(), "Input and output must have the same size");
+
+  s_TransformDirectionsKernel(mTransform, directions.GetPtr(), out_Directions.GetPtr(), directions.GetCount());
+}
+
+// static
+ezUInt32 ezSimdKernels::CullSpheres(ezArrayPtr<const ezSimdVec4f> planes, ezArrayPtr<const ezSimdBSphere> spheres, ezArrayPtr<ezUInt32> out_VisibleIndices)
+{
+  EZ_ASSERT_DEV(out_VisibleIndices.GetCount() >= spheres.GetCount(), "The output must be able to hold one index per sphere");
+
+  return s_CullSpheresKernel(planes.GetPtr(), planes.GetCount(), spheres.GetPtr(), spheres.GetCount(), out_VisibleIndices.GetPtr());
+}
+
+// static
+void ezSimdKernels::MulAdd(ezArrayPtr<float> inout_Values, ezArrayPtr<const float> values, float fFactor)
+{
+  EZ_ASSERT_DEV(inout_Values.GetCount() == values.GetCount(), "Both arrays must have the same size");
+
+  s_MulAddKernel(inout_Values.GetPtr(), values.GetPtr(), fFactor, values.GetCount());
+}
+
+// static
+bool ezSimdKernels::IsBackendSupported(ezSimdKernelBackend::Enum backend)
+{
+  switch (backend)
+  {
+    case ezSimdKernelBackend::Default:
+      return true;
+
+    case ezSimdKernelBackend::AVX2:
+#if EZ_ENABLED(EZ_SIMD_KERNELS_AVX2)
+      return ezSystemInformation::GetCPUFeatures().AreAllSet(ezCPUFeatures::AVX2 | ezCPUFeatures::FMA);
+#else
+      return false;
+#endif
+
+    default:
+      EZ_ASSERT_NOT_IMPLEMENTED;
+      return false;
+  }
+}
+
+// static
+ezSimdKernelBackend::Enum ezSimdKernels::GetBestSupportedBackend()
+{
+  return IsBackendSupported(ezSimdKernelBackend::AVX2) ? ezSimdKernelBackend::AVX2 : ezSimdKernelBackend::Default;
+}
+
+// static
+void ezSimdKernels::SetBackend(ezSimdKernelBackend::Enum backend)
+{
+  EZ_ASSERT_DEV(IsBackendSupported(backend), "SIMD kernel backend {} is not supported on this CPU", static_cast<int>(backend));
+
+  s_Backend = backend;
+
+  switch (backend)
+  {
+#if EZ_ENABLED(EZ_SIMD_KERNELS_AVX2)
+    case ezSimdKernelBackend::AVX2:
+      s_TransformPositionsKernel = &ezTransformPositionsAVX2;
+      s_TransformDirectionsKernel = &ezTransformDirectionsAVX2;
+      s_CullSpheresKernel = &ezCullSpheresAVX2;
+      s_MulAddKernel = &ezMulAddAVX2;
+      break;
+#endif
+
+    default:
+      s_TransformPositionsKernel = &ezTransformPositionsDefault;
+      s_TransformDirectionsKernel = &ezTransformDirectionsDefault;
+      s_CullSpheresKernel = &ezCullSpheresDefault;
+      s_MulAddKernel = &ezMulAddDefault;
+      break;
+  }
+}
+
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, SimdKernels)
+
+  ON_CORESYSTEMS_STARTUP
+  {
+    ezSimdKernels::SetBackend(ezSimdKernels::GetBestSupportedBackend());
+  }
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+EZ_STATICLINK_FILE(Foundation, Foundation_SimdMath_Implementation_SimdKernels);
@@ -131,8 +131,8 @@ EZ_ALWAYS_INLINE ezSimdVec4f ezSimdMat4f::TransformPosition(const ezSimdVec4f& v
 {
   ezSimdVec4f result;
   result = m_col0 * v.x();
-  result += m_col1 * v.y();
-  result += m_col2 * v.z();
+  result = ezSimdVec4f::MulAdd(m_col1, v.y(), result);
+  result = ezSimdVec4f::MulAdd(m_col2, v.z(), result);
   result += m_col3;
 
   return result;
@@ -142,8 +142,8 @@ EZ_ALWAYS_INLINE ezSimdVec4f ezSimdMat4f::TransformDirection(const ezSimdVec4f&
 {
   ezSimdVec4f result;
   result = m_col0 * v.x();
-  result += m_col1 * v.y();
-  result += m_col2 * v.z();
+  result = ezSimdVec4f::MulAdd(m_col1, v.y(), result);
+  result = ezSimdVec4f::MulAdd(m_col2, v.z(), result);
 
   return result;
 }
@@ -153,24 +153,24 @@ EZ_ALWAYS_INLINE ezSimdMat4f ezSimdMat4f::operator*(const ezSimdMat4f& rhs) cons
   ezSimdMat4f result;
 
   result.m_col0 = m_col0 * rhs.m_col0.x();
-  result.m_col0 += m_col1 * rhs.m_col0.y();
-  result.m_col0 += m_col2 * rhs.m_col0.z();
-  result.m_col0 += m_col3 * rhs.m_col0.w();
+  result.m_col0 = ezSimdVec4f::MulAdd(m_col1, rhs.m_col0.y(), result.m_col0);
+  result.m_col0 = ezSimdVec4f::MulAdd(m_col2, rhs.m_col0.z(), result.m_col0);
+  result.m_col0 = ezSimdVec4f::MulAdd(m_col3, rhs.m_col0.w(), result.m_col0);
 
   result.m_col1 = m_col0 * rhs.m_col1.x();
-  result.m_col1 += m_col1 * rhs.m_col1.y();
-  result.m_col1 += m_col2 * rhs.m_col1.z();
-  result.m_col1 += m_col3 * rhs.m_col1.w();
+  result.m_col1 = ezSimdVec4f::MulAdd(m_col1, rhs.m_col1.y(), result.m_col1);
+  result.m_col1 = ezSimdVec4f::MulAdd(m_col2, rhs.m_col1.z(), result.m_col1);
+  result.m_col1 = ezSimdVec4f::MulAdd(m_col3, rhs.m_col1.w(), result.m_col1);
 
   result.m_col2 = m_col0 * rhs.m_col2.x();
-  result.m_col2 += m_col1 * rhs.m_col2.y();
-  result.m_col2 += m_col2 * rhs.m_col2.z();
-  result.m_col2 += m_col3 * rhs.m_col2.w();
+  result.m_col2 = ezSimdVec4f::MulAdd(m_col1, rhs.m_col2.y(), result.m_col2);
+  result.m_col2 = ezSimdVec4f::MulAdd(m_col2, rhs.m_col2.z(), result.m_col2);
+  result.m_col2 = ezSimdVec4f::MulAdd(m_col3, rhs.m_col2.w(), result.m_col2);
 
   result.m_col3 = m_col0 * rhs.m_col3.x();
-  result.m_col3 += m_col1 * rhs.m_col3.y();
-  result.m_col3 += m_col2 * rhs.m_col3.z();
-  result.m_col3 += m_col3 * rhs.m_col3.w();
+  result.m_col3 = ezSimdVec4f::MulAdd(m_col1, rhs.m_col3.y(), result.m_col3);
+  result.m_col3 = ezSimdVec4f::MulAdd(m_col2, rhs.m_col3.z(), result.m_col3);
+  result.m_col3 = ezSimdVec4f::MulAdd(m_col3, rhs.m_col3.w(), result.m_col3);
 
   return result;
 }
@@ -0,0 +1,108 @@
+#pragma once
+
+template <typename VEC>
+EZ_ALWAYS_INLINE void ezSimdTransformBatch<VEC>::SetIdentity()
+{
+  m_Position.Set(ezSimdVec4f::ZeroVector());
+  m_Rotation.SetIdentity();
+  m_Scale.Set(ezSimdVec4f(1.0f));
+}
+
+template <typename VEC>
+EZ_FORCE_INLINE void ezSimdTransformBatch<VEC>::Set(const ezSimdTransform& t)
+{
+  m_Position.Set(t.m_Position);
+  m_Rotation.m_xyz.Set(t.m_Rotation.m_v);
+  m_Rotation.m_w = VEC(t.m_Rotation.m_v.w());
+  m_Scale.Set(t.m_Scale);
+}
+
+template <typename VEC>
+template <typename ACCESSOR>
+EZ_FORCE_INLINE void ezSimdTransformBatch<VEC>::Load(ezUInt32 uiCount, ACCESSOR getTransform)
+{
+  m_Position.Load(uiCount, [&](ezUInt32 i) -> const ezSimdVec4f& { return getTransform(i).m_Position; });
+  m_Rotation.Load(uiCount, [&](ezUInt32 i) -> const ezSimdQuat& { return getTransform(i).m_Rotation; });
+  m_Scale.Load(uiCount, [&](ezUInt32 i) -> const ezSimdVec4f& { return getTransform(i).m_Scale; });
+}
+
+template <typename VEC>
+EZ_ALWAYS_INLINE void ezSimdTransformBatch<VEC>::Load(const ezSimdTransform* pTransforms, ezUInt32 uiCount)
+{
+  Load(uiCount, [pTransforms](ezUInt32 i) -> const ezSimdTransform& { return pTransforms[i]; });
+}
+
+template <typename VEC>
+template <typename ACCESSOR>
+EZ_FORCE_INLINE void ezSimdTransformBatch<VEC>::Store(ezUInt32 uiCount, ACCESSOR getTransform) const
+{
+  m_Position.Store(uiCount, [&](ezUInt32 i) -> ezSimdVec4f& { return getTransform(i).m_Position; });
+  m_Rotation.Store(uiCount, [&](ezUInt32 i) -> ezSimdQuat& { return getTransform(i).m_Rotation; });
+  m_Scale.Store(uiCount, [&](ezUInt32 i) -> ezSimdVec4f& { return getTransform(i).m_Scale; });
+}
+
+template <typename VEC>
+EZ_ALWAYS_INLINE void ezSimdTransformBatch<VEC>::Store(ezSimdTransform* pTransforms, ezUInt32 uiCount) const
+{
+  Store(uiCount, [pTransforms](ezUInt32 i) -> ezSimdTransform& { return pTransforms[i]; });
+}
+
+template <typename VEC>
+ezSimdTransform ezSimdTransformBatch<VEC>::GetLane(ezUInt32 uiLane) const
+{
+  ezSimdTransform result;
+  result.m_Position = m_Position.GetLane(uiLane);
+  result.m_Rotation.m_v = ezInternal::SimdBatchGetLane(uiLane, m_Rotation.m_xyz.x, m_Rotation.m_xyz.y, m_Rotation.m_xyz.z, m_Rotation.m_w);
+  result.m_Scale = m_Scale.GetLane(uiLane);
+
+  return result;
+}
+
+template <typename VEC>
+EZ_ALWAYS_INLINE VEC ezSimdTransformBatch<VEC>::GetMaxScale() const
+{
+  const ezSimdBatchVec3<VEC> absScale = m_Scale.Abs();
+  return absScale.x.CompMax(absScale.y).CompMax(absScale.z);
+}
+
+template <typename VEC>
+EZ_ALWAYS_INLINE void ezSimdTransformBatch<VEC>::SetGlobalTransform(
+  const ezSimdTransformBatch& globalTransformParent, const ezSimdTransformBatch& localTransformChild)
+{
+  *this = globalTransformParent * localTransformChild;
+}
+
+template <typename VEC>
+EZ_ALWAYS_INLINE ezSimdBatchVec3<VEC> ezSimdTransformBatch<VEC>::TransformPosition(const ezSimdBatchVec3<VEC>& v) const
+{
+  return m_Position + m_Rotation * m_Scale.CompMul(v);
+}
+
+template <typename VEC>
+EZ_ALWAYS_INLINE ezSimdBatchVec3<VEC> ezSimdTransformBatch<VEC>::TransformDirection(const ezSimdBatchVec3<VEC>& v) const
+{
+  return m_Rotation * m_Scale.CompMul(v);
+}
+
+template <typename VEC>
+EZ_FORCE_INLINE void ezSimdTransformBatch<VEC>::GetAsMat3(
+  ezSimdBatchVec3<VEC>& out_col0, ezSimdBatchVec3<VEC>& out_col1, ezSimdBatchVec3<VEC>& out_col2) const
+{
+  m_Rotation.GetAsMat3(out_col0, out_col1, out_col2);
+
+  out_col0 = out_col0 * m_Scale.x;
+  out_col1 = out_col1 * m_Scale.y;
+  out_col2 = out_col2 * m_Scale.z;
+}
+
+template <typename VEC>
+EZ_FORCE_INLINE const ezSimdTransformBatch<VEC> operator*(const ezSimdTransformBatch<VEC>& lhs, const ezSimdTransformBatch<VEC>& rhs)
+{
+  ezSimdTransformBatch<VEC> t;
+
+  t.m_Position = (lhs.m_Rotation * rhs.m_Position.CompMul(lhs.m_Scale)) + lhs.m_Position;
+  t.m_Rotation = lhs.m_Rotation * rhs.m_Rotation;
+  t.m_Scale = lhs.m_Scale.CompMul(rhs.m_Scale);
+
+  return t;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <Foundation/SimdMath/SimdBBoxSphere.h>
+#include <Foundation/SimdMath/SimdBSphereBatch.h>
+
+/// \brief Stores 4 or 8 combined bounding boxes and spheres in structure-of-arrays layout, e.g. to transform or cull them in batches.
+///
+/// VEC is the lane type, i.e. ezSimdVec4f or ezSimdVec8f. Use ezSimdBBoxSphereBatch4, ezSimdBBoxSphereBatch8 or ezSimdBBoxSphereBatchDefault.
+template <typename VEC>
+class ezSimdBBoxSphereBatch
+{
+public:
+  EZ_DECLARE_POD_TYPE();
+
+  typedef ezSimdBatchTraits<VEC> Traits;
+  typedef typename Traits::BoolType BoolType;
+
+  /// \brief Default constructor does not initialize anything.
+  ezSimdBBoxSphereBatch() = default;
+
+  /// \brief Loads uiCount bounds. getBounds(i) must return a const ezSimdBBoxSphere&.
+  ///
+  /// uiCount must be between 1 and the number of lanes. The remaining lanes are filled with copies of the last bounds.
+  template <typename ACCESSOR>
+  void Load(ezUInt32 uiCount, ACCESSOR getBounds); // [tested]
+
+  /// \brief Loads uiCount consecutive bounds.
+  void Load(const ezSimdBBoxSphere* pBounds, ezUInt32 uiCount); // [tested]
+
+  /// \brief Stores uiCount bounds. getBounds(i) must return an ezSimdBBoxSphere&. The w component of the box half extents is set to zero.
+  template <typename ACCESSOR>
+  void Store(ezUInt32 uiCount, ACCESSOR getBounds) const; // [tested]
+
+  /// \brief Stores uiCount consecutive bounds.
+  void Store(ezSimdBBoxSphere* pBounds, ezUInt32 uiCount) const; // [tested]
+
+  /// \brief Returns the bounds of the given lane.
+  ezSimdBBoxSphere GetLane(ezUInt32 uiLane) const; // [tested]
+
+public:
+  /// \brief Transforms every bounds with the transform of the same lane, see ezSimdBBoxSphere::Transform(const ezSimdTransform&).
+  void Transform(const ezSimdTransformBatch<VEC>& t); // [tested]
+
+  /// \brief Returns which bounds are not completely in front of any of the given planes.
+  ///
+  /// The planes are stored as (normal, negative distance) and their normals point outwards, like the planes of ezFrustum.
+  /// Both the sphere and the box are tested, so this culls more than testing only one of them.
+  BoolType Overlaps(ezArrayPtr<const ezSimdVec4f> planes) const; // [tested]
+
+  /// \brief Returns which bounds overlap the frustum.
+  BoolType Overlaps(const ezFrustum& frustum) const; // [tested]
+
+public:
+  ezSimdBatchVec3<VEC> m_Center;
+  VEC m_Radius;
+  ezSimdBatchVec3<VEC> m_BoxHalfExtents;
+};
+
+typedef ezSimdBBoxSphereBatch<ezSimdVec4f> ezSimdBBoxSphereBatch4;
+typedef ezSimdBBoxSphereBatch<ezSimdVec8f> ezSimdBBoxSphereBatch8;
+typedef ezSimdBBoxSphereBatch<ezSimdBatchVec> ezSimdBBoxSphereBatchDefault;
+
+#include <Foundation/SimdMath/Implementation/SimdBBoxSphereBatch_inl.h>
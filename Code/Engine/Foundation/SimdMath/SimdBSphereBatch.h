@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Foundation/Math/Frustum.h>
+#include <Foundation/SimdMath/SimdBSphere.h>
+#include <Foundation/SimdMath/SimdTransformBatch.h>
+
+/// \brief Stores 4 or 8 bounding spheres in structure-of-arrays layout, e.g. to transform or cull them in batches.
+///
+/// VEC is the lane type, i.e. ezSimdVec4f or ezSimdVec8f. Use ezSimdBSphereBatch4, ezSimdBSphereBatch8 or ezSimdBSphereBatchDefault.
+template <typename VEC>
+class ezSimdBSphereBatch
+{
+public:
+  EZ_DECLARE_POD_TYPE();
+
+  typedef ezSimdBatchTraits<VEC> Traits;
+  typedef typename Traits::BoolType BoolType;
+
+  /// \brief Default constructor does not initialize anything.
+  ezSimdBSphereBatch() = default;
+
+  /// \brief Loads uiCount spheres. getSphere(i) must return a const ezSimdBSphere&.
+  ///
+  /// uiCount must be between 1 and the number of lanes. The remaining lanes are filled with copies of the last sphere.
+  template <typename ACCESSOR>
+  void Load(ezUInt32 uiCount, ACCESSOR getSphere); // [tested]
+
+  /// \brief Loads uiCount consecutive spheres.
+  void Load(const ezSimdBSphere* pSpheres, ezUInt32 uiCount); // [tested]
+
+  /// \brief Stores uiCount spheres. getSphere(i) must return an ezSimdBSphere&.
+  template <typename ACCESSOR>
+  void Store(ezUInt32 uiCount, ACCESSOR getSphere) const; // [tested]
+
+  /// \brief Stores uiCount consecutive spheres.
+  void Store(ezSimdBSphere* pSpheres, ezUInt32 uiCount) const; // [tested]
+
+  /// \brief Returns the sphere of the given lane.
+  ezSimdBSphere GetLane(ezUInt32 uiLane) const; // [tested]
+
+public:
+  /// \brief Transforms every sphere with the transform of the same lane, see ezSimdBSphere::Transform(const ezSimdTransform&).
+  void Transform(const ezSimdTransformBatch<VEC>& t); // [tested]
+
+  /// \brief Returns which spheres are not completely in front of any of the given planes.
+  ///
+  /// The planes are stored as (normal, negative distance) and their normals point outwards, like the planes of ezFrustum.
+  BoolType Overlaps(ezArrayPtr<const ezSimdVec4f> planes) const; // [tested]
+
+  /// \brief Returns which spheres overlap the frustum, see ezFrustum::Overlaps(const ezSimdBSphere&).
+  BoolType Overlaps(const ezFrustum& frustum) const; // [tested]
+
+public:
+  ezSimdBatchVec3<VEC> m_Center;
+  VEC m_Radius;
+};
+
+typedef ezSimdBSphereBatch<ezSimdVec4f> ezSimdBSphereBatch4;
+typedef ezSimdBSphereBatch<ezSimdVec8f> ezSimdBSphereBatch8;
+typedef ezSimdBSphereBatch<ezSimdBatchVec> ezSimdBSphereBatchDefault;
+
+namespace ezInternal
+{
+  /// \brief Loads the frustum planes in the layout that the Overlaps() functions of the bounds batches expect.
+  EZ_FORCE_INLINE void SimdBatchGetFrustumPlanes(const ezFrustum& frustum, ezSimdVec4f* out_pPlanes)
+  {
+    for (ezUInt32 i = 0; i < ezFrustum::PLANE_COUNT; ++i)
+    {
+      out_pPlanes[i].Load<4>(frustum.GetPlane(static_cast<ezUInt8>(i)).m_vNormal.GetData());
+    }
+  }
+} // namespace ezInternal
+
+#include <Foundation/SimdMath/Implementation/SimdBSphereBatch_inl.h>
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <Foundation/SimdMath/SimdQuat.h>
+#include <Foundation/SimdMath/SimdVec8f.h>
+
+/// \brief Describes a float vector type that can be used as the lane type of the structure-of-arrays batch types,
+/// i.e. ezSimdVec4f for batches of 4 and ezSimdVec8f for batches of 8 elements.
+template <typename VEC>
+struct ezSimdBatchTraits;
+
+template <>
+struct ezSimdBatchTraits<ezSimdVec4f>
+{
+  typedef ezSimdVec4b BoolType;
+
+  enum
+  {
+    NumLanes = 4
+  };
+
+  /// \brief Builds one vector from NumLanes / 4 quads.
+  EZ_ALWAYS_INLINE static ezSimdVec4f FromQuads(const ezSimdVec4f* pQuads) { return pQuads[0]; }
+
+  /// \brief Splits a vector into NumLanes / 4 quads.
+  EZ_ALWAYS_INLINE static void ToQuads(const ezSimdVec4f& v, ezSimdVec4f* out_pQuads) { out_pQuads[0] = v; }
+
+  /// \brief Returns a bit mask with one bit per lane that is set.
+  EZ_ALWAYS_INLINE static ezUInt32 GetMask(const ezSimdVec4b& b)
+  {
+    return (b.x() ? 1u : 0u) | (b.y() ? 2u : 0u) | (b.z() ? 4u : 0u) | (b.w() ? 8u : 0u);
+  }
+};
+
+template <>
+struct ezSimdBatchTraits<ezSimdVec8f>
+{
+  typedef ezSimdVec8b BoolType;
+
+  enum
+  {
+    NumLanes = 8
+  };
+
+  EZ_ALWAYS_INLINE static ezSimdVec8f FromQuads(const ezSimdVec4f* pQuads) { return ezSimdVec8f(pQuads[0], pQuads[1]); }
+
+  EZ_ALWAYS_INLINE static void ToQuads(const ezSimdVec8f& v, ezSimdVec4f* out_pQuads)
+  {
+    out_pQuads[0] = v.GetLow();
+    out_pQuads[1] = v.GetHigh();
+  }
+
+  EZ_ALWAYS_INLINE static ezUInt32 GetMask(const ezSimdVec8b& b) { return b.GetMask(); }
+};
+
+/// \brief The lane type that batch processing code should use if it does not care about the batch size.
+///
+/// This is ezSimdVec8f when the engine is compiled with native 8-wide vectors and ezSimdVec4f otherwise.
+#if EZ_ENABLED(EZ_SIMD_NATIVE_VEC8)
+typedef ezSimdVec8f ezSimdBatchVec;
+#else
+typedef ezSimdVec4f ezSimdBatchVec;
+#endif
+
+/// \brief The x, y and z components of one 3D vector per lane in structure-of-arrays layout.
+template <typename VEC>
+struct ezSimdBatchVec3
+{
+  EZ_DECLARE_POD_TYPE();
+
+  typedef ezSimdBatchTraits<VEC> Traits;
+
+  /// \brief Default constructor does not initialize anything.
+  ezSimdBatchVec3() = default;
+
+  ezSimdBatchVec3(const VEC& x, const VEC& y, const VEC& z); // [tested]
+
+  /// \brief Sets all lanes to the same vector.
+  void Set(const ezSimdVec4f& v); // [tested]
+
+  /// \brief Loads the xyz components of uiCount vectors. getVector(i) must return a const ezSimdVec4f&.
+  ///
+  /// uiCount must be between 1 and the number of lanes. The remaining lanes are filled with copies of the last vector.
+  template <typename ACCESSOR>
+  void Load(ezUInt32 uiCount, ACCESSOR getVector); // [tested]
+
+  /// \brief Stores the xyz components into uiCount vectors and sets their w component to zero. getVector(i) must return an ezSimdVec4f&.
+  template <typename ACCESSOR>
+  void Store(ezUInt32 uiCount, ACCESSOR getVector) const; // [tested]
+
+  /// \brief Returns the vector of the given lane, with w set to zero.
+  ezSimdVec4f GetLane(ezUInt32 uiLane) const; // [tested]
+
+public:
+  VEC Dot(const ezSimdBatchVec3& rhs) const; // [tested]
+
+  /// \brief Cross product in a right handed coordinate system, see ezSimdVec4f::CrossRH.
+  ezSimdBatchVec3 CrossRH(const ezSimdBatchVec3& rhs) const; // [tested]
+
+  ezSimdBatchVec3 CompMul(const ezSimdBatchVec3& rhs) const; // [tested]
+
+  ezSimdBatchVec3 Abs() const; // [tested]
+
+  ezSimdBatchVec3 operator+(const ezSimdBatchVec3& rhs) const; // [tested]
+  ezSimdBatchVec3 operator-(const ezSimdBatchVec3& rhs) const; // [tested]
+  ezSimdBatchVec3 operator*(const VEC& f) const;               // [tested]
+
+  /// \brief Returns a * b + c.
+  static ezSimdBatchVec3 MulAdd(const ezSimdBatchVec3& a, const VEC& b, const ezSimdBatchVec3& c); // [tested]
+
+public:
+  VEC x;
+  VEC y;
+  VEC z;
+};
+
+/// \brief One rotation quaternion per lane in structure-of-arrays layout.
+template <typename VEC>
+struct ezSimdBatchQuat
+{
+  EZ_DECLARE_POD_TYPE();
+
+  typedef ezSimdBatchTraits<VEC> Traits;
+
+  /// \brief Default constructor does not initialize anything.
+  ezSimdBatchQuat() = default;
+
+  /// \brief Sets all lanes to the identity rotation.
+  void SetIdentity(); // [tested]
+
+  /// \brief Loads uiCount quaternions. getQuat(i) must return a const ezSimdQuat&. See ezSimdBatchVec3::Load().
+  template <typename ACCESSOR>
+  void Load(ezUInt32 uiCount, ACCESSOR getQuat); // [tested]
+
+  /// \brief Stores uiCount quaternions. getQuat(i) must return an ezSimdQuat&.
+  template <typename ACCESSOR>
+  void Store(ezUInt32 uiCount, ACCESSOR getQuat) const; // [tested]
+
+public:
+  /// \brief Rotates the given vectors, see ezSimdQuat::operator*(const ezSimdVec4f&).
+  ezSimdBatchVec3<VEC> operator*(const ezSimdBatchVec3<VEC>& v) const; // [tested]
+
+  /// \brief Concatenates the rotations, see ezSimdQuat::operator*(const ezSimdQuat&).
+  ezSimdBatchQuat operator*(const ezSimdBatchQuat& q2) const; // [tested]
+
+  /// \brief Returns the columns of the rotation matrices.
+  void GetAsMat3(ezSimdBatchVec3<VEC>& out_col0, ezSimdBatchVec3<VEC>& out_col1, ezSimdBatchVec3<VEC>& out_col2) const; // [tested]
+
+public:
+  ezSimdBatchVec3<VEC> m_xyz;
+  VEC m_w;
+};
+
+namespace ezInternal
+{
+  /// \brief Transposes uiCount vectors into structure-of-arrays layout, used by the Load functions of the batch types.
+  template <typename VEC, typename ACCESSOR>
+  void SimdBatchLoad(ezUInt32 uiCount, ACCESSOR getVector, VEC& out_x, VEC& out_y, VEC& out_z, VEC& out_w);
+
+  /// \brief Transposes structure-of-arrays data back into uiCount vectors, used by the Store functions of the batch types.
+  template <typename VEC, typename ACCESSOR>
+  void SimdBatchStore(ezUInt32 uiCount, ACCESSOR getVector, const VEC& x, const VEC& y, const VEC& z, const VEC& w);
+
+  /// \brief Returns the vector of a single lane.
+  template <typename VEC>
+  ezSimdVec4f SimdBatchGetLane(ezUInt32 uiLane, const VEC& x, const VEC& y, const VEC& z, const VEC& w);
+} // namespace ezInternal
+
+#include <Foundation/SimdMath/Implementation/SimdBatch_inl.h>
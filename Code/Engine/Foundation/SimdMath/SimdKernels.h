@@ -0,0 +1,59 @@
+#pragma once
+
+#include <Foundation/SimdMath/SimdBSphere.h>
+#include <Foundation/SimdMath/SimdMat4f.h>
+#include <Foundation/Types/ArrayPtr.h>
+
+/// \brief The instruction sets that ezSimdKernels can use.
+struct ezSimdKernelBackend
+{
+  enum Enum
+  {
+    Default, ///< Uses the SIMD implementation that the engine was compiled with.
+    AVX2,    ///< 8-wide kernels that use AVX2 and FMA, only available on x86 CPUs that support them.
+
+    ENUM_COUNT
+  };
+};
+
+/// \brief Bulk kernels for hot loops, e.g. transforming positions, culling bounding spheres or integrating particle data.
+///
+/// The engine is usually compiled for SSE4.1, so that it runs on all x64 CPUs. These kernels additionally exist in versions
+/// for wider instruction sets, and at startup the widest version that the CPU supports is selected.
+/// All versions produce the same results, apart from floating point differences caused by FMA.
+class EZ_FOUNDATION_DLL ezSimdKernels
+{
+public:
+  /// \brief Transforms all positions with the given matrix. The w component of the input is ignored and treated as 1.
+  ///
+  /// The input and output may be the same array.
+  static void TransformPositions(const ezSimdMat4f& mTransform, ezArrayPtr<const ezSimdVec4f> positions, ezArrayPtr<ezSimdVec4f> out_Positions); // [tested]
+
+  /// \brief Transforms all directions with the given matrix. The w component of the input is ignored and treated as 0.
+  ///
+  /// The input and output may be the same array.
+  static void TransformDirections(const ezSimdMat4f& mTransform, ezArrayPtr<const ezSimdVec4f> directions, ezArrayPtr<ezSimdVec4f> out_Directions); // [tested]
+
+  /// \brief Writes the indices of all spheres that are not completely in front of any of the planes and returns how many there are.
+  ///
+  /// The planes are stored as (normal, negative distance) and their normals point outwards, like the planes of ezFrustum.
+  /// out_VisibleIndices must be able to hold one index per sphere.
+  static ezUInt32 CullSpheres(ezArrayPtr<const ezSimdVec4f> planes, ezArrayPtr<const ezSimdBSphere> spheres, ezArrayPtr<ezUInt32> out_VisibleIndices); // [tested]
+
+  /// \brief Computes inout_Values[i] += values[i] * fFactor for all elements, e.g. to integrate particle velocities.
+  static void MulAdd(ezArrayPtr<float> inout_Values, ezArrayPtr<const float> values, float fFactor); // [tested]
+
+  /// \brief Returns whether the given backend can be used on this CPU.
+  static bool IsBackendSupported(ezSimdKernelBackend::Enum backend); // [tested]
+
+  /// \brief Returns the widest backend that this CPU supports. This is the one that is selected at startup.
+  static ezSimdKernelBackend::Enum GetBestSupportedBackend(); // [tested]
+
+  /// \brief Switches all kernels to the given backend, e.g. to compare them in tests and benchmarks. The backend must be supported.
+  static void SetBackend(ezSimdKernelBackend::Enum backend); // [tested]
+
+  static ezSimdKernelBackend::Enum GetBackend() { return s_Backend; } // [tested]
+
+private:
+  static ezSimdKernelBackend::Enum s_Backend;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <Foundation/SimdMath/SimdBatch.h>
+#include <Foundation/SimdMath/SimdTransform.h>
+
+/// \brief Stores 4 or 8 transforms in structure-of-arrays layout, so that one operation processes all of them at once.
+///
+/// VEC is the lane type, i.e. ezSimdVec4f or ezSimdVec8f. Use ezSimdTransformBatch4, ezSimdTransformBatch8 or ezSimdTransformBatchDefault.
+/// The results are the same as those of the corresponding ezSimdTransform functions, apart from floating point rounding.
+template <typename VEC>
+class ezSimdTransformBatch
+{
+public:
+  EZ_DECLARE_POD_TYPE();
+
+  typedef ezSimdBatchTraits<VEC> Traits;
+
+  /// \brief Default constructor: Does not do any initialization.
+  ezSimdTransformBatch() = default;
+
+  /// \brief Sets all lanes to the identity transform.
+  void SetIdentity(); // [tested]
+
+  /// \brief Sets all lanes to the given transform.
+  void Set(const ezSimdTransform& t); // [tested]
+
+  /// \brief Loads uiCount transforms. getTransform(i) must return a const ezSimdTransform&.
+  ///
+  /// uiCount must be between 1 and the number of lanes. The remaining lanes are filled with copies of the last transform.
+  template <typename ACCESSOR>
+  void Load(ezUInt32 uiCount, ACCESSOR getTransform); // [tested]
+
+  /// \brief Loads uiCount consecutive transforms.
+  void Load(const ezSimdTransform* pTransforms, ezUInt32 uiCount); // [tested]
+
+  /// \brief Stores uiCount transforms. getTransform(i) must return an ezSimdTransform&.
+  template <typename ACCESSOR>
+  void Store(ezUInt32 uiCount, ACCESSOR getTransform) const; // [tested]
+
+  /// \brief Stores uiCount consecutive transforms.
+  void Store(ezSimdTransform* pTransforms, ezUInt32 uiCount) const; // [tested]
+
+  /// \brief Returns the transform of the given lane.
+  ezSimdTransform GetLane(ezUInt32 uiLane) const; // [tested]
+
+public:
+  /// \brief Returns the scale component with maximum magnitude for every lane.
+  VEC GetMaxScale() const; // [tested]
+
+  /// \brief Sets every lane to the global transform that is reached by applying the child's local transform to the parent's global one.
+  void SetGlobalTransform(const ezSimdTransformBatch& globalTransformParent, const ezSimdTransformBatch& localTransformChild); // [tested]
+
+  ezSimdBatchVec3<VEC> TransformPosition(const ezSimdBatchVec3<VEC>& v) const;  // [tested]
+  ezSimdBatchVec3<VEC> TransformDirection(const ezSimdBatchVec3<VEC>& v) const; // [tested]
+
+  /// \brief Returns the columns of the upper 3x3 part of the transformation matrices, see ezSimdTransform::GetAsMat4().
+  void GetAsMat3(ezSimdBatchVec3<VEC>& out_col0, ezSimdBatchVec3<VEC>& out_col1, ezSimdBatchVec3<VEC>& out_col2) const; // [tested]
+
+public:
+  ezSimdBatchVec3<VEC> m_Position;
+  ezSimdBatchQuat<VEC> m_Rotation;
+  ezSimdBatchVec3<VEC> m_Scale;
+};
+
+/// \brief Concatenates the transforms of every lane, see ezSimdTransform operator*.
+template <typename VEC>
+const ezSimdTransformBatch<VEC> operator*(const ezSimdTransformBatch<VEC>& lhs, const ezSimdTransformBatch<VEC>& rhs); // [tested]
+
+typedef ezSimdTransformBatch<ezSimdVec4f> ezSimdTransformBatch4;
+typedef ezSimdTransformBatch<ezSimdVec8f> ezSimdTransformBatch8;
+typedef ezSimdTransformBatch<ezSimdBatchVec> ezSimdTransformBatchDefault;
+
+#include <Foundation/SimdMath/Implementation/SimdTransformBatch_inl.h>
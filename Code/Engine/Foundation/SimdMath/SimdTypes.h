@@ -19,3 +19,29 @@ struct ezMathAcc
 #else
 #  error "Unknown SIMD implementation."
 #endif
+
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE && EZ_SSE_LEVEL >= EZ_SSE_AVX2
+#  undef EZ_SIMD_NATIVE_VEC8
+#  define EZ_SIMD_NATIVE_VEC8 EZ_ON
+#else
+namespace ezInternal
+{
+  struct OctFloat
+  {
+    QuadFloat m_lo;
+    QuadFloat m_hi;
+  };
+
+  struct OctBool
+  {
+    QuadBool m_lo;
+    QuadBool m_hi;
+  };
+
+  struct OctInt
+  {
+    QuadInt m_lo;
+    QuadInt m_hi;
+  };
+} // namespace ezInternal
+#endif
@@ -73,6 +73,8 @@ public:
   ezSimdVec4i CompMax(const ezSimdVec4i& v) const; // [tested]
   ezSimdVec4i Abs() const;                         // [tested]
 
+  static ezSimdVec4i Select(const ezSimdVec4b& cmp, const ezSimdVec4i& ifTrue, const ezSimdVec4i& ifFalse); // [tested]
+
   ezSimdVec4b operator==(const ezSimdVec4i& v) const; // [tested]
   ezSimdVec4b operator!=(const ezSimdVec4i& v) const; // [tested]
   ezSimdVec4b operator<=(const ezSimdVec4i& v) const; // [tested]
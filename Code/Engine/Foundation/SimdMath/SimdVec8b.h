@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Foundation/SimdMath/SimdVec4b.h>
+
+/// \brief An 8-component SIMD vector of booleans, the result of comparisons between ezSimdVec8f or ezSimdVec8i.
+///
+/// Uses a 256 bit register when EZ_SIMD_NATIVE_VEC8 is enabled and two ezSimdVec4b otherwise.
+class EZ_FOUNDATION_DLL ezSimdVec8b
+{
+public:
+  EZ_DECLARE_POD_TYPE();
+
+  ezSimdVec8b();                                             // [tested]
+  explicit ezSimdVec8b(bool b);                              // [tested]
+  ezSimdVec8b(const ezSimdVec4b& lo, const ezSimdVec4b& hi); // [tested]
+  ezSimdVec8b(ezInternal::OctBool b);                        // [tested]
+
+public:
+  template <int N>
+  bool GetComponent() const; // [tested]
+
+  ezSimdVec4b GetLow() const;  // [tested]
+  ezSimdVec4b GetHigh() const; // [tested]
+
+  /// \brief Returns one bit per component, bit 0 is the first component.
+  ezUInt32 GetMask() const; // [tested]
+
+public:
+  ezSimdVec8b operator&&(const ezSimdVec8b& rhs) const; // [tested]
+  ezSimdVec8b operator||(const ezSimdVec8b& rhs) const; // [tested]
+  ezSimdVec8b operator!() const;                        // [tested]
+
+  bool AllSet() const;  // [tested]
+  bool AnySet() const;  // [tested]
+  bool NoneSet() const; // [tested]
+
+public:
+  ezInternal::OctBool m_v;
+};
+
+#if EZ_ENABLED(EZ_SIMD_NATIVE_VEC8)
+#  include <Foundation/SimdMath/Implementation/SSE/AVXVec8b_inl.h>
+#else
+#  include <Foundation/SimdMath/Implementation/Emulated/EmulatedVec8b_inl.h>
+#endif
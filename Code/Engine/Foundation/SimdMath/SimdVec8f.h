@@ -0,0 +1,104 @@
+#pragma once
+
+#include <Foundation/SimdMath/SimdVec4f.h>
+#include <Foundation/SimdMath/SimdVec8b.h>
+
+/// \brief An 8-component SIMD vector class for batch processing, e.g. of one component of eight positions at once.
+///
+/// Uses a 256 bit register when EZ_SIMD_NATIVE_VEC8 is enabled and two ezSimdVec4f otherwise, so code that is written
+/// for 8-wide data runs everywhere and gets faster when compiled for AVX2. See also ezSimdKernels for runtime selection.
+class EZ_FOUNDATION_DLL ezSimdVec8f
+{
+public:
+  EZ_DECLARE_POD_TYPE();
+
+  ezSimdVec8f(); // [tested]
+
+  explicit ezSimdVec8f(float f); // [tested]
+
+  ezSimdVec8f(const ezSimdVec4f& lo, const ezSimdVec4f& hi); // [tested]
+
+  ezSimdVec8f(ezInternal::OctFloat v); // [tested]
+
+  void Set(float f); // [tested]
+
+  void SetZero(); // [tested]
+
+  /// \brief Loads 8 floats, the pointer does not need to be aligned.
+  void Load(const float* pFloats); // [tested]
+
+  /// \brief Stores 8 floats, the pointer does not need to be aligned.
+  void Store(float* pFloats) const; // [tested]
+
+public:
+  template <ezMathAcc::Enum acc = ezMathAcc::FULL>
+  ezSimdVec8f GetReciprocal() const; // [tested]
+
+  template <ezMathAcc::Enum acc = ezMathAcc::FULL>
+  ezSimdVec8f GetSqrt() const; // [tested]
+
+  template <ezMathAcc::Enum acc = ezMathAcc::FULL>
+  ezSimdVec8f GetInvSqrt() const; // [tested]
+
+public:
+  template <int N>
+  float GetComponent() const; // [tested]
+
+  ezSimdVec4f GetLow() const;  // [tested]
+  ezSimdVec4f GetHigh() const; // [tested]
+
+public:
+  ezSimdVec8f operator-() const;                     // [tested]
+  ezSimdVec8f operator+(const ezSimdVec8f& v) const; // [tested]
+  ezSimdVec8f operator-(const ezSimdVec8f& v) const; // [tested]
+
+  ezSimdVec8f operator*(float f) const; // [tested]
+  ezSimdVec8f operator/(float f) const; // [tested]
+
+  ezSimdVec8f CompMul(const ezSimdVec8f& v) const; // [tested]
+
+  template <ezMathAcc::Enum acc = ezMathAcc::FULL>
+  ezSimdVec8f CompDiv(const ezSimdVec8f& v) const; // [tested]
+
+  ezSimdVec8f CompMin(const ezSimdVec8f& rhs) const; // [tested]
+  ezSimdVec8f CompMax(const ezSimdVec8f& rhs) const; // [tested]
+  ezSimdVec8f Abs() const;                           // [tested]
+  ezSimdVec8f Floor() const;                         // [tested]
+  ezSimdVec8f Ceil() const;                          // [tested]
+
+  static ezSimdVec8f Select(const ezSimdVec8b& cmp, const ezSimdVec8f& ifTrue, const ezSimdVec8f& ifFalse); // [tested]
+
+  ezSimdVec8f& operator+=(const ezSimdVec8f& v); // [tested]
+  ezSimdVec8f& operator-=(const ezSimdVec8f& v); // [tested]
+
+  ezSimdVec8f& operator*=(float f); // [tested]
+  ezSimdVec8f& operator/=(float f); // [tested]
+
+  ezSimdVec8b operator==(const ezSimdVec8f& v) const; // [tested]
+  ezSimdVec8b operator!=(const ezSimdVec8f& v) const; // [tested]
+  ezSimdVec8b operator<=(const ezSimdVec8f& v) const; // [tested]
+  ezSimdVec8b operator<(const ezSimdVec8f& v) const;  // [tested]
+  ezSimdVec8b operator>=(const ezSimdVec8f& v) const; // [tested]
+  ezSimdVec8b operator>(const ezSimdVec8f& v) const;  // [tested]
+
+  ezSimdFloat HorizontalSum() const; // [tested]
+  ezSimdFloat HorizontalMin() const; // [tested]
+  ezSimdFloat HorizontalMax() const; // [tested]
+
+  static ezSimdVec8f ZeroVector(); // [tested]
+
+  /// \brief Returns a * b + c, computed with a single rounding when FMA is available.
+  static ezSimdVec8f MulAdd(const ezSimdVec8f& a, const ezSimdVec8f& b, const ezSimdVec8f& c); // [tested]
+
+  /// \brief Returns a * b - c, computed with a single rounding when FMA is available.
+  static ezSimdVec8f MulSub(const ezSimdVec8f& a, const ezSimdVec8f& b, const ezSimdVec8f& c); // [tested]
+
+public:
+  ezInternal::OctFloat m_v;
+};
+
+#if EZ_ENABLED(EZ_SIMD_NATIVE_VEC8)
+#  include <Foundation/SimdMath/Implementation/SSE/AVXVec8f_inl.h>
+#else
+#  include <Foundation/SimdMath/Implementation/Emulated/EmulatedVec8f_inl.h>
+#endif
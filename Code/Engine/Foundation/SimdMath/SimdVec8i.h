@@ -0,0 +1,85 @@
+#pragma once
+
+#include <Foundation/SimdMath/SimdVec4i.h>
+#include <Foundation/SimdMath/SimdVec8f.h>
+
+/// \brief An 8-component SIMD vector class of signed 32b integers.
+///
+/// Uses a 256 bit register when EZ_SIMD_NATIVE_VEC8 is enabled and two ezSimdVec4i otherwise.
+class EZ_FOUNDATION_DLL ezSimdVec8i
+{
+public:
+  EZ_DECLARE_POD_TYPE();
+
+  ezSimdVec8i(); // [tested]
+
+  explicit ezSimdVec8i(ezInt32 i); // [tested]
+
+  ezSimdVec8i(const ezSimdVec4i& lo, const ezSimdVec4i& hi); // [tested]
+
+  ezSimdVec8i(ezInternal::OctInt v); // [tested]
+
+  void Set(ezInt32 i); // [tested]
+
+  void SetZero(); // [tested]
+
+  /// \brief Loads 8 integers, the pointer does not need to be aligned.
+  void Load(const ezInt32* pInts); // [tested]
+
+  /// \brief Stores 8 integers, the pointer does not need to be aligned.
+  void Store(ezInt32* pInts) const; // [tested]
+
+public:
+  ezSimdVec8f ToFloat() const; // [tested]
+
+  static ezSimdVec8i Truncate(const ezSimdVec8f& f); // [tested]
+
+public:
+  template <int N>
+  ezInt32 GetComponent() const; // [tested]
+
+  ezSimdVec4i GetLow() const;  // [tested]
+  ezSimdVec4i GetHigh() const; // [tested]
+
+public:
+  ezSimdVec8i operator-() const;                     // [tested]
+  ezSimdVec8i operator+(const ezSimdVec8i& v) const; // [tested]
+  ezSimdVec8i operator-(const ezSimdVec8i& v) const; // [tested]
+
+  ezSimdVec8i CompMul(const ezSimdVec8i& v) const; // [tested]
+
+  ezSimdVec8i operator|(const ezSimdVec8i& v) const; // [tested]
+  ezSimdVec8i operator&(const ezSimdVec8i& v) const; // [tested]
+  ezSimdVec8i operator^(const ezSimdVec8i& v) const; // [tested]
+  ezSimdVec8i operator~() const;                     // [tested]
+
+  ezSimdVec8i operator<<(ezUInt32 uiShift) const; // [tested]
+  ezSimdVec8i operator>>(ezUInt32 uiShift) const; // [tested]
+
+  ezSimdVec8i& operator+=(const ezSimdVec8i& v); // [tested]
+  ezSimdVec8i& operator-=(const ezSimdVec8i& v); // [tested]
+
+  ezSimdVec8i CompMin(const ezSimdVec8i& v) const; // [tested]
+  ezSimdVec8i CompMax(const ezSimdVec8i& v) const; // [tested]
+  ezSimdVec8i Abs() const;                         // [tested]
+
+  static ezSimdVec8i Select(const ezSimdVec8b& cmp, const ezSimdVec8i& ifTrue, const ezSimdVec8i& ifFalse); // [tested]
+
+  ezSimdVec8b operator==(const ezSimdVec8i& v) const; // [tested]
+  ezSimdVec8b operator!=(const ezSimdVec8i& v) const; // [tested]
+  ezSimdVec8b operator<=(const ezSimdVec8i& v) const; // [tested]
+  ezSimdVec8b operator<(const ezSimdVec8i& v) const;  // [tested]
+  ezSimdVec8b operator>=(const ezSimdVec8i& v) const; // [tested]
+  ezSimdVec8b operator>(const ezSimdVec8i& v) const;  // [tested]
+
+  static ezSimdVec8i ZeroVector(); // [tested]
+
+public:
+  ezInternal::OctInt m_v;
+};
+
+#if EZ_ENABLED(EZ_SIMD_NATIVE_VEC8)
+#  include <Foundation/SimdMath/Implementation/SSE/AVXVec8i_inl.h>
+#else
+#  include <Foundation/SimdMath/Implementation/Emulated/EmulatedVec8i_inl.h>
+#endif
@@ -14,7 +14,9 @@ class ezTempHashedString;
 /// (it's a pointer comparison).\n
 /// Copying ezHashedString objects around and assigning between them is very fast as well.\n
 /// \n
-/// Assigning from some other string type is rather slow though, as it requires thread synchronization.\n
+/// Assigning from some other string type is slower though, as it has to look up the string in the central storage. Every thread caches
+/// the strings it added recently, so repeatedly assigning the same strings does not require thread synchronization. Otherwise the storage
+/// is split into several shards with separate locks, so that threads only wait for each other when they add strings to the same shard.\n
 /// You can also get access to the actual string data via GetString().\n
 /// \n
 /// You should use ezHashedString whenever the size of the encapsulating object is important and when changes to the string itself
@@ -45,6 +47,9 @@ public:
   /// This function will clean up all unused strings. It should typically not be necessary to call this function at all, unless lots of
   /// strings get stored in ezHashedString that are not really used throughout the applications life time.
   ///
+  /// Strings that are only referenced by the lookup cache of another thread are kept until that thread has dropped them,
+  /// which it does the next time it adds a string. They are removed by a later call to this function.
+  ///
   /// Returns the number of unused strings that were removed.
   static ezUInt32 ClearUnusedStrings();
 #endif
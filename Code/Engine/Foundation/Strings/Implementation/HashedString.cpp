@@ -4,15 +4,97 @@
 #include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/Mutex.h>
 
-struct HashedStringData
+// The strings are distributed over several maps by the upper bits of their hash, so that threads that add different strings rarely
+// wait for the same mutex.
+static constexpr ezUInt32 s_uiNumHashedStringShardBits = 5;
+static constexpr ezUInt32 s_uiNumHashedStringShards = 1u << s_uiNumHashedStringShardBits;
+
+struct EZ_ALIGN_64(HashedStringShard)
 {
   ezMutex m_Mutex;
   ezHashedString::StringStorage m_Storage;
+};
+
+struct HashedStringData
+{
+  HashedStringShard m_Shards[s_uiNumHashedStringShards];
   ezHashedString::HashedType m_Empty;
+
+  /// Incremented by ClearUnusedStrings() to tell all threads to drop the strings in their cache.
+  ezAtomicInteger32 m_iCacheGeneration;
 };
 
 static HashedStringData* s_pHSData;
 
+EZ_ALWAYS_INLINE static HashedStringShard& GetHashedStringShard(ezUInt32 uiHash)
+{
+  return s_pHSData->m_Shards[uiHash >> (32 - s_uiNumHashedStringShardBits)];
+}
+
+/// \brief A small direct mapped cache of the strings that the current thread added recently.
+///
+/// Most code adds the same few strings over and over again (e.g. message and property names), these are found here without
+/// locking anything. With ref counting every cache entry holds a reference, so the string cannot be removed while it is cached.
+struct HashedStringThreadCache
+{
+  static constexpr ezUInt32 NumEntries = 64;
+
+  struct Entry
+  {
+    ezUInt32 m_uiHash = 0;
+    ezHashedString::HashedType m_Data;
+  };
+
+  ~HashedStringThreadCache() { Flush(); }
+
+  EZ_ALWAYS_INLINE ezHashedString::HashedType* Lookup(ezUInt32 uiHash)
+  {
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+    if (m_iGeneration != s_pHSData->m_iCacheGeneration)
+    {
+      Flush();
+      m_iGeneration = s_pHSData->m_iCacheGeneration;
+    }
+#endif
+
+    Entry& entry = m_Entries[uiHash % NumEntries];
+    return (entry.m_uiHash == uiHash && entry.m_Data.IsValid()) ? &entry.m_Data : nullptr;
+  }
+
+  void Store(ezUInt32 uiHash, ezHashedString::HashedType data)
+  {
+    Entry& entry = m_Entries[uiHash % NumEntries];
+
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+    data.Value().m_iRefCount.Increment();
+
+    if (entry.m_Data.IsValid())
+      entry.m_Data.Value().m_iRefCount.Decrement();
+#endif
+
+    entry.m_uiHash = uiHash;
+    entry.m_Data = data;
+  }
+
+  void Flush()
+  {
+    for (Entry& entry : m_Entries)
+    {
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+      if (entry.m_Data.IsValid())
+        entry.m_Data.Value().m_iRefCount.Decrement();
+#endif
+
+      entry = Entry();
+    }
+  }
+
+  Entry m_Entries[NumEntries];
+  ezInt32 m_iGeneration = 0;
+};
+
+static thread_local HashedStringThreadCache tl_HashedStringCache;
+
 EZ_MSVC_ANALYSIS_WARNING_PUSH
 EZ_MSVC_ANALYSIS_WARNING_DISABLE(6011) // Disable warning for null pointer dereference as InitHashedString() will ensure that s_pHSData is set
 
@@ -22,28 +104,42 @@ ezHashedString::HashedType ezHashedString::AddHashedString(const char* szString,
   if (s_pHSData == nullptr)
     InitHashedString();
 
-  EZ_LOCK(s_pHSData->m_Mutex);
-
-  // try to find the existing string
-  bool bExisted = false;
-  auto ret = s_pHSData->m_Storage.FindOrAdd(uiHash, &bExisted);
-
-  // if it already exists, just increase the refcount
-  if (bExisted)
+  if (HashedType* pCached = tl_HashedStringCache.Lookup(uiHash))
   {
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
-    ret.Value().m_iRefCount.Increment();
+    pCached->Value().m_iRefCount.Increment();
 #endif
+    return *pCached;
   }
-  else
+
+  HashedType ret;
+
   {
-    ezHashedString::HashedData& d = ret.Value();
+    HashedStringShard& shard = GetHashedStringShard(uiHash);
+    EZ_LOCK(shard.m_Mutex);
+
+    // try to find the existing string
+    bool bExisted = false;
+    ret = shard.m_Storage.FindOrAdd(uiHash, &bExisted);
+
+    // if it already exists, just increase the refcount
+    if (bExisted)
+    {
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+      ret.Value().m_iRefCount.Increment();
+#endif
+    }
+    else
+    {
+      ezHashedString::HashedData& d = ret.Value();
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
-    d.m_iRefCount = 1;
+      d.m_iRefCount = 1;
 #endif
-    d.m_sString = szString;
+      d.m_sString = szString;
+    }
   }
 
+  tl_HashedStringCache.Store(uiHash, ret);
   return ret;
 }
 
@@ -70,19 +166,26 @@ void ezHashedString::InitHashedString()
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
 ezUInt32 ezHashedString::ClearUnusedStrings()
 {
-  EZ_LOCK(s_pHSData->m_Mutex);
+  // all threads drop their cached references on their next lookup, the current thread does so right away
+  s_pHSData->m_iCacheGeneration.Increment();
+  tl_HashedStringCache.Flush();
 
   ezUInt32 uiDeleted = 0;
 
-  for (auto it = s_pHSData->m_Storage.GetIterator(); it.IsValid();)
+  for (HashedStringShard& shard : s_pHSData->m_Shards)
   {
-    if (it.Value().m_iRefCount == 0)
+    EZ_LOCK(shard.m_Mutex);
+
+    for (auto it = shard.m_Storage.GetIterator(); it.IsValid();)
     {
-      it = s_pHSData->m_Storage.Remove(it);
-      ++uiDeleted;
+      if (it.Value().m_iRefCount == 0)
+      {
+        it = shard.m_Storage.Remove(it);
+        ++uiDeleted;
+      }
+      else
+        ++it;
     }
-    else
-      ++it;
   }
 
   return uiDeleted;
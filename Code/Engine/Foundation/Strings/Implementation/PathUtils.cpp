@@ -1,5 +1,6 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/Memory/ArenaAllocator.h>
 #include <Foundation/Strings/Implementation/StringIterator.h>
 #include <Foundation/Strings/StringBuilder.h>
 
@@ -280,7 +281,8 @@ bool ezPathUtils::IsSubPath(const ezStringView& sPrefixPath, const ezStringView&
 {
   /// \test this is new
 
-  ezStringBuilder tmp = sPrefixPath;
+  ezArenaAllocator<> arena;
+  ezStringBuilder tmp(sPrefixPath, &arena);
   tmp.MakeCleanPath();
   tmp.AppendPath("");
 
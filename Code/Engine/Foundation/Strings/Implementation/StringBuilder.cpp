@@ -1,6 +1,7 @@
 #include <FoundationPCH.h>
 
 #include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Memory/ArenaAllocator.h>
 #include <Foundation/Strings/FormatString.h>
 #include <Foundation/Strings/StringBuilder.h>
 
@@ -927,9 +928,10 @@ void ezStringBuilder::RemoveFileExtension()
 
 ezResult ezStringBuilder::MakeRelativeTo(const char* szAbsolutePathToMakeThisRelativeTo)
 {
-  ezStringBuilder sAbsBase = szAbsolutePathToMakeThisRelativeTo;
+  ezArenaAllocator<> arena;
+  ezStringBuilder sAbsBase(szAbsolutePathToMakeThisRelativeTo, &arena);
   sAbsBase.MakeCleanPath();
-  ezStringBuilder sAbsThis = *this;
+  ezStringBuilder sAbsThis(GetView(), &arena);
   sAbsThis.MakeCleanPath();
 
   if (sAbsBase.IsEqual_NoCase(sAbsThis.GetData()))
@@ -1,5 +1,6 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/Strings/Implementation/Utf8Simd.h>
 #include <Foundation/Strings/StringConversion.h>
 
 // **************** ezStringWChar ****************
@@ -19,6 +20,12 @@ void ezStringWChar::operator=(const char* szUtf8)
 
     while (*szUtf8 != '\0')
     {
+      // ASCII characters are converted 16 at a time
+      szUtf8 += ezInternal::Utf8Simd::AppendAsciiToUtf16Or32<wchar_t>(szUtf8, m_Data);
+
+      if (*szUtf8 == '\0')
+        break;
+
       // decode utf8 to utf32
       const ezUInt32 uiUtf32 = ezUnicodeUtils::DecodeUtf8ToUtf32(szUtf8);
 
@@ -138,6 +145,12 @@ void ezStringUtf8::operator=(const ezUInt16* szUtf16)
 
     while (*szUtf16 != '\0')
     {
+      // ASCII characters are converted 8 at a time
+      szUtf16 += ezInternal::Utf8Simd::AppendAsciiToUtf8(szUtf16, m_Data);
+
+      if (*szUtf16 == '\0')
+        break;
+
       // decode utf8 to utf32
       const ezUInt32 uiUtf32 = ezUnicodeUtils::DecodeUtf16ToUtf32(szUtf16);
 
@@ -160,6 +173,12 @@ void ezStringUtf8::operator=(const ezUInt32* szUtf32)
   {
     while (*szUtf32 != '\0')
     {
+      // ASCII characters are converted 4 at a time
+      szUtf32 += ezInternal::Utf8Simd::AppendAsciiToUtf8(szUtf32, m_Data);
+
+      if (*szUtf32 == '\0')
+        break;
+
       // decode utf8 to utf32
       const ezUInt32 uiUtf32 = *szUtf32;
       ++szUtf32;
@@ -182,6 +201,12 @@ void ezStringUtf8::operator=(const wchar_t* szWChar)
   {
     while (*szWChar != '\0')
     {
+      // ASCII characters are converted 4 or 8 at a time, depending on the size of wchar_t
+      szWChar += ezInternal::Utf8Simd::AppendAsciiToUtf8(szWChar, m_Data);
+
+      if (*szWChar == '\0')
+        break;
+
       // decode utf8 to utf32
       const ezUInt32 uiUtf32 = ezUnicodeUtils::DecodeWCharToUtf32(szWChar);
 
@@ -237,6 +262,12 @@ void ezStringUtf16::operator=(const char* szUtf8)
 
     while (*szUtf8 != '\0')
     {
+      // ASCII characters are converted 16 at a time
+      szUtf8 += ezInternal::Utf8Simd::AppendAsciiToUtf16Or32<ezUInt16>(szUtf8, m_Data);
+
+      if (*szUtf8 == '\0')
+        break;
+
       // decode utf8 to utf32
       const ezUInt32 uiUtf32 = ezUnicodeUtils::DecodeUtf8ToUtf32(szUtf8);
 
@@ -334,6 +365,12 @@ void ezStringUtf32::operator=(const char* szUtf8)
 
     while (*szUtf8 != '\0')
     {
+      // ASCII characters are converted 16 at a time
+      szUtf8 += ezInternal::Utf8Simd::AppendAsciiToUtf16Or32<ezUInt32>(szUtf8, m_Data);
+
+      if (*szUtf8 == '\0')
+        break;
+
       // decode utf8 to utf32
       m_Data.PushBack(ezUnicodeUtils::DecodeUtf8ToUtf32(szUtf8));
     }
@@ -1,5 +1,6 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/Strings/Implementation/Utf8Simd.h>
 #include <Foundation/Strings/StringView.h>
 #include <Foundation/Utilities/ConversionUtils.h>
 
@@ -48,6 +49,57 @@ void ezStringUtils::PrintStringLengthStatistics()
 
 #endif
 
+ezUInt32 ezStringUtils::GetCharacterCount(const char* szUtf8, const char* pStringEnd)
+{
+  if (IsNullOrEmpty(szUtf8))
+    return 0;
+
+  ezUInt32 uiCharacters = 0;
+
+  while (true)
+  {
+    uiCharacters += ezInternal::Utf8Simd::SkipCharacters(szUtf8, pStringEnd);
+
+    if ((szUtf8 >= pStringEnd) || (*szUtf8 == '\0'))
+      break;
+
+    // skip all the Utf8 continuation bytes
+    if (!ezUnicodeUtils::IsUtf8ContinuationByte(*szUtf8))
+      ++uiCharacters;
+
+    ++szUtf8;
+  }
+
+  return uiCharacters;
+}
+
+void ezStringUtils::GetCharacterAndElementCount(const char* szUtf8, ezUInt32& uiCharacterCount, ezUInt32& uiElementCount, const char* pStringEnd)
+{
+  uiCharacterCount = 0;
+  uiElementCount = 0;
+
+  if (IsNullOrEmpty(szUtf8))
+    return;
+
+  const char* szStart = szUtf8;
+
+  while (true)
+  {
+    uiCharacterCount += ezInternal::Utf8Simd::SkipCharacters(szUtf8, pStringEnd);
+
+    if ((szUtf8 >= pStringEnd) || (*szUtf8 == '\0'))
+      break;
+
+    // skip all the Utf8 continuation bytes
+    if (!ezUnicodeUtils::IsUtf8ContinuationByte(*szUtf8))
+      ++uiCharacterCount;
+
+    ++szUtf8;
+  }
+
+  uiElementCount = static_cast<ezUInt32>(szUtf8 - szStart);
+}
+
 // Unicode ToUpper / ToLower character conversion
 //  License: $(WEB www.boost.org/LICENSE_1_0.txt, Boost License 1.0).
 //  Authors: $(WEB digitalmars.com, Walter Bright), Jonathan M Davis, and Kenji Hara
@@ -265,8 +317,16 @@ ezInt32 ezStringUtils::Compare(const char* pString1, const char* pString2, const
 {
   EZ_STRINGCOMPARE_HANDLE_NULL_PTRS(pString1, pString2, 0, -1, 1, pString1End, pString2End);
 
-  while ((*pString1 != '\0') && (*pString2 != '\0') && (pString1 < pString1End) && (pString2 < pString2End))
+  while (true)
   {
+    // skip all equal bytes 16 at a time
+    const ezUInt32 uiEqualBytes = ezInternal::Utf8Simd::CountEqualBytes(pString1, pString2, pString1End, pString2End);
+    pString1 += uiEqualBytes;
+    pString2 += uiEqualBytes;
+
+    if (!((*pString1 != '\0') && (*pString2 != '\0') && (pString1 < pString1End) && (pString2 < pString2End)))
+      break;
+
     if (*pString1 != *pString2)
       return ToSignedInt(*pString1) - ToSignedInt(*pString2);
 
@@ -333,8 +393,16 @@ ezInt32 ezStringUtils::Compare_NoCase(const char* pString1, const char* pString2
 {
   EZ_STRINGCOMPARE_HANDLE_NULL_PTRS(pString1, pString2, 0, -1, 1, pString1End, pString2End);
 
-  while ((*pString1 != '\0') && (*pString2 != '\0') && (pString1 < pString1End) && (pString2 < pString2End))
+  while (true)
   {
+    // skip all ASCII characters that are equal, ignoring their case, 16 at a time
+    const ezUInt32 uiEqualBytes = ezInternal::Utf8Simd::CountEqualAscii_NoCase(pString1, pString2, pString1End, pString2End);
+    pString1 += uiEqualBytes;
+    pString2 += uiEqualBytes;
+
+    if (!((*pString1 != '\0') && (*pString2 != '\0') && (pString1 < pString1End) && (pString2 < pString2End)))
+      break;
+
     // utf8::next will already advance the iterators
     const ezUInt32 uiChar1 = ezUnicodeUtils::DecodeUtf8ToUtf32(pString1);
     const ezUInt32 uiChar2 = ezUnicodeUtils::DecodeUtf8ToUtf32(pString2);
@@ -371,8 +439,18 @@ ezInt32 ezStringUtils::CompareN_NoCase(
 
   EZ_STRINGCOMPARE_HANDLE_NULL_PTRS(pString1, pString2, 0, -1, 1, pString1End, pString2End);
 
-  while ((*pString1 != '\0') && (*pString2 != '\0') && (uiCharsToCompare > 0) && (pString1 < pString1End) && (pString2 < pString2End))
+  while (true)
   {
+    // every ASCII character is a single byte, so at most uiCharsToCompare of them can be skipped
+    const ezUInt32 uiEqualBytes =
+      ezMath::Min(ezInternal::Utf8Simd::CountEqualAscii_NoCase(pString1, pString2, pString1End, pString2End), uiCharsToCompare);
+    pString1 += uiEqualBytes;
+    pString2 += uiEqualBytes;
+    uiCharsToCompare -= uiEqualBytes;
+
+    if (!((*pString1 != '\0') && (*pString2 != '\0') && (uiCharsToCompare > 0) && (pString1 < pString1End) && (pString2 < pString2End)))
+      break;
+
     // utf8::next will already advance the iterators
     const ezUInt32 uiChar1 = ezUnicodeUtils::DecodeUtf8ToUtf32(pString1);
     const ezUInt32 uiChar2 = ezUnicodeUtils::DecodeUtf8ToUtf32(pString2);
@@ -610,8 +688,28 @@ const char* ezStringUtils::FindSubString(const char* szSource, const char* szStr
 
   const char* pCurPos = &szSource[0];
 
+  // a valid Utf8 string never starts with a continuation byte, so every occurrence of its first byte is the start of a character
+  const ezUInt8 uiFirstByte = static_cast<ezUInt8>(szStringToFind[0]);
+  const bool bUseCandidates = !ezUnicodeUtils::IsUtf8ContinuationByte(szStringToFind[0]);
+
   while ((*pCurPos != '\0') && (pCurPos < pSourceEnd))
   {
+    ezUInt32 uiCandidates, uiValidBytes;
+    if (bUseCandidates && ezInternal::Utf8Simd::FindBytes(pCurPos, pSourceEnd, uiFirstByte, uiFirstByte, uiFirstByte, uiCandidates, uiValidBytes))
+    {
+      for (; uiCandidates != 0; uiCandidates &= uiCandidates - 1)
+      {
+        const char* pCandidate = pCurPos + ezMath::FirstBitLow(uiCandidates);
+
+        if (ezStringUtils::StartsWith(pCandidate, szStringToFind, pSourceEnd))
+          return pCandidate;
+      }
+
+      // this may stop in the middle of a character, which is fine, since continuation bytes are never candidates
+      pCurPos += uiValidBytes;
+      continue;
+    }
+
     if (ezStringUtils::StartsWith(pCurPos, szStringToFind, pSourceEnd))
       return pCurPos;
 
@@ -629,8 +727,32 @@ const char* ezStringUtils::FindSubString_NoCase(const char* szSource, const char
 
   const char* pCurPos = &szSource[0];
 
+  // If the searched string starts with an ASCII character, only the bytes that are equal to it in upper or lower case can start a match.
+  // The only exceptions are the characters 0x130, 0x131 (upper case 'I') and 0x17F (upper case 'S'), which start with 0xC4 and 0xC5.
+  const ezUInt32 uiFirstChar = static_cast<ezUInt8>(szStringToFind[0]);
+  const ezUInt32 uiFirstCharUpper = ezStringUtils::ToUpperChar(uiFirstChar);
+  const bool bUseCandidates = ezUnicodeUtils::IsASCII(uiFirstChar);
+  const ezUInt8 uiSpecialByte = (uiFirstCharUpper == 'I') ? 0xC4 : ((uiFirstCharUpper == 'S') ? 0xC5 : static_cast<ezUInt8>(uiFirstChar));
+
   while ((*pCurPos != '\0') && (pCurPos < pSourceEnd))
   {
+    ezUInt32 uiCandidates, uiValidBytes;
+    if (bUseCandidates && ezInternal::Utf8Simd::FindBytes(pCurPos, pSourceEnd, static_cast<ezUInt8>(uiFirstCharUpper),
+                            static_cast<ezUInt8>(ezStringUtils::ToLowerChar(uiFirstChar)), uiSpecialByte, uiCandidates, uiValidBytes))
+    {
+      for (; uiCandidates != 0; uiCandidates &= uiCandidates - 1)
+      {
+        const char* pCandidate = pCurPos + ezMath::FirstBitLow(uiCandidates);
+
+        if (ezStringUtils::StartsWith_NoCase(pCandidate, szStringToFind, pSourceEnd))
+          return pCandidate;
+      }
+
+      // this may stop in the middle of a character, which is fine, since continuation bytes are never candidates
+      pCurPos += uiValidBytes;
+      continue;
+    }
+
     if (ezStringUtils::StartsWith_NoCase(pCurPos, szStringToFind, pSourceEnd))
       return pCurPos;
 
@@ -61,51 +61,6 @@ ezUInt32 ezStringUtils::GetStringElementCount(const T* pString, const T* pString
   return uiCount;
 }
 
-inline ezUInt32 ezStringUtils::GetCharacterCount(const char* szUtf8, const char* pStringEnd)
-{
-  if (IsNullOrEmpty(szUtf8))
-    return 0;
-
-  ezUInt32 uiCharacters = 0;
-
-  while ((*szUtf8 != '\0') && (szUtf8 < pStringEnd))
-  {
-    // skip all the Utf8 continuation bytes
-    if (!ezUnicodeUtils::IsUtf8ContinuationByte(*szUtf8))
-      ++uiCharacters;
-
-    ++szUtf8;
-  }
-
-  return uiCharacters;
-}
-
-inline void ezStringUtils::GetCharacterAndElementCount(
-  const char* szUtf8, ezUInt32& uiCharacterCount, ezUInt32& uiElementCount, const char* pStringEnd)
-{
-  uiCharacterCount = 0;
-  uiElementCount = 0;
-
-  if (IsNullOrEmpty(szUtf8))
-    return;
-
-  while (szUtf8 < pStringEnd)
-  {
-    char uiByte = *szUtf8;
-    if (uiByte == '\0')
-    {
-      break;
-    }
-
-    // skip all the Utf8 continuation bytes
-    if (!ezUnicodeUtils::IsUtf8ContinuationByte(uiByte))
-      ++uiCharacterCount;
-
-    ++szUtf8;
-    ++uiElementCount;
-  }
-}
-
 EZ_ALWAYS_INLINE bool ezStringUtils::IsEqual(const char* pString1, const char* pString2, const char* pString1End, const char* pString2End)
 {
   return ezStringUtils::Compare(pString1, pString2, pString1End, pString2End) == 0;
@@ -0,0 +1,149 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Strings/Implementation/Utf8Simd.h>
+#include <Foundation/Strings/UnicodeUtils.h>
+
+#if EZ_ENABLED(EZ_UTF8_SIMD)
+
+namespace
+{
+  // The error bits of the lookup tables, each one is only set, if all three tables agree.
+  enum : ezUInt8
+  {
+    TOO_SHORT = 1 << 0,      // a lead byte or an ASCII character follows a lead byte
+    TOO_LONG = 1 << 1,       // a continuation byte follows an ASCII character
+    OVERLONG_3 = 1 << 2,     // 11100000 100_____
+    TOO_LARGE = 1 << 3,      // 11110100 1001____ and larger
+    SURROGATE = 1 << 4,      // 11101101 101_____
+    OVERLONG_2 = 1 << 5,     // 1100000_ 10______
+    TOO_LARGE_1000 = 1 << 6, // 11110101 1000____ and larger
+    OVERLONG_4 = 1 << 6,     // 11110000 1000____
+    TWO_CONTS = 1 << 7,      // two continuation bytes in a row, only valid as the third or fourth byte of a sequence
+    CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS,
+  };
+
+  // indexed with the high nibble of the first byte
+  static const ezUInt8 s_Utf8Byte1High[16] = {
+    // 0_______ ASCII
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+    // 10______ continuation
+    TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+    // 1100____ two byte lead
+    TOO_SHORT | OVERLONG_2,
+    // 1101____ two byte lead
+    TOO_SHORT,
+    // 1110____ three byte lead
+    TOO_SHORT | OVERLONG_3 | SURROGATE,
+    // 1111____ four byte lead
+    TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4};
+
+  // indexed with the low nibble of the first byte
+  static const ezUInt8 s_Utf8Byte1Low[16] = {
+    // ____0000
+    CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+    // ____0001
+    CARRY | OVERLONG_2,
+    // ____001_
+    CARRY, CARRY,
+    // ____0100
+    CARRY | TOO_LARGE,
+    // ____0101 - ____1100
+    CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+    // ____1101
+    CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+    // ____111_
+    CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000};
+
+  // indexed with the high nibble of the second byte
+  static const ezUInt8 s_Utf8Byte2High[16] = {
+    // 0_______ ASCII
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+    // 1000____
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+    // 1001____
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+    // 101_____
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE, TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    // 11______ lead byte
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT};
+
+  /// Validates Utf8 16 bytes at a time with the lookup algorithm from "Validating UTF-8 In Less Than One Instruction Per Byte"
+  /// (Keiser, Lemire). Three table lookups with the nibbles of every byte and its predecessor find all invalid combinations of two bytes,
+  /// and the positions of three and four byte lead bytes tell where two continuation bytes in a row are required.
+  class ezUtf8Validator
+  {
+  public:
+    void AddBlock(__m128i input)
+    {
+      if (_mm_movemask_epi8(input) == 0)
+      {
+        // an ASCII block is only an error, if the previous block ended in the middle of a sequence
+        m_Error = _mm_or_si128(m_Error, m_PrevIncomplete);
+      }
+      else
+      {
+        const __m128i prev1 = _mm_alignr_epi8(input, m_PrevInput, 15);
+        const __m128i prev2 = _mm_alignr_epi8(input, m_PrevInput, 14);
+        const __m128i prev3 = _mm_alignr_epi8(input, m_PrevInput, 13);
+
+        const __m128i lowNibbleMask = _mm_set1_epi8(0x0F);
+        const __m128i byte1High = _mm_shuffle_epi8(LoadTable(s_Utf8Byte1High), _mm_and_si128(_mm_srli_epi16(prev1, 4), lowNibbleMask));
+        const __m128i byte1Low = _mm_shuffle_epi8(LoadTable(s_Utf8Byte1Low), _mm_and_si128(prev1, lowNibbleMask));
+        const __m128i byte2High = _mm_shuffle_epi8(LoadTable(s_Utf8Byte2High), _mm_and_si128(_mm_srli_epi16(input, 4), lowNibbleMask));
+        const __m128i specialCases = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+        // only 111_____ and 1111____ keep their highest bit, i.e. two and three bytes later, continuation bytes are required
+        const __m128i isThirdByte = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+        const __m128i isFourthByte = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+        const __m128i mustBeContinuation = _mm_and_si128(_mm_or_si128(isThirdByte, isFourthByte), _mm_set1_epi8(static_cast<char>(0x80)));
+
+        // TWO_CONTS is exactly where a third or fourth byte is, anything else is an error
+        m_Error = _mm_or_si128(m_Error, _mm_xor_si128(mustBeContinuation, specialCases));
+
+        // lead bytes at the end of the block, whose continuation bytes would have to be in the next block
+        const __m128i maxValue = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+        m_PrevIncomplete = _mm_subs_epu8(input, maxValue);
+      }
+
+      m_PrevInput = input;
+    }
+
+    bool IsValid() const { return _mm_testz_si128(_mm_or_si128(m_Error, m_PrevIncomplete), _mm_set1_epi8(-1)) != 0; }
+
+  private:
+    EZ_ALWAYS_INLINE static __m128i LoadTable(const ezUInt8* pTable) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(pTable)); }
+
+    __m128i m_PrevInput = _mm_setzero_si128();
+    __m128i m_PrevIncomplete = _mm_setzero_si128();
+    __m128i m_Error = _mm_setzero_si128();
+  };
+} // namespace
+
+#endif
+
+bool ezUnicodeUtils::IsValidUtf8(const char* szString, const char* szStringEnd)
+{
+  if (szStringEnd == GetMaxStringEnd<char>())
+    szStringEnd = szString + strlen(szString);
+
+#if EZ_ENABLED(EZ_UTF8_SIMD)
+  ezUtf8Validator validator;
+
+  for (; szStringEnd - szString >= static_cast<ptrdiff_t>(ezInternal::Utf8Simd::BlockSize); szString += ezInternal::Utf8Simd::BlockSize)
+  {
+    validator.AddBlock(ezInternal::Utf8Simd::LoadBlock(szString));
+  }
+
+  // the remaining bytes are padded with zeros, which are valid ASCII characters
+  char lastBlock[ezInternal::Utf8Simd::BlockSize] = {};
+  ezMemoryUtils::RawByteCopy(lastBlock, szString, szStringEnd - szString);
+  validator.AddBlock(ezInternal::Utf8Simd::LoadBlock(lastBlock));
+
+  return validator.IsValid();
+#else
+  return utf8::is_valid(szString, szStringEnd);
+#endif
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Strings_Implementation_UnicodeUtils);
@@ -140,14 +140,6 @@ inline ezUInt32 ezUnicodeUtils::GetSizeForCharacterInUtf8(ezUInt32 uiCharacter)
   return 4;
 }
 
-inline bool ezUnicodeUtils::IsValidUtf8(const char* szString, const char* szStringEnd)
-{
-  if (szStringEnd == GetMaxStringEnd<char>())
-    szStringEnd = szString + strlen(szString);
-
-  return utf8::is_valid(szString, szStringEnd);
-}
-
 inline bool ezUnicodeUtils::SkipUtf8Bom(const char*& szUtf8)
 {
   EZ_ASSERT_DEBUG(szUtf8 != nullptr, "This function expects non nullptr pointers");
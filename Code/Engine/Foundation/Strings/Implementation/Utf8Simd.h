@@ -0,0 +1,244 @@
+#pragma once
+
+#include <Foundation/Math/Math.h>
+#include <Foundation/Strings/UnicodeUtils.h>
+
+// Independent of EZ_SIMD_IMPLEMENTATION, all x86 builds target at least SSE4.1 (see ezUtilsCppFlags.cmake).
+// MSVC does not define __SSE4_1__, but allows the intrinsics anyway.
+#if EZ_ENABLED(EZ_PLATFORM_ARCH_X86) && (defined(__SSE4_1__) || EZ_ENABLED(EZ_COMPILER_MSVC))
+#  define EZ_UTF8_SIMD EZ_ON
+#  include <smmintrin.h>
+#  include <tmmintrin.h>
+#else
+#  define EZ_UTF8_SIMD EZ_OFF
+#endif
+
+namespace ezInternal
+{
+  /// \brief SSE helpers for the string functions, which look at blocks of 16 bytes at once.
+  ///
+  /// All functions only handle the common case, e.g. a block of ASCII characters, and return how much of the block they processed.
+  /// The callers then fall back to their scalar code for the next character, so the result is always identical to the scalar code.
+  /// Without SSE, the functions always return 0.
+  ///
+  /// The end of a zero terminated string is not known in advance. For those, a block is only loaded, if it does not cross a page
+  /// boundary. Such a load may read a few bytes behind the terminator, but it can never touch a page that the string does not touch.
+  struct Utf8Simd
+  {
+    enum : ezUInt32
+    {
+      BlockSize = 16,
+      PageSize = 4096,
+    };
+
+    /// \brief Returns whether a whole block can be read at pData, without reading past pEnd or into an unknown page.
+    template <typename T>
+    EZ_ALWAYS_INLINE static bool CanLoadBlock(const T* pData, const T* pEnd)
+    {
+      if (pEnd != ezUnicodeUtils::GetMaxStringEnd<T>())
+        return reinterpret_cast<const char*>(pEnd) - reinterpret_cast<const char*>(pData) >= static_cast<ptrdiff_t>(BlockSize);
+
+      return (reinterpret_cast<size_t>(pData) & (PageSize - 1)) <= PageSize - BlockSize;
+    }
+
+#if EZ_ENABLED(EZ_UTF8_SIMD)
+
+    EZ_ALWAYS_INLINE static __m128i LoadBlock(const void* pData) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData)); }
+
+    /// \brief Returns a bitmask with one bit per byte that is either non-ASCII or zero.
+    EZ_ALWAYS_INLINE static ezUInt32 MatchNonAsciiOrZero(__m128i block)
+    {
+      return static_cast<ezUInt32>(_mm_movemask_epi8(_mm_or_si128(block, _mm_cmpeq_epi8(block, _mm_setzero_si128()))));
+    }
+
+    /// \brief Converts all ASCII characters in the block to upper case and leaves all other bytes unchanged.
+    EZ_ALWAYS_INLINE static __m128i ToUpperAscii(__m128i block)
+    {
+      const __m128i isLower = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(block, _mm_set1_epi8('z' + 1)));
+      return _mm_sub_epi8(block, _mm_and_si128(isLower, _mm_set1_epi8('a' - 'A')));
+    }
+
+    /// \brief Returns the number of leading bytes that are neither zero nor the first difference between the two blocks.
+    EZ_ALWAYS_INLINE static ezUInt32 CountEqual(__m128i block1, __m128i block2, ezUInt32 uiStopMask)
+    {
+      const ezUInt32 uiEqual = static_cast<ezUInt32>(_mm_movemask_epi8(_mm_cmpeq_epi8(block1, block2)));
+      const ezUInt32 uiZero = static_cast<ezUInt32>(_mm_movemask_epi8(_mm_cmpeq_epi8(block1, _mm_setzero_si128())));
+
+      return ezMath::FirstBitLow((~uiEqual | uiZero | uiStopMask) | (1u << BlockSize));
+    }
+
+#endif
+
+    /// \brief Returns how many of the next 16 bytes are equal in both strings, stopping at the terminator.
+    EZ_ALWAYS_INLINE static ezUInt32 CountEqualBytes(const char* pString1, const char* pString2, const char* pString1End, const char* pString2End)
+    {
+#if EZ_ENABLED(EZ_UTF8_SIMD)
+      if (CanLoadBlock(pString1, pString1End) && CanLoadBlock(pString2, pString2End))
+      {
+        return CountEqual(LoadBlock(pString1), LoadBlock(pString2), 0);
+      }
+#endif
+
+      return 0;
+    }
+
+    /// \brief Returns how many of the next 16 bytes are ASCII characters in both strings and equal, when ignoring their case.
+    ///
+    /// Non-ASCII characters are left to the scalar code, because a few of them are equal to ASCII characters in case-insensitive comparisons.
+    EZ_ALWAYS_INLINE static ezUInt32 CountEqualAscii_NoCase(const char* pString1, const char* pString2, const char* pString1End, const char* pString2End)
+    {
+#if EZ_ENABLED(EZ_UTF8_SIMD)
+      if (CanLoadBlock(pString1, pString1End) && CanLoadBlock(pString2, pString2End))
+      {
+        const __m128i block1 = LoadBlock(pString1);
+        const __m128i block2 = LoadBlock(pString2);
+        const ezUInt32 uiNonAscii = static_cast<ezUInt32>(_mm_movemask_epi8(_mm_or_si128(block1, block2)));
+
+        return CountEqual(ToUpperAscii(block1), ToUpperAscii(block2), uiNonAscii);
+      }
+#endif
+
+      return 0;
+    }
+
+    /// \brief Counts the characters in all blocks up to the terminator or pEnd and moves szUtf8 behind them.
+    ///
+    /// Stops either at the terminator or in front of the last block, that cannot be loaded.
+    EZ_ALWAYS_INLINE static ezUInt32 SkipCharacters(const char*& szUtf8, const char* pEnd)
+    {
+      ezUInt32 uiCharacters = 0;
+
+#if EZ_ENABLED(EZ_UTF8_SIMD)
+      while (CanLoadBlock(szUtf8, pEnd))
+      {
+        const __m128i block = LoadBlock(szUtf8);
+
+        const ezUInt32 uiZero = static_cast<ezUInt32>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_setzero_si128())));
+        const ezUInt32 uiValidBytes = ezMath::FirstBitLow(uiZero | (1u << BlockSize));
+
+        // continuation bytes are 10xxxxxx, i.e. all signed bytes smaller than 11000000
+        const ezUInt32 uiContinuation = static_cast<ezUInt32>(_mm_movemask_epi8(_mm_cmplt_epi8(block, _mm_set1_epi8(static_cast<char>(0xC0)))));
+
+        uiCharacters += uiValidBytes - ezMath::CountBits(uiContinuation & ((1u << uiValidBytes) - 1));
+        szUtf8 += uiValidBytes;
+
+        if (uiZero != 0)
+          break;
+      }
+#endif
+
+      return uiCharacters;
+    }
+
+    /// \brief Returns a bitmask of all bytes in the next block that are equal to one of the given values, and writes the number of
+    /// bytes before the terminator to out_uiValidBytes. Returns false, if the block cannot be loaded.
+    EZ_ALWAYS_INLINE static bool FindBytes(const char* szUtf8, const char* pEnd, ezUInt8 uiValue0, ezUInt8 uiValue1, ezUInt8 uiValue2, ezUInt32& out_uiMatches, ezUInt32& out_uiValidBytes)
+    {
+#if EZ_ENABLED(EZ_UTF8_SIMD)
+      if (CanLoadBlock(szUtf8, pEnd))
+      {
+        const __m128i block = LoadBlock(szUtf8);
+        const __m128i matches = _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(static_cast<char>(uiValue0))),
+          _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(static_cast<char>(uiValue1))), _mm_cmpeq_epi8(block, _mm_set1_epi8(static_cast<char>(uiValue2)))));
+
+        out_uiValidBytes = ezMath::FirstBitLow(static_cast<ezUInt32>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_setzero_si128()))) | (1u << BlockSize));
+        out_uiMatches = static_cast<ezUInt32>(_mm_movemask_epi8(matches)) & ((1u << out_uiValidBytes) - 1);
+        return true;
+      }
+#endif
+
+      return false;
+    }
+
+    /// \brief Appends the ASCII characters at the start of the next 16 bytes to the array of UTF-16 or UTF-32 code units.
+    ///
+    /// Returns how many characters were appended, which is 16, unless the block contains non-ASCII characters or the terminator.
+    template <typename T, typename Container>
+    EZ_ALWAYS_INLINE static ezUInt32 AppendAsciiToUtf16Or32(const char* szUtf8, Container& inout_Data)
+    {
+      static_assert(sizeof(T) == 2 || sizeof(T) == 4, "Only UTF-16 and UTF-32 code units are supported");
+
+#if EZ_ENABLED(EZ_UTF8_SIMD)
+      if (CanLoadBlock(szUtf8, ezUnicodeUtils::GetMaxStringEnd<char>()))
+      {
+        const __m128i block = LoadBlock(szUtf8);
+        const ezUInt32 uiNumAscii = ezMath::FirstBitLow(MatchNonAsciiOrZero(block) | (1u << BlockSize));
+
+        if (uiNumAscii == 0)
+          return 0;
+
+        // all 16 bytes are converted, but only the ASCII characters are kept
+        const ezUInt32 uiCount = inout_Data.GetCount();
+        inout_Data.SetCountUninitialized(uiCount + BlockSize);
+        __m128i* pDst = reinterpret_cast<__m128i*>(inout_Data.GetData() + uiCount);
+
+        const __m128i lo = _mm_unpacklo_epi8(block, _mm_setzero_si128());
+        const __m128i hi = _mm_unpackhi_epi8(block, _mm_setzero_si128());
+
+        if (sizeof(T) == 2)
+        {
+          _mm_storeu_si128(pDst + 0, lo);
+          _mm_storeu_si128(pDst + 1, hi);
+        }
+        else
+        {
+          _mm_storeu_si128(pDst + 0, _mm_unpacklo_epi16(lo, _mm_setzero_si128()));
+          _mm_storeu_si128(pDst + 1, _mm_unpackhi_epi16(lo, _mm_setzero_si128()));
+          _mm_storeu_si128(pDst + 2, _mm_unpacklo_epi16(hi, _mm_setzero_si128()));
+          _mm_storeu_si128(pDst + 3, _mm_unpackhi_epi16(hi, _mm_setzero_si128()));
+        }
+
+        inout_Data.SetCountUninitialized(uiCount + uiNumAscii);
+        return uiNumAscii;
+      }
+#endif
+
+      return 0;
+    }
+
+    /// \brief Appends the ASCII characters at the start of the next 16 bytes of UTF-16 or UTF-32 code units to the UTF-8 array.
+    ///
+    /// Returns how many code units were appended, which is 8 or 4, unless the block contains other characters or the terminator.
+    template <typename T, typename Container>
+    EZ_ALWAYS_INLINE static ezUInt32 AppendAsciiToUtf8(const T* pString, Container& inout_Utf8)
+    {
+      static_assert(sizeof(T) == 2 || sizeof(T) == 4, "Only UTF-16 and UTF-32 code units are supported");
+
+#if EZ_ENABLED(EZ_UTF8_SIMD)
+      if (CanLoadBlock(pString, ezUnicodeUtils::GetMaxStringEnd<T>()))
+      {
+        const __m128i block = LoadBlock(pString);
+
+        __m128i isAscii, utf8;
+        if (sizeof(T) == 2)
+        {
+          isAscii = _mm_andnot_si128(_mm_cmpeq_epi16(block, _mm_setzero_si128()),
+            _mm_cmpeq_epi16(_mm_and_si128(block, _mm_set1_epi16(static_cast<short>(0xFF80))), _mm_setzero_si128()));
+          utf8 = _mm_packus_epi16(block, block);
+        }
+        else
+        {
+          isAscii = _mm_andnot_si128(_mm_cmpeq_epi32(block, _mm_setzero_si128()),
+            _mm_cmpeq_epi32(_mm_and_si128(block, _mm_set1_epi32(static_cast<int>(0xFFFFFF80))), _mm_setzero_si128()));
+          const __m128i utf16 = _mm_packs_epi32(block, block);
+          utf8 = _mm_packus_epi16(utf16, utf16);
+        }
+
+        const ezUInt32 uiNotAscii = ~static_cast<ezUInt32>(_mm_movemask_epi8(isAscii));
+        const ezUInt32 uiNumAscii = ezMath::FirstBitLow(uiNotAscii) / sizeof(T);
+
+        if (uiNumAscii == 0)
+          return 0;
+
+        const ezUInt32 uiCount = inout_Utf8.GetCount();
+        inout_Utf8.SetCountUninitialized(uiCount + uiNumAscii);
+        ezMemoryUtils::RawByteCopy(inout_Utf8.GetData() + uiCount, &utf8, uiNumAscii);
+
+        return uiNumAscii;
+      }
+#endif
+
+      return 0;
+    }
+  };
+} // namespace ezInternal
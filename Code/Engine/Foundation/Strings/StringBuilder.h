@@ -24,6 +24,7 @@ class ezFormatString;
 /// It is not meant to store strings for a longer duration.
 /// Each ezStringBuilder uses an ezHybridArray to allocate a large buffer on the stack, such that string manipulations
 /// are possible without memory allocations, unless the string is too large.
+/// Temporary builders that often exceed that size, e.g. for absolute paths, can use an ezArenaAllocator on the stack instead.
 /// No sharing of data happens between ezStringBuilder instances, as it is expected that they will be modified anyway.
 /// Instead all data is always copied, therefore instances should not be passed by copy.
 /// All string data is stored Utf8 encoded, just as all other string classes, too.
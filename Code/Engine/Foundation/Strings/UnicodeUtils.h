@@ -44,7 +44,9 @@ public:
   static void MoveToPriorUtf8(const char*& szUtf8, ezUInt32 uiNumCharacters = 1); // [tested]
 
   /// \brief Returns false if the given string does not contain a completely valid Utf8 string.
-  static bool IsValidUtf8(const char* szString, const char* szStringEnd = GetMaxStringEnd<char>());
+  ///
+  /// Overlong encodings, surrogates and code points above 0x10FFFF are invalid. With SSE, the string is validated 16 bytes at a time.
+  static bool IsValidUtf8(const char* szString, const char* szStringEnd = GetMaxStringEnd<char>()); // [tested]
 
   /// \brief If the given string starts with a Utf8 Bom, the pointer is incremented behind the Bom, and the function returns true.
   ///
@@ -104,3 +104,18 @@ float ezSystemInformation::GetCPUUtilization() const
   EZ_ASSERT_NOT_IMPLEMENTED;
   return 0.0f;
 }
+
+void ezSystemInformation::GetCPUTopology(ezDynamicArray<ezCPULogicalProcessor>& out_Processors)
+{
+  // the core layout is not queried on OSX, every logical processor is reported as a separate core
+  ezDynamicArray<ezCPUTopologyEntry> entries;
+
+  for (ezUInt32 i = 0; i < Get().GetCPUCoreCount(); ++i)
+  {
+    ezCPUTopologyEntry& entry = entries.ExpandAndGetRef();
+    entry.m_uiProcessorIndex = i;
+    entry.m_uiCoreKey = i;
+  }
+
+  BuildCPUTopology(entries, out_Processors);
+}
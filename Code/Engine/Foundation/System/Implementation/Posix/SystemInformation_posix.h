@@ -1,8 +1,52 @@
 #include <Foundation/FoundationInternal.h>
 EZ_FOUNDATION_INTERNAL_HEADER
 
+#include <Foundation/Strings/StringUtils.h>
+
+#include <dirent.h>
+#include <sched.h>
 #include <unistd.h>
 
+namespace
+{
+  bool ReadCPUTopologyValue(ezUInt32 uiProcessor, const char* szFile, ezUInt32& out_uiValue)
+  {
+    char szPath[128];
+    ezStringUtils::snprintf(szPath, EZ_ARRAY_SIZE(szPath), "/sys/devices/system/cpu/cpu%u/topology/%s", uiProcessor, szFile);
+
+    FILE* pFile = fopen(szPath, "r");
+    if (pFile == nullptr)
+      return false;
+
+    const bool bRead = fscanf(pFile, "%u", &out_uiValue) == 1;
+    fclose(pFile);
+    return bRead;
+  }
+
+  ezUInt32 ReadCPUNumaNode(ezUInt32 uiProcessor)
+  {
+    char szPath[128];
+    ezStringUtils::snprintf(szPath, EZ_ARRAY_SIZE(szPath), "/sys/devices/system/cpu/cpu%u", uiProcessor);
+
+    DIR* pDir = opendir(szPath);
+    if (pDir == nullptr)
+      return 0;
+
+    // on NUMA systems the directory of each processor contains a link 'nodeN' to its node
+    ezUInt32 uiNode = 0;
+    while (dirent* pEntry = readdir(pDir))
+    {
+      if (sscanf(pEntry->d_name, "node%u", &uiNode) == 1)
+        break;
+
+      uiNode = 0;
+    }
+
+    closedir(pDir);
+    return uiNode;
+  }
+} // namespace
+
 bool ezSystemInformation::IsDebuggerAttached()
 {
   // TODO: No simple way to test without massive overhead.
@@ -67,3 +111,42 @@ float ezSystemInformation::GetCPUUtilization() const
   EZ_ASSERT_NOT_IMPLEMENTED;
   return 0.0f;
 }
+
+void ezSystemInformation::GetCPUTopology(ezDynamicArray<ezCPULogicalProcessor>& out_Processors)
+{
+  out_Processors.Clear();
+
+  // only report the processors that this process is allowed to run on (e.g. inside containers or with 'taskset')
+  cpu_set_t allowedProcessors;
+  CPU_ZERO(&allowedProcessors);
+  const bool bHasAffinity = sched_getaffinity(0, sizeof(allowedProcessors), &allowedProcessors) == 0;
+
+  const ezUInt32 uiNumProcessors = static_cast<ezUInt32>(sysconf(_SC_NPROCESSORS_CONF));
+
+  ezDynamicArray<ezCPUTopologyEntry> entries;
+  entries.Reserve(uiNumProcessors);
+
+  for (ezUInt32 uiProcessor = 0; uiProcessor < uiNumProcessors && uiProcessor < CPU_SETSIZE; ++uiProcessor)
+  {
+    if (bHasAffinity && !CPU_ISSET(uiProcessor, &allowedProcessors))
+      continue;
+
+    ezUInt32 uiPackage = 0;
+    ezUInt32 uiCore = uiProcessor;
+
+    // without sysfs every processor is treated as a separate core
+    if (!ReadCPUTopologyValue(uiProcessor, "core_id", uiCore))
+    {
+      uiCore = uiProcessor;
+    }
+
+    ReadCPUTopologyValue(uiProcessor, "physical_package_id", uiPackage);
+
+    ezCPUTopologyEntry& entry = entries.ExpandAndGetRef();
+    entry.m_uiProcessorIndex = uiProcessor;
+    entry.m_uiNumaNode = ReadCPUNumaNode(uiProcessor);
+    entry.m_uiCoreKey = (static_cast<ezUInt64>(uiPackage) << 32) | uiCore;
+  }
+
+  BuildCPUTopology(entries, out_Processors);
+}
@@ -2,9 +2,142 @@
 
 #include <Foundation/System/SystemInformation.h>
 
+#if EZ_ENABLED(EZ_PLATFORM_ARCH_X86)
+#  if EZ_ENABLED(EZ_COMPILER_MSVC)
+#    include <intrin.h>
+#  else
+#    include <cpuid.h>
+#  endif
+#endif
+
 // Storage for the current configuration
 ezSystemInformation ezSystemInformation::s_SystemInformation;
 
+namespace
+{
+  /// The platform specific topology queries fill out this structure for every logical processor.
+  struct ezCPUTopologyEntry
+  {
+    ezUInt32 m_uiProcessorIndex = 0;
+    ezUInt32 m_uiNumaNode = 0;
+    ezUInt64 m_uiCoreKey = 0; ///< Any value that is identical for all SMT siblings of one physical core and unique otherwise.
+  };
+
+  /// Sorts the processors, numbers the physical cores consecutively and determines the SMT index of every processor.
+  void BuildCPUTopology(ezDynamicArray<ezCPUTopologyEntry>& entries, ezDynamicArray<ezCPULogicalProcessor>& out_Processors)
+  {
+    entries.Sort([](const ezCPUTopologyEntry& a, const ezCPUTopologyEntry& b) {
+      if (a.m_uiNumaNode != b.m_uiNumaNode)
+        return a.m_uiNumaNode < b.m_uiNumaNode;
+      if (a.m_uiCoreKey != b.m_uiCoreKey)
+        return a.m_uiCoreKey < b.m_uiCoreKey;
+      return a.m_uiProcessorIndex < b.m_uiProcessorIndex;
+    });
+
+    out_Processors.SetCount(entries.GetCount());
+
+    for (ezUInt32 i = 0; i < entries.GetCount(); ++i)
+    {
+      ezCPULogicalProcessor& proc = out_Processors[i];
+      proc.m_uiProcessorIndex = entries[i].m_uiProcessorIndex;
+      proc.m_uiNumaNode = entries[i].m_uiNumaNode;
+
+      if (i > 0 && entries[i].m_uiNumaNode == entries[i - 1].m_uiNumaNode && entries[i].m_uiCoreKey == entries[i - 1].m_uiCoreKey)
+      {
+        proc.m_uiPhysicalCore = out_Processors[i - 1].m_uiPhysicalCore;
+        proc.m_uiSMTIndex = out_Processors[i - 1].m_uiSMTIndex + 1;
+      }
+      else
+      {
+        proc.m_uiPhysicalCore = (i > 0) ? out_Processors[i - 1].m_uiPhysicalCore + 1 : 0;
+        proc.m_uiSMTIndex = 0;
+      }
+    }
+  }
+
+#if EZ_ENABLED(EZ_PLATFORM_ARCH_X86)
+  void ezCpuId(ezUInt32 uiLeaf, ezUInt32 uiSubLeaf, ezUInt32 out_Registers[4])
+  {
+#  if EZ_ENABLED(EZ_COMPILER_MSVC)
+    int registers[4];
+    __cpuidex(registers, static_cast<int>(uiLeaf), static_cast<int>(uiSubLeaf));
+    ezMemoryUtils::Copy(out_Registers, reinterpret_cast<ezUInt32*>(registers), 4);
+#  else
+    __cpuid_count(uiLeaf, uiSubLeaf, out_Registers[0], out_Registers[1], out_Registers[2], out_Registers[3]);
+#  endif
+  }
+
+  ezUInt64 ezReadExtendedControlRegister()
+  {
+#  if EZ_ENABLED(EZ_COMPILER_MSVC)
+    return _xgetbv(0);
+#  else
+    ezUInt32 uiLow, uiHigh;
+    __asm__ volatile("xgetbv" : "=a"(uiLow), "=d"(uiHigh) : "c"(0));
+    return (static_cast<ezUInt64>(uiHigh) << 32) | uiLow;
+#  endif
+  }
+
+  ezBitflags<ezCPUFeatures> DetectCPUFeatures()
+  {
+    ezBitflags<ezCPUFeatures> features;
+
+    ezUInt32 regs[4];
+    ezCpuId(0, 0, regs);
+    const ezUInt32 uiMaxLeaf = regs[0];
+
+    if (uiMaxLeaf < 1)
+      return features;
+
+    ezCpuId(1, 0, regs);
+    const ezUInt32 uiFeaturesEcx = regs[2];
+
+    features.AddOrRemove(ezCPUFeatures::SSE41, (uiFeaturesEcx & EZ_BIT(19)) != 0);
+    features.AddOrRemove(ezCPUFeatures::SSE42, (uiFeaturesEcx & EZ_BIT(20)) != 0);
+
+    // the AVX registers are only usable if the OS saves them on context switches (OSXSAVE + XCR0 bits for SSE and AVX state)
+    const bool bOSSavesAVX = (uiFeaturesEcx & EZ_BIT(27)) != 0 && (ezReadExtendedControlRegister() & 0x6) == 0x6;
+    if (!bOSSavesAVX || (uiFeaturesEcx & EZ_BIT(28)) == 0)
+      return features;
+
+    features.Add(ezCPUFeatures::AVX);
+    features.AddOrRemove(ezCPUFeatures::FMA, (uiFeaturesEcx & EZ_BIT(12)) != 0);
+
+    if (uiMaxLeaf < 7)
+      return features;
+
+    ezCpuId(7, 0, regs);
+    const ezUInt32 uiExtendedFeaturesEbx = regs[1];
+
+    features.AddOrRemove(ezCPUFeatures::AVX2, (uiExtendedFeaturesEbx & EZ_BIT(5)) != 0);
+
+    // AVX-512 additionally requires the OS to save the opmask and upper ZMM registers
+    const bool bOSSavesAVX512 = (ezReadExtendedControlRegister() & 0xE6) == 0xE6;
+    features.AddOrRemove(ezCPUFeatures::AVX512F, bOSSavesAVX512 && (uiExtendedFeaturesEbx & EZ_BIT(16)) != 0);
+
+    return features;
+  }
+#else
+  ezBitflags<ezCPUFeatures> DetectCPUFeatures()
+  {
+    ezBitflags<ezCPUFeatures> features;
+
+#  if EZ_ENABLED(EZ_PLATFORM_ARCH_ARM) && (defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64))
+    features.Add(ezCPUFeatures::NEON);
+#  endif
+
+    return features;
+  }
+#endif
+} // namespace
+
+// static
+ezBitflags<ezCPUFeatures> ezSystemInformation::GetCPUFeatures()
+{
+  static ezBitflags<ezCPUFeatures> s_Features = DetectCPUFeatures();
+  return s_Features;
+}
+
 // Include inline file
 #if EZ_ENABLED(EZ_PLATFORM_WINDOWS)
 #  include <Foundation/System/Implementation/Win/SystemInformation_win.h>
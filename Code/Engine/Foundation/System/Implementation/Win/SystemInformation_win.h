@@ -147,3 +147,69 @@ float ezSystemInformation::GetCPUUtilization() const
   return 0.0f;
 #endif
 }
+
+void ezSystemInformation::GetCPUTopology(ezDynamicArray<ezCPULogicalProcessor>& out_Processors)
+{
+  out_Processors.Clear();
+
+  ezDynamicArray<ezCPUTopologyEntry> entries;
+
+  DWORD uiBufferSize = 0;
+  GetLogicalProcessorInformation(nullptr, &uiBufferSize);
+
+  ezDynamicArray<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> infos;
+  infos.SetCount(uiBufferSize / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+
+  if (!infos.IsEmpty() && GetLogicalProcessorInformation(infos.GetData(), &uiBufferSize))
+  {
+    // this only reports the processors of the current processor group (up to 64)
+    constexpr ezUInt32 uiMaskBits = sizeof(ULONG_PTR) * 8;
+
+    ezUInt32 numaNodes[uiMaskBits] = {};
+
+    for (const SYSTEM_LOGICAL_PROCESSOR_INFORMATION& info : infos)
+    {
+      if (info.Relationship != RelationNumaNode)
+        continue;
+
+      for (ezUInt32 i = 0; i < uiMaskBits; ++i)
+      {
+        if ((info.ProcessorMask & (static_cast<ULONG_PTR>(1) << i)) != 0)
+          numaNodes[i] = info.NumaNode.NodeNumber;
+      }
+    }
+
+    ezUInt32 uiCore = 0;
+
+    for (const SYSTEM_LOGICAL_PROCESSOR_INFORMATION& info : infos)
+    {
+      if (info.Relationship != RelationProcessorCore)
+        continue;
+
+      for (ezUInt32 i = 0; i < uiMaskBits; ++i)
+      {
+        if ((info.ProcessorMask & (static_cast<ULONG_PTR>(1) << i)) != 0)
+        {
+          ezCPUTopologyEntry& entry = entries.ExpandAndGetRef();
+          entry.m_uiProcessorIndex = i;
+          entry.m_uiNumaNode = numaNodes[i];
+          entry.m_uiCoreKey = uiCore;
+        }
+      }
+
+      ++uiCore;
+    }
+  }
+
+  if (entries.IsEmpty())
+  {
+    for (ezUInt32 i = 0; i < Get().GetCPUCoreCount(); ++i)
+    {
+      ezCPUTopologyEntry& entry = entries.ExpandAndGetRef();
+      entry.m_uiProcessorIndex = i;
+      entry.m_uiCoreKey = i;
+    }
+  }
+
+  BuildCPUTopology(entries, out_Processors);
+}
@@ -1,5 +1,52 @@
 #pragma once
 
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Types/Bitflags.h>
+
+/// \brief Describes where one logical processor (hardware thread) is located in the CPU topology. See ezSystemInformation::GetCPUTopology().
+struct ezCPULogicalProcessor
+{
+  EZ_DECLARE_POD_TYPE();
+
+  ezUInt32 m_uiProcessorIndex = 0; ///< The index that the OS uses for this logical processor, e.g. for thread affinities.
+  ezUInt32 m_uiPhysicalCore = 0;   ///< Logical processors with the same value are SMT siblings (hyper-threads) on the same physical core.
+  ezUInt32 m_uiSMTIndex = 0;       ///< 0 for the first logical processor of a physical core, 1 and up for its SMT siblings.
+  ezUInt32 m_uiNumaNode = 0;       ///< The NUMA node that the processor belongs to. Always 0 on systems without NUMA.
+};
+
+/// \brief Instruction set extensions that the CPU and the OS support. See ezSystemInformation::GetCPUFeatures().
+struct ezCPUFeatures
+{
+  typedef ezUInt32 StorageType;
+
+  enum Enum
+  {
+    None = 0,
+    SSE41 = EZ_BIT(0),
+    SSE42 = EZ_BIT(1),
+    AVX = EZ_BIT(2),
+    AVX2 = EZ_BIT(3),
+    FMA = EZ_BIT(4),
+    AVX512F = EZ_BIT(5),
+    NEON = EZ_BIT(6),
+
+    Default = None
+  };
+
+  struct Bits
+  {
+    StorageType SSE41 : 1;
+    StorageType SSE42 : 1;
+    StorageType AVX : 1;
+    StorageType AVX2 : 1;
+    StorageType FMA : 1;
+    StorageType AVX512F : 1;
+    StorageType NEON : 1;
+  };
+};
+
+EZ_DECLARE_FLAGS_OPERATORS(ezCPUFeatures);
+
 /// \brief The system configuration class encapsulates information about the system the application is running on.
 ///
 /// Retrieve the system configuration by using ezSystemInformation::Get(). If you use the system configuration in startup code
@@ -35,6 +82,18 @@ public:
   /// \brief Returns whether a debugger is currently attached to this process.
   static bool IsDebuggerAttached();
 
+  /// \brief Returns all logical processors that this process may run on, sorted by NUMA node, physical core and SMT index.
+  ///
+  /// Physical cores are numbered consecutively, starting at zero. On platforms where the topology cannot be determined,
+  /// every logical processor is reported as a separate physical core on NUMA node 0.
+  static void GetCPUTopology(ezDynamicArray<ezCPULogicalProcessor>& out_Processors);
+
+  /// \brief Returns the instruction set extensions that can be used on this machine.
+  ///
+  /// The AVX based features are only reported when the OS saves the extended registers on context switches.
+  /// Code that was compiled for a lower instruction set can use this to select faster code paths at runtime.
+  static ezBitflags<ezCPUFeatures> GetCPUFeatures();
+
   /// \brief Allows access to the current system configuration.
   static const ezSystemInformation& Get()
   {
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <Foundation/Threading/TaskSystem.h>
+
+/// \brief Base class for tasks that are spawned through an ezForkJoinScope.
+///
+/// In contrast to regular tasks, fork-join tasks are not reference counted and do not belong to any task group.
+/// They are meant to be allocated on the stack (or inside other data that outlives them), so that spawning them
+/// does not need any heap allocation. The task system only stores a pointer to them, therefore a fork-join task
+/// must not be destroyed before ezForkJoinScope::Sync() has returned.
+///
+/// Usually you would use ezForkJoinTask instead of deriving from this class directly.
+class EZ_FOUNDATION_DLL ezForkJoinTaskBase : public ezTask
+{
+public:
+  /// \brief Fork-join tasks may spawn and sync other fork-join tasks, therefore the nesting mode is always ezTaskNesting::Maybe.
+  ezForkJoinTaskBase(const char* szTaskName = "ForkJoinTask");
+  ~ezForkJoinTaskBase();
+
+private:
+  friend class ezTaskSystem;
+  friend class ezForkJoinScope;
+
+  ezForkJoinScope* m_pScope = nullptr;
+};
+
+/// \brief A fork-join task that executes a function object, typically a lambda.
+///
+/// The function object is stored by value inside the task, so together with the task it lives wherever the task is declared:
+/// \code{.cpp}
+///   ezForkJoinScope scope;
+///   ezForkJoinTask left([&]() { Sort(first, middle); });
+///   scope.Spawn(left);
+///   Sort(middle, last); // do the other half on this thread
+///   scope.Sync();
+/// \endcode
+template <typename Function>
+class ezForkJoinTask final : public ezForkJoinTaskBase
+{
+public:
+  ezForkJoinTask(Function func, const char* szTaskName = "ForkJoinTask")
+    : ezForkJoinTaskBase(szTaskName)
+    , m_Func(std::move(func))
+  {
+  }
+
+private:
+  virtual void Execute() override { m_Func(); }
+
+  Function m_Func;
+};
+
+/// \brief Spawns fork-join tasks and waits for all of them to finish.
+///
+/// This is a light-weight alternative to task groups, for recursive algorithms (sorting, building hierarchies, traversing trees)
+/// that want to create very many, very small tasks.
+/// Spawning a task does not allocate any memory. When called on a worker thread, the task is pushed into that thread's
+/// own work-stealing deque and idle threads steal it from there. Sync() executes other tasks (preferably the ones that were just
+/// spawned from the same thread) until all spawned tasks are finished. When there is nothing left that it could execute, but a stolen
+/// task is still running on another thread, Sync() does not sleep. It keeps polling and yields the rest of its time slice in between
+/// (see ezTaskSystem::WaitForCondition()), so a thread that waits for a long-running stolen task keeps its core busy.
+///
+/// A scope may be reused after Sync() returned. It is not allowed to spawn tasks into the same scope from several threads concurrently,
+/// but tasks may create their own scopes to spawn further tasks.
+class EZ_FOUNDATION_DLL ezForkJoinScope
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezForkJoinScope);
+
+public:
+  /// \brief The priority determines which threads work on the spawned tasks. Main thread priorities are not supported.
+  ezForkJoinScope(ezTaskPriority::Enum priority = ezTaskPriority::ThisFrame);
+
+  /// \brief Asserts that all spawned tasks have been waited for.
+  ~ezForkJoinScope();
+
+  /// \brief Queues the task for execution. The task must stay alive until Sync() has returned.
+  void Spawn(ezForkJoinTaskBase& task); // [tested]
+
+  /// \brief Returns once all tasks that were spawned through this scope are finished. Helps executing tasks in the mean time,
+  /// and polls with ezThreadUtils::YieldTimeSlice() when there is nothing to help with.
+  void Sync(); // [tested]
+
+  /// \brief Returns the priority with which the tasks are queued.
+  ezTaskPriority::Enum GetPriority() const { return m_Priority; }
+
+private:
+  friend class ezTaskSystem;
+
+  ezAtomicInteger32 m_iPendingTasks;
+  ezTaskPriority::Enum m_Priority;
+};
@@ -2,31 +2,63 @@
 
 #include <Foundation/Threading/TaskSystem.h>
 
+namespace
+{
+  // Adaptive mode: how long a single task invocation should take at least, to amortize the cost of scheduling it.
+  static constexpr double s_fAdaptiveInvocationTimeNS = 50000.0;
+
+  // Adaptive mode: how long to process items on the calling thread, to measure their cost, when it is not known yet.
+  static constexpr double s_fAdaptiveProbeTimeNS = 20000.0;
+
+  // Adaptive mode: the maximum number of invocations per worker thread, more invocations balance items with varying cost better.
+  static constexpr ezUInt32 s_uiAdaptiveMaxInvocationsPerThread = 16;
+} // namespace
+
 /// \brief This is a helper class that splits up task items via index ranges.
 class IndexedTask final : public ezTask
 {
 public:
-  IndexedTask(ezUInt32 uiStartIndex, ezUInt32 uiNumItems, ezParallelForIndexedFunction taskCallback, ezUInt32 uiItemsPerInvocation)
+  IndexedTask(ezUInt32 uiStartIndex, ezUInt32 uiNumItems, ezParallelForIndexedFunction taskCallback, ezUInt32 uiItemsPerInvocation,
+    ezParallelForCostCache* pCostCache = nullptr)
     : m_uiStartIndex(uiStartIndex)
     , m_uiNumItems(uiNumItems)
     , m_uiItemsPerInvocation(uiItemsPerInvocation)
     , m_TaskCallback(std::move(taskCallback))
+    , m_pCostCache(pCostCache)
   {
   }
 
   void Execute() override
   {
+    const ezTime tStart = m_pCostCache ? ezTime::Now() : ezTime();
+
     // Work through all of them.
     m_TaskCallback(m_uiStartIndex, m_uiStartIndex + m_uiNumItems);
+
+    if (m_pCostCache)
+    {
+      m_pCostCache->AddMeasurement(ezTime::Now() - tStart, m_uiNumItems);
+    }
   }
 
   void ExecuteWithMultiplicity(ezUInt32 uiInvocation) const override
   {
-    const ezUInt32 uiSliceStartIndex = uiInvocation * m_uiItemsPerInvocation;
+    const ezUInt32 uiSliceStartIndex = m_uiStartIndex + uiInvocation * m_uiItemsPerInvocation;
     const ezUInt32 uiSliceEndIndex = ezMath::Min(uiSliceStartIndex + m_uiItemsPerInvocation, m_uiStartIndex + m_uiNumItems);
 
+    if (uiSliceStartIndex >= uiSliceEndIndex)
+      return;
+
+    const ezTime tStart = m_pCostCache ? ezTime::Now() : ezTime();
+
     // Run through the calculated slice, the end index is exclusive, i.e., should not be handled by this instance.
     m_TaskCallback(uiSliceStartIndex, uiSliceEndIndex);
+
+    // in adaptive mode every invocation refines the measured cost, so that following loops adapt to changes in the workload
+    if (m_pCostCache)
+    {
+      m_pCostCache->AddMeasurement(ezTime::Now() - tStart, uiSliceEndIndex - uiSliceStartIndex);
+    }
   }
 
 private:
@@ -34,8 +66,39 @@ private:
   ezUInt32 m_uiNumItems;
   ezUInt32 m_uiItemsPerInvocation;
   ezParallelForIndexedFunction m_TaskCallback;
+  ezParallelForCostCache* m_pCostCache;
 };
 
+ezTime ezParallelForCostCache::GetItemCost() const
+{
+  return ezTime::Nanoseconds(m_iPicosecondsPerItem * 0.001);
+}
+
+void ezParallelForCostCache::AddMeasurement(ezTime duration, ezUInt32 uiNumItems)
+{
+  if (uiNumItems == 0)
+    return;
+
+  // at least one picosecond, zero means 'not measured'
+  const ezInt64 iMeasured = ezMath::Max<ezInt64>(1, static_cast<ezInt64>(duration.GetNanoseconds() * 1000.0 / uiNumItems));
+
+  while (true)
+  {
+    const ezInt64 iPrevious = m_iPicosecondsPerItem;
+
+    // moving average, single outliers (e.g. a thread being preempted) should not change the partitioning much
+    const ezInt64 iNew = (iPrevious == 0) ? iMeasured : iPrevious + (iMeasured - iPrevious) / 4;
+
+    if (m_iPicosecondsPerItem.TestAndSet(iPrevious, ezMath::Max<ezInt64>(1, iNew)))
+      return;
+  }
+}
+
+void ezParallelForCostCache::Reset()
+{
+  m_iPicosecondsPerItem = 0;
+}
+
 ezUInt32 ezParallelForParams::DetermineMultiplicity(ezUInt32 uiNumTaskItems) const
 {
   // If we have not exceeded the threading threshold we will indicate to use serial execution.
@@ -82,9 +145,35 @@ ezUInt32 ezParallelForParams::DetermineItemsPerInvocation(ezUInt32 uiNumTaskItem
   return uiItemsPerInvocation;
 }
 
+ezUInt32 ezParallelForParams::DetermineAdaptiveMultiplicity(ezUInt32 uiNumTaskItems, ezTime itemCost) const
+{
+  const double fItemCostNS = ezMath::Max(itemCost.GetNanoseconds(), 0.001);
+  const double fTotalCostNS = fItemCostNS * uiNumTaskItems;
+
+  // Not even enough work for two invocations, scheduling tasks would take longer than doing it right away.
+  if (fTotalCostNS < 2.0 * s_fAdaptiveInvocationTimeNS)
+  {
+    return 0;
+  }
+
+  const ezUInt32 uiNumWorkers = ezMath::Max(1u, ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks));
+
+  // As many invocations as possible, as long as each of them is still worth scheduling.
+  const double fMaxInvocations = fTotalCostNS / s_fAdaptiveInvocationTimeNS;
+  const ezUInt32 uiMultiplicity = static_cast<ezUInt32>(ezMath::Min<double>(fMaxInvocations, uiNumWorkers * s_uiAdaptiveMaxInvocationsPerThread));
+
+  return ezMath::Min(uiMultiplicity, uiNumTaskItems);
+}
+
 void ezTaskSystem::ParallelForIndexed(
   ezUInt32 uiStartIndex, ezUInt32 uiNumItems, ezParallelForIndexedFunction taskCallback, const char* taskName, const ezParallelForParams& params)
 {
+  if (params.bAdaptive)
+  {
+    ParallelForIndexedAdaptive(uiStartIndex, uiNumItems, std::move(taskCallback), taskName, params);
+    return;
+  }
+
   const ezUInt32 uiMultiplicity = params.DetermineMultiplicity(uiNumItems);
   const ezUInt32 uiItemsPerInvocation = params.DetermineItemsPerInvocation(uiNumItems, uiMultiplicity);
 
@@ -110,5 +199,65 @@ void ezTaskSystem::ParallelForIndexed(
   }
 }
 
+void ezTaskSystem::ParallelForIndexedAdaptive(
+  ezUInt32 uiStartIndex, ezUInt32 uiNumItems, ezParallelForIndexedFunction taskCallback, const char* taskName, const ezParallelForParams& params)
+{
+  ezParallelForCostCache localCostCache;
+  ezParallelForCostCache* pCostCache = (params.pCostCache != nullptr) ? params.pCostCache : &localCostCache;
+
+  const char* szTaskName = taskName ? taskName : "Generic Indexed Task";
+  const ezUInt32 uiEndIndex = uiStartIndex + uiNumItems;
+
+  if (pCostCache->GetItemCost().IsZero() && uiNumItems > 0)
+  {
+    EZ_PROFILE_SCOPE(szTaskName);
+
+    // Process batches of growing size on this thread, until the measurement is precise enough.
+    // If the items are cheap, this may already do all the work.
+    const ezTime tStart = ezTime::Now();
+    ezTime tElapsed;
+    ezUInt32 uiBatchSize = 1;
+
+    while (uiStartIndex < uiEndIndex && tElapsed.GetNanoseconds() < s_fAdaptiveProbeTimeNS)
+    {
+      const ezUInt32 uiBatchEnd = uiStartIndex + ezMath::Min(uiBatchSize, uiEndIndex - uiStartIndex);
+      taskCallback(uiStartIndex, uiBatchEnd);
+
+      uiStartIndex = uiBatchEnd;
+      uiBatchSize *= 2;
+      tElapsed = ezTime::Now() - tStart;
+    }
+
+    pCostCache->AddMeasurement(tElapsed, uiNumItems - (uiEndIndex - uiStartIndex));
+    uiNumItems = uiEndIndex - uiStartIndex;
+
+    if (uiNumItems == 0)
+      return;
+  }
+
+  const ezUInt32 uiMultiplicity = params.DetermineAdaptiveMultiplicity(uiNumItems, pCostCache->GetItemCost());
+  const ezUInt32 uiItemsPerInvocation = params.DetermineItemsPerInvocation(uiNumItems, uiMultiplicity);
+
+  if (uiMultiplicity == 0)
+  {
+    IndexedTask indexedTask(uiStartIndex, uiNumItems, std::move(taskCallback), uiItemsPerInvocation, pCostCache);
+    indexedTask.ConfigureTask(szTaskName, params.nestingMode);
+
+    EZ_PROFILE_SCOPE(indexedTask.m_sTaskName);
+    indexedTask.Execute();
+  }
+  else
+  {
+    ezAllocatorBase* pAllocator = (params.pTaskAllocator != nullptr) ? params.pTaskAllocator : ezFoundation::GetDefaultAllocator();
+
+    ezSharedPtr<IndexedTask> pIndexedTask =
+      EZ_NEW(pAllocator, IndexedTask, uiStartIndex, uiNumItems, std::move(taskCallback), uiItemsPerInvocation, pCostCache);
+    pIndexedTask->ConfigureTask(szTaskName, params.nestingMode);
+
+    pIndexedTask->SetMultiplicity(uiMultiplicity);
+    ezTaskGroupID taskGroupId = ezTaskSystem::StartSingleTask(pIndexedTask, ezTaskPriority::EarlyThisFrame);
+    ezTaskSystem::WaitForGroup(taskGroupId);
+  }
+}
 
 EZ_STATICLINK_FILE(Foundation, Foundation_Threading_Implementation_ParallelFor);
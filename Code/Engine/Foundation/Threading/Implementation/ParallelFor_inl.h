@@ -45,6 +45,18 @@ template <typename ElemType>
 void ezTaskSystem::ParallelForInternal(
   ezArrayPtr<ElemType> taskItems, ezParallelForFunction<ElemType> taskCallback, const char* taskName, const ezParallelForParams& config)
 {
+  if (config.bAdaptive)
+  {
+    // the adaptive partitioning works on index ranges, the callback is only referenced, since ParallelForIndexed blocks until all items are done
+    ParallelForIndexed(
+      0, taskItems.GetCount(),
+      [&taskCallback, taskItems](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+        taskCallback(uiStartIndex, taskItems.GetSubArray(uiStartIndex, uiEndIndex - uiStartIndex));
+      },
+      taskName ? taskName : "Generic ArrayPtr Task", config);
+    return;
+  }
+
   const ezUInt32 uiMultiplicity = config.DetermineMultiplicity(taskItems.GetCount());
   const ezUInt32 uiItemsPerInvocation = config.DetermineItemsPerInvocation(taskItems.GetCount(), uiMultiplicity);
 
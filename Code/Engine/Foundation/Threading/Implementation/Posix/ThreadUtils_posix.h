@@ -8,6 +8,7 @@
 // Posix implementation of thread helper functions
 
 #include <pthread.h>
+#include <sched.h>
 
 static pthread_t g_MainThread = (pthread_t)0;
 
@@ -48,3 +49,23 @@ bool ezThreadUtils::IsMainThread()
 {
   return pthread_self() == g_MainThread;
 }
+
+ezResult ezThreadUtils::SetCurrentThreadAffinity(ezArrayPtr<const ezUInt32> processors)
+{
+#if EZ_ENABLED(EZ_PLATFORM_LINUX) || EZ_ENABLED(EZ_PLATFORM_ANDROID)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+
+  for (ezUInt32 uiProcessor : processors)
+  {
+    if (uiProcessor < CPU_SETSIZE)
+      CPU_SET(uiProcessor, &set);
+  }
+
+  // with a pid of zero this only affects the calling thread
+  return sched_setaffinity(0, sizeof(set), &set) == 0 ? EZ_SUCCESS : EZ_FAILURE;
+#else
+  // OSX only supports affinity hints through the thread_policy API
+  return EZ_FAILURE;
+#endif
+}
@@ -31,12 +31,9 @@ void ezTask::SetMultiplicity(ezUInt32 uiMultiplicity)
 
 void ezTask::Run(ezUInt32 uiInvocation)
 {
-  // actually this should not be possible to happen
-  if (m_iRemainingRuns == 0 || m_bCancelExecution)
-  {
-    m_iRemainingRuns = 0;
+  // the task was canceled after this invocation had been handed out already
+  if (m_bCancelExecution)
     return;
-  }
 
   {
     ezStringBuilder scopeName = m_sTaskName;
@@ -55,8 +52,6 @@ void ezTask::Run(ezUInt32 uiInvocation)
       Execute();
     }
   }
-
-  m_iRemainingRuns.Decrement();
 }
 
 
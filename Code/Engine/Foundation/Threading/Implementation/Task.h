@@ -84,9 +84,23 @@ private:
   /// \brief Called by ezTaskSystem to execute the task. Calls 'Execute' internally.
   void Run(ezUInt32 uiInvocation);
 
-  /// \brief Decremented when a task is finished, set to zero when canceled.
+  /// \brief Decremented whenever an invocation of this task has been executed or canceled.
   ezAtomicInteger32 m_iRemainingRuns;
 
+  /// \brief The number of queued invocations that have not been handed out to any thread yet.
+  ///
+  /// Each thread that dequeues the task claims one invocation by decrementing this.
+  /// Canceling sets it to zero, which turns all the queue entries that are still pending into no-ops.
+  ezAtomicInteger32 m_iInvocationsToClaim;
+
+  /// \brief The number of entries of this task that are still in any of the task queues, including canceled ones.
+  ///
+  /// Entries in the worker threads' deques can't be removed, so the task must not be reset or destroyed before they are all gone.
+  ezAtomicInteger32 m_iQueuedEntries;
+
+  /// \brief Holds a reference to the task while m_iQueuedEntries is not zero, its group releases its reference when it finishes.
+  ezSharedPtr<ezTask> m_pKeepAliveWhileQueued;
+
   /// \brief Set to true when the task is SUPPOSED to cancel. Whether the task is able to do that, depends on its implementation.
   bool m_bCancelExecution = false;
 
@@ -107,5 +121,10 @@ private:
   /// \brief The parent group to which this task belongs.
   ezTaskGroupID m_BelongsToGroup;
 
+  /// \brief The index of this task in its group's task list, set when the task gets scheduled.
+  ///
+  /// The queues only store plain pointers, this allows to find the shared pointer for m_OnTaskFinished without searching for it.
+  ezUInt32 m_uiIndexInGroup = 0;
+
   ezString m_sTaskName;
 };
@@ -27,11 +27,47 @@ void ezTaskGroup::Reuse(ezTaskPriority::Enum priority, ezOnTaskGroupFinishedCall
   m_uiGroupCounter += 2; // even if it wraps around, it will never be zero, thus zero stays an invalid group counter
   m_Tasks.Clear();
   m_DependsOnGroups.Clear();
-  m_OthersDependingOnMe.Clear();
+  m_DependencyLinks.Clear();
+  m_iDependentsHead = static_cast<ezInt64>(static_cast<ezUInt64>(m_uiGroupCounter) << 32 | DependentsListEnd);
   m_Priority = priority;
   m_OnFinishedCallback = callback;
 }
 
+bool ezTaskGroup::RegisterAsDependentOf(ezUInt32 uiDependencySlot)
+{
+  EZ_ASSERT_DEV(uiDependencySlot < (1u << 15), "Too many dependencies on a single task group.");
+
+  const ezTaskGroupID& dependsOn = m_DependsOnGroups[uiDependencySlot];
+  ezTaskGroup* pDependency = dependsOn.m_pTaskGroup;
+
+  const ezUInt32 uiNode = MakeDependentsListNode(m_uiTaskGroupIndex, uiDependencySlot);
+
+  while (true)
+  {
+    const ezUInt64 uiHead = static_cast<ezUInt64>(static_cast<ezInt64>(pDependency->m_iDependentsHead));
+
+    // if the list belongs to another generation, the dependency has been finished and reused since the ID was created
+    // if it is closed, the dependency is finished and its dependents are being (or have been) notified already
+    if ((uiHead >> 32) != dependsOn.m_uiGroupCounter || static_cast<ezUInt32>(uiHead) == DependentsListClosed)
+      return false;
+
+    // the link has to be written before the node is published
+    m_DependencyLinks[uiDependencySlot] = static_cast<ezUInt32>(uiHead);
+
+    const ezUInt64 uiNewHead = (uiHead & 0xFFFFFFFF00000000ull) | uiNode;
+
+    if (pDependency->m_iDependentsHead.TestAndSet(static_cast<ezInt64>(uiHead), static_cast<ezInt64>(uiNewHead)))
+      return true;
+  }
+}
+
+ezUInt32 ezTaskGroup::CloseDependentsList(ezUInt32 uiGroupCounter)
+{
+  const ezUInt64 uiClosed = static_cast<ezUInt64>(uiGroupCounter) << 32 | DependentsListClosed;
+
+  return static_cast<ezUInt32>(static_cast<ezUInt64>(m_iDependentsHead.Set(static_cast<ezInt64>(uiClosed))));
+}
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
 void ezTaskGroup::DebugCheckTaskGroup(ezTaskGroupID groupID, ezMutex& mutex)
 {
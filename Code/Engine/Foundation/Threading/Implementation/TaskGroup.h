@@ -27,13 +27,42 @@ private:
   void WaitForFinish(ezTaskGroupID group) const;
   void Reuse(ezTaskPriority::Enum priority, ezOnTaskGroupFinishedCallback callback);
 
-  bool m_bInUse = true;
+  enum : ezUInt32
+  {
+    DependentsListEnd = 0,
+    DependentsListClosed = 0xFFFFFFFF,
+  };
+
+  /// \brief Tries to add this group to the list of groups that get notified once the given dependency has finished.
+  ///
+  /// Returns false, if the dependency has already finished (or is finishing right now), in which case nothing was added.
+  bool RegisterAsDependentOf(ezUInt32 uiDependencySlot);
+
+  /// \brief Atomically closes the list of dependent groups, such that no further groups can register, and returns its head.
+  ezUInt32 CloseDependentsList(ezUInt32 uiGroupCounter);
+
+  /// \brief Identifies one entry in m_DependsOnGroups of some group, used as a node in the dependents list of other groups.
+  static ezUInt32 MakeDependentsListNode(ezUInt16 uiTaskGroupIndex, ezUInt32 uiDependencySlot)
+  {
+    return ((static_cast<ezUInt32>(uiTaskGroupIndex) << 15) | uiDependencySlot) + 1;
+  }
+
+  ezAtomicBool m_bInUse; ///< Atomic, since WriteStateSnapshotToDGML() reads it while other threads finish or reuse the group.
   bool m_bStartedByUser = false;
-  ezUInt16 m_uiTaskGroupIndex = 0xFFFF; // only there as a debugging aid
+  ezUInt16 m_uiTaskGroupIndex = 0xFFFF; // used to link groups in lock-free lists
   ezUInt32 m_uiGroupCounter = 1;
+  ezUInt32 m_uiNextFreeGroup = 0; // index + 1 of the next group on the free list, see ezTaskSystemState::m_iFreeTaskGroups
   ezHybridArray<ezSharedPtr<ezTask>, 16> m_Tasks;
   ezHybridArray<ezTaskGroupID, 4> m_DependsOnGroups;
-  ezHybridArray<ezTaskGroupID, 8> m_OthersDependingOnMe;
+
+  // For every entry in m_DependsOnGroups, the next node in the dependents list of that other group.
+  ezHybridArray<ezUInt32, 4> m_DependencyLinks;
+
+  // Lock-free singly linked list of the groups that wait for this group to finish.
+  // The upper 32 bits hold the group counter of the generation that the list belongs to, the lower 32 bits the first node
+  // (see MakeDependentsListNode()). Once the group finishes, the node is set to DependentsListClosed.
+  ezAtomicInteger64 m_iDependentsHead;
+
   ezAtomicInteger32 m_iNumActiveDependencies;
   ezAtomicInteger32 m_iNumRemainingTasks;
   ezOnTaskGroupFinishedCallback m_OnFinishedCallback;
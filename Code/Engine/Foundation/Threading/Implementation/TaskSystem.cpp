@@ -1,6 +1,8 @@
 #include <FoundationPCH.h>
 
 #include <Foundation/Configuration/Startup.h>
+#include <Foundation/Memory/Allocator.h>
+#include <Foundation/Memory/Policies/PoolAllocation.h>
 #include <Foundation/Threading/Implementation/TaskGroup.h>
 #include <Foundation/Threading/Implementation/TaskSystemState.h>
 #include <Foundation/Threading/Implementation/TaskWorkerThread.h>
@@ -36,6 +38,12 @@ void ezTaskSystem::Startup()
   s_ThreadState = EZ_DEFAULT_NEW(ezTaskSystemThreadState);
   s_State = EZ_DEFAULT_NEW(ezTaskSystemState);
 
+#if EZ_ENABLED(EZ_SUPPORTS_COROUTINES)
+  // individual allocations are not tracked, the parent allocator still tracks the blocks that the pool holds on to
+  typedef ezAllocator<ezMemoryPolicies::ezPoolAllocation, ezMemoryTrackingFlags::RegisterAllocator> CoroutineAllocatorType;
+  s_State->m_pCoroutineAllocator = EZ_DEFAULT_NEW(CoroutineAllocatorType, "TaskCoroutines", ezFoundation::GetAlignedAllocator());
+#endif
+
   tl_TaskWorkerInfo.m_WorkerType = ezWorkerThreadType::MainThread;
   tl_TaskWorkerInfo.m_iWorkerIndex = 0;
 }
@@ -0,0 +1,108 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Threading/TaskCoroutine.h>
+
+#if EZ_ENABLED(EZ_SUPPORTS_COROUTINES)
+
+#  include <Foundation/Threading/Implementation/TaskSystemState.h>
+
+namespace
+{
+  /// Resumes a suspended coroutine. The coroutine then runs on the thread that executes this task, until it suspends again or finishes.
+  class ezCoroutineResumeTask final : public ezTask
+  {
+  public:
+    ezCoroutineResumeTask(void* pCoroutineAddress)
+      : m_pCoroutineAddress(pCoroutineAddress)
+    {
+      // the coroutine may do anything, including waiting for other tasks
+      ConfigureTask("ResumeCoroutine", ezTaskNesting::Maybe);
+    }
+
+  private:
+    virtual void Execute() override { std::coroutine_handle<>::from_address(m_pCoroutineAddress).resume(); }
+
+    void* m_pCoroutineAddress;
+  };
+} // namespace
+
+ezAllocatorBase* ezTaskSystem::GetCoroutineAllocator()
+{
+  return s_State->m_pCoroutineAllocator.Borrow();
+}
+
+void ezTaskSystem::ResumeCoroutine(void* pCoroutineAddress, ezTaskPriority::Enum Priority, ezTaskGroupID Dependency)
+{
+  // the task is kept alive by its group, which may outlive the coroutine frame, so it has to be reference counted
+  ezSharedPtr<ezTask> pTask = EZ_NEW(GetCoroutineAllocator(), ezCoroutineResumeTask, pCoroutineAddress);
+
+  if (Dependency.IsValid())
+  {
+    StartSingleTask(pTask, Priority, Dependency);
+  }
+  else
+  {
+    StartSingleTask(pTask, Priority);
+  }
+}
+
+ezTaskCoroutine::ezTaskCoroutine(Handle h)
+  : m_Handle(h)
+{
+}
+
+ezTaskCoroutine::ezTaskCoroutine(ezTaskCoroutine&& other)
+  : m_Handle(other.m_Handle)
+{
+  other.m_Handle = nullptr;
+}
+
+ezTaskCoroutine::~ezTaskCoroutine()
+{
+  Release();
+}
+
+void ezTaskCoroutine::operator=(ezTaskCoroutine&& other)
+{
+  if (this == &other)
+    return;
+
+  Release();
+
+  m_Handle = other.m_Handle;
+  other.m_Handle = nullptr;
+}
+
+bool ezTaskCoroutine::IsFinished() const
+{
+  return !m_Handle || m_Handle.promise().m_iState == Finished;
+}
+
+void ezTaskCoroutine::Wait()
+{
+  if (IsFinished())
+    return;
+
+  EZ_ASSERT_DEV(m_Handle.promise().m_iState == Running, "Cannot wait for a coroutine that is awaited by another coroutine.");
+
+  ezTaskSystem::WaitForCondition([this]() { return IsFinished(); });
+}
+
+void ezTaskCoroutine::Release()
+{
+  if (!m_Handle)
+    return;
+
+  // if the coroutine is still running, it frees its frame itself once it is finished
+  if (!m_Handle.promise().m_iState.TestAndSet(Running, Detached))
+  {
+    EZ_ASSERT_DEV(m_Handle.promise().m_iState == Finished, "A task coroutine is destroyed while another coroutine awaits it.");
+    m_Handle.destroy();
+  }
+
+  m_Handle = nullptr;
+}
+
+#endif
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Threading_Implementation_TaskSystemCoroutines);
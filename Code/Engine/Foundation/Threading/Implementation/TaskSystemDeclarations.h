@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/Containers/HybridArray.h>
+#include <Foundation/Threading/AtomicInteger.h>
 #include <Foundation/Threading/ConditionVariable.h>
 #include <Foundation/Time/Time.h>
 #include <Foundation/Types/Delegate.h>
@@ -9,6 +10,8 @@
 
 class ezTask;
 class ezTaskGroup;
+class ezForkJoinTaskBase;
+class ezForkJoinScope;
 class ezTaskWorkerThread;
 class ezTaskSystemState;
 class ezTaskSystemThreadState;
@@ -98,6 +101,42 @@ struct ezWorkerThreadType
   static const char* GetThreadTypeName(ezWorkerThreadType::Enum ThreadType);
 };
 
+/// \brief Describes how the worker threads are placed onto the CPU cores. See ezTaskSystem::SetThreadPlacement().
+struct ezTaskThreadPlacement
+{
+  enum Enum : ezUInt8
+  {
+    Default,       ///< Worker threads are not pinned, the OS decides where they run.
+    PhysicalCores, ///< Every short task worker is pinned to its own physical core. Long task and file access workers are kept away from those
+                   ///< cores, by restricting them to the SMT siblings of the cores, to another NUMA node or to the remaining cores.
+  };
+};
+
+/// \brief Statistics about the frame times and the worker thread utilization. See ezTaskSystem::GetUtilizationReport().
+struct ezTaskSystemUtilizationReport
+{
+  /// The number of frames (calls to ezTaskSystem::FinishFrameTasks()) that the statistics were gathered over.
+  ezUInt32 m_uiNumFrames = 0;
+
+  ezTime m_MinFrameTime;
+  ezTime m_MaxFrameTime;
+  ezTime m_AverageFrameTime;
+  ezTime m_FrameTimeStandardDeviation;
+
+  /// The average utilization (0 - 1) of the worker threads of each type.
+  double m_fAverageUtilization[ezWorkerThreadType::ENUM_COUNT] = {};
+
+  /// The highest utilization that any single worker thread of each type had during one frame.
+  double m_fPeakUtilization[ezWorkerThreadType::ENUM_COUNT] = {};
+
+  /// How many tasks the worker threads of each type executed in total.
+  ezUInt64 m_uiNumTasksExecuted[ezWorkerThreadType::ENUM_COUNT] = {};
+
+  /// The placement that was active while the statistics were gathered, and how many worker threads were successfully pinned.
+  ezTaskThreadPlacement::Enum m_ThreadPlacement = ezTaskThreadPlacement::Default;
+  ezUInt32 m_uiNumPinnedThreads = 0;
+};
+
 /// \brief Given out by ezTaskSystem::CreateTaskGroup to identify a task group.
 class EZ_FOUNDATION_DLL ezTaskGroupID
 {
@@ -162,6 +201,33 @@ enum class ezTaskNesting
   Never,
 };
 
+/// \brief Stores how long a ParallelFor invocation needs per item, to partition the following invocations of the same loop.
+///
+/// Used by ParallelFor invocations that run with ezParallelForParams::bAdaptive. Typically declared as a static variable
+/// next to the loop, so that the cost is only measured once and then refined with every invocation:
+/// \code{.cpp}
+///   static ezParallelForCostCache s_Cost;
+///
+///   ezParallelForParams params;
+///   params.bAdaptive = true;
+///   params.pCostCache = &s_Cost;
+///   ezTaskSystem::ParallelFor(items, [](ezArrayPtr<Item> slice) { ... }, "UpdateItems", params);
+/// \endcode
+struct EZ_FOUNDATION_DLL ezParallelForCostCache
+{
+  /// \brief Returns the measured time per item, or zero if nothing was measured yet.
+  ezTime GetItemCost() const;
+
+  /// \brief Blends the time that it took to process the given number of items into the stored cost.
+  void AddMeasurement(ezTime duration, ezUInt32 uiNumItems);
+
+  /// \brief Discards the measured cost, e.g. when the work done per item has changed significantly.
+  void Reset();
+
+private:
+  ezAtomicInteger64 m_iPicosecondsPerItem;
+};
+
 /// \brief Settings for ezTaskSystem::ParallelFor invocations.
 struct EZ_FOUNDATION_DLL ezParallelForParams
 {
@@ -185,6 +251,15 @@ struct EZ_FOUNDATION_DLL ezParallelForParams
   /// The allocator used to for the tasks that the parallel-for uses internally. If null, will use the default allocator.
   ezAllocatorBase* pTaskAllocator = nullptr;
 
+  /// If enabled, uiBinSize and uiMaxTasksPerThread are ignored. Instead the items are partitioned according to how long they take to process,
+  /// such that each task invocation does enough work to be worth scheduling. Loops that are too cheap are executed on the calling thread.
+  /// If the cost per item is not known yet, the first items are processed on the calling thread to measure it.
+  bool bAdaptive = false;
+
+  /// Optional storage for the cost per item in adaptive mode, which saves measuring the cost again with every invocation.
+  /// Each cost cache should only be used by a single loop. See ezParallelForCostCache.
+  ezParallelForCostCache* pCostCache = nullptr;
+
   /// Returns the multiplicity to use for the given task. If 0 is returned,
   /// serial execution is to be performed.
   ezUInt32 DetermineMultiplicity(ezUInt32 uiNumTaskItems) const;
@@ -192,6 +267,10 @@ struct EZ_FOUNDATION_DLL ezParallelForParams
   /// Returns the number of task items to work on per invocation (multiplicity).
   /// This is aligned with the multiplicity, i.e., multiplicity * bin_size >= # task items.
   ezUInt32 DetermineItemsPerInvocation(ezUInt32 uiNumTaskItems, ezUInt32 uiMultiplicity) const;
+
+  /// Returns the multiplicity to use in adaptive mode, when processing one item takes the given time. If 0 is returned,
+  /// serial execution is to be performed.
+  ezUInt32 DetermineAdaptiveMultiplicity(ezUInt32 uiNumTaskItems, ezTime itemCost) const;
 };
 
 using ezParallelForIndexedFunction = ezDelegate<void(ezUInt32, ezUInt32), 48>;
@@ -0,0 +1,74 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Threading/ForkJoin.h>
+#include <Foundation/Threading/Implementation/TaskWorkerThread.h>
+#include <Foundation/Threading/TaskSystem.h>
+
+ezForkJoinTaskBase::ezForkJoinTaskBase(const char* szTaskName /*= "ForkJoinTask"*/)
+{
+  ConfigureTask(szTaskName, ezTaskNesting::Maybe);
+}
+
+ezForkJoinTaskBase::~ezForkJoinTaskBase()
+{
+  EZ_ASSERT_DEV(IsTaskFinished(), "A fork-join task is destroyed while it is still queued or running. Call ezForkJoinScope::Sync() first.");
+}
+
+ezForkJoinScope::ezForkJoinScope(ezTaskPriority::Enum priority /*= ezTaskPriority::ThisFrame*/)
+  : m_Priority(priority)
+{
+  EZ_ASSERT_DEV(ezTaskSystem::GetWorkerTypeForPriority(priority) != ezWorkerThreadType::MainThread,
+    "Fork-join tasks cannot be executed with a main thread priority.");
+}
+
+ezForkJoinScope::~ezForkJoinScope()
+{
+  EZ_ASSERT_DEV(m_iPendingTasks == 0, "ezForkJoinScope::Sync() has to be called before the scope is destroyed.");
+}
+
+void ezForkJoinScope::Spawn(ezForkJoinTaskBase& task)
+{
+  EZ_ASSERT_DEV(task.IsTaskFinished(), "A fork-join task cannot be spawned again before it has finished.");
+
+  task.m_pScope = this;
+  m_iPendingTasks.Increment();
+
+  ezTaskSystem::SpawnForkJoinTask(&task, m_Priority);
+}
+
+void ezForkJoinScope::Sync()
+{
+  if (m_iPendingTasks == 0)
+    return;
+
+  // executes other tasks (with a preference for the ones that this thread spawned most recently) until all our tasks are done
+  ezTaskSystem::WaitForCondition([this]() { return m_iPendingTasks == 0; });
+}
+
+void ezTaskSystem::SpawnForkJoinTask(ezForkJoinTaskBase* pTask, ezTaskPriority::Enum Priority)
+{
+  if (s_ThreadState->m_Workers[ezWorkerThreadType::ShortTasks].GetCount() == 0)
+    SetWorkerThreadCount(-1, -1); // set the default number of threads, if none are started yet
+
+  pTask->Reset();
+  pTask->m_BelongsToGroup = ezTaskGroupID();
+  pTask->m_iInvocationsToClaim = 1;
+  pTask->m_bTaskIsScheduled = true;
+
+  QueueTask(pTask, 1, Priority, false, true);
+
+  WakeUpThreads(GetWorkerTypeForPriority(Priority), 1);
+}
+
+void ezTaskSystem::ForkJoinTaskHasFinished(ezForkJoinTaskBase* pTask)
+{
+  ezForkJoinScope* pScope = pTask->m_pScope;
+
+  pTask->m_iRemainingRuns.Decrement();
+
+  // once the counter reaches zero, the scope's Sync() may return and both the task and the scope may get destroyed right away,
+  // so neither of them must be accessed after this
+  pScope->m_iPendingTasks.Decrement();
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Threading_Implementation_TaskSystemForkJoin);
@@ -11,31 +11,80 @@
 
 ezTaskGroupID ezTaskSystem::CreateTaskGroup(ezTaskPriority::Enum Priority, ezOnTaskGroupFinishedCallback callback)
 {
-  EZ_LOCK(s_TaskSystemMutex);
+  ezTaskGroup* pGroup = AllocateTaskGroup();
+  pGroup->Reuse(Priority, callback);
 
-  ezUInt32 i = 0;
+  ezTaskGroupID id;
+  id.m_pTaskGroup = pGroup;
+  id.m_uiGroupCounter = pGroup->m_uiGroupCounter;
+  return id;
+}
 
-  // this search could be speed up with a stack of free groups
-  for (; i < s_State->m_TaskGroups.GetCount(); ++i)
+ezTaskGroup* ezTaskSystem::AllocateTaskGroup()
+{
+  while (true)
   {
-    if (!s_State->m_TaskGroups[i].m_bInUse)
+    const ezUInt64 uiHead = static_cast<ezUInt64>(static_cast<ezInt64>(s_State->m_iFreeTaskGroups));
+    const ezUInt32 uiTop = static_cast<ezUInt32>(uiHead);
+
+    if (uiTop != 0)
+    {
+      ezTaskGroup* pGroup = s_State->GetTaskGroup(uiTop - 1);
+
+      // the group may get popped (and pushed again) by another thread in the mean time, reading its link is still safe,
+      // because groups are never deallocated, and in that case the tag has changed and the CAS fails
+      const ezUInt64 uiNewHead = (((uiHead >> 32) + 1) << 32) | pGroup->m_uiNextFreeGroup;
+
+      if (s_State->m_iFreeTaskGroups.TestAndSet(static_cast<ezInt64>(uiHead), static_cast<ezInt64>(uiNewHead)))
+        return pGroup;
+
+      continue;
+    }
+
+    EZ_LOCK(s_State->m_TaskGroupChunkMutex);
+
+    // another thread may have allocated a new chunk, while we were waiting for the lock
+    if (static_cast<ezUInt32>(static_cast<ezInt64>(s_State->m_iFreeTaskGroups)) != 0)
+      continue;
+
+    const ezUInt32 uiChunk = s_State->m_iNumTaskGroupChunks;
+    EZ_ASSERT_ALWAYS(uiChunk < ezTaskSystemState::MaxTaskGroupChunks, "Too many task groups are in use at the same time.");
+
+    ezTaskGroup* pChunk = EZ_DEFAULT_NEW_ARRAY(ezTaskGroup, ezTaskSystemState::TaskGroupChunkSize).GetPtr();
+
+    for (ezUInt32 i = 0; i < ezTaskSystemState::TaskGroupChunkSize; ++i)
+    {
+      pChunk[i].m_uiTaskGroupIndex = static_cast<ezUInt16>(uiChunk * ezTaskSystemState::TaskGroupChunkSize + i);
+    }
+
+    s_State->m_TaskGroupChunks[uiChunk] = pChunk;
+    s_State->m_iNumTaskGroupChunks.Increment();
+
+    // keep the first group for ourselves, all others go onto the free list
+    for (ezUInt32 i = 1; i < ezTaskSystemState::TaskGroupChunkSize; ++i)
     {
-      goto foundtaskgroup;
+      ReleaseTaskGroup(&pChunk[i]);
     }
+
+    return &pChunk[0];
   }
+}
+
+void ezTaskSystem::ReleaseTaskGroup(ezTaskGroup* pGroup)
+{
+  const ezUInt32 uiGroupRef = pGroup->m_uiTaskGroupIndex + 1;
 
-  // no free group found, create a new one
-  s_State->m_TaskGroups.ExpandAndGetRef();
-  s_State->m_TaskGroups[i].m_uiTaskGroupIndex = static_cast<ezUInt16>(i);
+  while (true)
+  {
+    const ezUInt64 uiHead = static_cast<ezUInt64>(static_cast<ezInt64>(s_State->m_iFreeTaskGroups));
 
-foundtaskgroup:
+    pGroup->m_uiNextFreeGroup = static_cast<ezUInt32>(uiHead);
 
-  s_State->m_TaskGroups[i].Reuse(Priority, callback);
+    const ezUInt64 uiNewHead = (((uiHead >> 32) + 1) << 32) | uiGroupRef;
 
-  ezTaskGroupID id;
-  id.m_pTaskGroup = &s_State->m_TaskGroups[i];
-  id.m_uiGroupCounter = s_State->m_TaskGroups[i].m_uiGroupCounter;
-  return id;
+    if (s_State->m_iFreeTaskGroups.TestAndSet(static_cast<ezInt64>(uiHead), static_cast<ezInt64>(uiNewHead)))
+      return;
+  }
 }
 
 void ezTaskSystem::AddTaskToGroup(ezTaskGroupID groupID, const ezSharedPtr<ezTask>& pTask)
@@ -46,6 +95,13 @@ void ezTaskSystem::AddTaskToGroup(ezTaskGroupID groupID, const ezSharedPtr<ezTas
 
   ezTaskGroup::DebugCheckTaskGroup(groupID, s_TaskSystemMutex);
 
+  if (pTask->m_iQueuedEntries != 0)
+  {
+    // the task was canceled, but some of its entries are still in the deques of worker threads
+    // they have to be dropped first, otherwise they would claim the invocations of the next run
+    WaitForCondition([&pTask]() { return pTask->m_iQueuedEntries == 0; });
+  }
+
   pTask->Reset();
   pTask->m_BelongsToGroup = groupID;
   groupID.m_pTaskGroup->m_Tasks.PushBack(pTask);
@@ -82,46 +138,50 @@ void ezTaskSystem::StartTaskGroup(ezTaskGroupID groupID)
 
   ezTaskGroup::DebugCheckTaskGroup(groupID, s_TaskSystemMutex);
 
-  ezInt32 iActiveDependencies = 0;
+  ezTaskGroup& tg = *groupID.m_pTaskGroup;
 
-  {
-    EZ_LOCK(s_TaskSystemMutex);
+  tg.m_bStartedByUser = true;
 
-    ezTaskGroup& tg = *groupID.m_pTaskGroup;
+  const ezUInt32 uiNumDependencies = tg.m_DependsOnGroups.GetCount();
 
-    tg.m_bStartedByUser = true;
+  if (uiNumDependencies == 0)
+  {
+    ScheduleGroupTasks(&tg, false);
+    return;
+  }
 
-    for (ezUInt32 i = 0; i < tg.m_DependsOnGroups.GetCount(); ++i)
-    {
-      if (!IsTaskGroupFinished(tg.m_DependsOnGroups[i]))
-      {
-        ezTaskGroup& Dependency = *tg.m_DependsOnGroups[i].m_pTaskGroup;
+  // the links must not be relocated anymore, once other groups can see them
+  tg.m_DependencyLinks.SetCountUninitialized(uiNumDependencies);
 
-        // add this task group to the list of dependencies, such that when that group finishes, this task group can get woken up
-        Dependency.m_OthersDependingOnMe.PushBack(groupID);
+  // The additional count prevents that the group gets scheduled by a dependency that finishes while we are still registering at the others.
+  // Otherwise the group could even finish and get reused in the mean time.
+  tg.m_iNumActiveDependencies = static_cast<ezInt32>(uiNumDependencies) + 1;
 
-        // count how many other groups need to finish before this task group can be executed
-        ++iActiveDependencies;
-      }
-    }
+  ezInt32 iFinishedDependencies = 0;
 
-    if (iActiveDependencies != 0)
+  for (ezUInt32 i = 0; i < uiNumDependencies; ++i)
+  {
+    // add this task group to the list of dependents, such that when that group finishes, this task group can get woken up
+    if (!tg.RegisterAsDependentOf(i))
     {
-      // atomic integers are quite slow, so do not use them in the loop, where they are not yet needed
-      tg.m_iNumActiveDependencies = iActiveDependencies;
+      ++iFinishedDependencies;
     }
   }
 
-  if (iActiveDependencies == 0)
+  if (iFinishedDependencies > 0)
+  {
+    tg.m_iNumActiveDependencies.Subtract(iFinishedDependencies);
+  }
+
+  // remove the additional count again, if all dependencies have finished in the mean time, it is our turn to start the group
+  if (tg.m_iNumActiveDependencies.Decrement() == 0)
   {
-    ScheduleGroupTasks(groupID.m_pTaskGroup, false);
+    ScheduleGroupTasks(&tg, false);
   }
 }
 
 void ezTaskSystem::StartTaskGroupBatch(ezArrayPtr<const ezTaskGroupID> batch)
 {
-  EZ_LOCK(s_TaskSystemMutex);
-
   for (const ezTaskGroupID& group : batch)
   {
     StartTaskGroup(group);
@@ -146,84 +206,52 @@ void ezTaskSystem::ScheduleGroupTasks(ezTaskGroup* pGroup, bool bHighPriority)
   }
 
   ezInt32 iRemainingTasks = 0;
+  ezUInt32 uiNumTasks = 0;
+  const ezTaskPriority::Enum Priority = pGroup->m_Priority;
 
-  // add all the tasks to the task list, so that they will be processed
+  // store how many tasks from this groups still need to be processed
   {
-    EZ_LOCK(s_TaskSystemMutex);
-
+    // synchronizes with CancelTask(), which removes tasks from the group that are not scheduled yet
+    EZ_LOCK(pGroup->m_CondVarGroupFinished);
 
-    // store how many tasks from this groups still need to be processed
+    uiNumTasks = pGroup->m_Tasks.GetCount();
 
-    for (auto pTask : pGroup->m_Tasks)
+    for (ezUInt32 task = 0; task < uiNumTasks; ++task)
     {
-      iRemainingTasks += ezMath::Max(1u, pTask->m_uiMultiplicity);
-      pTask->m_iRemainingRuns = ezMath::Max(1u, pTask->m_uiMultiplicity);
+      ezTask* pTask = pGroup->m_Tasks[task].Borrow();
+      const ezInt32 iRuns = (ezInt32)ezMath::Max(1u, pTask->m_uiMultiplicity);
+
+      iRemainingTasks += iRuns;
+      pTask->m_iRemainingRuns = iRuns;
+      pTask->m_iInvocationsToClaim = iRuns;
+      pTask->m_iQueuedEntries = iRuns;
+      pTask->m_pKeepAliveWhileQueued = pGroup->m_Tasks[task];
+      pTask->m_uiIndexInGroup = task;
+      pTask->m_bTaskIsScheduled = true;
     }
 
-    pGroup->m_iNumRemainingTasks = iRemainingTasks;
-
-
-    for (ezUInt32 task = 0; task < pGroup->m_Tasks.GetCount(); ++task)
-    {
-      auto& pTask = pGroup->m_Tasks[task];
+    // one extra run keeps the group alive while its tasks get queued, CancelTask() may finish tasks that are not queued yet
+    pGroup->m_iNumRemainingTasks = iRemainingTasks + 1;
+  }
 
-      for (ezUInt32 mult = 0; mult < ezMath::Max(1u, pTask->m_uiMultiplicity); ++mult)
-      {
-        TaskData td;
-        td.m_pBelongsToGroup = pGroup;
-        td.m_pTask = pTask;
-        td.m_pTask->m_bTaskIsScheduled = true;
-        td.m_uiInvocation = mult;
-
-        if (bHighPriority)
-          s_State->m_Tasks[pGroup->m_Priority].PushFront(td);
-        else
-          s_State->m_Tasks[pGroup->m_Priority].PushBack(td);
-      }
-    }
+  // add all the tasks to the task queues, so that they will be processed
+  for (ezUInt32 task = 0; task < uiNumTasks; ++task)
+  {
+    ezTask* pTask = pGroup->m_Tasks[task].Borrow();
 
-    // send the proper thread signal, to make sure one of the correct worker threads is awake
-    switch (pGroup->m_Priority)
-    {
-      case ezTaskPriority::EarlyThisFrame:
-      case ezTaskPriority::ThisFrame:
-      case ezTaskPriority::LateThisFrame:
-      case ezTaskPriority::EarlyNextFrame:
-      case ezTaskPriority::NextFrame:
-      case ezTaskPriority::LateNextFrame:
-      case ezTaskPriority::In2Frames:
-      case ezTaskPriority::In3Frames:
-      case ezTaskPriority::In4Frames:
-      case ezTaskPriority::In5Frames:
-      case ezTaskPriority::In6Frames:
-      case ezTaskPriority::In7Frames:
-      case ezTaskPriority::In8Frames:
-      case ezTaskPriority::In9Frames:
-      {
-        WakeUpThreads(ezWorkerThreadType::ShortTasks, iRemainingTasks);
-        break;
-      }
+    QueueTask(pTask, ezMath::Max(1u, pTask->m_uiMultiplicity), Priority, bHighPriority, true);
+  }
 
-      case ezTaskPriority::LongRunning:
-      case ezTaskPriority::LongRunningHighPriority:
-      {
-        WakeUpThreads(ezWorkerThreadType::LongTasks, iRemainingTasks);
-        break;
-      }
+  // once the extra run is finished, the group may get finished and reused at any time, so it must not be accessed anymore after that
+  TaskHasFinished(nullptr, pGroup);
 
-      case ezTaskPriority::FileAccess:
-      case ezTaskPriority::FileAccessHighPriority:
-      {
-        WakeUpThreads(ezWorkerThreadType::FileAccess, iRemainingTasks);
-        break;
-      }
+  // send the proper thread signal, to make sure one of the correct worker threads is awake
+  const ezWorkerThreadType::Enum WorkerType = GetWorkerTypeForPriority(Priority);
 
-      case ezTaskPriority::SomeFrameMainThread:
-      case ezTaskPriority::ThisFrameMainThread:
-      case ezTaskPriority::ENUM_COUNT:
-        // nothing to do for these enum values
-        break;
-    }
+  // main thread tasks are picked up in FinishFrameTasks()
+  if (WorkerType != ezWorkerThreadType::MainThread)
+  {
+    WakeUpThreads(WorkerType, iRemainingTasks);
   }
 }
 
@@ -244,11 +272,19 @@ ezResult ezTaskSystem::CancelGroup(ezTaskGroupID Group, ezOnTaskRunning::Enum On
 
   EZ_PROFILE_SCOPE("CancelGroup");
 
-  EZ_LOCK(s_TaskSystemMutex);
+  ezHybridArray<ezSharedPtr<ezTask>, 16> TasksCopy;
 
-  ezResult res = EZ_SUCCESS;
+  {
+    // the group finishes (and clears its tasks) under the same lock
+    EZ_LOCK(Group.m_pTaskGroup->m_CondVarGroupFinished);
 
-  auto TasksCopy = Group.m_pTaskGroup->m_Tasks;
+    if (ezTaskSystem::IsTaskGroupFinished(Group))
+      return EZ_SUCCESS;
+
+    TasksCopy = Group.m_pTaskGroup->m_Tasks;
+  }
+
+  ezResult res = EZ_SUCCESS;
 
   // first cancel ALL the tasks in the group, without waiting for anything
   for (ezUInt32 task = 0; task < TasksCopy.GetCount(); ++task)
@@ -1,7 +1,22 @@
 #pragma once
 
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/Threading/Implementation/TaskGroup.h>
 #include <Foundation/Threading/TaskSystem.h>
 
+/// \internal The global queue of tasks for one priority.
+///
+/// Threads that do not own a local work-stealing deque for a priority (e.g. the main thread) put their tasks here.
+/// It is also used as the overflow, once a local deque is full, and it is the only place where tasks can be reprioritized.
+struct ezTaskInjectionQueue
+{
+  ezMutex m_Mutex;
+  ezDeque<ezTask*> m_Tasks;
+
+  // allows to skip empty queues without locking the mutex
+  ezAtomicInteger32 m_iNumTasks;
+};
+
 class ezTaskSystemThreadState
 {
 private:
@@ -16,19 +31,78 @@ private:
 
   // the maximum number of worker threads that should be non-idle (and not blocked) at any time
   ezUInt32 m_uiMaxWorkersToUse[ezWorkerThreadType::ENUM_COUNT] = {};
+
+  // see ezTaskSystem::SetThreadPlacement()
+  ezTaskThreadPlacement::Enum m_ThreadPlacement = ezTaskThreadPlacement::Default;
+
+  // the logical processor for each short task worker (indexed by the worker index modulo the count)
+  // and the logical processors that all long task and file access workers share
+  ezDynamicArray<ezUInt32> m_ShortTaskProcessors;
+  ezDynamicArray<ezUInt32> m_BackgroundProcessors;
+
+  // how many of the current worker threads were pinned successfully
+  ezAtomicInteger32 m_iNumPinnedThreads;
+
+  // Accumulated by ezTaskSystem::UpdateUtilizationReport(). The averages in m_UtilizationReport are only computed when it is retrieved.
+  ezTaskSystemUtilizationReport m_UtilizationReport;
+  double m_fFrameTimeSum = 0.0;
+  double m_fFrameTimeSquaredSum = 0.0;
+  double m_fUtilizationSum[ezWorkerThreadType::ENUM_COUNT] = {};
 };
 
 class ezTaskSystemState
 {
+public:
+  ~ezTaskSystemState()
+  {
+    const ezUInt32 uiNumChunks = m_iNumTaskGroupChunks;
+
+    for (ezUInt32 i = 0; i < uiNumChunks; ++i)
+    {
+      ezArrayPtr<ezTaskGroup> chunk(m_TaskGroupChunks[i], TaskGroupChunkSize);
+      EZ_DEFAULT_DELETE_ARRAY(chunk);
+    }
+  }
+
 private:
   friend class ezTaskSystem;
 
+  enum : ezUInt32
+  {
+    TaskGroupChunkSize = 64,
+    MaxTaskGroupChunks = (1 << 16) / TaskGroupChunkSize, // ezTaskGroup::m_uiTaskGroupIndex is 16 bit
+  };
+
+  EZ_ALWAYS_INLINE ezTaskGroup* GetTaskGroup(ezUInt32 uiIndex) const
+  {
+    return m_TaskGroupChunks[uiIndex / TaskGroupChunkSize] + (uiIndex % TaskGroupChunkSize);
+  }
+
   // The target frame time used by FinishFrameTasks()
   ezTime m_TargetFrameTime = ezTime::Seconds(1.0 / 40.0); // => 25 ms
 
-  // The deque can grow without relocating existing data, therefore the ezTaskGroupID's can store pointers directly to the data
-  ezDeque<ezTaskGroup> m_TaskGroups;
+  // Task groups are allocated in chunks that never get relocated or freed while the task system is running.
+  // Therefore the ezTaskGroupID's can store pointers directly to the groups and a group index can be resolved without any lock.
+  ezTaskGroup* m_TaskGroupChunks[MaxTaskGroupChunks] = {};
+  ezAtomicInteger32 m_iNumTaskGroupChunks;
+
+  // Only locked when the free list is empty and a new chunk has to be allocated
+  ezMutex m_TaskGroupChunkMutex;
+
+  // Lock-free stack of unused task groups, linked through ezTaskGroup::m_uiNextFreeGroup.
+  // The lower 32 bits are the index + 1 of the top group (zero if empty), the upper 32 bits are a tag that changes with every operation,
+  // so that a concurrent pop and push of the same group cannot go unnoticed (ABA problem).
+  ezAtomicInteger64 m_iFreeTaskGroups;
+
+  // The global queues of scheduled tasks, for each priority. Worker threads additionally have their own work-stealing deques.
+  ezTaskInjectionQueue m_InjectionQueues[ezTaskPriority::ENUM_COUNT];
+
+  // Whether worker threads put the tasks that they schedule into their own deques, see ezTaskSystem::SetWorkStealingEnabled()
+  bool m_bWorkStealing = true;
 
-  // The lists of all scheduled tasks, for each priority.
-  ezList<ezTaskSystem::TaskData> m_Tasks[ezTaskPriority::ENUM_COUNT];
+#if EZ_ENABLED(EZ_SUPPORTS_COROUTINES)
+  // Coroutine frames and the tasks that resume them are allocated from this pool.
+  // It is destroyed after the task group chunks, which may still hold on to resume tasks.
+  ezUniquePtr<ezAllocatorBase> m_pCoroutineAllocator;
+#endif
 };
@@ -1,6 +1,7 @@
 #include <FoundationPCH.h>
 
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/ForkJoin.h>
 #include <Foundation/Threading/Implementation/TaskGroup.h>
 #include <Foundation/Threading/Implementation/TaskSystemState.h>
 #include <Foundation/Threading/Implementation/TaskWorkerThread.h>
@@ -26,11 +27,14 @@ ezTaskGroupID ezTaskSystem::StartSingleTask(
   return Group;
 }
 
-void ezTaskSystem::TaskHasFinished(const ezSharedPtr<ezTask>& pTask, ezTaskGroup* pGroup)
+void ezTaskSystem::TaskHasFinished(ezTask* pTask, ezTaskGroup* pGroup)
 {
-  if (pTask && pTask->m_OnTaskFinished.IsValid() && pTask->m_iRemainingRuns == 0)
+  if (pTask && pTask->m_iRemainingRuns.Decrement() == 0 && pTask->m_OnTaskFinished.IsValid())
   {
-    pTask->m_OnTaskFinished(pTask);
+    // the callback takes a shared pointer, the group still holds one until all of its tasks are finished
+    // its task list is not modified anymore once the tasks are scheduled, so the index is still valid
+    EZ_ASSERT_DEBUG(pGroup->m_Tasks[pTask->m_uiIndexInGroup].Borrow() == pTask, "Invalid task index");
+    pTask->m_OnTaskFinished(pGroup->m_Tasks[pTask->m_uiIndexInGroup]);
   }
 
   if (pGroup->m_iNumRemainingTasks.Decrement() == 0)
@@ -48,21 +52,27 @@ void ezTaskSystem::TaskHasFinished(const ezSharedPtr<ezTask>& pTask, ezTaskGroup
 
       // set this task group to be finished such that no one tries to append further dependencies
       pGroup->m_uiGroupCounter += 2;
+
+      // unless an outside reference is held onto a task, this will deallocate the tasks
+      // CancelGroup() copies the tasks under the same lock, after checking that the group is not finished yet
+      pGroup->m_Tasks.Clear();
     }
 
     // wake up all threads that are waiting for this group
     pGroup->m_CondVarGroupFinished.SignalAll();
 
+    // no other group can register itself as a dependent anymore, after the list is closed
+    ezUInt32 uiNode = pGroup->CloseDependentsList(groupCounter);
+
+    while (uiNode != ezTaskGroup::DependentsListEnd)
     {
-      EZ_LOCK(s_TaskSystemMutex);
+      const ezUInt32 uiNodeIndex = uiNode - 1;
+      ezTaskGroup* pDependent = s_State->GetTaskGroup(uiNodeIndex >> 15);
 
-      for (ezUInt32 dep = 0; dep < pGroup->m_OthersDependingOnMe.GetCount(); ++dep)
-      {
-        DependencyHasFinished(pGroup->m_OthersDependingOnMe[dep].m_pTaskGroup);
-      }
+      // read the link first, once the dependent gets scheduled, it may finish and get reused at any time
+      uiNode = pDependent->m_DependencyLinks[uiNodeIndex & 0x7FFF];
 
-      // unless an outside reference is held onto a task, this will deallocate the tasks
-      pGroup->m_Tasks.Clear();
+      DependencyHasFinished(pDependent);
     }
 
     if (pGroup->m_OnFinishedCallback.IsValid())
@@ -75,7 +85,129 @@ void ezTaskSystem::TaskHasFinished(const ezSharedPtr<ezTask>& pTask, ezTaskGroup
 
     // set this task available for reuse
     pGroup->m_bInUse = false;
+    ReleaseTaskGroup(pGroup);
+  }
+}
+
+void ezTaskSystem::QueueTask(ezTask* pTask, ezUInt32 uiCount, ezTaskPriority::Enum Priority, bool bHighPriority, bool bAllowLocalQueue)
+{
+  // ReprioritizeFrameTasks() only moves the tasks in the global queues, so tasks for later frames must not end up in the deques,
+  // and high priority tasks have to go to the front of the global queue, instead of joining the other tasks in the deque
+  const bool bLocalQueuePriority = (Priority <= ezTaskPriority::LateThisFrame) ||
+                                   (Priority >= ezTaskPriority::LongRunningHighPriority && Priority <= ezTaskPriority::ThisFrameMainThread);
+
+  if (bAllowLocalQueue && !bHighPriority && bLocalQueuePriority && s_State->m_bWorkStealing && tl_TaskWorkerInfo.m_pWorkerThread != nullptr)
+  {
+    if (ezTaskWorkStealingDeque* pLocalQueue = tl_TaskWorkerInfo.m_pWorkerThread->GetLocalQueue(Priority))
+    {
+      while (uiCount > 0 && pLocalQueue->PushBottom(pTask))
+      {
+        --uiCount;
+      }
+
+      if (uiCount == 0)
+        return;
+    }
   }
+
+  // everything that has no local queue, or that does not fit into it anymore, goes into the global queue
+  ezTaskInjectionQueue& queue = s_State->m_InjectionQueues[Priority];
+
+  EZ_LOCK(queue.m_Mutex);
+
+  for (ezUInt32 i = 0; i < uiCount; ++i)
+  {
+    if (bHighPriority)
+      queue.m_Tasks.PushFront(pTask);
+    else
+      queue.m_Tasks.PushBack(pTask);
+  }
+
+  queue.m_iNumTasks.Add(uiCount);
+}
+
+ezTask* ezTaskSystem::DequeueTask(ezTaskPriority::Enum Priority, bool bOnlyTasksThatNeverWait, const ezTaskGroupID& WaitingForGroup)
+{
+  auto IsAllowed = [&](ezTask* pTask) {
+    return !bOnlyTasksThatNeverWait || (pTask->m_NestingMode == ezTaskNesting::Never) ||
+           pTask->m_BelongsToGroup.m_pTaskGroup == WaitingForGroup.m_pTaskGroup;
+  };
+
+  ezTaskWorkerThread* pThisWorker = tl_TaskWorkerInfo.m_pWorkerThread;
+
+  // the thread's own deque contains the tasks that it queued most recently, their data is most likely still in the cache
+  if (pThisWorker != nullptr)
+  {
+    if (ezTaskWorkStealingDeque* pLocalQueue = pThisWorker->GetLocalQueue(Priority))
+    {
+      if (ezTask* pTask = pLocalQueue->PopBottom())
+      {
+        if (IsAllowed(pTask))
+          return pTask;
+
+        // this thread is blocked and may not execute this task, hand it over to someone else
+        QueueTask(pTask, 1, Priority, true, false);
+      }
+    }
+  }
+
+  // then check the global queue
+  {
+    ezTaskInjectionQueue& queue = s_State->m_InjectionQueues[Priority];
+
+    if (queue.m_iNumTasks > 0)
+    {
+      EZ_LOCK(queue.m_Mutex);
+
+      for (ezUInt32 i = 0; i < queue.m_Tasks.GetCount(); ++i)
+      {
+        ezTask* pTask = queue.m_Tasks[i];
+
+        if (IsAllowed(pTask))
+        {
+          if (i == 0)
+            queue.m_Tasks.PopFront();
+          else
+            queue.m_Tasks.RemoveAtAndCopy(i);
+
+          queue.m_iNumTasks.Decrement();
+          return pTask;
+        }
+      }
+    }
+  }
+
+  // finally try to steal the oldest task from another worker thread
+  {
+    const ezWorkerThreadType::Enum WorkerType = GetWorkerTypeForPriority(Priority);
+    const ezUInt32 uiNumWorkers = s_ThreadState->m_iAllocatedWorkers[WorkerType];
+
+    // start with different victims on different threads, to spread out the contention
+    const ezUInt32 uiFirstVictim = (tl_TaskWorkerInfo.m_iWorkerIndex >= 0) ? tl_TaskWorkerInfo.m_iWorkerIndex + 1 : 0;
+
+    for (ezUInt32 i = 0; i < uiNumWorkers; ++i)
+    {
+      ezTaskWorkerThread* pVictim = s_ThreadState->m_Workers[WorkerType][(uiFirstVictim + i) % uiNumWorkers];
+
+      if (pVictim == pThisWorker)
+        continue;
+
+      ezTaskWorkStealingDeque* pVictimQueue = pVictim->GetLocalQueue(Priority);
+
+      if (pVictimQueue == nullptr || pVictimQueue->IsEmpty())
+        continue;
+
+      if (ezTask* pTask = pVictimQueue->Steal())
+      {
+        if (IsAllowed(pTask))
+          return pTask;
+
+        QueueTask(pTask, 1, Priority, true, false);
+      }
+    }
+  }
+
+  return nullptr;
 }
 
 ezTaskSystem::TaskData ezTaskSystem::GetNextTask(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
@@ -86,37 +218,45 @@ ezTaskSystem::TaskData ezTaskSystem::GetNextTask(ezTaskPriority::Enum FirstPrior
   EZ_ASSERT_DEV(FirstPriority >= ezTaskPriority::EarlyThisFrame && LastPriority < ezTaskPriority::ENUM_COUNT, "Priority Range is invalid: {0} to {1}",
     FirstPriority, LastPriority);
 
-  EZ_LOCK(s_TaskSystemMutex);
-
-  // go through all the task lists that this thread is willing to work on
-  for (ezUInt32 prio = FirstPriority; prio <= (ezUInt32)LastPriority; ++prio)
-  {
-    for (auto it = s_State->m_Tasks[prio].GetIterator(); it.IsValid(); ++it)
+  auto FindTask = [&]() -> TaskData {
+    // go through all the task queues that this thread is willing to work on
+    for (ezUInt32 prio = FirstPriority; prio <= (ezUInt32)LastPriority; ++prio)
     {
-      if (!bOnlyTasksThatNeverWait || (it->m_pTask->m_NestingMode == ezTaskNesting::Never) || it->m_pBelongsToGroup == WaitingForGroup.m_pTaskGroup)
+      if (ezTask* pTask = DequeueTask((ezTaskPriority::Enum)prio, bOnlyTasksThatNeverWait, WaitingForGroup))
       {
-        TaskData td = *it;
-
-        s_State->m_Tasks[prio].Remove(it);
+        TaskData td;
+        td.m_pTask = pTask;
+        td.m_pBelongsToGroup = pTask->m_BelongsToGroup.m_pTaskGroup;
         return td;
       }
     }
-  }
 
-  if (pWorkerState)
+    return TaskData();
+  };
+
+  TaskData td = FindTask();
+
+  if (td.m_pTask == nullptr && pWorkerState)
   {
     EZ_VERIFY(pWorkerState->Set((int)ezTaskWorkerState::Idle) == (int)ezTaskWorkerState::Active, "Corrupt Worker State");
+
+    // tasks that got queued after the search above but before the state switched to 'idle' would not wake up this thread,
+    // so look once more, now that everyone else can see that this thread is about to go to sleep
+    td = FindTask();
+
+    if (td.m_pTask != nullptr)
+    {
+      // if another thread woke us up in the mean time, the state is 'active' already and WaitForWork() will swallow the extra signal
+      pWorkerState->CompareAndSwap((int)ezTaskWorkerState::Idle, (int)ezTaskWorkerState::Active);
+    }
   }
 
-  return TaskData();
+  return td;
 }
 
 bool ezTaskSystem::ExecuteTask(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
   const ezTaskGroupID& WaitingForGroup, ezAtomicInteger32* pWorkerState)
 {
-  // const ezWorkerThreadType::Enum workerType = (tl_TaskWorkerInfo.m_WorkerType == ezWorkerThreadType::Unknown) ? ezWorkerThreadType::ShortTasks :
-  // tl_TaskWorkerInfo.m_WorkerType;
-
   ezTaskSystem::TaskData td = GetNextTask(FirstPriority, LastPriority, bOnlyTasksThatNeverWait, WaitingForGroup, pWorkerState);
 
   if (td.m_pTask == nullptr)
@@ -127,18 +267,57 @@ bool ezTaskSystem::ExecuteTask(ezTaskPriority::Enum FirstPriority, ezTaskPriorit
     EZ_ASSERT_DEV(td.m_pBelongsToGroup == WaitingForGroup.m_pTaskGroup, "");
   }
 
-  tl_TaskWorkerInfo.m_bAllowNestedTasks = td.m_pTask->m_NestingMode != ezTaskNesting::Never;
-  tl_TaskWorkerInfo.m_szTaskName = td.m_pTask->m_sTaskName;
-  td.m_pTask->Run(td.m_uiInvocation);
-  tl_TaskWorkerInfo.m_bAllowNestedTasks = true;
-  tl_TaskWorkerInfo.m_szTaskName = nullptr;
+  // claim one of the invocations of the task, this fails when the task was canceled after it had been queued
+  const ezInt32 iInvocation = td.m_pTask->m_iInvocationsToClaim.Decrement();
+
+  if (iInvocation >= 0)
+  {
+    tl_TaskWorkerInfo.m_bAllowNestedTasks = td.m_pTask->m_NestingMode != ezTaskNesting::Never;
+    tl_TaskWorkerInfo.m_szTaskName = td.m_pTask->m_sTaskName;
+    td.m_pTask->Run(static_cast<ezUInt32>(iInvocation));
+    tl_TaskWorkerInfo.m_bAllowNestedTasks = true;
+    tl_TaskWorkerInfo.m_szTaskName = nullptr;
+  }
 
-  // notify the group, that a task is finished, which might trigger other tasks to be executed
-  TaskHasFinished(td.m_pTask, td.m_pBelongsToGroup);
+  if (td.m_pBelongsToGroup == nullptr)
+  {
+    // only fork-join tasks are queued without a group
+    ForkJoinTaskHasFinished(static_cast<ezForkJoinTaskBase*>(td.m_pTask));
+    return true;
+  }
+
+  if (iInvocation >= 0)
+  {
+    // notify the group, that a task is finished, which might trigger other tasks to be executed
+    // canceled invocations have been reported as finished by CancelTask() already
+    TaskHasFinished(td.m_pTask, td.m_pBelongsToGroup);
+  }
+
+  ReleaseQueuedEntry(td.m_pTask);
 
   return true;
 }
 
+void ezTaskSystem::ReleaseQueuedEntry(ezTask* pTask)
+{
+  while (true)
+  {
+    const ezInt32 iEntries = pTask->m_iQueuedEntries;
+
+    if (iEntries == 1)
+    {
+      // this is the last entry, so no one else accesses the counter or the reference anymore
+      // the reference has to be taken out before the counter is reset, since the task may get scheduled again right after that
+      ezSharedPtr<ezTask> pKeepAlive = std::move(pTask->m_pKeepAliveWhileQueued);
+      pTask->m_iQueuedEntries = 0;
+      return;
+    }
+
+    if (pTask->m_iQueuedEntries.TestAndSet(iEntries, iEntries - 1))
+      return;
+  }
+}
+
 
 ezResult ezTaskSystem::CancelTask(const ezSharedPtr<ezTask>& pTask, ezOnTaskRunning::Enum OnTaskRunning)
 {
@@ -155,41 +334,71 @@ ezResult ezTaskSystem::CancelTask(const ezSharedPtr<ezTask>& pTask, ezOnTaskRunn
   pTask->m_bCancelExecution = true;
 
   {
-    EZ_LOCK(s_TaskSystemMutex);
+    const ezTaskGroupID& group = pTask->m_BelongsToGroup;
+
+    // synchronizes with ScheduleGroupTasks()
+    EZ_LOCK(group.m_pTaskGroup->m_CondVarGroupFinished);
 
     // if the task is still in the queue of its group, it had not yet been scheduled
-    if (!pTask->m_bTaskIsScheduled && pTask->m_BelongsToGroup.m_pTaskGroup->m_Tasks.RemoveAndSwap(pTask))
+    if (!pTask->m_bTaskIsScheduled && !IsTaskGroupFinished(group) && group.m_pTaskGroup->m_Tasks.RemoveAndSwap(pTask))
     {
       // we set the task to finished, even though it was not executed
       pTask->m_iRemainingRuns = 0;
       return EZ_SUCCESS;
     }
+  }
 
-    // check if the task has already been scheduled for execution
-    // if so, remove it from the work queue
-    {
-      for (ezUInt32 i = 0; i < ezTaskPriority::ENUM_COUNT; ++i)
-      {
-        auto it = s_State->m_Tasks[i].GetIterator();
+  // the task has been scheduled for execution already
+  // take away all invocations that were not yet handed out to any thread
+  // whoever dequeues one of the remaining entries will only drop it, without executing the task
+  const ezInt32 iUnclaimedInvocations = ezMath::Max(0, pTask->m_iInvocationsToClaim.Set(0));
 
-        while (it.IsValid())
-        {
-          if (it->m_pTask == pTask)
-          {
-            s_State->m_Tasks[i].Remove(it);
+  // the entries in the global queues can be removed right away, only those in the workers' own deques have to be left to them
+  {
+    ezUInt32 uiRemovedEntries = 0;
 
-            // we set the task to finished, even though it was not executed
-            pTask->m_iRemainingRuns = 0;
+    for (ezUInt32 i = 0; i < ezTaskPriority::ENUM_COUNT; ++i)
+    {
+      ezTaskInjectionQueue& queue = s_State->m_InjectionQueues[i];
 
-            // tell the system that one task of that group is 'finished', to ensure its dependencies will get scheduled
-            TaskHasFinished(it->m_pTask, it->m_pBelongsToGroup);
-            return EZ_SUCCESS;
-          }
+      if (queue.m_iNumTasks == 0)
+        continue;
 
-          ++it;
+      EZ_LOCK(queue.m_Mutex);
+
+      for (ezUInt32 t = queue.m_Tasks.GetCount(); t > 0; --t)
+      {
+        if (queue.m_Tasks[t - 1] == pTask.Borrow())
+        {
+          queue.m_Tasks.RemoveAtAndCopy(t - 1);
+          queue.m_iNumTasks.Decrement();
+          ++uiRemovedEntries;
         }
       }
     }
+
+    for (ezUInt32 i = 0; i < uiRemovedEntries; ++i)
+    {
+      ReleaseQueuedEntry(pTask.Borrow());
+    }
+  }
+
+  // tell the system that the canceled invocations are 'finished', to ensure the task's dependencies will get scheduled
+  // this is done outside the queue locks, since it may schedule other tasks
+  {
+    ezTaskGroup* pGroup = pTask->m_BelongsToGroup.m_pTaskGroup;
+
+    for (ezInt32 i = 0; i < iUnclaimedInvocations; ++i)
+    {
+      TaskHasFinished(pTask.Borrow(), pGroup);
+    }
+  }
+
+  if (iUnclaimedInvocations == (ezInt32)ezMath::Max(1u, pTask->m_uiMultiplicity))
+  {
+    // none of the invocations has started, so the task is finished now
+    // entries that are still in the deques of worker threads only hold a reference to the task, until those threads drop them
+    return EZ_SUCCESS;
   }
 
   // if we made it here, the task was already running
@@ -217,56 +426,50 @@ bool ezTaskSystem::HelpExecutingTasks(const ezTaskGroupID& WaitingForGroup)
 
 void ezTaskSystem::ReprioritizeFrameTasks()
 {
-  // There should usually be no 'this frame tasks' left at this time
-  // however, while we waited to enter the lock, such tasks might have appeared
-  // In this case we move them into the highest-priority 'this frame' queue, to ensure they will be executed asap
-  for (ezUInt32 i = (ezUInt32)ezTaskPriority::ThisFrame; i <= (ezUInt32)ezTaskPriority::LateThisFrame; ++i)
-  {
-    auto it = s_State->m_Tasks[i].GetIterator();
+  // Only the global queues can be reprioritized. QueueTask() never puts tasks for later frames into the worker threads' own deques.
 
-    // move all 'this frame' tasks into the 'early this frame' queue
-    while (it.IsValid())
-    {
-      s_State->m_Tasks[ezTaskPriority::EarlyThisFrame].PushBack(*it);
+  auto MoveTasks = [](ezUInt32 uiFrom, ezUInt32 uiTo) {
+    ezTaskInjectionQueue& from = s_State->m_InjectionQueues[uiFrom];
+    ezTaskInjectionQueue& to = s_State->m_InjectionQueues[uiTo];
+
+    if (from.m_iNumTasks == 0)
+      return;
+
+    // always lock the higher priority queue first
+    EZ_LOCK(to.m_Mutex);
+    EZ_LOCK(from.m_Mutex);
 
-      ++it;
+    for (ezTask* pTask : from.m_Tasks)
+    {
+      to.m_Tasks.PushBack(pTask);
     }
 
+    to.m_iNumTasks.Add(from.m_Tasks.GetCount());
+    from.m_iNumTasks = 0;
+
     // remove the tasks from their current queue
-    s_State->m_Tasks[i].Clear();
+    from.m_Tasks.Clear();
+  };
+
+  // There should usually be no 'this frame tasks' left at this time
+  // however, while we waited to enter the lock, such tasks might have appeared
+  // In this case we move them into the highest-priority 'this frame' queue, to ensure they will be executed asap
+  for (ezUInt32 i = (ezUInt32)ezTaskPriority::ThisFrame; i <= (ezUInt32)ezTaskPriority::LateThisFrame; ++i)
+  {
+    MoveTasks(i, ezTaskPriority::EarlyThisFrame);
   }
 
+  // move all 'next frame' tasks into the 'this frame' queues
   for (ezUInt32 i = (ezUInt32)ezTaskPriority::EarlyNextFrame; i <= (ezUInt32)ezTaskPriority::LateNextFrame; ++i)
   {
-    auto it = s_State->m_Tasks[i].GetIterator();
-
-    // move all 'next frame' tasks into the 'this frame' queues
-    while (it.IsValid())
-    {
-      s_State->m_Tasks[i - 3].PushBack(*it);
-
-      ++it;
-    }
-
-    // remove the tasks from their current queue
-    s_State->m_Tasks[i].Clear();
+    MoveTasks(i, i - 3);
   }
 
+  // move all 'in N frames' tasks into the 'in N-1 frames' queues
+  // moves 'In2Frames' into 'LateNextFrame'
   for (ezUInt32 i = (ezUInt32)ezTaskPriority::In2Frames; i <= (ezUInt32)ezTaskPriority::In9Frames; ++i)
   {
-    auto it = s_State->m_Tasks[i].GetIterator();
-
-    // move all 'in N frames' tasks into the 'in N-1 frames' queues
-    // moves 'In2Frames' into 'LateNextFrame'
-    while (it.IsValid())
-    {
-      s_State->m_Tasks[i - 1].PushBack(*it);
-
-      ++it;
-    }
-
-    // remove the tasks from their current queue
-    s_State->m_Tasks[i].Clear();
+    MoveTasks(i, i - 1);
   }
 }
 
@@ -373,10 +576,8 @@ void ezTaskSystem::FinishFrameTasks()
   // all the important tasks for this frame should be finished or worked on by now
   // so we can now re-prioritize the tasks for the next frame
   {
-    EZ_LOCK(s_TaskSystemMutex);
-
     // get this info once, it won't shrink (but might grow) while we are outside the lock
-    uiSomeFrameTasks = s_State->m_Tasks[ezTaskPriority::SomeFrameMainThread].GetCount();
+    uiSomeFrameTasks = s_State->m_InjectionQueues[ezTaskPriority::SomeFrameMainThread].m_iNumTasks;
 
     ReprioritizeFrameTasks();
   }
@@ -403,6 +604,8 @@ void ezTaskSystem::FinishFrameTasks()
           s_ThreadState->m_Workers[type][t]->UpdateThreadUtilization(tDiff);
         }
       }
+
+      UpdateUtilizationReport(tDiff);
     }
   }
 }
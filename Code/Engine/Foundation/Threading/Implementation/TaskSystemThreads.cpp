@@ -55,6 +55,8 @@ void ezTaskSystem::SetWorkerThreadCount(ezInt32 iShortTasks, ezInt32 iLongTasks)
   s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::LongTasks] = uiLongTasks;
   s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::FileAccess] = 1;
 
+  UpdateThreadPlacement();
+
   AllocateThreads(ezWorkerThreadType::ShortTasks, s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::ShortTasks]);
   AllocateThreads(ezWorkerThreadType::LongTasks, s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::LongTasks]);
   AllocateThreads(ezWorkerThreadType::FileAccess, s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::FileAccess]);
@@ -92,14 +94,30 @@ void ezTaskSystem::StopWorkerThreads()
 
     for (ezUInt32 i = 0; i < uiNumWorkers; ++i)
     {
-      s_ThreadState->m_Workers[type][i]->Join();
-      EZ_DEFAULT_DELETE(s_ThreadState->m_Workers[type][i]);
+      ezTaskWorkerThread* pWorker = s_ThreadState->m_Workers[type][i];
+      pWorker->Join();
+
+      // tasks that are still in the thread's own deques must not get lost, move them over to the global queues
+      for (ezUInt32 prio = 0; prio < ezTaskPriority::ENUM_COUNT; ++prio)
+      {
+        if (ezTaskWorkStealingDeque* pLocalQueue = pWorker->GetLocalQueue((ezTaskPriority::Enum)prio))
+        {
+          while (ezTask* pTask = pLocalQueue->Steal())
+          {
+            QueueTask(pTask, 1, (ezTaskPriority::Enum)prio, false, false);
+          }
+        }
+      }
+
+      EZ_DEFAULT_DELETE(pWorker);
     }
 
     s_ThreadState->m_iAllocatedWorkers[type] = 0;
     s_ThreadState->m_uiMaxWorkersToUse[type] = 0;
     s_ThreadState->m_Workers[type].Clear();
   }
+
+  s_ThreadState->m_iNumPinnedThreads = 0;
 }
 
 void ezTaskSystem::AllocateThreads(ezWorkerThreadType::Enum type, ezUInt32 uiAddThreads)
@@ -117,7 +135,8 @@ void ezTaskSystem::AllocateThreads(ezWorkerThreadType::Enum type, ezUInt32 uiAdd
 
     for (ezUInt32 i = 0; i < uiAddThreads; ++i)
     {
-      s_ThreadState->m_Workers[type][uiNextThreadIdx] = EZ_DEFAULT_NEW(ezTaskWorkerThread, (ezWorkerThreadType::Enum)type, uiNextThreadIdx);
+      s_ThreadState->m_Workers[type][uiNextThreadIdx] =
+        EZ_DEFAULT_NEW(ezTaskWorkerThread, (ezWorkerThreadType::Enum)type, uiNextThreadIdx, GetWorkerThreadAffinity(type, uiNextThreadIdx));
       s_ThreadState->m_Workers[type][uiNextThreadIdx]->Start();
 
       ++uiNextThreadIdx;
@@ -180,6 +199,16 @@ void ezTaskSystem::WakeUpThreads(ezWorkerThreadType::Enum type, ezUInt32 uiNumTh
   }
 }
 
+void ezTaskSystem::SetWorkStealingEnabled(bool bEnable)
+{
+  s_State->m_bWorkStealing = bEnable;
+}
+
+bool ezTaskSystem::IsWorkStealingEnabled()
+{
+  return s_State->m_bWorkStealing;
+}
+
 ezWorkerThreadType::Enum ezTaskSystem::GetCurrentThreadWorkerType()
 {
   return tl_TaskWorkerInfo.m_WorkerType;
@@ -190,9 +219,212 @@ double ezTaskSystem::GetThreadUtilization(ezWorkerThreadType::Enum Type, ezUInt3
   return s_ThreadState->m_Workers[Type][uiThreadIndex]->GetThreadUtilization(pNumTasksExecuted);
 }
 
+void ezTaskSystem::SetThreadPlacement(ezTaskThreadPlacement::Enum placement)
+{
+  if (s_ThreadState->m_ThreadPlacement == placement)
+    return;
+
+  s_ThreadState->m_ThreadPlacement = placement;
+
+  const ezUInt32 uiShortTasks = s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::ShortTasks];
+  const ezUInt32 uiLongTasks = s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::LongTasks];
+
+  // if no threads were created yet, the placement is applied once they are
+  if (uiShortTasks == 0)
+    return;
+
+  // threads can only pin themselves when they start, so restart all of them with the same configuration
+  StopWorkerThreads();
+  SetWorkerThreadCount(uiShortTasks, uiLongTasks);
+}
+
+ezTaskThreadPlacement::Enum ezTaskSystem::GetThreadPlacement()
+{
+  return s_ThreadState->m_ThreadPlacement;
+}
+
+void ezTaskSystem::UpdateThreadPlacement()
+{
+  auto* s = s_ThreadState.Borrow();
+
+  s->m_ShortTaskProcessors.Clear();
+  s->m_BackgroundProcessors.Clear();
+
+  if (s->m_ThreadPlacement == ezTaskThreadPlacement::Default)
+    return;
+
+  ezDynamicArray<ezCPULogicalProcessor> processors;
+  ezSystemInformation::GetCPUTopology(processors);
+
+  if (processors.IsEmpty())
+    return;
+
+  // the topology is sorted by NUMA node, so the nodes of the first and last processor differ on NUMA systems
+  const ezUInt32 uiFirstNode = processors[0].m_uiNumaNode;
+  const bool bMultipleNodes = processors.PeekBack().m_uiNumaNode != uiFirstNode;
+  const ezUInt32 uiNumCores = processors.PeekBack().m_uiPhysicalCore + 1;
+
+  bool bHasSMT = false;
+  for (const ezCPULogicalProcessor& proc : processors)
+  {
+    bHasSMT |= proc.m_uiSMTIndex > 0;
+  }
+
+  // Short task workers get the first logical processor of one physical core each. The first core is left to the main thread,
+  // unless that is the only one. Without SMT, the short task workers stay on the first NUMA node, to leave the others to the
+  // background threads.
+  const ezUInt32 uiNumShortTaskWorkers = s->m_uiMaxWorkersToUse[ezWorkerThreadType::ShortTasks];
+  ezUInt32 uiSkipCores = uiNumCores > 1 ? 1 : 0;
+
+  for (const ezCPULogicalProcessor& proc : processors)
+  {
+    if (proc.m_uiSMTIndex != 0)
+      continue;
+
+    if (!bHasSMT && bMultipleNodes && proc.m_uiNumaNode != uiFirstNode)
+      break;
+
+    if (uiSkipCores > 0)
+    {
+      --uiSkipCores;
+      continue;
+    }
+
+    if (s->m_ShortTaskProcessors.GetCount() < uiNumShortTaskWorkers)
+    {
+      s->m_ShortTaskProcessors.PushBack(proc.m_uiProcessorIndex);
+    }
+  }
+
+  // Long task and file access workers share the SMT siblings, or all other NUMA nodes, or whatever cores are left.
+  // If nothing is left, they stay unpinned.
+  for (const ezCPULogicalProcessor& proc : processors)
+  {
+    bool bBackground = false;
+
+    if (bHasSMT)
+      bBackground = proc.m_uiSMTIndex > 0;
+    else if (bMultipleNodes)
+      bBackground = proc.m_uiNumaNode != uiFirstNode;
+    else
+      bBackground = !s->m_ShortTaskProcessors.Contains(proc.m_uiProcessorIndex);
+
+    if (bBackground)
+    {
+      s->m_BackgroundProcessors.PushBack(proc.m_uiProcessorIndex);
+    }
+  }
+}
+
+ezArrayPtr<const ezUInt32> ezTaskSystem::GetWorkerThreadAffinity(ezWorkerThreadType::Enum type, ezUInt32 uiThreadIndex)
+{
+  const auto* s = s_ThreadState.Borrow();
+
+  if (type == ezWorkerThreadType::ShortTasks)
+  {
+    if (s->m_ShortTaskProcessors.IsEmpty())
+      return ezArrayPtr<const ezUInt32>();
+
+    // additional workers, that are allocated when others are blocked, share the cores of the regular workers
+    return ezArrayPtr<const ezUInt32>(&s->m_ShortTaskProcessors[uiThreadIndex % s->m_ShortTaskProcessors.GetCount()], 1);
+  }
+
+  return s->m_BackgroundProcessors;
+}
+
+void ezTaskSystem::GetUtilizationReport(ezTaskSystemUtilizationReport& out_Report)
+{
+  const auto* s = s_ThreadState.Borrow();
+
+  out_Report = s->m_UtilizationReport;
+  out_Report.m_ThreadPlacement = s->m_ThreadPlacement;
+  out_Report.m_uiNumPinnedThreads = s->m_iNumPinnedThreads;
+
+  if (out_Report.m_uiNumFrames == 0)
+    return;
+
+  const double fNumFrames = out_Report.m_uiNumFrames;
+  const double fAverage = s->m_fFrameTimeSum / fNumFrames;
+  const double fVariance = ezMath::Max(0.0, s->m_fFrameTimeSquaredSum / fNumFrames - fAverage * fAverage);
+
+  out_Report.m_AverageFrameTime = ezTime::Seconds(fAverage);
+  out_Report.m_FrameTimeStandardDeviation = ezTime::Seconds(ezMath::Sqrt(fVariance));
+
+  for (ezUInt32 type = 0; type < ezWorkerThreadType::ENUM_COUNT; ++type)
+  {
+    out_Report.m_fAverageUtilization[type] = s->m_fUtilizationSum[type] / fNumFrames;
+  }
+}
+
+void ezTaskSystem::ResetUtilizationReport()
+{
+  auto* s = s_ThreadState.Borrow();
+
+  s->m_UtilizationReport = ezTaskSystemUtilizationReport();
+  s->m_fFrameTimeSum = 0.0;
+  s->m_fFrameTimeSquaredSum = 0.0;
+
+  for (ezUInt32 type = 0; type < ezWorkerThreadType::ENUM_COUNT; ++type)
+  {
+    s->m_fUtilizationSum[type] = 0.0;
+  }
+}
+
+void ezTaskSystem::UpdateUtilizationReport(ezTime frameTime)
+{
+  auto* s = s_ThreadState.Borrow();
+  ezTaskSystemUtilizationReport& report = s->m_UtilizationReport;
+
+  if (report.m_uiNumFrames == 0)
+  {
+    report.m_MinFrameTime = frameTime;
+    report.m_MaxFrameTime = frameTime;
+  }
+  else
+  {
+    report.m_MinFrameTime = ezMath::Min(report.m_MinFrameTime, frameTime);
+    report.m_MaxFrameTime = ezMath::Max(report.m_MaxFrameTime, frameTime);
+  }
+
+  ++report.m_uiNumFrames;
+
+  const double fFrameTime = frameTime.GetSeconds();
+  s->m_fFrameTimeSum += fFrameTime;
+  s->m_fFrameTimeSquaredSum += fFrameTime * fFrameTime;
+
+  for (ezUInt32 type = 0; type < ezWorkerThreadType::ENUM_COUNT; ++type)
+  {
+    const ezUInt32 uiNumWorkers = s->m_iAllocatedWorkers[type];
+
+    if (uiNumWorkers == 0)
+      continue;
+
+    double fUtilization = 0.0;
+
+    for (ezUInt32 t = 0; t < uiNumWorkers; ++t)
+    {
+      ezUInt32 uiNumTasks = 0;
+      const double fThreadUtilization = s->m_Workers[type][t]->GetThreadUtilization(&uiNumTasks);
+
+      fUtilization += fThreadUtilization;
+      report.m_fPeakUtilization[type] = ezMath::Max(report.m_fPeakUtilization[type], fThreadUtilization);
+      report.m_uiNumTasksExecuted[type] += uiNumTasks;
+    }
+
+    // relative to the number of threads that are supposed to be active, additional threads only jump in while others are blocked
+    s->m_fUtilizationSum[type] += fUtilization / ezMath::Max(1u, s->m_uiMaxWorkersToUse[type]);
+  }
+}
+
 void ezTaskSystem::DetermineTasksToExecuteOnThread(ezTaskPriority::Enum& out_FirstPriority, ezTaskPriority::Enum& out_LastPriority)
 {
-  switch (tl_TaskWorkerInfo.m_WorkerType)
+  DeterminePriorityRange(tl_TaskWorkerInfo.m_WorkerType, out_FirstPriority, out_LastPriority);
+}
+
+void ezTaskSystem::DeterminePriorityRange(
+  ezWorkerThreadType::Enum ThreadType, ezTaskPriority::Enum& out_FirstPriority, ezTaskPriority::Enum& out_LastPriority)
+{
+  switch (ThreadType)
   {
     case ezWorkerThreadType::MainThread:
     {
@@ -238,5 +470,43 @@ void ezTaskSystem::DetermineTasksToExecuteOnThread(ezTaskPriority::Enum& out_Fir
   }
 }
 
+ezWorkerThreadType::Enum ezTaskSystem::GetWorkerTypeForPriority(ezTaskPriority::Enum Priority)
+{
+  switch (Priority)
+  {
+    case ezTaskPriority::EarlyThisFrame:
+    case ezTaskPriority::ThisFrame:
+    case ezTaskPriority::LateThisFrame:
+    case ezTaskPriority::EarlyNextFrame:
+    case ezTaskPriority::NextFrame:
+    case ezTaskPriority::LateNextFrame:
+    case ezTaskPriority::In2Frames:
+    case ezTaskPriority::In3Frames:
+    case ezTaskPriority::In4Frames:
+    case ezTaskPriority::In5Frames:
+    case ezTaskPriority::In6Frames:
+    case ezTaskPriority::In7Frames:
+    case ezTaskPriority::In8Frames:
+    case ezTaskPriority::In9Frames:
+      return ezWorkerThreadType::ShortTasks;
+
+    case ezTaskPriority::LongRunning:
+    case ezTaskPriority::LongRunningHighPriority:
+      return ezWorkerThreadType::LongTasks;
+
+    case ezTaskPriority::FileAccess:
+    case ezTaskPriority::FileAccessHighPriority:
+      return ezWorkerThreadType::FileAccess;
+
+    case ezTaskPriority::SomeFrameMainThread:
+    case ezTaskPriority::ThisFrameMainThread:
+      return ezWorkerThreadType::MainThread;
+
+    default:
+      EZ_ASSERT_NOT_IMPLEMENTED;
+      return ezWorkerThreadType::Unknown;
+  }
+}
+
 
 EZ_STATICLINK_FILE(Foundation, Foundation_Threading_Implementation_TaskSystemThreads);
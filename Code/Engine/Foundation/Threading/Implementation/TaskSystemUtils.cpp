@@ -73,9 +73,14 @@ void ezTaskSystem::WriteStateSnapshotToDGML(ezDGMLGraph& graph)
   szTaskPriorityNames[ezTaskPriority::ThisFrameMainThread] = "ThisFrameMainThread";
   szTaskPriorityNames[ezTaskPriority::SomeFrameMainThread] = "SomeFrameMainThread";
 
-  for (ezUInt32 g = 0; g < s_State->m_TaskGroups.GetCount(); ++g)
+  const ezUInt32 uiNumTaskGroups = s_State->m_iNumTaskGroupChunks * ezTaskSystemState::TaskGroupChunkSize;
+
+  for (ezUInt32 g = 0; g < uiNumTaskGroups; ++g)
   {
-    const ezTaskGroup& tg = s_State->m_TaskGroups[g];
+    const ezTaskGroup& tg = *s_State->GetTaskGroup(g);
+
+    // groups are not protected by the global lock, but their tasks only get cleared under this lock
+    EZ_LOCK(tg.m_CondVarGroupFinished);
 
     if (!tg.m_bInUse)
       continue;
@@ -107,14 +112,16 @@ void ezTaskSystem::WriteStateSnapshotToDGML(ezDGMLGraph& graph)
     }
   }
 
-  for (ezUInt32 g = 0; g < s_State->m_TaskGroups.GetCount(); ++g)
+  for (ezUInt32 g = 0; g < uiNumTaskGroups; ++g)
   {
-    const ezTaskGroup& tg = s_State->m_TaskGroups[g];
+    const ezTaskGroup& tg = *s_State->GetTaskGroup(g);
 
-    if (!tg.m_bInUse)
+    // only groups that were in use in the first pass have a node, the group may have finished since then
+    ezDGMLGraph::NodeId ownNodeId;
+    if (!groupNodeIds.TryGetValue(&tg, ownNodeId))
       continue;
 
-    const ezDGMLGraph::NodeId ownNodeId = groupNodeIds[&tg];
+    EZ_LOCK(tg.m_CondVarGroupFinished);
 
     for (const ezTaskGroupID& dependsOn : tg.m_DependsOnGroups)
     {
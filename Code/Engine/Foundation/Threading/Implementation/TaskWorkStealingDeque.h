@@ -0,0 +1,115 @@
+#pragma once
+
+#include <Foundation/Threading/AtomicUtils.h>
+
+class ezTask;
+
+/// \internal A fixed-capacity, lock-free work-stealing deque of task pointers (Chase-Lev).
+///
+/// Every task worker thread owns one deque per task priority that it works on.
+/// Only the owning thread may call PushBottom() and PopBottom(), all other threads may only call Steal().
+/// The owner thus works on the most recently queued (and most likely cache-hot) tasks first,
+/// while other threads take away the oldest tasks from the opposite end.
+///
+/// The deque never grows. If it is full, PushBottom() fails and the task has to be put into the global injection queue instead.
+/// This way no memory ever needs to be reclaimed while other threads might still read from it.
+class ezTaskWorkStealingDeque
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezTaskWorkStealingDeque);
+
+public:
+  enum
+  {
+    Capacity = 256, ///< Must be a power of two.
+    IndexMask = Capacity - 1,
+  };
+
+  ezTaskWorkStealingDeque() = default;
+
+  /// \brief Adds a task at the bottom of the deque. Returns false if the deque is full. May only be called by the owning thread.
+  bool PushBottom(ezTask* pTask);
+
+  /// \brief Removes the most recently pushed task. Returns nullptr if the deque is empty. May only be called by the owning thread.
+  ezTask* PopBottom();
+
+  /// \brief Removes the oldest task from the top of the deque. May be called by any thread.
+  ///
+  /// Returns nullptr if the deque is empty or if another thread won the race for the same task.
+  ezTask* Steal();
+
+  /// \brief Returns whether the deque is empty. The result is only a hint, as other threads may modify the deque concurrently.
+  bool IsEmpty() const { return m_iBottom <= m_iTop; }
+
+private:
+  // top and bottom are written by different threads, keep them on separate cache lines
+  volatile ezInt64 m_iTop = 0;
+  ezUInt8 m_Padding0[64 - sizeof(ezInt64)];
+  volatile ezInt64 m_iBottom = 0;
+  ezUInt8 m_Padding1[64 - sizeof(ezInt64)];
+
+  ezTask* volatile m_Tasks[Capacity];
+};
+
+EZ_FORCE_INLINE bool ezTaskWorkStealingDeque::PushBottom(ezTask* pTask)
+{
+  const ezInt64 b = m_iBottom;
+  const ezInt64 t = ezAtomicUtils::Read(m_iTop);
+
+  if (b - t >= Capacity)
+    return false;
+
+  m_Tasks[b & IndexMask] = pTask;
+
+  // publishes the new element to the thieves
+  ezAtomicUtils::Set(m_iBottom, b + 1);
+  return true;
+}
+
+EZ_FORCE_INLINE ezTask* ezTaskWorkStealingDeque::PopBottom()
+{
+  const ezInt64 b = m_iBottom - 1;
+
+  // this has to be a full memory barrier, the thieves must see the reserved slot before we read 'top'
+  ezAtomicUtils::Set(m_iBottom, b);
+
+  const ezInt64 t = ezAtomicUtils::Read(m_iTop);
+
+  if (t > b)
+  {
+    // was empty
+    ezAtomicUtils::Set(m_iBottom, b + 1);
+    return nullptr;
+  }
+
+  ezTask* pTask = m_Tasks[b & IndexMask];
+
+  if (t == b)
+  {
+    // this is the last element, race against the thieves for it
+    if (!ezAtomicUtils::TestAndSet(m_iTop, t, t + 1))
+    {
+      pTask = nullptr;
+    }
+
+    ezAtomicUtils::Set(m_iBottom, b + 1);
+  }
+
+  return pTask;
+}
+
+EZ_FORCE_INLINE ezTask* ezTaskWorkStealingDeque::Steal()
+{
+  const ezInt64 t = ezAtomicUtils::Read(m_iTop);
+  const ezInt64 b = ezAtomicUtils::Read(m_iBottom);
+
+  if (t >= b)
+    return nullptr;
+
+  // the slot can only be overwritten by the owner after 'top' has moved past it, in which case the CAS below fails
+  ezTask* pTask = m_Tasks[t & IndexMask];
+
+  if (!ezAtomicUtils::TestAndSet(m_iTop, t, t + 1))
+    return nullptr;
+
+  return pTask;
+}
@@ -13,14 +13,27 @@ static const char* GenerateThreadName(ezWorkerThreadType::Enum ThreadType, ezUIn
   return sTemp.GetData();
 }
 
-ezTaskWorkerThread::ezTaskWorkerThread(ezWorkerThreadType::Enum ThreadType, ezUInt32 uiThreadNumber)
+ezTaskWorkerThread::ezTaskWorkerThread(ezWorkerThreadType::Enum ThreadType, ezUInt32 uiThreadNumber, ezArrayPtr<const ezUInt32> affinityProcessors)
   : ezThread(GenerateThreadName(ThreadType, uiThreadNumber), 32 * 1024) /* 32 KB of stack size */
 {
   m_WorkerType = ThreadType;
   m_uiWorkerThreadNumber = uiThreadNumber & 0xFFFF;
+  m_AffinityProcessors = affinityProcessors;
+
+  // the file access thread works strictly sequentially, there is nothing to gain from stealing its tasks
+  if (m_WorkerType == ezWorkerThreadType::ShortTasks || m_WorkerType == ezWorkerThreadType::LongTasks)
+  {
+    ezTaskPriority::Enum LastPriority;
+    ezTaskSystem::DeterminePriorityRange(m_WorkerType, m_FirstLocalPriority, LastPriority);
+
+    m_LocalQueues = EZ_DEFAULT_NEW_ARRAY(ezTaskWorkStealingDeque, LastPriority - m_FirstLocalPriority + 1);
+  }
 }
 
-ezTaskWorkerThread::~ezTaskWorkerThread() = default;
+ezTaskWorkerThread::~ezTaskWorkerThread()
+{
+  EZ_DEFAULT_DELETE_ARRAY(m_LocalQueues);
+}
 
 ezResult ezTaskWorkerThread::DeactivateWorker()
 {
@@ -48,6 +61,12 @@ ezUInt32 ezTaskWorkerThread::Run()
   tl_TaskWorkerInfo.m_WorkerType = m_WorkerType;
   tl_TaskWorkerInfo.m_iWorkerIndex = m_uiWorkerThreadNumber;
   tl_TaskWorkerInfo.m_pWorkerState = &m_WorkerState;
+  tl_TaskWorkerInfo.m_pWorkerThread = this;
+
+  if (!m_AffinityProcessors.IsEmpty() && ezThreadUtils::SetCurrentThreadAffinity(m_AffinityProcessors).Succeeded())
+  {
+    ezTaskSystem::s_ThreadState->m_iNumPinnedThreads.Increment();
+  }
 
   const bool bIsReserve = m_uiWorkerThreadNumber >= ezTaskSystem::s_ThreadState->m_uiMaxWorkersToUse[m_WorkerType];
 
@@ -100,6 +119,14 @@ void ezTaskWorkerThread::WaitForWork()
   m_ThreadActiveTime += ezTime::Now() - m_StartedWorkingTime;
   m_bExecutingTask = false;
   m_WakeUpSignal.WaitForSignal();
+
+  // a wake-up signal may be left over from a WakeUpIfIdle() call that raced with this thread finding work on its own
+  // (see ezTaskSystem::GetNextTask()), in that case nobody actually woke us up and we go back to sleep
+  while (m_WorkerState == (int)ezTaskWorkerState::Idle)
+  {
+    m_WakeUpSignal.WaitForSignal();
+  }
+
   EZ_ASSERT_DEBUG(m_WorkerState == (int)ezTaskWorkerState::Active, "Worker state should have been reset to 'active'");
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/Threading/Implementation/TaskSystemDeclarations.h>
+#include <Foundation/Threading/Implementation/TaskWorkStealingDeque.h>
 
 #include <Foundation/Threading/Thread.h>
 #include <Foundation/Threading/ThreadSignal.h>
@@ -14,8 +15,8 @@ class ezTaskWorkerThread final : public ezThread
   ///@{
 
 public:
-  /// \brief Tells the worker thread what tasks to execute and which thread index it has.
-  ezTaskWorkerThread(ezWorkerThreadType::Enum ThreadType, ezUInt32 uiThreadNumber);
+  /// \brief Tells the worker thread what tasks to execute, which thread index it has and on which logical processors it may run.
+  ezTaskWorkerThread(ezWorkerThreadType::Enum ThreadType, ezUInt32 uiThreadNumber, ezArrayPtr<const ezUInt32> affinityProcessors);
   ~ezTaskWorkerThread();
 
   /// \brief Deactivates the thread. Returns failure, if the thread is currently still running.
@@ -31,6 +32,28 @@ private:
   // For display purposes.
   ezUInt16 m_uiWorkerThreadNumber = 0xFFFF;
 
+  // The logical processors that the thread pins itself to when it starts. Empty, if the thread is not pinned.
+  ezHybridArray<ezUInt32, 1> m_AffinityProcessors;
+
+  ///@}
+
+  /// \name Work Stealing
+  ///@{
+
+public:
+  /// \brief Returns this thread's own deque for tasks of the given priority, or nullptr if the thread does not have one.
+  ///
+  /// Only short and long task workers own deques, and only for the priorities that they work on.
+  ezTaskWorkStealingDeque* GetLocalQueue(ezTaskPriority::Enum priority)
+  {
+    const ezUInt32 uiIndex = static_cast<ezUInt32>(priority) - static_cast<ezUInt32>(m_FirstLocalPriority);
+    return uiIndex < m_LocalQueues.GetCount() ? &m_LocalQueues[uiIndex] : nullptr;
+  }
+
+private:
+  ezTaskPriority::Enum m_FirstLocalPriority = ezTaskPriority::EarlyThisFrame;
+  ezArrayPtr<ezTaskWorkStealingDeque> m_LocalQueues;
+
   ///@}
 
   /// \name Thread Utilization
@@ -85,6 +108,7 @@ struct ezTaskWorkerInfo
   bool m_bAllowNestedTasks = true;
   const char* m_szTaskName = nullptr;
   ezAtomicInteger32* m_pWorkerState = nullptr;
+  ezTaskWorkerThread* m_pWorkerThread = nullptr;
 };
 
 extern thread_local ezTaskWorkerInfo tl_TaskWorkerInfo;
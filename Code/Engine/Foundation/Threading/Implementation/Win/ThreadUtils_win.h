@@ -37,3 +37,24 @@ bool ezThreadUtils::IsMainThread()
 {
   return GetCurrentThreadID() == g_uiMainThreadID;
 }
+
+ezResult ezThreadUtils::SetCurrentThreadAffinity(ezArrayPtr<const ezUInt32> processors)
+{
+#if EZ_ENABLED(EZ_PLATFORM_WINDOWS_DESKTOP)
+  // only processors of the current processor group (up to 64) can be addressed this way
+  DWORD_PTR uiMask = 0;
+
+  for (ezUInt32 uiProcessor : processors)
+  {
+    if (uiProcessor < sizeof(DWORD_PTR) * 8)
+      uiMask |= static_cast<DWORD_PTR>(1) << uiProcessor;
+  }
+
+  if (uiMask == 0)
+    return EZ_FAILURE;
+
+  return SetThreadAffinityMask(GetCurrentThread(), uiMask) != 0 ? EZ_SUCCESS : EZ_FAILURE;
+#else
+  return EZ_FAILURE;
+#endif
+}
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <Foundation/Threading/TaskSystem.h>
+
+#if EZ_ENABLED(EZ_SUPPORTS_COROUTINES)
+
+#  include <coroutine>
+
+/// \brief The return type for C++20 coroutines that run on the task system.
+///
+/// A coroutine starts executing right away on the calling thread, until it suspends for the first time.
+/// Through the awaitables ezTaskGroupAwaiter and ezCoroutineResumeOn it then continues on a worker thread for a chosen ezTaskPriority,
+/// which makes it possible to write code that hops between threads without splitting it up into many small tasks and callbacks:
+/// \code{.cpp}
+///   ezTaskCoroutine LoadLevel(ezString sFile)
+///   {
+///     co_await ezCoroutineResumeOn(ezTaskPriority::FileAccess);
+///     ReadFile(sFile); // executed on the file access thread
+///
+///     co_await ezTaskSystem::StartSingleTask(pParseTask, ezTaskPriority::LongRunning); // suspends until the task group is finished
+///
+///     co_await ezCoroutineResumeOn(ezTaskPriority::ThisFrameMainThread);
+///     CreateObjects(); // executed on the main thread
+///   }
+/// \endcode
+///
+/// Coroutine frames are allocated from ezTaskSystem::GetCoroutineAllocator(), which pools them by size, so starting coroutines
+/// frequently does not go through the general purpose heap.
+///
+/// The ezTaskCoroutine object owns the coroutine frame. Destroying it while the coroutine is still running detaches the coroutine,
+/// in which case it runs to completion and then frees its own frame. Another coroutine can co_await an ezTaskCoroutine to continue once
+/// it is finished, a regular function can use Wait() instead.
+class EZ_FOUNDATION_DLL ezTaskCoroutine
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezTaskCoroutine);
+
+public:
+  class promise_type;
+  using Handle = std::coroutine_handle<promise_type>;
+
+  /// \internal The states of a coroutine, stored in its promise.
+  enum State : ezInt32
+  {
+    Running,  ///< Executing or suspended.
+    Awaited,  ///< Executing or suspended, another coroutine continues once this one is finished.
+    Finished, ///< Done, the frame stays alive until the ezTaskCoroutine is destroyed.
+    Detached, ///< The ezTaskCoroutine was destroyed, the frame is freed once the coroutine is finished.
+  };
+
+  class promise_type
+  {
+  public:
+    static void* operator new(size_t uiSize) { return ezTaskSystem::GetCoroutineAllocator()->Allocate(uiSize, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+    static void operator delete(void* ptr) { ezTaskSystem::GetCoroutineAllocator()->Deallocate(ptr); }
+
+    ezTaskCoroutine get_return_object() { return ezTaskCoroutine(Handle::from_promise(*this)); }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    auto final_suspend() noexcept { return FinalAwaiter(); }
+    void return_void() {}
+    void unhandled_exception() { EZ_REPORT_FAILURE("Unhandled exception in a task coroutine."); }
+
+  private:
+    friend class ezTaskCoroutine;
+
+    struct FinalAwaiter
+    {
+      bool await_ready() const noexcept { return false; }
+      std::coroutine_handle<> await_suspend(Handle h) noexcept;
+      void await_resume() const noexcept {}
+    };
+
+    ezAtomicInteger32 m_iState; // ezTaskCoroutine::State
+    std::coroutine_handle<> m_Continuation;
+  };
+
+  /// \brief Suspends the awaiting coroutine until this coroutine is finished. Only one coroutine may await it.
+  class Awaiter
+  {
+  public:
+    explicit Awaiter(Handle h)
+      : m_Handle(h)
+    {
+    }
+
+    bool await_ready() const noexcept { return m_Handle.promise().m_iState == Finished; }
+    bool await_suspend(std::coroutine_handle<> continuation) noexcept;
+    void await_resume() const noexcept {}
+
+  private:
+    Handle m_Handle;
+  };
+
+  ezTaskCoroutine() = default;
+  ezTaskCoroutine(ezTaskCoroutine&& other);
+  ~ezTaskCoroutine();
+
+  void operator=(ezTaskCoroutine&& other);
+
+  /// \brief Whether this object refers to a coroutine at all.
+  bool IsValid() const { return static_cast<bool>(m_Handle); } // [tested]
+
+  /// \brief Returns whether the coroutine has run to completion.
+  bool IsFinished() const; // [tested]
+
+  /// \brief Blocks until the coroutine is finished. Like ezTaskSystem::WaitForCondition() this helps executing tasks in the mean time.
+  void Wait(); // [tested]
+
+  /// \brief Allows another coroutine to 'co_await' this one.
+  Awaiter operator co_await() const noexcept { return Awaiter(m_Handle); } // [tested]
+
+private:
+  explicit ezTaskCoroutine(Handle h);
+
+  void Release();
+
+  Handle m_Handle;
+};
+
+/// \brief Suspends a coroutine until the given task group is finished. Then the coroutine is resumed from a task with the given priority.
+///
+/// If the group is already finished, the coroutine simply continues on the current thread.
+class ezTaskGroupAwaiter
+{
+public:
+  explicit ezTaskGroupAwaiter(ezTaskGroupID group, ezTaskPriority::Enum resumePriority = ezTaskPriority::ThisFrame)
+    : m_Group(group)
+    , m_ResumePriority(resumePriority)
+  {
+  }
+
+  bool await_ready() const { return ezTaskSystem::IsTaskGroupFinished(m_Group); }
+  void await_suspend(std::coroutine_handle<> h) const { ezTaskSystem::ResumeCoroutine(h.address(), m_ResumePriority, m_Group); }
+  void await_resume() const {}
+
+private:
+  ezTaskGroupID m_Group;
+  ezTaskPriority::Enum m_ResumePriority;
+};
+
+/// \brief Allows to 'co_await' a task group directly, e.g. the result of ezTaskSystem::StartSingleTask().
+///
+/// The coroutine is resumed with priority ezTaskPriority::ThisFrame. Use ezTaskGroupAwaiter to choose a different priority.
+inline ezTaskGroupAwaiter operator co_await(ezTaskGroupID group)
+{
+  return ezTaskGroupAwaiter(group);
+}
+
+/// \brief Suspends a coroutine and resumes it from a task with the given priority.
+///
+/// This moves the rest of the coroutine onto another thread, e.g. ezTaskPriority::FileAccess to do blocking file operations,
+/// or one of the main thread priorities to continue with work that has to be done on the main thread.
+class ezCoroutineResumeOn
+{
+public:
+  explicit ezCoroutineResumeOn(ezTaskPriority::Enum priority)
+    : m_Priority(priority)
+  {
+  }
+
+  bool await_ready() const { return false; }
+  void await_suspend(std::coroutine_handle<> h) const { ezTaskSystem::ResumeCoroutine(h.address(), m_Priority, ezTaskGroupID()); }
+  void await_resume() const {}
+
+private:
+  ezTaskPriority::Enum m_Priority;
+};
+
+inline std::coroutine_handle<> ezTaskCoroutine::promise_type::FinalAwaiter::await_suspend(Handle h) noexcept
+{
+  promise_type& promise = h.promise();
+
+  // once the state is 'Finished', the owner may destroy the frame at any time, so it must not be accessed anymore,
+  // unless the coroutine is detached or awaited, in which case nobody else can destroy it
+  switch (promise.m_iState.Set(Finished))
+  {
+    case Awaited:
+      return promise.m_Continuation;
+
+    case Detached:
+      h.destroy();
+      break;
+
+    default:
+      break;
+  }
+
+  return std::noop_coroutine();
+}
+
+inline bool ezTaskCoroutine::Awaiter::await_suspend(std::coroutine_handle<> continuation) noexcept
+{
+  promise_type& promise = m_Handle.promise();
+  promise.m_Continuation = continuation;
+
+  // fails if the coroutine finished in the mean time, then the awaiting coroutine just continues
+  const ezInt32 iPrevState = promise.m_iState.CompareAndSwap(Running, Awaited);
+  EZ_ASSERT_DEV(iPrevState != Awaited, "A task coroutine can only be awaited by one other coroutine.");
+  return iPrevState == Running;
+}
+
+#endif
@@ -76,9 +76,8 @@ public:
 
   struct TaskData
   {
-    ezSharedPtr<ezTask> m_pTask;
+    ezTask* m_pTask = nullptr;
     ezTaskGroup* m_pBelongsToGroup = nullptr;
-    ezUInt32 m_uiInvocation = 0;
   };
 
 private:
@@ -90,8 +89,23 @@ private:
   static bool ExecuteTask(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
     const ezTaskGroupID& WaitingForGroup, ezAtomicInteger32* pWorkerState);
 
+  /// \brief Takes one task of the given priority from the thread's own deque, the global injection queue or another worker's deque (in that
+  /// order). Returns nullptr if there is no task that the calling thread may execute.
+  static ezTask* DequeueTask(ezTaskPriority::Enum Priority, bool bOnlyTasksThatNeverWait, const ezTaskGroupID& WaitingForGroup);
+
+  /// \brief Queues \a uiCount invocations of \a pTask for execution.
+  ///
+  /// If \a bAllowLocalQueue is set and the calling thread is a worker that owns a deque for \a Priority, the task is put there,
+  /// otherwise it ends up in the global injection queue. High priority tasks and tasks for later frames always go into the global queue,
+  /// since only there they can be put in front of the other tasks or get reprioritized.
+  static void QueueTask(ezTask* pTask, ezUInt32 uiCount, ezTaskPriority::Enum Priority, bool bHighPriority, bool bAllowLocalQueue);
+
+  /// \brief Called for every queue entry of a group task that got dequeued, whether it was executed or not.
+  /// Releases the reference that keeps the task alive once all of its entries are gone.
+  static void ReleaseQueuedEntry(ezTask* pTask);
+
   /// \brief Called whenever a task has been finished/canceled. Makes sure that groups are marked as finished when all tasks are done.
-  static void TaskHasFinished(const ezSharedPtr<ezTask>& pTask, ezTaskGroup* pGroup);
+  static void TaskHasFinished(ezTask* pTask, ezTaskGroup* pGroup);
 
   /// \brief Moves all 'next frame' tasks into the 'this frame' queues.
   static void ReprioritizeFrameTasks();
@@ -105,6 +119,40 @@ private:
 
   ///@}
 
+  /// \name Fork-Join
+  ///@{
+
+private:
+  friend class ezForkJoinScope;
+
+  /// \brief Queues a fork-join task without any task group. See ezForkJoinScope.
+  static void SpawnForkJoinTask(ezForkJoinTaskBase* pTask, ezTaskPriority::Enum Priority);
+
+  /// \brief Called instead of TaskHasFinished() for tasks that do not belong to any group.
+  static void ForkJoinTaskHasFinished(ezForkJoinTaskBase* pTask);
+
+  ///@}
+
+#if EZ_ENABLED(EZ_SUPPORTS_COROUTINES)
+  /// \name Coroutines
+  ///@{
+
+public:
+  /// \brief Returns the pool allocator from which coroutine frames (see ezTaskCoroutine) and the tasks that resume them are allocated.
+  static ezAllocatorBase* GetCoroutineAllocator();
+
+private:
+  friend class ezTaskGroupAwaiter;
+  friend class ezCoroutineResumeOn;
+
+  /// \brief Resumes the suspended coroutine from a task with the given priority, once the Dependency group is finished.
+  ///
+  /// The coroutine is passed as the address of its std::coroutine_handle, so that this header does not need to include <coroutine>.
+  static void ResumeCoroutine(void* pCoroutineAddress, ezTaskPriority::Enum Priority, ezTaskGroupID Dependency);
+
+  ///@}
+#endif
+
   /// \name Managing Task Groups
   ///@{
 
@@ -176,6 +224,12 @@ private:
   /// \brief Is called whenever a dependency of pGroup has finished. Once all dependencies are finished, the group's tasks will get scheduled.
   static void DependencyHasFinished(ezTaskGroup* pGroup);
 
+  /// \brief Pops an unused task group from the lock-free free list. Allocates a new chunk of groups, if there is none left.
+  static ezTaskGroup* AllocateTaskGroup();
+
+  /// \brief Pushes a finished task group back onto the free list, from where it may get reused immediately.
+  static void ReleaseTaskGroup(ezTaskGroup* pGroup);
+
   ///@}
 
   /// \name Thread Management
@@ -208,15 +262,53 @@ public:
   /// \brief Returns the (thread local) type of tasks that would be executed on this thread
   static ezWorkerThreadType::Enum GetCurrentThreadWorkerType();
 
+  /// \brief Enables or disables putting tasks into the per-thread work-stealing deques.
+  ///
+  /// When enabled (the default), tasks that are scheduled from a worker thread are put into that thread's own deque, from where
+  /// they are executed in LIFO order by the same thread, or stolen by idle threads. This avoids contention on the global task queues
+  /// and keeps the data of recently spawned tasks in the cache.
+  /// When disabled, all tasks go through the global queues, which gives strict FIFO order within each priority.
+  static void SetWorkStealingEnabled(bool bEnable);
+
+  /// \brief Returns whether tasks scheduled from worker threads are put into per-thread deques. See SetWorkStealingEnabled().
+  static bool IsWorkStealingEnabled();
+
   /// \brief Returns the utilization (0.0 to 1.0) of the given thread. Note: This will only be valid, if FinishFrameTasks() is called once
   /// per frame.
   ///
   /// Also optionally returns the number of tasks that were finished during the last frame.
   static double GetThreadUtilization(ezWorkerThreadType::Enum Type, ezUInt32 uiThreadIndex, ezUInt32* pNumTasksExecuted = nullptr);
 
+  /// \brief Configures how the worker threads are placed onto the CPU cores. See ezTaskThreadPlacement.
+  ///
+  /// The placement is applied when the worker threads get created, therefore changing it restarts all worker threads.
+  /// Pinning threads is currently supported on Linux and Windows desktop, on other platforms the threads are left unpinned.
+  /// Use GetUtilizationReport() to compare the frame time variance with different placements.
+  static void SetThreadPlacement(ezTaskThreadPlacement::Enum placement); // [tested]
+
+  /// \brief Returns the placement that was set through SetThreadPlacement().
+  static ezTaskThreadPlacement::Enum GetThreadPlacement();
+
+  /// \brief Returns statistics about the frame times and the worker thread utilization.
+  ///
+  /// The statistics are gathered by FinishFrameTasks(), since the last call to ResetUtilizationReport().
+  static void GetUtilizationReport(ezTaskSystemUtilizationReport& out_Report); // [tested]
+
+  /// \brief Clears all statistics that are returned by GetUtilizationReport().
+  static void ResetUtilizationReport(); // [tested]
+
 private:
   friend class ezTaskWorkerThread;
 
+  /// \brief Determines which logical processors the worker threads get pinned to, for the current placement and number of workers.
+  static void UpdateThreadPlacement();
+
+  /// \brief Returns the logical processors that a new worker thread should be pinned to. Empty, if it should not be pinned.
+  static ezArrayPtr<const ezUInt32> GetWorkerThreadAffinity(ezWorkerThreadType::Enum type, ezUInt32 uiThreadIndex);
+
+  /// \brief Called by FinishFrameTasks() to accumulate the statistics for GetUtilizationReport().
+  static void UpdateUtilizationReport(ezTime frameTime);
+
   /// \brief Allocates \a uiAddThreads additional threads of \a type
   static void AllocateThreads(ezWorkerThreadType::Enum type, ezUInt32 uiAddThreads);
 
@@ -229,6 +321,13 @@ private:
   /// \brief Uses a thread local variable to know the current thread type and to decide the range of task priorities that it may execute
   static void DetermineTasksToExecuteOnThread(ezTaskPriority::Enum& out_FirstPriority, ezTaskPriority::Enum& out_LastPriority);
 
+  /// \brief Returns the range of task priorities that threads of the given type execute.
+  static void DeterminePriorityRange(
+    ezWorkerThreadType::Enum ThreadType, ezTaskPriority::Enum& out_FirstPriority, ezTaskPriority::Enum& out_LastPriority);
+
+  /// \brief Returns which type of worker thread executes tasks of the given priority.
+  static ezWorkerThreadType::Enum GetWorkerTypeForPriority(ezTaskPriority::Enum Priority);
+
 private:
   static ezUniquePtr<ezTaskSystemThreadState> s_ThreadState;
 
@@ -239,6 +338,7 @@ private:
 
 public:
   /// A helper function to process task items in a parallel fashion by having per-worker index ranges generated.
+  /// See ezParallelForParams::bAdaptive for partitioning the items according to their measured cost, instead of a fixed bin size.
   static void ParallelForIndexed(ezUInt32 uiStartIndex, ezUInt32 uiNumItems, ezParallelForIndexedFunction taskCallback,
     const char* taskName = nullptr, const ezParallelForParams& config = ezParallelForParams());
 
@@ -267,6 +367,9 @@ public:
     ezArrayPtr<ElemType> taskItems, Callback taskCallback, const char* taskName = nullptr, const ezParallelForParams& params = ezParallelForParams());
 
 private:
+  static void ParallelForIndexedAdaptive(
+    ezUInt32 uiStartIndex, ezUInt32 uiNumItems, ezParallelForIndexedFunction taskCallback, const char* taskName, const ezParallelForParams& params);
+
   template <typename ElemType>
   static void ParallelForInternal(
     ezArrayPtr<ElemType> taskItems, ezParallelForFunction<ElemType> taskCallback, const char* taskName, const ezParallelForParams& config);
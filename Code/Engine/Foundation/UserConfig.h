@@ -79,4 +79,9 @@
 //#undef EZ_USE_GUARDED_ALLOCATIONS
 //#define EZ_USE_GUARDED_ALLOCATIONS EZ_ON
 
+// Uncomment to use the scalable heap with per-thread heaps as the default allocator. Applications can also select it at runtime
+// through ezFoundation::SetDefaultHeapType().
+//#undef EZ_USE_SCALABLE_HEAP
+//#define EZ_USE_SCALABLE_HEAP EZ_ON
+
 #endif
@@ -64,5 +64,6 @@ private:
   ezDebugRendererContext m_ViewDebugContext;
 
   ezHybridArray<DataPerCategory, 16> m_DataPerCategory;
+  ezDynamicArray<ezRenderDataBatch::SortableRenderData> m_SortScratch;
   ezHybridArray<const ezRenderData*, 16> m_FrameData;
 };
@@ -19,6 +19,9 @@ void ezExtractedRenderData::AddFrameData(const ezRenderData* pFrameData)
   m_FrameData.PushBack(pFrameData);
 }
 
+// below this the radix sort passes are more expensive than the comparisons of a quick sort
+static constexpr ezUInt32 s_uiRadixSortThreshold = 2048;
+
 void ezExtractedRenderData::SortAndBatch()
 {
   EZ_PROFILE_SCOPE("SortAndBatch");
@@ -44,7 +47,19 @@ void ezExtractedRenderData::SortAndBatch()
     auto& data = dataPerCategory.m_SortableRenderData;
 
     // Sort
-    data.Sort(RenderDataComparer());
+    if (data.GetCount() < s_uiRadixSortThreshold)
+    {
+      data.Sort(RenderDataComparer());
+    }
+    else
+    {
+      // Two stable radix sorts yield the same order as the comparer: by sorting key first and by batch id for equal keys.
+      m_SortScratch.SetCountUninitialized(data.GetCount());
+
+      ezSorting::RadixSort(data.GetArrayPtr(), m_SortScratch.GetArrayPtr(),
+        [](const ezRenderDataBatch::SortableRenderData& d) { return d.m_pRenderData->m_uiBatchId; });
+      ezSorting::RadixSort(data.GetArrayPtr(), m_SortScratch.GetArrayPtr(), [](const ezRenderDataBatch::SortableRenderData& d) { return d.m_uiSortingKey; });
+    }
 
     // Find batches
     ezUInt32 uiCurrentBatchId = data[0].m_pRenderData->m_uiBatchId;
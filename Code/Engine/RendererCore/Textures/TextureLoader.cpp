@@ -119,8 +119,18 @@ ezResourceLoadData ezTextureResourceLoader::OpenDataStream(const ezResource* pRe
     if (sAbsolutePath.HasExtension("ezTexture2D") || sAbsolutePath.HasExtension("ezTexture3D") || sAbsolutePath.HasExtension("ezTextureCube") ||
         sAbsolutePath.HasExtension("ezRenderTarget") || sAbsolutePath.HasExtension("ezLUT"))
     {
-      if (LoadTexFile(File, *pData).Failed())
+      // parse directly from the file content, if the data directory can map it into memory, instead of reading it through the file cache
+      ezArrayPtr<const ezUInt8> content;
+      if (File.MapFileContent(content).Succeeded())
+      {
+        ezRawMemoryStreamReader reader(content.GetPtr(), content.GetCount());
+        if (LoadTexFile(reader, *pData).Failed())
+          return res;
+      }
+      else if (LoadTexFile(File, *pData).Failed())
+      {
         return res;
+      }
     }
     else
     {
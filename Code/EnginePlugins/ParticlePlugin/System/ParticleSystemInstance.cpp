@@ -339,6 +339,9 @@ void ezParticleSystemInstance::ReinitializeStreamProcessors(const ezParticleSyst
 ezParticleSystemInstance::ezParticleSystemInstance()
 {
   m_BoundingVolume = ezBoundingSphere(ezVec3::ZeroVector(), 0.25f);
+
+  // many particles may die in the same frame, the death handlers only read the data of the removed particles
+  m_StreamGroup.SetBatchedElementRemoval(true);
 }
 
 void ezParticleSystemInstance::Construct(
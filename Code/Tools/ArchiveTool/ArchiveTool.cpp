@@ -18,6 +18,10 @@ Options to be specific:
 -pack "path/to/folder" "path/to/another/folder" ...
 -unpack "path/to/file.ezArchive" "another/file.ezArchive"
 -out "path/to/file/or/folder"
+-blocksize 256
+-dictionary 110
+
+When packing, files are compressed on all CPU cores. Files with identical content are only stored once.
 
 -pack and -unpack can take multiple inputs to either aggregate multiple folders into one archive (pack)
 or to unpack multiple archives at the same time.
@@ -28,6 +32,16 @@ For unpacking the target should be a folder (may or may not exist) into which th
 
 If no -out is specified, it is determined to be where the input file is located.
 
+-blocksize only affects packing. If given, compressed files that are larger than the given number of KB are split into
+independently compressed blocks of that size. Such files can be read partially without decompressing everything before
+the requested data, and large files are decompressed on multiple threads. Smaller blocks compress slightly worse.
+The block size must not be larger than 65536 KB (64 MB).
+
+-dictionary only affects packing. If given, a zstd dictionary of up to the given number of KB is trained from the small files
+and stored in the archive. All compressed files that are not split into blocks are compressed with it. This improves the
+compression of many small files of the same kind (materials, prefabs, ...) considerably, because they share a lot of content.
+The dictionary size must not be larger than 16384 KB (16 MB).
+
 If neither -pack nor -unpack is specified, the mode is detected automatically from the list of inputs.
 If all inputs are folders, mode is going to be 'pack'.
 If all inputs are files, mode is going to be 'unpack'.
@@ -40,6 +54,12 @@ ezArchiveTool.exe "C:\Stuff"
 ezArchiveTool.exe "C:\Stuff" -out "C:\MyStuff.ezArchive"
   will pack all data in "C:\Stuff" into "C:\MyStuff.ezArchive"
 
+ezArchiveTool.exe "C:\Stuff" -blocksize 256
+  will pack all data in "C:\Stuff" into "C:\Stuff.ezArchive" and compress large files in blocks of 256 KB
+
+ezArchiveTool.exe "C:\Stuff" -dictionary 110
+  will pack all data in "C:\Stuff" into "C:\Stuff.ezArchive" and compress the files with a dictionary of up to 110 KB
+
 ezArchiveTool.exe "C:\Stuff.ezArchive"
   will unpack all data from the archive into "C:\Stuff"
 
@@ -96,10 +116,18 @@ public:
     Unpack,
   };
 
+  enum : ezUInt32
+  {
+    MaxBlockSizeKB = 64 * 1024,      ///< Larger values would overflow the block size in bytes, and such blocks would be pointless anyway.
+    MaxDictionarySizeKB = 16 * 1024, ///< The dictionary is kept in memory while the archive is mounted, typical ones are around 100 KB.
+  };
+
   ArchiveMode m_Mode = ArchiveMode::Auto;
 
   ezDynamicArray<ezString> m_sInputs;
   ezString m_sOutput;
+  ezUInt32 m_uiBlockSizeKB = 0;
+  ezUInt32 m_uiDictionarySizeKB = 0;
 
   ezArchiveTool()
     : ezApplication("ArchiveTool")
@@ -117,6 +145,20 @@ public:
     ezCommandLineUtils& cmd = *ezCommandLineUtils::GetGlobalInstance();
 
     m_sOutput = cmd.GetStringOption("-out");
+    m_uiBlockSizeKB = cmd.GetUIntOption("-blocksize", 0);
+    m_uiDictionarySizeKB = cmd.GetUIntOption("-dictionary", 0);
+
+    if (m_uiBlockSizeKB > MaxBlockSizeKB)
+    {
+      ezLog::Error("-blocksize must not be larger than {} KB", (ezUInt32)MaxBlockSizeKB);
+      return EZ_FAILURE;
+    }
+
+    if (m_uiDictionarySizeKB > MaxDictionarySizeKB)
+    {
+      ezLog::Error("-dictionary must not be larger than {} KB", (ezUInt32)MaxDictionarySizeKB);
+      return EZ_FAILURE;
+    }
 
     ezStringBuilder path;
 
@@ -173,7 +215,8 @@ public:
       {
         const char* szArg = GetArgument(a);
 
-        if (ezStringUtils::IsEqual_NoCase(szArg, "-out"))
+        if (ezStringUtils::IsEqual_NoCase(szArg, "-out") || ezStringUtils::IsEqual_NoCase(szArg, "-blocksize") ||
+            ezStringUtils::IsEqual_NoCase(szArg, "-dictionary"))
           break;
 
         m_sInputs.PushBack(ezOSFile::MakePathAbsoluteWithCWD(szArg));
@@ -210,6 +253,16 @@ public:
 
     ezLog::Info("Output: '{}'", m_sOutput);
 
+    if (m_uiBlockSizeKB > 0)
+    {
+      ezLog::Info("Block size: {} KB", m_uiBlockSizeKB);
+    }
+
+    if (m_uiDictionarySizeKB > 0)
+    {
+      ezLog::Info("Max dictionary size: {} KB", m_uiDictionarySizeKB);
+    }
+
     return EZ_SUCCESS;
   }
 
@@ -250,6 +303,8 @@ public:
   ezResult Pack()
   {
     ezArchiveBuilderImpl archive;
+    archive.m_uiZstdBlockSize = m_uiBlockSizeKB * 1024;
+    archive.m_uiZstdDictionarySize = m_uiDictionarySizeKB * 1024;
 
     for (const auto& folder : m_sInputs)
     {
@@ -267,13 +322,26 @@ public:
     m_sOutput = ezOSFile::MakePathAbsoluteWithCWD(m_sOutput);
 
     ezLog::Info("Writing archive to '{}'", m_sOutput);
-    if (archive.WriteArchive(m_sOutput).Failed())
+
+    ezArchiveBuilder::Statistics stats;
+    if (archive.WriteArchive(m_sOutput, &stats).Failed())
     {
       ezLog::Error("Failed to write the ezArchive");
 
       return EZ_FAILURE;
     }
 
+    ezLog::Info("Packed {} files ({}) into {} of file data", stats.m_uiNumEntries, ezArgFileSize(stats.m_uiUncompressedBytes), ezArgFileSize(stats.m_uiStoredBytes));
+    ezLog::Info("Deduplication: {} files had identical content and share their data, saving {}", stats.m_uiNumDeduplicatedEntries, ezArgFileSize(stats.m_uiDeduplicatedBytes));
+
+    if (m_uiDictionarySizeKB > 0)
+    {
+      if (stats.m_uiZstdDictionarySize > 0)
+        ezLog::Info("Dictionary: {} trained from {} files", ezArgFileSize(stats.m_uiZstdDictionarySize), stats.m_uiNumZstdDictionarySamples);
+      else
+        ezLog::Warning("No dictionary was stored, the {} sample files have too little in common", stats.m_uiNumZstdDictionarySamples);
+    }
+
     return EZ_SUCCESS;
   }
 
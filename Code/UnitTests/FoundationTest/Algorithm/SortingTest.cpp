@@ -1,5 +1,6 @@
 #include <FoundationTestPCH.h>
 
+#include <Foundation/Algorithm/ParallelSorting.h>
 #include <Foundation/Containers/DynamicArray.h>
 
 namespace
@@ -11,6 +12,45 @@ namespace
     // Comparision via operator. Sorting algorithm should prefer Less operator
     bool operator()(ezInt32 a, ezInt32 b) const { return a < b; }
   };
+
+  struct SortElement
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt64 m_uiKey;
+    ezUInt32 m_uiOrder;
+  };
+
+  struct SortElementComparer
+  {
+    EZ_ALWAYS_INLINE bool Less(const SortElement& a, const SortElement& b) const { return a.m_uiKey < b.m_uiKey; }
+  };
+
+  void FillSortElements(ezDynamicArray<SortElement>& elements, ezUInt32 uiCount, ezUInt64 uiKeyRange)
+  {
+    elements.SetCountUninitialized(uiCount);
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      // few distinct keys, to test that the sort is stable
+      const ezUInt64 uiRandom = (static_cast<ezUInt64>(rand()) << 32) ^ (static_cast<ezUInt64>(rand()) << 12) ^ rand();
+      elements[i].m_uiKey = uiRandom % uiKeyRange;
+      elements[i].m_uiOrder = i;
+    }
+  }
+
+  bool IsSortedAndStable(const ezDynamicArray<SortElement>& elements)
+  {
+    for (ezUInt32 i = 1; i < elements.GetCount(); ++i)
+    {
+      const SortElement& prev = elements[i - 1];
+      const SortElement& cur = elements[i];
+
+      if (prev.m_uiKey > cur.m_uiKey || (prev.m_uiKey == cur.m_uiKey && prev.m_uiOrder > cur.m_uiOrder))
+        return false;
+    }
+
+    return true;
+  }
 } // namespace
 
 EZ_CREATE_SIMPLE_TEST(Algorithm, Sorting)
@@ -52,4 +92,87 @@ EZ_CREATE_SIMPLE_TEST(Algorithm, Sorting)
       EZ_TEST_BOOL(a2[i - 1] >= a2[i]);
     }
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "MergeSort")
+  {
+    ezDynamicArray<ezInt32> a2 = a1;
+    ezDynamicArray<ezInt32> scratch;
+    scratch.SetCount(a2.GetCount());
+
+    ezSorting::MergeSort(a2.GetArrayPtr(), scratch.GetArrayPtr(), CustomComparer());
+
+    for (ezUInt32 i = 1; i < a2.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(a2[i - 1] >= a2[i]);
+    }
+
+    ezDynamicArray<SortElement> elements;
+    ezDynamicArray<SortElement> elementsScratch;
+
+    for (ezUInt32 uiCount : {0u, 1u, 31u, 32u, 33u, 1000u, 4099u})
+    {
+      FillSortElements(elements, uiCount, 50);
+      elementsScratch.SetCountUninitialized(uiCount);
+
+      ezSorting::MergeSort(elements.GetArrayPtr(), elementsScratch.GetArrayPtr(), SortElementComparer());
+      EZ_TEST_BOOL(IsSortedAndStable(elements));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "RadixSort")
+  {
+    ezDynamicArray<SortElement> elements;
+    ezDynamicArray<SortElement> elementsScratch;
+    auto keyExtractor = [](const SortElement& e) { return e.m_uiKey; };
+
+    // small arrays use insertion sort, large arrays use 11 bit digits, small key ranges skip most passes
+    for (ezUInt32 uiCount : {0u, 1u, 64u, 65u, 1000u, 100000u})
+    {
+      for (ezUInt64 uiKeyRange : {ezUInt64(50), ezUInt64(1) << 20, ezUInt64(0xFFFFFFFFFFFFFFFFull)})
+      {
+        FillSortElements(elements, uiCount, uiKeyRange);
+        elementsScratch.SetCountUninitialized(uiCount);
+
+        ezSorting::RadixSort(elements.GetArrayPtr(), elementsScratch.GetArrayPtr(), keyExtractor);
+        EZ_TEST_BOOL(IsSortedAndStable(elements));
+      }
+    }
+
+    // narrow key types
+    ezDynamicArray<ezUInt8> bytes;
+    ezDynamicArray<ezUInt8> bytesScratch;
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      bytes.PushBack(static_cast<ezUInt8>(rand()));
+    }
+    bytesScratch.SetCount(bytes.GetCount());
+
+    ezSorting::RadixSort(bytes.GetArrayPtr(), bytesScratch.GetArrayPtr(), [](ezUInt8 v) { return v; });
+
+    for (ezUInt32 i = 1; i < bytes.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(bytes[i - 1] <= bytes[i]);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ParallelSorting::MergeSort")
+  {
+    ezDynamicArray<SortElement> elements;
+
+    for (ezUInt32 uiCount : {0u, 1000u, 16u * 1024u + 1u, 100000u, 262147u})
+    {
+      FillSortElements(elements, uiCount, 1000);
+
+      ezParallelSorting::MergeSort(elements.GetArrayPtr(), SortElementComparer());
+      EZ_TEST_BOOL(IsSortedAndStable(elements));
+    }
+
+    ezDynamicArray<ezInt32> a2 = a1;
+    ezParallelSorting::MergeSort(a2.GetArrayPtr(), [](ezInt32 a, ezInt32 b) { return a > b; }, "Sort Test");
+
+    for (ezUInt32 i = 1; i < a2.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(a2[i - 1] >= a2[i]);
+    }
+  }
 }
@@ -0,0 +1,622 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Containers/BTreeSet.h>
+
+EZ_CREATE_SIMPLE_TEST(Containers, BTreeSet)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Constructor")
+  {
+    ezBTreeSet<ezUInt32> m;
+    ezBTreeSet<ezConstructionCounter, ezUInt32> m2;
+    ezBTreeSet<ezConstructionCounter, ezConstructionCounter> m3;
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "IsEmpty")
+  {
+    ezBTreeSet<ezUInt32> m;
+    EZ_TEST_BOOL(m.IsEmpty());
+
+    m.Insert(1);
+    EZ_TEST_BOOL(!m.IsEmpty());
+
+    m.Clear();
+    EZ_TEST_BOOL(m.IsEmpty());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "GetCount")
+  {
+    ezBTreeSet<ezUInt32> m;
+    EZ_TEST_INT(m.GetCount(), 0);
+
+    m.Insert(0);
+    EZ_TEST_INT(m.GetCount(), 1);
+
+    m.Insert(1);
+    EZ_TEST_INT(m.GetCount(), 2);
+
+    m.Insert(2);
+    EZ_TEST_INT(m.GetCount(), 3);
+
+    m.Insert(1);
+    EZ_TEST_INT(m.GetCount(), 3);
+
+    m.Clear();
+    EZ_TEST_INT(m.GetCount(), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Clear")
+  {
+    EZ_TEST_BOOL(ezConstructionCounter::HasAllDestructed());
+
+    {
+      ezBTreeSet<ezConstructionCounter> m1;
+      m1.Insert(ezConstructionCounter(1));
+      EZ_TEST_BOOL(ezConstructionCounter::HasDone(2, 1));
+
+      m1.Insert(ezConstructionCounter(3));
+      EZ_TEST_BOOL(ezConstructionCounter::HasDone(2, 1));
+
+      m1.Insert(ezConstructionCounter(1));
+      EZ_TEST_BOOL(ezConstructionCounter::HasDone(1, 1)); // nothing new to create, so only the one temporary is used
+
+      m1.Clear();
+      EZ_TEST_BOOL(ezConstructionCounter::HasDone(0, 2));
+      EZ_TEST_BOOL(ezConstructionCounter::HasAllDestructed());
+    }
+
+    {
+      ezBTreeSet<ezConstructionCounter> m1;
+      m1.Insert(ezConstructionCounter(0));
+      EZ_TEST_BOOL(ezConstructionCounter::HasDone(2, 1)); // one temporary
+
+      m1.Insert(ezConstructionCounter(1));
+      EZ_TEST_BOOL(ezConstructionCounter::HasDone(2, 1)); // one temporary
+
+      m1.Insert(ezConstructionCounter(0));
+      EZ_TEST_BOOL(ezConstructionCounter::HasDone(1, 1)); // nothing new to create, so only the one temporary is used
+
+      m1.Clear();
+      EZ_TEST_BOOL(ezConstructionCounter::HasDone(0, 2));
+      EZ_TEST_BOOL(ezConstructionCounter::HasAllDestructed());
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Insert")
+  {
+    ezBTreeSet<ezUInt32> m;
+    EZ_TEST_BOOL(m.GetHeapMemoryUsage() == 0);
+
+    EZ_TEST_BOOL(m.Insert(1).IsValid());
+    EZ_TEST_BOOL(m.Insert(1).IsValid());
+
+    m.Insert(3);
+    m.Insert(7);
+    m.Insert(9);
+    m.Insert(4);
+    m.Insert(2);
+    m.Insert(8);
+    m.Insert(5);
+    m.Insert(6);
+
+    EZ_TEST_BOOL(m.Insert(1).Key() == 1);
+    EZ_TEST_BOOL(m.Insert(3).Key() == 3);
+    EZ_TEST_INT(m.Insert(7).Key(), 7); // iterators are invalidated by insertions, so only the key can be compared
+
+    EZ_TEST_BOOL(m.GetHeapMemoryUsage() >= sizeof(ezUInt32) * 1 * 9);
+
+    EZ_TEST_BOOL(m.Find(1).IsValid());
+    EZ_TEST_BOOL(m.Find(2).IsValid());
+    EZ_TEST_BOOL(m.Find(3).IsValid());
+    EZ_TEST_BOOL(m.Find(4).IsValid());
+    EZ_TEST_BOOL(m.Find(5).IsValid());
+    EZ_TEST_BOOL(m.Find(6).IsValid());
+    EZ_TEST_BOOL(m.Find(7).IsValid());
+    EZ_TEST_BOOL(m.Find(8).IsValid());
+    EZ_TEST_BOOL(m.Find(9).IsValid());
+
+    EZ_TEST_BOOL(!m.Find(0).IsValid());
+    EZ_TEST_BOOL(!m.Find(10).IsValid());
+
+    EZ_TEST_INT(m.GetCount(), 9);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Contains")
+  {
+    ezBTreeSet<ezUInt32> m;
+    m.Insert(1);
+    m.Insert(3);
+    m.Insert(7);
+    m.Insert(9);
+    m.Insert(4);
+    m.Insert(2);
+    m.Insert(8);
+    m.Insert(5);
+    m.Insert(6);
+
+    EZ_TEST_BOOL(m.Contains(1));
+    EZ_TEST_BOOL(m.Contains(2));
+    EZ_TEST_BOOL(m.Contains(3));
+    EZ_TEST_BOOL(m.Contains(4));
+    EZ_TEST_BOOL(m.Contains(5));
+    EZ_TEST_BOOL(m.Contains(6));
+    EZ_TEST_BOOL(m.Contains(7));
+    EZ_TEST_BOOL(m.Contains(8));
+    EZ_TEST_BOOL(m.Contains(9));
+
+    EZ_TEST_BOOL(!m.Contains(0));
+    EZ_TEST_BOOL(!m.Contains(10));
+
+    EZ_TEST_INT(m.GetCount(), 9);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Set Operations")
+  {
+    ezBTreeSet<ezUInt32> base;
+    base.Insert(1);
+    base.Insert(3);
+    base.Insert(5);
+
+    ezBTreeSet<ezUInt32> empty;
+
+    ezBTreeSet<ezUInt32> disjunct;
+    disjunct.Insert(2);
+    disjunct.Insert(4);
+    disjunct.Insert(6);
+
+    ezBTreeSet<ezUInt32> subSet;
+    subSet.Insert(1);
+    subSet.Insert(5);
+
+    ezBTreeSet<ezUInt32> superSet;
+    superSet.Insert(1);
+    superSet.Insert(3);
+    superSet.Insert(5);
+    superSet.Insert(7);
+
+    ezBTreeSet<ezUInt32> nonDisjunctNonEmptySubSet;
+    nonDisjunctNonEmptySubSet.Insert(1);
+    nonDisjunctNonEmptySubSet.Insert(4);
+    nonDisjunctNonEmptySubSet.Insert(5);
+
+    // ContainsSet
+    EZ_TEST_BOOL(base.ContainsSet(base));
+
+    EZ_TEST_BOOL(base.ContainsSet(empty));
+    EZ_TEST_BOOL(!empty.ContainsSet(base));
+
+    EZ_TEST_BOOL(!base.ContainsSet(disjunct));
+    EZ_TEST_BOOL(!disjunct.ContainsSet(base));
+
+    EZ_TEST_BOOL(base.ContainsSet(subSet));
+    EZ_TEST_BOOL(!subSet.ContainsSet(base));
+
+    EZ_TEST_BOOL(!base.ContainsSet(superSet));
+    EZ_TEST_BOOL(superSet.ContainsSet(base));
+
+    EZ_TEST_BOOL(!base.ContainsSet(nonDisjunctNonEmptySubSet));
+    EZ_TEST_BOOL(!nonDisjunctNonEmptySubSet.ContainsSet(base));
+
+    // Union
+    {
+      ezBTreeSet<ezUInt32> res;
+
+      res.Union(base);
+      EZ_TEST_BOOL(res.ContainsSet(base));
+      EZ_TEST_BOOL(base.ContainsSet(res));
+      res.Union(subSet);
+      EZ_TEST_BOOL(res.ContainsSet(base));
+      EZ_TEST_BOOL(res.ContainsSet(subSet));
+      EZ_TEST_BOOL(base.ContainsSet(res));
+      res.Union(superSet);
+      EZ_TEST_BOOL(res.ContainsSet(base));
+      EZ_TEST_BOOL(res.ContainsSet(subSet));
+      EZ_TEST_BOOL(res.ContainsSet(superSet));
+      EZ_TEST_BOOL(superSet.ContainsSet(res));
+    }
+
+    // Difference
+    {
+      ezBTreeSet<ezUInt32> res;
+      res.Union(base);
+      res.Difference(empty);
+      EZ_TEST_BOOL(res.ContainsSet(base));
+      EZ_TEST_BOOL(base.ContainsSet(res));
+      res.Difference(disjunct);
+      EZ_TEST_BOOL(res.ContainsSet(base));
+      EZ_TEST_BOOL(base.ContainsSet(res));
+      res.Difference(subSet);
+      EZ_TEST_INT(res.GetCount(), 1);
+      EZ_TEST_BOOL(res.Contains(3));
+    }
+
+    // Intersection
+    {
+      ezBTreeSet<ezUInt32> res;
+      res.Union(base);
+      res.Intersection(disjunct);
+      EZ_TEST_BOOL(res.IsEmpty());
+      res.Union(base);
+      res.Intersection(subSet);
+      EZ_TEST_BOOL(base.ContainsSet(subSet));
+      EZ_TEST_BOOL(res.ContainsSet(subSet));
+      EZ_TEST_BOOL(subSet.ContainsSet(res));
+      res.Intersection(superSet);
+      EZ_TEST_BOOL(superSet.ContainsSet(res));
+      EZ_TEST_BOOL(res.ContainsSet(subSet));
+      EZ_TEST_BOOL(subSet.ContainsSet(res));
+      res.Intersection(empty);
+      EZ_TEST_BOOL(res.IsEmpty());
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Find")
+  {
+    ezBTreeSet<ezUInt32> m;
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+      m.Insert(i);
+
+    for (ezInt32 i = 1000 - 1; i >= 0; --i)
+      EZ_TEST_INT(m.Find(i).Key(), i);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Remove (non-existing)")
+  {
+    ezBTreeSet<ezUInt32> m;
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+      EZ_TEST_BOOL(!m.Remove(i));
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+      m.Insert(i);
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+      EZ_TEST_BOOL(m.Remove(i + 500) == (i < 500));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Remove (Iterator)")
+  {
+    ezBTreeSet<ezUInt32> m;
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+      m.Insert(i);
+
+    for (ezInt32 i = 0; i < 1000 - 1; ++i)
+    {
+      ezBTreeSet<ezUInt32>::Iterator itNext = m.Remove(m.Find(i));
+      EZ_TEST_BOOL(!m.Find(i).IsValid());
+      EZ_TEST_BOOL(itNext.Key() == i + 1);
+
+      EZ_TEST_INT(m.GetCount(), 1000 - 1 - i);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Remove (Key)")
+  {
+    ezBTreeSet<ezUInt32> m;
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+      m.Insert(i);
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+    {
+      EZ_TEST_BOOL(m.Remove(i));
+      EZ_TEST_BOOL(!m.Find(i).IsValid());
+
+      EZ_TEST_INT(m.GetCount(), 1000 - 1 - i);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "operator=")
+  {
+    ezBTreeSet<ezUInt32> m, m2;
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+      m.Insert(i);
+
+    m2 = m;
+
+    for (ezInt32 i = 1000 - 1; i >= 0; --i)
+      EZ_TEST_BOOL(m2.Find(i).IsValid());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Copy Constructor")
+  {
+    ezBTreeSet<ezUInt32> m;
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+      m.Insert(i);
+
+    ezBTreeSet<ezUInt32> m2(m);
+
+    for (ezInt32 i = 1000 - 1; i >= 0; --i)
+      EZ_TEST_BOOL(m2.Find(i).IsValid());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "GetIterator / Forward Iteration")
+  {
+    ezBTreeSet<ezUInt32> m;
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+      m.Insert(i);
+
+    ezInt32 i = 0;
+    for (ezBTreeSet<ezUInt32>::Iterator it = m.GetIterator(); it.IsValid(); ++it)
+    {
+      EZ_TEST_INT(it.Key(), i);
+      ++i;
+    }
+
+    EZ_TEST_INT(i, 1000);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "GetIterator / Forward Iteration (const)")
+  {
+    ezBTreeSet<ezUInt32> m;
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+      m.Insert(i);
+
+    const ezBTreeSet<ezUInt32> m2(m);
+
+    ezInt32 i = 0;
+    for (ezBTreeSet<ezUInt32>::Iterator it = m2.GetIterator(); it.IsValid(); ++it)
+    {
+      EZ_TEST_INT(it.Key(), i);
+      ++i;
+    }
+
+    EZ_TEST_INT(i, 1000);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "GetLastIterator / Backward Iteration")
+  {
+    ezBTreeSet<ezUInt32> m;
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+      m.Insert(i);
+
+    ezInt32 i = 1000 - 1;
+    for (ezBTreeSet<ezUInt32>::Iterator it = m.GetLastIterator(); it.IsValid(); --it)
+    {
+      EZ_TEST_INT(it.Key(), i);
+      --i;
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "GetLastIterator / Backward Iteration (const)")
+  {
+    ezBTreeSet<ezUInt32> m;
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+      m.Insert(i);
+
+    const ezBTreeSet<ezUInt32> m2(m);
+
+    ezInt32 i = 1000 - 1;
+    for (ezBTreeSet<ezUInt32>::Iterator it = m2.GetLastIterator(); it.IsValid(); --it)
+    {
+      EZ_TEST_INT(it.Key(), i);
+      --i;
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "LowerBound")
+  {
+    ezBTreeSet<ezInt32> m, m2;
+
+    m.Insert(0);
+    m.Insert(3);
+    m.Insert(7);
+    m.Insert(9);
+
+    EZ_TEST_INT(m.LowerBound(-1).Key(), 0);
+    EZ_TEST_INT(m.LowerBound(0).Key(), 0);
+    EZ_TEST_INT(m.LowerBound(1).Key(), 3);
+    EZ_TEST_INT(m.LowerBound(2).Key(), 3);
+    EZ_TEST_INT(m.LowerBound(3).Key(), 3);
+    EZ_TEST_INT(m.LowerBound(4).Key(), 7);
+    EZ_TEST_INT(m.LowerBound(5).Key(), 7);
+    EZ_TEST_INT(m.LowerBound(6).Key(), 7);
+    EZ_TEST_INT(m.LowerBound(7).Key(), 7);
+    EZ_TEST_INT(m.LowerBound(8).Key(), 9);
+    EZ_TEST_INT(m.LowerBound(9).Key(), 9);
+
+    EZ_TEST_BOOL(!m.LowerBound(10).IsValid());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "UpperBound")
+  {
+    ezBTreeSet<ezInt32> m, m2;
+
+    m.Insert(0);
+    m.Insert(3);
+    m.Insert(7);
+    m.Insert(9);
+
+    EZ_TEST_INT(m.UpperBound(-1).Key(), 0);
+    EZ_TEST_INT(m.UpperBound(0).Key(), 3);
+    EZ_TEST_INT(m.UpperBound(1).Key(), 3);
+    EZ_TEST_INT(m.UpperBound(2).Key(), 3);
+    EZ_TEST_INT(m.UpperBound(3).Key(), 7);
+    EZ_TEST_INT(m.UpperBound(4).Key(), 7);
+    EZ_TEST_INT(m.UpperBound(5).Key(), 7);
+    EZ_TEST_INT(m.UpperBound(6).Key(), 7);
+    EZ_TEST_INT(m.UpperBound(7).Key(), 9);
+    EZ_TEST_INT(m.UpperBound(8).Key(), 9);
+    EZ_TEST_BOOL(!m.UpperBound(9).IsValid());
+    EZ_TEST_BOOL(!m.UpperBound(10).IsValid());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Insert / Remove")
+  {
+    // Tests whether reusing of elements makes problems
+
+    ezBTreeSet<ezInt32> m;
+
+    for (ezUInt32 r = 0; r < 5; ++r)
+    {
+      // Insert
+      for (ezUInt32 i = 0; i < 10000; ++i)
+        m.Insert(i);
+
+      EZ_TEST_INT(m.GetCount(), 10000);
+
+      // Remove
+      for (ezUInt32 i = 0; i < 5000; ++i)
+        EZ_TEST_BOOL(m.Remove(i));
+
+      // Insert others
+      for (ezUInt32 j = 1; j < 1000; ++j)
+        m.Insert(20000 * j);
+
+      // Remove
+      for (ezUInt32 i = 0; i < 5000; ++i)
+        EZ_TEST_BOOL(m.Remove(5000 + i));
+
+      // Remove others
+      for (ezUInt32 j = 1; j < 1000; ++j)
+      {
+        EZ_TEST_BOOL(m.Find(20000 * j).IsValid());
+        EZ_TEST_BOOL(m.Remove(20000 * j));
+      }
+    }
+
+    EZ_TEST_BOOL(m.IsEmpty());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Iterator")
+  {
+    ezBTreeSet<ezUInt32> m;
+    for (ezUInt32 i = 0; i < 1000; ++i)
+      m.Insert(i + 1);
+
+    EZ_TEST_INT(std::find(begin(m), end(m), 500).Key(), 500);
+
+    auto itfound = std::find_if(begin(m), end(m), [](ezUInt32 val) { return val == 500; });
+
+    EZ_TEST_BOOL(std::find(begin(m), end(m), 500) == itfound);
+
+    ezUInt32 prev = *begin(m);
+    for (ezUInt32 val : m)
+    {
+      EZ_TEST_BOOL(val >= prev);
+      prev = val;
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "operator == / !=")
+  {
+    ezBTreeSet<ezUInt32> m, m2;
+
+    EZ_TEST_BOOL(m == m2);
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+      m.Insert(i * 10);
+
+    EZ_TEST_BOOL(m != m2);
+
+    m2 = m;
+
+    EZ_TEST_BOOL(m == m2);
+  }
+
+  constexpr ezUInt32 uiSetSize = sizeof(ezBTreeSet<ezString>);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Swap")
+  {
+    ezUInt8 set1Mem[uiSetSize];
+    ezUInt8 set2Mem[uiSetSize];
+    ezMemoryUtils::PatternFill(set1Mem, 0xCA, uiSetSize);
+    ezMemoryUtils::PatternFill(set2Mem, 0xCA, uiSetSize);
+
+    ezStringBuilder tmp;
+    ezBTreeSet<ezString>* set1 = new (set1Mem)(ezBTreeSet<ezString>);
+    ezBTreeSet<ezString>* set2 = new (set2Mem)(ezBTreeSet<ezString>);
+
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      tmp.Format("stuff{}bla", i);
+      set1->Insert(tmp);
+
+      tmp.Format("{0}{0}{0}", i);
+      set2->Insert(tmp);
+    }
+
+    set1->Swap(*set2);
+
+    // test swapped elements
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      tmp.Format("stuff{}bla", i);
+      EZ_TEST_BOOL(set2->Contains(tmp));
+
+      tmp.Format("{0}{0}{0}", i);
+      EZ_TEST_BOOL(set1->Contains(tmp));
+    }
+
+    // test iterators after swap
+    {
+      for (const auto& element : *set1)
+      {
+        EZ_TEST_BOOL(!set2->Contains(element));
+      }
+
+      for (const auto& element : *set2)
+      {
+        EZ_TEST_BOOL(!set1->Contains(element));
+      }
+    }
+
+    // due to a compiler bug in VS 2017, PatternFill cannot be called here, because it will move the memset BEFORE the destructor call!
+    // seems to be fixed in VS 2019 though
+
+    set1->~ezBTreeSet<ezString>();
+    // ezMemoryUtils::PatternFill(set1Mem, 0xBA, uiSetSize);
+
+    set2->~ezBTreeSet<ezString>();
+    ezMemoryUtils::PatternFill(set2Mem, 0xBA, uiSetSize);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Swap Empty")
+  {
+    ezUInt8 set1Mem[uiSetSize];
+    ezUInt8 set2Mem[uiSetSize];
+    ezMemoryUtils::PatternFill(set1Mem, 0xCA, uiSetSize);
+    ezMemoryUtils::PatternFill(set2Mem, 0xCA, uiSetSize);
+
+    ezStringBuilder tmp;
+    ezBTreeSet<ezString>* set1 = new (set1Mem)(ezBTreeSet<ezString>);
+    ezBTreeSet<ezString>* set2 = new (set2Mem)(ezBTreeSet<ezString>);
+
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      tmp.Format("stuff{}bla", i);
+      set1->Insert(tmp);
+    }
+
+    set1->Swap(*set2);
+    EZ_TEST_BOOL(set1->IsEmpty());
+
+    set1->~ezBTreeSet<ezString>();
+    ezMemoryUtils::PatternFill(set1Mem, 0xBA, uiSetSize);
+
+    // test swapped elements
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      tmp.Format("stuff{}bla", i);
+      EZ_TEST_BOOL(set2->Contains(tmp));
+    }
+
+    // test iterators after swap
+    {
+      for (const auto& element : *set2)
+      {
+        EZ_TEST_BOOL(set2->Contains(element));
+      }
+    }
+
+    set2->~ezBTreeSet<ezString>();
+    ezMemoryUtils::PatternFill(set2Mem, 0xBA, uiSetSize);
+  }
+}
@@ -1,11 +1,14 @@
 
 #include <FoundationTestPCH.h>
 
+#include <Foundation/Containers/Set.h>
 #include <Foundation/DataProcessing/Stream/DefaultImplementations/ZeroInitializer.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamGroup.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamProcessor.h>
+#include <Foundation/Math/Random.h>
 #include <Foundation/Reflection/Reflection.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
 
 EZ_CREATE_SIMPLE_TEST_GROUP(DataProcessing);
 
@@ -52,6 +55,89 @@ protected:
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(AddOneStreamProcessor, 1, ezRTTIDefaultAllocator<AddOneStreamProcessor>)
 EZ_END_DYNAMIC_REFLECTED_TYPE;
 
+// Range processors
+
+class MultiplyAddRangeProcessor : public ezProcessingStreamProcessor
+{
+  EZ_ADD_DYNAMIC_REFLECTION(MultiplyAddRangeProcessor, ezProcessingStreamProcessor);
+
+public:
+  MultiplyAddRangeProcessor() { m_bSupportsRangeProcessing = true; }
+
+  void SetStreamNames(ezHashedString InputStreamName, ezHashedString OutputStreamName)
+  {
+    m_InputStreamName = InputStreamName;
+    m_OutputStreamName = OutputStreamName;
+  }
+
+  float m_fMultiply = 1.0f;
+  float m_fAdd = 0.0f;
+  ezAtomicInteger32 m_iMisalignedChunks;
+
+protected:
+  virtual ezResult UpdateStreamBindings() override
+  {
+    m_pInputStream = m_pStreamGroup->GetStreamByName(m_InputStreamName);
+    m_pOutputStream = m_pStreamGroup->GetStreamByName(m_OutputStreamName);
+
+    DeclareStreamRead(m_pInputStream);
+    DeclareStreamWrite(m_pOutputStream);
+
+    return (m_pInputStream && m_pOutputStream) ? EZ_SUCCESS : EZ_FAILURE;
+  }
+
+  virtual void InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override {}
+  virtual void Process(ezUInt64 uiNumElements) override {}
+
+  virtual void ProcessRange(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override
+  {
+    const float* pInput = m_pInputStream->GetData<float>() + uiStartIndex;
+    float* pOutput = m_pOutputStream->GetWritableData<float>() + uiStartIndex;
+
+    if (uiStartIndex % ezProcessingStream::ElementGranularity != 0 || !ezMemoryUtils::IsAligned(pInput, 16) || !ezMemoryUtils::IsAligned(pOutput, 16))
+    {
+      m_iMisalignedChunks.Increment();
+    }
+
+    const ezSimdVec4f vMultiply(m_fMultiply);
+    const ezSimdVec4f vAdd(m_fAdd);
+
+    // the streams are padded, so the last chunk can be processed with whole vectors as well
+    for (ezUInt64 i = 0; i < uiNumElements; i += 4)
+    {
+      ezSimdVec4f v;
+      v.Load<4>(pInput + i);
+      v = ezSimdVec4f::MulAdd(v, vMultiply, vAdd);
+      v.Store<4>(pOutput + i);
+    }
+  }
+
+  ezHashedString m_InputStreamName;
+  ezHashedString m_OutputStreamName;
+  ezProcessingStream* m_pInputStream = nullptr;
+  ezProcessingStream* m_pOutputStream = nullptr;
+};
+
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(MultiplyAddRangeProcessor, 1, ezRTTIDefaultAllocator<MultiplyAddRangeProcessor>)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+class DeclaredAddOneStreamProcessor : public AddOneStreamProcessor
+{
+  EZ_ADD_DYNAMIC_REFLECTION(DeclaredAddOneStreamProcessor, AddOneStreamProcessor);
+
+protected:
+  virtual ezResult UpdateStreamBindings() override
+  {
+    EZ_SUCCEED_OR_RETURN(AddOneStreamProcessor::UpdateStreamBindings());
+
+    DeclareStreamWrite(m_pStream);
+    return EZ_SUCCESS;
+  }
+};
+
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(DeclaredAddOneStreamProcessor, 1, ezRTTIDefaultAllocator<DeclaredAddOneStreamProcessor>)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+
 EZ_CREATE_SIMPLE_TEST(DataProcessing, ProcessingStream)
 {
   ezProcessingStreamGroup Group;
@@ -157,3 +243,189 @@ EZ_CREATE_SIMPLE_TEST(DataProcessing, ProcessingStream)
     }
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(DataProcessing, ParallelProcessing)
+{
+  for (ezUInt32 uiParallel = 0; uiParallel < 2; ++uiParallel)
+  {
+    // not a multiple of the chunk size
+    const ezUInt64 uiNumElements = 100003;
+
+    ezProcessingStreamGroup Group;
+    Group.SetParallelProcessingEnabled(uiParallel != 0);
+
+    ezProcessingStream* pStreamA = Group.AddStream("A", ezProcessingStream::DataType::Float);
+    ezProcessingStream* pStreamB = Group.AddStream("B", ezProcessingStream::DataType::Float);
+    ezProcessingStream* pStreamC = Group.AddStream("C", ezProcessingStream::DataType::Float);
+
+    for (ezProcessingStream* pStream : {pStreamA, pStreamB, pStreamC})
+    {
+      ezProcessingStreamSpawnerZeroInitialized* pSpawner = EZ_DEFAULT_NEW(ezProcessingStreamSpawnerZeroInitialized);
+      pSpawner->SetStreamName(pStream->GetName());
+      Group.AddProcessor(pSpawner);
+    }
+
+    // A += 1, a processor that does not declare its streams is executed alone
+    AddOneStreamProcessor* pAddOneA = EZ_DEFAULT_NEW(AddOneStreamProcessor);
+    pAddOneA->SetStreamName(pStreamA->GetName());
+    pAddOneA->m_fPriority = 1.0f;
+    Group.AddProcessor(pAddOneA);
+
+    // B = A * 2, then B = B + 1, executed chunk by chunk
+    MultiplyAddRangeProcessor* pMultiply = EZ_DEFAULT_NEW(MultiplyAddRangeProcessor);
+    pMultiply->SetStreamNames(pStreamA->GetName(), pStreamB->GetName());
+    pMultiply->m_fMultiply = 2.0f;
+    pMultiply->m_fPriority = 2.0f;
+    Group.AddProcessor(pMultiply);
+
+    MultiplyAddRangeProcessor* pAdd = EZ_DEFAULT_NEW(MultiplyAddRangeProcessor);
+    pAdd->SetStreamNames(pStreamB->GetName(), pStreamB->GetName());
+    pAdd->m_fAdd = 1.0f;
+    pAdd->m_fPriority = 4.0f;
+    Group.AddProcessor(pAdd);
+
+    // C += 1, independent of the range processors, therefore executed concurrently
+    DeclaredAddOneStreamProcessor* pAddOneC = EZ_DEFAULT_NEW(DeclaredAddOneStreamProcessor);
+    pAddOneC->SetStreamName(pStreamC->GetName());
+    pAddOneC->m_fPriority = 3.0f;
+    Group.AddProcessor(pAddOneC);
+
+    Group.SetSize(uiNumElements);
+    Group.InitializeElements(uiNumElements);
+    Group.Process();
+
+    EZ_TEST_INT(Group.GetNumActiveElements(), uiNumElements);
+    EZ_TEST_BOOL(Group.GetChunkSize() % ezProcessingStream::ElementGranularity == 0);
+    EZ_TEST_BOOL(Group.GetChunkSize() < uiNumElements);
+
+    for (ezUInt32 uiFrame = 1; uiFrame <= 3; ++uiFrame)
+    {
+      Group.Process();
+
+      const float* pA = pStreamA->GetData<float>();
+      const float* pB = pStreamB->GetData<float>();
+      const float* pC = pStreamC->GetData<float>();
+
+      ezUInt32 uiWrongElements = 0;
+      for (ezUInt64 i = 0; i < uiNumElements; ++i)
+      {
+        if (pA[i] != uiFrame || pB[i] != uiFrame * 2 + 1 || pC[i] != uiFrame)
+        {
+          ++uiWrongElements;
+        }
+      }
+
+      EZ_TEST_INT(uiWrongElements, 0);
+    }
+
+    EZ_TEST_INT(pMultiply->m_iMisalignedChunks, 0);
+    EZ_TEST_INT(pAdd->m_iMisalignedChunks, 0);
+  }
+}
+
+EZ_CREATE_SIMPLE_TEST(DataProcessing, BatchedElementRemoval)
+{
+  ezRandom rng;
+  rng.Initialize(42);
+
+  for (ezUInt32 uiBatched = 0; uiBatched < 2; ++uiBatched)
+  {
+    for (ezUInt32 uiRound = 0; uiRound < 20; ++uiRound)
+    {
+      const ezUInt32 uiNumElements = 1 + rng.UIntInRange(1000);
+
+      ezProcessingStreamGroup Group;
+      Group.SetBatchedElementRemoval(uiBatched != 0);
+
+      ezProcessingStream* pStreamID = Group.AddStream("ID", ezProcessingStream::DataType::Int);
+      ezProcessingStream* pStreamData = Group.AddStream("Data", ezProcessingStream::DataType::Float4);
+
+      Group.SetSize(uiNumElements);
+      Group.InitializeElements(uiNumElements);
+      Group.Process();
+
+      // give every element a unique ID in every stream
+      for (ezUInt32 i = 0; i < uiNumElements; ++i)
+      {
+        pStreamID->GetWritableData<ezInt32>()[i] = i;
+        pStreamData->GetWritableData<ezVec4>()[i].Set(static_cast<float>(i));
+      }
+
+      ezSet<ezInt32> expectedIDs;
+      for (ezUInt32 i = 0; i < uiNumElements; ++i)
+      {
+        expectedIDs.Insert(i);
+      }
+
+      // remove a random subset, with duplicates and in random order, sometimes everything
+      const ezUInt32 uiNumRemoves = (uiRound == 0) ? uiNumElements : rng.UIntInRange(uiNumElements);
+      for (ezUInt32 i = 0; i < uiNumRemoves; ++i)
+      {
+        const ezUInt32 uiIndex = (uiRound == 0) ? i : rng.UIntInRange(uiNumElements);
+        Group.RemoveElement(uiIndex);
+        expectedIDs.Remove(uiIndex);
+      }
+
+      // the removed elements are reported with their data still in place
+      ezSet<ezInt32> removedIDs;
+      auto elementRemoved = [&](const ezStreamGroupElementRemovedEvent& e) {
+        EZ_TEST_BOOL(e.m_pStreamGroup == &Group);
+        removedIDs.Insert(pStreamID->GetData<ezInt32>()[e.m_uiElementIndex]);
+      };
+      ezEventSubscriptionID elementRemovedID = Group.m_ElementRemovedEvent.AddEventHandler(elementRemoved);
+
+      ezUInt32 uiNumBatchEvents = 0;
+      ezDynamicArray<ezInt32> expectedAfterMove;
+      auto elementsRemoved = [&](const ezStreamGroupElementsRemovedEvent& e) {
+        ++uiNumBatchEvents;
+        EZ_TEST_INT(e.m_RemovedIndices.GetCount(), uiNumElements - expectedIDs.GetCount());
+
+        for (ezUInt32 i = 1; i < e.m_RemovedIndices.GetCount(); ++i)
+        {
+          EZ_TEST_BOOL(e.m_RemovedIndices[i - 1] < e.m_RemovedIndices[i]);
+        }
+
+        // apply the remap table to the IDs, the streams have to end up the same
+        expectedAfterMove.SetCount(static_cast<ezUInt32>(Group.GetNumActiveElements()));
+        ezMemoryUtils::Copy(expectedAfterMove.GetData(), pStreamID->GetData<ezInt32>(), expectedAfterMove.GetCount());
+
+        for (const auto& move : e.m_MovedElements)
+        {
+          EZ_TEST_BOOL(move.m_uiNewIndex < expectedIDs.GetCount());
+          EZ_TEST_BOOL(move.m_uiOldIndex >= expectedIDs.GetCount());
+          expectedAfterMove[static_cast<ezUInt32>(move.m_uiNewIndex)] = expectedAfterMove[static_cast<ezUInt32>(move.m_uiOldIndex)];
+        }
+
+        expectedAfterMove.SetCount(expectedIDs.GetCount());
+      };
+      ezEventSubscriptionID elementsRemovedID = Group.m_ElementsRemovedEvent.AddEventHandler(elementsRemoved);
+
+      Group.Process();
+
+      Group.m_ElementRemovedEvent.RemoveEventHandler(elementRemovedID);
+      Group.m_ElementsRemovedEvent.RemoveEventHandler(elementsRemovedID);
+
+      EZ_TEST_INT(Group.GetNumActiveElements(), expectedIDs.GetCount());
+      EZ_TEST_INT(removedIDs.GetCount(), uiNumElements - expectedIDs.GetCount());
+      EZ_TEST_INT(uiNumBatchEvents, (uiBatched != 0 && uiNumRemoves > 0) ? 1 : 0);
+
+      ezSet<ezInt32> remainingIDs;
+      for (ezUInt32 i = 0; i < Group.GetNumActiveElements(); ++i)
+      {
+        const ezInt32 iID = pStreamID->GetData<ezInt32>()[i];
+        remainingIDs.Insert(iID);
+
+        EZ_TEST_BOOL(expectedIDs.Contains(iID));
+        EZ_TEST_BOOL(!removedIDs.Contains(iID));
+        EZ_TEST_FLOAT(pStreamData->GetData<ezVec4>()[i].w, static_cast<float>(iID), 0.0f);
+
+        if (uiNumBatchEvents > 0)
+        {
+          EZ_TEST_INT(iID, expectedAfterMove[i]);
+        }
+      }
+
+      EZ_TEST_INT(remainingIDs.GetCount(), expectedIDs.GetCount());
+    }
+  }
+}
@@ -1,6 +1,7 @@
 #include <FoundationTestPCH.h>
 
 #include <Foundation/IO/Archive/Archive.h>
+#include <Foundation/IO/Archive/ArchiveBuilder.h>
 #include <Foundation/IO/Archive/DataDirTypeArchive.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
@@ -153,3 +154,380 @@ EZ_CREATE_SIMPLE_TEST(IO, Archive)
 }
 
 #endif
+
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_STATS)
+
+EZ_CREATE_SIMPLE_TEST(IO, ArchiveDataDir)
+{
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("ArchiveDataDirTest");
+  sOutputFolder.MakeCleanPath();
+
+#  if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS)
+  ezOSFile::DeleteFolder(sOutputFolder).IgnoreResult();
+#  endif
+  ezOSFile::CreateDirectoryStructure(sOutputFolder).IgnoreResult();
+
+  if (EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "ArchiveDataDirTest", "output", ezFileSystem::AllowWrites).Succeeded()).Failed())
+    return;
+
+  const ezStringBuilder sSourceFolder(sOutputFolder, "/Source");
+  const ezStringBuilder sArchiveFile(sOutputFolder, "/Test.ezArchive");
+
+  struct TestFile
+  {
+    const char* m_szName;
+    ezUInt32 m_uiSize;
+    ezArchiveCompressionMode m_CompressionMode;
+    ezUInt32 m_uiContent; ///< files with the same content are only stored once
+  };
+
+  const TestFile files[] = {
+    {"Uncompressed.bin", 1024 * 100 + 3, ezArchiveCompressionMode::Uncompressed, 0},
+    {"Folder/Empty.bin", 0, ezArchiveCompressionMode::Uncompressed, 1},
+    {"Folder/Copy.bin", 1024 * 100 + 3, ezArchiveCompressionMode::Uncompressed, 0},
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+    {"Folder/Compressed.bin", 1024 * 300, ezArchiveCompressionMode::Compressed_zstd, 2},
+    // larger than the block size, so it ends up as ezArchiveCompressionMode::Compressed_zstd_seekable
+    {"Seekable.bin", 1024 * 1024 * 4 + 5, ezArchiveCompressionMode::Compressed_zstd, 3},
+#  endif
+  };
+
+  auto GetFileByte = [](ezUInt32 uiFile, ezUInt32 uiOffset) { return static_cast<ezUInt8>((uiOffset / 16) * 3 + uiFile); };
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Build Archive")
+  {
+    ezArchiveBuilder builder;
+    builder.m_uiZstdBlockSize = 1024 * 512;
+
+    ezStringBuilder sPath;
+    for (ezUInt32 uiFile = 0; uiFile < EZ_ARRAY_SIZE(files); ++uiFile)
+    {
+      ezDynamicArray<ezUInt8> content;
+      content.SetCountUninitialized(files[uiFile].m_uiSize);
+      for (ezUInt32 i = 0; i < content.GetCount(); ++i)
+      {
+        content[i] = GetFileByte(files[uiFile].m_uiContent, i);
+      }
+
+      sPath.Set(sSourceFolder, "/", files[uiFile].m_szName);
+
+      ezOSFile file;
+      EZ_TEST_BOOL(file.Open(sPath, ezFileOpenMode::Write).Succeeded());
+      if (!content.IsEmpty())
+      {
+        EZ_TEST_BOOL(file.Write(content.GetData(), content.GetCount()).Succeeded());
+      }
+      file.Close();
+
+      auto& entry = builder.m_Entries.ExpandAndGetRef();
+      entry.m_sAbsSourcePath = sPath;
+      entry.m_sRelTargetPath = files[uiFile].m_szName;
+      entry.m_CompressionMode = files[uiFile].m_CompressionMode;
+    }
+
+    ezArchiveBuilder::Statistics stats;
+    EZ_TEST_BOOL(builder.WriteArchive(":output/Test.ezArchive", &stats).Succeeded());
+
+    EZ_TEST_INT(stats.m_uiNumEntries, EZ_ARRAY_SIZE(files));
+    EZ_TEST_INT(stats.m_uiNumDeduplicatedEntries, 1);
+    EZ_TEST_INT(stats.m_uiDeduplicatedBytes, 1024 * 100 + 3);
+
+    // the files are compressed in parallel, but the output must not depend on the scheduling
+    ezMemoryStreamStorage storage1, storage2;
+    ezMemoryStreamWriter writer1(&storage1), writer2(&storage2);
+    EZ_TEST_BOOL(builder.WriteArchive(writer1).Succeeded());
+    EZ_TEST_BOOL(builder.WriteArchive(writer2).Succeeded());
+    EZ_TEST_INT(storage1.GetStorageSize(), storage2.GetStorageSize());
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(storage1.GetData(), storage2.GetData(), storage1.GetStorageSize()));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Deduplication")
+  {
+    ezArchiveReader reader;
+    EZ_TEST_BOOL(reader.OpenArchive(sArchiveFile).Succeeded());
+
+    const ezArchiveTOC& toc = reader.GetArchiveTOC();
+    const ezArchiveEntry& original = toc.m_Entries[toc.FindEntry("Uncompressed.bin")];
+    const ezArchiveEntry& copy = toc.m_Entries[toc.FindEntry("Folder/Copy.bin")];
+
+    EZ_TEST_INT(original.m_uiDataStartOffset, copy.m_uiDataStartOffset);
+    EZ_TEST_INT(original.m_uiStoredDataSize, copy.m_uiStoredDataSize);
+    EZ_TEST_BOOL(original.m_uiPathStringOffset != copy.m_uiPathStringOffset);
+  }
+
+  if (EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sArchiveFile, "ArchiveDataDirTest", "archive", ezFileSystem::ReadOnly).Succeeded()).Failed())
+    return;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Read Files")
+  {
+    ezStringBuilder sPath;
+    for (ezUInt32 uiFile = 0; uiFile < EZ_ARRAY_SIZE(files); ++uiFile)
+    {
+      sPath.Set(":archive/", files[uiFile].m_szName);
+
+      ezFileReader file;
+      EZ_TEST_BOOL(file.Open(sPath).Succeeded());
+      EZ_TEST_INT(file.GetFileSize(), files[uiFile].m_uiSize);
+
+      ezDynamicArray<ezUInt8> content;
+      content.SetCountUninitialized(files[uiFile].m_uiSize + 10);
+      EZ_TEST_INT(file.ReadBytes(content.GetData(), content.GetCount()), files[uiFile].m_uiSize);
+
+      bool bContentCorrect = true;
+      for (ezUInt32 i = 0; i < files[uiFile].m_uiSize; ++i)
+      {
+        bContentCorrect &= (content[i] == GetFileByte(files[uiFile].m_uiContent, i));
+      }
+
+      EZ_TEST_BOOL(bContentCorrect);
+    }
+  }
+
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Seekable Entries")
+  {
+    ezArchiveReader reader;
+    EZ_TEST_BOOL(reader.OpenArchive(sArchiveFile).Succeeded());
+
+    const ezArchiveTOC& toc = reader.GetArchiveTOC();
+    const ezUInt32 uiCompressed = toc.FindEntry("Folder/Compressed.bin");
+    const ezUInt32 uiSeekable = toc.FindEntry("Seekable.bin");
+
+    // files up to the block size are not split into blocks
+    EZ_TEST_BOOL(toc.m_Entries[uiCompressed].m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd);
+    EZ_TEST_BOOL(toc.m_Entries[uiSeekable].m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_seekable);
+    EZ_TEST_INT(toc.m_Entries[uiSeekable].m_uiBlockSize, 1024 * 512);
+    EZ_TEST_INT(toc.m_Entries[uiSeekable].GetNumBlocks(), 9);
+    EZ_TEST_INT(toc.GetEntryBlockEndOffsets(uiSeekable).GetCount(), 9);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Random Access")
+  {
+    const ezUInt32 uiFile = EZ_ARRAY_SIZE(files) - 1;
+    const ezUInt32 uiSize = files[uiFile].m_uiSize;
+
+    ezFileReader file;
+    EZ_TEST_BOOL(file.Open(":archive/Seekable.bin", 1024 * 4).Succeeded());
+
+    ezDynamicArray<ezUInt8> content;
+    content.SetCountUninitialized(1024 * 1024 * 2);
+
+    auto CheckContent = [&](ezUInt32 uiOffset, ezUInt32 uiCount) {
+      bool bContentCorrect = true;
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        bContentCorrect &= (content[i] == GetFileByte(files[uiFile].m_uiContent, uiOffset + i));
+      }
+      EZ_TEST_BOOL(bContentCorrect);
+    };
+
+    EZ_TEST_INT(file.ReadBytes(content.GetData(), 100), 100);
+    CheckContent(0, 100);
+
+    // skip into the middle of the third block, only the blocks that are read from get decompressed
+    EZ_TEST_INT(file.SkipBytes(1024 * 1024 + 3000), 1024 * 1024 + 3000);
+    EZ_TEST_INT(file.ReadBytes(content.GetData(), 1024 * 1024 * 2), 1024 * 1024 * 2);
+    CheckContent(1024 * 1024 + 3100, 1024 * 1024 * 2);
+
+    // skipping behind the end stops at the end
+    EZ_TEST_INT(file.SkipBytes(1024 * 1024), uiSize - (1024 * 1024 * 3 + 3100));
+    EZ_TEST_INT(file.ReadBytes(content.GetData(), 10), 0);
+  }
+#  endif
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "MapFileContent")
+  {
+    ezStringBuilder sPath;
+    for (ezUInt32 uiFile = 0; uiFile < EZ_ARRAY_SIZE(files); ++uiFile)
+    {
+      sPath.Set(":archive/", files[uiFile].m_szName);
+
+      ezFileReader file;
+      EZ_TEST_BOOL(file.Open(sPath).Succeeded());
+
+      ezArrayPtr<const ezUInt8> content;
+      if (files[uiFile].m_CompressionMode != ezArchiveCompressionMode::Uncompressed)
+      {
+        // compressed entries can only be read through ReadBytes()
+        EZ_TEST_BOOL(file.MapFileContent(content).Failed());
+        continue;
+      }
+
+      EZ_TEST_BOOL(file.MapFileContent(content).Succeeded());
+      EZ_TEST_INT(content.GetCount(), files[uiFile].m_uiSize);
+
+      bool bContentCorrect = true;
+      for (ezUInt32 i = 0; i < content.GetCount(); ++i)
+      {
+        bContentCorrect &= (content[i] == GetFileByte(files[uiFile].m_uiContent, i));
+      }
+
+      EZ_TEST_BOOL(bContentCorrect);
+    }
+  }
+
+  ezFileSystem::RemoveDataDirectoryGroup("ArchiveDataDirTest");
+}
+
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+
+namespace
+{
+  /// Small text files that have a lot in common with each other, like typical prefab files.
+  void GetArchiveDictionaryTestFile(ezUInt32 uiFile, ezStringBuilder& out_sContent)
+  {
+    out_sContent.Clear();
+    out_sContent.AppendFormat("Prefab \"Prefabs/Generated/Prefab{}.ezPrefab\"\n{\n", uiFile);
+
+    for (ezUInt32 uiObject = 0; uiObject < 1 + uiFile % 4; ++uiObject)
+    {
+      out_sContent.AppendFormat("  GameObject \"Object{}\"\n  {\n", uiObject);
+      out_sContent.AppendFormat("    LocalPosition = Vec3({}, {}, 0.0)\n", (uiFile * 17 + uiObject) % 50, (uiFile * 5) % 20);
+      out_sContent.Append("    LocalRotation = Quat(0.0, 0.0, 0.0, 1.0)\n    LocalScaling = Vec3(1.0, 1.0, 1.0)\n    Active = true\n");
+      out_sContent.AppendFormat("    MeshComponent\n    {\n      Mesh = \"Meshes/Generated/Mesh{}.ezMesh\"\n", uiFile % 7);
+      out_sContent.Append("      Color = Color(1.0, 1.0, 1.0, 1.0)\n      RenderDataCategory = \"Default\"\n      CastShadows = true\n    }\n  }\n");
+    }
+
+    out_sContent.Append("}\n");
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(IO, ArchiveZstdDictionary)
+{
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("ArchiveZstdDictionaryTest");
+  sOutputFolder.MakeCleanPath();
+
+#    if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS)
+  ezOSFile::DeleteFolder(sOutputFolder).IgnoreResult();
+#    endif
+  ezOSFile::CreateDirectoryStructure(sOutputFolder).IgnoreResult();
+
+  if (EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "ArchiveZstdDictionaryTest", "output", ezFileSystem::AllowWrites).Succeeded()).Failed())
+    return;
+
+  const ezStringBuilder sArchiveFile(sOutputFolder, "/Dictionary.ezArchive");
+  const ezUInt32 uiNumSmallFiles = 100;
+
+  ezArchiveBuilder builder;
+  ezStringBuilder sPath, sContent;
+
+  for (ezUInt32 uiFile = 0; uiFile <= uiNumSmallFiles; ++uiFile)
+  {
+    auto& entry = builder.m_Entries.ExpandAndGetRef();
+    entry.m_CompressionMode = ezArchiveCompressionMode::Compressed_zstd;
+
+    if (uiFile < uiNumSmallFiles)
+    {
+      GetArchiveDictionaryTestFile(uiFile, sContent);
+      sPath.Format("Prefabs/Prefab{}.ezPrefab", uiFile);
+      entry.m_sRelTargetPath = sPath;
+    }
+    else
+    {
+      // too large to be used for training, but still compressed with the dictionary
+      sContent.Clear();
+      while (sContent.GetElementCount() < 1024 * 200)
+      {
+        sContent.Append("A line of a large file that compresses well on its own\n");
+      }
+
+      entry.m_sRelTargetPath = "Large.txt";
+    }
+
+    sPath.Set(sOutputFolder, "/Source/", entry.m_sRelTargetPath);
+    entry.m_sAbsSourcePath = sPath;
+
+    ezOSFile file;
+    EZ_TEST_BOOL(file.Open(sPath, ezFileOpenMode::Write).Succeeded());
+    EZ_TEST_BOOL(file.Write(sContent.GetData(), sContent.GetElementCount()).Succeeded());
+  }
+
+  auto GetExpectedContent = [&](ezUInt32 uiEntry, ezDynamicArray<ezUInt8>& out_Content) {
+    ezOSFile file;
+    EZ_TEST_BOOL(file.Open(builder.m_Entries[uiEntry].m_sAbsSourcePath, ezFileOpenMode::Read).Succeeded());
+
+    out_Content.Clear();
+    file.ReadAll(out_Content);
+  };
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Build Archive")
+  {
+    ezArchiveBuilder::Statistics statsWithout;
+    EZ_TEST_BOOL(builder.WriteArchive(":output/NoDictionary.ezArchive", &statsWithout).Succeeded());
+    EZ_TEST_INT(statsWithout.m_uiZstdDictionarySize, 0);
+
+    builder.m_uiZstdDictionarySize = 16 * 1024;
+
+    ezArchiveBuilder::Statistics stats;
+    EZ_TEST_BOOL(builder.WriteArchive(":output/Dictionary.ezArchive", &stats).Succeeded());
+
+    EZ_TEST_INT(stats.m_uiNumZstdDictionarySamples, uiNumSmallFiles);
+    EZ_TEST_BOOL(stats.m_uiZstdDictionarySize > 0 && stats.m_uiZstdDictionarySize <= 16 * 1024);
+    EZ_TEST_INT(stats.m_uiUncompressedBytes, statsWithout.m_uiUncompressedBytes);
+    EZ_TEST_BOOL(stats.m_uiStoredBytes * 2 < statsWithout.m_uiStoredBytes);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Read Entries")
+  {
+    ezArchiveReader reader;
+    EZ_TEST_BOOL(reader.OpenArchive(sArchiveFile).Succeeded());
+
+    if (EZ_TEST_BOOL(reader.GetZstdDictionary() != nullptr).Failed())
+      return;
+
+    EZ_TEST_BOOL(reader.GetZstdDictionary()->IsInitialized());
+
+    const ezArchiveTOC& toc = reader.GetArchiveTOC();
+    EZ_TEST_INT(toc.m_Entries.GetCount(), uiNumSmallFiles + 1);
+
+    ezDynamicArray<ezUInt8> expected;
+    ezDynamicArray<ezUInt8> content;
+
+    for (ezUInt32 i = 0; i < toc.m_Entries.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(toc.m_Entries[i].m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd);
+
+      GetExpectedContent(i, expected);
+
+      ezUniquePtr<ezStreamReader> pEntryReader = reader.CreateEntryReader(i);
+      content.SetCountUninitialized(expected.GetCount() + 10);
+      EZ_TEST_INT(pEntryReader->ReadBytes(content.GetData(), content.GetCount()), expected.GetCount());
+      EZ_TEST_BOOL(ezMemoryUtils::IsEqual(content.GetData(), expected.GetData(), expected.GetCount()));
+    }
+
+    ezArchiveReader readerWithout;
+    EZ_TEST_BOOL(readerWithout.OpenArchive(ezStringBuilder(sOutputFolder, "/NoDictionary.ezArchive")).Succeeded());
+    EZ_TEST_BOOL(readerWithout.GetZstdDictionary() == nullptr);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Mount as Data Dir")
+  {
+    if (EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sArchiveFile, "ArchiveZstdDictionaryTest", "archive", ezFileSystem::ReadOnly).Succeeded()).Failed())
+      return;
+
+    ezDynamicArray<ezUInt8> expected;
+    ezDynamicArray<ezUInt8> content;
+
+    for (ezUInt32 i = 0; i < builder.m_Entries.GetCount(); i += 7)
+    {
+      GetExpectedContent(i, expected);
+
+      sPath.Set(":archive/", builder.m_Entries[i].m_sRelTargetPath);
+
+      ezFileReader file;
+      EZ_TEST_BOOL(file.Open(sPath).Succeeded());
+
+      content.SetCountUninitialized(expected.GetCount() + 10);
+      EZ_TEST_INT(file.ReadBytes(content.GetData(), content.GetCount()), expected.GetCount());
+      EZ_TEST_BOOL(ezMemoryUtils::IsEqual(content.GetData(), expected.GetData(), expected.GetCount()));
+    }
+  }
+
+  ezFileSystem::RemoveDataDirectoryGroup("ArchiveZstdDictionaryTest");
+}
+
+#  endif
+
+#endif
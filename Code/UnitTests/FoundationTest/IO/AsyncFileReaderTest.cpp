@@ -0,0 +1,207 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/AsyncFileReader.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/OSFile.h>
+
+namespace
+{
+  static constexpr ezUInt32 s_uiNumFiles = 50;
+
+  ezUInt8 GetExpectedByte(ezUInt32 uiFile, ezUInt64 uiOffset)
+  {
+    return static_cast<ezUInt8>((uiFile * 31 + uiOffset * 7) & 0xFF);
+  }
+
+  ezUInt32 GetFileSize(ezUInt32 uiFile)
+  {
+    // a mix of empty, tiny and larger files
+    return (uiFile % 5 == 0) ? 0 : uiFile * 1237;
+  }
+
+  void GetFilePath(ezUInt32 uiFile, ezStringBuilder& out_sPath)
+  {
+    out_sPath = ezTestFramework::GetInstance()->GetAbsOutputPath();
+    out_sPath.MakeCleanPath();
+    out_sPath.AppendPath("IO", "AsyncFileReader");
+    out_sPath.AppendFormat("/File{0}.bin", uiFile);
+  }
+
+  void ReadAllFiles(bool bAllowIoUring)
+  {
+    ezAsyncFileReader reader(8, bAllowIoUring);
+
+    ezOSFile files[s_uiNumFiles];
+    ezDynamicArray<ezUInt8> buffers[s_uiNumFiles];
+
+    ezStringBuilder sPath;
+    ezUInt64 uiBytesRequested = 0;
+    for (ezUInt32 i = 0; i < s_uiNumFiles; ++i)
+    {
+      GetFilePath(i, sPath);
+      EZ_TEST_BOOL(files[i].Open(sPath, ezFileOpenMode::Read).Succeeded());
+
+      // request more than there is, the read stops at the end of the file
+      buffers[i].SetCountUninitialized(GetFileSize(i) + 100);
+      reader.SubmitRead(files[i], 0, buffers[i].GetData(), buffers[i].GetCount(), i);
+      uiBytesRequested += buffers[i].GetCount();
+    }
+
+    EZ_TEST_INT(reader.GetNumPendingReads(), s_uiNumFiles);
+    EZ_TEST_INT(reader.GetNumPendingBytes(), uiBytesRequested);
+
+    ezDynamicArray<ezAsyncFileReader::Completion> completions;
+    while (reader.GetNumPendingReads() > 0)
+    {
+      reader.WaitForCompletions(completions);
+    }
+
+    EZ_TEST_INT(completions.GetCount(), s_uiNumFiles);
+    EZ_TEST_INT(reader.GetNumPendingBytes(), 0);
+
+    ezDynamicArray<bool> completed;
+    completed.SetCount(s_uiNumFiles);
+
+    for (const auto& completion : completions)
+    {
+      const ezUInt32 uiFile = static_cast<ezUInt32>(completion.m_uiUserData);
+
+      EZ_TEST_BOOL(completion.m_Result.Succeeded());
+      EZ_TEST_BOOL(!completed[uiFile]);
+      completed[uiFile] = true;
+
+      EZ_TEST_INT(completion.m_uiBytesRequested, GetFileSize(uiFile) + 100);
+      EZ_TEST_INT(completion.m_uiBytesRead, GetFileSize(uiFile));
+
+      bool bContentCorrect = true;
+      for (ezUInt32 b = 0; b < GetFileSize(uiFile); ++b)
+      {
+        bContentCorrect &= (buffers[uiFile][b] == GetExpectedByte(uiFile, b));
+      }
+
+      EZ_TEST_BOOL(bContentCorrect);
+    }
+
+    EZ_TEST_INT(reader.PollCompletions(completions), 0);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(IO, AsyncFileReader)
+{
+  ezStringBuilder sPath;
+
+  for (ezUInt32 i = 0; i < s_uiNumFiles; ++i)
+  {
+    ezDynamicArray<ezUInt8> content;
+    content.SetCountUninitialized(GetFileSize(i));
+
+    for (ezUInt32 b = 0; b < content.GetCount(); ++b)
+    {
+      content[b] = GetExpectedByte(i, b);
+    }
+
+    GetFilePath(i, sPath);
+
+    ezOSFile file;
+    EZ_TEST_BOOL(file.Open(sPath, ezFileOpenMode::Write).Succeeded());
+
+    if (!content.IsEmpty())
+    {
+      EZ_TEST_BOOL(file.Write(content.GetData(), content.GetCount()).Succeeded());
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Read Files")
+  {
+    ezAsyncFileReader reader;
+    ezLog::Info("ezAsyncFileReader uses io_uring: {0}", reader.IsUsingIoUring() ? "yes" : "no");
+
+    ReadAllFiles(true);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Read Files (Fallback)")
+  {
+    ezAsyncFileReader reader(8, false);
+    EZ_TEST_BOOL(!reader.IsUsingIoUring());
+
+    ReadAllFiles(false);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Read Ranges")
+  {
+    for (bool bAllowIoUring : {true, false})
+    {
+      ezAsyncFileReader reader(4, bAllowIoUring);
+
+      GetFilePath(s_uiNumFiles - 1, sPath);
+      ezOSFile file;
+      EZ_TEST_BOOL(file.Open(sPath, ezFileOpenMode::Read).Succeeded());
+
+      // many reads from the same file, more than can be in flight at once
+      ezUInt8 buffer[20][100];
+      for (ezUInt32 i = 0; i < 20; ++i)
+      {
+        reader.SubmitRead(file, i * 1000, buffer[i], 100, i);
+      }
+
+      ezDynamicArray<ezAsyncFileReader::Completion> completions;
+      while (reader.GetNumPendingReads() > 0)
+      {
+        reader.WaitForCompletions(completions);
+      }
+
+      EZ_TEST_INT(completions.GetCount(), 20);
+
+      for (const auto& completion : completions)
+      {
+        const ezUInt32 i = static_cast<ezUInt32>(completion.m_uiUserData);
+        EZ_TEST_INT(completion.m_uiBytesRead, 100);
+        EZ_TEST_INT(buffer[i][0], GetExpectedByte(s_uiNumFiles - 1, i * 1000));
+        EZ_TEST_INT(buffer[i][99], GetExpectedByte(s_uiNumFiles - 1, i * 1000 + 99));
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ezFileReader::ReadBytesAsync")
+  {
+    ezStringBuilder sFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+    sFolder.MakeCleanPath();
+    sFolder.AppendPath("IO", "AsyncFileReader");
+
+    EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sFolder, "AsyncFileReaderTest", "async").Succeeded());
+
+    ezAsyncFileReader reader;
+
+    ezFileReader file;
+    EZ_TEST_BOOL(file.Open(":async/File7.bin").Succeeded());
+    EZ_TEST_BOOL(file.GetOSFile() != nullptr);
+
+    // read a few bytes through the cache first, the asynchronous read continues from there
+    ezUInt8 start[10];
+    EZ_TEST_INT(file.ReadBytes(start, 10), 10);
+    EZ_TEST_INT(start[9], GetExpectedByte(7, 9));
+
+    ezDynamicArray<ezUInt8> rest;
+    rest.SetCountUninitialized(GetFileSize(7) - 20);
+    EZ_TEST_BOOL(file.ReadBytesAsync(reader, rest.GetData(), rest.GetCount(), 42).Succeeded());
+
+    ezDynamicArray<ezAsyncFileReader::Completion> completions;
+    reader.WaitForCompletions(completions);
+
+    EZ_TEST_INT(completions.GetCount(), 1);
+    EZ_TEST_INT(completions[0].m_uiUserData, 42);
+    EZ_TEST_INT(completions[0].m_uiBytesRead, rest.GetCount());
+    EZ_TEST_INT(rest[0], GetExpectedByte(7, 10));
+    EZ_TEST_INT(rest.PeekBack(), GetExpectedByte(7, GetFileSize(7) - 11));
+
+    // afterwards ReadBytes continues behind the asynchronously read data
+    ezUInt8 end[20];
+    EZ_TEST_INT(file.ReadBytes(end, 20), 10);
+    EZ_TEST_INT(end[0], GetExpectedByte(7, GetFileSize(7) - 10));
+    EZ_TEST_INT(end[9], GetExpectedByte(7, GetFileSize(7) - 1));
+
+    file.Close();
+    ezFileSystem::RemoveDataDirectoryGroup("AsyncFileReaderTest");
+  }
+}
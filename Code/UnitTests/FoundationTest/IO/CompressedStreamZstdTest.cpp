@@ -6,6 +6,30 @@
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
 
+namespace
+{
+  /// Small text files that have a lot in common with each other, like typical material files.
+  void CreateZstdDictionaryTestFile(ezUInt32 uiFile, ezDynamicArray<ezUInt8>& out_Content)
+  {
+    const char* szShaders[] = {"DefaultMaterial", "CutoutMaterial", "TransparentMaterial", "TerrainMaterial"};
+
+    ezStringBuilder sText;
+    sText.AppendFormat("Material \"Materials/Generated/Material{}.ezMaterial\"\n", uiFile);
+    sText.Append("{\n  BaseMaterial = \"{ d615cd66-0904-00ca-81f9-768ff4fc24ee }\"\n");
+    sText.AppendFormat("  Shader = \"Shaders/Materials/{}.ezShader\"\n", szShaders[uiFile % EZ_ARRAY_SIZE(szShaders)]);
+    sText.AppendFormat("  BaseColor = Color({}, {}, {}, 1.0)\n", (uiFile * 7) % 100, (uiFile * 13) % 100, (uiFile * 31) % 100);
+    sText.Append("  BLEND_MODE = BLEND_MODE_OPAQUE\n  SHADING_MODE = SHADING_MODE_LIT\n  TWO_SIDED = false\n  FLIP_WINDING = false\n");
+    sText.Append("  USE_BASE_TEXTURE = true\n  USE_NORMAL_TEXTURE = true\n  USE_ROUGHNESS_TEXTURE = true\n  USE_METALLIC_TEXTURE = false\n");
+    sText.AppendFormat("  BaseTexture = \"Textures/Generated/Texture{}_D.ezTexture2D\"\n", uiFile / 3);
+    sText.AppendFormat("  NormalTexture = \"Textures/Generated/Texture{}_N.ezTexture2D\"\n", uiFile / 3);
+    sText.AppendFormat("  RoughnessTexture = \"Textures/Generated/Texture{}_R.ezTexture2D\"\n", uiFile / 3);
+    sText.AppendFormat("  RoughnessValue = {}\n  MetallicValue = 0.0\n  MaskThreshold = 0.25\n}\n", (uiFile % 10) / 10.0f);
+
+    out_Content.Clear();
+    out_Content.PushBackRange(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(sText.GetData()), sText.GetElementCount()));
+  }
+} // namespace
+
 EZ_CREATE_SIMPLE_TEST(IO, CompressedStreamZstd)
 {
   ezDynamicArray<ezUInt32> TestData;
@@ -134,6 +158,149 @@ EZ_CREATE_SIMPLE_TEST(IO, CompressedStreamZstd)
       EZ_TEST_BOOL(CompressedReader.ReadBytes(&uiTemp, sizeof(ezUInt32)) == 0);
     }
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Seekable Stream")
+  {
+    const ezUInt32 uiBlockSize = 64 * 1024;
+    const ezUInt64 uiDataSize = TestData.GetCount() * sizeof(ezUInt32) - 100; // the last block is not full
+
+    ezMemoryStreamStorage SeekableStorage;
+    ezMemoryStreamWriter SeekableWriter(&SeekableStorage);
+
+    ezSeekableStreamWriterZstd SeekableCompressor;
+    SeekableCompressor.SetOutputStream(&SeekableWriter, uiBlockSize);
+
+    const ezUInt8* pData = reinterpret_cast<const ezUInt8*>(TestData.GetData());
+    for (ezUInt64 uiWritten = 0; uiWritten < uiDataSize;)
+    {
+      const ezUInt64 uiWrite = ezMath::Min<ezUInt64>(uiDataSize - uiWritten, 1000 + uiWritten % 100000);
+      EZ_TEST_BOOL(SeekableCompressor.WriteBytes(pData + uiWritten, uiWrite).Succeeded());
+      uiWritten += uiWrite;
+    }
+
+    EZ_TEST_BOOL(SeekableCompressor.FinishCompressedStream().Succeeded());
+
+    const ezDynamicArray<ezUInt64>& blockEndOffsets = SeekableCompressor.GetBlockEndOffsets();
+    EZ_TEST_INT(blockEndOffsets.GetCount(), (uiDataSize + uiBlockSize - 1) / uiBlockSize);
+    EZ_TEST_INT(blockEndOffsets.PeekBack(), SeekableStorage.GetStorageSize());
+    EZ_TEST_INT(SeekableCompressor.GetWrittenBytes(), SeekableStorage.GetStorageSize());
+    EZ_TEST_BOOL(SeekableCompressor.GetWrittenBytes() * 10 < uiDataSize);
+
+    ezSeekableStreamReaderZstd SeekableReader;
+
+    for (ezUInt32 uiMinBlocksParallel : {0u, 4u})
+    {
+      SeekableReader.SetInputData(SeekableStorage.GetData(), blockEndOffsets.GetArrayPtr(), uiBlockSize, uiDataSize);
+      SeekableReader.SetMinBlocksForParallelDecompression(uiMinBlocksParallel);
+
+      // everything at once
+      ezDynamicArray<ezUInt8> decompressed;
+      decompressed.SetCountUninitialized(static_cast<ezUInt32>(uiDataSize) + 10);
+      EZ_TEST_INT(SeekableReader.ReadBytes(decompressed.GetData(), decompressed.GetCount()), uiDataSize);
+      EZ_TEST_BOOL(ezMemoryUtils::IsEqual(decompressed.GetData(), pData, static_cast<size_t>(uiDataSize)));
+      EZ_TEST_INT(SeekableReader.ReadBytes(decompressed.GetData(), 10), 0);
+
+      // random access, across block boundaries and starting in the middle of blocks
+      const ezUInt64 uiRanges[][2] = {{0, 10}, {uiBlockSize - 5, 10}, {uiBlockSize * 3 + 17, uiBlockSize * 6}, {uiBlockSize * 2, uiBlockSize * 5},
+        {uiDataSize - 50, 50}, {100, 1}};
+
+      for (const auto& range : uiRanges)
+      {
+        SeekableReader.SetReadPosition(range[0]);
+        EZ_TEST_INT(SeekableReader.GetReadPosition(), range[0]);
+        EZ_TEST_INT(SeekableReader.ReadBytes(decompressed.GetData(), range[1]), range[1]);
+        EZ_TEST_BOOL(ezMemoryUtils::IsEqual(decompressed.GetData(), pData + range[0], static_cast<size_t>(range[1])));
+      }
+
+      // skipping does not decompress, but moves the read position
+      SeekableReader.SetReadPosition(0);
+      EZ_TEST_INT(SeekableReader.SkipBytes(uiBlockSize * 7 + 3), uiBlockSize * 7 + 3);
+      EZ_TEST_INT(SeekableReader.ReadBytes(decompressed.GetData(), 8), 8);
+      EZ_TEST_BOOL(ezMemoryUtils::IsEqual(decompressed.GetData(), pData + uiBlockSize * 7 + 3, 8));
+      EZ_TEST_INT(SeekableReader.SkipBytes(uiDataSize), uiDataSize - (uiBlockSize * 7 + 11));
+      EZ_TEST_INT(SeekableReader.GetReadPosition(), uiDataSize);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Dictionary")
+  {
+    ezDynamicArray<ezDynamicArray<ezUInt8>> files;
+    files.SetCount(200);
+
+    for (ezUInt32 i = 0; i < files.GetCount(); ++i)
+    {
+      CreateZstdDictionaryTestFile(i, files[i]);
+    }
+
+    // train with every other file, the dictionary also has to work for similar data that it has not seen
+    ezDynamicArray<ezArrayPtr<const ezUInt8>> samples;
+    for (ezUInt32 i = 0; i < files.GetCount(); i += 2)
+    {
+      samples.PushBack(files[i].GetArrayPtr());
+    }
+
+    ezDynamicArray<ezUInt8> dictionaryData;
+    ezZstdDictionary::Train(samples, 16 * 1024, dictionaryData);
+    EZ_TEST_BOOL(!dictionaryData.IsEmpty());
+    EZ_TEST_BOOL(dictionaryData.GetCount() <= 16 * 1024);
+
+    ezZstdDictionary dictionary;
+    EZ_TEST_BOOL(!dictionary.IsInitialized());
+    EZ_TEST_BOOL(dictionary.Initialize(dictionaryData, true).Succeeded());
+    EZ_TEST_BOOL(dictionary.IsInitialized());
+    EZ_TEST_BOOL(dictionary.CanCompress());
+    EZ_TEST_INT(dictionary.GetDictionarySize(), dictionaryData.GetCount());
+
+    ezCompressedStreamWriterZstd DictCompressor;
+    ezCompressedStreamReaderZstd DictDecompressor;
+    ezDynamicArray<ezUInt8> decompressed;
+    ezUInt64 uiCompressedSize[2] = {0, 0};
+
+    for (ezUInt32 uiUseDictionary = 0; uiUseDictionary < 2; ++uiUseDictionary)
+    {
+      const ezZstdDictionary* pDictionary = uiUseDictionary ? &dictionary : nullptr;
+
+      for (const auto& file : files)
+      {
+        ezMemoryStreamStorage DictStorage;
+        ezMemoryStreamWriter DictWriter(&DictStorage);
+        ezMemoryStreamReader DictReader(&DictStorage);
+
+        DictCompressor.SetOutputStream(&DictWriter, ezCompressedStreamWriterZstd::Compression::Default, 4, pDictionary);
+        EZ_TEST_BOOL(DictCompressor.WriteBytes(file.GetData(), file.GetCount()).Succeeded());
+        EZ_TEST_BOOL(DictCompressor.FinishCompressedStream().Succeeded());
+        uiCompressedSize[uiUseDictionary] += DictCompressor.GetWrittenBytes();
+
+        // the decoder is reused for all files
+        DictDecompressor.SetInputStream(&DictReader, pDictionary);
+        decompressed.SetCountUninitialized(file.GetCount() + 10);
+        EZ_TEST_INT(DictDecompressor.ReadBytes(decompressed.GetData(), decompressed.GetCount()), file.GetCount());
+        EZ_TEST_BOOL(ezMemoryUtils::IsEqual(decompressed.GetData(), file.GetData(), file.GetCount()));
+      }
+    }
+
+    // each file on its own compresses poorly, with the shared content in the dictionary it is a lot better
+    EZ_TEST_BOOL(uiCompressedSize[1] * 2 < uiCompressedSize[0]);
+
+    // samples without anything in common do not result in a dictionary
+    ezDynamicArray<ezUInt8> noise;
+    noise.SetCountUninitialized(64 * 1024);
+    ezUInt32 uiRandom = 42;
+    for (ezUInt8& value : noise)
+    {
+      uiRandom = uiRandom * 1664525u + 1013904223u;
+      value = static_cast<ezUInt8>(uiRandom >> 24);
+    }
+
+    samples.Clear();
+    for (ezUInt32 i = 0; i < 16; ++i)
+    {
+      samples.PushBack(noise.GetArrayPtr().GetSubArray(i * 4096, 4096));
+    }
+
+    ezZstdDictionary::Train(samples, 16 * 1024, dictionaryData);
+    EZ_TEST_BOOL(dictionaryData.IsEmpty());
+  }
 }
 
 #endif
@@ -149,6 +149,48 @@ Only concrete and clocks.\n\
     FileIn.Close();
   }
 
+#if EZ_ENABLED(EZ_SUPPORTS_MEMORY_MAPPED_FILE)
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "MapFileContent")
+  {
+    ezFileReader FileIn;
+    EZ_TEST_BOOL(FileIn.Open("FileSystemTest.txt") == EZ_SUCCESS);
+
+    // the mapping is independent of the read position
+    char szTemp[4];
+    EZ_TEST_INT(FileIn.ReadBytes(szTemp, 4), 4);
+
+    ezArrayPtr<const ezUInt8> content;
+    EZ_TEST_BOOL(FileIn.MapFileContent(content).Succeeded());
+    EZ_TEST_INT(content.GetCount(), sFileContent.GetElementCount());
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(reinterpret_cast<const char*>(content.GetPtr()), sFileContent.GetData(), sFileContent.GetElementCount()));
+
+    // mapping again returns the same memory
+    ezArrayPtr<const ezUInt8> content2;
+    EZ_TEST_BOOL(FileIn.MapFileContent(content2).Succeeded());
+    EZ_TEST_BOOL(content2.GetPtr() == content.GetPtr());
+
+    EZ_TEST_INT(FileIn.ReadBytes(szTemp, 4), 4);
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(szTemp, sFileContent.GetData() + 4, 4));
+
+    FileIn.Close();
+
+    // empty files result in an empty view
+    {
+      ezFileWriter FileOut;
+      EZ_TEST_BOOL(FileOut.Open(":output1/FileSystemTestEmpty.txt") == EZ_SUCCESS);
+    }
+
+    EZ_TEST_BOOL(FileIn.Open("FileSystemTestEmpty.txt") == EZ_SUCCESS);
+    EZ_TEST_BOOL(FileIn.MapFileContent(content).Succeeded());
+    EZ_TEST_BOOL(content.IsEmpty());
+    FileIn.Close();
+
+    ezFileSystem::DeleteFile(":output1/FileSystemTestEmpty.txt");
+  }
+
+#endif
+
 #if EZ_DISABLED(EZ_PLATFORM_WINDOWS_UWP)
 
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "Read File (Absolute Path)")
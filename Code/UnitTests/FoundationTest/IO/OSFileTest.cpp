@@ -80,6 +80,30 @@ Only concrete and clocks.\n\
     f.Close();
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ReadAt")
+  {
+    char szTemp[64];
+
+    ezOSFile f;
+    EZ_TEST_BOOL(f.Open(sOutputFile.GetData(), ezFileOpenMode::Read) == EZ_SUCCESS);
+
+    EZ_TEST_INT(f.ReadAt(uiTextLen + 10, szTemp, 20), 20);
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(szTemp, sFileContent.GetData() + 10, 20));
+
+    // reads beyond the end of the file are cut off, which is not an error
+    ezResult result = EZ_FAILURE;
+    EZ_TEST_INT(f.ReadAt(uiTextLen * 2 - 5, szTemp, 64, &result), 5);
+    EZ_TEST_BOOL(result.Succeeded());
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(szTemp, sFileContent.GetData() + uiTextLen - 5, 5));
+
+    // the file position is independent of ReadAt on Posix systems
+#if EZ_ENABLED(EZ_USE_POSIX_FILE_API)
+    EZ_TEST_INT(f.GetFilePosition(), 0);
+#endif
+
+    f.Close();
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "Copy File")
   {
     ezOSFile::CopyFile(sOutputFile.GetData(), sOutputFile2.GetData());
@@ -1,8 +1,13 @@
 #include <FoundationTestPCH.h>
 
+#include <Foundation/Memory/ArenaAllocator.h>
 #include <Foundation/Memory/CommonAllocators.h>
+#include <Foundation/Memory/FrameAllocator.h>
 #include <Foundation/Memory/LargeBlockAllocator.h>
 #include <Foundation/Memory/StackAllocator.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Threading/ThreadUtils.h>
 
 struct EZ_ALIGN(NonAlignedVector, EZ_ALIGNMENT_MINIMUM)
 {
@@ -160,6 +165,321 @@ EZ_CREATE_SIMPLE_TEST(Memory, Allocator)
     EZ_TEST_BOOL(stats.m_uiAllocationSize == 0);
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "LargeBlockAllocator Thread Caches")
+  {
+    enum
+    {
+      BLOCK_SIZE_IN_BYTES = 4096 * 2
+    };
+
+    ezLargeBlockAllocator<BLOCK_SIZE_IN_BYTES> allocator("Test", ezFoundation::GetDefaultAllocator());
+    EZ_TEST_INT(allocator.GetThreadCacheSize(), decltype(allocator)::DEFAULT_THREAD_CACHE_SIZE);
+
+    // blocks that were just freed are handed out again by the same thread
+    auto block = allocator.AllocateBlock<int>();
+    int* pData = block.m_pData;
+    allocator.DeallocateBlock(block);
+
+    block = allocator.AllocateBlock<int>();
+    EZ_TEST_BOOL(block.m_pData == pData);
+    allocator.DeallocateBlock(block);
+
+    ezMemoryTracker::ThreadCacheStats cacheStats = ezMemoryTracker::GetThreadCacheStats(allocator.GetId());
+    EZ_TEST_INT(cacheStats.m_uiNumMisses, 1);
+
+    // make sure the worker threads are running, otherwise ParallelFor executes everything on this thread
+    if (ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks) == 0)
+    {
+      ezTaskSystem::SetWorkerThreadCount();
+    }
+
+    // many threads allocating and freeing concurrently
+    ezParallelForParams params;
+    params.uiBinSize = 1;
+    params.uiMaxTasksPerThread = 4;
+
+    ezTaskSystem::ParallelForIndexed(
+      0, 32,
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+        for (ezUInt32 uiIndex = uiStartIndex; uiIndex < uiEndIndex; ++uiIndex)
+        {
+          ezHybridArray<ezDataBlock<ezUInt32, BLOCK_SIZE_IN_BYTES>, 64> blocks;
+
+          for (ezUInt32 i = 0; i < 1000; ++i)
+          {
+            if (blocks.GetCount() < 64 && (blocks.IsEmpty() || (i * 7 + uiIndex) % 3 != 0))
+            {
+              auto newBlock = allocator.AllocateBlock<ezUInt32>();
+              *newBlock.ReserveBack() = uiIndex;
+              *newBlock.ReserveBack() = i;
+              blocks.PushBack(newBlock);
+            }
+            else
+            {
+              auto& oldBlock = blocks.PeekBack();
+
+              // if two threads got the same block, one of them would see the other's values
+              EZ_TEST_INT(oldBlock[0], uiIndex);
+              EZ_TEST_BOOL(oldBlock[1] < i);
+
+              allocator.DeallocateBlock(oldBlock);
+              blocks.PopBack();
+            }
+          }
+
+          for (auto& oldBlock : blocks)
+          {
+            EZ_TEST_INT(oldBlock[0], uiIndex);
+            allocator.DeallocateBlock(oldBlock);
+          }
+        }
+      },
+      "LargeBlockAllocator Thread Caches", params);
+
+    ezAllocatorBase::Stats stats = allocator.GetStats();
+    EZ_TEST_BOOL(stats.m_uiNumAllocations - stats.m_uiNumDeallocations == 0);
+    EZ_TEST_BOOL(stats.m_uiAllocationSize == 0);
+
+    allocator.FlushThreadCaches();
+
+    cacheStats = ezMemoryTracker::GetThreadCacheStats(allocator.GetId());
+    EZ_TEST_BOOL(cacheStats.m_uiNumHits > cacheStats.m_uiNumMisses);
+    EZ_TEST_BOOL(cacheStats.m_uiNumFlushes > 0);
+    EZ_TEST_INT(cacheStats.m_uiCachedSize, 0);
+
+    // without thread caches, every block comes from the shared free list
+    allocator.SetThreadCacheSize(0);
+
+    block = allocator.AllocateBlock<int>();
+    allocator.DeallocateBlock(block);
+
+    EZ_TEST_INT(ezMemoryTracker::GetThreadCacheStats(allocator.GetId()).m_uiNumMisses, cacheStats.m_uiNumMisses);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "PageAllocator Thread Cache")
+  {
+    const ezUInt32 uiPageSize = ezSystemInformation::Get().GetMemoryPageSize();
+
+    ezPageAllocator::FlushThreadCache();
+    const ezMemoryTracker::ThreadCacheStats prevStats = ezMemoryTracker::GetThreadCacheStats(ezPageAllocator::GetId());
+
+    void* pPages = ezPageAllocator::AllocatePage(uiPageSize * 4);
+    EZ_TEST_BOOL(ezMemoryUtils::IsAligned(pPages, uiPageSize));
+    ezPageAllocator::DeallocatePage(pPages, uiPageSize * 4);
+
+    // same size is taken from the cache, other sizes are not
+    void* pPages2 = ezPageAllocator::AllocatePage(uiPageSize * 2);
+    void* pPages4 = ezPageAllocator::AllocatePage(uiPageSize * 4);
+    EZ_TEST_BOOL(pPages4 == pPages);
+
+    // hits are only published when the cache exchanges pages with the OS
+    ezPageAllocator::FlushThreadCache();
+
+    ezMemoryTracker::ThreadCacheStats stats = ezMemoryTracker::GetThreadCacheStats(ezPageAllocator::GetId());
+    EZ_TEST_INT(stats.m_uiNumHits - prevStats.m_uiNumHits, 1);
+    EZ_TEST_INT(stats.m_uiNumMisses - prevStats.m_uiNumMisses, 2);
+
+    // once the cache is full, the oldest pages go back to the OS
+    const size_t uiPrevCacheSize = ezPageAllocator::GetThreadCacheSize();
+    ezPageAllocator::SetThreadCacheSize(uiPageSize * 4);
+
+    ezPageAllocator::DeallocatePage(pPages2, uiPageSize * 2);
+    ezPageAllocator::DeallocatePage(pPages4, uiPageSize * 4);
+
+    stats = ezMemoryTracker::GetThreadCacheStats(ezPageAllocator::GetId());
+    EZ_TEST_INT(stats.m_uiCachedSize - prevStats.m_uiCachedSize, uiPageSize * 4);
+
+    ezPageAllocator::SetThreadCacheSize(uiPrevCacheSize);
+    EZ_TEST_INT(ezMemoryTracker::GetThreadCacheStats(ezPageAllocator::GetId()).m_uiCachedSize, prevStats.m_uiCachedSize);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ScalableHeapAllocator")
+  {
+    typedef ezMemoryPolicies::ezScalableHeapAllocation Policy;
+
+    // every size fits into its size class and would not fit into the previous one
+    for (ezUInt32 uiSize = 1; uiSize <= Policy::MaxSmallSize; ++uiSize)
+    {
+      const ezUInt32 uiSizeClass = Policy::GetSizeClass(uiSize);
+      EZ_TEST_BOOL(uiSizeClass < Policy::NumSizeClasses);
+      EZ_TEST_BOOL(Policy::GetSizeClassBlockSize(uiSizeClass) >= uiSize);
+      EZ_TEST_BOOL(uiSizeClass == 0 || Policy::GetSizeClassBlockSize(uiSizeClass - 1) < uiSize);
+    }
+    EZ_TEST_INT(Policy::GetSizeClass(Policy::MaxSmallSize), Policy::NumSizeClasses - 1);
+
+    ezScalableHeapAllocator allocator("ScalableHeap");
+
+    // freed blocks are handed out again by the same thread
+    void* pSmall = allocator.Allocate(40, EZ_ALIGNMENT_MINIMUM);
+    allocator.Deallocate(pSmall);
+    EZ_TEST_BOOL(allocator.Allocate(48, EZ_ALIGNMENT_MINIMUM) == pSmall);
+    allocator.Deallocate(pSmall);
+
+    // large and over-aligned allocations
+    void* pLarge = allocator.Allocate(Policy::MaxSmallSize * 3, EZ_ALIGNMENT_MINIMUM);
+    ezMemoryUtils::PatternFill(static_cast<ezUInt8*>(pLarge), 0xAB, Policy::MaxSmallSize * 3);
+    void* pAligned = allocator.Allocate(24, 64);
+    EZ_TEST_BOOL(ezMemoryUtils::IsAligned(pAligned, 64));
+    void* pLargeAligned = allocator.Allocate(Policy::MaxSmallSize + 1, Policy::MaxAlignment);
+    EZ_TEST_BOOL(ezMemoryUtils::IsAligned(pLargeAligned, Policy::MaxAlignment));
+    EZ_TEST_BOOL(allocator.Reallocate(pLargeAligned, Policy::MaxSmallSize + 1, Policy::MaxSmallSize, Policy::MaxAlignment) == pLargeAligned);
+
+    // growing within the size class keeps the block
+    void* pGrow = allocator.Allocate(100, EZ_ALIGNMENT_MINIMUM);
+    ezMemoryUtils::PatternFill(static_cast<ezUInt8*>(pGrow), 0x42, 100);
+    EZ_TEST_BOOL(allocator.Reallocate(pGrow, 100, 112, EZ_ALIGNMENT_MINIMUM) == pGrow);
+    pGrow = allocator.Reallocate(pGrow, 112, 1000, EZ_ALIGNMENT_MINIMUM);
+    EZ_TEST_INT(static_cast<ezUInt8*>(pGrow)[99], 0x42);
+
+    allocator.Deallocate(pGrow);
+    allocator.Deallocate(pAligned);
+    allocator.Deallocate(pLargeAligned);
+    allocator.Deallocate(pLarge);
+
+    // make sure the worker threads are running, otherwise ParallelFor executes everything on this thread
+    if (ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks) == 0)
+    {
+      ezTaskSystem::SetWorkerThreadCount();
+    }
+
+    ezParallelForParams params;
+    params.uiBinSize = 1;
+    params.uiMaxTasksPerThread = 4;
+
+    constexpr ezUInt32 uiNumTasks = 16;
+    constexpr ezUInt32 uiNumAllocationsPerTask = 500;
+    ezDynamicArray<ezUInt32*> allocations;
+    allocations.SetCount(uiNumTasks * uiNumAllocationsPerTask);
+
+    auto allocateAll = [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      for (ezUInt32 uiIndex = uiStartIndex; uiIndex < uiEndIndex; ++uiIndex)
+      {
+        for (ezUInt32 i = 0; i < uiNumAllocationsPerTask; ++i)
+        {
+          const ezUInt32 uiSlot = uiIndex * uiNumAllocationsPerTask + i;
+          const size_t uiSize = 4 + (uiSlot * 97) % 2048;
+
+          ezUInt32* pData = static_cast<ezUInt32*>(allocator.Allocate(uiSize, EZ_ALIGNMENT_MINIMUM));
+          EZ_TEST_BOOL(ezMemoryUtils::IsAligned(pData, EZ_ALIGNMENT_MINIMUM));
+          *pData = uiSlot;
+          allocations[uiSlot] = pData;
+        }
+      }
+    };
+
+    // allocate on the worker threads and free everything on this thread, which goes through the remote free lists
+    ezTaskSystem::ParallelForIndexed(0, uiNumTasks, allocateAll, "ScalableHeap Allocate", params);
+
+    for (ezUInt32 uiSlot = 0; uiSlot < allocations.GetCount(); ++uiSlot)
+    {
+      // if two allocations got the same block, one of them would have been overwritten
+      EZ_TEST_INT(*allocations[uiSlot], uiSlot);
+      allocator.Deallocate(allocations[uiSlot]);
+    }
+
+    // the worker threads reclaim the remotely freed blocks before allocating new spans
+    ezTaskSystem::ParallelForIndexed(0, uiNumTasks, allocateAll, "ScalableHeap Allocate", params);
+
+    for (ezUInt32 uiSlot = 0; uiSlot < allocations.GetCount(); ++uiSlot)
+    {
+      EZ_TEST_INT(*allocations[uiSlot], uiSlot);
+      allocator.Deallocate(allocations[uiSlot]);
+    }
+
+    ezAllocatorBase::Stats stats = allocator.GetStats();
+    EZ_TEST_BOOL(stats.m_uiNumAllocations - stats.m_uiNumDeallocations == 0);
+    EZ_TEST_BOOL(stats.m_uiAllocationSize == 0);
+
+    // the thread heap statistics are only reported when the allocator is registered with the memory tracker
+    if (!allocator.GetId().IsInvalidated())
+    {
+      const ezMemoryTracker::ThreadCacheStats cacheStats = ezMemoryTracker::GetThreadCacheStats(allocator.GetId());
+      EZ_TEST_BOOL(cacheStats.m_uiNumHits > cacheStats.m_uiNumMisses);
+      EZ_TEST_BOOL(cacheStats.m_uiCachedSize > 0);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "MemoryTracker")
+  {
+    typedef ezAllocator<ezMemoryPolicies::ezHeapAllocation, ezMemoryTrackingFlags::RegisterAllocator | ezMemoryTrackingFlags::EnableAllocationTracking>
+      TrackedAllocator;
+
+    TrackedAllocator allocator("TrackedHeap");
+
+    // make sure the worker threads are running, otherwise ParallelFor executes everything on this thread
+    if (ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks) == 0)
+    {
+      ezTaskSystem::SetWorkerThreadCount();
+    }
+
+    ezParallelForParams params;
+    params.uiBinSize = 1;
+    params.uiMaxTasksPerThread = 4;
+
+    constexpr ezUInt32 uiNumAllocationsPerTask = 200;
+
+    // many threads adding and removing allocations of the same allocator concurrently
+    ezTaskSystem::ParallelForIndexed(
+      0, 16,
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+        for (ezUInt32 uiIndex = uiStartIndex; uiIndex < uiEndIndex; ++uiIndex)
+        {
+          void* allocations[uiNumAllocationsPerTask];
+
+          for (ezUInt32 i = 0; i < uiNumAllocationsPerTask; ++i)
+          {
+            allocations[i] = allocator.Allocate(16 + i, EZ_ALIGNMENT_MINIMUM);
+          }
+
+          for (ezUInt32 i = 0; i < uiNumAllocationsPerTask; ++i)
+          {
+            EZ_TEST_INT(allocator.AllocatedSize(allocations[i]), 16 + i);
+            allocator.Deallocate(allocations[i]);
+          }
+        }
+      },
+      "MemoryTracker", params);
+
+    ezAllocatorBase::Stats stats = allocator.GetStats();
+    EZ_TEST_INT(stats.m_uiNumAllocations, 16 * uiNumAllocationsPerTask);
+    EZ_TEST_INT(stats.m_uiNumDeallocations, 16 * uiNumAllocationsPerTask);
+    EZ_TEST_INT(stats.m_uiAllocationSize, 0);
+
+    // with sampling, only every n-th allocation records a stack trace
+    typedef ezAllocator<ezMemoryPolicies::ezHeapAllocation, ezMemoryTrackingFlags::All> StackTracedAllocator;
+    StackTracedAllocator tracedAllocator("StackTracedHeap");
+
+    EZ_TEST_INT(ezMemoryTracker::GetStackTraceSampleRate(), 1);
+    ezMemoryTracker::SetStackTraceSampleRate(4);
+
+    void* tracedAllocations[12];
+    ezUInt32 uiNumStackTraces = 0;
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(tracedAllocations); ++i)
+    {
+      tracedAllocations[i] = tracedAllocator.Allocate(32, EZ_ALIGNMENT_MINIMUM);
+
+      if (ezMemoryTracker::GetAllocationInfo(tracedAllocator.GetId(), tracedAllocations[i]).GetStackTrace().GetPtr() != nullptr)
+      {
+        ++uiNumStackTraces;
+      }
+    }
+
+    ezMemoryTracker::SetStackTraceSampleRate(1);
+
+    // platforms without stack tracing never record any
+    if (uiNumStackTraces > 0)
+    {
+      EZ_TEST_INT(uiNumStackTraces, 3);
+    }
+
+    EZ_TEST_INT(tracedAllocator.GetStats().m_uiNumAllocations, EZ_ARRAY_SIZE(tracedAllocations));
+
+    for (void* ptr : tracedAllocations)
+    {
+      tracedAllocator.Deallocate(ptr);
+    }
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "StackAllocator")
   {
     ezStackAllocator<> allocator("TestStackAllocator", ezFoundation::GetAlignedAllocator());
@@ -235,4 +555,176 @@ EZ_CREATE_SIMPLE_TEST(Memory, Allocator)
 
     EZ_TEST_BOOL(ezConstructionCounter::HasDestructed(50));
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "StackAllocator without Mutex")
+  {
+    ezStackAllocator<ezMemoryTrackingFlags::Default, ezNoMutex> allocator("TestStackAllocator", ezFoundation::GetAlignedAllocator());
+
+    void* blocks[8];
+    for (size_t i = 0; i < EZ_ARRAY_SIZE(blocks); i++)
+    {
+      blocks[i] = allocator.Allocate(64, sizeof(void*), nullptr);
+      EZ_TEST_BOOL(blocks[i] != nullptr);
+      ezMemoryUtils::PatternFill(static_cast<ezUInt8*>(blocks[i]), static_cast<ezUInt8>(i), 64);
+    }
+
+    for (size_t i = 0; i < EZ_ARRAY_SIZE(blocks); i++)
+    {
+      EZ_TEST_INT(static_cast<ezUInt8*>(blocks[i])[63], i);
+    }
+
+    // resetting with poisoning overwrites the freed memory, the buckets themselves are kept for the next allocations
+    allocator.Reset(true);
+
+    EZ_TEST_INT(static_cast<ezUInt8*>(blocks[0])[0], 0xCD);
+    EZ_TEST_INT(static_cast<ezUInt8*>(blocks[7])[63], 0xCD);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ArenaAllocator")
+  {
+    ezHeapAllocator parent("ArenaParent");
+
+    {
+      ezArenaAllocator<256> allocator("TestArenaAllocator", &parent);
+
+      // the first allocations come from the embedded buffer
+      void* pFirst = allocator.Allocate(100, 8);
+      void* pSecond = allocator.Allocate(100, 16);
+      EZ_TEST_BOOL(ezMemoryUtils::IsAligned(pFirst, 16));
+      EZ_TEST_BOOL(ezMemoryUtils::IsAligned(pSecond, 16));
+      EZ_TEST_BOOL(ezMemoryUtils::AddByteOffset(pFirst, 112) == pSecond);
+      EZ_TEST_INT(parent.GetStats().m_uiNumAllocations, 0);
+
+      // the last allocation grows in place
+      ezMemoryUtils::PatternFill(static_cast<ezUInt8*>(pSecond), 0x42, 100);
+      EZ_TEST_BOOL(allocator.Reallocate(pSecond, 100, 128, 16) == pSecond);
+
+      // deallocating the last allocation gives its memory back
+      allocator.Deallocate(pSecond);
+      EZ_TEST_BOOL(allocator.Allocate(32, 8) == pSecond);
+
+      // this does not fit into the embedded buffer anymore, so the content is copied into a bucket from the parent allocator
+      void* pThird = allocator.Reallocate(pSecond, 32, 1000, 16);
+      EZ_TEST_BOOL(pThird != pSecond);
+      EZ_TEST_INT(static_cast<ezUInt8*>(pThird)[31], 0x42);
+      EZ_TEST_INT(parent.GetStats().m_uiNumAllocations, 1);
+
+      // allocations that are larger than the next bucket get a bucket of their own
+      void* pLarge = allocator.Allocate(64 * 1024, 16);
+      ezMemoryUtils::PatternFill(static_cast<ezUInt8*>(pLarge), 0x17, 64 * 1024);
+      EZ_TEST_INT(parent.GetStats().m_uiNumAllocations, 2);
+
+      allocator.Reset();
+      EZ_TEST_INT(parent.GetStats().m_uiNumDeallocations, 2);
+      EZ_TEST_BOOL(allocator.Allocate(100, 8) == pFirst);
+
+      // buckets that are in use on destruction are freed as well
+      allocator.Allocate(1000, 8);
+    }
+
+    EZ_TEST_INT(parent.GetStats().m_uiNumAllocations, parent.GetStats().m_uiNumDeallocations);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ArenaAllocator with ezStringBuilder")
+  {
+    ezHeapAllocator parent("ArenaParent");
+    ezString sCopy;
+
+    {
+      ezArenaAllocator<1024> allocator("TestArenaAllocator", &parent);
+
+      ezStringBuilder sPath(&allocator);
+      ezStringBuilder sFile(&allocator);
+
+      for (ezUInt32 i = 0; i < 20; ++i)
+      {
+        sPath.AppendPath("SubFolder");
+      }
+
+      sFile = sPath;
+      sFile.AppendPath("File.txt");
+
+      EZ_TEST_INT(sPath.GetElementCount(), 20 * 10 - 1);
+      EZ_TEST_BOOL(sFile.EndsWith("SubFolder/File.txt"));
+      EZ_TEST_INT(parent.GetStats().m_uiNumAllocations, 0);
+
+      // copying into a string with another allocator does not reference the arena memory
+      sCopy = sFile;
+    }
+
+    EZ_TEST_INT(parent.GetStats().m_uiNumAllocations, parent.GetStats().m_uiNumDeallocations);
+    EZ_TEST_BOOL(sCopy.EndsWith("SubFolder/File.txt"));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FrameAllocator")
+  {
+    const bool bPoisonMemory = ezFrameAllocator::GetPoisonMemoryOnReset();
+    ezFrameAllocator::SetPoisonMemoryOnReset(true);
+
+    EZ_TEST_INT(ezFrameAllocator::GetFrameLifetime(), 2);
+    ezFrameAllocator::SetFrameLifetime(3);
+    EZ_TEST_INT(ezFrameAllocator::GetFrameLifetime(), 3);
+
+    // allocations stay alive for as many swaps as the frame lifetime minus one
+    ezUInt32* pShared = EZ_NEW(ezFrameAllocator::GetCurrentAllocator(), ezUInt32, 42);
+    ezUInt32* pThread = EZ_NEW(ezFrameAllocator::GetCurrentThreadAllocator(), ezUInt32, 43);
+
+    ezAllocatorBase* pThreadAllocator = ezFrameAllocator::GetCurrentThreadAllocator();
+    ezFrameAllocator::Swap();
+    EZ_TEST_BOOL(ezFrameAllocator::GetCurrentThreadAllocator() != pThreadAllocator);
+    ezFrameAllocator::Swap();
+
+    EZ_TEST_INT(*pShared, 42);
+    EZ_TEST_INT(*pThread, 43);
+
+    ezFrameAllocator::Swap();
+    EZ_TEST_BOOL(ezFrameAllocator::GetCurrentThreadAllocator() == pThreadAllocator);
+
+    EZ_TEST_INT(*pShared, 0xCDCDCDCD);
+    EZ_TEST_INT(*pThread, 0xCDCDCDCD);
+
+    // make sure the worker threads are running, otherwise ParallelFor executes everything on this thread
+    if (ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks) == 0)
+    {
+      ezTaskSystem::SetWorkerThreadCount();
+    }
+
+    ezParallelForParams params;
+    params.uiBinSize = 1;
+    params.uiMaxTasksPerThread = 4;
+
+    ezMutex mutex;
+    ezSet<ezAllocatorBase*> threadAllocators;
+    ezSet<ezThreadID> threadIds;
+    ezDynamicArray<ezUInt32*> values;
+
+    ezTaskSystem::ParallelForIndexed(
+      0, 64,
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+        for (ezUInt32 uiIndex = uiStartIndex; uiIndex < uiEndIndex; ++uiIndex)
+        {
+          ezAllocatorBase* pAllocator = ezFrameAllocator::GetCurrentThreadAllocator();
+          ezUInt32* pValue = EZ_NEW(pAllocator, ezUInt32, uiIndex);
+
+          EZ_LOCK(mutex);
+          threadAllocators.Insert(pAllocator);
+          threadIds.Insert(ezThreadUtils::GetCurrentThreadID());
+          values.PushBack(pValue);
+        }
+      },
+      "FrameAllocator", params);
+
+    // every thread allocates from its own allocator
+    EZ_TEST_INT(threadAllocators.GetCount(), threadIds.GetCount());
+
+    ezUInt64 uiSum = 0;
+    for (ezUInt32* pValue : values)
+    {
+      uiSum += *pValue;
+    }
+    EZ_TEST_INT(uiSum, 63 * 64 / 2);
+
+    ezFrameAllocator::SetFrameLifetime(2);
+    ezFrameAllocator::SetPoisonMemoryOnReset(bPoisonMemory);
+  }
 }
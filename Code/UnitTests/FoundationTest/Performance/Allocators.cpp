@@ -0,0 +1,243 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Memory/CommonAllocators.h>
+#include <Foundation/Memory/LargeBlockAllocator.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+  static constexpr ezUInt32 s_uiNumAllocatorThreadItems = 16;
+  static constexpr ezUInt32 s_uiNumBlockOperations = 2000;
+  static constexpr ezUInt32 s_uiNumHeapOperations = 20000;
+#else
+  static constexpr ezUInt32 s_uiNumAllocatorThreadItems = 64;
+  static constexpr ezUInt32 s_uiNumBlockOperations = 20000;
+  static constexpr ezUInt32 s_uiNumHeapOperations = 200000;
+#endif
+
+  static constexpr ezUInt32 s_uiBenchmarkBlockSize = 4096 * 4;
+  static constexpr ezUInt32 s_uiNumHeapSlots = 256;
+
+  // only register the allocators, tracking individual allocations would dominate the measurements
+  typedef ezAllocator<ezMemoryPolicies::ezHeapAllocation, ezMemoryTrackingFlags::RegisterAllocator> BenchmarkHeapAllocator;
+  typedef ezAllocator<ezMemoryPolicies::ezScalableHeapAllocation, ezMemoryTrackingFlags::RegisterAllocator> BenchmarkScalableHeapAllocator;
+  typedef ezAllocator<ezMemoryPolicies::ezHeapAllocation, ezMemoryTrackingFlags::RegisterAllocator | ezMemoryTrackingFlags::EnableAllocationTracking>
+    BenchmarkTrackedHeapAllocator;
+
+  EZ_ALWAYS_INLINE size_t GetBenchmarkAllocationSize(ezUInt32 uiIndex)
+  {
+    // mostly small sizes, like strings, array storage and small objects
+    return (uiIndex % 16) == 0 ? 256 + (uiIndex * 37) % 3840 : 8 + (uiIndex * 13) % 248;
+  }
+
+  void PrepareHeapBenchmark(ezParallelForParams& params)
+  {
+    // make sure the worker threads are running, otherwise ParallelFor executes everything on this thread
+    if (ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks) == 0)
+    {
+      ezTaskSystem::SetWorkerThreadCount();
+    }
+
+    params.uiBinSize = 1;
+    params.uiMaxTasksPerThread = 4;
+  }
+
+  /// Every task keeps a working set of allocations and keeps replacing them, all frees happen on the allocating thread.
+  template <typename AllocatorType>
+  ezTime MeasureHeapLocal(const char* szName)
+  {
+    AllocatorType allocator(szName);
+
+    ezParallelForParams params;
+    PrepareHeapBenchmark(params);
+
+    const ezTime t0 = ezTime::Now();
+
+    ezTaskSystem::ParallelForIndexed(
+      0, s_uiNumAllocatorThreadItems,
+      [&allocator](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+        void* slots[s_uiNumHeapSlots] = {};
+
+        for (ezUInt32 uiIndex = uiStartIndex; uiIndex < uiEndIndex; ++uiIndex)
+        {
+          for (ezUInt32 i = 0; i < s_uiNumHeapOperations / s_uiNumAllocatorThreadItems; ++i)
+          {
+            void*& pSlot = slots[(i * 7) % s_uiNumHeapSlots];
+            if (pSlot != nullptr)
+            {
+              allocator.Deallocate(pSlot);
+            }
+
+            pSlot = allocator.Allocate(GetBenchmarkAllocationSize(i + uiIndex), EZ_ALIGNMENT_MINIMUM);
+            *static_cast<ezUInt32*>(pSlot) = i;
+          }
+        }
+
+        for (void* pSlot : slots)
+        {
+          if (pSlot != nullptr)
+          {
+            allocator.Deallocate(pSlot);
+          }
+        }
+      },
+      "Heap Benchmark", params);
+
+    return ezTime::Now() - t0;
+  }
+
+  /// Allocations are made by one task and freed by another one, like data that is produced by one job and consumed by the next.
+  template <typename AllocatorType>
+  ezTime MeasureHeapCrossThread(const char* szName)
+  {
+    AllocatorType allocator(szName);
+
+    ezParallelForParams params;
+    PrepareHeapBenchmark(params);
+
+    constexpr ezUInt32 uiNumAllocationsPerItem = s_uiNumHeapOperations / s_uiNumAllocatorThreadItems / 4;
+    ezDynamicArray<void*> allocations;
+    allocations.SetCount(s_uiNumAllocatorThreadItems * uiNumAllocationsPerItem);
+
+    const ezTime t0 = ezTime::Now();
+
+    for (ezUInt32 uiRound = 0; uiRound < 4; ++uiRound)
+    {
+      ezTaskSystem::ParallelForIndexed(
+        0, s_uiNumAllocatorThreadItems,
+        [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+          for (ezUInt32 uiIndex = uiStartIndex; uiIndex < uiEndIndex; ++uiIndex)
+          {
+            for (ezUInt32 i = 0; i < uiNumAllocationsPerItem; ++i)
+            {
+              allocations[uiIndex * uiNumAllocationsPerItem + i] = allocator.Allocate(GetBenchmarkAllocationSize(i + uiIndex), EZ_ALIGNMENT_MINIMUM);
+            }
+          }
+        },
+        "Heap Benchmark Produce", params);
+
+      ezTaskSystem::ParallelForIndexed(
+        0, s_uiNumAllocatorThreadItems,
+        [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+          for (ezUInt32 uiIndex = uiStartIndex; uiIndex < uiEndIndex; ++uiIndex)
+          {
+            // free what another item allocated
+            const ezUInt32 uiOther = s_uiNumAllocatorThreadItems - 1 - uiIndex;
+
+            for (ezUInt32 i = 0; i < uiNumAllocationsPerItem; ++i)
+            {
+              allocator.Deallocate(allocations[uiOther * uiNumAllocationsPerItem + i]);
+            }
+          }
+        },
+        "Heap Benchmark Consume", params);
+    }
+
+    return ezTime::Now() - t0;
+  }
+
+  /// Every task allocates and frees blocks in bursts, like component managers do while a world is created or streamed.
+  ezTime MeasureLargeBlockAllocator(ezUInt32 uiThreadCacheSize)
+  {
+    ezLargeBlockAllocator<s_uiBenchmarkBlockSize> allocator("Benchmark", ezFoundation::GetDefaultAllocator());
+    allocator.SetThreadCacheSize(uiThreadCacheSize);
+
+    // make sure the worker threads are running, otherwise ParallelFor executes everything on this thread
+    if (ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks) == 0)
+    {
+      ezTaskSystem::SetWorkerThreadCount();
+    }
+
+    ezParallelForParams params;
+    params.uiBinSize = 1;
+    params.uiMaxTasksPerThread = 4;
+
+    const ezTime t0 = ezTime::Now();
+
+    ezTaskSystem::ParallelForIndexed(
+      0, s_uiNumAllocatorThreadItems,
+      [&allocator](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+        ezHybridArray<ezDataBlock<ezUInt32, s_uiBenchmarkBlockSize>, 32> blocks;
+
+        for (ezUInt32 uiIndex = uiStartIndex; uiIndex < uiEndIndex; ++uiIndex)
+        {
+          for (ezUInt32 i = 0; i < s_uiNumBlockOperations; ++i)
+          {
+            // bursts of allocations followed by bursts of deallocations
+            if (blocks.GetCount() < 32 && ((i / 24) % 2) == 0)
+            {
+              blocks.PushBack(allocator.AllocateBlock<ezUInt32>());
+              *blocks.PeekBack().ReserveBack() = i;
+            }
+            else if (!blocks.IsEmpty())
+            {
+              allocator.DeallocateBlock(blocks.PeekBack());
+              blocks.PopBack();
+            }
+          }
+
+          for (auto& block : blocks)
+          {
+            allocator.DeallocateBlock(block);
+          }
+
+          blocks.Clear();
+        }
+      },
+      "LargeBlockAllocator Benchmark", params);
+
+    const ezTime t1 = ezTime::Now();
+
+    const ezMemoryTracker::ThreadCacheStats stats = ezMemoryTracker::GetThreadCacheStats(allocator.GetId());
+    ezLog::Info("[test]LargeBlockAllocator, thread cache size {}: {} hits, {} misses, {} flushes", uiThreadCacheSize, stats.m_uiNumHits,
+      stats.m_uiNumMisses, stats.m_uiNumFlushes);
+
+    return t1 - t0;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, Allocators)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "LargeBlockAllocator (Multi-Threaded)")
+  {
+    const ezTime tNoCache = MeasureLargeBlockAllocator(0);
+    const ezTime tCache = MeasureLargeBlockAllocator(ezLargeBlockAllocator<s_uiBenchmarkBlockSize>::DEFAULT_THREAD_CACHE_SIZE);
+
+    const ezUInt32 uiNumWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+    ezLog::Info("[test]LargeBlockAllocator, {} workers: without thread caches {} ms, with thread caches {} ms", uiNumWorkers,
+      ezArgF(tNoCache.GetMilliseconds(), 2), ezArgF(tCache.GetMilliseconds(), 2));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ScalableHeapAllocator (Multi-Threaded)")
+  {
+    const ezTime tHeap = MeasureHeapLocal<BenchmarkHeapAllocator>("BenchmarkHeap");
+    const ezTime tScalable = MeasureHeapLocal<BenchmarkScalableHeapAllocator>("BenchmarkScalableHeap");
+
+    const ezUInt32 uiNumWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+    ezLog::Info("[test]Heap, {} workers, thread local frees: ezHeapAllocator {} ms, ezScalableHeapAllocator {} ms", uiNumWorkers,
+      ezArgF(tHeap.GetMilliseconds(), 2), ezArgF(tScalable.GetMilliseconds(), 2));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ScalableHeapAllocator (Cross-Thread Frees)")
+  {
+    const ezTime tHeap = MeasureHeapCrossThread<BenchmarkHeapAllocator>("BenchmarkHeap");
+    const ezTime tScalable = MeasureHeapCrossThread<BenchmarkScalableHeapAllocator>("BenchmarkScalableHeap");
+
+    const ezUInt32 uiNumWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+    ezLog::Info("[test]Heap, {} workers, cross-thread frees: ezHeapAllocator {} ms, ezScalableHeapAllocator {} ms", uiNumWorkers,
+      ezArgF(tHeap.GetMilliseconds(), 2), ezArgF(tScalable.GetMilliseconds(), 2));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "MemoryTracker (Multi-Threaded)")
+  {
+    const ezTime tUntracked = MeasureHeapLocal<BenchmarkHeapAllocator>("BenchmarkHeap");
+    const ezTime tTracked = MeasureHeapLocal<BenchmarkTrackedHeapAllocator>("BenchmarkTrackedHeap");
+
+    const ezUInt32 uiNumWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+    ezLog::Info("[test]MemoryTracker, {} workers: without allocation tracking {} ms, with allocation tracking {} ms", uiNumWorkers,
+      ezArgF(tUntracked.GetMilliseconds(), 2), ezArgF(tTracked.GetMilliseconds(), 2));
+  }
+}
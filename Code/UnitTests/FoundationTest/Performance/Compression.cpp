@@ -0,0 +1,156 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/CompressedStreamZstd.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Time/Stopwatch.h>
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+
+namespace
+{
+#  if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+  static constexpr ezUInt32 s_uiNumCompressionBenchmarkFiles = 300;
+#  else
+  static constexpr ezUInt32 s_uiNumCompressionBenchmarkFiles = 3000;
+#  endif
+  static constexpr ezUInt32 s_uiCompressionBenchmarkDictionarySize = 110 * 1024;
+
+  /// Generates the kind of small text files that make up most of an asset archive: materials, prefabs and collections.
+  void CreateCompressionBenchmarkFile(ezUInt32 uiFile, ezDynamicArray<ezUInt8>& out_Content)
+  {
+    ezStringBuilder sText;
+
+    switch (uiFile % 3)
+    {
+      case 0:
+        sText.AppendFormat("Material \"Materials/Level{}/Material{}.ezMaterial\"\n{\n", uiFile % 11, uiFile);
+        sText.AppendFormat("  Shader = \"Shaders/Materials/{}.ezShader\"\n", (uiFile % 2) ? "DefaultMaterial" : "CutoutMaterial");
+        sText.AppendFormat("  BaseColor = Color({}, {}, {}, 1.0)\n", (uiFile * 7) % 100, (uiFile * 13) % 100, (uiFile * 31) % 100);
+        sText.Append("  BLEND_MODE = BLEND_MODE_OPAQUE\n  SHADING_MODE = SHADING_MODE_LIT\n  TWO_SIDED = false\n");
+        sText.AppendFormat("  BaseTexture = \"Textures/Level{}/Texture{}_D.ezTexture2D\"\n", uiFile % 11, uiFile / 5);
+        sText.AppendFormat("  NormalTexture = \"Textures/Level{}/Texture{}_N.ezTexture2D\"\n", uiFile % 11, uiFile / 5);
+        sText.AppendFormat("  RoughnessValue = {}\n  MetallicValue = 0.0\n}\n", (uiFile % 10) / 10.0f);
+        break;
+
+      case 1:
+        sText.AppendFormat("Prefab \"Prefabs/Level{}/Prefab{}.ezPrefab\"\n{\n", uiFile % 11, uiFile);
+        for (ezUInt32 uiObject = 0; uiObject < 1 + uiFile % 5; ++uiObject)
+        {
+          sText.AppendFormat("  GameObject \"Object{}\"\n  {\n", uiObject);
+          sText.AppendFormat("    LocalPosition = Vec3({}, {}, {})\n", (uiFile * 17 + uiObject) % 50, (uiFile * 5) % 20, uiObject);
+          sText.Append("    LocalRotation = Quat(0.0, 0.0, 0.0, 1.0)\n    LocalScaling = Vec3(1.0, 1.0, 1.0)\n");
+          sText.AppendFormat("    MeshComponent\n    {\n      Mesh = \"Meshes/Level{}/Mesh{}.ezMesh\"\n", uiFile % 11, (uiFile + uiObject) % 97);
+          sText.Append("      Color = Color(1.0, 1.0, 1.0, 1.0)\n      CastShadows = true\n    }\n  }\n");
+        }
+        sText.Append("}\n");
+        break;
+
+      default:
+        sText.AppendFormat("Collection \"Collections/Level{}/Collection{}.ezCollection\"\n{\n", uiFile % 11, uiFile);
+        for (ezUInt32 uiResource = 0; uiResource < 5 + uiFile % 20; ++uiResource)
+        {
+          sText.AppendFormat("  Resource = \"Meshes/Level{}/Mesh{}.ezMesh\"\n", uiFile % 11, (uiFile * 3 + uiResource) % 97);
+        }
+        sText.Append("}\n");
+        break;
+    }
+
+    out_Content.Clear();
+    out_Content.PushBackRange(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(sText.GetData()), sText.GetElementCount()));
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, ZstdDictionary)
+{
+  ezDynamicArray<ezDynamicArray<ezUInt8>> files;
+  files.SetCount(s_uiNumCompressionBenchmarkFiles);
+
+  ezDynamicArray<ezArrayPtr<const ezUInt8>> samples;
+  ezUInt64 uiTotalBytes = 0;
+
+  for (ezUInt32 i = 0; i < files.GetCount(); ++i)
+  {
+    CreateCompressionBenchmarkFile(i, files[i]);
+    samples.PushBack(files[i].GetArrayPtr());
+    uiTotalBytes += files[i].GetCount();
+  }
+
+  ezZstdDictionary dictionary;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Train")
+  {
+    ezStopwatch sw;
+
+    ezDynamicArray<ezUInt8> dictionaryData;
+    ezZstdDictionary::Train(samples, s_uiCompressionBenchmarkDictionarySize, dictionaryData);
+    EZ_TEST_BOOL(dictionary.Initialize(dictionaryData, true).Succeeded());
+
+    ezLog::Info("[test]Training a {} KB dictionary from {} files ({} KB): {} ms", dictionaryData.GetCount() / 1024, files.GetCount(),
+      uiTotalBytes / 1024, ezArgF(sw.GetRunningTotal().GetMilliseconds(), 1));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Dictionary vs. No Dictionary")
+  {
+    if (!dictionary.IsInitialized())
+      return;
+
+    ezUInt64 uiCompressedBytes[2] = {0, 0};
+
+    for (ezUInt32 uiUseDictionary = 0; uiUseDictionary < 2; ++uiUseDictionary)
+    {
+      const ezZstdDictionary* pDictionary = uiUseDictionary ? &dictionary : nullptr;
+
+      // every file is compressed as a separate stream, like the entries of an ezArchive
+      ezDynamicArray<ezDynamicArray<ezUInt8>> compressed;
+      compressed.SetCount(files.GetCount());
+
+      ezCompressedStreamWriterZstd compressor;
+      ezStopwatch swCompress;
+
+      for (ezUInt32 i = 0; i < files.GetCount(); ++i)
+      {
+        ezMemoryStreamContainerWrapperStorage<ezDynamicArray<ezUInt8>> storage(&compressed[i]);
+        ezMemoryStreamWriter writer(&storage);
+
+        compressor.SetOutputStream(&writer, ezCompressedStreamWriterZstd::Compression::Default, 4, pDictionary);
+        compressor.WriteBytes(files[i].GetData(), files[i].GetCount()).IgnoreResult();
+        compressor.FinishCompressedStream().IgnoreResult();
+
+        uiCompressedBytes[uiUseDictionary] += compressed[i].GetCount();
+      }
+
+      const ezTime tCompress = swCompress.GetRunningTotal();
+
+      ezCompressedStreamReaderZstd decompressor;
+      ezDynamicArray<ezUInt8> decompressed;
+      bool bContentCorrect = true;
+
+      ezStopwatch swDecompress;
+
+      for (ezUInt32 i = 0; i < files.GetCount(); ++i)
+      {
+        ezMemoryStreamContainerWrapperStorage<ezDynamicArray<ezUInt8>> storage(&compressed[i]);
+        ezMemoryStreamReader reader(&storage);
+
+        decompressor.SetInputStream(&reader, pDictionary);
+        decompressed.SetCountUninitialized(files[i].GetCount());
+        bContentCorrect &= decompressor.ReadBytes(decompressed.GetData(), decompressed.GetCount()) == files[i].GetCount();
+        bContentCorrect &= ezMemoryUtils::IsEqual(decompressed.GetData(), files[i].GetData(), files[i].GetCount());
+      }
+
+      const ezTime tDecompress = swDecompress.GetRunningTotal();
+
+      EZ_TEST_BOOL(bContentCorrect);
+
+      ezLog::Info("[test]{}: {} files, {} KB -> {} KB (ratio {}), compress: {} ms, decompress: {} ms ({} MB/s)",
+        uiUseDictionary ? "Dictionary" : "No dictionary", files.GetCount(), uiTotalBytes / 1024, uiCompressedBytes[uiUseDictionary] / 1024,
+        ezArgF((double)uiTotalBytes / uiCompressedBytes[uiUseDictionary], 2), ezArgF(tCompress.GetMilliseconds(), 1),
+        ezArgF(tDecompress.GetMilliseconds(), 1), ezArgF(uiTotalBytes / (1024.0 * 1024.0) / tDecompress.GetSeconds(), 1));
+    }
+
+    EZ_TEST_BOOL(uiCompressedBytes[1] < uiCompressedBytes[0]);
+  }
+}
+
+#endif
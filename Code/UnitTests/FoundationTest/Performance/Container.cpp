@@ -1,6 +1,11 @@
 #include <FoundationTestPCH.h>
 
+#include <Foundation/Containers/ArrayMap.h>
+#include <Foundation/Containers/BTreeMap.h>
 #include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Containers/Map.h>
+#include <Foundation/Containers/SwissHashTable.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Reflection/Reflection.h>
 #include <Foundation/Strings/String.h>
@@ -75,6 +80,161 @@ namespace
 
   ezUInt32 SomeBigObject::constructionCount = 0;
   ezUInt32 SomeBigObject::destructionCount = 0;
+
+  // spreads the keys like pointers, odd keys are never inserted and are used for unsuccessful lookups
+  EZ_ALWAYS_INLINE ezUInt64 GetHashTableBenchmarkKey(ezUInt32 i)
+  {
+    return (static_cast<ezUInt64>(i) * 0x9E3779B97F4A7C15ull) & ~1ull;
+  }
+
+  template <typename TABLE>
+  void BenchmarkHashTable(const char* szName, ezUInt32 uiSize)
+  {
+    // small tables are filled several times, so that every measurement covers roughly the same number of operations
+    const ezUInt32 uiNumRepeats = ezMath::Max(1u, 1000000u / uiSize);
+
+    ezTime tInsert, tHit, tMiss, tErase;
+    ezUInt32 uiSum = 0;
+
+    for (ezUInt32 r = 0; r < uiNumRepeats; ++r)
+    {
+      TABLE table;
+
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiSize; ++i)
+      {
+        table.Insert(GetHashTableBenchmarkKey(i), i);
+      }
+
+      ezTime t1 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiSize; ++i)
+      {
+        uiSum += *table.GetValue(GetHashTableBenchmarkKey(i));
+      }
+
+      ezTime t2 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiSize; ++i)
+      {
+        uiSum += table.Contains(GetHashTableBenchmarkKey(i) | 1) ? 1 : 0;
+      }
+
+      ezTime t3 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiSize; ++i)
+      {
+        table.Remove(GetHashTableBenchmarkKey(i));
+      }
+
+      ezTime t4 = ezTime::Now();
+
+      tInsert += t1 - t0;
+      tHit += t2 - t1;
+      tMiss += t3 - t2;
+      tErase += t4 - t3;
+    }
+
+    const double fNumOps = static_cast<double>(uiSize) * uiNumRepeats;
+    ezLog::Info("[test]{0}<ezUInt64, ezUInt32> {1} entries: insert {2}ns, hit {3}ns, miss {4}ns, erase {5}ns", szName, uiSize,
+      ezArgF(tInsert.GetNanoseconds() / fNumOps, 1), ezArgF(tHit.GetNanoseconds() / fNumOps, 1), ezArgF(tMiss.GetNanoseconds() / fNumOps, 1),
+      ezArgF(tErase.GetNanoseconds() / fNumOps, 1), uiSum);
+  }
+
+  template <typename MAP>
+  void BenchmarkOrderedMap(const char* szName, ezUInt32 uiSize)
+  {
+    const ezUInt32 uiNumRepeats = ezMath::Max(1u, 1000000u / uiSize);
+
+    ezTime tInsert, tLookup, tIterate, tMixed;
+    ezUInt64 uiSum = 0;
+
+    for (ezUInt32 r = 0; r < uiNumRepeats; ++r)
+    {
+      MAP map;
+
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiSize; ++i)
+      {
+        map.Insert(GetHashTableBenchmarkKey(i), i);
+      }
+
+      // look up in a different order than inserted, otherwise ezMap would find its nodes in allocation order
+      ezTime t1 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiSize; ++i)
+      {
+        uiSum += *map.GetValue(GetHashTableBenchmarkKey(static_cast<ezUInt32>((i * 7919ull) % uiSize)));
+      }
+
+      ezTime t2 = ezTime::Now();
+      for (auto it : map)
+      {
+        uiSum += it.Value();
+      }
+
+      // every step replaces the oldest element and looks up another one, so the size stays the same
+      ezTime t3 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiSize; ++i)
+      {
+        map.Insert(GetHashTableBenchmarkKey(uiSize + i), i);
+        uiSum += map.Contains(GetHashTableBenchmarkKey(i + uiSize / 2)) ? 1 : 0;
+        map.Remove(GetHashTableBenchmarkKey(i));
+      }
+
+      ezTime t4 = ezTime::Now();
+
+      tInsert += t1 - t0;
+      tLookup += t2 - t1;
+      tIterate += t3 - t2;
+      tMixed += t4 - t3;
+    }
+
+    const double fNumOps = static_cast<double>(uiSize) * uiNumRepeats;
+    ezLog::Info("[test]{0}<ezUInt64, ezUInt32> {1} entries: insert {2}ns, lookup {3}ns, iterate {4}ns, mixed {5}ns", szName, uiSize,
+      ezArgF(tInsert.GetNanoseconds() / fNumOps, 1), ezArgF(tLookup.GetNanoseconds() / fNumOps, 1),
+      ezArgF(tIterate.GetNanoseconds() / fNumOps, 1), ezArgF(tMixed.GetNanoseconds() / fNumOps, 1), uiSum);
+  }
+
+  /// ezArrayMap is only sorted on demand, so it is measured for its intended use: fill once, then only look up.
+  void BenchmarkArrayMap(ezUInt32 uiSize)
+  {
+    const ezUInt32 uiNumRepeats = ezMath::Max(1u, 1000000u / uiSize);
+
+    ezTime tInsert, tLookup, tIterate;
+    ezUInt64 uiSum = 0;
+
+    for (ezUInt32 r = 0; r < uiNumRepeats; ++r)
+    {
+      ezArrayMap<ezUInt64, ezUInt32> map;
+
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiSize; ++i)
+      {
+        map.Insert(GetHashTableBenchmarkKey(i), i);
+      }
+      map.Sort();
+
+      ezTime t1 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiSize; ++i)
+      {
+        uiSum += map.GetValue(map.Find(GetHashTableBenchmarkKey(static_cast<ezUInt32>((i * 7919ull) % uiSize))));
+      }
+
+      ezTime t2 = ezTime::Now();
+      for (const auto& pair : map.GetData())
+      {
+        uiSum += pair.value;
+      }
+
+      ezTime t3 = ezTime::Now();
+
+      tInsert += t1 - t0;
+      tLookup += t2 - t1;
+      tIterate += t3 - t2;
+    }
+
+    const double fNumOps = static_cast<double>(uiSize) * uiNumRepeats;
+    ezLog::Info("[test]ezArrayMap<ezUInt64, ezUInt32> {0} entries: insert+sort {1}ns, lookup {2}ns, iterate {3}ns", uiSize,
+      ezArgF(tInsert.GetNanoseconds() / fNumOps, 1), ezArgF(tLookup.GetNanoseconds() / fNumOps, 1),
+      ezArgF(tIterate.GetNanoseconds() / fNumOps, 1), uiSum);
+  }
 } // namespace
 
 // Enable when needed
@@ -423,4 +583,35 @@ EZ_CREATE_SIMPLE_TEST(Performance, Container)
         ezArgF((t1 - t0).GetMilliseconds() / static_cast<double>(NUM_SAMPLES), 4), sum);
     }
   }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "ezHashTable vs. ezSwissHashTable")
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+    const ezUInt32 uiMaxSize = 1000 * 1000;
+#else
+    const ezUInt32 uiMaxSize = 10 * 1000 * 1000;
+#endif
+
+    for (ezUInt32 uiSize = 1000; uiSize <= uiMaxSize; uiSize *= 10)
+    {
+      BenchmarkHashTable<ezHashTable<ezUInt64, ezUInt32>>("ezHashTable", uiSize);
+      BenchmarkHashTable<ezSwissHashTable<ezUInt64, ezUInt32>>("ezSwissHashTable", uiSize);
+    }
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "ezMap vs. ezBTreeMap vs. ezArrayMap")
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+    const ezUInt32 uiMaxSize = 100 * 1000;
+#else
+    const ezUInt32 uiMaxSize = 1000 * 1000;
+#endif
+
+    for (ezUInt32 uiSize = 100; uiSize <= uiMaxSize; uiSize *= 10)
+    {
+      BenchmarkOrderedMap<ezMap<ezUInt64, ezUInt32>>("ezMap", uiSize);
+      BenchmarkOrderedMap<ezBTreeMap<ezUInt64, ezUInt32>>("ezBTreeMap", uiSize);
+      BenchmarkArrayMap(uiSize);
+    }
+  }
 }
@@ -0,0 +1,183 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/AsyncFileReader.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Time/Stopwatch.h>
+
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+namespace
+{
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+  static constexpr ezUInt32 s_uiNumSmallFiles = 500;
+#else
+  static constexpr ezUInt32 s_uiNumSmallFiles = 4000;
+#endif
+  static constexpr ezUInt32 s_uiMaxReadsInFlight = 64;
+
+  void GetSmallFilePath(ezUInt32 uiFile, ezStringBuilder& out_sPath)
+  {
+    out_sPath = ezTestFramework::GetInstance()->GetAbsOutputPath();
+    out_sPath.MakeCleanPath();
+    out_sPath.AppendPath("FileLoadingPerf");
+    out_sPath.AppendFormat("/File{0}.bin", uiFile);
+  }
+
+  ezUInt32 GetSmallFileSize(ezUInt32 uiFile)
+  {
+    // typical sizes of small resources, between 1 KB and 32 KB
+    return 1024 + (uiFile * 7919) % (31 * 1024);
+  }
+
+  /// Removes the files from the page cache where possible, so that they actually have to be read from disk.
+  /// Returns false, if the benchmark will run with a warm cache.
+  bool EvictFromPageCache()
+  {
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+    ezStringBuilder sPath;
+    for (ezUInt32 i = 0; i < s_uiNumSmallFiles; ++i)
+    {
+      GetSmallFilePath(i, sPath);
+
+      ezOSFile file;
+      if (file.Open(sPath, ezFileOpenMode::Read).Failed())
+        return false;
+
+      const int fd = fileno(file.GetFileData().m_pFileHandle);
+      if (posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) != 0)
+        return false;
+    }
+
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  ezUInt64 ReadFilesSequentially()
+  {
+    ezUInt64 uiBytesRead = 0;
+    ezDynamicArray<ezUInt8> content;
+    ezStringBuilder sPath;
+
+    for (ezUInt32 i = 0; i < s_uiNumSmallFiles; ++i)
+    {
+      GetSmallFilePath(i, sPath);
+
+      ezOSFile file;
+      if (file.Open(sPath, ezFileOpenMode::Read).Succeeded())
+      {
+        uiBytesRead += file.ReadAll(content);
+      }
+    }
+
+    return uiBytesRead;
+  }
+
+  ezUInt64 ReadFilesAsync(bool bAllowIoUring)
+  {
+    ezAsyncFileReader reader(s_uiMaxReadsInFlight, bAllowIoUring);
+
+    ezOSFile files[s_uiMaxReadsInFlight];
+    ezDynamicArray<ezUInt8> buffers[s_uiMaxReadsInFlight];
+    ezHybridArray<ezUInt32, s_uiMaxReadsInFlight> freeSlots;
+    ezDynamicArray<ezAsyncFileReader::Completion> completions;
+
+    for (ezUInt32 i = 0; i < s_uiMaxReadsInFlight; ++i)
+    {
+      freeSlots.PushBack(i);
+    }
+
+    ezUInt64 uiBytesRead = 0;
+    ezStringBuilder sPath;
+
+    for (ezUInt32 uiNextFile = 0; uiNextFile < s_uiNumSmallFiles || reader.GetNumPendingReads() > 0;)
+    {
+      // keep as many reads in flight as possible, this is how the resource manager loads files
+      for (; uiNextFile < s_uiNumSmallFiles && !freeSlots.IsEmpty(); ++uiNextFile)
+      {
+        const ezUInt32 uiSlot = freeSlots.PeekBack();
+        GetSmallFilePath(uiNextFile, sPath);
+
+        if (files[uiSlot].Open(sPath, ezFileOpenMode::Read).Failed())
+          continue;
+
+        freeSlots.PopBack();
+        buffers[uiSlot].SetCountUninitialized(static_cast<ezUInt32>(files[uiSlot].GetFileSize()));
+        reader.SubmitRead(files[uiSlot], 0, buffers[uiSlot].GetData(), buffers[uiSlot].GetCount(), uiSlot);
+      }
+
+      completions.Clear();
+      reader.WaitForCompletions(completions);
+
+      for (const auto& completion : completions)
+      {
+        const ezUInt32 uiSlot = static_cast<ezUInt32>(completion.m_uiUserData);
+        uiBytesRead += completion.m_uiBytesRead;
+        files[uiSlot].Close();
+        freeSlots.PushBack(uiSlot);
+      }
+    }
+
+    return uiBytesRead;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, FileLoading)
+{
+  ezUInt64 uiTotalBytes = 0;
+
+  {
+    ezDynamicArray<ezUInt8> content;
+    ezStringBuilder sPath;
+
+    for (ezUInt32 i = 0; i < s_uiNumSmallFiles; ++i)
+    {
+      content.SetCount(GetSmallFileSize(i), static_cast<ezUInt8>(i));
+      uiTotalBytes += content.GetCount();
+
+      GetSmallFilePath(i, sPath);
+
+      ezOSFile file;
+      if (EZ_TEST_BOOL(file.Open(sPath, ezFileOpenMode::Write).Succeeded()).Failed())
+        return;
+
+      EZ_TEST_BOOL(file.Write(content.GetData(), content.GetCount()).Succeeded());
+
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+      // dirty pages cannot be evicted from the page cache
+      fsync(fileno(file.GetFileData().m_pFileHandle));
+#endif
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Small Files")
+  {
+    auto Measure = [&](const char* szName, auto func) {
+      const bool bCold = EvictFromPageCache();
+
+      ezStopwatch sw;
+      const ezUInt64 uiBytesRead = func();
+      const ezTime t = sw.GetRunningTotal();
+
+      EZ_TEST_INT(uiBytesRead, uiTotalBytes);
+
+      ezLog::Info("[test]{} {} files ({} KB, {} cache): {} ms", szName, s_uiNumSmallFiles, uiTotalBytes / 1024, bCold ? "cold" : "warm",
+        ezArgF(t.GetMilliseconds(), 1));
+    };
+
+    Measure("Sequential ezOSFile::ReadAll,", []() { return ReadFilesSequentially(); });
+    Measure("ezAsyncFileReader (ezTaskSystem),", []() { return ReadFilesAsync(false); });
+    Measure("ezAsyncFileReader (io_uring if available),", []() { return ReadFilesAsync(true); });
+  }
+
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS) && EZ_ENABLED(EZ_SUPPORTS_FILE_STATS)
+  ezStringBuilder sFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sFolder.AppendPath("FileLoadingPerf");
+  ezOSFile::DeleteFolder(sFolder).IgnoreResult();
+#endif
+}
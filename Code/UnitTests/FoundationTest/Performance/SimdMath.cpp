@@ -0,0 +1,205 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/SimdMath/SimdBBoxSphereBatch.h>
+#include <Foundation/SimdMath/SimdKernels.h>
+#include <Foundation/SimdMath/SimdVec8f.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  static constexpr ezUInt32 s_uiNumSimdElements = 64 * 1024;
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+  static constexpr ezUInt32 s_uiNumSimdIterations = 4;
+#else
+  static constexpr ezUInt32 s_uiNumSimdIterations = 64;
+#endif
+
+  const char* GetSimdKernelBackendName(ezSimdKernelBackend::Enum backend)
+  {
+    return backend == ezSimdKernelBackend::AVX2 ? "AVX2" : "Default";
+  }
+
+  template <typename Func>
+  void MeasureSimdKernel(const char* szName, Func func)
+  {
+    const ezSimdKernelBackend::Enum previousBackend = ezSimdKernels::GetBackend();
+
+    for (ezUInt32 uiBackend = 0; uiBackend < ezSimdKernelBackend::ENUM_COUNT; ++uiBackend)
+    {
+      const ezSimdKernelBackend::Enum backend = static_cast<ezSimdKernelBackend::Enum>(uiBackend);
+      if (!ezSimdKernels::IsBackendSupported(backend))
+        continue;
+
+      ezSimdKernels::SetBackend(backend);
+
+      const ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < s_uiNumSimdIterations; ++i)
+      {
+        func();
+      }
+      const ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]{} ({}): {} ms", szName, GetSimdKernelBackendName(backend), ezArgF((t1 - t0).GetMilliseconds() / s_uiNumSimdIterations, 4));
+    }
+
+    ezSimdKernels::SetBackend(previousBackend);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, SimdMath)
+{
+  ezDynamicArray<ezSimdVec4f> positions;
+  positions.SetCountUninitialized(s_uiNumSimdElements);
+  for (ezUInt32 i = 0; i < s_uiNumSimdElements; ++i)
+  {
+    positions[i] = ezSimdVec4f((float)(i % 97), (float)(i % 89), (float)(i % 83), 1.0f);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "TransformPositions")
+  {
+    ezSimdMat4f m;
+    m.SetIdentity();
+    m.m_col3 = ezSimdVec4f(1, 2, 3, 1);
+
+    ezDynamicArray<ezSimdVec4f> output;
+    output.SetCountUninitialized(s_uiNumSimdElements);
+
+    MeasureSimdKernel("TransformPositions, 64k", [&]() { ezSimdKernels::TransformPositions(m, positions, output); });
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "CullSpheres")
+  {
+    ezDynamicArray<ezSimdBSphere> spheres;
+    for (const ezSimdVec4f& pos : positions)
+    {
+      spheres.PushBack(ezSimdBSphere(pos - ezSimdVec4f(48.0f), 2.0f));
+    }
+
+    ezSimdVec4f planes[6] = {
+      ezSimdVec4f(1, 0, 0, -30),
+      ezSimdVec4f(-1, 0, 0, -30),
+      ezSimdVec4f(0, 1, 0, -30),
+      ezSimdVec4f(0, -1, 0, -30),
+      ezSimdVec4f(0, 0, 1, -30),
+      ezSimdVec4f(0, 0, -1, -30),
+    };
+
+    ezDynamicArray<ezUInt32> visible;
+    visible.SetCountUninitialized(spheres.GetCount());
+
+    MeasureSimdKernel("CullSpheres, 64k", [&]() { ezSimdKernels::CullSpheres(ezMakeArrayPtr(planes), spheres, visible); });
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "MulAdd")
+  {
+    ezDynamicArray<float> values;
+    ezDynamicArray<float> velocities;
+    values.SetCount(s_uiNumSimdElements * 4);
+    velocities.SetCount(s_uiNumSimdElements * 4, 1.0f);
+
+    MeasureSimdKernel("MulAdd, 256k", [&]() { ezSimdKernels::MulAdd(values, velocities, 0.016f); });
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ezSimdVec4f vs. ezSimdVec8f")
+  {
+    ezDynamicArray<float> values;
+    values.SetCount(s_uiNumSimdElements * 4, 0.5f);
+    const float* pValues = values.GetData();
+    const ezUInt32 uiCount = values.GetCount();
+
+    ezSimdVec4f sum4 = ezSimdVec4f::ZeroVector();
+    const ezTime t0 = ezTime::Now();
+    for (ezUInt32 n = 0; n < s_uiNumSimdIterations; ++n)
+    {
+      for (ezUInt32 i = 0; i < uiCount; i += 4)
+      {
+        ezSimdVec4f v;
+        v.Load<4>(pValues + i);
+        sum4 = ezSimdVec4f::MulAdd(v, v, sum4);
+      }
+    }
+    const ezTime t1 = ezTime::Now();
+
+    ezSimdVec8f sum8 = ezSimdVec8f::ZeroVector();
+    for (ezUInt32 n = 0; n < s_uiNumSimdIterations; ++n)
+    {
+      for (ezUInt32 i = 0; i < uiCount; i += 8)
+      {
+        ezSimdVec8f v;
+        v.Load(pValues + i);
+        sum8 = ezSimdVec8f::MulAdd(v, v, sum8);
+      }
+    }
+    const ezTime t2 = ezTime::Now();
+
+    EZ_TEST_FLOAT(sum4.HorizontalSum<4>(), sum8.HorizontalSum(), 0.0f);
+
+    ezLog::Info("[test]Sum of squares, 256k: ezSimdVec4f {} ms, ezSimdVec8f {} ms (native: {})", ezArgF((t1 - t0).GetMilliseconds() / s_uiNumSimdIterations, 4),
+      ezArgF((t2 - t1).GetMilliseconds() / s_uiNumSimdIterations, 4), EZ_ENABLED(EZ_SIMD_NATIVE_VEC8));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ezSimdTransform vs. ezSimdTransformBatch")
+  {
+    // concatenate transforms and transform bounds the way the world updates its hierarchy
+    const ezUInt32 uiCount = s_uiNumSimdElements;
+
+    ezDynamicArray<ezSimdTransform> parents;
+    ezDynamicArray<ezSimdTransform> locals;
+    ezDynamicArray<ezSimdBBoxSphere> localBounds;
+    ezDynamicArray<ezSimdTransform> globals;
+    ezDynamicArray<ezSimdBBoxSphere> globalBounds;
+    globals.SetCountUninitialized(uiCount);
+    globalBounds.SetCountUninitialized(uiCount);
+
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      ezSimdQuat q;
+      q.SetFromAxisAndAngle(ezSimdVec4f(0, 0, 1), (float)(i % 31) * 0.1f);
+
+      parents.PushBack(ezSimdTransform(positions[i], q, ezSimdVec4f(1.0f + (i % 3))));
+      locals.PushBack(ezSimdTransform(positions[(i * 7) % uiCount], q, ezSimdVec4f(0.5f)));
+      localBounds.PushBack(ezSimdBBoxSphere(ezSimdVec4f::ZeroVector(), ezSimdVec4f(1.0f, 2.0f, 3.0f), 3.75f));
+    }
+
+    const ezTime t0 = ezTime::Now();
+    for (ezUInt32 n = 0; n < s_uiNumSimdIterations; ++n)
+    {
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        globals[i].SetGlobalTransform(parents[i], locals[i]);
+        globalBounds[i] = localBounds[i];
+        globalBounds[i].Transform(globals[i]);
+      }
+    }
+    const ezTime t1 = ezTime::Now();
+
+    const ezSimdBBoxSphere scalarBounds = globalBounds[uiCount - 1];
+
+    for (ezUInt32 n = 0; n < s_uiNumSimdIterations; ++n)
+    {
+      for (ezUInt32 i = 0; i < uiCount; i += ezSimdBatchTraits<ezSimdBatchVec>::NumLanes)
+      {
+        const ezUInt32 uiBatchCount = ezMath::Min<ezUInt32>(uiCount - i, ezSimdBatchTraits<ezSimdBatchVec>::NumLanes);
+
+        ezSimdTransformBatchDefault parentBatch, localBatch;
+        parentBatch.Load(parents.GetData() + i, uiBatchCount);
+        localBatch.Load(locals.GetData() + i, uiBatchCount);
+
+        const ezSimdTransformBatchDefault globalBatch = parentBatch * localBatch;
+        globalBatch.Store(globals.GetData() + i, uiBatchCount);
+
+        ezSimdBBoxSphereBatchDefault boundsBatch;
+        boundsBatch.Load(localBounds.GetData() + i, uiBatchCount);
+        boundsBatch.Transform(globalBatch);
+        boundsBatch.Store(globalBounds.GetData() + i, uiBatchCount);
+      }
+    }
+    const ezTime t2 = ezTime::Now();
+
+    EZ_TEST_BOOL(globalBounds[uiCount - 1].m_CenterAndRadius.IsEqual(scalarBounds.m_CenterAndRadius, 0.01f).AllSet<4>());
+
+    ezLog::Info("[test]Transform hierarchy level, 64k: ezSimdTransform {} ms, ezSimdTransformBatch {} ms ({} lanes)",
+      ezArgF((t1 - t0).GetMilliseconds() / s_uiNumSimdIterations, 4), ezArgF((t2 - t1).GetMilliseconds() / s_uiNumSimdIterations, 4),
+      (ezUInt32)ezSimdBatchTraits<ezSimdBatchVec>::NumLanes);
+  }
+}
@@ -0,0 +1,82 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Algorithm/ParallelSorting.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  struct SortBenchmarkElement
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt64 m_uiKey;
+    const void* m_pPayload;
+  };
+
+  struct SortBenchmarkComparer
+  {
+    EZ_ALWAYS_INLINE bool Less(const SortBenchmarkElement& a, const SortBenchmarkElement& b) const { return a.m_uiKey < b.m_uiKey; }
+  };
+
+  template <typename Func>
+  double MeasureSort(const ezDynamicArray<SortBenchmarkElement>& input, ezDynamicArray<SortBenchmarkElement>& data, ezUInt32 uiNumRepeats, Func func)
+  {
+    ezTime tTotal;
+
+    for (ezUInt32 r = 0; r < uiNumRepeats; ++r)
+    {
+      data = input;
+
+      const ezTime t0 = ezTime::Now();
+      func();
+      tTotal += ezTime::Now() - t0;
+    }
+
+    return tTotal.GetMicroseconds() / uiNumRepeats;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, Sorting)
+{
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+  const ezUInt32 uiMaxCount = 100 * 1000;
+#else
+  const ezUInt32 uiMaxCount = 1000 * 1000;
+#endif
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "QuickSort vs. MergeSort vs. RadixSort")
+  {
+    ezDynamicArray<SortBenchmarkElement> input;
+    ezDynamicArray<SortBenchmarkElement> data;
+    ezDynamicArray<SortBenchmarkElement> scratch;
+
+    for (ezUInt32 uiCount = 1000; uiCount <= uiMaxCount; uiCount *= 10)
+    {
+      input.SetCountUninitialized(uiCount);
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        // render data sorting keys, where the upper bits are mostly the same
+        input[i].m_uiKey = (static_cast<ezUInt64>(rand() % 16) << 48) | (static_cast<ezUInt64>(rand()) << 16) | (rand() & 0xFFFF);
+        input[i].m_pPayload = &input[i];
+      }
+      scratch.SetCountUninitialized(uiCount);
+
+      const ezUInt32 uiNumRepeats = ezMath::Max(1u, 1000000u / uiCount);
+
+      const double fQuickSort = MeasureSort(input, data, uiNumRepeats, [&]() { data.Sort(SortBenchmarkComparer()); });
+
+      const double fMergeSort =
+        MeasureSort(input, data, uiNumRepeats, [&]() { ezSorting::MergeSort(data.GetArrayPtr(), scratch.GetArrayPtr(), SortBenchmarkComparer()); });
+
+      const double fParallelMergeSort = MeasureSort(input, data, uiNumRepeats,
+        [&]() { ezParallelSorting::MergeSort(data.GetArrayPtr(), scratch.GetArrayPtr(), SortBenchmarkComparer()); });
+
+      const double fRadixSort = MeasureSort(input, data, uiNumRepeats,
+        [&]() { ezSorting::RadixSort(data.GetArrayPtr(), scratch.GetArrayPtr(), [](const SortBenchmarkElement& e) { return e.m_uiKey; }); });
+
+      ezLog::Info("[test]Sorting {} elements: QuickSort {}us, MergeSort {}us, ParallelMergeSort {}us, RadixSort {}us", uiCount, ezArgF(fQuickSort, 1),
+        ezArgF(fMergeSort, 1), ezArgF(fParallelMergeSort, 1), ezArgF(fRadixSort, 1));
+    }
+  }
+}
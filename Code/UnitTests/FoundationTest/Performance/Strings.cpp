@@ -0,0 +1,235 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Strings/HashedString.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Strings/StringConversion.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+  static constexpr ezUInt32 s_uiNumHashedStringAssignments = 20000;
+#else
+  static constexpr ezUInt32 s_uiNumHashedStringAssignments = 200000;
+#endif
+
+  static constexpr ezUInt32 s_uiNumHashedStringTasks = 64;
+
+  /// Every task assigns uiWorkingSetSize strings in a loop, the working sets of neighboring tasks overlap by half.
+  ezTime MeasureHashedStringAssign(const ezDynamicArray<ezString>& strings, ezUInt32 uiWorkingSetSize)
+  {
+    ezParallelForParams params;
+    params.uiBinSize = 1;
+    params.uiMaxTasksPerThread = 4;
+
+    const ezTime t0 = ezTime::Now();
+
+    ezTaskSystem::ParallelForIndexed(
+      0, s_uiNumHashedStringTasks,
+      [&strings, uiWorkingSetSize](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+        ezHashedString s;
+
+        for (ezUInt32 uiTask = uiStartIndex; uiTask < uiEndIndex; ++uiTask)
+        {
+          const ezUInt32 uiFirst = uiTask * uiWorkingSetSize / 2;
+
+          for (ezUInt32 i = 0; i < s_uiNumHashedStringAssignments / s_uiNumHashedStringTasks; ++i)
+          {
+            s.Assign(strings[(uiFirst + i % uiWorkingSetSize) % strings.GetCount()].GetData());
+          }
+        }
+      },
+      "HashedString Benchmark", params);
+
+    return ezTime::Now() - t0;
+  }
+
+  /// Does the string handling that loading a resource from a file does, ie. storing the resource ID, opening the file,
+  /// looking up its stats and storing its description. Returns the number of allocations per resource.
+  double MeasureAllocationsPerResource(const ezDynamicArray<ezString>& resourceIDs)
+  {
+    // only works when the default allocator tracks its allocations
+    ezAllocatorBase* pAllocator = ezFoundation::GetDefaultAllocator();
+    const ezUInt64 uiNumAllocations = pAllocator->GetStats().m_uiNumAllocations;
+
+    ezUInt8 buffer[64];
+
+    for (const ezString& sResourceID : resourceIDs)
+    {
+      // ezResource stores its ID as an ezString
+      ezString sID = sResourceID.GetData();
+      const char* szResourceID = sID.GetData();
+
+      ezFileReader file;
+      if (file.Open(szResourceID).Failed())
+        continue;
+
+      ezString sDescription = file.GetFilePathRelative().GetData();
+
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_STATS)
+      ezFileStats stats;
+      ezFileSystem::GetFileStats(szResourceID, stats).IgnoreResult();
+#endif
+
+      file.ReadBytes(buffer, EZ_ARRAY_SIZE(buffer));
+    }
+
+    return static_cast<double>(pAllocator->GetStats().m_uiNumAllocations - uiNumAllocations) / resourceIDs.GetCount();
+  }
+
+  /// Returns the throughput of func in MB/s, when it processes uiNumBytes per call.
+  template <typename Func>
+  double MeasureStringThroughput(ezUInt32 uiNumBytes, ezUInt32 uiNumRepeats, Func func)
+  {
+    const ezTime t0 = ezTime::Now();
+
+    for (ezUInt32 r = 0; r < uiNumRepeats; ++r)
+    {
+      func();
+    }
+
+    const ezTime t = ezTime::Now() - t0;
+    return (static_cast<double>(uiNumBytes) * uiNumRepeats / (1024.0 * 1024.0)) / t.GetSeconds();
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, Strings)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ezHashedString::Assign (Multi-Threaded)")
+  {
+    // make sure the worker threads are running, otherwise ParallelFor executes everything on this thread
+    if (ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks) == 0)
+    {
+      ezTaskSystem::SetWorkerThreadCount();
+    }
+
+    ezDynamicArray<ezString> strings;
+    ezStringBuilder sb;
+    for (ezUInt32 i = 0; i < 16 * 1024; ++i)
+    {
+      sb.Format("HashedStringBenchmark/Property_{}", i);
+      strings.PushBack(sb);
+    }
+
+    const ezUInt32 uiNumWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+
+    // the uncontended cost, for reference
+    {
+      ezHashedString s;
+
+      const ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < s_uiNumHashedStringAssignments; ++i)
+      {
+        s.Assign(strings[i % 4096].GetData());
+      }
+      const ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]ezHashedString::Assign, single thread, working set 4096: {} ns per assignment",
+        ezArgF((t1 - t0).GetNanoseconds() / s_uiNumHashedStringAssignments, 1));
+    }
+
+    // small working sets stay in the per-thread caches, large ones go to the shared storage
+    for (ezUInt32 uiWorkingSetSize : {16u, 256u, 4096u})
+    {
+      const ezTime t = MeasureHashedStringAssign(strings, uiWorkingSetSize);
+
+      ezLog::Info("[test]ezHashedString::Assign, {} workers, working set {}: {} ns per assignment", uiNumWorkers, uiWorkingSetSize,
+        ezArgF(t.GetNanoseconds() / s_uiNumHashedStringAssignments, 1));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Allocations per Loaded Resource")
+  {
+    ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+    sOutputFolder.AppendPath("StringAllocations");
+    EZ_TEST_BOOL(ezOSFile::CreateDirectoryStructure(sOutputFolder) == EZ_SUCCESS);
+
+    ezFileSystem::RegisterDataDirectoryFactory(ezDataDirectory::FolderType::Factory);
+    EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "StringAllocations", "output", ezFileSystem::AllowWrites) == EZ_SUCCESS);
+
+    // typical resource IDs, the absolute paths do not fit into the inline storage of ezStringBuilder
+    ezDynamicArray<ezString> resourceIDs;
+    ezStringBuilder sResourceID;
+    for (ezUInt32 i = 0; i < 64; ++i)
+    {
+      sResourceID.Format("AssetCache/PC/Textures/Environment/Rocks/Cliff_Moss_Variant_{}_Diffuse_Roughness.ezTexture2D", i);
+      resourceIDs.PushBack(sResourceID);
+
+      sResourceID.Prepend(":output/");
+
+      ezFileWriter file;
+      if (EZ_TEST_BOOL(file.Open(sResourceID) == EZ_SUCCESS).Succeeded())
+      {
+        EZ_TEST_BOOL(file.WriteBytes(sResourceID.GetData(), sResourceID.GetElementCount()) == EZ_SUCCESS);
+      }
+    }
+
+    // the first run initializes the file system data
+    MeasureAllocationsPerResource(resourceIDs);
+
+    const double fAllocations = MeasureAllocationsPerResource(resourceIDs);
+
+    ezLog::Info("[test]Allocations per loaded resource: {}", ezArgF(fAllocations, 2));
+
+    ezFileSystem::RemoveDataDirectoryGroup("StringAllocations");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Utf8 Processing")
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+    const ezUInt32 uiNumRepeats = 5;
+#else
+    const ezUInt32 uiNumRepeats = 50;
+#endif
+
+    // an asset path list, as it appears in JSON and OpenDDL documents, with an occasional non-ASCII name
+    ezStringBuilder sDocument;
+    for (ezUInt32 i = 0; i < 4096; ++i)
+    {
+      sDocument.AppendFormat("\"AssetCache/PC/Textures/Environment/Rocks/Cliff_Moss_Variant_{}_Diffuse_Roughness.ezTexture2D\",\n", i);
+
+      if (i % 64 == 0)
+        sDocument.Append(u8"\"H\u00e4user/Stra\u00dfe/\u6771\u4eac.ezPrefab\",\n");
+    }
+
+    ezStringBuilder sDocumentUpper = sDocument;
+    sDocumentUpper.ToUpper();
+
+    ezStringBuilder sDocumentChanged = sDocument;
+    sDocumentChanged.Append("x");
+
+    const ezUInt32 uiNumBytes = sDocument.GetElementCount();
+    const char* szDocument = sDocument.GetData();
+
+    ezStringUtf16 sUtf16(szDocument);
+    ezStringWChar sWChar(szDocument);
+
+    volatile ezUInt32 uiResult = 0;
+
+    const double fValidate = MeasureStringThroughput(uiNumBytes, uiNumRepeats, [&]() { uiResult += ezUnicodeUtils::IsValidUtf8(szDocument) ? 1 : 0; });
+    const double fCount = MeasureStringThroughput(uiNumBytes, uiNumRepeats, [&]() { uiResult += ezStringUtils::GetCharacterCount(szDocument); });
+    const double fCompare = MeasureStringThroughput(uiNumBytes, uiNumRepeats, [&]() { uiResult += ezStringUtils::Compare(szDocument, sDocumentChanged.GetData()); });
+    const double fCompareNoCase =
+      MeasureStringThroughput(uiNumBytes, uiNumRepeats, [&]() { uiResult += ezStringUtils::Compare_NoCase(szDocument, sDocumentUpper.GetData()); });
+    const double fFind = MeasureStringThroughput(uiNumBytes, uiNumRepeats, [&]() { uiResult += ezStringUtils::FindSubString(szDocument, "Variant_4095_") != nullptr ? 1 : 0; });
+    const double fFindNoCase =
+      MeasureStringThroughput(uiNumBytes, uiNumRepeats, [&]() { uiResult += ezStringUtils::FindSubString_NoCase(szDocument, "VARIANT_4095_") != nullptr ? 1 : 0; });
+    const double fToUtf16 = MeasureStringThroughput(uiNumBytes, uiNumRepeats, [&]() { uiResult += ezStringUtf16(szDocument).GetData()[0]; });
+    const double fToWChar = MeasureStringThroughput(uiNumBytes, uiNumRepeats, [&]() { uiResult += ezStringWChar(szDocument).GetData()[0]; });
+    const double fFromUtf16 = MeasureStringThroughput(uiNumBytes, uiNumRepeats, [&]() { uiResult += ezStringUtf8(sUtf16.GetData()).GetData()[0]; });
+    const double fFromWChar = MeasureStringThroughput(uiNumBytes, uiNumRepeats, [&]() { uiResult += ezStringUtf8(sWChar.GetData()).GetData()[0]; });
+
+    ezLog::Info("[test]Utf8 processing of {} KB: IsValidUtf8 {} MB/s, GetCharacterCount {} MB/s, Compare {} MB/s, Compare_NoCase {} MB/s", uiNumBytes / 1024,
+      ezArgF(fValidate, 0), ezArgF(fCount, 0), ezArgF(fCompare, 0), ezArgF(fCompareNoCase, 0));
+    ezLog::Info("[test]Utf8 processing of {} KB: FindSubString {} MB/s, FindSubString_NoCase {} MB/s", uiNumBytes / 1024, ezArgF(fFind, 0), ezArgF(fFindNoCase, 0));
+    ezLog::Info("[test]Utf8 conversion of {} KB: to Utf16 {} MB/s, to wchar_t {} MB/s, from Utf16 {} MB/s, from wchar_t {} MB/s", uiNumBytes / 1024,
+      ezArgF(fToUtf16, 0), ezArgF(fToWChar, 0), ezArgF(fFromUtf16, 0), ezArgF(fFromWChar, 0));
+  }
+}
@@ -0,0 +1,314 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/DelegateTask.h>
+#include <Foundation/Threading/ForkJoin.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+  static constexpr ezUInt32 s_uiNumRounds = 4;
+  static constexpr ezUInt32 s_uiNumSpawners = 8;
+  static constexpr ezUInt32 s_uiNumTasksPerSpawner = 256;
+  static constexpr ezUInt32 s_uiNumSmallGroups = 1024;
+  static constexpr ezUInt32 s_uiForkJoinDepth = 12;
+  static constexpr ezUInt32 s_uiNumCheapItems = 100000;
+  static constexpr ezUInt32 s_uiNumExpensiveItems = 1000;
+#else
+  static constexpr ezUInt32 s_uiNumRounds = 32;
+  static constexpr ezUInt32 s_uiNumSpawners = 8;
+  static constexpr ezUInt32 s_uiNumTasksPerSpawner = 1024;
+  static constexpr ezUInt32 s_uiNumSmallGroups = 8192;
+  static constexpr ezUInt32 s_uiForkJoinDepth = 15;
+  static constexpr ezUInt32 s_uiNumCheapItems = 1000000;
+  static constexpr ezUInt32 s_uiNumExpensiveItems = 4000;
+#endif
+
+  class ezPerfTinyTask final : public ezTask
+  {
+  public:
+    ezPerfTinyTask(ezAtomicInteger32* pCounter)
+      : m_pCounter(pCounter)
+    {
+      ConfigureTask("TinyTask", ezTaskNesting::Never);
+    }
+
+  private:
+    virtual void Execute() override { m_pCounter->Increment(); }
+
+    ezAtomicInteger32* m_pCounter;
+  };
+
+  /// Starts a group of tiny tasks from within a task and waits for it.
+  /// This is the typical pattern of nested parallelism, where the tasks are queued by a worker thread and not by the main thread.
+  class ezPerfSpawnerTask final : public ezTask
+  {
+  public:
+    ezPerfSpawnerTask(ezAtomicInteger32* pCounter)
+    {
+      ConfigureTask("SpawnerTask", ezTaskNesting::Maybe);
+
+      m_Tasks.SetCount(s_uiNumTasksPerSpawner);
+      for (auto& pTask : m_Tasks)
+      {
+        pTask = EZ_DEFAULT_NEW(ezPerfTinyTask, pCounter);
+      }
+    }
+
+  private:
+    virtual void Execute() override
+    {
+      ezTaskGroupID group = ezTaskSystem::CreateTaskGroup(ezTaskPriority::ThisFrame);
+
+      for (auto& pTask : m_Tasks)
+      {
+        ezTaskSystem::AddTaskToGroup(group, pTask);
+      }
+
+      ezTaskSystem::StartTaskGroup(group);
+      ezTaskSystem::WaitForGroup(group);
+    }
+
+    ezDynamicArray<ezSharedPtr<ezTask>> m_Tasks;
+  };
+
+  double MeasureTinyTaskThroughput(bool bWorkStealing)
+  {
+    ezTaskSystem::SetWorkStealingEnabled(bWorkStealing);
+
+    ezAtomicInteger32 iCounter;
+
+    ezDynamicArray<ezSharedPtr<ezTask>> spawners;
+    spawners.SetCount(s_uiNumSpawners);
+    for (auto& pSpawner : spawners)
+    {
+      pSpawner = EZ_DEFAULT_NEW(ezPerfSpawnerTask, &iCounter);
+    }
+
+    const ezTime t0 = ezTime::Now();
+
+    for (ezUInt32 round = 0; round < s_uiNumRounds; ++round)
+    {
+      ezTaskGroupID group = ezTaskSystem::CreateTaskGroup(ezTaskPriority::ThisFrame);
+
+      for (auto& pSpawner : spawners)
+      {
+        ezTaskSystem::AddTaskToGroup(group, pSpawner);
+      }
+
+      ezTaskSystem::StartTaskGroup(group);
+      ezTaskSystem::WaitForGroup(group);
+    }
+
+    const ezTime t1 = ezTime::Now();
+
+    EZ_TEST_INT(iCounter, s_uiNumRounds * s_uiNumSpawners * s_uiNumTasksPerSpawner);
+
+    ezTaskSystem::SetWorkStealingEnabled(true);
+
+    return (s_uiNumRounds * s_uiNumSpawners * s_uiNumTasksPerSpawner) / (t1 - t0).GetMilliseconds();
+  }
+
+  /// Starts many groups with a single tiny task each, where every group depends on one or two earlier groups.
+  /// This mostly measures the overhead of creating, resolving and recycling task groups.
+  double MeasureSmallGroupThroughput()
+  {
+    ezAtomicInteger32 iCounter;
+
+    ezDynamicArray<ezSharedPtr<ezTask>> tasks;
+    tasks.SetCount(s_uiNumSmallGroups);
+    for (auto& pTask : tasks)
+    {
+      pTask = EZ_DEFAULT_NEW(ezPerfTinyTask, &iCounter);
+    }
+
+    ezDynamicArray<ezTaskGroupID> groups;
+    groups.SetCount(s_uiNumSmallGroups);
+
+    const ezTime t0 = ezTime::Now();
+
+    for (ezUInt32 round = 0; round < s_uiNumRounds; ++round)
+    {
+      for (ezUInt32 i = 0; i < s_uiNumSmallGroups; ++i)
+      {
+        groups[i] = ezTaskSystem::CreateTaskGroup(ezTaskPriority::ThisFrame);
+        ezTaskSystem::AddTaskToGroup(groups[i], tasks[i]);
+
+        if (i > 0)
+        {
+          ezTaskSystem::AddTaskGroupDependency(groups[i], groups[(i - 1) / 2]);
+        }
+
+        if (i > 1)
+        {
+          ezTaskSystem::AddTaskGroupDependency(groups[i], groups[i - 2]);
+        }
+
+        ezTaskSystem::StartTaskGroup(groups[i]);
+      }
+
+      for (ezUInt32 i = s_uiNumSmallGroups; i > 0; --i)
+      {
+        ezTaskSystem::WaitForGroup(groups[i - 1]);
+      }
+    }
+
+    const ezTime t1 = ezTime::Now();
+
+    EZ_TEST_INT(iCounter, s_uiNumRounds * s_uiNumSmallGroups);
+
+    return (s_uiNumRounds * s_uiNumSmallGroups) / (t1 - t0).GetMilliseconds();
+  }
+
+  /// Spawns a binary tree of fork-join tasks, each task executes one half itself and spawns the other.
+  void ForkJoinRecursion(ezUInt32 uiDepth, ezAtomicInteger32* pCounter)
+  {
+    pCounter->Increment();
+
+    if (uiDepth == 0)
+      return;
+
+    ezForkJoinScope scope;
+    ezForkJoinTask task([=]() { ForkJoinRecursion(uiDepth - 1, pCounter); });
+    scope.Spawn(task);
+
+    ForkJoinRecursion(uiDepth - 1, pCounter);
+
+    scope.Sync();
+  }
+
+  double MeasureForkJoinThroughput()
+  {
+    ezAtomicInteger32 iCounter;
+
+    // start the recursion on a worker thread, such that the tasks go through the work-stealing deques
+    ezSharedPtr<ezTask> pRoot = EZ_DEFAULT_NEW(ezDelegateTask<void>, "ForkJoinRoot", [&]() {
+      for (ezUInt32 round = 0; round < s_uiNumRounds; ++round)
+      {
+        ForkJoinRecursion(s_uiForkJoinDepth, &iCounter);
+      }
+    });
+    pRoot->ConfigureTask("ForkJoinRoot", ezTaskNesting::Maybe);
+
+    const ezTime t0 = ezTime::Now();
+
+    ezTaskSystem::WaitForGroup(ezTaskSystem::StartSingleTask(pRoot, ezTaskPriority::ThisFrame));
+
+    const ezTime t1 = ezTime::Now();
+
+    const ezUInt32 uiNodesPerRound = (1u << (s_uiForkJoinDepth + 1)) - 1;
+    EZ_TEST_INT(iCounter, s_uiNumRounds * uiNodesPerRound);
+
+    // every inner node spawns one task
+    return (s_uiNumRounds * (uiNodesPerRound / 2)) / (t1 - t0).GetMilliseconds();
+  }
+
+  /// Runs the same loop several times, either with the default ParallelFor settings or in adaptive mode.
+  /// Returns the average time per loop.
+  ezTime MeasureParallelFor(ezArrayPtr<float> items, ezUInt32 uiIterationsPerItem, bool bAdaptive)
+  {
+    ezParallelForCostCache costCache;
+
+    ezParallelForParams params;
+    params.bAdaptive = bAdaptive;
+    params.pCostCache = &costCache;
+
+    auto processItems = [uiIterationsPerItem](ezArrayPtr<float> slice) {
+      for (float& item : slice)
+      {
+        for (ezUInt32 i = 0; i < uiIterationsPerItem; ++i)
+        {
+          item = ezMath::Sqrt(item + 1.0f);
+        }
+      }
+    };
+
+    // warm up, this also measures the cost in adaptive mode
+    ezTaskSystem::ParallelFor(items, processItems, "ParallelFor Benchmark", params);
+
+    const ezTime t0 = ezTime::Now();
+
+    for (ezUInt32 round = 0; round < s_uiNumRounds; ++round)
+    {
+      ezTaskSystem::ParallelFor(items, processItems, "ParallelFor Benchmark", params);
+    }
+
+    const ezTime t1 = ezTime::Now();
+
+    return (t1 - t0) / s_uiNumRounds;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, TaskSystem)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Tiny Tasks (Work Stealing Disabled)")
+  {
+    // this still uses the per-priority injection queues and the invocation counters, so it is not the same as the old single task list
+    const double fTasksPerMS = MeasureTinyTaskThroughput(false);
+
+    const ezUInt32 uiNumWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+    ezLog::Info("[test]Tiny Tasks, work stealing disabled, {} workers: {} tasks/ms", uiNumWorkers, ezArgF(fTasksPerMS, 1));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Tiny Tasks (Work Stealing)")
+  {
+    const double fTasksPerMS = MeasureTinyTaskThroughput(true);
+
+    const ezUInt32 uiNumWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+    ezLog::Info("[test]Tiny Tasks, work stealing, {} workers: {} tasks/ms", uiNumWorkers, ezArgF(fTasksPerMS, 1));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Small Groups with Dependencies")
+  {
+    const double fGroupsPerMS = MeasureSmallGroupThroughput();
+
+    const ezUInt32 uiNumWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+    ezLog::Info("[test]Small Groups with Dependencies, {} workers: {} groups/ms", uiNumWorkers, ezArgF(fGroupsPerMS, 1));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Fork-Join Tasks")
+  {
+    const double fTasksPerMS = MeasureForkJoinThroughput();
+
+    const ezUInt32 uiNumWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+    ezLog::Info("[test]Fork-Join Tasks, {} workers: {} spawns/ms", uiNumWorkers, ezArgF(fTasksPerMS, 1));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ParallelFor (Cheap Items)")
+  {
+    ezDynamicArray<float> items;
+    items.SetCount(s_uiNumCheapItems);
+
+    const ezTime tDefault = MeasureParallelFor(items, 1, false);
+    const ezTime tAdaptive = MeasureParallelFor(items, 1, true);
+
+    ezLog::Info("[test]ParallelFor, {} cheap items: default {} ms, adaptive {} ms", s_uiNumCheapItems, ezArgF(tDefault.GetMilliseconds(), 3),
+      ezArgF(tAdaptive.GetMilliseconds(), 3));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ParallelFor (Tiny Loop)")
+  {
+    ezDynamicArray<float> items;
+    items.SetCount(64);
+
+    const ezTime tDefault = MeasureParallelFor(items, 1, false);
+    const ezTime tAdaptive = MeasureParallelFor(items, 1, true);
+
+    ezLog::Info("[test]ParallelFor, 64 cheap items: default {} ms, adaptive {} ms", ezArgF(tDefault.GetMilliseconds(), 4),
+      ezArgF(tAdaptive.GetMilliseconds(), 4));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ParallelFor (Expensive Items)")
+  {
+    ezDynamicArray<float> items;
+    items.SetCount(s_uiNumExpensiveItems);
+
+    const ezTime tDefault = MeasureParallelFor(items, 1000, false);
+    const ezTime tAdaptive = MeasureParallelFor(items, 1000, true);
+
+    ezLog::Info("[test]ParallelFor, {} expensive items: default {} ms, adaptive {} ms", s_uiNumExpensiveItems, ezArgF(tDefault.GetMilliseconds(), 3),
+      ezArgF(tAdaptive.GetMilliseconds(), 3));
+  }
+}
@@ -0,0 +1,119 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/SimdMath/SimdBBoxSphereBatch.h>
+
+namespace
+{
+  template <typename VEC>
+  void TestSimdBBoxSphereBatch()
+  {
+    typedef ezSimdBBoxSphereBatch<VEC> Batch;
+    typedef ezSimdBatchTraits<VEC> Traits;
+    constexpr ezUInt32 uiNumLanes = Traits::NumLanes;
+
+    ezSimdBBoxSphere bounds[uiNumLanes];
+    for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+    {
+      bounds[i] = ezSimdBBoxSphere(ezSimdVec4f(i * 10.0f - 30.0f, 1.0f, (float)i), ezSimdVec4f(1.0f, 0.5f + i, 2.0f, 0.0f), 1.5f + i);
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "Load / Store / GetLane")
+    {
+      Batch batch;
+      batch.Load(bounds, uiNumLanes);
+
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        EZ_TEST_BOOL(batch.GetLane(i) == bounds[i]);
+      }
+
+      ezSimdBBoxSphere stored[uiNumLanes];
+      stored[uiNumLanes - 1].SetInvalid();
+      batch.Store(stored, uiNumLanes - 1);
+
+      for (ezUInt32 i = 0; i < uiNumLanes - 1; ++i)
+      {
+        EZ_TEST_BOOL(stored[i] == bounds[i]);
+      }
+      EZ_TEST_BOOL(!stored[uiNumLanes - 1].IsValid());
+
+      batch.Load(uiNumLanes, [&](ezUInt32 i) -> const ezSimdBBoxSphere& { return bounds[uiNumLanes - 1 - i]; });
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        EZ_TEST_BOOL(batch.GetLane(i) == bounds[uiNumLanes - 1 - i]);
+      }
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "Transform")
+    {
+      ezSimdTransform transforms[uiNumLanes];
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        ezSimdQuat qRotation;
+        qRotation.SetFromAxisAndAngle(ezSimdVec4f(0.0f, 0.6f, 0.8f), 0.3f * i);
+
+        transforms[i] = ezSimdTransform(ezSimdVec4f((float)i, 2.0f, -3.0f), qRotation, ezSimdVec4f(1.0f, -2.0f - i, 0.5f));
+      }
+
+      ezSimdTransformBatch<VEC> transformBatch;
+      transformBatch.Load(transforms, uiNumLanes);
+
+      Batch batch;
+      batch.Load(bounds, uiNumLanes);
+      batch.Transform(transformBatch);
+
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        ezSimdBBoxSphere expected = bounds[i];
+        expected.Transform(transforms[i]);
+
+        const ezSimdBBoxSphere result = batch.GetLane(i);
+        EZ_TEST_BOOL(result.m_CenterAndRadius.IsEqual(expected.m_CenterAndRadius, 0.0001f).AllSet<4>());
+        EZ_TEST_BOOL(result.m_BoxHalfExtents.IsEqual(expected.m_BoxHalfExtents, 0.0001f).AllSet<3>());
+      }
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "Overlaps")
+    {
+      ezFrustum frustum;
+      frustum.SetFrustum(ezVec3(0, 0, 0), ezVec3(1, 0, 0), ezVec3(0, 0, 1), ezAngle::Degree(90), ezAngle::Degree(90), 1.0f, 100.0f);
+
+      ezSimdBBoxSphere testBounds[uiNumLanes];
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        // alternate between bounds in front of and behind the camera
+        const float x = (i % 2 == 0) ? 10.0f + i : -10.0f - i;
+        testBounds[i] = ezSimdBBoxSphere(ezSimdVec4f(x, 0.0f, 0.0f), ezSimdVec4f(1.0f), 1.7f);
+      }
+
+      // the sphere touches the near plane, but the box doesn't, so this is culled
+      testBounds[uiNumLanes - 1] = ezSimdBBoxSphere(ezSimdVec4f(-0.5f, 0.0f, 0.0f), ezSimdVec4f(1.0f, 5.0f, 5.0f), 2.0f);
+
+      // the box touches the near plane, but the sphere doesn't, so this is culled as well
+      testBounds[uiNumLanes - 3] = ezSimdBBoxSphere(ezSimdVec4f(-0.5f, 0.0f, 0.0f), ezSimdVec4f(2.0f, 1.0f, 1.0f), 1.0f);
+
+      Batch batch;
+      batch.Load(testBounds, uiNumLanes);
+
+      const ezUInt32 uiMask = Traits::GetMask(batch.Overlaps(frustum));
+
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        const bool bExpected = (i % 2 == 0);
+        EZ_TEST_BOOL(((uiMask & EZ_BIT(i)) != 0) == bExpected);
+
+        // everything that the batch culls must be culled by the box or the sphere test of ezFrustum
+        if (!bExpected)
+        {
+          EZ_TEST_BOOL(!frustum.Overlaps(testBounds[i].GetBox()) || !frustum.Overlaps(testBounds[i].GetSphere()));
+        }
+      }
+    }
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(SimdMath, SimdBBoxSphereBatch)
+{
+  TestSimdBBoxSphereBatch<ezSimdVec4f>();
+  TestSimdBBoxSphereBatch<ezSimdVec8f>();
+}
@@ -0,0 +1,114 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/SimdMath/SimdBSphereBatch.h>
+
+namespace
+{
+  template <typename VEC>
+  void TestSimdBSphereBatch()
+  {
+    typedef ezSimdBSphereBatch<VEC> Batch;
+    typedef ezSimdBatchTraits<VEC> Traits;
+    constexpr ezUInt32 uiNumLanes = Traits::NumLanes;
+
+    ezSimdBSphere spheres[uiNumLanes];
+    for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+    {
+      spheres[i] = ezSimdBSphere(ezSimdVec4f(i * 10.0f - 30.0f, 1.0f, (float)i), 1.0f + i * 0.5f);
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "Load / Store / GetLane")
+    {
+      Batch batch;
+      batch.Load(spheres, uiNumLanes);
+
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        EZ_TEST_BOOL(batch.GetLane(i) == spheres[i]);
+      }
+
+      ezSimdBSphere stored[uiNumLanes];
+      stored[uiNumLanes - 1] = ezSimdBSphere(ezSimdVec4f::ZeroVector(), 0.0f);
+      batch.Store(stored, uiNumLanes - 1);
+
+      for (ezUInt32 i = 0; i < uiNumLanes - 1; ++i)
+      {
+        EZ_TEST_BOOL(stored[i] == spheres[i]);
+      }
+      EZ_TEST_BOOL(stored[uiNumLanes - 1] == ezSimdBSphere(ezSimdVec4f::ZeroVector(), 0.0f));
+
+      batch.Load(spheres, 1);
+      for (ezUInt32 i = 1; i < uiNumLanes; ++i)
+      {
+        EZ_TEST_BOOL(batch.GetLane(i) == spheres[0]);
+      }
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "Transform")
+    {
+      ezSimdQuat qRotation;
+      qRotation.SetFromAxisAndAngle(ezSimdVec4f(0, 0, 1), 1.0f);
+
+      ezSimdTransform transforms[uiNumLanes];
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        transforms[i] = ezSimdTransform(ezSimdVec4f((float)i, 2.0f, -3.0f), qRotation, ezSimdVec4f(1.0f, -2.0f - i, 0.5f));
+      }
+
+      ezSimdTransformBatch<VEC> transformBatch;
+      transformBatch.Load(transforms, uiNumLanes);
+
+      Batch batch;
+      batch.Load(spheres, uiNumLanes);
+      batch.Transform(transformBatch);
+
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        ezSimdBSphere expected = spheres[i];
+        expected.Transform(transforms[i]);
+
+        const ezSimdBSphere result = batch.GetLane(i);
+        EZ_TEST_BOOL(result.m_CenterAndRadius.IsEqual(expected.m_CenterAndRadius, 0.0001f).AllSet<4>());
+      }
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "Overlaps")
+    {
+      ezFrustum frustum;
+      frustum.SetFrustum(ezVec3(0, 0, 0), ezVec3(1, 0, 0), ezVec3(0, 0, 1), ezAngle::Degree(90), ezAngle::Degree(90), 1.0f, 100.0f);
+
+      ezSimdBSphere testSpheres[uiNumLanes];
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        // alternate between spheres in front of and behind the camera, the last one touches the near plane
+        const float x = (i % 2 == 0) ? 10.0f + i : -10.0f - i;
+        testSpheres[i] = ezSimdBSphere(ezSimdVec4f(x, 0.0f, 0.0f), 2.0f);
+      }
+      testSpheres[uiNumLanes - 1] = ezSimdBSphere(ezSimdVec4f(-1.0f, 0.0f, 0.0f), 2.5f);
+
+      Batch batch;
+      batch.Load(testSpheres, uiNumLanes);
+
+      const ezUInt32 uiMask = Traits::GetMask(batch.Overlaps(frustum));
+
+      ezSimdVec4f planes[ezFrustum::PLANE_COUNT];
+      for (ezUInt32 p = 0; p < ezFrustum::PLANE_COUNT; ++p)
+      {
+        planes[p].Load<4>(frustum.GetPlane(static_cast<ezUInt8>(p)).m_vNormal.GetData());
+      }
+      EZ_TEST_INT(Traits::GetMask(batch.Overlaps(ezMakeArrayPtr(planes))), uiMask);
+
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        const bool bExpected = (i % 2 == 0) || (i == uiNumLanes - 1);
+        EZ_TEST_BOOL(((uiMask & EZ_BIT(i)) != 0) == bExpected);
+      }
+    }
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(SimdMath, SimdBSphereBatch)
+{
+  TestSimdBSphereBatch<ezSimdVec4f>();
+  TestSimdBSphereBatch<ezSimdVec8f>();
+}
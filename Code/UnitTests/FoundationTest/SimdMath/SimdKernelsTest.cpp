@@ -0,0 +1,134 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/SimdMath/SimdKernels.h>
+
+EZ_CREATE_SIMPLE_TEST(SimdMath, SimdKernels)
+{
+  const ezSimdKernelBackend::Enum previousBackend = ezSimdKernels::GetBackend();
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Backends")
+  {
+    EZ_TEST_BOOL(ezSimdKernels::IsBackendSupported(ezSimdKernelBackend::Default));
+    EZ_TEST_BOOL(ezSimdKernels::IsBackendSupported(ezSimdKernels::GetBestSupportedBackend()));
+
+    // the widest supported backend is selected at startup
+    EZ_TEST_INT(ezSimdKernels::GetBackend(), ezSimdKernels::GetBestSupportedBackend());
+
+    ezSimdKernels::SetBackend(ezSimdKernelBackend::Default);
+    EZ_TEST_INT(ezSimdKernels::GetBackend(), ezSimdKernelBackend::Default);
+  }
+
+  for (ezUInt32 uiBackend = 0; uiBackend < ezSimdKernelBackend::ENUM_COUNT; ++uiBackend)
+  {
+    const ezSimdKernelBackend::Enum backend = static_cast<ezSimdKernelBackend::Enum>(uiBackend);
+    if (!ezSimdKernels::IsBackendSupported(backend))
+      continue;
+
+    ezSimdKernels::SetBackend(backend);
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "TransformPositions / TransformDirections")
+    {
+      const float data[16] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 0, 0, 0, 1};
+
+      ezSimdMat4f m;
+      m.SetFromArray(data, ezMatrixLayout::RowMajor);
+
+      // odd count to cover the remainder
+      ezDynamicArray<ezSimdVec4f> input;
+      for (ezUInt32 i = 0; i < 13; ++i)
+      {
+        input.PushBack(ezSimdVec4f((float)i, (float)i * 0.5f - 3.0f, 7.0f - (float)i, 42.0f));
+      }
+
+      ezDynamicArray<ezSimdVec4f> output;
+      output.SetCountUninitialized(input.GetCount());
+
+      ezSimdKernels::TransformPositions(m, input, output);
+      for (ezUInt32 i = 0; i < input.GetCount(); ++i)
+      {
+        EZ_TEST_BOOL(output[i].IsEqual(m.TransformPosition(input[i]), ezMath::DefaultEpsilon<float>()).AllSet<3>());
+      }
+
+      ezSimdKernels::TransformDirections(m, input, output);
+      for (ezUInt32 i = 0; i < input.GetCount(); ++i)
+      {
+        EZ_TEST_BOOL(output[i].IsEqual(m.TransformDirection(input[i]), ezMath::DefaultEpsilon<float>()).AllSet<3>());
+      }
+
+      // in-place
+      ezDynamicArray<ezSimdVec4f> inPlace = input;
+      ezSimdKernels::TransformPositions(m, inPlace, inPlace);
+      for (ezUInt32 i = 0; i < input.GetCount(); ++i)
+      {
+        EZ_TEST_BOOL(inPlace[i].IsEqual(m.TransformPosition(input[i]), ezMath::DefaultEpsilon<float>()).AllSet<3>());
+      }
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "CullSpheres")
+    {
+      // a box from -10 to 10 with outwards pointing planes
+      ezSimdVec4f planes[6] = {
+        ezSimdVec4f(1, 0, 0, -10),
+        ezSimdVec4f(-1, 0, 0, -10),
+        ezSimdVec4f(0, 1, 0, -10),
+        ezSimdVec4f(0, -1, 0, -10),
+        ezSimdVec4f(0, 0, 1, -10),
+        ezSimdVec4f(0, 0, -1, -10),
+      };
+
+      // centers on half units and integer radii, so that no sphere exactly touches a plane
+      ezDynamicArray<ezSimdBSphere> spheres;
+      ezDynamicArray<ezUInt32> expectedVisible;
+      for (ezUInt32 i = 0; i < 43; ++i)
+      {
+        const float x = (float)((i * 7) % 29) - 14.5f;
+        const float y = (float)((i * 11) % 31) - 15.5f;
+        const float z = (float)((i * 5) % 23) - 11.5f;
+        const float r = (float)(i % 4);
+
+        spheres.PushBack(ezSimdBSphere(ezSimdVec4f(x, y, z), r));
+
+        if (ezMath::Abs(x) - 10.0f <= r && ezMath::Abs(y) - 10.0f <= r && ezMath::Abs(z) - 10.0f <= r)
+        {
+          expectedVisible.PushBack(i);
+        }
+      }
+
+      ezDynamicArray<ezUInt32> visible;
+      visible.SetCountUninitialized(spheres.GetCount());
+
+      const ezUInt32 uiNumVisible = ezSimdKernels::CullSpheres(ezMakeArrayPtr(planes), spheres, visible);
+      EZ_TEST_INT(uiNumVisible, expectedVisible.GetCount());
+
+      if (uiNumVisible == expectedVisible.GetCount())
+      {
+        for (ezUInt32 i = 0; i < uiNumVisible; ++i)
+        {
+          EZ_TEST_INT(visible[i], expectedVisible[i]);
+        }
+      }
+
+      EZ_TEST_BOOL(expectedVisible.GetCount() > 0 && expectedVisible.GetCount() < spheres.GetCount());
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "MulAdd")
+    {
+      ezDynamicArray<float> positions;
+      ezDynamicArray<float> velocities;
+      for (ezUInt32 i = 0; i < 37; ++i)
+      {
+        positions.PushBack((float)i);
+        velocities.PushBack((float)i * 2.0f - 5.0f);
+      }
+
+      ezSimdKernels::MulAdd(positions, velocities, 0.5f);
+
+      for (ezUInt32 i = 0; i < positions.GetCount(); ++i)
+      {
+        EZ_TEST_FLOAT(positions[i], (float)i + ((float)i * 2.0f - 5.0f) * 0.5f, 0.0f);
+      }
+    }
+  }
+
+  ezSimdKernels::SetBackend(previousBackend);
+}
@@ -0,0 +1,266 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Math/Random.h>
+#include <Foundation/SimdMath/SimdTransformBatch.h>
+
+namespace
+{
+  // helpers to compare the xyz components of vectors, which are needed since the result of GetLane() is dependent in the templates below
+  bool SimdBatchTestIsEqual(const ezSimdVec4f& a, const ezSimdVec4f& b, const ezSimdFloat& fEpsilon)
+  {
+    return a.IsEqual(b, fEpsilon).AllSet<3>();
+  }
+
+  bool SimdBatchTestIsIdentical(const ezSimdVec4f& a, const ezSimdVec4f& b)
+  {
+    return (a == b).AllSet<3>();
+  }
+
+  ezSimdVec4f SimdBatchTestDot(const ezSimdVec4f& a, const ezSimdVec4f& b)
+  {
+    return ezSimdVec4f(a.Dot<3>(b));
+  }
+
+  ezSimdTransform CreateRandomSimdTransform(ezRandom& rng)
+  {
+    ezSimdVec4f vAxis(rng.FloatMinMax(-1.0f, 1.0f), rng.FloatMinMax(-1.0f, 1.0f), rng.FloatMinMax(-1.0f, 1.0f), 0.0f);
+    vAxis += ezSimdVec4f(0.0f, 0.0f, 0.1f, 0.0f);
+    vAxis.Normalize<3>();
+
+    ezSimdQuat qRotation;
+    qRotation.SetFromAxisAndAngle(vAxis, rng.FloatMinMax(-3.0f, 3.0f));
+
+    const ezSimdVec4f vPosition(rng.FloatMinMax(-100.0f, 100.0f), rng.FloatMinMax(-100.0f, 100.0f), rng.FloatMinMax(-100.0f, 100.0f), 0.0f);
+    const ezSimdVec4f vScale(rng.FloatMinMax(0.5f, 2.0f), rng.FloatMinMax(-2.0f, -0.5f), rng.FloatMinMax(0.5f, 2.0f), 0.0f);
+
+    return ezSimdTransform(vPosition, qRotation, vScale);
+  }
+
+  template <typename VEC>
+  void TestSimdTransformBatch()
+  {
+    typedef ezSimdTransformBatch<VEC> Batch;
+    constexpr ezUInt32 uiNumLanes = ezSimdBatchTraits<VEC>::NumLanes;
+    const ezSimdFloat fEpsilon = 0.001f;
+
+    ezRandom rng;
+    rng.Initialize(42);
+
+    ezSimdTransform parents[uiNumLanes];
+    ezSimdTransform locals[uiNumLanes];
+    for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+    {
+      parents[i] = CreateRandomSimdTransform(rng);
+      locals[i] = CreateRandomSimdTransform(rng);
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "Load / Store / GetLane")
+    {
+      Batch batch;
+      batch.Load(parents, uiNumLanes);
+
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        EZ_TEST_BOOL(batch.GetLane(i) == parents[i]);
+      }
+
+      ezSimdTransform stored[uiNumLanes + 1];
+      stored[uiNumLanes - 1] = ezSimdTransform::IdentityTransform();
+      stored[uiNumLanes] = ezSimdTransform::IdentityTransform();
+      batch.Store(stored, uiNumLanes - 1);
+
+      for (ezUInt32 i = 0; i < uiNumLanes - 1; ++i)
+      {
+        EZ_TEST_BOOL(stored[i] == parents[i]);
+      }
+
+      // only uiCount transforms are written
+      EZ_TEST_BOOL(stored[uiNumLanes - 1] == ezSimdTransform::IdentityTransform());
+      EZ_TEST_BOOL(stored[uiNumLanes] == ezSimdTransform::IdentityTransform());
+
+      // unused lanes are filled with the last transform
+      batch.Load(parents, 3);
+      for (ezUInt32 i = 3; i < uiNumLanes; ++i)
+      {
+        EZ_TEST_BOOL(batch.GetLane(i) == parents[2]);
+      }
+
+      // accessor
+      batch.Load(uiNumLanes, [&](ezUInt32 i) -> const ezSimdTransform& { return locals[uiNumLanes - 1 - i]; });
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        EZ_TEST_BOOL(batch.GetLane(i) == locals[uiNumLanes - 1 - i]);
+      }
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "Set / SetIdentity")
+    {
+      Batch batch;
+      batch.SetIdentity();
+
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        EZ_TEST_BOOL(batch.GetLane(i) == ezSimdTransform::IdentityTransform());
+      }
+
+      batch.Set(parents[0]);
+
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        EZ_TEST_BOOL(batch.GetLane(i) == parents[0]);
+      }
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "GetMaxScale")
+    {
+      Batch batch;
+      batch.Load(parents, uiNumLanes);
+
+      const ezSimdBatchVec3<VEC> maxScale(batch.GetMaxScale(), batch.GetMaxScale(), batch.GetMaxScale());
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        EZ_TEST_BOOL(SimdBatchTestIsIdentical(maxScale.GetLane(i), ezSimdVec4f(parents[i].GetMaxScale())));
+      }
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "SetGlobalTransform / operator*")
+    {
+      Batch parentBatch, localBatch;
+      parentBatch.Load(parents, uiNumLanes);
+      localBatch.Load(locals, uiNumLanes);
+
+      Batch globalBatch;
+      globalBatch.SetGlobalTransform(parentBatch, localBatch);
+
+      const Batch concatenated = parentBatch * localBatch;
+
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        ezSimdTransform expected;
+        expected.SetGlobalTransform(parents[i], locals[i]);
+
+        EZ_TEST_BOOL(globalBatch.GetLane(i).IsEqual(expected, fEpsilon));
+        EZ_TEST_BOOL(concatenated.GetLane(i).IsEqual(expected, fEpsilon));
+      }
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "TransformPosition / TransformDirection")
+    {
+      Batch batch;
+      batch.Load(parents, uiNumLanes);
+
+      ezSimdVec4f points[uiNumLanes];
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        points[i] = ezSimdVec4f(rng.FloatMinMax(-10.0f, 10.0f), rng.FloatMinMax(-10.0f, 10.0f), rng.FloatMinMax(-10.0f, 10.0f), 0.0f);
+      }
+
+      ezSimdBatchVec3<VEC> v;
+      v.Load(uiNumLanes, [&](ezUInt32 i) -> const ezSimdVec4f& { return points[i]; });
+
+      const ezSimdBatchVec3<VEC> positions = batch.TransformPosition(v);
+      const ezSimdBatchVec3<VEC> directions = batch.TransformDirection(v);
+
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        EZ_TEST_BOOL(SimdBatchTestIsEqual(positions.GetLane(i), parents[i].TransformPosition(points[i]), fEpsilon));
+        EZ_TEST_BOOL(SimdBatchTestIsEqual(directions.GetLane(i), parents[i].TransformDirection(points[i]), fEpsilon));
+      }
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "GetAsMat3")
+    {
+      Batch batch;
+      batch.Load(parents, uiNumLanes);
+
+      ezSimdBatchVec3<VEC> col0, col1, col2;
+      batch.GetAsMat3(col0, col1, col2);
+
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        const ezSimdMat4f m = parents[i].GetAsMat4();
+
+        EZ_TEST_BOOL(SimdBatchTestIsEqual(col0.GetLane(i), m.m_col0, fEpsilon));
+        EZ_TEST_BOOL(SimdBatchTestIsEqual(col1.GetLane(i), m.m_col1, fEpsilon));
+        EZ_TEST_BOOL(SimdBatchTestIsEqual(col2.GetLane(i), m.m_col2, fEpsilon));
+      }
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "ezSimdBatchVec3")
+    {
+      ezSimdVec4f a[uiNumLanes], b[uiNumLanes];
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        a[i] = ezSimdVec4f((float)i, -2.0f * i, 3.0f, 0.0f);
+        b[i] = ezSimdVec4f(1.0f, (float)i, -0.5f * i, 0.0f);
+      }
+
+      ezSimdBatchVec3<VEC> va, vb;
+      va.Load(uiNumLanes, [&](ezUInt32 i) -> const ezSimdVec4f& { return a[i]; });
+      vb.Load(uiNumLanes, [&](ezUInt32 i) -> const ezSimdVec4f& { return b[i]; });
+
+      const VEC dot = va.Dot(vb);
+      const ezSimdBatchVec3<VEC> dots(dot, dot, dot);
+      const ezSimdBatchVec3<VEC> cross = va.CrossRH(vb);
+      const ezSimdBatchVec3<VEC> sum = va + vb;
+      const ezSimdBatchVec3<VEC> diff = va - vb;
+      const ezSimdBatchVec3<VEC> mul = va.CompMul(vb);
+      const ezSimdBatchVec3<VEC> abs = va.Abs();
+      const ezSimdBatchVec3<VEC> scaled = va * VEC(2.0f);
+      const ezSimdBatchVec3<VEC> mulAdd = ezSimdBatchVec3<VEC>::MulAdd(va, VEC(2.0f), vb);
+
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        EZ_TEST_BOOL(SimdBatchTestIsEqual(dots.GetLane(i), SimdBatchTestDot(a[i], b[i]), 0.0001f));
+        EZ_TEST_BOOL(SimdBatchTestIsIdentical(cross.GetLane(i), a[i].CrossRH(b[i])));
+        EZ_TEST_BOOL(SimdBatchTestIsIdentical(sum.GetLane(i), a[i] + b[i]));
+        EZ_TEST_BOOL(SimdBatchTestIsIdentical(diff.GetLane(i), a[i] - b[i]));
+        EZ_TEST_BOOL(SimdBatchTestIsIdentical(mul.GetLane(i), a[i].CompMul(b[i])));
+        EZ_TEST_BOOL(SimdBatchTestIsIdentical(abs.GetLane(i), a[i].Abs()));
+        EZ_TEST_BOOL(SimdBatchTestIsIdentical(scaled.GetLane(i), a[i] * 2.0f));
+        EZ_TEST_BOOL(SimdBatchTestIsIdentical(mulAdd.GetLane(i), a[i] * 2.0f + b[i]));
+      }
+
+      ezSimdVec4f stored[uiNumLanes];
+      va.Store(uiNumLanes, [&](ezUInt32 i) -> ezSimdVec4f& { return stored[i]; });
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        EZ_TEST_BOOL(SimdBatchTestIsIdentical(stored[i], a[i]));
+      }
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "ezSimdBatchQuat")
+    {
+      ezSimdBatchQuat<VEC> qa, qb;
+      qa.Load(uiNumLanes, [&](ezUInt32 i) -> const ezSimdQuat& { return parents[i].m_Rotation; });
+      qb.Load(uiNumLanes, [&](ezUInt32 i) -> const ezSimdQuat& { return locals[i].m_Rotation; });
+
+      const ezSimdBatchQuat<VEC> q = qa * qb;
+      const ezSimdBatchVec3<VEC> rotated = qa * ezSimdBatchVec3<VEC>(VEC(1.0f), VEC(2.0f), VEC(3.0f));
+
+      ezSimdQuat stored[uiNumLanes];
+      q.Store(uiNumLanes, [&](ezUInt32 i) -> ezSimdQuat& { return stored[i]; });
+
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        EZ_TEST_BOOL(stored[i].IsEqualRotation(parents[i].m_Rotation * locals[i].m_Rotation, fEpsilon));
+        EZ_TEST_BOOL(SimdBatchTestIsEqual(rotated.GetLane(i), parents[i].m_Rotation * ezSimdVec4f(1, 2, 3), fEpsilon));
+      }
+
+      ezSimdBatchQuat<VEC> identity;
+      identity.SetIdentity();
+      identity.Store(uiNumLanes, [&](ezUInt32 i) -> ezSimdQuat& { return stored[i]; });
+
+      for (ezUInt32 i = 0; i < uiNumLanes; ++i)
+      {
+        EZ_TEST_BOOL(stored[i] == ezSimdQuat::IdentityQuaternion());
+      }
+    }
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(SimdMath, SimdTransformBatch)
+{
+  TestSimdTransformBatch<ezSimdVec4f>();
+  TestSimdTransformBatch<ezSimdVec8f>();
+}
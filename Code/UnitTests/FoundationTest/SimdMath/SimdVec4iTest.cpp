@@ -222,4 +222,16 @@ EZ_CREATE_SIMPLE_TEST(SimdMath, SimdVec4i)
     cmp = a > b;
     EZ_TEST_BOOL(!cmp.x() && !cmp.y() && !cmp.z() && cmp.w());
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Select")
+  {
+    ezSimdVec4i a(-3, 5, 7, 9);
+    ezSimdVec4i b(1, 2, 3, 4);
+
+    ezSimdVec4i s = ezSimdVec4i::Select(ezSimdVec4b(true, false, true, false), a, b);
+    EZ_TEST_BOOL(s.x() == -3 && s.y() == 2 && s.z() == 7 && s.w() == 4);
+
+    s = ezSimdVec4i::Select(a > b, a, b);
+    EZ_TEST_BOOL(s.x() == 1 && s.y() == 5 && s.z() == 7 && s.w() == 9);
+  }
 }
@@ -0,0 +1,219 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/SimdMath/SimdVec8f.h>
+
+namespace
+{
+  bool AllEqual(const ezSimdVec8f& v, const float* pExpected, float fEpsilon = 0.0f)
+  {
+    float values[8];
+    v.Store(values);
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+    {
+      if (!ezMath::IsEqual(values[i], pExpected[i], fEpsilon))
+        return false;
+    }
+
+    return true;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(SimdMath, SimdVec8f)
+{
+  const float values[8] = {1.0f, -2.0f, 3.5f, -4.0f, 5.0f, 6.25f, -7.0f, 8.0f};
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Constructor")
+  {
+#if EZ_ENABLED(EZ_SIMD_NATIVE_VEC8)
+    EZ_CHECK_AT_COMPILETIME(sizeof(ezSimdVec8f) == 32);
+#endif
+
+    ezSimdVec8f a(3.0f);
+    const float expectedA[8] = {3, 3, 3, 3, 3, 3, 3, 3};
+    EZ_TEST_BOOL(AllEqual(a, expectedA));
+
+    ezSimdVec8f b(ezSimdVec4f(1, 2, 3, 4), ezSimdVec4f(5, 6, 7, 8));
+    const float expectedB[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    EZ_TEST_BOOL(AllEqual(b, expectedB));
+
+    EZ_TEST_FLOAT(b.GetComponent<0>(), 1.0f, 0.0f);
+    EZ_TEST_FLOAT(b.GetComponent<3>(), 4.0f, 0.0f);
+    EZ_TEST_FLOAT(b.GetComponent<4>(), 5.0f, 0.0f);
+    EZ_TEST_FLOAT(b.GetComponent<7>(), 8.0f, 0.0f);
+
+    EZ_TEST_BOOL((b.GetLow() == ezSimdVec4f(1, 2, 3, 4)).AllSet<4>());
+    EZ_TEST_BOOL((b.GetHigh() == ezSimdVec4f(5, 6, 7, 8)).AllSet<4>());
+
+    ezSimdVec8f copy(b.m_v);
+    EZ_TEST_BOOL(AllEqual(copy, expectedB));
+
+    const float expectedZero[8] = {};
+    EZ_TEST_BOOL(AllEqual(ezSimdVec8f::ZeroVector(), expectedZero));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Setter / Load / Store")
+  {
+    ezSimdVec8f a;
+    a.Set(2.0f);
+    const float expected[8] = {2, 2, 2, 2, 2, 2, 2, 2};
+    EZ_TEST_BOOL(AllEqual(a, expected));
+
+    a.SetZero();
+    const float expectedZero[8] = {};
+    EZ_TEST_BOOL(AllEqual(a, expectedZero));
+
+    // unaligned
+    float buffer[9] = {};
+    ezMemoryUtils::Copy(buffer + 1, values, 8);
+    a.Load(buffer + 1);
+    EZ_TEST_BOOL(AllEqual(a, values));
+
+    float out[9] = {};
+    a.Store(out + 1);
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(out + 1, values, 8));
+    EZ_TEST_FLOAT(out[0], 0.0f, 0.0f);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Functions")
+  {
+    ezSimdVec8f a(ezSimdVec4f(1, 2, 4, 8), ezSimdVec4f(16, 0.5f, 0.25f, 64));
+
+    const float expectedRcp[8] = {1.0f, 0.5f, 0.25f, 0.125f, 0.0625f, 2.0f, 4.0f, 1.0f / 64.0f};
+    EZ_TEST_BOOL(AllEqual(a.GetReciprocal(), expectedRcp));
+    EZ_TEST_BOOL(AllEqual(a.GetReciprocal<ezMathAcc::BITS_23>(), expectedRcp, ezMath::DefaultEpsilon<float>()));
+    EZ_TEST_BOOL(AllEqual(a.GetReciprocal<ezMathAcc::BITS_12>(), expectedRcp, ezMath::LargeEpsilon<float>() * 4.0f));
+
+    ezSimdVec8f b(ezSimdVec4f(1, 4, 9, 16), ezSimdVec4f(25, 36, 49, 64));
+    const float expectedSqrt[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    EZ_TEST_BOOL(AllEqual(b.GetSqrt(), expectedSqrt));
+    EZ_TEST_BOOL(AllEqual(b.GetSqrt<ezMathAcc::BITS_23>(), expectedSqrt, ezMath::DefaultEpsilon<float>() * 8.0f));
+    EZ_TEST_BOOL(AllEqual(b.GetSqrt<ezMathAcc::BITS_12>(), expectedSqrt, ezMath::LargeEpsilon<float>() * 8.0f));
+
+    const float expectedInvSqrt[8] = {1.0f, 0.5f, 1.0f / 3.0f, 0.25f, 0.2f, 1.0f / 6.0f, 1.0f / 7.0f, 0.125f};
+    EZ_TEST_BOOL(AllEqual(b.GetInvSqrt(), expectedInvSqrt, ezMath::SmallEpsilon<float>()));
+    EZ_TEST_BOOL(AllEqual(b.GetInvSqrt<ezMathAcc::BITS_23>(), expectedInvSqrt, ezMath::DefaultEpsilon<float>()));
+    EZ_TEST_BOOL(AllEqual(b.GetInvSqrt<ezMathAcc::BITS_12>(), expectedInvSqrt, ezMath::LargeEpsilon<float>()));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Operators")
+  {
+    ezSimdVec8f a;
+    a.Load(values);
+    ezSimdVec8f b(2.0f);
+
+    float expected[8];
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = -values[i];
+    EZ_TEST_BOOL(AllEqual(-a, expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = values[i] + 2.0f;
+    EZ_TEST_BOOL(AllEqual(a + b, expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = values[i] - 2.0f;
+    EZ_TEST_BOOL(AllEqual(a - b, expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = values[i] * 3.0f;
+    EZ_TEST_BOOL(AllEqual(a * 3.0f, expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = values[i] / 4.0f;
+    EZ_TEST_BOOL(AllEqual(a / 4.0f, expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = values[i] * values[i];
+    EZ_TEST_BOOL(AllEqual(a.CompMul(a), expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = values[i] / 2.0f;
+    EZ_TEST_BOOL(AllEqual(a.CompDiv(b), expected));
+    EZ_TEST_BOOL(AllEqual(a.CompDiv<ezMathAcc::BITS_23>(b), expected, ezMath::DefaultEpsilon<float>() * 8.0f));
+    EZ_TEST_BOOL(AllEqual(a.CompDiv<ezMathAcc::BITS_12>(b), expected, ezMath::LargeEpsilon<float>() * 8.0f));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = ezMath::Min(values[i], 2.0f);
+    EZ_TEST_BOOL(AllEqual(a.CompMin(b), expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = ezMath::Max(values[i], 2.0f);
+    EZ_TEST_BOOL(AllEqual(a.CompMax(b), expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = ezMath::Abs(values[i]);
+    EZ_TEST_BOOL(AllEqual(a.Abs(), expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = ezMath::Floor(values[i]);
+    EZ_TEST_BOOL(AllEqual(a.Floor(), expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = ezMath::Ceil(values[i]);
+    EZ_TEST_BOOL(AllEqual(a.Ceil(), expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = values[i] * 2.0f + values[i];
+    EZ_TEST_BOOL(AllEqual(ezSimdVec8f::MulAdd(a, b, a), expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = values[i] * 2.0f - values[i];
+    EZ_TEST_BOOL(AllEqual(ezSimdVec8f::MulSub(a, b, a), expected));
+
+    ezSimdVec8f c = a;
+    c += b;
+    c -= a;
+    c *= 3.0f;
+    c /= 2.0f;
+    const float expectedAssign[8] = {3, 3, 3, 3, 3, 3, 3, 3};
+    EZ_TEST_BOOL(AllEqual(c, expectedAssign));
+
+    EZ_TEST_FLOAT(a.HorizontalSum(), 10.75f, 0.0f);
+    EZ_TEST_FLOAT(a.HorizontalMin(), -7.0f, 0.0f);
+    EZ_TEST_FLOAT(a.HorizontalMax(), 8.0f, 0.0f);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Comparison / Select")
+  {
+    ezSimdVec8f a;
+    a.Load(values);
+    ezSimdVec8f b(ezSimdVec4f(1, 0, 3.5f, 0), ezSimdVec4f(6, 6.25f, 0, 0));
+
+    EZ_TEST_INT((a == b).GetMask(), 0x25);
+    EZ_TEST_INT((a != b).GetMask(), 0xDA);
+    EZ_TEST_INT((a <= b).GetMask(), 0x7F);
+    EZ_TEST_INT((a < b).GetMask(), 0x5A);
+    EZ_TEST_INT((a >= b).GetMask(), 0xA5);
+    EZ_TEST_INT((a > b).GetMask(), 0x80);
+
+    const float expected[8] = {1.0f, 0.0f, 3.5f, 0.0f, 6.0f, 6.25f, 0.0f, 8.0f};
+    EZ_TEST_BOOL(AllEqual(ezSimdVec8f::Select(a >= b, b, a).CompMax(ezSimdVec8f::Select(a > b, a, b)), expected));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "SimdVec8b")
+  {
+    ezSimdVec8b t(true);
+    ezSimdVec8b f(false);
+    EZ_TEST_INT(t.GetMask(), 0xFF);
+    EZ_TEST_INT(f.GetMask(), 0);
+    EZ_TEST_BOOL(t.AllSet() && t.AnySet() && !t.NoneSet());
+    EZ_TEST_BOOL(!f.AllSet() && !f.AnySet() && f.NoneSet());
+
+    ezSimdVec8b m(ezSimdVec4b(true, false, false, true), ezSimdVec4b(false, false, true, false));
+    EZ_TEST_INT(m.GetMask(), 0x49);
+    EZ_TEST_BOOL(m.GetComponent<0>() && !m.GetComponent<1>() && m.GetComponent<3>() && m.GetComponent<6>() && !m.GetComponent<7>());
+    EZ_TEST_BOOL(!m.AllSet() && m.AnySet() && !m.NoneSet());
+    EZ_TEST_BOOL(m.GetLow().x() && m.GetHigh().z() && !m.GetHigh().w());
+
+    EZ_TEST_INT((!m).GetMask(), 0xB6);
+    EZ_TEST_INT((m && t).GetMask(), 0x49);
+    EZ_TEST_INT((m && f).GetMask(), 0);
+    EZ_TEST_INT((m || f).GetMask(), 0x49);
+    EZ_TEST_INT((m || !m).GetMask(), 0xFF);
+
+    ezSimdVec8b copy(m.m_v);
+    EZ_TEST_INT(copy.GetMask(), 0x49);
+  }
+}
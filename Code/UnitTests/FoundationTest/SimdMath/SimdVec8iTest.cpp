@@ -0,0 +1,149 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/SimdMath/SimdVec8i.h>
+
+namespace
+{
+  bool AllEqual(const ezSimdVec8i& v, const ezInt32* pExpected)
+  {
+    ezInt32 values[8];
+    v.Store(values);
+
+    return ezMemoryUtils::IsEqual(values, pExpected, 8);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(SimdMath, SimdVec8i)
+{
+  const ezInt32 values[8] = {1, -2, 3, -4, 50, 60, -70, 80};
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Constructor / Load / Store")
+  {
+    ezSimdVec8i a(3);
+    const ezInt32 expectedA[8] = {3, 3, 3, 3, 3, 3, 3, 3};
+    EZ_TEST_BOOL(AllEqual(a, expectedA));
+
+    ezSimdVec8i b(ezSimdVec4i(1, 2, 3, 4), ezSimdVec4i(5, 6, 7, 8));
+    const ezInt32 expectedB[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    EZ_TEST_BOOL(AllEqual(b, expectedB));
+    EZ_TEST_INT(b.GetComponent<0>(), 1);
+    EZ_TEST_INT(b.GetComponent<5>(), 6);
+    EZ_TEST_INT(b.GetLow().w(), 4);
+    EZ_TEST_INT(b.GetHigh().x(), 5);
+
+    ezSimdVec8i copy(b.m_v);
+    EZ_TEST_BOOL(AllEqual(copy, expectedB));
+
+    a.Set(7);
+    EZ_TEST_INT(a.GetComponent<7>(), 7);
+
+    a.SetZero();
+    const ezInt32 expectedZero[8] = {};
+    EZ_TEST_BOOL(AllEqual(a, expectedZero));
+    EZ_TEST_BOOL(AllEqual(ezSimdVec8i::ZeroVector(), expectedZero));
+
+    a.Load(values);
+    EZ_TEST_BOOL(AllEqual(a, values));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Conversion")
+  {
+    ezSimdVec8i a;
+    a.Load(values);
+
+    float floats[8];
+    a.ToFloat().Store(floats);
+    for (ezUInt32 i = 0; i < 8; ++i)
+    {
+      EZ_TEST_FLOAT(floats[i], static_cast<float>(values[i]), 0.0f);
+    }
+
+    ezSimdVec8f f(ezSimdVec4f(1.7f, -1.7f, 2.2f, -2.2f), ezSimdVec4f(0.5f, -0.5f, 100.9f, -100.9f));
+    const ezInt32 expected[8] = {1, -1, 2, -2, 0, 0, 100, -100};
+    EZ_TEST_BOOL(AllEqual(ezSimdVec8i::Truncate(f), expected));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Operators")
+  {
+    ezSimdVec8i a;
+    a.Load(values);
+    ezSimdVec8i b(3);
+
+    ezInt32 expected[8];
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = -values[i];
+    EZ_TEST_BOOL(AllEqual(-a, expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = values[i] + 3;
+    EZ_TEST_BOOL(AllEqual(a + b, expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = values[i] - 3;
+    EZ_TEST_BOOL(AllEqual(a - b, expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = values[i] * 3;
+    EZ_TEST_BOOL(AllEqual(a.CompMul(b), expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = values[i] | 3;
+    EZ_TEST_BOOL(AllEqual(a | b, expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = values[i] & 3;
+    EZ_TEST_BOOL(AllEqual(a & b, expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = values[i] ^ 3;
+    EZ_TEST_BOOL(AllEqual(a ^ b, expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = ~values[i];
+    EZ_TEST_BOOL(AllEqual(~a, expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = values[i] << 2;
+    EZ_TEST_BOOL(AllEqual(a << 2, expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = values[i] >> 1;
+    EZ_TEST_BOOL(AllEqual(a >> 1, expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = ezMath::Min(values[i], 3);
+    EZ_TEST_BOOL(AllEqual(a.CompMin(b), expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = ezMath::Max(values[i], 3);
+    EZ_TEST_BOOL(AllEqual(a.CompMax(b), expected));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+      expected[i] = ezMath::Abs(values[i]);
+    EZ_TEST_BOOL(AllEqual(a.Abs(), expected));
+
+    ezSimdVec8i c = a;
+    c += b;
+    c -= a;
+    const ezInt32 expectedAssign[8] = {3, 3, 3, 3, 3, 3, 3, 3};
+    EZ_TEST_BOOL(AllEqual(c, expectedAssign));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Comparison / Select")
+  {
+    ezSimdVec8i a;
+    a.Load(values);
+    ezSimdVec8i b(ezSimdVec4i(1, 0, 3, 0), ezSimdVec4i(60, 60, 0, 0));
+
+    EZ_TEST_INT((a == b).GetMask(), 0x25);
+    EZ_TEST_INT((a != b).GetMask(), 0xDA);
+    EZ_TEST_INT((a <= b).GetMask(), 0x7F);
+    EZ_TEST_INT((a < b).GetMask(), 0x5A);
+    EZ_TEST_INT((a >= b).GetMask(), 0xA5);
+    EZ_TEST_INT((a > b).GetMask(), 0x80);
+
+    const ezInt32 expected[8] = {1, 0, 3, 0, 60, 60, 0, 80};
+    EZ_TEST_BOOL(AllEqual(ezSimdVec8i::Select(a > b, a, b), expected));
+  }
+}
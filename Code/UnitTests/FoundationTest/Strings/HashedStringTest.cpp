@@ -1,6 +1,8 @@
 #include <FoundationTestPCH.h>
 
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Threading/TaskSystem.h>
 
 EZ_CREATE_SIMPLE_TEST(Strings, HashedString)
 {
@@ -201,4 +203,46 @@ EZ_CREATE_SIMPLE_TEST(Strings, HashedString)
     EZ_TEST_INT(ezHashedString::ClearUnusedStrings(), 0);
   }
 #endif
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Multi-Threaded Assign")
+  {
+    // every task adds an overlapping range of strings, more than fit into the per-thread caches
+    constexpr ezUInt32 uiNumTasks = 16;
+    constexpr ezUInt32 uiNumStrings = 200;
+
+    ezAtomicInteger32 iNumErrors;
+
+    ezParallelForParams params;
+    params.uiBinSize = 1;
+
+    ezTaskSystem::ParallelForIndexed(
+      0, uiNumTasks,
+      [&iNumErrors](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+        ezStringBuilder sb;
+
+        for (ezUInt32 uiTask = uiStartIndex; uiTask < uiEndIndex; ++uiTask)
+        {
+          for (ezUInt32 uiRepeat = 0; uiRepeat < 3; ++uiRepeat)
+          {
+            for (ezUInt32 i = 0; i < uiNumStrings; ++i)
+            {
+              sb.Format("MultiThreaded_{}", (uiTask * 50 + i) % 500);
+
+              ezHashedString s;
+              s.Assign(sb.GetData());
+
+              if (s.GetString() != sb || s != ezTempHashedString(sb.GetData()))
+                iNumErrors.Increment();
+            }
+          }
+        }
+      },
+      "HashedString Test", params);
+
+    EZ_TEST_INT(iNumErrors, 0);
+
+    ezHashedString s;
+    s.Assign("MultiThreaded_123");
+    EZ_TEST_STRING(s.GetData(), "MultiThreaded_123");
+  }
 }
@@ -3,10 +3,128 @@
 // NOTE: Always save this file as "Unicode (UTF-8 with signature)"
 // otherwise important Unicode characters are not encoded
 
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Math/Random.h>
 #include <Foundation/Strings/String.h>
+#include <Foundation/Strings/StringConversion.h>
 
 EZ_CREATE_SIMPLE_TEST_GROUP(Strings);
 
+namespace
+{
+  // mostly ASCII, so that the SIMD code paths are taken, and characters with 2 to 4 bytes, including the ones that are equal to
+  // ASCII characters in case-insensitive comparisons
+  static const char* s_szAsciiCharacters[] = {"a", "B", "i", "I", "s", "S", "z", "Z", "/", "_", "0", " "};
+  static const char* s_szUtf8Characters[] = {u8"\u00e4", u8"\u00c4", u8"\u00df", u8"\u0130", u8"\u0131", u8"\u017f", u8"\u6771", u8"\U0001D11E"};
+
+  void BuildRandomString(ezRandom& ref_rng, ezUInt32 uiNumCharacters, ezStringBuilder& out_sResult)
+  {
+    out_sResult.Clear();
+
+    for (ezUInt32 i = 0; i < uiNumCharacters; ++i)
+    {
+      if (ref_rng.UIntInRange(10) == 0)
+        out_sResult.Append(s_szUtf8Characters[ref_rng.UIntInRange(EZ_ARRAY_SIZE(s_szUtf8Characters))]);
+      else
+        out_sResult.Append(s_szAsciiCharacters[ref_rng.UIntInRange(EZ_ARRAY_SIZE(s_szAsciiCharacters))]);
+    }
+  }
+
+  /// Copies the string into the buffer, either at a random position or such that it ends right in front of a page boundary.
+  const char* PlaceString(ezRandom& ref_rng, ezDynamicArray<char>& ref_buffer, const ezStringBuilder& sString)
+  {
+    const ezUInt32 uiSize = sString.GetElementCount() + 1;
+    ref_buffer.SetCount(3 * 4096);
+
+    char* pPage = ezMemoryUtils::Align(ref_buffer.GetData() + 4096, 4096) + 4096;
+    char* pDst = ref_rng.Bool() ? (pPage - uiSize - ref_rng.UIntInRange(16)) : (ref_buffer.GetData() + ref_rng.UIntInRange(4096));
+
+    ezMemoryUtils::Copy(pDst, sString.GetData(), uiSize);
+    return pDst;
+  }
+
+  /// Returns a pointer behind the first uiNumCharacters characters, or to the terminator.
+  const char* GetRandomEnd(ezRandom& ref_rng, const char* szString)
+  {
+    ezUInt32 uiNumCharacters = ref_rng.UIntInRange(100);
+
+    const char* pEnd = szString;
+    while (*pEnd != '\0' && uiNumCharacters-- > 0)
+    {
+      ezUnicodeUtils::MoveToNextUtf8(pEnd);
+    }
+
+    return pEnd;
+  }
+
+  // The scalar implementations, which look at one character at a time, to compare the results of the SIMD code paths against.
+
+  ezUInt32 ReferenceCharacterCount(const char* szUtf8, const char* pStringEnd)
+  {
+    ezUInt32 uiCharacters = 0;
+    for (; (szUtf8 < pStringEnd) && (*szUtf8 != '\0'); ++szUtf8)
+    {
+      if (!ezUnicodeUtils::IsUtf8ContinuationByte(*szUtf8))
+        ++uiCharacters;
+    }
+
+    return uiCharacters;
+  }
+
+  ezInt32 ReferenceCompareEnd(const char* pString1, const char* pString2, const char* pString1End, const char* pString2End)
+  {
+    if (pString1 >= pString1End)
+      return (pString2 >= pString2End) ? 0 : -(ezInt32)(unsigned char)*pString2;
+
+    if (pString2 >= pString2End)
+      return (ezInt32)(unsigned char)*pString1;
+
+    return (ezInt32)(unsigned char)*pString1 - (ezInt32)(unsigned char)*pString2;
+  }
+
+  ezInt32 ReferenceCompare(const char* pString1, const char* pString2, const char* pString1End, const char* pString2End)
+  {
+    for (; (*pString1 != '\0') && (*pString2 != '\0') && (pString1 < pString1End) && (pString2 < pString2End); ++pString1, ++pString2)
+    {
+      if (*pString1 != *pString2)
+        return (ezInt32)(unsigned char)*pString1 - (ezInt32)(unsigned char)*pString2;
+    }
+
+    return ReferenceCompareEnd(pString1, pString2, pString1End, pString2End);
+  }
+
+  ezInt32 ReferenceCompareN_NoCase(const char* pString1, const char* pString2, ezUInt32 uiCharsToCompare, const char* pString1End, const char* pString2End)
+  {
+    while ((*pString1 != '\0') && (*pString2 != '\0') && (uiCharsToCompare > 0) && (pString1 < pString1End) && (pString2 < pString2End))
+    {
+      const ezUInt32 uiChar1 = ezUnicodeUtils::DecodeUtf8ToUtf32(pString1);
+      const ezUInt32 uiChar2 = ezUnicodeUtils::DecodeUtf8ToUtf32(pString2);
+
+      const ezInt32 iComparison = ezStringUtils::CompareChars_NoCase(uiChar1, uiChar2);
+      if (iComparison != 0)
+        return iComparison;
+
+      --uiCharsToCompare;
+    }
+
+    if (uiCharsToCompare == 0)
+      return 0;
+
+    return ReferenceCompareEnd(pString1, pString2, pString1End, pString2End);
+  }
+
+  const char* ReferenceFindSubString(const char* szSource, const char* szStringToFind, const char* pSourceEnd, bool bNoCase)
+  {
+    for (const char* pCurPos = szSource; (*pCurPos != '\0') && (pCurPos < pSourceEnd); ezUnicodeUtils::MoveToNextUtf8(pCurPos))
+    {
+      if (bNoCase ? ezStringUtils::StartsWith_NoCase(pCurPos, szStringToFind, pSourceEnd) : ezStringUtils::StartsWith(pCurPos, szStringToFind, pSourceEnd))
+        return pCurPos;
+    }
+
+    return nullptr;
+  }
+} // namespace
+
 EZ_CREATE_SIMPLE_TEST(Strings, StringUtils)
 {
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "IsNullOrEmpty")
@@ -867,4 +985,114 @@ EZ_CREATE_SIMPLE_TEST(Strings, StringUtils)
     EZ_TEST_BOOL(ezStringUtils::IsValidIdentifierName("asdf1"));
     EZ_TEST_BOOL(ezStringUtils::IsValidIdentifierName("_asdf"));
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "SIMD code paths")
+  {
+    ezRandom rng;
+    rng.Initialize(42);
+
+    ezDynamicArray<char> buffer1, buffer2;
+    ezStringBuilder sString1, sString2, sSearch;
+
+    for (ezUInt32 i = 0; i < 2000; ++i)
+    {
+      BuildRandomString(rng, rng.UIntInRange(80), sString1);
+
+      // equal, different in case, different in one character, or cut off
+      sString2 = sString1;
+      switch (rng.UIntInRange(4))
+      {
+        case 0:
+          sString2.ToUpper();
+          break;
+        case 1:
+          if (!sString2.IsEmpty())
+          {
+            const char* szStart = sString2.ComputeCharacterPosition(rng.UIntInRange(sString2.GetCharacterCount()));
+            const char* szEnd = szStart;
+            ezUnicodeUtils::MoveToNextUtf8(szEnd);
+
+            ezStringBuilder sReplacement;
+            BuildRandomString(rng, 1, sReplacement);
+            sString2.ReplaceSubString(szStart, szEnd, sReplacement);
+          }
+          break;
+        case 2:
+          sString2.Shrink(0, rng.UIntInRange(sString2.GetCharacterCount() + 1));
+          break;
+      }
+
+      const char* szString1 = PlaceString(rng, buffer1, sString1);
+      const char* szString2 = PlaceString(rng, buffer2, sString2);
+      const char* szString1End = GetRandomEnd(rng, szString1);
+      const char* szString2End = GetRandomEnd(rng, szString2);
+      const char* szMaxEnd = ezUnicodeUtils::GetMaxStringEnd<char>();
+
+      EZ_TEST_INT(ezStringUtils::GetCharacterCount(szString1), ReferenceCharacterCount(szString1, szMaxEnd));
+      EZ_TEST_INT(ezStringUtils::GetCharacterCount(szString1, szString1End), ReferenceCharacterCount(szString1, szString1End));
+
+      ezUInt32 uiCharacters, uiElements;
+      ezStringUtils::GetCharacterAndElementCount(szString1, uiCharacters, uiElements, szString1End);
+      EZ_TEST_INT(uiCharacters, ReferenceCharacterCount(szString1, szString1End));
+      EZ_TEST_INT(uiElements, (ezUInt32)(szString1End - szString1));
+
+      EZ_TEST_INT(ezStringUtils::Compare(szString1, szString2), ReferenceCompare(szString1, szString2, szMaxEnd, szMaxEnd));
+      EZ_TEST_INT(ezStringUtils::Compare(szString1, szString2, szString1End, szString2End), ReferenceCompare(szString1, szString2, szString1End, szString2End));
+
+      EZ_TEST_INT(ezStringUtils::Compare_NoCase(szString1, szString2), ReferenceCompareN_NoCase(szString1, szString2, 0xFFFFFFFF, szMaxEnd, szMaxEnd));
+      EZ_TEST_INT(ezStringUtils::Compare_NoCase(szString1, szString2, szString1End, szString2End),
+        ReferenceCompareN_NoCase(szString1, szString2, 0xFFFFFFFF, szString1End, szString2End));
+
+      const ezUInt32 uiCharsToCompare = 1 + rng.UIntInRange(80);
+      EZ_TEST_INT(ezStringUtils::CompareN_NoCase(szString1, szString2, uiCharsToCompare),
+        ReferenceCompareN_NoCase(szString1, szString2, uiCharsToCompare, szMaxEnd, szMaxEnd));
+
+      // either a part of the string, in different case, or a random string
+      if (rng.Bool() && !sString2.IsEmpty())
+      {
+        const ezUInt32 uiNumCharacters = sString2.GetCharacterCount();
+        const ezUInt32 uiStart = rng.UIntInRange(uiNumCharacters);
+        sSearch = sString2;
+        sSearch.Shrink(uiStart, uiNumCharacters - ezMath::Min(uiNumCharacters, uiStart + 1 + rng.UIntInRange(8)));
+      }
+      else
+      {
+        BuildRandomString(rng, 1 + rng.UIntInRange(2), sSearch);
+      }
+
+      EZ_TEST_BOOL(ezStringUtils::FindSubString(szString1, sSearch.GetData()) == ReferenceFindSubString(szString1, sSearch.GetData(), szMaxEnd, false));
+      EZ_TEST_BOOL(ezStringUtils::FindSubString(szString1, sSearch.GetData(), szString1End) == ReferenceFindSubString(szString1, sSearch.GetData(), szString1End, false));
+      EZ_TEST_BOOL(ezStringUtils::FindSubString_NoCase(szString1, sSearch.GetData()) == ReferenceFindSubString(szString1, sSearch.GetData(), szMaxEnd, true));
+      EZ_TEST_BOOL(
+        ezStringUtils::FindSubString_NoCase(szString1, sSearch.GetData(), szString1End) == ReferenceFindSubString(szString1, sSearch.GetData(), szString1End, true));
+
+      // conversions to Utf16 and Utf32 and back
+      ezHybridArray<ezUInt32, 128> utf32;
+      ezHybridArray<ezUInt16, 128> utf16;
+      for (const char* szChar = szString1; *szChar != '\0';)
+      {
+        utf32.PushBack(ezUnicodeUtils::DecodeUtf8ToUtf32(szChar));
+        ezUnicodeUtils::UtfInserter<ezUInt16, ezHybridArray<ezUInt16, 128>> inserter(&utf16);
+        ezUnicodeUtils::EncodeUtf32ToUtf16(utf32.PeekBack(), inserter);
+      }
+
+      ezStringUtf32 sUtf32(szString1);
+      ezStringUtf16 sUtf16(szString1);
+      ezStringWChar sWChar(szString1);
+
+      if (EZ_TEST_INT(sUtf32.GetElementCount(), utf32.GetCount()).Succeeded())
+      {
+        EZ_TEST_BOOL(ezMemoryUtils::IsEqual(sUtf32.GetData(), utf32.GetData(), utf32.GetCount()));
+      }
+
+      if (EZ_TEST_INT(sUtf16.GetElementCount(), utf16.GetCount()).Succeeded())
+      {
+        EZ_TEST_BOOL(ezMemoryUtils::IsEqual(sUtf16.GetData(), utf16.GetData(), utf16.GetCount()));
+      }
+
+      EZ_TEST_STRING(ezStringUtf8(sUtf32.GetData()).GetData(), szString1);
+      EZ_TEST_STRING(ezStringUtf8(sUtf16.GetData()).GetData(), szString1);
+      EZ_TEST_STRING(ezStringUtf8(sWChar.GetData()).GetData(), szString1);
+    }
+  }
 }
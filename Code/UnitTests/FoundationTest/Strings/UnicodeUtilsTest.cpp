@@ -2,6 +2,7 @@
 
 // NOTE: always save as Unicode UTF-8 with signature
 
+#include <Foundation/Math/Random.h>
 #include <Foundation/Strings/String.h>
 
 EZ_CREATE_SIMPLE_TEST(Strings, UnicodeUtils)
@@ -218,6 +219,78 @@ EZ_CREATE_SIMPLE_TEST(Strings, UnicodeUtils)
     EZ_TEST_BOOL(sz == &s.GetData()[0]);
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "IsValidUtf8")
+  {
+    EZ_TEST_BOOL(ezUnicodeUtils::IsValidUtf8(""));
+    EZ_TEST_BOOL(ezUnicodeUtils::IsValidUtf8("abc"));
+    EZ_TEST_BOOL(ezUnicodeUtils::IsValidUtf8(u8"\u00e4\u00f6\u00fc\u6771\U0001D11E"));
+
+    // the smallest and largest code points of every length, and a few invalid sequences around them
+    const char* szValid[] = {"\x7F", "\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xED\x9F\xBF", "\xEE\x80\x80", "\xEF\xBF\xBF", "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF"};
+    const char* szInvalid[] = {"\x80", "\xBF", "\xC0\xAF", "\xC1\xBF", "\xC2", "\xC2\x41", "\xE0\x80\xAF", "\xE0\xA0", "\xED\xA0\x80", "\xED\xBF\xBF",
+      "\xF0\x80\x80\xAF", "\xF0\x90\x80", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xFF", "\xC2\x80\x80"};
+
+    // at every position of a block and across block boundaries
+    const char* szPrefix = "abcdefghijklmnopqrstuvwxyz0123456789ABCD";
+    char szBuffer[64];
+    for (ezUInt32 uiPrefix = 0; uiPrefix < 40; ++uiPrefix)
+    {
+      for (const char* sz : szValid)
+      {
+        ezStringUtils::Copy(szBuffer, EZ_ARRAY_SIZE(szBuffer), szPrefix, szPrefix + uiPrefix);
+        strcat(szBuffer, sz);
+        strcat(szBuffer, "xyz");
+        EZ_TEST_BOOL(ezUnicodeUtils::IsValidUtf8(szBuffer));
+      }
+
+      for (const char* sz : szInvalid)
+      {
+        ezStringUtils::Copy(szBuffer, EZ_ARRAY_SIZE(szBuffer), szPrefix, szPrefix + uiPrefix);
+        strcat(szBuffer, sz);
+        EZ_TEST_BOOL(!ezUnicodeUtils::IsValidUtf8(szBuffer));
+
+        strcat(szBuffer, "xyz");
+        EZ_TEST_BOOL(!ezUnicodeUtils::IsValidUtf8(szBuffer));
+      }
+    }
+
+    // random mixes of valid and invalid bytes, compared to the scalar implementation
+    const ezUInt8 uiBytes[] = {'a', 0x7F, 0x80, 0x8F, 0x90, 0x9F, 0xA0, 0xBF, 0xC0, 0xC1, 0xC2, 0xDF, 0xE0, 0xE1, 0xED, 0xEF, 0xF0, 0xF1, 0xF4, 0xF5, 0xFF};
+
+    ezRandom rng;
+    rng.Initialize(7);
+
+    ezHybridArray<char, 128> buffer;
+    for (ezUInt32 i = 0; i < 10000; ++i)
+    {
+      buffer.Clear();
+
+      const ezUInt32 uiLength = rng.UIntInRange(100);
+      for (ezUInt32 c = 0; c < uiLength; ++c)
+      {
+        // mostly ASCII with a few valid characters, so that a single invalid byte makes the difference
+        const ezUInt32 uiType = rng.UIntInRange(20);
+        if (uiType == 0)
+        {
+          buffer.PushBack(static_cast<char>(uiBytes[rng.UIntInRange(EZ_ARRAY_SIZE(uiBytes))]));
+        }
+        else if (uiType < 4)
+        {
+          const char* szChar = szValid[rng.UIntInRange(EZ_ARRAY_SIZE(szValid))];
+          buffer.PushBackRange(ezArrayPtr<const char>(szChar, ezStringUtils::GetStringElementCount(szChar)));
+        }
+        else
+        {
+          buffer.PushBack(static_cast<char>('a' + rng.UIntInRange(26)));
+        }
+      }
+
+      const char* pStart = buffer.GetData();
+      const char* pEnd = pStart + buffer.GetCount();
+      EZ_TEST_BOOL(ezUnicodeUtils::IsValidUtf8(pStart, pEnd) == utf8::is_valid(pStart, pEnd));
+    }
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "SkipUtf8Bom")
   {
     // C++ is really stupid, chars are signed, but Utf8 only works with unsigned values ... argh!
@@ -212,4 +212,96 @@ EZ_CREATE_SIMPLE_TEST(Threading, ParallelFor)
     // check the resulting sum
     EZ_TEST_INT(uiNumbersSum, 4 * uiNumbersCheckSum);
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Parallel For (Adaptive)")
+  {
+    ezParallelForCostCache costCache;
+
+    ezParallelForParams adaptiveParams;
+    adaptiveParams.bAdaptive = true;
+    adaptiveParams.pCostCache = &costCache;
+
+    ezDynamicArray<ezUInt32> visited;
+    visited.SetCount(1000);
+
+    // the decision only depends on the cost per item, cheap loops run on the calling thread, expensive ones get split up
+    EZ_TEST_INT(adaptiveParams.DetermineAdaptiveMultiplicity(800, ezTime::Nanoseconds(10)), 0);
+    EZ_TEST_INT(adaptiveParams.DetermineAdaptiveMultiplicity(800, ezTime::Nanoseconds(100)), 0);
+    EZ_TEST_BOOL(adaptiveParams.DetermineAdaptiveMultiplicity(200, ezTime::Microseconds(20)) > 2);
+    EZ_TEST_BOOL(adaptiveParams.DetermineAdaptiveMultiplicity(200, ezTime::Microseconds(20)) <= 200);
+
+    // cheap items, the first invocation measures the cost
+    // how the items are partitioned depends on the measured time, which is not reliable on a loaded machine, so only the result is checked
+    for (ezUInt32 iRun = 0; iRun < 3; ++iRun)
+    {
+      ezTaskSystem::ParallelForIndexed(
+        100, visited.GetCount() - 100,
+        [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+          for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+          {
+            visited[i] += 1;
+          }
+        },
+        "ParallelFor Adaptive Cheap", adaptiveParams);
+
+      EZ_TEST_BOOL(!costCache.GetItemCost().IsZero());
+    }
+
+    for (ezUInt32 i = 0; i < visited.GetCount(); ++i)
+    {
+      EZ_TEST_INT(visited[i], i < 100 ? 0 : 3);
+    }
+
+    // expensive items have to be split up into several ranges
+    costCache.Reset();
+    EZ_TEST_BOOL(costCache.GetItemCost().IsZero());
+
+    ezDynamicArray<ezUInt32> items;
+    items.SetCount(200);
+
+    for (ezUInt32 iRun = 0; iRun < 3; ++iRun)
+    {
+      ezAtomicInteger32 iNumRanges;
+
+      ezTaskSystem::ParallelFor<ezUInt32>(
+        items.GetArrayPtr(),
+        [&](ezArrayPtr<ezUInt32> slice) {
+          iNumRanges.Increment();
+
+          for (ezUInt32& item : slice)
+          {
+            // roughly 20 microseconds of work per item
+            const ezTime tEnd = ezTime::Now() + ezTime::Microseconds(20);
+            while (ezTime::Now() < tEnd)
+            {
+            }
+
+            item += 1;
+          }
+        },
+        "ParallelFor Adaptive Expensive", adaptiveParams);
+
+      // every item takes at least 20 microseconds, a slow machine can only measure a higher cost, which never means fewer ranges
+      EZ_TEST_BOOL(iNumRanges > 2);
+    }
+
+    for (ezUInt32 item : items)
+    {
+      EZ_TEST_INT(item, 3);
+    }
+
+    // without a cost cache, each invocation measures the cost itself
+    adaptiveParams.pCostCache = nullptr;
+    ezUInt32 uiSum = 0;
+
+    ezTaskSystem::ParallelForSingle(
+      items.GetArrayPtr(),
+      [&](ezUInt32 uiItem) {
+        EZ_LOCK(dataAccessMutex);
+        uiSum += uiItem;
+      },
+      "ParallelFor Adaptive Uncached", adaptiveParams);
+
+    EZ_TEST_INT(uiSum, 3 * items.GetCount());
+  }
 }
@@ -2,6 +2,10 @@
 
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/System/SystemInformation.h>
+#include <Foundation/Threading/DelegateTask.h>
+#include <Foundation/Threading/ForkJoin.h>
+#include <Foundation/Threading/TaskCoroutine.h>
 #include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Time.h>
 #include <Foundation/Utilities/DGMLWriter.h>
@@ -66,6 +70,73 @@ private:
   }
 };
 
+class ezTestOrderTask final : public ezTask
+{
+public:
+  ezTestOrderTask(ezAtomicInteger32* pCounter)
+    : m_pCounter(pCounter)
+  {
+    ConfigureTask("ezTestOrderTask", ezTaskNesting::Never);
+  }
+
+  ezInt32 m_iExecutionOrder = -1;
+
+private:
+  virtual void Execute() override { m_iExecutionOrder = m_pCounter->PostIncrement(); }
+
+  ezAtomicInteger32* m_pCounter;
+};
+
+static ezUInt64 ForkJoinSum(const ezUInt32* pValues, ezUInt32 uiNumValues, ezAtomicInteger32& numTasks)
+{
+  if (uiNumValues <= 16)
+  {
+    ezUInt64 uiSum = 0;
+    for (ezUInt32 i = 0; i < uiNumValues; ++i)
+      uiSum += pValues[i];
+    return uiSum;
+  }
+
+  const ezUInt32 uiHalf = uiNumValues / 2;
+  ezUInt64 uiLeftSum = 0;
+
+  ezForkJoinScope scope;
+  ezForkJoinTask leftTask([&]() { uiLeftSum = ForkJoinSum(pValues, uiHalf, numTasks); });
+
+  numTasks.Increment();
+  scope.Spawn(leftTask);
+
+  const ezUInt64 uiRightSum = ForkJoinSum(pValues + uiHalf, uiNumValues - uiHalf, numTasks);
+
+  scope.Sync();
+
+  EZ_TEST_BOOL(leftTask.IsTaskFinished());
+  return uiLeftSum + uiRightSum;
+}
+
+#if EZ_ENABLED(EZ_SUPPORTS_COROUTINES)
+static ezTaskCoroutine CoroutineIncrementOn(ezTaskPriority::Enum priority, ezAtomicInteger32& counter)
+{
+  co_await ezCoroutineResumeOn(priority);
+  counter.Increment();
+}
+
+static ezTaskCoroutine CoroutineHopThreads(ezSharedPtr<ezTask> pTask, ezAtomicInteger32& counter, bool& bOnFileThread, bool& bOnMainThread)
+{
+  co_await ezCoroutineResumeOn(ezTaskPriority::FileAccess);
+  bOnFileThread = ezTaskSystem::GetCurrentThreadWorkerType() == ezWorkerThreadType::FileAccess;
+
+  co_await ezTaskSystem::StartSingleTask(pTask, ezTaskPriority::LongRunning);
+  EZ_TEST_BOOL(pTask->IsTaskFinished());
+
+  co_await CoroutineIncrementOn(ezTaskPriority::ThisFrame, counter);
+  EZ_TEST_INT(counter, 1);
+
+  co_await ezCoroutineResumeOn(ezTaskPriority::ThisFrameMainThread);
+  bOnMainThread = ezThreadUtils::IsMainThread();
+}
+#endif
+
 class TaskCallbacks
 {
 public:
@@ -550,6 +621,161 @@ EZ_CREATE_SIMPLE_TEST(Threading, TaskSystem)
     EZ_TEST_BOOL(t[2]->IsMultiplicityDone());
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Many Groups with Dependencies")
+  {
+    // more groups than fit into a single chunk of the group allocator
+    constexpr ezUInt32 uiNumGroups = 500;
+
+    ezAtomicInteger32 iCounter;
+    ezDynamicArray<ezSharedPtr<ezTestOrderTask>> tasks;
+    ezDynamicArray<ezTaskGroupID> groups;
+    tasks.SetCount(uiNumGroups);
+    groups.SetCount(uiNumGroups);
+
+    for (ezUInt32 i = 0; i < uiNumGroups; ++i)
+    {
+      tasks[i] = EZ_DEFAULT_NEW(ezTestOrderTask, &iCounter);
+
+      groups[i] = ezTaskSystem::CreateTaskGroup(ezTaskPriority::ThisFrame);
+      ezTaskSystem::AddTaskToGroup(groups[i], tasks[i]);
+
+      // some dependencies will already be finished, when the group gets started
+      if (i > 0)
+        ezTaskSystem::AddTaskGroupDependency(groups[i], groups[i / 2]);
+      if (i > 2)
+        ezTaskSystem::AddTaskGroupDependency(groups[i], groups[i - 3]);
+
+      ezTaskSystem::StartTaskGroup(groups[i]);
+    }
+
+    for (ezUInt32 i = 0; i < uiNumGroups; ++i)
+    {
+      ezTaskSystem::WaitForGroup(groups[i]);
+    }
+
+    EZ_TEST_INT(iCounter, uiNumGroups);
+
+    for (ezUInt32 i = 1; i < uiNumGroups; ++i)
+    {
+      EZ_TEST_BOOL(tasks[i]->m_iExecutionOrder > tasks[i / 2]->m_iExecutionOrder);
+
+      if (i > 2)
+        EZ_TEST_BOOL(tasks[i]->m_iExecutionOrder > tasks[i - 3]->m_iExecutionOrder);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Fork-Join")
+  {
+    ezDynamicArray<ezUInt32> values;
+    values.SetCountUninitialized(10000);
+
+    ezUInt64 uiExpectedSum = 0;
+    for (ezUInt32 i = 0; i < values.GetCount(); ++i)
+    {
+      values[i] = i * 7 + 3;
+      uiExpectedSum += values[i];
+    }
+
+    for (ezUInt32 iRun = 0; iRun < 10; ++iRun)
+    {
+      ezAtomicInteger32 numTasks;
+      EZ_TEST_INT(ForkJoinSum(values.GetData(), values.GetCount(), numTasks), uiExpectedSum);
+      EZ_TEST_BOOL(numTasks > 500);
+    }
+
+    // spawning from within a regular task
+    ezUInt64 uiSum = 0;
+    ezAtomicInteger32 numTasks;
+    ezSharedPtr<ezTask> pTask = EZ_DEFAULT_NEW(ezDelegateTask<void>, "ForkJoinRoot", [&]() { uiSum = ForkJoinSum(values.GetData(), values.GetCount(), numTasks); });
+    pTask->ConfigureTask("ForkJoinRoot", ezTaskNesting::Maybe);
+    ezTaskSystem::WaitForGroup(ezTaskSystem::StartSingleTask(pTask, ezTaskPriority::ThisFrame));
+
+    EZ_TEST_INT(uiSum, uiExpectedSum);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Thread Placement")
+  {
+    ezDynamicArray<ezCPULogicalProcessor> processors;
+    ezSystemInformation::GetCPUTopology(processors);
+    EZ_TEST_BOOL(!processors.IsEmpty());
+
+    ezHybridArray<ezUInt32, 64> indices;
+    for (const ezCPULogicalProcessor& proc : processors)
+    {
+      EZ_TEST_BOOL(!indices.Contains(proc.m_uiProcessorIndex));
+      indices.PushBack(proc.m_uiProcessorIndex);
+    }
+
+    ezTaskSystem::SetThreadPlacement(ezTaskThreadPlacement::PhysicalCores);
+    EZ_TEST_BOOL(ezTaskSystem::GetThreadPlacement() == ezTaskThreadPlacement::PhysicalCores);
+    ezTaskSystem::ResetUtilizationReport();
+
+    for (ezUInt32 iFrame = 0; iFrame < 5; ++iFrame)
+    {
+      ezTaskGroupID g = ezTaskSystem::CreateTaskGroup(ezTaskPriority::ThisFrame);
+
+      for (ezUInt32 i = 0; i < 8; ++i)
+      {
+        ezSharedPtr<ezTestTask> pTask = EZ_DEFAULT_NEW(ezTestTask);
+        pTask->m_uiIterations = 2;
+        ezTaskSystem::AddTaskToGroup(g, pTask);
+      }
+
+      ezTaskSystem::StartTaskGroup(g);
+      ezTaskSystem::WaitForGroup(g);
+
+      ezThreadUtils::Sleep(ezTime::Milliseconds(5));
+      ezTaskSystem::FinishFrameTasks();
+    }
+
+    ezTaskSystemUtilizationReport report;
+    ezTaskSystem::GetUtilizationReport(report);
+
+    EZ_TEST_BOOL(report.m_uiNumFrames > 0);
+    EZ_TEST_BOOL(report.m_ThreadPlacement == ezTaskThreadPlacement::PhysicalCores);
+    EZ_TEST_BOOL(report.m_MinFrameTime <= report.m_AverageFrameTime);
+    EZ_TEST_BOOL(report.m_AverageFrameTime <= report.m_MaxFrameTime);
+
+    ezTaskSystem::SetThreadPlacement(ezTaskThreadPlacement::Default);
+    ezTaskSystem::ResetUtilizationReport();
+
+    ezTaskSystem::GetUtilizationReport(report);
+    EZ_TEST_INT(report.m_uiNumFrames, 0);
+    EZ_TEST_INT(report.m_uiNumPinnedThreads, 0);
+  }
+
+#if EZ_ENABLED(EZ_SUPPORTS_COROUTINES)
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Coroutines")
+  {
+    for (ezUInt32 iRun = 0; iRun < 10; ++iRun)
+    {
+      ezAtomicInteger32 counter;
+      bool bOnFileThread = false;
+      bool bOnMainThread = false;
+
+      ezSharedPtr<ezTask> pTask = EZ_DEFAULT_NEW(ezTestTask);
+      ezTaskCoroutine coroutine = CoroutineHopThreads(pTask, counter, bOnFileThread, bOnMainThread);
+      EZ_TEST_BOOL(coroutine.IsValid());
+
+      coroutine.Wait();
+
+      EZ_TEST_BOOL(coroutine.IsFinished());
+      EZ_TEST_BOOL(bOnFileThread);
+      EZ_TEST_BOOL(bOnMainThread);
+      EZ_TEST_INT(counter, 1);
+    }
+
+    // detached coroutines free their frames themselves
+    ezAtomicInteger32 counter;
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      CoroutineIncrementOn(ezTaskPriority::ThisFrame, counter);
+    }
+
+    ezTaskSystem::WaitForCondition([&]() { return counter == 100; });
+  }
+#endif
+
   // capture profiling info for testing
   /*ezStringBuilder sOutputPath = ezTestFramework::GetInstance()->GetAbsOutputPath();
 